@@ -156,6 +156,24 @@ export const METRICS_SCHEMA = {
     cbOverruns:   { index: 5, type: 'counter', unit: 'count', description: 'Audio callbacks that overran their time budget' },
     nrtMaxPassMs:  { index: 6, type: 'gauge', unit: 'ms', description: 'Longest the control thread has spent handling one batch of commands since boot' },
     nrtInFlightMs: { index: 7, type: 'gauge', unit: 'ms', description: 'How long the control thread has been stuck in the command it is handling right now. Anything but 0 means later commands, and every reply behind them, are waiting' },
+    egressMaxQueueBytes:    { index: 8,  type: 'gauge',   unit: 'bytes', description: 'Deepest per-connection reply queue on the stream command transport right now. A stalled client backs up only its own queue' },
+    egressDropped:          { index: 9,  type: 'counter', unit: 'count', description: 'Replies dropped because a client\'s reply queue was full (drop-oldest policy)' },
+    egressOverflowCloses:   { index: 10, type: 'counter', unit: 'count', description: 'Clients disconnected because their reply queue was full (disconnect policy)' },
+    samplePrefetchHits:     { index: 11, type: 'counter', unit: 'count', description: 'Synths whose registered sample was already resident when they started' },
+    sampleLateLoads:        { index: 12, type: 'counter', unit: 'count', description: 'Synths whose registered sample was not resident in time. The sample loads then, but that synth plays silence' },
+    sampleEvictions:        { index: 13, type: 'counter', unit: 'count', description: 'Idle registered samples evicted to stay under the residency budget' },
+    sampleResidentKiB:      { index: 14, type: 'gauge',   unit: 'KiB',   description: 'Memory held right now by registered samples, in KiB' },
+    smoothingConverged:     { index: 15, type: 'gauge',   unit: 'count', description: 'Lag, Ramp and VarLag units whose output has settled and that are filling a constant instead of filtering' },
+    fftTransforms:          { index: 16, type: 'counter', unit: 'count', description: 'FFT and IFFT transforms run since boot' },
+    fftBlockPeak:           { index: 17, type: 'gauge',   unit: 'count', description: 'Most FFT and IFFT transforms run in a single block over the last ~64 blocks' },
+    arenaAllocs:            { index: 18, type: 'counter', unit: 'count', description: 'Unit constructor allocations served from a per-node arena since boot' },
+    arenaPoolAllocs:        { index: 19, type: 'counter', unit: 'count', description: 'Unit constructor allocations that went to the realtime pool since boot' },
+    arenaSynths:            { index: 20, type: 'counter', unit: 'count', description: 'Synths whose unit constructors have run since boot' },
+    idleBlocks:             { index: 21, type: 'counter', unit: 'count', description: 'Blocks not rendered because the engine was idle, since boot' },
+    precodedCommands:       { index: 22, type: 'counter', unit: 'count', description: 'Commands that arrived pre-decoded and skipped the OSC parse, since boot' },
+    worldResizes:           { index: 23, type: 'counter', unit: 'count', description: 'Times the World\'s limits (nodes, buffers, buses, wire buffers, RT memory) were raised while running' },
+    worldResizeApplyUs:     { index: 24, type: 'gauge',   unit: 'us',    description: 'How long the last World resize held the audio thread' },
+    worldResizeBytes:       { index: 25, type: 'counter', unit: 'bytes', description: 'Memory added by World resizes since boot' },
   },
 
   composites: COMPOSITES,
@@ -249,6 +249,8 @@ export class SuperSonic {
 
   // Cached TypedArray views for scope slots (lazily initialized, avoids per-frame allocations)
   #scopeViews = null;
+  // Cached u32 view of the meter region (lazily initialized)
+  #meterView = null;
 
   /**
    * Validate scsynthOptions (worldOptions) at construction time.
@@ -837,6 +839,7 @@ export class SuperSonic {
 
     this.#initialized = false;
     this.#scopeViews = null;
+    this.#meterView = null;
     this.loadedSynthDefs.clear();
     this.#initPromise = null;
     this.#oscChannel = null;
@@ -1075,6 +1078,84 @@ export class SuperSonic {
     };
   }
 
+  // ============================================================================
+  // METER API
+  //
+  // Per-channel peak, RMS and true peak of the hardware outputs and of up to
+  // 16 chosen audio buses, measured by the engine after every block into the
+  // METER region of the SAB (bus_meter.h; field offsets mirror METER_* in
+  // shared_memory.h). No synths and no OSC: setMeters() writes a request the
+  // engine picks up at its next block, getMeters() reads the latest levels.
+  // SAB mode only for now.
+  // ============================================================================
+
+  /** @returns {Uint32Array|null} u32 view of the METER region */
+  #meterWords() {
+    const bc = this.#metricsReader.bufferConstants;
+    const sab = this.#metricsReader.sharedBuffer;
+    if (!bc || bc.METER_START == null || !sab) return null;
+    if (!this.#meterView) {
+      this.#meterView = new Uint32Array(sab, this.#metricsReader.ringBufferBase + bc.METER_START,
+                                        bc.METER_SIZE / 4);
+    }
+    return this.#meterView;
+  }
+
+  /**
+   * Choose what the engine meters. Outputs are always metered while on.
+   *
+   * @param {Object} [options]
+   * @param {boolean} [options.enabled=true] - false stops metering
+   * @param {number[]} [options.buses=[]] - audio bus indices (up to 16)
+   * @param {boolean} [options.truePeak=false] - 4x-oversampled true peak
+   * @param {number} [options.rmsMs=0] - RMS time constant (0 = 300 ms)
+   * @param {number} [options.peakMs=0] - peak fall time for 20 dB (0 = 1700 ms)
+   * @returns {number|null} Request generation; getMeters().gen reaches it once applied
+   */
+  setMeters({ enabled = true, buses = [], truePeak = false, rmsMs = 0, peakMs = 0 } = {}) {
+    this.#ensureInitialized("set meters");
+    const w = this.#meterWords();
+    if (!w) return null;
+    const count = Math.min(buses.length, 16);
+    w[1] = (enabled ? 1 : 0) | (truePeak ? 2 : 0);   // METER_REQ_FLAGS
+    w[2] = rmsMs >>> 0;                               // METER_REQ_RMS_MS
+    w[3] = peakMs >>> 0;                              // METER_REQ_PEAK_MS
+    w[4] = count;                                     // METER_REQ_BUS_COUNT
+    for (let i = 0; i < count; i++) w[8 + i] = buses[i] >>> 0;   // METER_REQ_BUSES
+    return Atomics.add(w, 0, 1) + 1;                  // METER_REQ_GEN, published last
+  }
+
+  /**
+   * Latest meter levels (linear amplitude), or null before the engine has
+   * applied a request.
+   *
+   * @returns {{ gen: number, blocks: number, rmsMs: number, peakMs: number,
+   *   outputs: Array<{ peak: number, rms: number, truePeak: number, max: number }>,
+   *   buses: Array<{ bus: number, peak: number, rms: number, truePeak: number, max: number }> }|null}
+   */
+  getMeters() {
+    if (!this.#initialized) return null;
+    const w = this.#meterWords();
+    if (!w) return null;
+    const f = new Float32Array(w.buffer, w.byteOffset, w.length);
+    const SEQ = 24, ROWS = 48;   // METER_SEQ, METER_ROWS as u32 indices
+    for (let tries = 0; tries < 8; tries++) {
+      const s0 = Atomics.load(w, SEQ);
+      if (s0 === 0) return null;
+      if (s0 & 1) continue;
+      const outputs = Math.min(w[27], 16), busCount = Math.min(w[28], 16);
+      const row = (c, extra) => ({ ...extra, peak: f[ROWS + c * 4], rms: f[ROWS + c * 4 + 1],
+                                   truePeak: f[ROWS + c * 4 + 2], max: f[ROWS + c * 4 + 3] });
+      const out = {
+        gen: w[25], rmsMs: w[29], peakMs: w[30], blocks: w[31],
+        outputs: Array.from({ length: outputs }, (_, c) => row(c)),
+        buses: Array.from({ length: busCount }, (_, i) => row(outputs + i, { bus: w[32 + i] })),
+      };
+      if (Atomics.load(w, SEQ) === s0) return out;
+    }
+    return null;
+  }
+
   // ============================================================================
   // AUDIO CAPTURE API
   //
@@ -1511,6 +1592,7 @@ export class SuperSonic {
     this.#bufferQueue = Promise.resolve();
     this.#initialized = false;
     this.#scopeViews = null;
+    this.#meterView = null;
     this.loadedSynthDefs.clear();
     this.#initPromise = null;
     this.#wasmMemory = null;
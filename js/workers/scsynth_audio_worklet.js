@@ -221,7 +221,10 @@ class ScsynthProcessor extends AudioWorkletProcessor {
             PADDING_MAGIC: uint32View[47],
             scheduler_data_pool_size: uint32View[48],
             scheduler_slot_count: uint32View[49],
-            RING_PADDING_MARKER: uint8View[200],  // After 50 uint32s = 200 bytes
+            // Bus meters (peak/RMS/true peak; see getMeters() in supersonic.js)
+            METER_START: uint32View[50],
+            METER_SIZE: uint32View[51],
+            RING_PADDING_MARKER: uint8View[208],  // After 52 uint32s = 208 bytes
             MESSAGE_HEADER_SIZE: 16  // sizeof(Message) - 4 x uint32_t (magic, length, sequence, sourceId)
         };
 
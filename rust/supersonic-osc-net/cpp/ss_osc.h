@@ -5,6 +5,8 @@
  * callback, then drives it:
  *   - ss_osc_configure(): (re)bind the external cue server.
  *   - ss_osc_send():      send a now-due scheduled OSC packet to a host:port.
+ *   - ss_osc_send_addr() / ss_osc_send_batch(): send to resolved SsOscAddrs
+ *     (the command transport's replies).
  * Inbound external OSC is re-framed to /external-osc-cue <ip> <port> <address>
  * <args...> and handed back via the emit callback (which may fire on the cue
  * server's recv thread, so the host impl must be thread-safe). The subsystem
@@ -54,6 +56,37 @@ void ss_osc_configure(SsOsc* handle, int32_t port, int32_t loopback, int32_t cue
 void ss_osc_send(SsOsc* handle, const uint8_t* host, uint32_t host_len,
                  int32_t port, const uint8_t* data, uint32_t len);
 
+/* A resolved UDP endpoint: the OS's own sockaddr_in / sockaddr_in6 bytes and
+ * their length (<= 28). Fixed-size, so a transport can key, compare (len +
+ * memcmp of bytes[0..len)) and store origins without formatting or resolving
+ * strings; hand it back to ss_osc_send_addr / ss_osc_send_batch to reply.
+ * Otherwise opaque. Must match SsOscAddr in ffi.rs. */
+#define SS_OSC_ADDR_BYTES 28
+typedef struct SsOscAddr {
+    uint32_t len;
+    uint8_t  bytes[SS_OSC_ADDR_BYTES];
+} SsOscAddr;
+
+/* Resolve `host`:`port` once into `out` (a family an outbound socket exists
+ * for). `host` is a byte string (ptr + len). 1 on success, 0 otherwise. */
+int32_t ss_osc_addr_resolve(SsOsc* handle, const uint8_t* host, uint32_t host_len,
+                            int32_t port, SsOscAddr* out);
+
+/* Send one packet to a resolved address. 1 if the kernel took it. */
+int32_t ss_osc_send_addr(SsOsc* handle, const SsOscAddr* addr,
+                         const uint8_t* data, uint32_t len);
+
+/* Send `count` datagrams, keeping order per address family. On Linux each
+ * family goes out in as few sendmmsg calls as it takes (one per 1024); other
+ * platforms loop. A datagram the kernel refuses is skipped. Returns the number
+ * sent. Must match SsOscDatagram in ffi.rs. Off the audio thread. */
+typedef struct SsOscDatagram {
+    const SsOscAddr* addr;
+    const uint8_t*   data;
+    uint32_t         len;
+} SsOscDatagram;
+uint32_t ss_osc_send_batch(SsOsc* handle, const SsOscDatagram* dgrams, uint32_t count);
+
 /* Raw OSC ingress (separate from the cue server): receive datagrams on `port`
  * and hand the raw OSC bytes to `emit` (kind = broadcast) without re-framing.
  * `loopback` != 0 binds 127.0.0.1 + ::1, else all interfaces. The standalone
@@ -76,6 +109,15 @@ SsOscIngress* ss_osc_ingress_start_with_src(void* ctx, ss_osc_emit_src_fn emit,
                                             int32_t port,
                                             const uint8_t* bind_addr, uint32_t bind_addr_len);
 
+/* Address-bearing OSC ingress: as ss_osc_ingress_start_with_src, but the
+ * sender arrives as a packed SsOscAddr (no per-datagram string formatting),
+ * valid only for the call. This is what UdpOscTransport uses. */
+typedef void (*ss_osc_emit_addr_fn)(void* ctx, const SsOscAddr* src,
+                                    const uint8_t* osc, uint32_t len);
+SsOscIngress* ss_osc_ingress_start_with_addr(void* ctx, ss_osc_emit_addr_fn emit,
+                                             int32_t port,
+                                             const uint8_t* bind_addr, uint32_t bind_addr_len);
+
 /* ── UDS datagram ingress (unix only) ─────────────────────────────────────────
  * The kernel-ACL'd sibling of the UDP control port: binds a socket file at
  * `path` (created 0600, replacing a stale file; put it in a 0700 directory to
@@ -136,10 +178,41 @@ SsOscStream* ss_osc_pipe_start(void* ctx, ss_osc_stream_packet_fn on_packet,
                                uint32_t max_conns);
 /* The actual bound TCP port (for port-0 starts); 0 for path/name servers. */
 int32_t ss_osc_stream_port(SsOscStream* handle);
-/* Frame and send one packet to a live connection. 1 = sent, 0 = unknown/closed
- * connection or write failure. Off the audio thread. */
+/* Frame and queue one packet for a live connection. 1 = queued, 0 = unknown/
+ * closed connection or a frame the overflow policy refused. TCP/UDS stream
+ * connections each own a bounded egress queue drained by their own writer
+ * thread (many frames per vectored write), so this never blocks on a slow
+ * client; named pipes still send synchronously. Off the audio thread. */
 int32_t ss_osc_stream_send(SsOscStream* handle, uint32_t conn_id,
                            const uint8_t* data, uint32_t len);
+
+/* Egress overflow policy: what a full connection queue does with a new frame. */
+#define SS_OSC_EGRESS_DROP_OLDEST 0 /* discard the oldest frames not yet being written */
+#define SS_OSC_EGRESS_DISCONNECT  1 /* close the connection (default) */
+
+/* Queue size in bytes (0 = 1 MiB default; clamped to [512 KiB, 64 MiB] and
+ * rounded up to a power of two) and overflow policy for connections accepted
+ * from now on — call straight after start. 0 on a null handle or unknown
+ * policy. Named-pipe servers accept and ignore it. */
+int32_t ss_osc_stream_set_egress(SsOscStream* handle, uint32_t queue_bytes, uint32_t overflow);
+
+/* Bytes queued for one connection (including a batch being written), or -1
+ * for an unknown/closed connection or a server without queues. */
+int64_t ss_osc_stream_queue_depth(SsOscStream* handle, uint32_t conn_id);
+
+/* Egress snapshot across a server's live connections. Must match
+ * SsOscStreamEgressStats in stream.rs. */
+typedef struct SsOscStreamEgressStats {
+    uint32_t connections;
+    uint32_t reserved;
+    uint64_t max_queue_bytes;  /* deepest per-connection queue right now */
+    uint64_t peak_queue_bytes; /* deepest any live connection's queue has been */
+    uint64_t queued_bytes;     /* sum over connections */
+    uint64_t dropped_frames;   /* drop-oldest discards (cumulative) */
+    uint64_t overflow_closes;  /* connections closed by the disconnect policy (cumulative) */
+} SsOscStreamEgressStats;
+/* 1 on success, 0 on a null argument. Any thread. */
+int32_t ss_osc_stream_egress_stats(SsOscStream* handle, SsOscStreamEgressStats* out);
 /* Stop accepting, close every connection, join the threads, free the server. */
 void ss_osc_stream_stop(SsOscStream* handle);
 
@@ -0,0 +1,408 @@
+//! Per-connection egress queue for the stream servers (`stream.rs`).
+//!
+//! A bounded byte ring that holds frames already in wire format (4-byte
+//! big-endian length + payload), so the connection's writer thread can hand
+//! the kernel every queued frame in one vectored write — the ring's two
+//! contiguous spans are the whole batch. The sender (the NRT gateway, via
+//! `ss_osc_stream_send`) only copies into the ring and never blocks on a
+//! socket: one stalled client fills its own queue and nobody else's.
+//!
+//! Three monotonic byte cursors (u64 — they never wrap in practice):
+//!   * `tail`  — end of published frames. Producer-owned.
+//!   * `claim` — start of frames the writer has not yet taken. The writer
+//!     advances it to take a batch; under [`Overflow::DropOldest`] the
+//!     producer advances it to discard the oldest untaken frame. Both sides
+//!     use compare-exchange, so a frame is either sent or dropped, never half
+//!     of each — the connection's framing stays intact.
+//!   * `head`  — everything before it is free space. Only ever raised
+//!     (`fetch_max`): by the writer once a batch is written, and by either
+//!     side to reclaim dropped frames when no batch is in flight ahead of them.
+//!
+//! Lock-free between producer and writer. A producer-side mutex serialises
+//! concurrent senders (the gateway is the sole one in practice); it guards a
+//! bounded memcpy and is never held across a syscall.
+
+use std::cell::UnsafeCell;
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicU8, Ordering};
+use std::sync::{Mutex, OnceLock};
+use std::thread::Thread;
+
+use crate::stream::MAX_FRAME;
+
+/// Default per-connection queue: room for a few max-size frames, or many
+/// thousands of typical replies.
+pub const DEFAULT_QUEUE_BYTES: usize = 1024 * 1024;
+
+/// Smallest queue accepted — one max-size frame must always fit.
+pub const MIN_QUEUE_BYTES: usize = (4 + MAX_FRAME).next_power_of_two();
+
+/// Largest queue accepted, so a misconfigured size can't reserve gigabytes
+/// per connection.
+pub const MAX_QUEUE_BYTES: usize = 64 * 1024 * 1024;
+
+/// What a full queue does with the next frame. Values match the
+/// `SS_OSC_EGRESS_*` constants in `cpp/ss_osc.h`.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+#[repr(u32)]
+pub enum Overflow {
+    /// Discard the oldest frames the writer hasn't taken yet to make room.
+    /// While a batch is still being written (a stalled client) the space it
+    /// holds can't be freed, so the new frame is dropped instead.
+    DropOldest = 0,
+    /// Close the connection: a reliable stream must not silently lose replies.
+    Disconnect = 1,
+}
+
+impl Overflow {
+    pub fn from_u32(v: u32) -> Option<Overflow> {
+        match v {
+            0 => Some(Overflow::DropOldest),
+            1 => Some(Overflow::Disconnect),
+            _ => None,
+        }
+    }
+}
+
+/// Outcome of [`EgressQueue::push`].
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub(crate) enum Push {
+    /// Queued; `dropped` older frames were discarded to make room.
+    Queued { dropped: u32 },
+    /// DropOldest with nothing discardable: this frame was dropped.
+    Dropped,
+    /// Disconnect policy and the frame doesn't fit: close the connection.
+    Overflow,
+}
+
+pub(crate) struct EgressQueue {
+    buf: Box<[UnsafeCell<u8>]>,
+    mask: u64,
+    overflow: Overflow,
+    tail: AtomicU64,
+    claim: AtomicU64,
+    head: AtomicU64,
+    peak: AtomicU64,
+    producer: Mutex<()>,
+    // Writer wake-up: the writer parks with `idle` set; a push that finds it
+    // set clears it and unparks. Only a parked writer costs a wake syscall.
+    idle: AtomicBool,
+    waiter: OnceLock<Thread>,
+}
+
+// Safety: `buf` is only written by the (serialised) producer into free space
+// and only read by the writer inside a claimed batch — disjoint by the cursor
+// protocol above. The one exception, the length header at `claim`, is
+// accessed atomically (`hdr_byte`).
+unsafe impl Sync for EgressQueue {}
+unsafe impl Send for EgressQueue {}
+
+impl EgressQueue {
+    /// `bytes` is clamped to [MIN_QUEUE_BYTES, MAX_QUEUE_BYTES] and rounded up
+    /// to a power of two.
+    pub(crate) fn new(bytes: usize, overflow: Overflow) -> EgressQueue {
+        let cap = bytes.clamp(MIN_QUEUE_BYTES, MAX_QUEUE_BYTES).next_power_of_two();
+        EgressQueue {
+            buf: (0..cap).map(|_| UnsafeCell::new(0)).collect(),
+            mask: cap as u64 - 1,
+            overflow,
+            tail: AtomicU64::new(0),
+            claim: AtomicU64::new(0),
+            head: AtomicU64::new(0),
+            peak: AtomicU64::new(0),
+            producer: Mutex::new(()),
+            idle: AtomicBool::new(false),
+            waiter: OnceLock::new(),
+        }
+    }
+
+    #[cfg(test)]
+    fn capacity(&self) -> usize {
+        self.buf.len()
+    }
+
+    /// Bytes queued, including a batch the writer is still sending.
+    pub(crate) fn depth(&self) -> u64 {
+        let tail = self.tail.load(Ordering::Acquire);
+        tail.saturating_sub(self.head.load(Ordering::Acquire))
+    }
+
+    /// Deepest the queue has been since the connection opened.
+    pub(crate) fn peak(&self) -> u64 {
+        self.peak.load(Ordering::Relaxed)
+    }
+
+    fn ptr(&self) -> *mut u8 {
+        UnsafeCell::raw_get(self.buf.as_ptr())
+    }
+
+    fn write_at(&self, pos: u64, data: &[u8]) {
+        let i = (pos & self.mask) as usize;
+        let first = data.len().min(self.buf.len() - i);
+        unsafe {
+            std::ptr::copy_nonoverlapping(data.as_ptr(), self.ptr().add(i), first);
+            std::ptr::copy_nonoverlapping(data.as_ptr().add(first), self.ptr(), data.len() - first);
+        }
+    }
+
+    // A length-header byte. Headers are the one part of the ring both sides
+    // touch outside a claimed batch: the writer reads the header at a `claim`
+    // the producer may be dropping and overwriting, so header bytes are only
+    // ever written and read atomically. AtomicU8 has u8's layout.
+    fn hdr_byte(&self, pos: u64) -> &AtomicU8 {
+        unsafe { &*(self.ptr().add((pos & self.mask) as usize) as *const AtomicU8) }
+    }
+
+    fn write_len_at(&self, pos: u64, len: u32) {
+        for (k, b) in len.to_be_bytes().iter().enumerate() {
+            self.hdr_byte(pos + k as u64).store(*b, Ordering::Release);
+        }
+    }
+
+    // Frame length (header included) of the frame starting at `pos`.
+    fn frame_len_at(&self, pos: u64) -> u64 {
+        let mut hdr = [0u8; 4];
+        for (k, b) in hdr.iter_mut().enumerate() {
+            *b = self.hdr_byte(pos + k as u64).load(Ordering::Acquire);
+        }
+        4 + u32::from_be_bytes(hdr) as u64
+    }
+
+    /// Frame and enqueue one packet. Never blocks on the socket.
+    pub(crate) fn push(&self, data: &[u8]) -> Push {
+        let need = 4 + data.len() as u64;
+        if need > self.buf.len() as u64 {
+            return match self.overflow {
+                Overflow::DropOldest => Push::Dropped,
+                Overflow::Disconnect => Push::Overflow,
+            };
+        }
+        let _g = self.producer.lock().unwrap();
+        let tail = self.tail.load(Ordering::Relaxed);
+        let mut dropped = 0u32;
+        while tail + need - self.head.load(Ordering::Acquire) > self.buf.len() as u64 {
+            match self.overflow {
+                Overflow::Disconnect => return Push::Overflow,
+                Overflow::DropOldest => {
+                    let c = self.claim.load(Ordering::Acquire);
+                    if c == tail || self.head.load(Ordering::Acquire) != c {
+                        // The space is held by a batch the writer is still
+                        // sending; displacing untaken frames would free
+                        // nothing until it completes.
+                        return Push::Dropped;
+                    }
+                    let next = c + self.frame_len_at(c);
+                    if self.claim
+                        .compare_exchange(c, next, Ordering::AcqRel, Ordering::Acquire)
+                        .is_ok()
+                    {
+                        dropped += 1;
+                        // Fails only if the writer already reclaimed it.
+                        let _ = self.head.compare_exchange(
+                            c, next, Ordering::AcqRel, Ordering::Relaxed);
+                    }
+                }
+            }
+        }
+        self.write_len_at(tail, data.len() as u32);
+        self.write_at(tail + 4, data);
+        self.tail.store(tail + need, Ordering::SeqCst);
+        let depth = tail + need - self.head.load(Ordering::Relaxed);
+        self.peak.fetch_max(depth, Ordering::Relaxed);
+        if self.idle.swap(false, Ordering::SeqCst) {
+            if let Some(t) = self.waiter.get() {
+                t.unpark();
+            }
+        }
+        Push::Queued { dropped }
+    }
+
+    /// Writer side: take up to `max_bytes` of whole frames (always at least
+    /// one). Returns the claimed [start, end) cursor range, or None if empty.
+    pub(crate) fn claim(&self, max_bytes: u64) -> Option<(u64, u64)> {
+        loop {
+            let c = self.claim.load(Ordering::Acquire);
+            let t = self.tail.load(Ordering::SeqCst);
+            // Frames the producer dropped before `c` are garbage; free them.
+            self.head.fetch_max(c, Ordering::Release);
+            if c == t {
+                return None;
+            }
+            let mut end = c + self.frame_len_at(c);
+            while end < t {
+                let next = end + self.frame_len_at(end);
+                if next - c > max_bytes {
+                    break;
+                }
+                end = next;
+            }
+            if self.claim
+                .compare_exchange(c, end, Ordering::AcqRel, Ordering::Acquire)
+                .is_ok()
+            {
+                return Some((c, end));
+            }
+        }
+    }
+
+    /// The claimed range as (up to) two contiguous slices of wire bytes.
+    pub(crate) fn spans(&self, start: u64, end: u64) -> (&[u8], &[u8]) {
+        let i = (start & self.mask) as usize;
+        let len = (end - start) as usize;
+        let first = len.min(self.buf.len() - i);
+        unsafe {
+            (
+                std::slice::from_raw_parts(self.ptr().add(i), first),
+                std::slice::from_raw_parts(self.ptr(), len - first),
+            )
+        }
+    }
+
+    /// Writer side: a claimed batch is on the wire; free its bytes.
+    pub(crate) fn release(&self, end: u64) {
+        self.head.fetch_max(end, Ordering::Release);
+    }
+
+    /// Writer side: register the thread a push unparks.
+    pub(crate) fn set_waiter(&self, t: Thread) {
+        let _ = self.waiter.set(t);
+    }
+
+    /// Writer side: announce an imminent park. Returns false if work arrived
+    /// in the meantime (the caller loops instead of parking).
+    pub(crate) fn prepare_park(&self) -> bool {
+        self.idle.store(true, Ordering::SeqCst);
+        if self.claim.load(Ordering::SeqCst) != self.tail.load(Ordering::SeqCst) {
+            self.idle.store(false, Ordering::SeqCst);
+            return false;
+        }
+        true
+    }
+
+    /// Wake the writer regardless of queued work (close / server stop).
+    pub(crate) fn wake(&self) {
+        self.idle.store(false, Ordering::SeqCst);
+        if let Some(t) = self.waiter.get() {
+            t.unpark();
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn drain(q: &EgressQueue) -> Vec<Vec<u8>> {
+        let mut wire = Vec::new();
+        while let Some((s, e)) = q.claim(u64::MAX) {
+            let (a, b) = q.spans(s, e);
+            wire.extend_from_slice(a);
+            wire.extend_from_slice(b);
+            q.release(e);
+        }
+        let mut out = Vec::new();
+        let mut i = 0;
+        while i < wire.len() {
+            let n = u32::from_be_bytes(wire[i..i + 4].try_into().unwrap()) as usize;
+            out.push(wire[i + 4..i + 4 + n].to_vec());
+            i += 4 + n;
+        }
+        out
+    }
+
+    // Frames come out in order, in wire format, across the ring's wrap point.
+    #[test]
+    fn frames_round_trip_across_wrap() {
+        let q = EgressQueue::new(0, Overflow::Disconnect);
+        let big = vec![7u8; q.capacity() / 2 - 100];
+        for round in 0..5u8 {
+            assert_eq!(q.push(&big), Push::Queued { dropped: 0 });
+            assert_eq!(q.push(&[round; 3]), Push::Queued { dropped: 0 });
+            let got = drain(&q);
+            assert_eq!(got, vec![big.clone(), vec![round; 3]]);
+            assert_eq!(q.depth(), 0);
+        }
+    }
+
+    // One claim spans many frames (one vectored write), bounded by max_bytes
+    // but never below a single frame.
+    #[test]
+    fn claim_batches_whole_frames() {
+        let q = EgressQueue::new(0, Overflow::Disconnect);
+        for _ in 0..10 {
+            q.push(&[1u8; 96]); // 100 bytes framed
+        }
+        let (s, e) = q.claim(350).unwrap();
+        assert_eq!(e - s, 300, "three whole frames fit in 350 bytes");
+        q.release(e);
+        let (s, e) = q.claim(10).unwrap();
+        assert_eq!(e - s, 100, "a batch always carries at least one frame");
+        q.release(e);
+        assert_eq!(q.depth(), 600);
+    }
+
+    // Disconnect policy: a frame that doesn't fit reports Overflow and the
+    // queue keeps what it had.
+    #[test]
+    fn disconnect_policy_reports_overflow() {
+        let q = EgressQueue::new(0, Overflow::Disconnect);
+        let chunk = vec![0u8; q.capacity() / 4 - 4];
+        for _ in 0..4 {
+            assert_eq!(q.push(&chunk), Push::Queued { dropped: 0 });
+        }
+        assert_eq!(q.push(&[1]), Push::Overflow);
+        assert_eq!(q.depth(), q.capacity() as u64);
+    }
+
+    // DropOldest displaces untaken frames; frames inside an in-flight batch
+    // are never touched, so the new frame is dropped instead.
+    #[test]
+    fn drop_oldest_spares_in_flight_batch() {
+        let q = EgressQueue::new(0, Overflow::DropOldest);
+        let chunk = vec![0u8; q.capacity() / 4 - 4];
+        for i in 0..4u8 {
+            let mut c = chunk.clone();
+            c[0] = i;
+            q.push(&c);
+        }
+        assert_eq!(q.push(&[9]), Push::Queued { dropped: 1 });
+        let got = drain(&q);
+        assert_eq!(got.len(), 4);
+        assert_eq!(got[0][0], 1, "the oldest frame was displaced");
+        assert_eq!(got[3], vec![9]);
+
+        for _ in 0..4 {
+            q.push(&chunk);
+        }
+        let (_, e) = q.claim(u64::MAX).unwrap(); // writer stalls holding it all
+        assert_eq!(q.push(&[1]), Push::Dropped);
+        q.release(e);
+        assert_eq!(q.push(&[1]), Push::Queued { dropped: 0 });
+    }
+
+    // A concurrent writer sees every byte exactly once and in order.
+    #[test]
+    fn concurrent_producer_and_writer() {
+        use std::sync::Arc;
+        let q = Arc::new(EgressQueue::new(0, Overflow::Disconnect));
+        let w = q.clone();
+        let reader = std::thread::spawn(move || {
+            let mut seen = 0u32;
+            while seen < 20_000 {
+                for f in drain(&w) {
+                    assert_eq!(u32::from_le_bytes(f[..4].try_into().unwrap()), seen);
+                    seen += 1;
+                }
+            }
+        });
+        let mut i = 0u32;
+        while i < 20_000 {
+            let mut f = i.to_le_bytes().to_vec();
+            f.resize(4 + (i as usize % 300), 0xAB);
+            match q.push(&f) {
+                Push::Queued { .. } => i += 1,
+                _ => std::thread::yield_now(),
+            }
+        }
+        reader.join().unwrap();
+    }
+}
@@ -4,6 +4,12 @@
 //! * [`ss_osc_configure`] — (re)bind the cue server (port, loopback, on/off).
 //! * [`ss_osc_send`]      — send one OSC packet to an arbitrary host:port
 //!                          (off the audio thread).
+//! * [`ss_osc_send_addr`] / [`ss_osc_send_batch`] — send to already-resolved
+//!                          [`SsOscAddr`]s, one packet or a whole batch (one
+//!                          `sendmmsg` per family on Linux). The command
+//!                          transport's reply path: origins arrive as packed
+//!                          addresses ([`ss_osc_ingress_start_with_addr`]), so a
+//!                          reply never formats or resolves a host string.
 //!
 //! Dual-stack: the cue server binds both IPv4 and IPv6 (loopback → 127.0.0.1 +
 //! ::1, all-interfaces → 0.0.0.0 + ::); outbound resolves the destination and
@@ -18,6 +24,8 @@
 //! touches the audio thread.
 
 use std::ffi::c_void;
+#[cfg(target_os = "linux")]
+use std::os::fd::AsRawFd;
 use std::io::ErrorKind;
 use std::net::{IpAddr, Ipv6Addr, SocketAddr, SocketAddrV6, ToSocketAddrs, UdpSocket};
 use std::slice;
@@ -26,7 +34,7 @@ use std::sync::{Arc, Mutex};
 use std::thread::JoinHandle;
 use std::time::Duration;
 
-use socket2::{Domain, Protocol, Socket, Type};
+use socket2::{Domain, Protocol, SockAddr, Socket, Type};
 
 use supersonic_osc::{decode_packet, encode, OscArg, OscPacket};
 // Emit-callback shape + panic fence, shared across the subsystem C ABIs.
@@ -53,6 +61,51 @@ impl Host {
     }
 }
 
+/// A resolved UDP endpoint as the OS lays it out: the raw `sockaddr_in` /
+/// `sockaddr_in6` bytes plus their length. Fixed-size and `Copy`, so a transport
+/// can key, compare and store origins without formatting or resolving strings;
+/// the bytes go straight back to the kernel as a send's destination. Opaque to
+/// C++. Must match `SsOscAddr` in cpp/ss_osc.h.
+#[repr(C)]
+#[derive(Clone, Copy, PartialEq, Eq, Debug)]
+pub struct SsOscAddr {
+    pub len: u32,
+    pub bytes: [u8; SS_OSC_ADDR_BYTES],
+}
+
+/// sizeof(sockaddr_in6) on every supported platform; sockaddr_in is smaller.
+pub const SS_OSC_ADDR_BYTES: usize = 28;
+
+impl SsOscAddr {
+    pub fn from_socket(addr: SocketAddr) -> Self {
+        let sa = SockAddr::from(addr);
+        let len = (sa.len() as usize).min(SS_OSC_ADDR_BYTES);
+        let mut out = SsOscAddr { len: len as u32, bytes: [0; SS_OSC_ADDR_BYTES] };
+        // SAFETY: `sa` holds at least `sa.len()` initialised bytes.
+        let raw = unsafe { slice::from_raw_parts(sa.as_ptr() as *const u8, len) };
+        out.bytes[..len].copy_from_slice(raw);
+        out
+    }
+
+    pub fn to_socket(&self) -> Option<SocketAddr> {
+        let len = self.len as usize;
+        if len == 0 || len > SS_OSC_ADDR_BYTES {
+            return None;
+        }
+        // SAFETY: the storage is zeroed and at least 128 bytes; we copy `len`
+        // bytes of what the OS produced for this family and report that length.
+        let (_, sa) = unsafe {
+            SockAddr::try_init(|storage, slen| {
+                std::ptr::copy_nonoverlapping(self.bytes.as_ptr(), storage as *mut u8, len);
+                *slen = len as _;
+                Ok(())
+            })
+        }
+        .ok()?;
+        sa.as_socket()
+    }
+}
+
 /// A running cue server: one recv thread per bound socket (IPv4 + IPv6) sharing a
 /// stop flag. Dropping it stops the threads (≤ the read timeout) and closes the
 /// sockets.
@@ -207,6 +260,10 @@ impl SsOsc {
         cs.loopback = loopback;
     }
 
+    fn socket_for(&self, addr: &SocketAddr) -> Option<&UdpSocket> {
+        if addr.is_ipv4() { self.send4.as_ref() } else { self.send6.as_ref() }
+    }
+
     fn send(&self, host: &str, port: u16, data: &[u8]) {
         let resolved = match (host, port).to_socket_addrs() {
             Ok(it) => it,
@@ -215,13 +272,90 @@ impl SsOsc {
         // Send to the first resolved address whose family socket exists — so a
         // dual-stack host works, and a v6-only-down host still reaches IPv4.
         for addr in resolved {
-            let sock = if addr.is_ipv4() { self.send4.as_ref() } else { self.send6.as_ref() };
-            if let Some(s) = sock {
+            if let Some(s) = self.socket_for(&addr) {
                 let _ = s.send_to(data, addr);
                 return;
             }
         }
     }
+
+    fn send_addr(&self, addr: &SsOscAddr, data: &[u8]) -> bool {
+        let Some(sa) = addr.to_socket() else { return false };
+        match self.socket_for(&sa) {
+            Some(s) => s.send_to(data, sa).is_ok(),
+            None => false,
+        }
+    }
+
+    // Send a batch, preserving order within each family. Linux hands each
+    // family's datagrams to the kernel in as few sendmmsg calls as it takes;
+    // elsewhere this is a send_to loop. Returns how many were sent.
+    #[cfg(target_os = "linux")]
+    fn send_batch(&self, batch: &[(&SsOscAddr, &[u8])]) -> usize {
+        let family = |a: &SsOscAddr| {
+            if a.len < 2 { return -1; }
+            i32::from(u16::from_ne_bytes([a.bytes[0], a.bytes[1]]))
+        };
+        let mut sent = 0;
+        for (af, sock) in [(libc::AF_INET, &self.send4), (libc::AF_INET6, &self.send6)] {
+            let Some(sock) = sock else { continue };
+            let group: Vec<&(&SsOscAddr, &[u8])> =
+                batch.iter().filter(|(a, _)| family(a) == af).collect();
+            if !group.is_empty() {
+                sent += sendmmsg_all(sock, &group);
+            }
+        }
+        sent
+    }
+
+    #[cfg(not(target_os = "linux"))]
+    fn send_batch(&self, batch: &[(&SsOscAddr, &[u8])]) -> usize {
+        batch.iter().filter(|(a, d)| self.send_addr(a, d)).count()
+    }
+}
+
+// Kernel cap on one sendmmsg call (UIO_MAXIOV).
+#[cfg(target_os = "linux")]
+const MAX_MMSG: usize = 1024;
+
+// Send every datagram in `group` (all one family) from `sock`, in order. A
+// datagram the kernel refuses outright (unreachable, too large) is skipped, as
+// a failed send_to would be; the rest still go.
+#[cfg(target_os = "linux")]
+fn sendmmsg_all(sock: &UdpSocket, group: &[&(&SsOscAddr, &[u8])]) -> usize {
+    let mut iov: Vec<libc::iovec> = group
+        .iter()
+        .map(|(_, d)| libc::iovec { iov_base: d.as_ptr() as *mut c_void, iov_len: d.len() })
+        .collect();
+    let mut hdrs: Vec<libc::mmsghdr> = Vec::with_capacity(group.len());
+    for (i, (addr, _)) in group.iter().enumerate() {
+        // SAFETY: all-zero is a valid mmsghdr (it has private padding fields on
+        // some targets, so it can't be built with a literal).
+        let mut h: libc::mmsghdr = unsafe { std::mem::zeroed() };
+        // The kernel only reads the name; the cast drops const for the C type.
+        h.msg_hdr.msg_name = addr.bytes.as_ptr() as *mut c_void;
+        h.msg_hdr.msg_namelen = addr.len as libc::socklen_t;
+        h.msg_hdr.msg_iov = &mut iov[i];
+        h.msg_hdr.msg_iovlen = 1;
+        hdrs.push(h);
+    }
+    let fd = sock.as_raw_fd();
+    let (mut at, mut sent) = (0, 0);
+    while at < hdrs.len() {
+        let n = (hdrs.len() - at).min(MAX_MMSG);
+        // SAFETY: hdrs[at..at + n] point at iov entries, datagrams and address
+        // bytes that all outlive the call.
+        let r = unsafe { libc::sendmmsg(fd, hdrs.as_mut_ptr().add(at), n as u32, 0) };
+        if r > 0 {
+            at += r as usize;
+            sent += r as usize;
+        } else if r < 0 && std::io::Error::last_os_error().kind() == ErrorKind::Interrupted {
+            continue;
+        } else {
+            at += 1; // hdrs[at] was refused; move past it
+        }
+    }
+    sent
 }
 
 /// A raw OSC ingress server: receives datagrams on a bound port (IPv4 + IPv6)
@@ -355,18 +489,21 @@ fn bind_ingress(bind_addr: &str, port: u16) -> Vec<UdpSocket> {
     socks
 }
 
-fn start_ingress_src(host: HostSrc, port: u16, bind_addr: &str) -> Option<SsOscIngress> {
-    let socks = bind_ingress(bind_addr, port);
+// One recv thread per bound socket, each running `serve`.
+fn spawn_ingress<F>(socks: Vec<UdpSocket>, serve: F) -> Option<SsOscIngress>
+where
+    F: Fn(UdpSocket, Arc<AtomicBool>) + Clone + Send + 'static,
+{
     if socks.is_empty() {
         return None;
     }
     let stop = Arc::new(AtomicBool::new(false));
     let mut joins = Vec::new();
     for sock in socks {
-        let (t_stop, t_host) = (stop.clone(), host);
+        let (t_stop, t_serve) = (stop.clone(), serve.clone());
         if let Ok(j) = std::thread::Builder::new()
             .name("ss-osc-ingress".into())
-            .spawn(move || run_raw_server_src(sock, t_stop, t_host))
+            .spawn(move || t_serve(sock, t_stop))
         {
             joins.push(j);
         }
@@ -374,6 +511,44 @@ fn start_ingress_src(host: HostSrc, port: u16, bind_addr: &str) -> Option<SsOscI
     Some(SsOscIngress { stop, joins })
 }
 
+fn start_ingress_src(host: HostSrc, port: u16, bind_addr: &str) -> Option<SsOscIngress> {
+    spawn_ingress(bind_ingress(bind_addr, port), move |sock, stop| {
+        run_raw_server_src(sock, stop, host)
+    })
+}
+
+// ── Address-bearing ingress ──────────────────────────────────────────────────
+// The same, but the sender arrives as a packed SsOscAddr instead of an ip string:
+// no per-datagram formatting or allocation, and the transport can hand the very
+// same bytes back to ss_osc_send_addr / ss_osc_send_batch to reply.
+
+/// emit-with-address callback: (ctx, src, osc, len). `src` is valid only for the
+/// call; `osc`/`len` is the verbatim datagram.
+pub type EmitAddrFn = extern "C" fn(*mut c_void, *const SsOscAddr, *const u8, u32);
+
+#[derive(Clone, Copy)]
+struct HostAddr {
+    ctx: *mut c_void,
+    emit: EmitAddrFn,
+}
+unsafe impl Send for HostAddr {}
+unsafe impl Sync for HostAddr {}
+
+fn run_raw_server_addr(socket: UdpSocket, stop: Arc<AtomicBool>, host: HostAddr) {
+    let _ = socket.set_read_timeout(Some(Duration::from_millis(100)));
+    let mut buf = vec![0u8; 65536];
+    while !stop.load(Ordering::Relaxed) {
+        match socket.recv_from(&mut buf) {
+            Ok((n, src)) => no_unwind((), || {
+                let addr = SsOscAddr::from_socket(src);
+                (host.emit)(host.ctx, &addr, buf.as_ptr(), n as u32)
+            }),
+            Err(e) if e.kind() == ErrorKind::WouldBlock || e.kind() == ErrorKind::TimedOut => {}
+            Err(_) => break,
+        }
+    }
+}
+
 // ── C ABI ────────────────────────────────────────────────────────────────────
 
 /// Create the OSC subsystem. Returns an owning pointer (null on failure); free
@@ -442,6 +617,82 @@ pub unsafe extern "C" fn ss_osc_send(
     });
 }
 
+/// Resolve `host`:`port` once into `out` (the first address an outbound socket
+/// of that family exists for), so later sends skip resolution. `host` is a byte
+/// string (ptr+len; an IPv4/IPv6 literal or a hostname). 1 on success, 0 if it
+/// doesn't resolve.
+#[no_mangle]
+pub unsafe extern "C" fn ss_osc_addr_resolve(
+    handle: *mut SsOsc,
+    host: *const u8,
+    host_len: u32,
+    port: i32,
+    out: *mut SsOscAddr,
+) -> i32 {
+    if handle.is_null() || host.is_null() || out.is_null() || port <= 0 || port > 65535 {
+        return 0;
+    }
+    let me = &*handle;
+    let host_bytes = slice::from_raw_parts(host, host_len as usize);
+    no_unwind(0, || {
+        let Ok(h) = std::str::from_utf8(host_bytes) else { return 0 };
+        let Ok(resolved) = (h, port as u16).to_socket_addrs() else { return 0 };
+        for addr in resolved {
+            if me.socket_for(&addr).is_some() {
+                *out = SsOscAddr::from_socket(addr);
+                return 1;
+            }
+        }
+        0
+    })
+}
+
+/// Send one OSC packet to a resolved address. 1 if the kernel took it.
+#[no_mangle]
+pub unsafe extern "C" fn ss_osc_send_addr(
+    handle: *mut SsOsc,
+    addr: *const SsOscAddr,
+    data: *const u8,
+    len: u32,
+) -> i32 {
+    if handle.is_null() || addr.is_null() || data.is_null() {
+        return 0;
+    }
+    let me = &*handle;
+    let data = slice::from_raw_parts(data, len as usize);
+    no_unwind(0, || me.send_addr(&*addr, data) as i32)
+}
+
+/// One datagram of a [`ss_osc_send_batch`]. Must match `SsOscDatagram` in
+/// cpp/ss_osc.h.
+#[repr(C)]
+pub struct SsOscDatagram {
+    pub addr: *const SsOscAddr,
+    pub data: *const u8,
+    pub len: u32,
+}
+
+/// Send `count` datagrams. Order is kept per address family; on Linux each
+/// family goes to the kernel in as few `sendmmsg` calls as it takes (one per
+/// 1024 datagrams). Returns how many were sent.
+#[no_mangle]
+pub unsafe extern "C" fn ss_osc_send_batch(
+    handle: *mut SsOsc,
+    dgrams: *const SsOscDatagram,
+    count: u32,
+) -> u32 {
+    if handle.is_null() || dgrams.is_null() || count == 0 {
+        return 0;
+    }
+    let me = &*handle;
+    let batch: Vec<(&SsOscAddr, &[u8])> = slice::from_raw_parts(dgrams, count as usize)
+        .iter()
+        .filter(|d| !d.addr.is_null() && !d.data.is_null())
+        .map(|d| (&*d.addr, slice::from_raw_parts(d.data, d.len as usize)))
+        .collect();
+    no_unwind(0, || me.send_batch(&batch) as u32)
+}
+
 /// Start a raw OSC ingress server on `port`: `loopback` != 0 binds 127.0.0.1 +
 /// ::1, else 0.0.0.0 + ::. Received datagrams are delivered to `emit` as raw OSC
 /// bytes (kind = broadcast). Returns an owning pointer (null on bind failure);
@@ -494,6 +745,38 @@ pub unsafe extern "C" fn ss_osc_ingress_start_with_src(
     })
 }
 
+/// Start an address-bearing OSC ingress: like
+/// [`ss_osc_ingress_start_with_src`], but each datagram's sender arrives as a
+/// packed [`SsOscAddr`] (no string formatting), ready to pass back to
+/// [`ss_osc_send_addr`] / [`ss_osc_send_batch`]. Null on bind failure; free with
+/// [`ss_osc_ingress_stop`]. `ctx`/`emit` must outlive it.
+#[no_mangle]
+pub unsafe extern "C" fn ss_osc_ingress_start_with_addr(
+    ctx: *mut c_void,
+    emit: EmitAddrFn,
+    port: i32,
+    bind_addr: *const u8,
+    bind_addr_len: u32,
+) -> *mut SsOscIngress {
+    no_unwind(std::ptr::null_mut(), || {
+        if port <= 0 || port > 65535 {
+            return std::ptr::null_mut();
+        }
+        let addr = if bind_addr.is_null() {
+            ""
+        } else {
+            std::str::from_utf8(slice::from_raw_parts(bind_addr, bind_addr_len as usize)).unwrap_or("")
+        };
+        let host = HostAddr { ctx, emit };
+        match spawn_ingress(bind_ingress(addr, port as u16), move |sock, stop| {
+            run_raw_server_addr(sock, stop, host)
+        }) {
+            Some(srv) => Box::into_raw(Box::new(srv)),
+            None => std::ptr::null_mut(),
+        }
+    })
+}
+
 /// Stop the ingress recv threads and close the sockets.
 #[no_mangle]
 pub unsafe extern "C" fn ss_osc_ingress_stop(handle: *mut SsOscIngress) {
@@ -747,6 +1030,125 @@ mod tests {
         drop(cap);
     }
 
+    // A packed address survives the round trip to SocketAddr for both families,
+    // and equal endpoints pack to equal bytes (the transport keys on them).
+    #[test]
+    fn addr_round_trip() {
+        let v4: SocketAddr = "10.1.2.3:4000".parse().unwrap();
+        let v6: SocketAddr = "[fe80::1]:57110".parse().unwrap();
+        for sa in [v4, v6] {
+            let a = SsOscAddr::from_socket(sa);
+            assert_eq!(a.to_socket(), Some(sa));
+            assert_eq!(a, SsOscAddr::from_socket(sa));
+        }
+        assert_ne!(SsOscAddr::from_socket(v4), SsOscAddr::from_socket("10.1.2.3:4001".parse().unwrap()));
+        let empty = SsOscAddr { len: 0, bytes: [0; SS_OSC_ADDR_BYTES] };
+        assert_eq!(empty.to_socket(), None);
+    }
+
+    // Address-bearing ingress hands over the sender as a packed address that
+    // replies go straight back to, singly and batched, in order.
+    #[test]
+    fn ingress_with_addr_replies_by_address() {
+        struct Cap(Mutex<Vec<(SsOscAddr, Vec<u8>)>>);
+        extern "C" fn collect_addr(ctx: *mut c_void, src: *const SsOscAddr, osc: *const u8, len: u32) {
+            let c = unsafe { &*(ctx as *const Cap) };
+            let bytes = unsafe { slice::from_raw_parts(osc, len as usize) }.to_vec();
+            c.0.lock().unwrap().push((unsafe { *src }, bytes));
+        }
+
+        let cap = Box::new(Cap(Mutex::new(Vec::new())));
+        let ctx = &*cap as *const Cap as *mut c_void;
+        let port = free_port();
+        let bind = "127.0.0.1";
+        let ing = unsafe {
+            ss_osc_ingress_start_with_addr(ctx, collect_addr, port as i32, bind.as_ptr(), bind.len() as u32)
+        };
+        assert!(!ing.is_null());
+        std::thread::sleep(Duration::from_millis(150));
+
+        let client = UdpSocket::bind("127.0.0.1:0").unwrap();
+        client.set_read_timeout(Some(Duration::from_secs(2))).unwrap();
+        let msg = encode("/status", &[]);
+        assert!(wait_until(|| {
+            let _ = client.send_to(&msg, ("127.0.0.1", port));
+            !cap.0.lock().unwrap().is_empty()
+        }));
+        let (src, bytes) = cap.0.lock().unwrap()[0].clone();
+        assert_eq!(decode(&bytes).unwrap().addr, "/status");
+        assert_eq!(src.to_socket(), Some(client.local_addr().unwrap()));
+
+        let collector = Box::new(Collector(Mutex::new(Vec::new())));
+        let h = ss_osc_create(&*collector as *const Collector as *mut c_void, collect);
+        let mut buf = [0u8; 256];
+
+        let one = encode("/one", &[]);
+        assert_eq!(unsafe { ss_osc_send_addr(h, &src, one.as_ptr(), one.len() as u32) }, 1);
+        let (n, _) = client.recv_from(&mut buf).expect("single reply");
+        assert_eq!(decode(&buf[..n]).unwrap().addr, "/one");
+
+        let replies: Vec<Vec<u8>> = (0..40).map(|i| encode("/r", &[OscArg::Int(i)])).collect();
+        let dgrams: Vec<SsOscDatagram> = replies
+            .iter()
+            .map(|r| SsOscDatagram { addr: &src, data: r.as_ptr(), len: r.len() as u32 })
+            .collect();
+        assert_eq!(unsafe { ss_osc_send_batch(h, dgrams.as_ptr(), dgrams.len() as u32) }, 40);
+        for i in 0..40 {
+            let (n, _) = client.recv_from(&mut buf).expect("batched reply");
+            assert_eq!(decode(&buf[..n]).unwrap().args.first().and_then(|a| a.as_i32()), Some(i));
+        }
+
+        // Resolving once gives the same bytes the ingress reported.
+        let mut resolved = SsOscAddr { len: 0, bytes: [0; SS_OSC_ADDR_BYTES] };
+        let ip = "127.0.0.1";
+        let cport = client.local_addr().unwrap().port() as i32;
+        assert_eq!(unsafe { ss_osc_addr_resolve(h, ip.as_ptr(), ip.len() as u32, cport, &mut resolved) }, 1);
+        assert_eq!(resolved, src);
+
+        unsafe { ss_osc_destroy(h) };
+        unsafe { ss_osc_ingress_stop(ing) };
+        drop(collector);
+        drop(cap);
+    }
+
+    // A batch mixing families reaches both listeners, each in order.
+    #[test]
+    fn send_batch_mixed_families() {
+        if !v6_loopback_available() {
+            eprintln!("skip send_batch_mixed_families: no IPv6 loopback here");
+            return;
+        }
+        let collector = Box::new(Collector(Mutex::new(Vec::new())));
+        let h = ss_osc_create(&*collector as *const Collector as *mut c_void, collect);
+        let l4 = UdpSocket::bind("127.0.0.1:0").unwrap();
+        let l6 = UdpSocket::bind("[::1]:0").unwrap();
+        for l in [&l4, &l6] {
+            l.set_read_timeout(Some(Duration::from_secs(2))).unwrap();
+        }
+        let a4 = SsOscAddr::from_socket(l4.local_addr().unwrap());
+        let a6 = SsOscAddr::from_socket(l6.local_addr().unwrap());
+        let pkts: Vec<Vec<u8>> = (0..20).map(|i| encode("/m", &[OscArg::Int(i)])).collect();
+        let dgrams: Vec<SsOscDatagram> = pkts
+            .iter()
+            .enumerate()
+            .map(|(i, p)| SsOscDatagram {
+                addr: if i % 2 == 0 { &a4 } else { &a6 },
+                data: p.as_ptr(),
+                len: p.len() as u32,
+            })
+            .collect();
+        assert_eq!(unsafe { ss_osc_send_batch(h, dgrams.as_ptr(), dgrams.len() as u32) }, 20);
+        let mut buf = [0u8; 256];
+        for (l, first) in [(&l4, 0), (&l6, 1)] {
+            for i in (first..20).step_by(2) {
+                let (n, _) = l.recv_from(&mut buf).expect("batched datagram");
+                assert_eq!(decode(&buf[..n]).unwrap().args.first().and_then(|a| a.as_i32()), Some(i));
+            }
+        }
+        unsafe { ss_osc_destroy(h) };
+        drop(collector);
+    }
+
     // "Allow OSC From Other Computers" semantic: loopback-only binds 127.0.0.1
     // (+ ::1), so a datagram to this host's real IP is NOT received; all-interfaces
     // binds 0.0.0.0 (+ ::) and IS. Skipped if the box has no non-loopback IPv4.
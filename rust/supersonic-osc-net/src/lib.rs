@@ -13,7 +13,10 @@ pub mod ffi;
 
 // Kernel-ACL'd local transports (the UDP control port's owner-only siblings):
 // UDS datagram, length-prefix-framed stream servers (UDS + TCP), and the
-// Windows named-pipe analogue behind the same stream ABI.
+// Windows named-pipe analogue behind the same stream ABI. Stream connections
+// send through per-connection egress queues.
+#[cfg(not(target_arch = "wasm32"))]
+pub mod egress;
 #[cfg(not(target_arch = "wasm32"))]
 pub mod pipe;
 #[cfg(not(target_arch = "wasm32"))]
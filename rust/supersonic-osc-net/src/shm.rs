@@ -19,7 +19,7 @@
 
 use std::sync::atomic::{fence, AtomicI32, AtomicU32, Ordering};
 
-const SEG_MAGIC: u32 = 0x5C09_E008; // shm_segment_header::MAGIC (E008)
+const SEG_MAGIC: u32 = 0x5C09_E00A; // shm_segment_header::MAGIC (E00A)
 const MESSAGE_MAGIC: u32 = 0xDEAD_BEEF; // ring/ring.h
 const PADDING_MAGIC: u32 = 0xBADD_CAFE;
 const MSG_HDR: usize = 16; // sizeof(Message)
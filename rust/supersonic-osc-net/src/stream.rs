@@ -16,6 +16,13 @@
 //! client's notify subscriptions — subscription lifetime == connection
 //! lifetime. `on_closed` is suppressed during server stop (the host is
 //! tearing down and must not be re-entered).
+//!
+//! Egress (socket backend): every connection owns a bounded egress queue
+//! (`egress.rs`) drained by its own writer thread, so `send` only copies the
+//! frame in and never blocks on a socket — a stalled client backs up its own
+//! queue, not the gateway or any other client. The writer batches every
+//! queued frame into one vectored write. A full queue either drops the oldest
+//! untaken frames or closes the connection (`ss_osc_stream_set_egress`).
 
 use std::ffi::c_void;
 use std::slice;
@@ -49,6 +56,36 @@ pub(crate) trait StreamServerImpl: Send {
     fn port(&self) -> i32 {
         0
     }
+    /// Egress queue size + overflow policy for connections accepted from now
+    /// on. Backends that send synchronously (named pipes) have no queue.
+    fn set_egress(&self, _queue_bytes: usize, _overflow: Overflow) {}
+    /// Bytes queued for one connection; None if unknown or unqueued.
+    fn queue_depth(&self, _conn_id: u32) -> Option<u64> {
+        None
+    }
+    fn egress_stats(&self) -> SsOscStreamEgressStats {
+        SsOscStreamEgressStats::default()
+    }
+}
+
+/// Egress queue snapshot across a server's connections. Must match
+/// `SsOscStreamEgressStats` in `cpp/ss_osc.h`.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct SsOscStreamEgressStats {
+    /// Live connections.
+    pub connections: u32,
+    pub _reserved: u32,
+    /// Deepest per-connection queue right now, bytes.
+    pub max_queue_bytes: u64,
+    /// Deepest any live connection's queue has been, bytes.
+    pub peak_queue_bytes: u64,
+    /// Sum of every connection's queue, bytes.
+    pub queued_bytes: u64,
+    /// Frames discarded by the drop-oldest policy (cumulative).
+    pub dropped_frames: u64,
+    /// Connections closed by the disconnect policy (cumulative).
+    pub overflow_closes: u64,
 }
 
 /// The host callbacks + opaque context, shared by every reader thread.
@@ -72,7 +109,10 @@ impl Host {
     }
 }
 
-/// Frame `data` for the wire: 4-byte big-endian length + payload.
+/// Frame `data` for the wire: 4-byte big-endian length + payload. Used by the
+/// named-pipe backend's synchronous send; the socket backend frames in place
+/// inside each connection's egress queue.
+#[cfg_attr(not(windows), allow(dead_code))]
 pub(crate) fn frame_packet(data: &[u8]) -> Vec<u8> {
     let mut out = Vec::with_capacity(4 + data.len());
     out.extend_from_slice(&(data.len() as u32).to_be_bytes());
@@ -103,33 +143,40 @@ pub(crate) fn drain_frames(acc: &mut Vec<u8>, host: &Host, conn: u32) -> bool {
 // ── Socket backend (TCP + UDS stream) ────────────────────────────────────────
 
 use std::collections::HashMap;
-use std::io::{ErrorKind, Read, Write};
+use std::io::{ErrorKind, IoSlice, Read, Write};
 use std::net::{Shutdown, TcpListener, TcpStream};
 #[cfg(unix)]
 use std::os::unix::net::{UnixListener, UnixStream};
 use std::path::PathBuf;
-use std::sync::atomic::{AtomicBool, AtomicU32, Ordering};
+use std::sync::atomic::{AtomicBool, AtomicU32, AtomicU64, AtomicUsize, Ordering};
 use std::sync::{Arc, Mutex};
 use std::thread::JoinHandle;
 use std::time::Duration;
 
 use supersonic_osc::ffi::no_unwind;
 
-/// Bound on a single blocking send. A client that hasn't drained its socket
-/// within this long is treated as stuck: the write fails and the connection
-/// is dropped, so one non-reading client can't wedge the gateway thread (the
-/// sole caller of send/broadcast) indefinitely on a full kernel send buffer.
+use crate::egress::{EgressQueue, Overflow, Push, DEFAULT_QUEUE_BYTES};
+
+/// Bound on a single blocking write by a connection's writer thread. A client
+/// that hasn't drained its socket within this long is treated as stuck: the
+/// write fails and the connection is dropped. Only that connection's writer
+/// waits it out — senders just enqueue.
 const WRITE_TIMEOUT: Duration = Duration::from_secs(2);
 
-/// A connection's write half: framed sends + a shutdown to unblock its reader.
-trait ConnWriter: Send {
-    fn write_all_bytes(&mut self, data: &[u8]) -> std::io::Result<()>;
+/// Most bytes handed to one vectored write. Frames beyond it stay untaken, so
+/// a drop-oldest queue can still displace them while the batch is in flight.
+const MAX_BATCH: u64 = 64 * 1024;
+
+/// A connection's write half: vectored sends + a shutdown to unblock its
+/// reader and writer.
+trait ConnWriter: Send + Sync {
+    fn write_vectored_bytes(&mut self, bufs: &[IoSlice<'_>]) -> std::io::Result<usize>;
     fn set_write_timeout(&self, d: Duration);
     fn shutdown_both(&self);
 }
 impl ConnWriter for TcpStream {
-    fn write_all_bytes(&mut self, data: &[u8]) -> std::io::Result<()> {
-        self.write_all(data)
+    fn write_vectored_bytes(&mut self, bufs: &[IoSlice<'_>]) -> std::io::Result<usize> {
+        self.write_vectored(bufs)
     }
     fn set_write_timeout(&self, d: Duration) {
         let _ = TcpStream::set_write_timeout(self, Some(d));
@@ -140,8 +187,8 @@ impl ConnWriter for TcpStream {
 }
 #[cfg(unix)]
 impl ConnWriter for UnixStream {
-    fn write_all_bytes(&mut self, data: &[u8]) -> std::io::Result<()> {
-        self.write_all(data)
+    fn write_vectored_bytes(&mut self, bufs: &[IoSlice<'_>]) -> std::io::Result<usize> {
+        self.write_vectored(bufs)
     }
     fn set_write_timeout(&self, d: Duration) {
         let _ = UnixStream::set_write_timeout(self, Some(d));
@@ -193,14 +240,43 @@ impl Acceptor for UnixListener {
     }
 }
 
-type Writer = Arc<Mutex<Box<dyn ConnWriter>>>;
+/// One live connection as the registry sees it: its egress queue (drained by
+/// its own writer thread) and a handle used only to shut the socket down.
+struct Conn {
+    queue: EgressQueue,
+    ctl: Box<dyn ConnWriter>,
+    closing: AtomicBool,
+}
+
+impl Conn {
+    fn close(&self) {
+        self.closing.store(true, Ordering::Release);
+        self.ctl.shutdown_both();
+        self.queue.wake();
+    }
+}
 
-/// State shared between the accept loop, reader threads, and the C ABI.
+/// State shared between the accept loop, reader/writer threads, and the C ABI.
 struct Shared {
     stop: AtomicBool,
-    conns: Mutex<HashMap<u32, Writer>>,
+    conns: Mutex<HashMap<u32, Arc<Conn>>>,
     next_id: AtomicU32, // conn ids from 1, never reused (0 = in-process)
-    readers: Mutex<Vec<JoinHandle<()>>>,
+    threads: Mutex<Vec<JoinHandle<()>>>,
+    // Egress config for connections accepted from now on.
+    queue_bytes: AtomicUsize,
+    overflow: AtomicU32,
+    // Cumulative across every connection, closed ones included.
+    dropped_frames: AtomicU64,
+    overflow_closes: AtomicU64,
+}
+
+impl Shared {
+    // Remove a connection and shut it down; its reader then fires on_closed.
+    fn evict(&self, id: u32) {
+        if let Some(c) = self.conns.lock().unwrap().remove(&id) {
+            c.close();
+        }
+    }
 }
 
 struct SocketServer {
@@ -212,39 +288,68 @@ struct SocketServer {
 
 impl StreamServerImpl for SocketServer {
     fn send(&self, conn_id: u32, data: &[u8]) -> bool {
-        // Clone the writer handle out of the registry, then write outside the
-        // registry lock — a slow client must not stall unrelated sends.
-        let writer = self.shared.conns.lock().unwrap().get(&conn_id).cloned();
-        let Some(writer) = writer else { return false };
-        if writer.lock().unwrap().write_all_bytes(&frame_packet(data)).is_ok() {
-            return true;
-        }
-        // Write failed or hit WRITE_TIMEOUT (stuck client): a partial frame may
-        // have gone out, desyncing this connection's framing, so evict it and
-        // shut it down. The reader wakes on the shutdown and fires on_closed,
-        // pruning the client from every audience.
-        if let Some(w) = self.shared.conns.lock().unwrap().remove(&conn_id) {
-            w.lock().unwrap().shutdown_both();
+        // Enqueue only — the connection's writer thread does the syscall, so a
+        // stalled client delays nobody but itself.
+        let conn = self.shared.conns.lock().unwrap().get(&conn_id).cloned();
+        let Some(conn) = conn else { return false };
+        match conn.queue.push(data) {
+            Push::Queued { dropped } => {
+                if dropped > 0 {
+                    self.shared.dropped_frames.fetch_add(dropped as u64, Ordering::Relaxed);
+                }
+                true
+            }
+            Push::Dropped => {
+                self.shared.dropped_frames.fetch_add(1, Ordering::Relaxed);
+                false
+            }
+            Push::Overflow => {
+                self.shared.overflow_closes.fetch_add(1, Ordering::Relaxed);
+                self.shared.evict(conn_id);
+                false
+            }
         }
-        false
     }
     fn port(&self) -> i32 {
         self.port
     }
+    fn set_egress(&self, queue_bytes: usize, overflow: Overflow) {
+        self.shared.queue_bytes.store(queue_bytes, Ordering::Relaxed);
+        self.shared.overflow.store(overflow as u32, Ordering::Relaxed);
+    }
+    fn queue_depth(&self, conn_id: u32) -> Option<u64> {
+        self.shared.conns.lock().unwrap().get(&conn_id).map(|c| c.queue.depth())
+    }
+    fn egress_stats(&self) -> SsOscStreamEgressStats {
+        let conns = self.shared.conns.lock().unwrap();
+        let mut s = SsOscStreamEgressStats {
+            connections: conns.len() as u32,
+            dropped_frames: self.shared.dropped_frames.load(Ordering::Relaxed),
+            overflow_closes: self.shared.overflow_closes.load(Ordering::Relaxed),
+            ..Default::default()
+        };
+        for c in conns.values() {
+            let depth = c.queue.depth();
+            s.queued_bytes += depth;
+            s.max_queue_bytes = s.max_queue_bytes.max(depth);
+            s.peak_queue_bytes = s.peak_queue_bytes.max(c.queue.peak());
+        }
+        s
+    }
 }
 
 impl Drop for SocketServer {
     fn drop(&mut self) {
         self.shared.stop.store(true, Ordering::Relaxed);
-        // Shut every connection down so blocked readers return immediately
-        // rather than waiting out their read timeout.
-        for w in self.shared.conns.lock().unwrap().values() {
-            w.lock().unwrap().shutdown_both();
+        // Shut every connection down so blocked readers and writers return
+        // immediately rather than waiting out their timeouts.
+        for c in self.shared.conns.lock().unwrap().values() {
+            c.close();
         }
         if let Some(j) = self.accept_join.take() {
             let _ = j.join();
         }
-        for j in self.shared.readers.lock().unwrap().drain(..) {
+        for j in self.shared.threads.lock().unwrap().drain(..) {
             let _ = j.join();
         }
         if let Some(p) = &self.path {
@@ -273,24 +378,66 @@ fn run_reader<C: ConnReader>(mut conn: C, id: u32, shared: Arc<Shared>, host: Ho
     }
     // Leave the registry, then tell the host — subscription lifetime ==
     // connection lifetime. Suppressed during stop: the host is tearing down.
-    if let Some(w) = shared.conns.lock().unwrap().remove(&id) {
-        w.lock().unwrap().shutdown_both();
-    }
+    shared.evict(id);
     if !shared.stop.load(Ordering::Relaxed) {
         host.closed(id);
     }
 }
 
-// Join and discard the handles of readers that have already exited, so the
-// registry tracks only live readers instead of growing with total-connections
-// across a long-running server's reconnect churn. Live readers are left in
-// place for the join-on-stop guarantee in SocketServer::drop.
-fn reap_finished_readers(shared: &Shared) {
-    let mut readers = shared.readers.lock().unwrap();
+// Write every byte of a claimed batch — many frames per syscall.
+fn write_batch(w: &mut dyn ConnWriter, a: &[u8], b: &[u8]) -> std::io::Result<()> {
+    let mut bufs = [IoSlice::new(a), IoSlice::new(b)];
+    let mut bufs = &mut bufs[..];
+    while !bufs.is_empty() {
+        match w.write_vectored_bytes(bufs) {
+            Ok(0) => return Err(ErrorKind::WriteZero.into()),
+            Ok(n) => IoSlice::advance_slices(&mut bufs, n),
+            Err(e) if e.kind() == ErrorKind::Interrupted => {}
+            Err(e) => return Err(e),
+        }
+    }
+    Ok(())
+}
+
+// A connection's writer: drain its egress queue until the connection closes.
+fn run_writer(mut w: Box<dyn ConnWriter>, conn: Arc<Conn>, id: u32, shared: Arc<Shared>) {
+    conn.queue.set_waiter(std::thread::current());
+    loop {
+        if conn.closing.load(Ordering::Acquire) || shared.stop.load(Ordering::Relaxed) {
+            return;
+        }
+        match conn.queue.claim(MAX_BATCH) {
+            Some((start, end)) => {
+                let (a, b) = conn.queue.spans(start, end);
+                if write_batch(w.as_mut(), a, b).is_err() {
+                    // Failed or hit WRITE_TIMEOUT (stuck client): a partial
+                    // frame may have gone out, desyncing the framing, so evict.
+                    // The reader wakes on the shutdown and fires on_closed.
+                    shared.evict(id);
+                    return;
+                }
+                conn.queue.release(end);
+            }
+            None => {
+                if conn.queue.prepare_park() {
+                    std::thread::park();
+                }
+            }
+        }
+    }
+}
+
+// Join and discard the handles of reader/writer threads that have already
+// exited, so the registry tracks only live threads instead of growing with
+// total-connections across a long-running server's reconnect churn. Live
+// threads are left in place for the join-on-stop guarantee in
+// SocketServer::drop.
+fn reap_finished_threads(shared: &Shared) {
+    let mut threads = shared.threads.lock().unwrap();
     let mut i = 0;
-    while i < readers.len() {
-        if readers[i].is_finished() {
-            let _ = readers.swap_remove(i).join(); // already done — returns at once
+    while i < threads.len() {
+        if threads[i].is_finished() {
+            let _ = threads.swap_remove(i).join(); // already done — returns at once
         } else {
             i += 1;
         }
@@ -299,32 +446,46 @@ fn reap_finished_readers(shared: &Shared) {
 
 fn run_accept<A: Acceptor>(listener: A, shared: Arc<Shared>, host: Host, max_conns: usize) {
     while !shared.stop.load(Ordering::Relaxed) {
-        reap_finished_readers(&shared);
+        reap_finished_threads(&shared);
         match listener.accept_one() {
-            Ok(conn) => {
+            Ok(sock) => {
                 // Admission control: over the cap → drop immediately, so the
                 // excess client sees a crisp reset instead of a silent hang.
                 if shared.conns.lock().unwrap().len() >= max_conns {
-                    drop(conn);
+                    drop(sock);
                     continue;
                 }
                 let id = shared.next_id.fetch_add(1, Ordering::Relaxed);
-                let writer = match conn.clone_writer() {
-                    Ok(w) => {
-                        w.set_write_timeout(WRITE_TIMEOUT);
-                        Arc::new(Mutex::new(w))
-                    }
-                    Err(_) => continue,
+                let (writer, ctl) = match (sock.clone_writer(), sock.clone_writer()) {
+                    (Ok(w), Ok(c)) => (w, c),
+                    _ => continue,
                 };
-                shared.conns.lock().unwrap().insert(id, writer);
+                writer.set_write_timeout(WRITE_TIMEOUT);
+                let overflow = Overflow::from_u32(shared.overflow.load(Ordering::Relaxed))
+                    .unwrap_or(Overflow::Disconnect);
+                let conn = Arc::new(Conn {
+                    queue: EgressQueue::new(shared.queue_bytes.load(Ordering::Relaxed), overflow),
+                    ctl,
+                    closing: AtomicBool::new(false),
+                });
+                shared.conns.lock().unwrap().insert(id, conn.clone());
+                let (w_shared, w_conn) = (shared.clone(), conn.clone());
+                let writer_join = std::thread::Builder::new()
+                    .name("ss-osc-stream-tx".into())
+                    .spawn(move || run_writer(writer, w_conn, id, w_shared));
+                let Ok(writer_join) = writer_join else {
+                    shared.conns.lock().unwrap().remove(&id);
+                    continue;
+                };
+                shared.threads.lock().unwrap().push(writer_join);
                 let (t_shared, t_host) = (shared.clone(), host);
                 if let Ok(j) = std::thread::Builder::new()
                     .name("ss-osc-stream".into())
-                    .spawn(move || run_reader(conn, id, t_shared, t_host))
+                    .spawn(move || run_reader(sock, id, t_shared, t_host))
                 {
-                    shared.readers.lock().unwrap().push(j);
+                    shared.threads.lock().unwrap().push(j);
                 } else {
-                    shared.conns.lock().unwrap().remove(&id);
+                    shared.evict(id); // stops the writer too
                 }
             }
             Err(e) if e.kind() == ErrorKind::WouldBlock => {
@@ -346,7 +507,11 @@ fn start_socket_server<A: Acceptor>(
         stop: AtomicBool::new(false),
         conns: Mutex::new(HashMap::new()),
         next_id: AtomicU32::new(1),
-        readers: Mutex::new(Vec::new()),
+        threads: Mutex::new(Vec::new()),
+        queue_bytes: AtomicUsize::new(DEFAULT_QUEUE_BYTES),
+        overflow: AtomicU32::new(Overflow::Disconnect as u32),
+        dropped_frames: AtomicU64::new(0),
+        overflow_closes: AtomicU64::new(0),
     });
     let max = max_conns.max(1) as usize;
     let t_shared = shared.clone();
@@ -477,9 +642,10 @@ pub unsafe extern "C" fn ss_osc_stream_port(handle: *mut SsOscStream) -> i32 {
     (*handle).0.port()
 }
 
-/// Send one OSC packet, framed, to connection `conn_id`. Returns 1 on send,
-/// 0 for an unknown/closed connection or write failure. Safe from any
-/// non-audio thread (registry + per-connection write locks).
+/// Queue one OSC packet, framed, for connection `conn_id`; its writer thread
+/// sends it. Returns 1 when queued, 0 for an unknown/closed connection or a
+/// frame the overflow policy refused. Never blocks on the socket. Safe from
+/// any non-audio thread.
 #[no_mangle]
 pub unsafe extern "C" fn ss_osc_stream_send(
     handle: *mut SsOscStream,
@@ -495,6 +661,57 @@ pub unsafe extern "C" fn ss_osc_stream_send(
     no_unwind(0, || me.0.send(conn_id, data) as i32)
 }
 
+/// Configure the per-connection egress queue for connections accepted from
+/// now on: `queue_bytes` (clamped to [512 KiB, 64 MiB], rounded up to a power
+/// of two; 0 = default 1 MiB) and the overflow policy (`SS_OSC_EGRESS_*`).
+/// Returns 0 for a null handle or unknown policy. Named-pipe servers accept
+/// and ignore it (they send synchronously).
+#[no_mangle]
+pub unsafe extern "C" fn ss_osc_stream_set_egress(
+    handle: *mut SsOscStream,
+    queue_bytes: u32,
+    overflow: u32,
+) -> i32 {
+    if handle.is_null() {
+        return 0;
+    }
+    let Some(policy) = Overflow::from_u32(overflow) else { return 0 };
+    let bytes = if queue_bytes == 0 { DEFAULT_QUEUE_BYTES } else { queue_bytes as usize };
+    let me = &*handle;
+    no_unwind(0, || {
+        me.0.set_egress(bytes, policy);
+        1
+    })
+}
+
+/// Bytes queued for `conn_id` (including a batch being written), or -1 for an
+/// unknown/closed connection or a backend without queues.
+#[no_mangle]
+pub unsafe extern "C" fn ss_osc_stream_queue_depth(handle: *mut SsOscStream, conn_id: u32) -> i64 {
+    if handle.is_null() {
+        return -1;
+    }
+    let me = &*handle;
+    no_unwind(-1, || me.0.queue_depth(conn_id).map_or(-1, |d| d as i64))
+}
+
+/// Fill `out` with the server's egress queue snapshot. Returns 0 on a null
+/// argument. Safe from any thread.
+#[no_mangle]
+pub unsafe extern "C" fn ss_osc_stream_egress_stats(
+    handle: *mut SsOscStream,
+    out: *mut SsOscStreamEgressStats,
+) -> i32 {
+    if handle.is_null() || out.is_null() {
+        return 0;
+    }
+    let me = &*handle;
+    no_unwind(0, || {
+        *out = me.0.egress_stats();
+        1
+    })
+}
+
 /// Stop accepting, close every connection, join the threads, free the server.
 /// `on_closed` does not fire for connections closed by the stop itself.
 #[no_mangle]
@@ -748,6 +965,100 @@ mod tests {
         unsafe { ss_osc_stream_stop(h) };
     }
 
+    // Register two clients and return (a, a_conn, b, b_conn).
+    fn two_clients(cap: &Cap, port: u16) -> (TcpStream, u32, TcpStream, u32) {
+        let mut a = connect(port);
+        a.write_all(&frame(&encode("/a", &[]))).unwrap();
+        assert!(wait_until(|| cap.packets.lock().unwrap().len() == 1));
+        let mut b = connect(port);
+        b.write_all(&frame(&encode("/b", &[]))).unwrap();
+        assert!(wait_until(|| cap.packets.lock().unwrap().len() == 2));
+        let p = cap.packets.lock().unwrap().clone();
+        (a, p[0].0, b, p[1].0)
+    }
+
+    // A client that never reads must not stall sends to it or to anyone else:
+    // send only enqueues. Drop-oldest discards once its queue is full.
+    #[test]
+    fn tcp_stalled_client_does_not_block_others() {
+        let cap = Cap::new();
+        let (h, port) = start_tcp(&cap, 4);
+        assert_eq!(unsafe { ss_osc_stream_set_egress(h, 0, Overflow::DropOldest as u32) }, 1);
+        let (_a, a_conn, mut b, b_conn) = two_clients(&cap, port);
+
+        let blob = encode("/blob", &[OscArg::Blob(vec![0u8; 16 * 1024])]);
+        let t0 = Instant::now();
+        for _ in 0..1000 {
+            unsafe { ss_osc_stream_send(h, a_conn, blob.as_ptr(), blob.len() as u32) };
+        }
+        assert!(t0.elapsed() < Duration::from_secs(1),
+                "sends to a stalled client must not block ({:?})", t0.elapsed());
+        assert!(unsafe { ss_osc_stream_queue_depth(h, a_conn) } >= 0, "a live conn has a queue");
+
+        let reply = encode("/status.reply", &[]);
+        let sent = unsafe { ss_osc_stream_send(h, b_conn, reply.as_ptr(), reply.len() as u32) };
+        assert_eq!(sent, 1);
+        let body = read_frame(&mut b).expect("the healthy client still gets its reply");
+        assert_eq!(decode(&body).unwrap().addr, "/status.reply");
+
+        let mut st = SsOscStreamEgressStats::default();
+        assert_eq!(unsafe { ss_osc_stream_egress_stats(h, &mut st) }, 1);
+        assert_eq!(st.connections, 2);
+        assert!(st.dropped_frames > 0, "a 16 MB flood overflows a 1 MiB queue");
+        assert_eq!(st.overflow_closes, 0);
+        // Loopback socket buffers may absorb the remainder by now; the peak
+        // records the backlog regardless.
+        assert!(st.peak_queue_bytes >= (1 << 19), "the queue filled up");
+
+        unsafe { ss_osc_stream_stop(h) };
+    }
+
+    // Default policy: a queue overflow closes the stalled connection (on_closed
+    // fires) rather than silently losing replies on a reliable stream.
+    #[test]
+    fn tcp_overflow_disconnects_stalled_client() {
+        let cap = Cap::new();
+        let (h, port) = start_tcp(&cap, 4);
+        let (_a, a_conn, _b, b_conn) = two_clients(&cap, port);
+
+        let blob = encode("/blob", &[OscArg::Blob(vec![0u8; 16 * 1024])]);
+        let mut refused = false;
+        for _ in 0..1000 {
+            if unsafe { ss_osc_stream_send(h, a_conn, blob.as_ptr(), blob.len() as u32) } == 0 {
+                refused = true;
+                break;
+            }
+        }
+        assert!(refused, "the overflowing send is refused");
+        assert!(wait_until(|| cap.closed.lock().unwrap().contains(&a_conn)));
+        assert!(!cap.closed.lock().unwrap().contains(&b_conn));
+        assert_eq!(unsafe { ss_osc_stream_queue_depth(h, a_conn) }, -1);
+
+        let mut st = SsOscStreamEgressStats::default();
+        unsafe { ss_osc_stream_egress_stats(h, &mut st) };
+        assert_eq!(st.overflow_closes, 1);
+        assert_eq!(st.connections, 1);
+
+        unsafe { ss_osc_stream_stop(h) };
+    }
+
+    // Many queued replies reach a reading client intact and in order.
+    #[test]
+    fn tcp_queued_replies_arrive_in_order() {
+        let cap = Cap::new();
+        let (h, port) = start_tcp(&cap, 4);
+        let (mut a, a_conn, _b, _) = two_clients(&cap, port);
+        for i in 0..2000 {
+            let m = encode("/n", &[OscArg::Int(i)]);
+            assert_eq!(unsafe { ss_osc_stream_send(h, a_conn, m.as_ptr(), m.len() as u32) }, 1);
+        }
+        for i in 0..2000 {
+            let body = read_frame(&mut a).expect("queued reply");
+            assert_eq!(decode(&body).unwrap().args[0].as_i32(), Some(i));
+        }
+        unsafe { ss_osc_stream_stop(h) };
+    }
+
     #[test]
     fn stop_is_prompt() {
         let cap = Cap::new();
@@ -13,7 +13,8 @@
 //!   * a mix of tiny and large (100 KiB, split-write) frames, so reassembly is
 //!     exercised while the pipe is saturated;
 //!   * the server stays live afterwards (a final round trip still answers).
-//! Throughput and any datagram loss are logged for regression visibility.
+//! Throughput and any datagram loss are logged for regression visibility, as
+//! is the UDP reply egress rate (host-string vs resolved vs batched sends).
 
 use std::collections::HashMap;
 use std::ffi::c_void;
@@ -365,3 +366,106 @@ mod dgram {
         unsafe { ss_osc_uds_stop(handle) };
     }
 }
+
+// ── UDP reply egress ─────────────────────────────────────────────────────────
+// Replies per second out of one SsOsc to a loopback client, three ways: the
+// host-string send (parse + resolve per datagram), a pre-resolved address, and
+// pre-resolved batches (one sendmmsg per batch on Linux). The rate is measured
+// on the sending side, which is what the gateway pays; the receiver only checks
+// that what the kernel took arrived intact.
+
+mod udp_egress {
+    use super::*;
+    use std::net::UdpSocket;
+    use std::sync::atomic::{AtomicI64, Ordering};
+    use supersonic_osc_net::ffi::{
+        ss_osc_create, ss_osc_destroy, ss_osc_send, ss_osc_send_addr, ss_osc_send_batch, SsOscAddr,
+        SsOscDatagram,
+    };
+
+    const REPLIES: i32 = 50_000;
+    const BATCH: usize = 64; // about what one gateway wake drains under load
+
+    extern "C" fn no_emit(_: *mut c_void, _: i32, _: *const u8, _: u32) {}
+
+    #[test]
+    fn udp_reply_rate() {
+        let rx = UdpSocket::bind("127.0.0.1:0").unwrap();
+        rx.set_read_timeout(Some(Duration::from_millis(200))).unwrap();
+        let to = rx.local_addr().unwrap();
+        let got = Arc::new(AtomicI64::new(0));
+        let corrupt = Arc::new(AtomicI64::new(0));
+        let reader = {
+            let (rx, got, corrupt) = (rx.try_clone().unwrap(), got.clone(), corrupt.clone());
+            std::thread::spawn(move || {
+                let mut buf = [0u8; 512];
+                let mut idle = 0;
+                while idle < 10 {
+                    match rx.recv_from(&mut buf) {
+                        Ok((n, _)) => {
+                            idle = 0;
+                            if packet_id(&buf[..n]).is_some() {
+                                got.fetch_add(1, Ordering::Relaxed);
+                            } else {
+                                corrupt.fetch_add(1, Ordering::Relaxed);
+                            }
+                        }
+                        Err(_) => idle += 1,
+                    }
+                }
+            })
+        };
+
+        let h = ss_osc_create(std::ptr::null_mut(), no_emit);
+        let pkts: Vec<Vec<u8>> = (1..=REPLIES).map(|id| load_msg(id, false)).collect();
+        let addr = SsOscAddr::from_socket(to);
+        let host = to.ip().to_string();
+        let mut rates = Vec::new();
+        for mode in ["host string", "resolved", "batched"] {
+            let t0 = Instant::now();
+            match mode {
+                "host string" => {
+                    for p in &pkts {
+                        unsafe {
+                            ss_osc_send(h, host.as_ptr(), host.len() as u32, to.port() as i32,
+                                        p.as_ptr(), p.len() as u32)
+                        };
+                    }
+                }
+                "resolved" => {
+                    for p in &pkts {
+                        unsafe { ss_osc_send_addr(h, &addr, p.as_ptr(), p.len() as u32) };
+                    }
+                }
+                _ => {
+                    for chunk in pkts.chunks(BATCH) {
+                        let dgrams: Vec<SsOscDatagram> = chunk
+                            .iter()
+                            .map(|p| SsOscDatagram { addr: &addr, data: p.as_ptr(), len: p.len() as u32 })
+                            .collect();
+                        unsafe { ss_osc_send_batch(h, dgrams.as_ptr(), dgrams.len() as u32) };
+                    }
+                }
+            }
+            let secs = t0.elapsed().as_secs_f64();
+            rates.push((mode, REPLIES as f64 / secs));
+            // Let the reader catch up so one mode's backlog doesn't cost the next.
+            std::thread::sleep(Duration::from_millis(100));
+        }
+        unsafe { ss_osc_destroy(h) };
+        reader.join().unwrap();
+
+        assert_eq!(corrupt.load(Ordering::Relaxed), 0, "udp egress: corrupt datagrams");
+        // A saturating loopback blast may overflow the receive buffer; that loss
+        // is the kernel's, not the sender's. Something from every mode must land.
+        assert!(got.load(Ordering::Relaxed) > 0, "udp egress: nothing arrived");
+        for (mode, rate) in &rates {
+            eprintln!("[load] udp egress ({mode}): {rate:.0} replies/s");
+        }
+        eprintln!(
+            "[load] udp egress: {}/{} datagrams received",
+            got.load(Ordering::Relaxed),
+            3 * REPLIES
+        );
+    }
+}
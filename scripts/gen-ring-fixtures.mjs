@@ -111,6 +111,17 @@ const CASES = [
             ['drain'],
         ],
     },
+    {
+        // sourceId is a full u32: the pre-decoded command record flag
+        // (SOURCE_ID_PRECODED, the top bit) rides through untouched.
+        name: 'precoded_source_flag',
+        size: 128,
+        ops: [
+            ['write', 0x80000003, Uint8Array.from({ length: 32 }, (_, i) => 0x40 + i)],
+            ['write', 3, Uint8Array.from({ length: 8 }, (_, i) => 0x70 + i)],
+            ['drain'],
+        ],
+    },
 ];
 
 function runCase({ name, size, ops }) {
@@ -62,12 +62,33 @@ public:
     // and drops. A packet that is not a '/'-led, NUL-terminated OSC address (or a
     // bundle) returns false too.
     bool ingest(const uint8_t* data, size_t len, const void* callCtx) const noexcept {
-        if (data == nullptr || len < 4) return false;
-        if (len >= 8 && std::memcmp(data, "#bundle", 8) == 0) return dispatch(mDefault, callCtx, data, len);
-        if (data[0] != '/') return false;
+        const Dest* d = resolve(data, len);
+        return d ? dispatch(*d, callCtx, data, len) : false;
+    }
+
+    // The handler ingest() would hand this packet to, without calling it
+    // (nullptr when nothing would claim it). Lets a caller holding a
+    // pre-decoded form of a message take a shortcut only where the raw
+    // message would have gone the same way.
+    Handler handlerFor(const uint8_t* data, size_t len) const noexcept {
+        const Dest* d = resolve(data, len);
+        return d ? d->h : nullptr;
+    }
+
+    size_t routeCount() const noexcept { return mCount; }
+
+private:
+    struct Dest {
+        Handler h   = nullptr;
+        void*   ctx = nullptr;
+    };
+    const Dest* resolve(const uint8_t* data, size_t len) const noexcept {
+        if (data == nullptr || len < 4) return nullptr;
+        if (len >= 8 && std::memcmp(data, "#bundle", 8) == 0) return &mDefault;
+        if (data[0] != '/') return nullptr;
         size_t addr = 0;
         while (addr < len && data[addr] != '\0') ++addr;
-        if (addr == len) return false;  // address not NUL-terminated within bounds
+        if (addr == len) return nullptr;  // address not NUL-terminated within bounds
 
         const Dest* best = &mDefault;
         size_t bestLen = 0;
@@ -76,16 +97,8 @@ public:
             if (r.len <= bestLen || r.len > addr) continue;
             if (std::memcmp(data, r.prefix, r.len) == 0) { best = &r.dest; bestLen = r.len; }
         }
-        return dispatch(*best, callCtx, data, len);
+        return best;
     }
-
-    size_t routeCount() const noexcept { return mCount; }
-
-private:
-    struct Dest {
-        Handler h   = nullptr;
-        void*   ctx = nullptr;
-    };
     static bool dispatch(const Dest& d, const void* callCtx, const uint8_t* data, size_t len) noexcept {
         return d.h ? d.h(d.ctx, callCtx, data, len) : false;
     }
@@ -17,6 +17,7 @@
 #include "IngressCallCtx.h"
 #include "ReplyChannel.h"
 #include "lanes/lanes_internal.h"   // ss_egress_nrt_write — off-thread debug egress
+#include "shm_peer_plane.h"          // direct peer lane (native)
 // Platform macros (SC_COLD_BSS, tiered-memory attributes). Header-only and
 // scsynth-free, so it is included in both builds — the no-synth core still
 // places the ring arena + scheduler pool in bulk RAM on tiered targets.
@@ -61,6 +62,11 @@ static SuperClock& superClock() {
 #include <cstdlib>
 #include <cmath>
 #include <limits>
+#ifndef __EMSCRIPTEN__
+#include <chrono>
+#include <mutex>
+#include <thread>
+#endif
 
 #ifdef __wasm_simd128__
 #include <wasm_simd128.h>
@@ -81,6 +87,7 @@ static SuperClock& superClock() {
 #include "SC_Graph.h"              // from synth/server/
 #include "SC_Group.h"              // from synth/server/
 #include "SC_HiddenWorld.h"        // from synth/server/
+#include "SC_WorldResize.h"        // from synth/server/ - runtime World limits
 #include "sc_msg_iter.h"           // from synth/include/plugin_interface/
 #include "Samp.hpp"                // for sine table initialization
 #endif // SUPERSONIC_SYNTH
@@ -99,6 +106,10 @@ static SuperClock& superClock() {
 // IN-ring drain below runs on.
 #include "lanes/lanes_internal.h"
 #include "lanes/ring_drain.h"
+#include "cmd_record.h"   // pre-decoded command records (SOURCE_ID_PRECODED)
+#include "latency_trace.h"   // ingress-to-apply latency histograms
+#include "usdt.h"            // static tracepoints
+#include "bus_meter.h"       // output/bus level meters (METER region)
 
 // Pre-allocated heap for RT-safe allocations
 #include "supersonic_heap.h"
@@ -119,6 +130,8 @@ std::atomic<uint64_t> g_engine_frames{0};
 #if SUPERSONIC_SYNTH
 int PerformOSCMessage(World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
 void PerformOSCBundle(World* inWorld, OSC_Packet* inPacket);
+int PerformPrecodedCommand(World* inWorld, const SsCmdView& inCmd, ReplyAddress* inReply);
+static void ss_synth_precoded(const SsCmdView& cmd, uint32_t token);
 #endif
 
 // Audio-thread /clock handler (the wasm ingress route). Handles the cheap
@@ -248,6 +261,34 @@ extern "C" {
     bool     g_in_discard_active = false;
     uint32_t g_in_discard_below  = 0;
 
+#ifndef __EMSCRIPTEN__
+    // Direct peer lane (peer_lane_attach): the SHM peer's command ring
+    // (shm_peer_plane.h), drained by process_audio right after the IN ring.
+    // g_peer_lane_busy brackets every drain so an attach can wait out a
+    // drain of the plane it replaces. g_peer_drain is audio-thread only.
+    std::atomic<ShmPeerPlaneHeader*> g_peer_lane{nullptr};
+    std::atomic<bool>                g_peer_lane_busy{false};
+    SsDrainState                     g_peer_drain;
+    // Each peer frame is copied here before it is looked at: the peer can
+    // still write the ring, so nothing is parsed in place. Sized to the
+    // largest frame the ring can hold. Audio-thread only.
+    alignas(16) uint8_t              g_peer_frame[SHM_PEER_CMD_RING_SIZE];
+#endif
+
+    // Idle mode (ss_idle_* in lanes.h). g_idle_silent: the last block had no
+    // synths and nothing drained, fired or tapped, so it rendered silence and
+    // the output buses still hold it; the next such block skips the World.
+    // g_block_osc_time is the last ticked block's start, for the distance to
+    // the next scheduled event. g_idle_blocks counts blocks not rendered
+    // (idleBlocks native stat). Audio-thread only.
+    bool     g_idle_silent    = false;
+    int64_t  g_block_osc_time = 0;
+    uint32_t g_idle_blocks    = 0;
+
+    // Pre-decoded command records run through the jump table
+    // (precodedCommands native stat). Audio-thread only.
+    uint32_t g_precoded_cmds  = 0;
+
     void* g_rt_pool_ptr = nullptr;
     size_t g_rt_pool_size = 0;
 
@@ -273,10 +314,12 @@ extern "C" {
     // the lock-free RT-out ring; any other thread (watchdog, recovery, boot on
     // native) routes to the locked NRT-out ring, so RT-out never gets a second
     // concurrent writer. Set via AudioThreadScope at the top of process_audio.
+    // The same scope marks the thread RT for the heap, which then refuses to
+    // grow or release areas on it (see supersonic_heap_maintain).
     thread_local bool t_on_audio_thread = false;
     struct AudioThreadScope {
-        AudioThreadScope()  { t_on_audio_thread = true;  }
-        ~AudioThreadScope() { t_on_audio_thread = false; }
+        AudioThreadScope()  { t_on_audio_thread = true;  supersonic_heap_set_rt_thread(true);  }
+        ~AudioThreadScope() { t_on_audio_thread = false; supersonic_heap_set_rt_thread(false); }
     };
 
     // Unified event scheduler: one timed queue fanning out to the synth graph
@@ -388,6 +431,28 @@ extern "C" {
         }
     }
 
+#if SUPERSONIC_SYNTH
+    // Nothing for a block ending at nextOscTime to do beyond what the drain
+    // already did: no synths (empty groups calc nothing), no scheduled event due
+    // by its end, no MIDI clock burst to generate, no live input bus being
+    // metered (bus_meter.h) and, on WASM, no master tap recording. Audio thread.
+    static bool idle_quiet(int64_t nextOscTime, uint32_t active_input_channels) {
+        if (g_world->mNumGraphs != 0) return false;
+        if (g_scheduler.nextTime() <= nextOscTime) return false;
+        if (g_active_superclock.load(std::memory_order_acquire) && !get_midi_clock_out().idle())
+            return false;
+        if (active_input_channels > 0 &&
+            ss_meter_reads_inputs(g_world->mNumOutputs, active_input_channels))
+            return false;
+#ifdef __EMSCRIPTEN__
+        if (g_shm_audio_buffers &&
+            g_shm_audio_buffers[SHM_AUDIO_MASTER_SLOT].enabled.load(std::memory_order_relaxed))
+            return false;
+#endif
+        return true;
+    }
+#endif
+
     static inline void increment_scheduler_drop_metric() {
         if (!metrics) {
             return;
@@ -414,6 +479,18 @@ extern "C" {
             std::memory_order_release);
     }
 
+#ifndef __EMSCRIPTEN__
+    // Publish (or, with null, withdraw) the direct peer lane. Both sides are
+    // seq_cst: either the audio thread's next drain sees the new plane, or
+    // this call sees the drain in progress and waits for it to finish — so on
+    // return nothing reads the old plane and the caller may unmap it.
+    void peer_lane_attach(ShmPeerPlaneHeader* plane) {
+        g_peer_lane.store(plane);
+        while (g_peer_lane_busy.load())
+            std::this_thread::yield();
+    }
+#endif
+
     EMSCRIPTEN_KEEPALIVE
     void clear_scheduler() {
         g_in_seq_reset.store(true, std::memory_order_relaxed);
@@ -439,6 +516,8 @@ extern "C" {
     // (not a global) so the offset's only input is the call ctx; 0 for immediate.
     void dispatch(const uint8_t* osc, uint32_t len, uint32_t token,
                   int64_t when, int64_t blockTime) {
+        if (const EngineScheduler::Scan* scan = g_scheduler.scan(); scan && scan->due)
+            scan->due(scan->ctx, osc, len, when);
         const DrainCallCtx cc{ token, when, blockTime };
         OscIngress* ig = g_active_ingress.load(std::memory_order_acquire);
         if (ig && ig->ingest(osc, len, &cc)) return;
@@ -453,6 +532,43 @@ extern "C" {
         }
     }
 
+    // Run a pre-decoded command record (a frame flagged SOURCE_ID_PRECODED,
+    // see cmd_record.h). The record goes through the scsynth jump table only
+    // when the message it carries would have reached the synth default route
+    // anyway; otherwise (a route claims the address, the entries fail the
+    // bounds check, no World yet, a no-synth build) the carried message is
+    // dispatched raw, so a record never behaves differently from its message.
+    void dispatch_precoded(const uint8_t* payload, uint32_t len, uint32_t token) {
+        SsCmdView v;
+        const bool ok = ss_cmd_view(payload, len, v);
+        if (!v.osc) {
+            static std::atomic<uint32_t> badRecordLog{0};
+            if (badRecordLog.fetch_add(1, std::memory_order_relaxed) < 16)
+                ss_log("ERROR: malformed command record (%u bytes) — dropped", len);
+            return;
+        }
+        const uint8_t* osc = reinterpret_cast<const uint8_t*>(v.osc);
+#if SUPERSONIC_SYNTH
+        OscIngress* ig = g_active_ingress.load(std::memory_order_acquire);
+        if (ok && g_world && ig &&
+            ig->handlerFor(osc, v.oscLen) == &ss_synth_default_route) {
+            if (const EngineScheduler::Scan* scan = g_scheduler.scan(); scan && scan->due)
+                scan->due(scan->ctx, osc, v.oscLen, 0);
+            ss_synth_precoded(v, token);
+            return;
+        }
+#else
+        (void)ok;
+#endif
+        dispatch(osc, v.oscLen, token, /*when=*/0, /*blockTime=*/0);
+    }
+
+    // Count a traced command's wait (latency_trace.h): its ingress stamp to now.
+    void record_latency(uint32_t origin, uint8_t latencyClass, uint32_t ingressUs) {
+        ss_latency_record(shared_memory + LATENCY_TRACE_START, origin, latencyClass,
+                          ss_latency_now_us() - ingressUs);
+    }
+
     // Defer an OSC message until `when` (its OSC timetag), carrying its sender
     // token; the fire loop drains due events and calls dispatch(osc, token, when).
     // `tag` groups events for /sched/flush.
@@ -466,22 +582,70 @@ extern "C" {
     // sized so that, within a sane lookahead, this drop does not happen in normal
     // use; a drop means the producer scheduled further ahead than the pool holds.
     void scheduled_dispatch(const uint8_t* osc, uint32_t len, uint32_t token,
-                            int64_t when, uint32_t tag) {
+                            int64_t when, uint32_t tag, uint32_t ingressUs = 0,
+                            uint8_t latencyClass = kSsLatencyUntraced) {
         if (len > EngineScheduler::kMaxPayload) {
             ss_log("WARNING: scheduled message too large (%u bytes, max %u) - dropped",
                    len, EngineScheduler::kMaxPayload);
             increment_scheduler_drop_metric();
             return;
         }
-        if (g_scheduler.full() || !g_scheduler.addScheduled(when, tag, token, osc, len)) {
+        if (g_scheduler.full() || !g_scheduler.addScheduled(when, tag, token, osc, len,
+                                                             ingressUs, latencyClass)) {
             ss_log("WARNING: scheduler full (%d events) - scheduled message dropped",
                    g_scheduler.size());
             increment_scheduler_drop_metric();
             return;
         }
+        if (const EngineScheduler::Scan* scan = g_scheduler.scan(); scan && scan->admit)
+            scan->admit(scan->ctx, osc, len, when);
         update_scheduler_depth_metric(g_scheduler.size());
     }
 
+    // Perform one raw OSC frame from an IN lane: a timestamped bundle or a
+    // "/schedule <timetag> <blob>" is parked on the scheduler, anything else
+    // dispatches now. `stamped`/`ingressUs` carry the frame's latency-trace
+    // stamp (latency_trace.h) into whichever path it takes.
+    //
+    // Two ways to schedule, one mechanism: both park OSC for re-dispatch on
+    // time (scheduled_dispatch), which is fail-open — it always consumes the
+    // frame (dropping+counting an un-schedulable one) so a full scheduler can
+    // never head-of-line-block an in-order lane.
+    void perform_frame(const uint8_t* osc, uint32_t len, uint32_t token,
+                       bool stamped = false, uint32_t ingressUs = 0) {
+        // (1) Bundle. A future timetag → scheduler (synth plane;
+        // SCHED_TAG_SYNTH is protected from the default /sched/flush);
+        // an immediate one (0/1) dispatches now. Either way a bundle is
+        // never a /schedule packet — don't fall through to parse_schedule.
+        if (ss_is_bundle(osc, len)) {
+            uint64_t timetag = ss_bundle_timetag(osc);
+            if (timetag != 0 && timetag != 1) {
+                scheduled_dispatch(osc, len, token, (int64_t)timetag, SCHED_TAG_SYNTH,
+                                   ingressUs,
+                                   stamped ? kSsLatencyClassBundle : kSsLatencyUntraced);
+                return;
+            }
+        } else {
+            // (2) "/schedule <timetag> <blob>" → scheduler (the inner blob,
+            // re-dispatched on time). SCHED_TAG_DEFAULT — a run-stop flush
+            // cancels it, matching the MIDI/OSC it usually carries.
+            SchedulePacket sp = ss_parse_schedule(osc, len);
+            if (sp.ok) {
+                scheduled_dispatch(sp.blob, sp.blobLen, token, sp.when, SCHED_TAG_DEFAULT,
+                                   ingressUs,
+                                   stamped ? kSsLatencyClassSchedule : kSsLatencyUntraced);
+                return;
+            }
+        }
+
+        // (3) Everything else → dispatch now. The one address dispatcher
+        // routes it: synth inline (default), control to its handler /
+        // NRT, with no ingress published it goes straight to synth.
+        dispatch(osc, len, token, /*when=*/0, /*blockTime=*/0);
+        if (stamped)
+            record_latency(token, kSsLatencyClassImmediate, ingressUs);
+    }
+
     // Initialize memory pointers. The arena is the public POSIX segment when
     // the native backend supplied one (g_external_segment), else the in-band
     // ring_buffer_storage (WASM, and headless native with no shm). Either way
@@ -559,6 +723,7 @@ extern "C" {
         g_in_drain.lastSeq = -1;
         g_in_flush_below.store(-1, std::memory_order_relaxed);
         g_in_discard_active = false;
+        g_idle_silent = false;   // a new World's output buses hold nothing yet
 
         // Initialize metrics
         metrics->process_count.store(0, std::memory_order_relaxed);
@@ -575,6 +740,14 @@ extern "C" {
         metrics->scheduler_last_late_ms.store(0, std::memory_order_relaxed);
         metrics->scheduler_last_late_tick.store(0, std::memory_order_relaxed);
 
+        // Latency trace: empty histograms for the new engine (tracing itself
+        // is process-wide and carries on if it was on).
+        memset(shared_memory + LATENCY_TRACE_START, 0, LATENCY_TRACE_SIZE);
+
+        // Bus meters: nothing requested, nothing published.
+        memset(shared_memory + METER_START, 0, METER_SIZE);
+        g_meter = SsMeterState{};
+
         // Initialize node tree memory
         // All entries start with id = -1 (empty slot)
         // Using memset with 0xFF sets all bytes to 0xFF, which is -1 for signed int32
@@ -910,6 +1083,57 @@ extern "C" {
         control = nullptr;
         metrics = nullptr;
     }
+
+    // Runtime World growth (SC_WorldResize.h). The control thread prepares a
+    // resize and parks it here; process_audio applies it at the top of the
+    // next block, before anything in that block can use the limits, and
+    // posts the outcome. Whoever takes the slot owns the apply, so a caller
+    // that times out can retract an un-applied resize without racing it.
+    std::atomic<WorldResize*> g_pending_resize{nullptr};
+    std::atomic<int> g_resize_result{0};   // 0 pending, 1 applied, -1 refused
+    std::mutex g_resize_mutex;             // one resize at a time
+
+    void apply_pending_resize() {
+        WorldResize* r = g_pending_resize.load(std::memory_order_acquire);
+        if (!r || !g_pending_resize.compare_exchange_strong(r, nullptr, std::memory_order_acq_rel))
+            return;
+        const bool ok = World_ApplyResize(g_world, r);
+        g_resize_result.store(ok ? 1 : -1, std::memory_order_release);
+    }
+
+    bool world_limits(WorldLimits* current, WorldLimits* ceiling) {
+        if (!g_world) return false;
+        World_GetLimits(g_world, current, ceiling);
+        return true;
+    }
+
+    const char* world_grow(const WorldLimits* want, uint32_t timeout_ms, WorldResizeReport* report) {
+        std::lock_guard<std::mutex> lock(g_resize_mutex);
+        if (!g_world || !memory_initialized) return "no World";
+        WorldResizeReport local;
+        if (!report) report = &local;
+        const char* error = nullptr;
+        WorldResize* r = World_PrepareResize(g_world, *want, &error);
+        if (!r) return error;
+
+        g_resize_result.store(0, std::memory_order_relaxed);
+        g_pending_resize.store(r, std::memory_order_release);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (g_resize_result.load(std::memory_order_acquire) == 0) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                WorldResize* expected = r;
+                if (g_pending_resize.compare_exchange_strong(expected, nullptr,
+                                                             std::memory_order_acq_rel)) {
+                    World_FinishResize(g_world, r, report);
+                    return "timed out waiting for the audio thread";
+                }
+                // Taken just now: the apply is running, its result is a block away.
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        World_FinishResize(g_world, r, report);
+        return report->mError;
+    }
 #endif
 
     // Main audio processing function - called once per block (the lanes tick,
@@ -936,6 +1160,10 @@ extern "C" {
 
         g_scheduler.drainPendingClear();
 
+#if !defined(__EMSCRIPTEN__) && SUPERSONIC_SYNTH
+        apply_pending_resize();
+#endif
+
         // Calculate current NTP time from components
         // currentNTP = audioContextTime + ntp_start + (drift_us/1000000) + (global_ms/1000)
         // Read ntp_start_time directly from shared memory every frame
@@ -954,6 +1182,7 @@ extern "C" {
 #endif
 
         uint32_t pc = metrics->process_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        SS_PROBE1(block_begin, pc);
 
         // Publish native-only engine stats (synthdef count, allocated buffers)
         // at a low rate — the synthdef count is O(1) but the SndBuf scan is
@@ -961,7 +1190,15 @@ extern "C" {
         // light. Declared in SC_World.cpp.
 #if SUPERSONIC_SYNTH
         extern void World_UpdateNativeStats(World*);
-        if (g_world && (pc & 63u) == 0u) World_UpdateNativeStats(g_world);
+        if (g_world && (pc & 63u) == 0u) {
+            World_UpdateNativeStats(g_world);
+            reinterpret_cast<std::atomic<uint32_t>*>(shared_memory + NATIVE_STATS_START +
+                                                     NATIVE_STAT_IDLE_BLOCKS)
+                ->store(g_idle_blocks, std::memory_order_relaxed);
+            reinterpret_cast<std::atomic<uint32_t>*>(shared_memory + NATIVE_STATS_START +
+                                                     NATIVE_STAT_PRECODED_CMDS)
+                ->store(g_precoded_cmds, std::memory_order_relaxed);
+        }
 #endif
 
         // Host telemetry. Sample the ring fill every block so peaks stay a true
@@ -1045,10 +1282,17 @@ extern "C" {
             // Bound per block to stay within the audio budget.
             constexpr uint32_t MAX_MESSAGES_PER_FRAME = 32;
 
+            // Latency trace: look up ingress stamps this block only if on.
+            const bool trace = ss_latency_begin_block(shared_memory + LATENCY_TRACE_START);
+
             // Snapshot the gap counter so losses this block can be surfaced
             // in the debug channel (the walker only counts them).
             uint32_t gaps_before =
                 metrics->messages_sequence_gaps.load(std::memory_order_relaxed);
+            // ...and the processed counter, so the idle check knows whether
+            // anything was performed.
+            const uint32_t processed_before =
+                metrics->messages_processed.load(std::memory_order_relaxed);
 
             SsDrainStop stop = SsDrainStop::Empty;
             ss_drain_ring(
@@ -1058,7 +1302,7 @@ extern "C" {
                                 &metrics->messages_dropped,
                                 &metrics->messages_sequence_gaps },
                 MAX_MESSAGES_PER_FRAME,
-                [current_ntp](uint32_t sourceId, const uint8_t* payload,
+                [current_ntp, trace](uint32_t sourceId, const uint8_t* payload,
                               uint32_t payload_size, uint32_t seq) -> SsDrainVerdict {
                     // Purge in progress: frames sequenced before the flush
                     // snapshot are stale — consume them undispatched. The
@@ -1069,50 +1313,31 @@ extern "C" {
                             return SsDrainVerdict::Consume;
                         g_in_discard_active = false;
                     }
+                    SS_PROBE3(ingress_drain, payload_size, sourceId & ~SOURCE_ID_PRECODED, seq);
+
+                    // Traced: the producer's ingress stamp for this frame,
+                    // recorded once the command is performed, or carried
+                    // into the scheduler and recorded when it fires.
+                    uint32_t ingressUs = 0;
+                    const bool stamped = trace && ss_latency_stamp_of(seq, ingressUs);
+
+                    // A pre-decoded command record: always an immediate
+                    // single message (never a bundle or /schedule).
+                    if (sourceId & SOURCE_ID_PRECODED) {
+                        dispatch_precoded(payload, payload_size,
+                                          sourceId & ~SOURCE_ID_PRECODED);
+                        if (stamped)
+                            record_latency(sourceId & ~SOURCE_ID_PRECODED,
+                                           kSsLatencyClassImmediate, ingressUs);
+                        return SsDrainVerdict::Consume;
+                    }
 
                     // In-place delivery: the payload points into the IN ring
                     // (the consumer owns the region until we return Consume).
                     // scsynth's perform path is synchronous and copies what
                     // it keeps (a scheduled bundle is memcpy'd into the
                     // scheduler's data pool), so nothing retains this pointer.
-                    char* osc_buffer = const_cast<char*>(
-                        reinterpret_cast<const char*>(payload));
-                    const uint8_t* osc = reinterpret_cast<const uint8_t*>(osc_buffer);
-
-                    // Two ways to schedule, one mechanism. A timestamped bundle and
-                    // "/schedule <timetag> <blob>" both park OSC for re-dispatch on
-                    // time (scheduled_dispatch); everything else dispatches now.
-                    // scheduled_dispatch is fail-open — it always consumes the frame
-                    // (dropping+counting an un-schedulable one) so a full scheduler
-                    // can never head-of-line-block the in-order IN-ring drain.
-
-                    // (1) Bundle. A future timetag → scheduler (synth plane;
-                    // SCHED_TAG_SYNTH is protected from the default /sched/flush);
-                    // an immediate one (0/1) dispatches now. Either way a bundle is
-                    // never a /schedule packet — don't fall through to parse_schedule.
-                    if (ss_is_bundle(osc, payload_size)) {
-                        uint64_t timetag = ss_bundle_timetag(osc);
-                        if (timetag != 0 && timetag != 1) {
-                            scheduled_dispatch(osc, payload_size, sourceId,
-                                               (int64_t)timetag, SCHED_TAG_SYNTH);
-                            return SsDrainVerdict::Consume;
-                        }
-                    } else {
-                        // (2) "/schedule <timetag> <blob>" → scheduler (the inner blob,
-                        // re-dispatched on time). SCHED_TAG_DEFAULT — a run-stop flush
-                        // cancels it, matching the MIDI/OSC it usually carries.
-                        SchedulePacket sp = ss_parse_schedule(osc, payload_size);
-                        if (sp.ok) {
-                            scheduled_dispatch(sp.blob, sp.blobLen, sourceId,
-                                               sp.when, SCHED_TAG_DEFAULT);
-                            return SsDrainVerdict::Consume;
-                        }
-                    }
-
-                    // (3) Everything else → dispatch now. The one address dispatcher
-                    // routes it: synth inline (default), control to its handler /
-                    // NRT, with no ingress published it goes straight to synth.
-                    dispatch(osc, payload_size, sourceId, /*when=*/0, /*blockTime=*/0);
+                    perform_frame(payload, payload_size, sourceId, stamped, ingressUs);
                     return SsDrainVerdict::Consume;
                 },
                 &stop);
@@ -1141,7 +1366,78 @@ extern "C" {
                     control->status_flags.fetch_or(STATUS_FRAGMENTED_MSG, std::memory_order_relaxed);
             }
 
+#ifndef __EMSCRIPTEN__
+            // Direct peer lane: the SHM peer's command ring, drained here rather
+            // than copied into the IN ring by the NRT gateway first. Same walker,
+            // same untrusted-cursor validation as the IN ring. The frame's
+            // sourceId is ignored apart from its SOURCE_ID_PRECODED bit — every
+            // frame carries SHM_PEER_ORIGIN_TOKEN, so identity is the
+            // transport's, never the peer's. Unlike the IN ring, whose writers
+            // are all in this process, the peer can rewrite a frame after
+            // publishing it, so each one is copied into g_peer_frame first and
+            // only the copy is validated and performed: a record's offsets
+            // cannot change between ss_cmd_view and the handler reading them.
+            // Control-plane addresses (/supersonic/*, /clock/*) still reach
+            // the NRT thread through their routes. Untraced: the stamp table
+            // is keyed by IN-ring sequence numbers.
+            if (g_peer_lane.load(std::memory_order_relaxed)) {
+                g_peer_lane_busy.store(true);
+                if (ShmPeerPlaneHeader* plane = g_peer_lane.load()) {
+                    constexpr uint32_t MAX_PEER_MESSAGES_PER_FRAME = 32;
+                    ss_drain_ring(
+                        shm_peer_cmd_ring(plane), SHM_PEER_CMD_RING_SIZE,
+                        &plane->cmd_head, &plane->cmd_tail, g_peer_drain,
+                        SsDrainMetrics{ &metrics->messages_processed, nullptr,
+                                        &metrics->osc_in_corrupted, nullptr },
+                        MAX_PEER_MESSAGES_PER_FRAME,
+                        [](uint32_t sourceId, const uint8_t* payload, uint32_t payload_size,
+                           uint32_t seq) -> SsDrainVerdict {
+                            SS_PROBE3(ingress_drain, payload_size, SHM_PEER_ORIGIN_TOKEN, seq);
+                            // Host-side "sent" counters, as ingest counts every
+                            // other transport's commands.
+                            metrics->osc_out_messages_sent.fetch_add(1, std::memory_order_relaxed);
+                            metrics->osc_out_bytes_sent.fetch_add(payload_size,
+                                                                  std::memory_order_relaxed);
+                            if (payload_size > sizeof(g_peer_frame))
+                                return SsDrainVerdict::Consume;   // the walker bounds it by the ring
+                            std::memcpy(g_peer_frame, payload, payload_size);
+                            if (sourceId & SOURCE_ID_PRECODED)
+                                dispatch_precoded(g_peer_frame, payload_size, SHM_PEER_ORIGIN_TOKEN);
+                            else
+                                perform_frame(g_peer_frame, payload_size, SHM_PEER_ORIGIN_TOKEN);
+                            return SsDrainVerdict::Consume;
+                        });
+                }
+                g_peer_lane_busy.store(false, std::memory_order_release);
+            }
+#endif
+
+            SS_PROBE2(block_drained, pc,
+                      metrics->messages_processed.load(std::memory_order_relaxed) - processed_before);
+
+            // This block's OSC time window, for draining due scheduled events.
+            int64_t currentOscTime = ntp_to_osc_timetag(current_ntp);
+            int64_t nextOscTime = currentOscTime + g_osc_increment;
+            g_block_osc_time = currentOscTime;
+
 #if SUPERSONIC_SYNTH
+            // Idle: no synths, nothing performed this block and nothing due in
+            // it. The first such block renders as usual, which leaves silence on
+            // the output buses and in static_audio_bus; later ones only advance
+            // the block counter (so bus-touched stamps stay valid) and return.
+            const bool quiet =
+                metrics->messages_processed.load(std::memory_order_relaxed) == processed_before &&
+                idle_quiet(nextOscTime, active_input_channels);
+            if (quiet && g_idle_silent) {
+                g_world->mBufCounter++;
+                ++g_idle_blocks;
+                ss_meter_silence(shared_memory + METER_START, 1, g_world->mNumOutputs,
+                                 g_world->mNumAudioBusChannels);
+                SS_PROBE2(block_end, pc, 1);
+                return true;
+            }
+            g_idle_silent = quiet;
+
             // Block size from scsynth's World options. Web: always 128
             // (AudioWorklet render quantum). Native: chosen at boot —
             // typically equal to the hardware callback buffer size.
@@ -1155,10 +1451,6 @@ extern "C" {
             memset(static_audio_bus, 0, QUANTUM_SIZE * g_world->mNumOutputs * sizeof(float));
 #endif
 
-            // This block's OSC time window, for draining due scheduled events.
-            int64_t currentOscTime = ntp_to_osc_timetag(current_ntp);
-            int64_t nextOscTime = currentOscTime + g_osc_increment;
-
             // Schedule any midi_clock_beat burst ticks due in the look-ahead
             // window (SuperClock-timed) into the same scheduler, so they stay
             // sample-locked to audio.
@@ -1171,12 +1463,16 @@ extern "C" {
             // block's start, so the synth backend places the event sample-accurately
             // (offset = ev.when - block start); other handlers ignore both.
             ss_fire_due(g_scheduler, nextOscTime, currentOscTime,
-                [](const uint8_t* d, uint32_t n, uint32_t token, int64_t when, int64_t bt) {
+                [trace](const uint8_t* d, uint32_t n, uint32_t token, int64_t when, int64_t bt,
+                        const EngineScheduler::EngineMeta& meta) {
                     dispatch(d, n, token, when, bt);
+                    if (trace && meta.latencyClass != kSsLatencyUntraced)
+                        record_latency(token, meta.latencyClass, meta.ingressUs);
                 });
             // Publish queue depth once per block, after draining (size() reflects
             // released slots — a per-event read would lag release and never reach 0).
             update_scheduler_depth_metric(g_scheduler.size());
+            SS_PROBE2(block_fired, pc, g_scheduler.size());
 
 #if SUPERSONIC_SYNTH
             // Run the graph (DSP pass): resets the event-time offset, marks the
@@ -1192,10 +1488,17 @@ extern "C" {
                 rt_alloc::Guard rt_dsp_guard;
                 EngineCore_RunBlock(g_world, active_input_channels);
             }
+            SS_PROBE1(block_rendered, pc);
 
             // Deliver /tr, /n_end, /n_go, etc. produced by this block's graph pass.
             EngineCore_FlushNotifications(g_world);
 
+            // Level meters (bus_meter.h), while the block is still on the buses.
+            ss_meter_block(shared_memory + METER_START, g_world->mAudioBus,
+                           g_world->mAudioBusTouched, g_world->mBufCounter,
+                           g_world->mNumOutputs, g_world->mNumAudioBusChannels,
+                           static_cast<uint32_t>(QUANTUM_SIZE), g_world->mSampleRate);
+
             // Fast copy audio from g_world->mAudioBus to static_audio_bus
             // Layout: Both buffers are channel-by-channel, 128 samples per channel
             float* src = g_world->mAudioBus;
@@ -1241,9 +1544,71 @@ extern "C" {
 #endif // SUPERSONIC_SYNTH
         }
 
+        SS_PROBE2(block_end, pc, 0);
         return true; // Keep processor alive
     }
 
+    // Blocks after the last tick that would render silence and perform nothing
+    // (lanes.h ss_idle_blocks). Block j after the last one fires every event
+    // due by the end of its window, g_block_osc_time + (j + 1) blocks, so the
+    // blocks before the one that fires the next event are free. One more is held
+    // back because the host's NTP can be slewed between ticks. Audio thread,
+    // between ticks.
+    uint32_t engine_idle_blocks(uint32_t max_blocks) {
+#if SUPERSONIC_SYNTH
+        if (!g_idle_silent || !memory_initialized || !control || !g_world) return 0;
+        if (control->in_head.load(std::memory_order_seq_cst) !=
+            control->in_tail.load(std::memory_order_relaxed))
+            return 0;
+#ifndef __EMSCRIPTEN__
+        if (ShmPeerPlaneHeader* plane = g_peer_lane.load(std::memory_order_acquire);
+            plane && plane->cmd_head.load(std::memory_order_acquire) !=
+                         plane->cmd_tail.load(std::memory_order_relaxed))
+            return 0;
+#endif
+        if (!get_midi_clock_out().idle()) return 0;
+        const int64_t next = g_scheduler.nextTime();
+        if (next == INT64_MAX || g_osc_increment <= 0) return max_blocks;
+        const int64_t free_blocks = (next - g_block_osc_time - 1) / g_osc_increment - 2;
+        if (free_blocks <= 0) return 0;
+        return free_blocks < static_cast<int64_t>(max_blocks)
+                   ? static_cast<uint32_t>(free_blocks) : max_blocks;
+#else
+        (void)max_blocks;
+        return 0;
+#endif
+    }
+
+    // A writer the doorbell can't hear is attached (lanes.h ss_idle_unwatched):
+    // the SHM peer lane, whose ring is written from another process.
+    bool engine_idle_unwatched() {
+#ifndef __EMSCRIPTEN__
+        return g_peer_lane.load(std::memory_order_relaxed) != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    // Account for `blocks` blocks the host did not tick (lanes.h ss_idle_skip):
+    // the block counter, process_count and the OSC block clock move on exactly
+    // as if each had rendered its silence. Audio thread, between ticks.
+    void engine_idle_skip(uint32_t blocks) {
+#if SUPERSONIC_SYNTH
+        if (blocks == 0 || !g_idle_silent || !metrics || !g_world) return;
+        g_world->mBufCounter += static_cast<int32>(blocks);
+        g_block_osc_time += static_cast<int64_t>(blocks) * g_osc_increment;
+        metrics->process_count.fetch_add(blocks, std::memory_order_relaxed);
+        g_idle_blocks += blocks;
+        reinterpret_cast<std::atomic<uint32_t>*>(shared_memory + NATIVE_STATS_START +
+                                                 NATIVE_STAT_IDLE_BLOCKS)
+            ->store(g_idle_blocks, std::memory_order_relaxed);
+        ss_meter_silence(shared_memory + METER_START, blocks, g_world->mNumOutputs,
+                         g_world->mNumAudioBusChannels);
+#else
+        (void)blocks;
+#endif
+    }
+
     // Frame a log line as a `/supersonic/debug <text>` OSC message and emit it.
     // Routing keeps the RT-out ring single-writer: on the audio thread the line
     // goes to the lock-free RT-out ring; off the audio thread (watchdog, recovery,
@@ -1384,6 +1749,13 @@ extern "C" {
         return g_world ? static_cast<int>(g_world->mNumInputs) : 0;
     }
 
+    // Live World sample rate. With a pinned internal rate it can differ from
+    // the device's, so the native callback reads it on each device start.
+    EMSCRIPTEN_KEEPALIVE
+    int get_audio_sample_rate() {
+        return g_world ? static_cast<int>(g_world->mSampleRate + 0.5) : 0;
+    }
+
     // Mark an audio bus "touched" so In.ar reads it. Callers from
     // INSIDE process_audio (after the per-block mBufCounter++) write
     // the current counter; pre-process_audio callers (e.g. Link Audio
@@ -1718,4 +2090,15 @@ bool ss_synth_default_route(void* /*routeCtx*/, const void* callCtx,
     }
     return true;
 }
+
+// The default route's counterpart for a pre-decoded command record
+// (dispatch_precoded has already checked it): same reply channel, immediate
+// timing (the sub-block offset is left alone, as for any immediate message),
+// scsynth's jump table instead of the address lookup and type-tag walk.
+static void ss_synth_precoded(const SsCmdView& cmd, uint32_t token) {
+    using namespace scsynth;
+    ReplyAddress reply = ring_reply(token);
+    PerformPrecodedCommand(g_world, cmd, &reply);
+    ++g_precoded_cmds;
+}
 #endif // SUPERSONIC_SYNTH
@@ -19,6 +19,9 @@
 struct World;
 struct WorldOptions;
 struct ReplyAddress;
+struct WorldLimits;
+struct WorldResizeReport;
+struct ShmPeerPlaneHeader;
 
 // Published true by a backend that drains the NRT-out ring (the native NRT
 // gateway). While true, off-audio-thread debug (ss_log) is routed to the locked
@@ -61,6 +64,12 @@ extern "C" {
     // thread applies the flush, so it cannot race producers or the drain.
     void ss_ingress_flush_request();
 
+    // Idle mode, behind lanes.h ss_idle_blocks / ss_idle_skip. Audio thread,
+    // between ticks.
+    uint32_t engine_idle_blocks(uint32_t max_blocks);
+    void     engine_idle_skip(uint32_t blocks);
+    bool     engine_idle_unwatched();
+
 #ifndef __EMSCRIPTEN__
     // Native-only: world teardown/rebuild for cold swap
     void destroy_world();
@@ -69,6 +78,19 @@ extern "C" {
     // World and clears memory_initialized/shared_memory/control/metrics so
     // the lanes entry points reject before the host unmaps the segment.
     void teardown_memory();
+
+    // Native-only: grow the World's limits in place (SC_WorldResize.h).
+    // Prepares on the calling thread, waits up to timeout_ms for the audio
+    // thread to swap it in at a block boundary, and fills *report. Returns
+    // nullptr on success, else why nothing changed. Serialised; the caller
+    // keeps cold swaps out for the duration.
+    const char* world_grow(const WorldLimits* want, uint32_t timeout_ms, WorldResizeReport* report);
+    bool world_limits(WorldLimits* current, WorldLimits* ceiling);
+
+    // Native-only: drain a peer's SHM command ring (shm_peer_plane.h) straight
+    // from process_audio, as a second IN lane; null withdraws it. Returns once
+    // the audio thread can no longer be reading the previous plane.
+    void peer_lane_attach(ShmPeerPlaneHeader* plane);
 #endif
 
     // scsynth audio bus functions
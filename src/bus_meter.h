@@ -0,0 +1,281 @@
+/*
+ * SuperSonic
+ * Copyright (c) 2025 Sam Aaron
+ *
+ * Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+ *
+ * bus_meter.h — built-in level meters for the hardware outputs and a
+ * client-selected set of audio buses.
+ *
+ * Without them a client shows levels by running an analysis synth per
+ * channel (Amplitude/Peak + SendReply), which costs a synth slot, RT
+ * allocations in Node_SendReply and a stream of OSC replies at UI frame
+ * rate. Here the audio thread measures each metered channel once per block,
+ * right after the graph pass, with the nova-simd peak-meter kernels
+ * (simd_peakmeter.hpp), and publishes the levels into the METER region of
+ * the arena (shared_memory.h). Native, shm and JS readers all poll the same
+ * seqlock-protected block; no OSC is involved.
+ *
+ * True peak is the largest magnitude of the signal 4x oversampled, as in
+ * ITU-R BS.1770 annex 2: three interpolated points between each pair of
+ * samples from a 12-tap Hann-windowed sinc, 6 samples of delay.
+ *
+ * Off by default. Disabled, the audio thread pays one atomic load per
+ * block. The region has a single writer for its published half, the audio
+ * thread; the request half is the clients' (see shared_memory.h).
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "shared_memory.h"
+#include "simd_peakmeter.hpp"
+
+constexpr uint32_t kSsMeterDefaultRmsMs  = 300;    // VU-like
+constexpr uint32_t kSsMeterDefaultPeakMs = 1700;   // IEC 60268-10 type I: 20 dB in 1.7 s
+constexpr uint32_t kSsMeterMaxMs         = 60000;
+constexpr uint32_t kSsMeterTaps          = 12;     // per oversampling phase
+constexpr uint32_t kSsMeterPhases        = 3;      // interpolated points per sample
+constexpr uint32_t kSsMeterChunk         = 128;    // true-peak working set, frames
+
+struct SsMeterState {
+    uint32_t gen = 0;                 // REQ_GEN applied
+    uint32_t flags = 0;
+    uint32_t outputs = 0;
+    uint32_t buses = 0;
+    uint32_t busIds[METER_MAX_BUSES] = {};
+    uint32_t rmsMs = kSsMeterDefaultRmsMs;
+    uint32_t peakMs = kSsMeterDefaultPeakMs;
+    uint32_t blocks = 0;
+
+    // Per-block coefficients, for the block length and rate they were made for.
+    uint32_t coefFrames = 0;
+    double   coefRate = 0.0;
+    float    rmsCoef = 0.f;           // one-pole step toward this block's mean square
+    float    peakFall = 0.f;          // per-block peak multiplier
+
+    float peak[METER_MAX_CHANNELS] = {};
+    float meanSquare[METER_MAX_CHANNELS] = {};
+    float truePeak[METER_MAX_CHANNELS] = {};
+    float max[METER_MAX_CHANNELS] = {};
+    float history[METER_MAX_CHANNELS][kSsMeterTaps - 1] = {};
+};
+
+inline SsMeterState g_meter;
+inline float        g_meter_fir[kSsMeterPhases][kSsMeterTaps];
+inline bool         g_meter_fir_ready = false;
+
+namespace ss_meter_detail {
+inline std::atomic<uint32_t>* u32(uint8_t* region, uint32_t off) {
+    return reinterpret_cast<std::atomic<uint32_t>*>(region + off);
+}
+
+inline void store_f32(uint8_t* region, uint32_t off, float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    u32(region, off)->store(bits, std::memory_order_relaxed);
+}
+
+// Denormal-free decay: a level this far below full scale reads as silence.
+inline float settle(float v) { return v < 1e-9f ? 0.f : v; }
+
+// Phase p interpolates at 0.25 (p + 1) samples past window[5]. Each phase is
+// normalised to unity DC gain.
+inline void make_fir() {
+    constexpr double kPi = 3.14159265358979323846;
+    const double half = kSsMeterTaps / 2.0;
+    for (uint32_t p = 0; p < kSsMeterPhases; ++p) {
+        double sum = 0.0;
+        double h[kSsMeterTaps];
+        for (uint32_t k = 0; k < kSsMeterTaps; ++k) {
+            const double d = (half - 1.0) + 0.25 * (p + 1) - k;
+            const double sinc = d == 0.0 ? 1.0 : std::sin(kPi * d) / (kPi * d);
+            const double hann = 0.5 * (1.0 + std::cos(kPi * d / half));
+            h[k] = sinc * hann;
+            sum += h[k];
+        }
+        for (uint32_t k = 0; k < kSsMeterTaps; ++k)
+            g_meter_fir[p][k] = static_cast<float>(h[k] / sum);
+    }
+    g_meter_fir_ready = true;
+}
+}  // namespace ss_meter_detail
+
+// Largest interpolated magnitude over `n` samples of `in`. `history` holds
+// the channel's last kSsMeterTaps - 1 input samples and is advanced.
+inline float ss_meter_true_peak(const float* in, uint32_t n, float* history) {
+    constexpr uint32_t H = kSsMeterTaps - 1;
+    if (!g_meter_fir_ready) ss_meter_detail::make_fir();
+    float work[H + kSsMeterChunk];
+    std::memcpy(work, history, H * sizeof(float));
+    float tp = 0.f;
+    while (n) {
+        const uint32_t m = n < kSsMeterChunk ? n : kSsMeterChunk;
+        std::memcpy(work + H, in, m * sizeof(float));
+        for (uint32_t i = 0; i < m; ++i) {
+            const float* x = work + i;
+            for (uint32_t p = 0; p < kSsMeterPhases; ++p) {
+                float acc = 0.f;
+                for (uint32_t k = 0; k < kSsMeterTaps; ++k)
+                    acc += g_meter_fir[p][k] * x[k];
+                tp = std::max(tp, std::fabs(acc));
+            }
+        }
+        std::memmove(work, work + m, H * sizeof(float));
+        in += m;
+        n -= m;
+    }
+    std::memcpy(history, work, H * sizeof(float));
+    return tp;
+}
+
+// Seqlock writer, as SuperClock::publishSampleClock: odd SEQ, release fence,
+// relaxed field stores, even SEQ with release.
+inline void ss_meter_publish(uint8_t* region) {
+    using namespace ss_meter_detail;
+    const SsMeterState& m = g_meter;
+    auto* seq = u32(region, METER_SEQ);
+    const uint32_t s = seq->load(std::memory_order_relaxed);
+    seq->store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    u32(region, METER_GEN)->store(m.gen, std::memory_order_relaxed);
+    u32(region, METER_FLAGS)->store(m.flags, std::memory_order_relaxed);
+    u32(region, METER_OUTPUTS)->store(m.outputs, std::memory_order_relaxed);
+    u32(region, METER_BUSES)->store(m.buses, std::memory_order_relaxed);
+    u32(region, METER_RMS_MS)->store(m.rmsMs, std::memory_order_relaxed);
+    u32(region, METER_PEAK_MS)->store(m.peakMs, std::memory_order_relaxed);
+    u32(region, METER_BLOCKS)->store(m.blocks, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < METER_MAX_BUSES; ++i)
+        u32(region, METER_BUS_IDS + i * 4)->store(m.busIds[i], std::memory_order_relaxed);
+    for (uint32_t c = 0; c < METER_MAX_CHANNELS; ++c) {
+        const uint32_t row = METER_ROWS + c * METER_ROW_SIZE;
+        store_f32(region, row + 0, m.peak[c]);
+        store_f32(region, row + 4, std::sqrt(m.meanSquare[c]));
+        store_f32(region, row + 8, m.truePeak[c]);
+        store_f32(region, row + 12, m.max[c]);
+    }
+    seq->store(s + 2, std::memory_order_release);
+}
+
+// Take up a new request: validate it against the World's bus count, zero
+// the levels and publish the applied configuration.
+inline void ss_meter_apply(uint8_t* region, uint32_t gen, uint32_t numOutputs,
+                           uint32_t numAudioBuses) {
+    using ss_meter_detail::u32;
+    SsMeterState& m = g_meter;
+    const uint32_t flags = u32(region, METER_REQ_FLAGS)->load(std::memory_order_relaxed);
+    const uint32_t rmsMs = u32(region, METER_REQ_RMS_MS)->load(std::memory_order_relaxed);
+    const uint32_t peakMs = u32(region, METER_REQ_PEAK_MS)->load(std::memory_order_relaxed);
+    const uint32_t want = std::min(
+        u32(region, METER_REQ_BUS_COUNT)->load(std::memory_order_relaxed), METER_MAX_BUSES);
+
+    m = SsMeterState{};
+    m.gen = gen;
+    m.flags = flags & (METER_FLAG_ON | METER_FLAG_TRUE_PEAK);
+    m.rmsMs = rmsMs ? std::min(rmsMs, kSsMeterMaxMs) : kSsMeterDefaultRmsMs;
+    m.peakMs = peakMs ? std::min(peakMs, kSsMeterMaxMs) : kSsMeterDefaultPeakMs;
+    if (m.flags & METER_FLAG_ON) {
+        m.outputs = std::min(numOutputs, METER_MAX_OUTPUTS);
+        for (uint32_t i = 0; i < want; ++i) {
+            const uint32_t bus = u32(region, METER_REQ_BUSES + i * 4)->load(std::memory_order_relaxed);
+            if (bus < numAudioBuses) m.busIds[m.buses++] = bus;
+        }
+    }
+    ss_meter_publish(region);
+}
+
+namespace ss_meter_detail {
+inline void make_coefficients(uint32_t frames, double sampleRate) {
+    SsMeterState& m = g_meter;
+    const double blockMs = 1000.0 * frames / sampleRate;
+    m.rmsCoef = static_cast<float>(1.0 - std::exp(-blockMs / m.rmsMs));
+    m.peakFall = static_cast<float>(std::pow(10.0, -blockMs / m.peakMs));
+    m.coefFrames = frames;
+    m.coefRate = sampleRate;
+}
+
+inline uint32_t channels() { return g_meter.outputs + g_meter.buses; }
+}  // namespace ss_meter_detail
+
+// Once per rendered block, after the graph pass. `audioBus` is the World's
+// bus area, channel-major with `frames` samples per bus; a bus counts only if
+// it is an output or was written this block (touched == bufCounter), as In.ar
+// reads them.
+inline void ss_meter_block(uint8_t* region, const float* audioBus, const int32_t* touched,
+                           int32_t bufCounter, uint32_t numOutputs, uint32_t numAudioBuses,
+                           uint32_t frames, double sampleRate) {
+    using namespace ss_meter_detail;
+    const uint32_t gen = u32(region, METER_REQ_GEN)->load(std::memory_order_acquire);
+    if (gen != g_meter.gen) ss_meter_apply(region, gen, numOutputs, numAudioBuses);
+    SsMeterState& m = g_meter;
+    if (!(m.flags & METER_FLAG_ON) || frames == 0 || sampleRate <= 0.0) return;
+    if (frames != m.coefFrames || sampleRate != m.coefRate) make_coefficients(frames, sampleRate);
+
+#ifdef NOVA_SIMD
+    // peak_rms_vec_simd takes aligned blocks of four vectors.
+    constexpr uint32_t kUnroll = 4 * nova::vec<float>::size;
+#endif
+    const uint32_t n = channels();
+    for (uint32_t c = 0; c < n; ++c) {
+        const uint32_t bus = c < m.outputs ? c : m.busIds[c - m.outputs];
+        const bool live = bus < numOutputs || (bus < numAudioBuses && touched[bus] == bufCounter);
+        float peak = 0.f, sumSquares = 0.f, truePeak = 0.f;
+        if (live) {
+            const float* in = audioBus + static_cast<size_t>(bus) * frames;
+#ifdef NOVA_SIMD
+            if (frames % kUnroll == 0 &&
+                (reinterpret_cast<uintptr_t>(in) % (nova::vec<float>::size * sizeof(float))) == 0)
+                nova::peak_rms_vec_simd(in, &peak, &sumSquares, frames);
+            else
+#endif
+                nova::peak_rms_vec(in, &peak, &sumSquares, frames);
+            truePeak = (m.flags & METER_FLAG_TRUE_PEAK)
+                ? std::max(peak, ss_meter_true_peak(in, frames, m.history[c])) : peak;
+        } else if (m.flags & METER_FLAG_TRUE_PEAK) {
+            std::memset(m.history[c], 0, sizeof m.history[c]);
+        }
+        m.peak[c] = settle(std::max(peak, m.peak[c] * m.peakFall));
+        m.truePeak[c] = settle(std::max(truePeak, m.truePeak[c] * m.peakFall));
+        m.meanSquare[c] = settle(m.meanSquare[c] + m.rmsCoef * (sumSquares / frames - m.meanSquare[c]));
+        m.max[c] = std::max(m.max[c], truePeak);
+    }
+    ++m.blocks;
+    ss_meter_publish(region);
+}
+
+// True while a metered bus is one of the live input buses
+// [firstInput, firstInput + numInputs): those carry signal with no synth
+// running, so the engine must keep rendering for them to be measured.
+inline bool ss_meter_reads_inputs(uint32_t firstInput, uint32_t numInputs) {
+    const SsMeterState& m = g_meter;
+    if (!(m.flags & METER_FLAG_ON)) return false;
+    for (uint32_t i = 0; i < m.buses; ++i)
+        if (m.busIds[i] - firstInput < numInputs) return true;
+    return false;
+}
+
+// `blocks` blocks of silence the engine did not render (idle skip): the
+// levels fall as if they had been metered. A pending request is applied.
+inline void ss_meter_silence(uint8_t* region, uint32_t blocks, uint32_t numOutputs,
+                             uint32_t numAudioBuses) {
+    using namespace ss_meter_detail;
+    const uint32_t gen = u32(region, METER_REQ_GEN)->load(std::memory_order_acquire);
+    if (gen != g_meter.gen) ss_meter_apply(region, gen, numOutputs, numAudioBuses);
+    SsMeterState& m = g_meter;
+    if (!(m.flags & METER_FLAG_ON) || blocks == 0 || m.coefFrames == 0) return;
+    const float fall = static_cast<float>(std::pow(static_cast<double>(m.peakFall), blocks));
+    const float keep = static_cast<float>(std::pow(1.0 - m.rmsCoef, static_cast<double>(blocks)));
+    const uint32_t n = channels();
+    for (uint32_t c = 0; c < n; ++c) {
+        m.peak[c] = settle(m.peak[c] * fall);
+        m.truePeak[c] = settle(m.truePeak[c] * fall);
+        m.meanSquare[c] = settle(m.meanSquare[c] * keep);
+        std::memset(m.history[c], 0, sizeof m.history[c]);
+    }
+    m.blocks += blocks;
+    ss_meter_publish(region);
+}
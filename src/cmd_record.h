@@ -0,0 +1,399 @@
+/*
+ * SuperSonic
+ * Copyright (c) 2025 Sam Aaron
+ *
+ * Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+ *
+ * cmd_record.h — pre-decoded command records: the hot scsynth commands
+ * (/s_new, /n_set, /n_free, /g_new, /n_map, /c_set) decoded by the producer
+ * that writes the IN ring, so the audio thread does neither the address
+ * lookup nor the type-tag walk nor the control-name hashing.
+ *
+ * A record travels in an ordinary IN-ring frame whose Message.sourceId has
+ * SOURCE_ID_PRECODED set (ring.h); the low 31 bits stay the origin token.
+ * Payload layout, host byte order, every part 4-aligned:
+ *
+ *   SsCmdRecord                 fixed header (command + leading args)
+ *   SsCmdEntry[count]           one per repeated argument group
+ *   the original OSC message    oscLen bytes, at oscOffset
+ *
+ * The original message rides along, so the consumer can always fall back to
+ * the raw path (/dumpOSC, a scheduler scan, a build without the jump table),
+ * and names in entries are offsets into that copy — the string compare
+ * behind a hash match still has its key, and nothing points across
+ * processes.
+ *
+ * ss_cmd_encode() accepts only the argument shapes whose meaning it can
+ * reproduce exactly (type-tagged, integer node ids, no node-path strings, no
+ * tags other than i/f/s/[ ]); anything else returns 0 and the producer writes
+ * the message raw. ss_cmd_view() is the consumer's bounds check — the IN
+ * ring lives in shared memory, so a record is validated before any offset in
+ * it is followed.
+ *
+ * Header-only; standard C++ only, no allocation, never reads past len.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "synth/include/server/SC_OSC_Commands.h"   // cmd_s_new, … (the jump-table index)
+
+struct SsCmdRecord {
+    uint16_t cmd;         // scsynth command number (cmd_s_new, …)
+    uint16_t count;       // SsCmdEntry records that follow
+    uint32_t oscOffset;   // payload offset of the original message
+    uint32_t oscLen;
+    int32_t  node;        // s_new: new node id; n_set / n_map: target node id
+    int32_t  addAction;   // s_new
+    int32_t  target;      // s_new: target node id
+    int32_t  nameHash;    // s_new: Hash(defname)
+    uint32_t nameOff;     // s_new: defname offset within the original message
+};
+static_assert(sizeof(SsCmdRecord) == 32, "SsCmdRecord is wire format");
+
+// Entry ops for control arguments (/s_new, /n_set, /n_map).
+enum SsCmdOp : uint8_t {
+    kSsCmdSet        = 0,  // value.f → control
+    kSsCmdMapControl = 1,  // map control to control bus value.i ("c12", /n_map)
+    kSsCmdMapAudio   = 2,  // map control to audio bus value.i ("a12")
+};
+
+struct SsCmdEntry {
+    int32_t  key;       // control index, or Hash(name) when nameOff != 0;
+                        // n_free: node id; g_new: new group id; c_set: bus index
+    uint32_t nameOff;   // control name offset in the original message; 0 = key
+                        // is an index (offset 0 is the address, never a name)
+    union {
+        float   f;      // set ops, c_set: the value
+        int32_t i;      // map ops: the bus; g_new: the target node id
+    } value;
+    uint16_t aux;       // control ops: element within the control (name[aux],
+                        // index + aux); g_new: the add action
+    uint8_t  op;        // SsCmdOp
+    uint8_t  pad;
+};
+static_assert(sizeof(SsCmdEntry) == 16, "SsCmdEntry is wire format");
+
+// A validated record, pointing into the payload it was checked against.
+struct SsCmdView {
+    const SsCmdRecord* rec     = nullptr;
+    const SsCmdEntry*  entries = nullptr;
+    const char*        osc     = nullptr;   // the original message (also set
+    uint32_t           oscLen  = 0;         // when only the entries are bad)
+    uint32_t           size    = 0;         // whole payload
+};
+
+// Producer-side buffer that covers every record the hot path builds; larger
+// messages are written raw.
+constexpr uint32_t SS_CMD_RECORD_MAX = 2048;
+
+namespace ss_cmd_detail {
+
+// Hash(const int32*) from Hash.h: Thomas Wang's integer hash folded over the
+// name's 32-bit words (native byte order) up to the word holding its NUL.
+inline int32_t hashName(const uint8_t* s) {
+    const uint32_t lastChar = [] {
+        const uint32_t probe = 1;
+        uint8_t first;
+        std::memcpy(&first, &probe, 1);
+        return first ? 0xFF000000u : 0x000000FFu;
+    }();
+    uint32_t hash = 0;
+    uint32_t c;
+    do {
+        std::memcpy(&c, s, 4);
+        s += 4;
+        uint32_t h = hash + c;
+        h += ~(h << 15);
+        h ^= h >> 10;
+        h += h << 3;
+        h ^= h >> 6;
+        h += ~(h << 11);
+        h ^= h >> 16;
+        hash = h;
+    } while (c & lastChar);
+    return static_cast<int32_t>(hash);
+}
+
+// sc_atoi from SC_Str4.h ("c12" → 12 after the prefix; "" → -1).
+inline int32_t scAtoi(const char* s) {
+    if (*s == 0) return -1;
+    uint32_t value = 0, c;
+    while ((c = static_cast<uint32_t>(*s++ - '0')) <= 9) value = value * 10 + c;
+    return static_cast<int32_t>(value);
+}
+
+inline uint32_t load_be32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+// Bounded reader over a type-tagged OSC message. Every read checks bounds
+// and its tag; a failed read poisons the encode (return 0 → raw).
+struct Reader {
+    const uint8_t* data;
+    uint32_t       len;
+    uint32_t       pos   = 0;      // argument data cursor
+    const char*    tags  = nullptr;
+    uint32_t       ntags = 0;
+    uint32_t       tag   = 0;      // next tag index
+
+    uint32_t remain() const { return len - pos; }
+    char next() const { return tag < ntags ? tags[tag] : '\0'; }
+
+    // End of the NUL-terminated, 4-padded OSC string at `at`; 0 if it runs
+    // past len or its last pad byte isn't NUL (Hash and str4eq stop on the
+    // word whose last byte is zero).
+    uint32_t strEnd(uint32_t at) const {
+        uint32_t e = at;
+        while (e < len && data[e] != '\0') ++e;
+        if (e == len) return 0;
+        const uint32_t end = (e + 4u) & ~3u;
+        return end <= len && data[end - 1] == '\0' ? end : 0;
+    }
+    bool i32(int32_t& v) {
+        if (next() != 'i' || remain() < 4) return false;
+        v = static_cast<int32_t>(load_be32(data + pos));
+        pos += 4; ++tag;
+        return true;
+    }
+    bool f32(float& v) {   // getf: 'f', or an 'i' converted
+        const char t = next();
+        if ((t != 'f' && t != 'i') || remain() < 4) return false;
+        const uint32_t bits = load_be32(data + pos);
+        if (t == 'f') std::memcpy(&v, &bits, 4);
+        else v = static_cast<float>(static_cast<int32_t>(bits));
+        pos += 4; ++tag;
+        return true;
+    }
+    bool str(uint32_t& off) {
+        if (next() != 's') return false;
+        const uint32_t end = strEnd(pos);
+        if (end == 0) return false;
+        off = pos;
+        pos = end; ++tag;
+        return true;
+    }
+};
+
+// Output cursor over the caller's buffer.
+struct Writer {
+    uint8_t*  out;
+    uint32_t  cap;
+    uint32_t  count = 0;
+    bool      ok    = true;
+
+    SsCmdEntry* add() {
+        const uint32_t at = sizeof(SsCmdRecord) + count * sizeof(SsCmdEntry);
+        if (!ok || count == 0xFFFF || at + sizeof(SsCmdEntry) > cap) { ok = false; return nullptr; }
+        ++count;
+        auto* e = reinterpret_cast<SsCmdEntry*>(out + at);
+        std::memset(e, 0, sizeof(*e));
+        return e;
+    }
+};
+
+// The control-argument loop shared by /s_new (Graph_Ctor) and /n_set
+// (meth_n_set). They differ only in how the element index advances:
+// Graph_Ctor steps it for every tag ('[' cancels its own step), meth_n_set
+// only for values and c/a bus mappings.
+inline bool controls(Reader& r, Writer& w, bool synthNew) {
+    while (r.remain() >= 8) {
+        int32_t  key;
+        uint32_t nameOff = 0;
+        if (r.next() == 's') {
+            if (!r.str(nameOff)) return false;
+            key = hashName(r.data + nameOff);
+        } else if (!r.i32(key)) {
+            return false;
+        }
+        int32_t i = 0, loop = 0;
+        do {
+            const char t = r.next();
+            switch (t) {
+            case 'f':
+            case 'i': {
+                float v;
+                if (!r.f32(v)) return false;
+                SsCmdEntry* e = w.add();
+                if (!e) return false;
+                e->key = key; e->nameOff = nameOff;
+                e->value.f = v; e->aux = static_cast<uint16_t>(i); e->op = kSsCmdSet;
+                if (!synthNew) ++i;
+                break;
+            }
+            case 's': {
+                uint32_t off;
+                if (!r.str(off)) return false;
+                const char* s = reinterpret_cast<const char*>(r.data + off);
+                if (*s == 'c' || *s == 'a') {
+                    SsCmdEntry* e = w.add();
+                    if (!e) return false;
+                    e->key = key; e->nameOff = nameOff;
+                    e->value.i = scAtoi(s + 1); e->aux = static_cast<uint16_t>(i);
+                    e->op = *s == 'c' ? kSsCmdMapControl : kSsCmdMapAudio;
+                    if (!synthNew) ++i;
+                }
+                break;
+            }
+            case '[':
+                ++r.tag; ++loop;
+                if (synthNew) --i;
+                break;
+            case ']':
+                ++r.tag; --loop;
+                if (loop < 0) return false;
+                break;
+            default:
+                return false;   // 'd', 'b', 'T', missing tag, …: raw path
+            }
+            if (synthNew) ++i;
+            if (i < 0 || i > 0xFFFF) return false;
+        } while (loop);
+    }
+    return true;
+}
+
+}  // namespace ss_cmd_detail
+
+// Decode `osc` (one OSC message, not a bundle) into a record in `out`.
+// Returns the record's length, or 0 when the message is not one of the hot
+// commands in a shape the record can carry — the caller then writes it raw.
+inline uint32_t ss_cmd_encode(const uint8_t* osc, uint32_t len, uint8_t* out, uint32_t cap) {
+    using namespace ss_cmd_detail;
+    if (!osc || !out || len < 8 || osc[0] != '/' || (len & 3u)) return 0;
+
+    static constexpr struct { char addr[8]; uint16_t cmd; } kHot[] = {
+        { "/s_new", cmd_s_new }, { "/n_set", cmd_n_set }, { "/n_free", cmd_n_free },
+        { "/g_new", cmd_g_new }, { "/n_map", cmd_n_map }, { "/c_set", cmd_c_set },
+    };
+    Reader r{ osc, len };
+    const uint32_t tagsAt = r.strEnd(0);
+    if (tagsAt == 0 || tagsAt >= len || osc[tagsAt] != ',') return 0;
+    uint16_t cmd = 0;
+    for (const auto& h : kHot)
+        if (std::strcmp(reinterpret_cast<const char*>(osc), h.addr) == 0) cmd = h.cmd;
+    if (cmd == 0) return 0;
+    const uint32_t argsAt = r.strEnd(tagsAt);
+    if (argsAt == 0) return 0;
+    r.tags  = reinterpret_cast<const char*>(osc + tagsAt + 1);
+    r.ntags = static_cast<uint32_t>(std::strlen(r.tags));
+    r.pos   = argsAt;
+
+    if (cap < sizeof(SsCmdRecord)) return 0;
+    SsCmdRecord rec{};
+    rec.cmd = cmd;
+    Writer w{ out, cap };
+
+    // Name offsets (nameOff) are relative to the original message, so the
+    // entries can be written before the copy's place is known.
+    switch (cmd) {
+    case cmd_s_new:
+        if (!r.str(rec.nameOff) || !r.i32(rec.node) || !r.i32(rec.addAction) ||
+            !r.i32(rec.target) || !controls(r, w, true))
+            return 0;
+        rec.nameHash = hashName(osc + rec.nameOff);
+        break;
+    case cmd_n_set:
+        if (!r.i32(rec.node) || !controls(r, w, false)) return 0;
+        break;
+    case cmd_n_map:
+        if (!r.i32(rec.node)) return 0;
+        while (r.remain() >= 8) {
+            int32_t key, bus;
+            uint32_t nameOff = 0;
+            if (r.next() == 's') {
+                if (!r.str(nameOff)) return 0;
+                key = hashName(osc + nameOff);
+            } else if (!r.i32(key)) {
+                return 0;
+            }
+            if (!r.i32(bus)) return 0;
+            SsCmdEntry* e = w.add();
+            if (!e) return 0;
+            e->key = key; e->nameOff = nameOff; e->value.i = bus; e->op = kSsCmdMapControl;
+        }
+        break;
+    case cmd_n_free:
+        while (r.remain() > 0) {
+            SsCmdEntry* e = w.add();
+            if (!e || !r.i32(e->key)) return 0;
+        }
+        break;
+    case cmd_g_new:
+        while (r.remain() > 0) {
+            int32_t action;
+            SsCmdEntry* e = w.add();
+            if (!e || !r.i32(e->key) || !r.i32(action) || !r.i32(e->value.i)) return 0;
+            if (action < 0 || action > 0xFFFF) return 0;
+            e->aux = static_cast<uint16_t>(action);
+        }
+        break;
+    case cmd_c_set:
+        while (r.remain() >= 8) {
+            SsCmdEntry* e = w.add();
+            if (!e || !r.i32(e->key) || !r.f32(e->value.f)) return 0;
+        }
+        break;
+    }
+    if (!w.ok) return 0;
+
+    rec.count     = static_cast<uint16_t>(w.count);
+    rec.oscOffset = static_cast<uint32_t>(sizeof(SsCmdRecord) + w.count * sizeof(SsCmdEntry));
+    rec.oscLen    = len;
+    if (rec.oscOffset + len > cap) return 0;
+    std::memcpy(out, &rec, sizeof(rec));
+    std::memcpy(out + rec.oscOffset, osc, len);
+    return rec.oscOffset + len;
+}
+
+// Consumer-side check of a flagged payload. Fills `v` and returns true when
+// every offset in the record stays inside the payload and every name it
+// references is a terminated string within the original message. When only
+// the header and the original message check out, v.osc / v.oscLen are still
+// set (and false returned) so the caller can dispatch the message raw.
+inline bool ss_cmd_view(const uint8_t* payload, uint32_t size, SsCmdView& v) {
+    v = SsCmdView{};
+    if (!payload || size < sizeof(SsCmdRecord)) return false;
+    const auto* rec = reinterpret_cast<const SsCmdRecord*>(payload);
+    const uint64_t tableEnd = sizeof(SsCmdRecord) + uint64_t(rec->count) * sizeof(SsCmdEntry);
+    if ((rec->oscOffset & 3u) || rec->oscOffset < tableEnd ||
+        uint64_t(rec->oscOffset) + rec->oscLen > size || rec->oscLen < 4)
+        return false;
+    const char* osc = reinterpret_cast<const char*>(payload + rec->oscOffset);
+    v.osc    = osc;
+    v.oscLen = rec->oscLen;
+
+    // A name must start on a word inside the message and reach a word whose
+    // last byte is NUL before the message ends: the hash and str4 compares
+    // read it a word at a time up to that word.
+    auto nameOk = [osc, len = rec->oscLen](uint32_t off) {
+        if (off == 0 || (off & 3u)) return false;
+        for (; off + 4 <= len; off += 4)
+            if (osc[off + 3] == '\0') return true;
+        return false;
+    };
+    if (rec->cmd == cmd_s_new && !nameOk(rec->nameOff)) return false;
+    const auto* entries = reinterpret_cast<const SsCmdEntry*>(payload + sizeof(SsCmdRecord));
+    for (uint32_t i = 0; i < rec->count; ++i) {
+        const SsCmdEntry& e = entries[i];
+        if (e.nameOff && !nameOk(e.nameOff)) return false;
+        if (e.op > kSsCmdMapAudio) return false;
+    }
+    v.rec     = rec;
+    v.entries = entries;
+    v.size    = size;
+    return true;
+}
+
+// The view of a record ss_cmd_view has already accepted (the jump-table
+// handlers receive the payload pointer only).
+inline SsCmdView ss_cmd_view_checked(const char* payload) {
+    SsCmdView v;
+    v.rec     = reinterpret_cast<const SsCmdRecord*>(payload);
+    v.entries = reinterpret_cast<const SsCmdEntry*>(payload + sizeof(SsCmdRecord));
+    v.osc     = payload + v.rec->oscOffset;
+    v.oscLen  = v.rec->oscLen;
+    return v;
+}
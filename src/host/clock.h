@@ -31,4 +31,22 @@ inline int64_t osc_now() {
     return ntp_to_osc_timetag(unix_seconds + supersonic::kNtpEpochOffset);
 }
 
+// OSC timetag -> Unix-epoch nanoseconds on the same system clock, for absolute
+// sleeps. Timetags before 1970 clamp to 0.
+inline int64_t osc_to_unix_ns(int64_t timetag) {
+    const uint64_t tt   = static_cast<uint64_t>(timetag);
+    const int64_t  secs = static_cast<int64_t>(tt >> 32)
+                        - static_cast<int64_t>(supersonic::kNtpEpochOffset);
+    if (secs < 0) return 0;
+    const int64_t frac = static_cast<int64_t>(((tt & 0xFFFFFFFFull) * 1'000'000'000ull) >> 32);
+    return secs * 1'000'000'000 + frac;
+}
+
+// A non-negative timetag difference in microseconds.
+inline int64_t osc_delta_us(int64_t delta) {
+    const uint64_t d = static_cast<uint64_t>(delta);
+    return static_cast<int64_t>((d >> 32) * 1'000'000ull
+                              + (((d & 0xFFFFFFFFull) * 1'000'000ull) >> 32));
+}
+
 }  // namespace ss_host
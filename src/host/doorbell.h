@@ -0,0 +1,96 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+
+    Doorbell for the standalone host's tick loop: one thread sleeps until an
+    absolute wall-clock deadline, any other thread can wake it early.
+
+    The sleeper reads the ring count with arm(), decides how long to sleep, and
+    passes that count to wait(). A ring() in between bumps the count, so the wait
+    returns at once instead of missing the wake-up. On Linux the wait is a
+    FUTEX_WAIT_BITSET with an absolute CLOCK_REALTIME timeout: the same hrtimer
+    path as clock_nanosleep(TIMER_ABSTIME), but interruptible by a FUTEX_WAKE. The
+    deadline is on CLOCK_REALTIME because OSC timetags are wall-clock time
+    (clock.h). Elsewhere it is a condition variable with wait_until on the
+    system clock.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace ss_host {
+
+class Doorbell {
+public:
+    // Ring count to hand to wait(). Read it before looking at what to wait for.
+    uint32_t arm() const { return mSeq.load(std::memory_order_acquire); }
+
+    // Wake the sleeper, or make its next wait() on an older count return at once.
+    void ring() {
+        mSeq.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mSeq), FUTEX_WAKE_PRIVATE, 1,
+                nullptr, nullptr, 0);
+#else
+        { std::lock_guard<std::mutex> lk(mMx); }
+        mCv.notify_one();
+#endif
+    }
+
+    // Sleep until `deadlineNs` (Unix-epoch nanoseconds, INT64_MAX = no deadline)
+    // or until the count moves past `armed`. Returns true if rung. May return
+    // early on a signal; callers re-check the clock.
+    bool wait(uint32_t armed, int64_t deadlineNs) {
+#if defined(__linux__)
+        timespec ts;
+        timespec* abs = nullptr;
+        if (deadlineNs != INT64_MAX) {
+            ts.tv_sec  = static_cast<time_t>(deadlineNs / 1'000'000'000);
+            ts.tv_nsec = static_cast<long>(deadlineNs % 1'000'000'000);
+            abs = &ts;
+        }
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mSeq),
+                FUTEX_WAIT_BITSET_PRIVATE | FUTEX_CLOCK_REALTIME, armed, abs, nullptr,
+                FUTEX_BITSET_MATCH_ANY);
+#else
+        std::unique_lock<std::mutex> lk(mMx);
+        auto rung = [&] { return mSeq.load(std::memory_order_acquire) != armed; };
+        if (deadlineNs == INT64_MAX) {
+            mCv.wait(lk, rung);
+        } else {
+            const auto until = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(deadlineNs)));
+            mCv.wait_until(lk, until, rung);
+        }
+#endif
+        return mSeq.load(std::memory_order_acquire) != armed;
+    }
+
+private:
+    // The futex word: a 32-bit aligned counter.
+    std::atomic<uint32_t> mSeq{0};
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word");
+#if !defined(__linux__)
+    std::mutex              mMx;
+    std::condition_variable mCv;
+#endif
+};
+
+}  // namespace ss_host
@@ -11,15 +11,22 @@
     place of the synth default. Decoupled from sockets so it is unit-testable:
     ingest() may be called from a recv thread (it only locks the inbox), tick() is
     called from the single scheduler thread that owns the core.
+
+    The tick thread sleeps until the next due event (tick_loop.h). ingest() rings
+    the doorbell when it queues an event earlier than the deadline that thread is
+    sleeping towards, and tick() records how late each event fired.
 */
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <mutex>
 #include <vector>
 
+#include "clock.h"
+#include "doorbell.h"
 #include "osc_reader.h"
 #include "scheduler/Scheduler.h"
 #include "scheduler/schedule_parse.h"
@@ -33,6 +40,43 @@ namespace ss_host {
 // ev.meta->origin uniformly across both schedulers.
 struct HostMeta { uint32_t origin = 0; };
 
+// Dispatch lateness: how long after its timetag each event was handed to the
+// ingress. Bucket 0 holds 0 µs; bucket b >= 1 holds [2^(b-1), 2^b) µs; the last
+// bucket also takes everything longer. Written by the tick thread only.
+struct LatenessHistogram {
+    static constexpr int kBuckets = 24;
+
+    uint64_t counts[kBuckets] = {};
+    uint64_t total = 0;
+    int64_t  maxUs = 0;
+
+    static int bucket(int64_t us) {
+        if (us <= 0) return 0;
+        int b = 64 - __builtin_clzll(static_cast<uint64_t>(us));
+        return b < kBuckets ? b : kBuckets - 1;
+    }
+    // Exclusive upper bound of bucket b, in µs.
+    static int64_t bucketLimitUs(int b) { return int64_t(1) << b; }
+
+    void record(int64_t us) {
+        ++counts[bucket(us)];
+        ++total;
+        if (us > maxUs) maxUs = us;
+    }
+    // Exclusive upper bound of the bucket holding quantile q (0..1), in µs.
+    int64_t quantileUs(double q) const {
+        if (total == 0) return 0;
+        const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += counts[b];
+            if (seen >= rank) return bucketLimitUs(b);
+        }
+        return bucketLimitUs(kBuckets - 1);
+    }
+    void reset() { *this = LatenessHistogram{}; }
+};
+
 class HostScheduler {
 public:
     explicit HostScheduler(OscIngress& ingress) : mIngress(ingress) {}
@@ -49,9 +93,13 @@ public:
             // "/schedule <timetag> <inner blob>": store the inner message; the
             // outbound side routes it by address (/osc/send or /midi/*).
             SchedulePacket sp = ss_parse_schedule(data, static_cast<uint32_t>(len));
-            if (sp.ok)
+            if (sp.ok) {
                 push(Command{Command::Schedule, sp.when, SCHED_TAG_DEFAULT,
                              std::vector<uint8_t>(sp.blob, sp.blob + sp.blobLen)});
+                // After the push: if the tick thread already drained the inbox,
+                // it has published the deadline it sleeps towards (or kAwake).
+                if (sp.when < mSleepingUntil.load()) mDoorbell.ring();
+            }
         } else if (std::strcmp(addr, "/sched/flush") == 0) {
             uint32_t tag = 0;  // empty/missing tag = flush all
             const char* t;
@@ -76,14 +124,34 @@ public:
             }
         }
         ss_fire_due(mCore, now, /*blockTime*/ 0,
-            [this](const uint8_t* d, uint32_t n, uint32_t, int64_t, int64_t) {
+            [this, now](const uint8_t* d, uint32_t n, uint32_t, int64_t when, int64_t) {
+                mLateness.record(now > when ? osc_delta_us(now - when) : 0);
                 mIngress.ingest(d, n, /*callCtx*/ nullptr);
             });
     }
 
     int pending() const { return mCore.size(); }
 
+    // Timetag of the earliest queued event, INT64_MAX if none. Tick thread; only
+    // covers what the last tick() moved out of the inbox.
+    int64_t nextDue() const { return mCore.nextTime(); }
+
+    // Sleep handshake for the tick thread (tick_loop.h). beginPass() before
+    // tick(): from here on every ingested event rings, and the returned count
+    // goes to doorbell().wait(). sleepingUntil() after tick(), with nextDue():
+    // only events earlier than that ring from then on.
+    uint32_t beginPass() {
+        mSleepingUntil.store(kAwake);
+        return mDoorbell.arm();
+    }
+    void sleepingUntil(int64_t due) { mSleepingUntil.store(due); }
+    Doorbell& doorbell() { return mDoorbell; }
+
+    const LatenessHistogram& lateness() const { return mLateness; }
+    void resetLateness() { mLateness.reset(); }
+
 private:
+    static constexpr int64_t kAwake = INT64_MAX;   // every event is "earlier"
     static constexpr int kSlots    = 256;
     static constexpr int kDataPool = kSlots * 1024;
     using Core = Scheduler<HostMeta, kSlots, kDataPool>;
@@ -104,6 +172,12 @@ private:
     OscIngress&          mIngress;
     std::mutex           mMx;
     std::vector<Command> mInbox;
+    Doorbell             mDoorbell;
+    // Deadline the tick thread sleeps towards; kAwake while it is between
+    // beginPass() and sleepingUntil(). Sequentially consistent on both sides so
+    // ingest() never reads a stale deadline after the drain that missed its push.
+    std::atomic<int64_t> mSleepingUntil{kAwake};
+    LatenessHistogram    mLateness;
 };
 
 }  // namespace ss_host
@@ -7,15 +7,18 @@
     Standalone scheduler host: a sample-accurate OSC/MIDI event scheduler with no
     synthesis engine. Receives the control vocabulary (/schedule, /sched/flush)
     over UDP, schedules each event on the generic Scheduler, and delivers due
-    events via the Rust OSC and MIDI subsystems. A timer thread drives the
-    scheduler tick off the wall clock.
+    events via the Rust OSC and MIDI subsystems. The main thread runs the tick
+    loop (tick_loop.h), sleeping until the next event is due.
 
-    Usage: supersonic-scheduler [control_port=4560] [loopback=1]
+    Usage: supersonic-scheduler [control_port=4560] [loopback=1] [spin_us=0]
+      spin_us  busy-wait this many microseconds before each deadline instead of
+               relying on the kernel timer alone (lower lateness, more CPU)
 */
 
 #include "host/clock.h"
 #include "host/host_scheduler.h"
 #include "host/host_outbound.h"
+#include "host/tick_loop.h"
 #include "OscIngress.h"
 #include "ss_osc.h"
 #ifdef SUPERSONIC_WITH_MIDI
@@ -23,12 +26,13 @@
 #endif
 
 #include <atomic>
-#include <chrono>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <thread>
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
 
 namespace {
 std::atomic<bool> g_running{true};
@@ -49,6 +53,7 @@ void midi_transport_noop(void*, const uint8_t*, uint32_t, const uint8_t*, uint32
 int main(int argc, char** argv) {
     int control_port = argc > 1 ? std::atoi(argv[1]) : 4560;
     int loopback     = argc > 2 ? std::atoi(argv[2]) : 1;
+    int spin_us      = argc > 3 ? std::atoi(argv[3]) : 0;
 
     SsOsc* osc = ss_osc_create(nullptr, osc_emit_noop);
     if (!osc) {
@@ -104,12 +109,25 @@ int main(int argc, char** argv) {
     std::fprintf(stderr, "supersonic-scheduler: %s on control port %d (%s)\n",
                  caps, control_port, loopback ? "loopback" : "all interfaces");
 
-    // Drive the scheduler at ~1 ms granularity off the wall clock; tick()
+#if defined(__linux__)
+    // The default 50 µs timer slack would be added to every deadline wake.
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+#endif
+    // Sleep until each event is due (or ingest queues an earlier one); tick()
     // dispatches whatever just came due through the OscIngress inline.
-    while (g_running.load()) {
-        sched.tick(ss_host::osc_now());
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-    }
+    ss_host::TickLoopOptions loopOpts;
+    loopOpts.spinUs = spin_us > 0 ? static_cast<uint32_t>(spin_us) : 0;
+    ss_host::run_tick_loop(sched, g_running, loopOpts);
+
+    const auto& late = sched.lateness();
+    if (late.total)
+        std::fprintf(stderr,
+                     "supersonic-scheduler: %llu events, lateness p50 <%lld us, "
+                     "p99 <%lld us, max %lld us\n",
+                     static_cast<unsigned long long>(late.total),
+                     static_cast<long long>(late.quantileUs(0.5)),
+                     static_cast<long long>(late.quantileUs(0.99)),
+                     static_cast<long long>(late.maxUs));
 
     ss_osc_ingress_stop(ingress);
 #ifdef SUPERSONIC_WITH_MIDI
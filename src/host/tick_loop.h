@@ -0,0 +1,80 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+
+    Deadline-driven tick loop for the standalone host. Instead of polling the
+    scheduler every millisecond, the tick thread sleeps on an absolute wall-clock
+    deadline taken from the scheduler head (HostScheduler::nextDue) and ticks when
+    it arrives. ingest() rings the doorbell (doorbell.h) when it queues an event
+    earlier than that deadline, so a new near event is never held behind a far
+    one. With nothing queued the thread sleeps until rung, waking only every
+    kIdleWakeMs to notice a stop request.
+
+    The kernel wakes a sleeper some tens of microseconds after its deadline.
+    spinUs > 0 sleeps until that long before the deadline and busy-waits the rest,
+    trading a little CPU per event for lower dispatch lateness.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "clock.h"
+#include "host_scheduler.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace ss_host {
+
+struct TickLoopOptions {
+    uint32_t spinUs = 0;   // busy-wait this long before each deadline; 0 = sleep only
+};
+
+// Bounds how long a stop request can go unnoticed while nothing is queued.
+constexpr int64_t kIdleWakeMs = 250;
+
+inline int64_t unix_ns_now() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// Run until `running` goes false. Single thread: the one that owns `sched`'s
+// core and calls tick().
+inline void run_tick_loop(HostScheduler& sched, const std::atomic<bool>& running,
+                          const TickLoopOptions& opt = {}) {
+    Doorbell& bell = sched.doorbell();
+    while (running.load(std::memory_order_acquire)) {
+        const uint32_t armed = sched.beginPass();
+        sched.tick(osc_now());
+        const int64_t due = sched.nextDue();
+        sched.sleepingUntil(due);
+
+        const int64_t idleNs = unix_ns_now() + kIdleWakeMs * 1'000'000;
+        if (due == INT64_MAX) {
+            bell.wait(armed, idleNs);
+            continue;
+        }
+        const int64_t dueNs   = osc_to_unix_ns(due);
+        const int64_t sleepNs = dueNs - static_cast<int64_t>(opt.spinUs) * 1000;
+        if (unix_ns_now() < sleepNs) {
+            bell.wait(armed, sleepNs < idleNs ? sleepNs : idleNs);
+            if (unix_ns_now() < sleepNs) continue;   // rung, idle wake or signal
+        }
+        while (bell.arm() == armed && osc_now() < due &&
+               running.load(std::memory_order_relaxed)) {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+            _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+            __asm__ volatile("yield");
+#endif
+        }
+    }
+}
+
+}  // namespace ss_host
@@ -23,7 +23,10 @@
 
 #include "../audio_processor.h"          // arena globals + process_audio + accessors
 #include "../audio_config.h"             // sonicpi::WorldOpts positional indices
+#include "../cmd_record.h"               // ss_cmd_encode (precoded ingress)
+#include "../latency_trace.h"            // ingress stamps
 #include "../shared_memory.h"            // layout, ControlPointers, EgressRoute
+#include "../usdt.h"                     // static tracepoints
 #include "../workers/RingBufferWriter.h" // the single ring writer
 
 // ── internal state ──────────────────────────────────────────────────────────
@@ -40,6 +43,13 @@ static std::atomic<int32_t> g_nrt_egress_lock{0};
 static constexpr uint32_t kNrtEgressMax =
     NRT_OUT_BUFFER_SIZE / 2 < 8192 ? NRT_OUT_BUFFER_SIZE / 2 : 8192;
 
+// Idle doorbell (ss_idle_*): the host's wake callback and whether it wants
+// the next ingress write rung. Written on the host's audio thread, read by
+// every ingress producer.
+static std::atomic<SsDoorbellFn> g_doorbell_fn{nullptr};
+static std::atomic<void*>        g_doorbell_ctx{nullptr};
+static std::atomic<bool>         g_doorbell_armed{false};
+
 // Per-lane consumer state (single consumer per lane, by contract). Process
 // lifetime; init_memory() resets it alongside the ring sequence counters via
 // ss_lanes_reset_drains.
@@ -94,11 +104,42 @@ void ss_lanes_reset_rings(void) {
 bool ss_ingress_write(const uint8_t* osc, uint32_t len, uint32_t source_id) {
     if (!memory_initialized || !shared_memory || !control || !osc || len == 0)
         return false;
-    return RingBufferWriter::write(
-        shared_memory + IN_BUFFER_START, IN_BUFFER_SIZE,
-        &control->in_head, &control->in_tail,
-        &control->in_sequence, &control->in_write_lock,
-        osc, len, source_id);
+    bool ok;
+    uint32_t seq = 0;   // for the ingress_write probe
+    if (g_latency_trace_on.load(std::memory_order_relaxed)) {
+        const uint32_t now = ss_latency_now_us();   // outside the lock
+        ok = RingBufferWriter::write(
+            shared_memory + IN_BUFFER_START, IN_BUFFER_SIZE,
+            &control->in_head, &control->in_tail,
+            &control->in_sequence, &control->in_write_lock,
+            osc, len, source_id, [now, &seq](uint32_t s) { seq = s; ss_latency_stamp(s, now); });
+    } else {
+        ok = RingBufferWriter::write(
+            shared_memory + IN_BUFFER_START, IN_BUFFER_SIZE,
+            &control->in_head, &control->in_tail,
+            &control->in_sequence, &control->in_write_lock,
+            osc, len, source_id, [&seq](uint32_t s) { seq = s; });
+    }
+    SS_PROBE4(ingress_write, len, source_id & ~SOURCE_ID_PRECODED, seq, ok);
+    if (ok) ss_idle_wake();
+    return ok;
+}
+
+bool ss_ingress_write_precoded(const uint8_t* osc, uint32_t len, uint32_t source_id) {
+    if (!osc || (source_id & SOURCE_ID_PRECODED)) return ss_ingress_write(osc, len, source_id);
+    uint8_t rec[SS_CMD_RECORD_MAX];
+    const uint32_t n = ss_cmd_encode(osc, len, rec, sizeof(rec));
+    if (n == 0) return ss_ingress_write(osc, len, source_id);
+    return ss_ingress_write(rec, n, source_id | SOURCE_ID_PRECODED);
+}
+
+void ss_latency_trace(bool on) {
+    if (on == g_latency_trace_on.load(std::memory_order_relaxed)) return;
+    if (on) {
+        ss_latency_clear_stamps();
+        g_latency_trace_reset.store(true, std::memory_order_relaxed);
+    }
+    g_latency_trace_on.store(on, std::memory_order_release);
 }
 
 // ── Egress ──────────────────────────────────────────────────────────────────
@@ -158,11 +199,15 @@ bool ss_egress_nrt_write(uint32_t route, uint32_t token,
     uint8_t buf[kNrtEgressMax];
     std::memcpy(buf, &route, sizeof(route));
     std::memcpy(buf + sizeof(route), osc, len);
-    return RingBufferWriter::write(
+    const bool ok = RingBufferWriter::write(
         shared_memory + NRT_OUT_BUFFER_START, NRT_OUT_BUFFER_SIZE,
         &control->nrt_out_head, &control->nrt_out_tail,
         &control->nrt_out_sequence, &g_nrt_egress_lock,
         buf, len + EGRESS_ROUTE_SIZE, token);
+    // The native NRT gateway drains on the host's block tick: an idle host
+    // sleeping through blocks would hold this frame until it woke.
+    if (ok) ss_idle_wake();
+    return ok;
 }
 
 // ── Tick ────────────────────────────────────────────────────────────────────
@@ -186,6 +231,42 @@ uint32_t ss_block_size(void) {
     return static_cast<uint32_t>(get_audio_buffer_samples());
 }
 
+// ── Idle ────────────────────────────────────────────────────────────────────
+
+uint32_t ss_idle_blocks(uint32_t max_blocks) {
+    return engine_idle_blocks(max_blocks);
+}
+
+void ss_idle_skip(uint32_t blocks) {
+    engine_idle_skip(blocks);
+}
+
+bool ss_idle_unwatched(void) {
+    return engine_idle_unwatched();
+}
+
+void ss_idle_set_doorbell(SsDoorbellFn fn, void* ctx) {
+    g_doorbell_armed.store(false, std::memory_order_relaxed);
+    g_doorbell_ctx.store(ctx, std::memory_order_relaxed);
+    g_doorbell_fn.store(fn, std::memory_order_release);
+}
+
+void ss_idle_arm(bool armed) {
+    g_doorbell_armed.store(armed, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+// The fences here and in ss_idle_arm pair up: either the host's re-check after
+// arming sees the caller's work (the IN head just published) or this load sees
+// the arm.
+void ss_idle_wake(void) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!g_doorbell_armed.load(std::memory_order_relaxed)) return;
+    if (!g_doorbell_armed.exchange(false, std::memory_order_acq_rel)) return;
+    if (SsDoorbellFn fn = g_doorbell_fn.load(std::memory_order_acquire))
+        fn(g_doorbell_ctx.load(std::memory_order_relaxed));
+}
+
 // ── Init ──────────────────────────────────────────────────────────────────────
 
 // The arena override init_memory() consults (set by the native backend when a
@@ -79,6 +79,26 @@ extern "C" {
  */
 bool ss_ingress_write(const uint8_t* osc, uint32_t len, uint32_t source_id);
 
+/* As ss_ingress_write, but a hot scsynth command (/s_new, /n_set, /n_free,
+ * /g_new, /n_map, /c_set) in a shape the engine can decode ahead of time is
+ * written as a pre-decoded command record (cmd_record.h), so the audio
+ * thread skips the address lookup and the argument walk. Bundles, other
+ * commands and anything the encoder declines go in raw, exactly as through
+ * ss_ingress_write. The decode runs on the calling thread, allocation-free.
+ * source_id must fit in 31 bits (the top bit flags a record).
+ */
+bool ss_ingress_write_precoded(const uint8_t* osc, uint32_t len, uint32_t source_id);
+
+/* Command latency tracing (latency_trace.h). While on, every frame written
+ * through the two calls above is stamped with its ingress time, and the
+ * tick histograms how long each waited until it was performed or fired,
+ * per origin and delivery class, into the arena's LATENCY_TRACE region.
+ * Turning it on clears the histograms (the region's epoch bumps on the
+ * next tick). Any thread. Off by default; off costs a relaxed load per
+ * write and per tick.
+ */
+void ss_latency_trace(bool on);
+
 /* ── Egress ────────────────────────────────────────────────────────────────
  * Two single-consumer rings out of the engine:
  *
@@ -142,6 +162,58 @@ const float* ss_audio_out(void);   /* rendered block, channel-major     */
 float*       ss_audio_in(void);    /* input bus region, fill before tick */
 uint32_t     ss_block_size(void);  /* frames per block (web: 128)        */
 
+/* ── Idle ──────────────────────────────────────────────────────────────────
+ * An engine with no synths (empty groups don't count), nothing drained or
+ * fired and no MIDI clock burst pending renders one block of silence, then
+ * skips the DSP pass inside ss_tick until something arrives. A host that
+ * owns its wakeups can go further and not tick at all:
+ *
+ *   ss_idle_blocks(max)  after a tick: how many following blocks would be
+ *                        silent and do nothing, given the IN ring and the
+ *                        next scheduled event (0 = tick as usual). Capped
+ *                        at max.
+ *   ss_idle_skip(n)      the host let n <= that many block periods pass
+ *                        without ticking; the engine's block clock and
+ *                        process count move on as if it had. Then tick the
+ *                        next block as usual, at its normal sample position.
+ *
+ * Both are audio thread only, between ticks. The block a message lands in
+ * is the one the host ticks next, exactly as when ticking every block.
+ *
+ * To sleep through the skippable blocks but wake on the first message, a
+ * host installs a doorbell and arms it before each sleep:
+ *
+ *   ss_idle_set_doorbell(fn, ctx)  fn(ctx) runs on the writing thread, at
+ *                                  most once per arm. Keep it short (signal
+ *                                  a condition variable).
+ *   ss_idle_arm(true)              then re-read ss_idle_blocks(); a write
+ *                                  racing the arm is either seen there or
+ *                                  rings the doorbell. ss_idle_arm(false)
+ *                                  after waking.
+ *   ss_idle_wake()                 ring it now if armed: engine control
+ *                                  threads with work for the next tick
+ *                                  (a loaded sample, a MIDI clock burst).
+ *                                  NRT egress writes ring it too, for
+ *                                  hosts that drain egress on the tick.
+ *
+ * Writes the engine cannot see (a peer writing the arena's IN ring directly)
+ * ring nothing, so bound each sleep.
+ *
+ *   ss_idle_unwatched()            true while such a writer is attached to
+ *                                  the engine itself (the SHM peer command
+ *                                  lane): wake every block period and
+ *                                  re-read ss_idle_blocks() rather than
+ *                                  sleeping the whole stretch.
+ */
+typedef void (*SsDoorbellFn)(void* ctx);
+
+uint32_t ss_idle_blocks(uint32_t max_blocks);
+void     ss_idle_skip(uint32_t blocks);
+void     ss_idle_set_doorbell(SsDoorbellFn fn, void* ctx);
+void     ss_idle_arm(bool armed);
+void     ss_idle_wake(void);
+bool     ss_idle_unwatched(void);
+
 /* ── Init ──────────────────────────────────────────────────────────────────
  * Bring the engine up: configure the World, lay out the arena (rings, control,
  * metrics, node-tree, scope), allocate the RT-safe heap, and create the DSP
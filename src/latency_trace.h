@@ -0,0 +1,133 @@
+/*
+ * SuperSonic
+ * Copyright (c) 2025 Sam Aaron
+ *
+ * Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+ *
+ * latency_trace.h — optional ingress-to-apply command latency tracing.
+ *
+ * A producer writing the IN ring through ss_ingress_write stamps the frame's
+ * sequence number with a monotonic microsecond time, in a process-local side
+ * table (the wire format is untouched, and writers that don't stamp — the
+ * JS ring writer, a peer writing the arena directly — simply go untraced).
+ * The audio thread looks the stamp up when it performs the frame, or carries
+ * it through the scheduler pool and looks at the clock again when the event
+ * fires, and adds the difference to a log2 histogram in the LATENCY_TRACE
+ * region of the arena (shared_memory.h), split by origin token and by how
+ * the command was delivered (kSsLatencyClass*).
+ *
+ * Off by default. Disabled, a producer pays one relaxed load per write and
+ * the audio thread one per block; nothing is stamped or recorded.
+ *
+ * Threading: stamps are written inside the ring's writer lock, before the
+ * head is published with release, so the drain (which acquires the head)
+ * always sees the stamp of the frame it reads. The table has one slot per
+ * sequence number modulo kSsLatencyStampSlots and every slot keeps its full
+ * sequence number, so a slot reused by a later frame, or never stamped,
+ * never matches. The histogram region has a single writer, the audio
+ * thread; readers see relaxed u32 counters.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "shared_memory.h"
+
+// Delivery paths, the histogram's command classes.
+constexpr uint8_t kSsLatencyClassImmediate = 0;   // drained and performed now (incl. precoded)
+constexpr uint8_t kSsLatencyClassBundle    = 1;   // timestamped bundle, fired from the scheduler
+constexpr uint8_t kSsLatencyClassSchedule  = 2;   // "/schedule" inner message, fired from the scheduler
+constexpr uint8_t kSsLatencyUntraced       = 0xFF;
+static_assert(LATENCY_TRACE_CLASSES == 3, "one histogram per kSsLatencyClass*");
+
+constexpr uint32_t kSsLatencyStampSlots = 4096;   // power of two
+
+inline std::atomic<bool>     g_latency_trace_on{false};
+inline std::atomic<bool>     g_latency_trace_reset{false};
+inline std::atomic<uint64_t> g_latency_stamps[kSsLatencyStampSlots];
+
+// Monotonic microseconds, truncated: differences stay exact up to ~71 minutes.
+inline uint32_t ss_latency_now_us() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// ── Producer side ────────────────────────────────────────────────────────────
+
+inline void ss_latency_stamp(uint32_t seq, uint32_t us) {
+    g_latency_stamps[seq & (kSsLatencyStampSlots - 1)].store(
+        (static_cast<uint64_t>(seq) << 32) | us, std::memory_order_relaxed);
+}
+
+// Invalidate every stamp: slot i gets a sequence number whose low bits are
+// not i, which no frame that maps to slot i can carry.
+inline void ss_latency_clear_stamps() {
+    for (uint32_t i = 0; i < kSsLatencyStampSlots; ++i)
+        g_latency_stamps[i].store(static_cast<uint64_t>(i ^ 1u) << 32,
+                                  std::memory_order_relaxed);
+}
+
+// ── Audio-thread side ────────────────────────────────────────────────────────
+
+inline bool ss_latency_stamp_of(uint32_t seq, uint32_t& us) {
+    const uint64_t s =
+        g_latency_stamps[seq & (kSsLatencyStampSlots - 1)].load(std::memory_order_relaxed);
+    if (static_cast<uint32_t>(s >> 32) != seq) return false;
+    us = static_cast<uint32_t>(s);
+    return true;
+}
+
+// Bucket 0 holds 0 µs; bucket b >= 1 holds [2^(b-1), 2^b) µs; the last bucket
+// also takes everything longer.
+inline uint32_t ss_latency_bucket(uint32_t us) {
+    if (us == 0) return 0;
+    const uint32_t b = 32u - static_cast<uint32_t>(__builtin_clz(us));
+    return b < LATENCY_TRACE_BUCKETS ? b : LATENCY_TRACE_BUCKETS - 1;
+}
+
+namespace ss_latency_detail {
+inline std::atomic<uint32_t>* u32(uint8_t* region, uint32_t off) {
+    return reinterpret_cast<std::atomic<uint32_t>*>(region + off);
+}
+}  // namespace ss_latency_detail
+
+// Once per block, before the drain: apply a pending reset, publish the
+// enabled flag, and say whether to trace this block.
+inline bool ss_latency_begin_block(uint8_t* region) {
+    using ss_latency_detail::u32;
+    const bool on = g_latency_trace_on.load(std::memory_order_acquire);
+    if (g_latency_trace_reset.load(std::memory_order_relaxed) &&
+        g_latency_trace_reset.exchange(false, std::memory_order_acquire)) {
+        for (uint32_t off = LATENCY_TRACE_ORIGIN_IDS; off < LATENCY_TRACE_SIZE; off += 4)
+            u32(region, off)->store(0, std::memory_order_relaxed);
+        u32(region, LATENCY_TRACE_EPOCH)->store(
+            u32(region, LATENCY_TRACE_EPOCH)->load(std::memory_order_relaxed) + 1,
+            std::memory_order_release);
+    }
+    if (u32(region, LATENCY_TRACE_ENABLED)->load(std::memory_order_relaxed) != uint32_t(on))
+        u32(region, LATENCY_TRACE_ENABLED)->store(on, std::memory_order_relaxed);
+    return on;
+}
+
+// Count one command of class `cls` from `origin` that waited `us`. The first
+// LATENCY_TRACE_ORIGINS - 1 distinct origins get their own row; the last row
+// collects the rest.
+inline void ss_latency_record(uint8_t* region, uint32_t origin, uint32_t cls, uint32_t us) {
+    using ss_latency_detail::u32;
+    const uint32_t id = origin + 1;
+    uint32_t row = LATENCY_TRACE_ORIGINS - 1;
+    for (uint32_t i = 0; i + 1 < LATENCY_TRACE_ORIGINS; ++i) {
+        auto* slot = u32(region, LATENCY_TRACE_ORIGIN_IDS + i * 4);
+        const uint32_t cur = slot->load(std::memory_order_relaxed);
+        if (cur == id) { row = i; break; }
+        if (cur == 0) { slot->store(id, std::memory_order_relaxed); row = i; break; }
+    }
+    auto* count = u32(region, LATENCY_TRACE_COUNTS +
+        ((row * LATENCY_TRACE_CLASSES + cls) * LATENCY_TRACE_BUCKETS + ss_latency_bucket(us)) * 4);
+    count->store(count->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    auto* peak = u32(region, LATENCY_TRACE_MAX_US + cls * 4);
+    if (us > peak->load(std::memory_order_relaxed))
+        peak->store(us, std::memory_order_relaxed);
+}
@@ -48,6 +48,8 @@
  *     SUPERSONIC_MAX_BLOCK_SIZE            static_audio_bus block cap (non-WASM)
  *     SUPERSONIC_DEFAULT_BLOCK_SIZE        default control block size (non-WASM)
  *     SUPERSONIC_MAX_CHANNELS              per-world max channels
+ *   World tables ......................... synth/server/SC_WorldResize.cpp
+ *     SUPERSONIC_WORLD_GROWTH_FACTOR       runtime growth ceiling (x boot size)
  *   Audio capture ring ................... synth/common/shm_audio_buffer.hpp
  *     SUPERSONIC_MAX_SHM_AUDIO_BUFFERS     capture slot count
  *     SUPERSONIC_SHM_AUDIO_SECONDS         per-slot ring duration (seconds)
@@ -147,6 +149,9 @@
   #ifndef SUPERSONIC_SHM_AUDIO_FRAMES
   #define SUPERSONIC_SHM_AUDIO_FRAMES 64
   #endif
+  #ifndef SUPERSONIC_WORLD_GROWTH_FACTOR
+  #define SUPERSONIC_WORLD_GROWTH_FACTOR 1         // no address-space reservation
+  #endif
 
 #endif // SUPERSONIC_PROFILE_ESP32S3
 
@@ -222,6 +227,9 @@
   #ifndef SUPERSONIC_SHM_AUDIO_FRAMES
   #define SUPERSONIC_SHM_AUDIO_FRAMES 128
   #endif
+  #ifndef SUPERSONIC_WORLD_GROWTH_FACTOR
+  #define SUPERSONIC_WORLD_GROWTH_FACTOR 1         // no address-space reservation
+  #endif
 
 #endif // SUPERSONIC_PROFILE_TEENSY41
 
@@ -314,6 +322,20 @@
 #define SUPERSONIC_MAX_CHANNELS 128
 #endif
 
+// World tables that units hold pointers into (buses + touched stamps, SndBufs,
+// wire buffers) are reserved in address space at this multiple of their boot
+// size, so /supersonic/world/grow can raise the limits in place; pages are only
+// backed once used. Node and RT-memory ceilings use the same multiple. 1 turns
+// the reservation off (those tables stay at boot size): the WASM heap and the
+// embedded targets have no lazily backed virtual memory to reserve.
+#ifndef SUPERSONIC_WORLD_GROWTH_FACTOR
+#if defined(__EMSCRIPTEN__)
+#define SUPERSONIC_WORLD_GROWTH_FACTOR 1
+#else
+#define SUPERSONIC_WORLD_GROWTH_FACTOR 16
+#endif
+#endif
+
 // Audio capture ring (shm_audio_buffer)
 #ifndef SUPERSONIC_MAX_SHM_AUDIO_BUFFERS
 #define SUPERSONIC_MAX_SHM_AUDIO_BUFFERS 4
@@ -120,6 +120,24 @@ inline constexpr NativeStatInfo kNativeStats[] = {
     { 5, "cbOverruns", "count", "Audio callbacks that overran their time budget" },
     { 6, "nrtMaxPassMs", "ms", "Longest the control thread has spent handling one batch of commands since boot" },
     { 7, "nrtInFlightMs", "ms", "How long the control thread has been stuck in the command it is handling right now. Anything but 0 means later commands, and every reply behind them, are waiting" },
+    { 8, "egressMaxQueueBytes", "bytes", "Deepest per-connection reply queue on the stream command transport right now. A stalled client backs up only its own queue" },
+    { 9, "egressDropped", "count", "Replies dropped because a client's reply queue was full (drop-oldest policy)" },
+    { 10, "egressOverflowCloses", "count", "Clients disconnected because their reply queue was full (disconnect policy)" },
+    { 11, "samplePrefetchHits", "count", "Synths whose registered sample was already resident when they started" },
+    { 12, "sampleLateLoads", "count", "Synths whose registered sample was not resident in time. The sample loads then, but that synth plays silence" },
+    { 13, "sampleEvictions", "count", "Idle registered samples evicted to stay under the residency budget" },
+    { 14, "sampleResidentKiB", "KiB", "Memory held right now by registered samples, in KiB" },
+    { 15, "smoothingConverged", "count", "Lag, Ramp and VarLag units whose output has settled and that are filling a constant instead of filtering" },
+    { 16, "fftTransforms", "count", "FFT and IFFT transforms run since boot" },
+    { 17, "fftBlockPeak", "count", "Most FFT and IFFT transforms run in a single block over the last ~64 blocks" },
+    { 18, "arenaAllocs", "count", "Unit constructor allocations served from a per-node arena since boot" },
+    { 19, "arenaPoolAllocs", "count", "Unit constructor allocations that went to the realtime pool since boot" },
+    { 20, "arenaSynths", "count", "Synths whose unit constructors have run since boot" },
+    { 21, "idleBlocks", "count", "Blocks not rendered because the engine was idle, since boot" },
+    { 22, "precodedCommands", "count", "Commands that arrived pre-decoded and skipped the OSC parse, since boot" },
+    { 23, "worldResizes", "count", "Times the World's limits (nodes, buffers, buses, wire buffers, RT memory) were raised while running" },
+    { 24, "worldResizeApplyUs", "us", "How long the last World resize held the audio thread" },
+    { 25, "worldResizeBytes", "bytes", "Memory added by World resizes since boot" },
 };
 
 // Rows combining several metrics in one reading ("current | peak", ...).
@@ -0,0 +1,161 @@
+/*
+ * SuperSonic
+ * Copyright (c) 2026 Sam Aaron
+ *
+ * Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+ *
+ * metrics_shards.h — contention-free counters for the hot metrics fields.
+ *
+ * Every transport thread that calls SupersonicEngine::ingest counts the
+ * message into PerformanceMetrics, and the audio thread writes its own
+ * counters into the same cache lines every block. With shared fetch_adds
+ * the line bounces between the audio core and each transport core on every
+ * message. Here each thread instead counts into a private, cache-line-sized
+ * shard with plain relaxed load/store (it is the shard's only writer), and
+ * an aggregator adds whatever the shards gained since its last pass into
+ * the PerformanceMetrics fields (ss_counter_publish).
+ *
+ * The published layout (metrics_schema.h) is untouched: the aggregator
+ * adds deltas, so the fields keep their meaning for every reader — the shm
+ * observer, JS metrics_reader, the NIF — and writers that still fetch_add
+ * the field directly (the audio thread's messages_dropped) coexist with
+ * the sharded ones. The native engine publishes from the NRT gateway once
+ * per audio block and on every getMetrics(), so in-process readers see
+ * exact counts and cross-process readers lag by at most a block.
+ *
+ * Threads claim a shard on first use and release it when they exit; the
+ * counts stay in the shard for the next owner, so nothing is lost. Past
+ * kSsCounterShards concurrent writers the rest share an overflow shard,
+ * counted with fetch_add. With sharding off (the default, and the only
+ * mode outside the native engine) ss_count is the old fetch_add on the
+ * field.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "shared_memory.h"
+
+enum SsCounter : uint32_t {
+    kSsCountOscOutMessages = 0,
+    kSsCountOscOutBytes,
+    kSsCountMessagesDropped,
+    kSsCounters
+};
+
+// The field each counter publishes into.
+inline constexpr std::atomic<uint32_t> PerformanceMetrics::* kSsCounterFields[kSsCounters] = {
+    &PerformanceMetrics::osc_out_messages_sent,
+    &PerformanceMetrics::osc_out_bytes_sent,
+    &PerformanceMetrics::messages_dropped,
+};
+
+constexpr uint32_t kSsCounterShards = 32;
+
+struct alignas(64) SsCounterShard {
+    std::atomic<uint32_t> owned{0};
+    std::atomic<uint32_t> count[kSsCounters]{};
+};
+static_assert(sizeof(SsCounterShard) == 64, "one shard per cache line");
+
+// The last shard is the shared overflow shard.
+inline SsCounterShard        g_counter_shards[kSsCounterShards + 1];
+inline std::atomic<uint32_t> g_counter_shards_used{0};   // high-water mark of claimed slots
+inline std::atomic<bool>     g_counter_shards_on{false};
+
+struct SsCounterPublisher {
+    std::mutex mutex;
+    uint32_t   last[kSsCounters] = {};
+};
+inline SsCounterPublisher g_counter_publisher;
+
+namespace ss_counter_detail {
+
+struct Claim {
+    SsCounterShard* shard = nullptr;
+    bool exclusive = false;
+    ~Claim() {
+        if (exclusive) shard->owned.store(0, std::memory_order_release);
+    }
+};
+
+inline Claim& claim() {
+    thread_local Claim c;
+    if (c.shard) return c;
+    for (uint32_t i = 0; i < kSsCounterShards; ++i) {
+        uint32_t free = 0;
+        if (g_counter_shards[i].owned.compare_exchange_strong(
+                free, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            c.shard = &g_counter_shards[i];
+            c.exclusive = true;
+            uint32_t used = g_counter_shards_used.load(std::memory_order_relaxed);
+            while (used < i + 1 &&
+                   !g_counter_shards_used.compare_exchange_weak(used, i + 1, std::memory_order_relaxed)) {}
+            return c;
+        }
+    }
+    c.shard = &g_counter_shards[kSsCounterShards];
+    return c;
+}
+
+// Sum of every shard that has ever been claimed, plus the overflow shard.
+inline uint32_t sum(uint32_t counter) {
+    const uint32_t used = g_counter_shards_used.load(std::memory_order_relaxed);
+    uint32_t total = g_counter_shards[kSsCounterShards].count[counter].load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < used; ++i)
+        total += g_counter_shards[i].count[counter].load(std::memory_order_relaxed);
+    return total;
+}
+
+}  // namespace ss_counter_detail
+
+// Count n events on `counter`. Safe from any thread, including real-time
+// ones once they hold a shard (the first call on a thread claims one).
+inline void ss_count(PerformanceMetrics* m, SsCounter counter, uint32_t n = 1) {
+    if (!g_counter_shards_on.load(std::memory_order_relaxed)) {
+        (m->*kSsCounterFields[counter]).fetch_add(n, std::memory_order_relaxed);
+        return;
+    }
+    ss_counter_detail::Claim& c = ss_counter_detail::claim();
+    std::atomic<uint32_t>& slot = c.shard->count[counter];
+    if (c.exclusive)
+        slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    else
+        slot.fetch_add(n, std::memory_order_relaxed);
+}
+
+// Turn sharding on or off. On takes the current shard sums as the baseline,
+// so counts left over from an earlier engine are never published into a
+// fresh metrics region. Off publishes what is outstanding first.
+inline void ss_counter_shards(PerformanceMetrics* m, bool on) {
+    std::lock_guard<std::mutex> lk(g_counter_publisher.mutex);
+    if (on) {
+        for (uint32_t i = 0; i < kSsCounters; ++i)
+            g_counter_publisher.last[i] = ss_counter_detail::sum(i);
+        g_counter_shards_on.store(true, std::memory_order_relaxed);
+        return;
+    }
+    g_counter_shards_on.store(false, std::memory_order_relaxed);
+    if (!m) return;
+    for (uint32_t i = 0; i < kSsCounters; ++i) {
+        const uint32_t now = ss_counter_detail::sum(i);
+        (m->*kSsCounterFields[i]).fetch_add(now - g_counter_publisher.last[i], std::memory_order_relaxed);
+        g_counter_publisher.last[i] = now;
+    }
+}
+
+// Add what the shards gained since the last pass into the metrics fields.
+// Not for the audio thread (takes a lock). u32 wraparound is harmless: the
+// delta is taken modulo 2^32, like the fields themselves.
+inline void ss_counter_publish(PerformanceMetrics* m) {
+    if (!m || !g_counter_shards_on.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lk(g_counter_publisher.mutex);
+    for (uint32_t i = 0; i < kSsCounters; ++i) {
+        const uint32_t now = ss_counter_detail::sum(i);
+        const uint32_t delta = now - g_counter_publisher.last[i];
+        if (delta) (m->*kSsCounterFields[i]).fetch_add(delta, std::memory_order_relaxed);
+        g_counter_publisher.last[i] = now;
+    }
+}
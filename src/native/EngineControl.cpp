@@ -13,6 +13,7 @@
 #include "osc/OscReceivedElements.h"
 #include "DevicePolicy.h"
 #include "supersonic_config.h"  // SUPERSONIC_VERSION_MAJOR / _MINOR
+#include "supersonic_heap.h"
 #ifdef __APPLE__
 #include "AggregateDeviceHelper.h"
 #include "JuceAudioCallback.h"  // get_audio_first_private_bus_idx()
@@ -772,6 +773,149 @@ bool EngineControl::handleSupersonicCommand(const DrainCallCtx& meta, const uint
                       static_cast<uint32_t>(s.Size()));
             return true;
 
+        } else if (std::strcmp(addr, "/supersonic/buffers/compact") == 0) {
+            // Blocks this thread for the pass (bounded by SampleLoader's
+            // own timeout), like devices/switch does for a swap.
+            auto r = mEngine->compactBufferMemory();
+            char buf[256];
+            osc::OutboundPacketStream s(buf, sizeof(buf));
+            s << osc::BeginMessage("/supersonic/buffers/compact.reply")
+              << static_cast<osc::int32>(r.ran ? 1 : 0)
+              << static_cast<osc::int32>(r.buffersMoved)
+              << static_cast<osc::int64>(r.bytesMoved)
+              << static_cast<osc::int32>(r.areasReleased)
+              << static_cast<osc::int64>(r.bytesReleased)
+              << static_cast<osc::int64>(r.bytesReclaimed)
+              << osc::EndMessage;
+            mEgress->reply(token, reinterpret_cast<const uint8_t*>(s.Data()),
+                      static_cast<uint32_t>(s.Size()));
+            return true;
+
+        } else if (std::strcmp(addr, "/supersonic/buffers/stats") == 0) {
+            auto r = mEngine->bufferMemoryReport();
+            char buf[256];
+            osc::OutboundPacketStream s(buf, sizeof(buf));
+            s << osc::BeginMessage("/supersonic/buffers/stats.reply")
+              << static_cast<osc::int32>(r.areas)
+              << static_cast<osc::int32>(r.growthAreas)
+              << static_cast<osc::int64>(r.reservedBytes)
+              << static_cast<osc::int64>(r.inUseBytes)
+              << static_cast<osc::int64>(r.freeBytes)
+              << static_cast<osc::int64>(r.largestFreeBytes)
+              << static_cast<osc::int32>(r.fragmentationPermille)
+              << static_cast<osc::int32>(r.passes)
+              << static_cast<osc::int64>(r.buffersMoved)
+              << static_cast<osc::int64>(r.bytesReleased)
+              << static_cast<osc::int64>(supersonic_heap_headroom())
+              << static_cast<osc::int32>(supersonic_heap_rt_growth_refused())
+              << static_cast<osc::int32>(supersonic_heap_deferred_areas())
+              << osc::EndMessage;
+            mEgress->reply(token, reinterpret_cast<const uint8_t*>(s.Data()),
+                      static_cast<uint32_t>(s.Size()));
+            return true;
+
+        } else if (std::strcmp(addr, "/supersonic/buffers/register") == 0
+                   || std::strcmp(addr, "/supersonic/buffers/unregister") == 0) {
+            const bool reg = std::strcmp(addr, "/supersonic/buffers/register") == 0;
+            auto it = msg.ArgumentsBegin();
+            int32_t bufnum = -1, startFrame = 0, numFrames = 0;
+            const char* path = "";
+            if (it != msg.ArgumentsEnd() && it->IsInt32()) { bufnum = it->AsInt32Unchecked(); ++it; }
+            if (reg && it != msg.ArgumentsEnd() && it->IsString()) { path = it->AsStringUnchecked(); ++it; }
+            if (reg && it != msg.ArgumentsEnd() && it->IsInt32()) { startFrame = it->AsInt32Unchecked(); ++it; }
+            if (reg && it != msg.ArgumentsEnd() && it->IsInt32()) { numFrames = it->AsInt32Unchecked(); ++it; }
+            auto& residency = mEngine->sampleResidency();
+            const bool ok = reg ? residency.registerBuffer(bufnum, path, startFrame, numFrames)
+                                : residency.unregisterBuffer(bufnum);
+            char buf[128];
+            osc::OutboundPacketStream s(buf, sizeof(buf));
+            s << osc::BeginMessage(reg ? "/supersonic/buffers/register.reply"
+                                       : "/supersonic/buffers/unregister.reply")
+              << static_cast<osc::int32>(bufnum)
+              << static_cast<osc::int32>(ok ? 1 : 0)
+              << osc::EndMessage;
+            mEgress->reply(token, reinterpret_cast<const uint8_t*>(s.Data()),
+                      static_cast<uint32_t>(s.Size()));
+            return true;
+
+        } else if (std::strcmp(addr, "/supersonic/buffers/residency") == 0) {
+            const auto r = mEngine->sampleResidency().stats();
+            char buf[256];
+            osc::OutboundPacketStream s(buf, sizeof(buf));
+            s << osc::BeginMessage("/supersonic/buffers/residency.reply")
+              << static_cast<osc::int32>(r.registered)
+              << static_cast<osc::int32>(r.resident)
+              << static_cast<osc::int64>(r.residentBytes)
+              << static_cast<osc::int64>(r.budgetBytes)
+              << static_cast<osc::int32>(r.prefetches)
+              << static_cast<osc::int32>(r.prefetchHits)
+              << static_cast<osc::int32>(r.lateLoads)
+              << static_cast<osc::int32>(r.evictions)
+              << osc::EndMessage;
+            mEgress->reply(token, reinterpret_cast<const uint8_t*>(s.Data()),
+                      static_cast<uint32_t>(s.Size()));
+            return true;
+
+        } else if (std::strcmp(addr, "/supersonic/world/grow") == 0) {
+            // Args (all optional; 0 or missing keeps the limit): nodes,
+            // buffers, audioBuses, controlBuses, wireBufs, rtMemoryKB.
+            // Blocks this thread until the audio thread applies it, like
+            // buffers/compact.
+            uint32_t v[6] = {};
+            int n = 0;
+            for (auto it = msg.ArgumentsBegin(); it != msg.ArgumentsEnd() && n < 6; ++it, ++n)
+                if (it->IsInt32() && it->AsInt32Unchecked() > 0)
+                    v[n] = static_cast<uint32_t>(it->AsInt32Unchecked());
+            WorldLimits want;
+            want.mMaxNodes = v[0];
+            want.mNumBuffers = v[1];
+            want.mNumAudioBusChannels = v[2];
+            want.mNumControlBusChannels = v[3];
+            want.mMaxWireBufs = v[4];
+            want.mRealTimeMemoryKB = v[5];
+            auto r = mEngine->growWorld(want);
+            char buf[256];
+            osc::OutboundPacketStream s(buf, sizeof(buf));
+            s << osc::BeginMessage("/supersonic/world/grow.reply");
+            if (r.success) {
+                const WorldLimits& l = r.report.mLimits;
+                s << static_cast<osc::int32>(1)
+                  << static_cast<osc::int32>(l.mMaxNodes)
+                  << static_cast<osc::int32>(l.mNumBuffers)
+                  << static_cast<osc::int32>(l.mNumAudioBusChannels)
+                  << static_cast<osc::int32>(l.mNumControlBusChannels)
+                  << static_cast<osc::int32>(l.mMaxWireBufs)
+                  << static_cast<osc::int32>(l.mRealTimeMemoryKB)
+                  << static_cast<osc::int64>(r.report.mBytesAdded)
+                  << static_cast<osc::int32>(r.report.mPrepareUs)
+                  << static_cast<osc::int32>(r.report.mApplyUs);
+            } else {
+                s << static_cast<osc::int32>(0) << r.error.c_str();
+            }
+            s << osc::EndMessage;
+            mEgress->reply(token, reinterpret_cast<const uint8_t*>(s.Data()),
+                      static_cast<uint32_t>(s.Size()));
+            return true;
+
+        } else if (std::strcmp(addr, "/supersonic/world/limits") == 0) {
+            WorldLimits cur, ceil;
+            mEngine->worldLimits(cur, ceil);   // zeros with no World
+            char buf[256];
+            osc::OutboundPacketStream s(buf, sizeof(buf));
+            s << osc::BeginMessage("/supersonic/world/limits.reply");
+            for (const WorldLimits* l : {&cur, &ceil}) {
+                s << static_cast<osc::int32>(l->mMaxNodes)
+                  << static_cast<osc::int32>(l->mNumBuffers)
+                  << static_cast<osc::int32>(l->mNumAudioBusChannels)
+                  << static_cast<osc::int32>(l->mNumControlBusChannels)
+                  << static_cast<osc::int32>(l->mMaxWireBufs)
+                  << static_cast<osc::int32>(l->mRealTimeMemoryKB);
+            }
+            s << osc::EndMessage;
+            mEgress->reply(token, reinterpret_cast<const uint8_t*>(s.Data()),
+                      static_cast<uint32_t>(s.Size()));
+            return true;
+
         } else if (std::strcmp(addr, "/supersonic/clock/offset") == 0) {
             auto it = msg.ArgumentsBegin();
             if (it != msg.ArgumentsEnd() && it->IsFloat()) {
@@ -8,6 +8,8 @@
 #include "lanes/lanes.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 
 #if defined(__linux__)
@@ -21,20 +23,41 @@
 // wallClockNTP() comes from WallClock.h (included via JuceAudioCallback.h)
 
 HeadlessDriver::HeadlessDriver()
-    : juce::Thread("SuperSonic-Headless") {}
+    : juce::Thread("SuperSonic-Headless") {
+    addListener(this);
+}
+
+HeadlessDriver::~HeadlessDriver() {
+    removeListener(this);
+}
 
 void HeadlessDriver::configure(JuceAudioCallback* callback,
                                 SampleLoader* sampleLoader,
                                 int sampleRate,
                                 int blockSize,
                                 int numOutputChannels,
-                                int numInputChannels) {
+                                int numInputChannels,
+                                int worldSampleRate) {
     mCallback          = callback;
     mSampleLoader      = sampleLoader;
     mSampleRate        = (sampleRate > 0) ? sampleRate : 48000;
     mBlockSize         = (blockSize  > 0) ? blockSize  : 128;
     mNumOutputChannels = numOutputChannels;
     mNumInputChannels  = numInputChannels;
+    mWorldRate         = (worldSampleRate > 0) ? worldSampleRate : mSampleRate;
+
+    // Resample when the simulated device runs at another rate. configure()
+    // is a no-op (inactive) for equal rates; it runs here, on the control
+    // thread, before the driver thread starts.
+    mConverter = {};
+    if (mWorldRate != mSampleRate) {
+        const int nOut = std::max(1, mNumOutputChannels);
+        if (mConverter.configure(mWorldRate, mSampleRate, nOut,
+                                 get_audio_buffer_samples(), mBlockSize))
+            mConvScratch.assign(static_cast<size_t>(nOut) * mBlockSize, 0.0f);
+        else
+            mWorldRate = mSampleRate;
+    }
 }
 
 // Shared per-block loop body — installs pending buffers, derives NTP via
@@ -44,6 +67,11 @@ void HeadlessDriver::processBlock(double& samplePos) {
     if (mSampleLoader)
         mSampleLoader->installPendingBuffers();
 
+    if (mConverter.active()) {
+        processConvertedBlock(samplePos);
+        return;
+    }
+
     const double ntp = mSuperClock->updateAudioThreadNTP(samplePos, mSampleRate);
 
     // Sample clock: headless has no DAC, so "audible" == render time
@@ -65,11 +93,117 @@ void HeadlessDriver::processBlock(double& samplePos) {
                      static_cast<uint32_t>(mSampleRate),
                      ntp, hostMicros);
     samplePos += mBlockSize;
+    mDeviceFrames.fetch_add(static_cast<uint64_t>(mBlockSize), std::memory_order_relaxed);
+
+    mCallback->processCount.fetch_add(1, std::memory_order_release);
+    mCallback->processCount.notify_all();
+}
+
+// One simulated device block at mSampleRate: render World blocks (at
+// mWorldRate, the unit of samplePos) until the converter can produce
+// mBlockSize device frames, then pull them. The output has nowhere to go
+// headless, but running the converter keeps timing and cost identical to a
+// real device. The sample clock reports the converter's latency in World
+// frames, as the JUCE callback does.
+void HeadlessDriver::processConvertedBlock(double& samplePos) {
+    const uint32_t worldBlock = static_cast<uint32_t>(get_audio_buffer_samples());
+    double ntp = mSuperClock->updateAudioThreadNTP(samplePos, mWorldRate);
+    mSuperClock->publishSampleClock(
+        samplePos, static_cast<double>(mWorldRate), ntp,
+        static_cast<uint32_t>(std::lround(mConverter.latencyInputFrames())));
+    const uint64_t hostMicros =
+        static_cast<uint64_t>(std::max<int64_t>(0, mSuperClock->linkClockMicros()));
+
+    while (mConverter.available() < mBlockSize) {
+        renderAudioBlock(*mSuperClock, worldBlock,
+                         static_cast<uint32_t>(mNumOutputChannels),
+                         static_cast<uint32_t>(mNumInputChannels),
+                         static_cast<uint32_t>(mWorldRate),
+                         ntp, hostMicros);
+        samplePos += worldBlock;
+        ntp += static_cast<double>(worldBlock) / mWorldRate;
+        mSuperClock->advanceEngineFrames(samplePos);
+        mConverter.push(ss_audio_out(), static_cast<int>(worldBlock),
+                        mNumOutputChannels, static_cast<int>(worldBlock));
+    }
+    mConverter.pull(mConvScratch.data(), mBlockSize, mNumOutputChannels, mBlockSize);
+    mDeviceFrames.fetch_add(static_cast<uint64_t>(mBlockSize), std::memory_order_relaxed);
 
     mCallback->processCount.fetch_add(1, std::memory_order_release);
     mCallback->processCount.notify_all();
 }
 
+// Runs on whichever thread wrote to the IN ring (or finished a load), once per
+// arm.
+void HeadlessDriver::idleDoorbell(void* ctx) {
+    auto* self = static_cast<HeadlessDriver*>(ctx);
+    {
+        std::lock_guard<std::mutex> lock(self->mIdleLock);
+        self->mIdleRung = true;
+    }
+    self->mIdleCv.notify_one();
+}
+
+// signalThreadShouldExit() from stopThread: don't make it wait out a sleep.
+void HeadlessDriver::exitSignalSent() {
+    idleDoorbell(this);
+}
+
+uint32_t HeadlessDriver::idleSleep(double& samplePos) {
+    // Resampling pulls World blocks at the converter's pace, and Link Audio
+    // peers expect a continuous stream: both keep ticking.
+    if (mIdleSleepMs <= 0 || mConverter.active() || mSuperClock->isLinkAudioPublishEnabled())
+        return 0;
+
+    using Clock = std::chrono::steady_clock;
+    const std::chrono::nanoseconds blockPeriod(1'000'000'000LL * mBlockSize / mSampleRate);
+    const uint32_t maxBlocks = static_cast<uint32_t>(std::max<int64_t>(
+        1, std::chrono::nanoseconds(std::chrono::milliseconds(mIdleSleepMs)) / blockPeriod));
+    if (ss_idle_blocks(maxBlocks) < 2) return 0;   // not worth a sleep
+
+    // The block just rendered ended before the next deadline and after the one
+    // before it, so every whole block period counted from here has come due by
+    // the time it has elapsed: skipping that many never runs ahead of the wall
+    // clock.
+    const auto start = Clock::now();
+    uint32_t idle = 0;
+    {
+        std::unique_lock<std::mutex> lock(mIdleLock);
+        mIdleRung = false;
+        ss_idle_arm(true);
+        idle = ss_idle_blocks(maxBlocks);
+        if (idle >= 2 && !threadShouldExit()
+            && !(mSampleLoader && mSampleLoader->hasCompletedLoads())) {
+            const auto until = start + blockPeriod * idle;
+            if (!ss_idle_unwatched()) {
+                mIdleCv.wait_until(lock, until, [this] { return mIdleRung; });
+            } else {
+                // The SHM peer's ring writes ring no doorbell: look at it once
+                // a block, so its commands wait no longer than they would with
+                // the driver ticking.
+                while (!mIdleCv.wait_until(lock, std::min(until, Clock::now() + blockPeriod),
+                                           [this] { return mIdleRung; })
+                       && Clock::now() < until && ss_idle_blocks(1) != 0) {}
+            }
+        } else {
+            idle = 0;
+        }
+    }
+    ss_idle_arm(false);
+
+    const uint32_t skip = static_cast<uint32_t>(std::min<int64_t>(
+        idle, (Clock::now() - start) / blockPeriod));
+    if (skip == 0) return 0;
+
+    ss_idle_skip(skip);
+    samplePos += static_cast<double>(skip) * mBlockSize;
+    mSuperClock->advanceEngineFrames(samplePos);
+    mDeviceFrames.fetch_add(static_cast<uint64_t>(skip) * mBlockSize, std::memory_order_relaxed);
+    mCallback->processCount.fetch_add(skip, std::memory_order_release);
+    mCallback->processCount.notify_all();
+    return skip;
+}
+
 // Re-anchor the wake deadline when the loop has fallen more than
 // kMaxCatchupBlocks behind, so a scheduling gap can't turn into a back-to-back
 // catch-up burst. Unit-agnostic (see header); the caller passes now, deadline,
@@ -83,8 +217,9 @@ int64_t HeadlessDriver::cappedNextWake(int64_t nextWake, int64_t now,
 }
 
 // Each platform implements run() using its highest-resolution timer.
-// Only the sleep mechanism differs; the loop body is shared via processBlock(),
-// and each loop caps catch-up via cappedNextWake() after advancing the deadline.
+// Only the sleep mechanism differs; the loop body is shared via processBlock()
+// and idleSleep(), and each loop caps catch-up via cappedNextWake() after
+// advancing the deadline past the block rendered and any skipped.
 
 #if defined(__linux__)
 
@@ -103,16 +238,21 @@ void HeadlessDriver::run() {
     struct timespec next;
     clock_gettime(CLOCK_MONOTONIC, &next);
     double samplePos = 0.0;
-    mSuperClock->resetAudioThreadTime(samplePos, mSampleRate);
+    mDeviceFrames.store(0, std::memory_order_relaxed);
+    if (mConverter.active()) mConverter.reset();
+    mSuperClock->resetAudioThreadTime(samplePos, mWorldRate);
+    ss_idle_set_doorbell(&HeadlessDriver::idleDoorbell, this);
 
     while (!threadShouldExit()) {
         processBlock(samplePos);
+        const int64_t blocks = 1 + idleSleep(samplePos);
         struct timespec nowTs;
         clock_gettime(CLOCK_MONOTONIC, &nowTs);
-        next = nsToTimespec(cappedNextWake(timespecToNs(next) + blockNs,
+        next = nsToTimespec(cappedNextWake(timespecToNs(next) + blockNs * blocks,
                                            timespecToNs(nowTs), blockNs));
         clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
     }
+    ss_idle_set_doorbell(nullptr, nullptr);
 }
 
 #elif defined(__APPLE__)
@@ -124,16 +264,21 @@ void HeadlessDriver::run() {
     const uint64_t blockTicks = blockNs * tbi.denom / tbi.numer;
     uint64_t nextWake = mach_absolute_time();
     double samplePos = 0.0;
-    mSuperClock->resetAudioThreadTime(samplePos, mSampleRate);
+    mDeviceFrames.store(0, std::memory_order_relaxed);
+    if (mConverter.active()) mConverter.reset();
+    mSuperClock->resetAudioThreadTime(samplePos, mWorldRate);
+    ss_idle_set_doorbell(&HeadlessDriver::idleDoorbell, this);
 
     while (!threadShouldExit()) {
         processBlock(samplePos);
+        const uint64_t blocks = 1 + idleSleep(samplePos);
         nextWake = static_cast<uint64_t>(cappedNextWake(
-            static_cast<int64_t>(nextWake + blockTicks),
+            static_cast<int64_t>(nextWake + blockTicks * blocks),
             static_cast<int64_t>(mach_absolute_time()),
             static_cast<int64_t>(blockTicks)));
         mach_wait_until(nextWake);
     }
+    ss_idle_set_doorbell(nullptr, nullptr);
 }
 
 #elif defined(_WIN32)
@@ -152,12 +297,16 @@ void HeadlessDriver::run() {
     QueryPerformanceCounter(&now);
     LONGLONG nextWake = now.QuadPart;
     double samplePos = 0.0;
-    mSuperClock->resetAudioThreadTime(samplePos, mSampleRate);
+    mDeviceFrames.store(0, std::memory_order_relaxed);
+    if (mConverter.active()) mConverter.reset();
+    mSuperClock->resetAudioThreadTime(samplePos, mWorldRate);
+    ss_idle_set_doorbell(&HeadlessDriver::idleDoorbell, this);
 
     while (!threadShouldExit()) {
         processBlock(samplePos);
+        const LONGLONG blocks = 1 + idleSleep(samplePos);
         QueryPerformanceCounter(&now);
-        nextWake = cappedNextWake(nextWake + blockTicks, now.QuadPart, blockTicks);
+        nextWake = cappedNextWake(nextWake + blockTicks * blocks, now.QuadPart, blockTicks);
         LONGLONG remaining = nextWake - now.QuadPart;
         if (remaining > 0) {
             LARGE_INTEGER due;
@@ -167,6 +316,7 @@ void HeadlessDriver::run() {
         }
     }
 
+    ss_idle_set_doorbell(nullptr, nullptr);
     if (timer)
         CloseHandle(timer);
 }
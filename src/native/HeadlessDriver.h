@@ -12,32 +12,64 @@
  *
  * Worker threads (ReplyReader, DebugReader) are woken after each block,
  * so OSC replies flow exactly as they would with a real audio device.
+ *
+ * With a pinned internal rate (Config::internalSampleRate) the driver
+ * simulates a device at `sampleRate` in front of a World at
+ * `worldSampleRate`: it ticks at the device's block period and pulls each
+ * device block through a RateConverter, rendering World blocks as needed —
+ * the same path JuceAudioCallback takes for a real device.
+ *
+ * Idle: when the engine reports blocks that would render silence and do
+ * nothing (ss_idle_blocks — no synths, empty IN ring, nothing scheduled that
+ * soon), the thread sleeps through them on a condition variable instead of
+ * waking every block, bounded by setIdleSleepMs. An ingress write, a
+ * finished sample load or a thread-exit request rings the lanes doorbell and
+ * wakes it early. The SHM peer lane rings nothing (its writer is another
+ * process), so while one is attached the sleep wakes once a block period to
+ * look at its ring. The blocks that passed are handed to ss_idle_skip and the
+ * sample position moves on by the same amount, so the next block renders at
+ * the sample position and wall-clock deadline it would have had anyway.
  */
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include "RateConverter.h"
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
+#include <vector>
 
 class JuceAudioCallback;
 class SampleLoader;
 class SuperClock;
 
-class HeadlessDriver : public juce::Thread {
+class HeadlessDriver : public juce::Thread, private juce::Thread::Listener {
 public:
     HeadlessDriver();
+    ~HeadlessDriver() override;
 
     void configure(JuceAudioCallback* callback,
                    SampleLoader* sampleLoader,
                    int sampleRate,
                    int blockSize,
                    int numOutputChannels,
-                   int numInputChannels);
+                   int numInputChannels,
+                   int worldSampleRate = 0);   // 0 = the World runs at sampleRate
 
     // Must be set before run() is called.
     void setSuperClock(SuperClock* sc) { mSuperClock = sc; }
 
+    // Longest idle sleep, in ms; 0 ticks every block. Set before run().
+    void setIdleSleepMs(int ms) { mIdleSleepMs = ms; }
+
     void run() override;
 
+    // Simulated-device frames delivered since the thread started (device
+    // rate). Tests compare it against SuperClock::engineFrames().
+    uint64_t deviceFrames() const { return mDeviceFrames.load(std::memory_order_relaxed); }
+    bool isResampling() const { return mConverter.active(); }
+
     // Bound on how far the timer loop replays missed blocks after a scheduling
     // gap (thread starvation, sleep/wake). Beyond this the loop re-anchors to
     // the current time and drops the backlog rather than firing a back-to-back
@@ -60,6 +92,15 @@ private:
     // Shared loop body: install buffers, derive NTP via SuperClock,
     // process audio, wake workers. Called once per block.
     void processBlock(double& samplePos);
+    // processBlock's resampling branch (simulated device rate != World rate).
+    void processConvertedBlock(double& samplePos);
+
+    // Sleep through the blocks ss_idle_blocks reports free, or until the
+    // doorbell rings, and account for the block periods that passed. Returns
+    // how many blocks were skipped (0: tick the next one as usual).
+    uint32_t idleSleep(double& samplePos);
+    static void idleDoorbell(void* ctx);
+    void exitSignalSent() override;
 
     // Ticks the engine at this block size. Set explicitly from
     // SupersonicEngine::Config so the tick rate is deterministic and
@@ -73,4 +114,16 @@ private:
     int                mSampleRate        = 48000;
     int                mNumOutputChannels = 2;
     int                mNumInputChannels  = 0;
+
+    // World rate (== mSampleRate unless resampling) and the World → device
+    // converter, with one device block of planar scratch for its output.
+    int                       mWorldRate = 48000;
+    supersonic::RateConverter mConverter;
+    std::vector<float>        mConvScratch;
+    std::atomic<uint64_t>     mDeviceFrames{0};
+
+    int                     mIdleSleepMs = 50;
+    std::mutex              mIdleLock;
+    std::condition_variable mIdleCv;
+    bool                    mIdleRung = false;   // guarded by mIdleLock
 };
@@ -66,4 +66,20 @@ public:
     virtual void broadcastOsc(const uint8_t*, uint32_t) {}
     virtual bool subscribeOsc(uint32_t) { return false; }
     virtual void unsubscribeOsc(uint32_t) {}
+
+    // End of a gateway pass: everything the engine had to say this wake has been
+    // handed over. A transport that gathers sends into batches (UdpOscTransport)
+    // pushes them out here; one that sends inline has nothing to do.
+    virtual void flush() {}
+
+    // Per-peer egress queueing, for transports that queue replies instead of
+    // sending inline (StreamOscTransport). The default — a synchronous sender —
+    // has no queue and reports zeros. Unlike the methods above this is polled
+    // from the engine's watchdog thread, so implementations must be thread-safe.
+    struct EgressStats {
+        uint32_t maxQueueBytes  = 0;  // deepest per-peer queue right now
+        uint32_t droppedFrames  = 0;  // frames discarded by a full queue (cumulative)
+        uint32_t overflowCloses = 0;  // peers disconnected by a full queue (cumulative)
+    };
+    virtual EgressStats egressStats() const { return {}; }
 };
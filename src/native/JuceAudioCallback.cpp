@@ -125,8 +125,14 @@ void JuceAudioCallback::initialiseWorld(uint8_t* ringBufferStorage,
 }
 
 void JuceAudioCallback::audioDeviceAboutToStart(juce::AudioIODevice* device) {
-    mSampleRate     = static_cast<int>(device->getCurrentSampleRate());
-    mNominalRate.store(mSampleRate, std::memory_order_relaxed);
+    mDeviceRate     = static_cast<int>(device->getCurrentSampleRate());
+    mNominalRate.store(mDeviceRate, std::memory_order_relaxed);
+    // With a pinned internal rate the World keeps its own rate across device
+    // changes (hot swaps); read it from the live World, which a cold swap may
+    // have just rebuilt. Otherwise the World follows the device, as before.
+    const int worldRate = get_audio_sample_rate();
+    mSampleRate     = (mInternalRate > 0 && worldRate > 0) ? worldRate : mDeviceRate;
+    mEngineRate.store(mSampleRate, std::memory_order_relaxed);
     mSamplePosition = 0.0;
     mPrefetchCount  = 0;
     mInputAccumCount = 0;
@@ -225,6 +231,29 @@ void JuceAudioCallback::audioDeviceAboutToStart(juce::AudioIODevice* device) {
 
     mOutputLatencySamples = device->getOutputLatencyInSamples();
 
+    // Rate conversion between the World and this device. configure() leaves
+    // a converter inactive when the rates match; it also refuses ratios it
+    // can't reduce to kMaxPhases, which the engine avoids by cold-swapping
+    // the World to the device rate instead (see SupersonicEngine::worldRateFor).
+    mOutConverter = {};
+    mInConverter  = {};
+    if (mSampleRate != mDeviceRate) {
+        mConvMaxPull = std::max(hwBufSize, mBufLen);
+        const int outCh = std::max(1, std::max(mNumOutputChannels, mWorldOutputBusChannels));
+        const int inCh  = std::max(1, mNumInputChannels);
+        if (mOutConverter.configure(mSampleRate, mDeviceRate, outCh, mBufLen, mConvMaxPull)) {
+            mInConverter.configure(mDeviceRate, mSampleRate, inCh, mConvMaxPull, mBufLen);
+            mConvScratch.assign(static_cast<size_t>(outCh) * mConvMaxPull, 0.0f);
+            fprintf(stderr, "[juce] resampling World %d Hz <-> device %d Hz "
+                    "(group delay %.1f frames)\n", mSampleRate, mDeviceRate,
+                    mOutConverter.groupDelayInputFrames());
+        } else {
+            fprintf(stderr, "[juce] WARNING: cannot resample World %d Hz to device %d Hz\n",
+                    mSampleRate, mDeviceRate);
+        }
+        fflush(stderr);
+    }
+
     // Native timing: set ntp_start and drift to 0. NTP is derived from sample
     // position with slow drift correction (see run loop), so these offsets are unused.
     if (mRingBufferStorage) {
@@ -256,6 +285,8 @@ void JuceAudioCallback::resume() {
     mSamplePosition = 0.0;
     mPrefetchCount  = 0;
     mInputAccumCount = 0;      // discard stale mic samples from before pause
+    if (mOutConverter.active()) mOutConverter.reset();
+    if (mInConverter.active())  mInConverter.reset();
     mSuperClock->resetAudioThreadTime(mSamplePosition, mSampleRate);
     mCallbackCount  = 0;       // re-arm warmup for new device
     mLastCbTime     = {};      // clear gap detector baseline
@@ -283,6 +314,121 @@ bool JuceAudioCallback::isPaused() const {
     return mPaused.load(std::memory_order_acquire);
 }
 
+// One World block — see the header. Advances wallNTP, mSamplePosition and the
+// Link Audio host timestamp by one block.
+const float* JuceAudioCallback::renderWorldBlock(double& wallNTP,
+                                                 uint64_t& linkAudioBlockHostMicros,
+                                                 uint64_t scsynthBlockMicros,
+                                                 int nOut) {
+    // Pre-tick hook (for tau integration)
+    if (preTick)
+        preTick(mSamplePosition, wallNTP * 1000.0 - supersonic::kNtpEpochOffset * 1000.0);
+
+    // Drain pending Link Audio input into the listen bus before
+    // scsynth's In.ar reads it. No-op without an active subscription.
+    if (auto* busPool = reinterpret_cast<float*>(get_audio_bus_pool())) {
+        mSuperClock->drainLinkAudioInputsToBuses(
+            busPool,
+            static_cast<uint32_t>(mBufLen),
+            static_cast<uint32_t>(get_audio_bus_count()),
+            static_cast<uint32_t>(mSampleRate),
+            linkAudioBlockHostMicros);
+    }
+
+    // Native timing: pass wall-clock NTP directly; the tick uses it as-is
+    // (only the WASM build converts its argument, from AudioContext time).
+    // Advance NTP by one block duration for each sub-block.
+    ss_tick(wallNTP,
+            static_cast<uint32_t>(mNumOutputChannels),
+            static_cast<uint32_t>(mNumInputChannels));
+    wallNTP += static_cast<double>(mBufLen) / mSampleRate;
+    mSamplePosition += mBufLen;
+    // Keep scope-stream writes anchored to the block being rendered.
+    mSuperClock->advanceEngineFrames(mSamplePosition);
+
+    const float* outputBus = ss_audio_out();
+    if (outputBus) {
+        // Publish this scsynth block to Link Audio. Main sink:
+        // stereo when nOut >= 2, mono fallback for nOut == 1.
+        // hostMicros is the audio-framework's playback timestamp
+        // for THIS sub-block; advanced after each publish so
+        // consecutive sub-blocks within one JUCE callback get
+        // correctly-spaced timestamps. No-op when LinkAudio off /
+        // no subscriber.
+        if (nOut >= 2) {
+            mSuperClock->publishAudioBlock(
+                outputBus, outputBus + mBufLen,
+                static_cast<size_t>(mBufLen),
+                static_cast<uint32_t>(mSampleRate),
+                linkAudioBlockHostMicros);
+        } else if (nOut == 1) {
+            mSuperClock->publishAudioBlock(
+                outputBus, nullptr,
+                static_cast<size_t>(mBufLen),
+                static_cast<uint32_t>(mSampleRate),
+                linkAudioBlockHostMicros);
+        }
+        // Any user-added aux sinks tapping arbitrary bus ranges.
+        // No-op when none registered (lock-free fast path).
+        if (auto* busPool = reinterpret_cast<float*>(get_audio_bus_pool())) {
+            mSuperClock->publishAuxSinks(
+                busPool,
+                static_cast<uint32_t>(mBufLen),
+                static_cast<uint32_t>(get_audio_bus_count()),
+                static_cast<uint32_t>(mSampleRate),
+                linkAudioBlockHostMicros);
+        }
+        linkAudioBlockHostMicros += scsynthBlockMicros;
+    }
+    return outputBus;
+}
+
+// Converting IO path: device input goes through mInConverter into each World
+// block's input bus, and World blocks are rendered into mOutConverter until
+// it can produce the callback's device-rate frames. Pulls are chunked at
+// mConvMaxPull, the size the converters and scratch were allocated for.
+void JuceAudioCallback::renderConverted(const float* const* inputChannelData, int nIn,
+                                        float* const* outputChannelData, int nOut,
+                                        int numSamples, double wallNTP,
+                                        uint64_t linkAudioBlockHostMicros,
+                                        uint64_t scsynthBlockMicros) {
+    const int inCh = std::min(nIn, mWorldInputBusChannels);
+    if (nIn > 0)
+        mInConverter.push(inputChannelData, nIn, numSamples);
+
+    int filled = 0;
+    while (filled < numSamples) {
+        const int want = std::min(numSamples - filled, mConvMaxPull);
+        while (mOutConverter.available() < want) {
+            if (float* inputBus = ss_audio_in(); inputBus && inCh > 0) {
+                const int got = mInConverter.pull(inputBus, mBufLen, inCh, mBufLen);
+                for (int ch = 0; ch < inCh; ++ch)
+                    if (got < mBufLen)
+                        std::memset(inputBus + ch * mBufLen + got, 0,
+                                    static_cast<size_t>(mBufLen - got) * sizeof(float));
+            }
+            const float* outputBus = renderWorldBlock(wallNTP, linkAudioBlockHostMicros,
+                                                      scsynthBlockMicros, nOut);
+            if (!outputBus) {
+                // Engine not up yet: silence for the rest of the callback.
+                for (int ch = 0; ch < nOut; ++ch)
+                    if (outputChannelData[ch])
+                        std::memset(outputChannelData[ch] + filled, 0,
+                                    static_cast<size_t>(numSamples - filled) * sizeof(float));
+                return;
+            }
+            mOutConverter.push(outputBus, mBufLen, nOut, mBufLen);
+        }
+        mOutConverter.pull(mConvScratch.data(), mConvMaxPull, nOut, want);
+        for (int ch = 0; ch < nOut; ++ch)
+            if (outputChannelData[ch])
+                std::memcpy(outputChannelData[ch] + filled,
+                            mConvScratch.data() + static_cast<size_t>(ch) * mConvMaxPull,
+                            static_cast<size_t>(want) * sizeof(float));
+        filled += want;
+    }
+}
+
 void JuceAudioCallback::audioDeviceIOCallbackWithContext(
     const float* const* inputChannelData,
     int numInputChannels,
@@ -408,11 +554,14 @@ void JuceAudioCallback::audioDeviceIOCallbackWithContext(
     float* prefBase   = mPrefetchBuf.data();
     float* accumBase  = mInputAccum.data();
     const int accumPerChanCap = mAccumPerChanCap;
+    // Device at a different rate from the pinned World: the converters take
+    // over input accumulation and output prefetch (see renderConverted).
+    const bool converting = mOutConverter.active();
 
     // Accumulate available hardware input samples. Decouples HW buffer size
     // from scsynth's 128-sample block: we feed scsynth a full mBufLen only
     // when we have one, so no zero-padding inside a block.
-    if (nIn > 0) {
+    if (nIn > 0 && !converting) {
         // Clamp incoming samples to our capacity. If the HW buffer is larger
         // than the accumulator (shouldn't happen — aboutToStart sized us to
         // fit), keep the newest samples only.
@@ -471,9 +620,18 @@ void JuceAudioCallback::audioDeviceIOCallbackWithContext(
     // across its sub-blocks); per-block cursor advances happen in the loop.
     // Negative latency reports from flaky drivers clamp to 0 — a raw cast
     // would push the anchor ~a day ahead.
+    // While converting, the latency is in World frames: the device's, scaled
+    // to the World rate, plus what the output converter holds (its group
+    // delay and any frames rendered ahead last callback).
+    uint32_t outputLatencyFrames = static_cast<uint32_t>(std::max(0, mOutputLatencySamples));
+    if (converting) {
+        outputLatencyFrames = static_cast<uint32_t>(std::lround(
+            outputLatencyFrames * static_cast<double>(mSampleRate) / mDeviceRate
+            + mOutConverter.latencyInputFrames()));
+    }
     mSuperClock->publishSampleClock(
         mSamplePosition, static_cast<double>(mSampleRate), wallNTP,
-        static_cast<uint32_t>(std::max(0, mOutputLatencySamples)));
+        outputLatencyFrames);
 
     // Mirror Link clock + stream-health into the dashboard metrics from one
     // lock-free session capture. `metrics` is the engine's segment-resident
@@ -485,6 +643,11 @@ void JuceAudioCallback::audioDeviceIOCallbackWithContext(
     // mirror — RT-safe and live even on no-Link builds.
     mSuperClock->publishClockMetrics(metrics, wallNTP, 4.0);
 
+    if (converting) {
+        renderConverted(inputChannelData, nIn, outputChannelData, nOut, numSamples,
+                        wallNTP, linkAudioBlockHostMicros, scsynthBlockMicros);
+        outputFilled = numSamples;
+    }
 
     while (outputFilled < numSamples) {
         // Feed scsynth one full mBufLen block of input from the accumulator.
@@ -520,65 +683,9 @@ void JuceAudioCallback::audioDeviceIOCallbackWithContext(
             }
         }
 
-        // Pre-tick hook (for tau integration)
-        if (preTick)
-            preTick(mSamplePosition, wallNTP * 1000.0 - supersonic::kNtpEpochOffset * 1000.0);
-
-        // Drain pending Link Audio input into the listen bus before
-        // scsynth's In.ar reads it. No-op without an active subscription.
-        if (auto* busPool = reinterpret_cast<float*>(get_audio_bus_pool())) {
-            mSuperClock->drainLinkAudioInputsToBuses(
-                busPool,
-                static_cast<uint32_t>(mBufLen),
-                static_cast<uint32_t>(get_audio_bus_count()),
-                static_cast<uint32_t>(mSampleRate),
-                linkAudioBlockHostMicros);
-        }
-
-        // Native timing: pass wall-clock NTP directly; the tick uses it as-is
-        // (only the WASM build converts its argument, from AudioContext time).
-        // Advance NTP by one block duration for each sub-block.
-        ss_tick(wallNTP,
-                static_cast<uint32_t>(mNumOutputChannels),
-                static_cast<uint32_t>(mNumInputChannels));
-        wallNTP += static_cast<double>(mBufLen) / mSampleRate;
-        mSamplePosition += mBufLen;
-        // Keep scope-stream writes anchored to the block being rendered.
-        mSuperClock->advanceEngineFrames(mSamplePosition);
-
-        const float* outputBus = ss_audio_out();
+        const float* outputBus = renderWorldBlock(wallNTP, linkAudioBlockHostMicros,
+                                                  scsynthBlockMicros, nOut);
         if (outputBus) {
-            // Publish this scsynth block to Link Audio. Main sink:
-            // stereo when nOut >= 2, mono fallback for nOut == 1.
-            // hostMicros is the audio-framework's playback timestamp
-            // for THIS sub-block; advanced after each publish so
-            // consecutive sub-blocks within one JUCE callback get
-            // correctly-spaced timestamps. No-op when LinkAudio off /
-            // no subscriber.
-            if (nOut >= 2) {
-                mSuperClock->publishAudioBlock(
-                    outputBus, outputBus + mBufLen,
-                    static_cast<size_t>(mBufLen),
-                    static_cast<uint32_t>(mSampleRate),
-                    linkAudioBlockHostMicros);
-            } else if (nOut == 1) {
-                mSuperClock->publishAudioBlock(
-                    outputBus, nullptr,
-                    static_cast<size_t>(mBufLen),
-                    static_cast<uint32_t>(mSampleRate),
-                    linkAudioBlockHostMicros);
-            }
-            // Any user-added aux sinks tapping arbitrary bus ranges.
-            // No-op when none registered (lock-free fast path).
-            if (auto* busPool = reinterpret_cast<float*>(get_audio_bus_pool())) {
-                mSuperClock->publishAuxSinks(
-                    busPool,
-                    static_cast<uint32_t>(mBufLen),
-                    static_cast<uint32_t>(get_audio_bus_count()),
-                    static_cast<uint32_t>(mSampleRate),
-                    linkAudioBlockHostMicros);
-            }
-            linkAudioBlockHostMicros += scsynthBlockMicros;
 
             int needed  = numSamples - outputFilled;
             int toCopy  = std::min(needed, mBufLen);
@@ -621,7 +728,7 @@ void JuceAudioCallback::audioDeviceIOCallbackWithContext(
     // ── 4. Timing stats (no I/O on audio thread — store atomically for external query) ──
     auto cbEnd = std::chrono::high_resolution_clock::now();
     double cbUs = std::chrono::duration<double, std::micro>(cbEnd - cbStart).count();
-    double budgetUs = (static_cast<double>(numSamples) / mSampleRate) * 1e6;
+    double budgetUs = (static_cast<double>(numSamples) / mDeviceRate) * 1e6;
 
     mCallbackCount++;
     mTotalUs += cbUs;
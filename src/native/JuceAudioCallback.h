@@ -4,6 +4,7 @@
 #pragma once
 
 #include <juce_audio_devices/juce_audio_devices.h>
+#include "RateConverter.h"
 #include "WallClock.h"
 #include <atomic>
 #include <chrono>
@@ -26,6 +27,7 @@ extern "C" {
     int get_audio_first_private_bus_idx();
     int get_audio_num_output_buses();
     int get_audio_num_input_buses();
+    int get_audio_sample_rate();
     void touch_audio_bus(uint32_t busIdx);
     void touch_audio_bus_for_next_block(uint32_t busIdx);
 }
@@ -85,6 +87,23 @@ public:
         return mNominalRate.load(std::memory_order_relaxed);
     }
 
+    // Pin the World to a fixed internal rate (Config::internalSampleRate; 0 =
+    // follow the device). When the device opens at another rate, the callback
+    // renders at the World's rate and runs both directions through a
+    // RateConverter. Control thread, before the device starts.
+    void setInternalSampleRate(int rate) { mInternalRate = rate > 0 ? rate : 0; }
+    int  internalSampleRate() const { return mInternalRate; }
+
+    // Rate the engine frames advance at: the World's rate while converting,
+    // else the device's nominal rate. The watchdog's rate-skew check measures
+    // engineFrames() against this.
+    int engineSampleRate() const {
+        return mEngineRate.load(std::memory_order_relaxed);
+    }
+
+    // True while the current device runs at a different rate from the World.
+    bool isResampling() const { return mOutConverter.active(); }
+
     void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
     void audioDeviceStopped() override;
     void audioDeviceIOCallbackWithContext(
@@ -134,6 +153,18 @@ public:
     std::atomic<void*> mRecordWriter{nullptr};
 
 private:
+    // One World block: pre-tick hook, Link Audio input drain, ss_tick, clock
+    // advance and Link Audio publish. Returns the output bus, or nullptr
+    // before the engine is up. Shared by the same-rate and converting paths.
+    const float* renderWorldBlock(double& wallNTP, uint64_t& linkAudioBlockHostMicros,
+                                  uint64_t scsynthBlockMicros, int nOut);
+
+    // Converting path of the IO callback (device rate != World rate).
+    void renderConverted(const float* const* inputChannelData, int nIn,
+                         float* const* outputChannelData, int nOut, int numSamples,
+                         double wallNTP, uint64_t linkAudioBlockHostMicros,
+                         uint64_t scsynthBlockMicros);
+
     // scsynth's audio block size — the number of samples the graph
     // processes per tick. Matches the hardware callback size when set at
     // init so the process loop is 1:1 (no accumulator / prefetch dance).
@@ -166,6 +197,22 @@ private:
     double     mSamplePosition     = 0.0;   // cumulative samples (increments by mBufLen)
     int        mOutputLatencySamples = 0;   // device DSP→DAC latency, captured at start
 
+    // Fixed internal rate (see setInternalSampleRate). mSampleRate is the
+    // World's rate — the unit of mSamplePosition and every clock call — and
+    // mDeviceRate the hardware's; they differ only while converting.
+    int        mInternalRate       = 0;
+    int        mDeviceRate         = 48000;
+    std::atomic<int> mEngineRate{0};        // see engineSampleRate()
+
+    // World → device (output) and device → World (input) converters, sized
+    // in audioDeviceAboutToStart and inactive unless the rates differ.
+    // mConvScratch holds one pull of planar output before it is copied into
+    // JUCE's channel pointers.
+    supersonic::RateConverter mOutConverter;
+    supersonic::RateConverter mInConverter;
+    std::vector<float>        mConvScratch;
+    int                       mConvMaxPull = 0;
+
     // Prefetch buffer: channel-major, mBufLen samples per channel. Only
     // populated when the HW callback wants fewer samples than a scsynth
     // block (rare — happens if HW buffer shrinks after World init).
@@ -273,6 +273,8 @@ int main(int argc, char* argv[]) {
                 "Usage: supersonic [options]\n\n"
                 "  -u <port>    UDP port (default: 57110)\n"
                 "  -S <rate>    Sample rate (default: 48000)\n"
+                "  --internal-rate <rate>  Pin the synth engine to this rate and\n"
+                "                          resample to/from the device (default: off)\n"
                 "  -Z <size>    Hardware buffer size (default: auto)\n"
                 "  -z <size>    scsynth control block size, 32-1024 (default: 128)\n"
                 "  -i <num>     Input channels (default: device max; 0 = disable)\n"
@@ -300,6 +302,10 @@ int main(int argc, char* argv[]) {
                 "  --shm-commands      SHM segment's peer command plane (one trusted\n"
                 "                      co-located peer; requires -u > 0)\n"
                 "  --max-connections <n>  Stream/pipe connection cap (default 4)\n"
+                "  --egress-queue <KB>    Per-connection reply queue, TCP/UDS stream\n"
+                "                         (default 1024; min 512)\n"
+                "  --egress-overflow <p>  Full reply queue: disconnect (default) or\n"
+                "                         drop-oldest\n"
                 "\n"
                 "  --headless   No audio device; timer-driven render (CI/tests)\n\n"
             );
@@ -366,6 +372,8 @@ int main(int argc, char* argv[]) {
     std::string udsStreamPath, udsDgramPath, pipeName;
     bool        shmCommands = false;
     uint32_t    maxConns = 4;
+    uint32_t    egressQueueKB = 0;  // 0 = the stream leaf's default
+    auto        egressOverflow = StreamOscTransport::EgressOverflow::Disconnect;
     bool        headless = false;
 
     for (int i = 1; i < argc; ++i) {
@@ -387,6 +395,13 @@ int main(int argc, char* argv[]) {
             continue;
         }
 
+        // Pin the World's rate (Config::internalSampleRate) next to -S: a
+        // device at another rate goes through the resampler instead.
+        if (std::strcmp(arg, "--internal-rate") == 0) {
+            if (val) { cfg.internalSampleRate = std::atoi(val); ++i; }
+            continue;
+        }
+
         if (std::strcmp(arg, "--tcp") == 0) {
             if (val) { tcpPort = std::atoi(val); ++i; }
             continue;
@@ -418,6 +433,29 @@ int main(int argc, char* argv[]) {
             }
             continue;
         }
+        // Per-connection reply queue for the stream transports: a stalled
+        // client backs up only its own queue; the policy decides what a full
+        // one does. Clamped by the Rust leaf ([512 KB, 64 MB]).
+        if (std::strcmp(arg, "--egress-queue") == 0) {
+            if (val) {
+                const long kb = std::atol(val);
+                egressQueueKB = static_cast<uint32_t>(kb < 0 ? 0 : (kb > 65536 ? 65536 : kb));
+                ++i;
+            }
+            continue;
+        }
+        if (std::strcmp(arg, "--egress-overflow") == 0) {
+            if (val) {
+                if (std::strcmp(val, "drop-oldest") == 0)
+                    egressOverflow = StreamOscTransport::EgressOverflow::DropOldest;
+                else if (std::strcmp(val, "disconnect") == 0)
+                    egressOverflow = StreamOscTransport::EgressOverflow::Disconnect;
+                else
+                    fprintf(stderr, "[supersonic] unknown --egress-overflow policy: %s\n", val);
+                ++i;
+            }
+            continue;
+        }
         // No audio device: the HeadlessDriver renders on a timer thread, so
         // OSC still drains and replies flow — for CI and the transport harness.
         if (std::strcmp(arg, "--headless") == 0) {
@@ -556,6 +594,7 @@ int main(int argc, char* argv[]) {
         } else {
             streamServer.setIngest(ingest);
             streamServer.setMaxConnections(maxConns);
+            streamServer.setEgressQueue(egressQueueKB * 1024, egressOverflow);
             if (tcpPort > 0) {
                 streamServer.initialiseTcp(tcpPort, cfg.bindAddress);
                 snprintf(descBuf, sizeof(descBuf), "TCP port %d (max %u connections)",
@@ -4,6 +4,7 @@
  * (the egress ring, SuperClock setters) is already thread-safe.
  */
 #include "MidiControl.h"
+#include "MidiMap.h"
 
 #include "src/IngressCallCtx.h"
 #include "OscEgress.h"
@@ -18,9 +19,10 @@
 #include <cstring>
 #include <string>
 
-void MidiControl::init(OscEgress* egress, SuperClock* clock) {
+void MidiControl::init(OscEgress* egress, SuperClock* clock, MidiMap* map) {
     mEgress = egress;
     mClock  = clock;
+    mMap    = map;
     // Push /clock/timelines whenever the timeline set changes (add/remove/
     // stale/primary). Fires off the RT thread (MIDI feed / staleness worker).
     if (mClock)
@@ -61,6 +63,13 @@ bool MidiControl::handleMidiCommand(const DrainCallCtx& meta, const uint8_t* dat
 
     if (handleClockOutVerb(data, size)) return true;
 
+    if (mMap && std::strncmp(addr, "/midi/map/", 10) == 0) {
+        mMap->handleCommand(data, size, [this, token](const uint8_t* r, uint32_t n) {
+            if (mEgress) mEgress->reply(token, r, n);
+        });
+        return true;
+    }
+
     if (mMidi) ss_midi_handle_osc(mMidi, data, size);
     return true;
 }
@@ -133,6 +142,9 @@ void MidiControl::emitCb(void* ctx, int32_t kind, const uint8_t* osc, uint32_t l
     if (kind == SS_MIDI_EMIT_REPLY) {
         self->mEgress->reply(self->mReplyToken, osc, len);
     } else {
+        // Mapped events go straight into the IN ring, ahead of the broadcast
+        // (which still reaches subscribers).
+        if (self->mMap) self->mMap->midiIn(osc, len);
         logMidiPortsChange(osc, len);
         self->mEgress->broadcastMidiNotify(osc, len);
     }
@@ -5,7 +5,8 @@
  * bridges it to the engine: forwards "/midi/" control OSC into it, and routes
  * its callbacks back out — "/midi/in/" events + "/midi/ports" to the egress hub,
  * clock-in BPM and transport to SuperClock. Subscription manages the egress
- * audience.
+ * audience. "/midi/in/" events also pass through the engine's MidiMap, which
+ * plays mapped notes and controls without a client round trip.
  */
 #pragma once
 
@@ -14,11 +15,14 @@
 struct SsMidi;       // rust/supersonic-midi/cpp/ss_midi.h
 class OscEgress;
 class SuperClock;
+class MidiMap;
 struct DrainCallCtx;
 
 class MidiControl {
 public:
-    void init(OscEgress* egress, SuperClock* clock);
+    // `map` (optional) evaluates each /midi/in event before it is broadcast
+    // and owns the "/midi/map/" verbs.
+    void init(OscEgress* egress, SuperClock* clock, MidiMap* map = nullptr);
     void shutdown();
 
     // Handle one "/midi/" command off the audio thread (NRT gateway). Returns
@@ -49,6 +53,7 @@ private:
     SsMidi*     mMidi   = nullptr;
     OscEgress*  mEgress = nullptr;
     SuperClock* mClock  = nullptr;
+    MidiMap*    mMap    = nullptr;
     // The current command's origin token, held for the duration of a synchronous
     // ss_midi_handle_osc call so emitCb (a Rust callback with no call ctx) can
     // route its REPLY back to the caller. NRT-thread-only; REPLY emits are
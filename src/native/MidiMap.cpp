@@ -0,0 +1,463 @@
+/*
+ * MidiMap.cpp — see MidiMap.h.
+ */
+#include "MidiMap.h"
+
+#include "osc/OscReceivedElements.h"
+#include "osc/OscOutboundPacketStream.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// ── Template encoding ───────────────────────────────────────────────────────
+// A minimal OSC writer that remembers where each argument landed, so the
+// per-event fields can be patched in place.
+struct Arg {
+    char        tag;
+    int32_t     i = 0;
+    float       f = 0.0f;
+    std::string s;
+};
+Arg intArg(int32_t v)              { Arg a{'i'}; a.i = v; return a; }
+Arg floatArg(float v)              { Arg a{'f'}; a.f = v; return a; }
+Arg strArg(const std::string& v)   { Arg a{'s'}; a.s = v; return a; }
+
+void putString(std::vector<uint8_t>& out, const std::string& s) {
+    out.insert(out.end(), s.begin(), s.end());
+    out.push_back(0);
+    while (out.size() % 4) out.push_back(0);
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void patchU32(std::vector<uint8_t>& out, uint32_t at, uint32_t v) {
+    out[at]     = static_cast<uint8_t>(v >> 24);
+    out[at + 1] = static_cast<uint8_t>(v >> 16);
+    out[at + 2] = static_cast<uint8_t>(v >> 8);
+    out[at + 3] = static_cast<uint8_t>(v);
+}
+
+uint32_t floatBits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof u);
+    return u;
+}
+
+// Append one message; offsets[k] is the byte offset of argument k in `out`.
+void encodeMessage(std::vector<uint8_t>& out, const char* address,
+                   const std::vector<Arg>& args, std::vector<uint32_t>& offsets) {
+    putString(out, address);
+    std::string tags = ",";
+    for (const auto& a : args) tags += a.tag;
+    putString(out, tags);
+    offsets.clear();
+    for (const auto& a : args) {
+        offsets.push_back(static_cast<uint32_t>(out.size()));
+        switch (a.tag) {
+            case 'i': putU32(out, static_cast<uint32_t>(a.i)); break;
+            case 'f': putU32(out, floatBits(a.f));             break;
+            default:  putString(out, a.s);                     break;
+        }
+    }
+}
+
+// ── Command parsing ─────────────────────────────────────────────────────────
+bool readNumber(osc::ReceivedMessageArgumentIterator& it,
+                const osc::ReceivedMessageArgumentIterator& end, float& out) {
+    if (it == end) return false;
+    if (it->IsInt32())       out = static_cast<float>(it->AsInt32Unchecked());
+    else if (it->IsFloat())  out = it->AsFloatUnchecked();
+    else if (it->IsDouble()) out = static_cast<float>(it->AsDoubleUnchecked());
+    else return false;
+    ++it;
+    return true;
+}
+
+bool readInt(osc::ReceivedMessageArgumentIterator& it,
+             const osc::ReceivedMessageArgumentIterator& end, int32_t& out) {
+    float f;
+    if (!readNumber(it, end, f)) return false;
+    out = static_cast<int32_t>(f);
+    return true;
+}
+
+bool readString(osc::ReceivedMessageArgumentIterator& it,
+                const osc::ReceivedMessageArgumentIterator& end, std::string& out) {
+    if (it == end || !it->IsString()) return false;
+    out = it->AsStringUnchecked();
+    ++it;
+    return true;
+}
+
+void sendReply(const MidiMap::Sink& reply, const char* address, int32_t id, bool ok) {
+    char buf[128];
+    osc::OutboundPacketStream s(buf, sizeof(buf));
+    s << osc::BeginMessage(address) << id << (ok ? 1 : 0) << osc::EndMessage;
+    reply(reinterpret_cast<const uint8_t*>(s.Data()), static_cast<uint32_t>(s.Size()));
+}
+
+const char* kindName(int kind) {
+    switch (kind) {
+        case 0:  return "notes";
+        case 1:  return "cc";
+        default: return "bend";
+    }
+}
+
+} // namespace
+
+// ── Configuration (NRT gateway) ─────────────────────────────────────────────
+
+// /midi/map/notes i:id s:port i:channel s:def i:group [s:key value]...
+// Keys: pitch (control, default "note"), hz (1 = send frequency), velocity
+// (control, default "amp"), vel_min / vel_max (default 0..1), gate (release
+// control, default "gate"), low / high (note range), add_action (default 0).
+// Any other key is a fixed control passed to every /s_new.
+bool MidiMap::configureNotes(const uint8_t* data, uint32_t size, Rule& rule) {
+    std::string def, pitchCtl = "note", velCtl = "amp", gateCtl = "gate";
+    int32_t group = 1, addAction = 0;
+    std::vector<std::pair<std::string, float>> fixed;
+    try {
+        osc::ReceivedMessage msg(osc::ReceivedPacket(reinterpret_cast<const char*>(data),
+                                 static_cast<osc::osc_bundle_element_size_t>(size)));
+        auto it = msg.ArgumentsBegin();
+        const auto end = msg.ArgumentsEnd();
+        int32_t channel = 0;
+        if (!readInt(it, end, rule.id) || !readString(it, end, rule.port)
+            || !readInt(it, end, channel) || !readString(it, end, def)
+            || !readInt(it, end, group))
+            return false;
+        rule.channel = channel;
+        while (it != end) {
+            std::string key;
+            if (!readString(it, end, key)) return false;
+            if (key == "pitch" || key == "velocity" || key == "gate") {
+                std::string name;
+                if (!readString(it, end, name)) return false;
+                (key == "pitch" ? pitchCtl : key == "velocity" ? velCtl : gateCtl) = name;
+                continue;
+            }
+            float v;
+            if (!readNumber(it, end, v)) return false;
+            if      (key == "hz")         rule.hz = v != 0.0f;
+            else if (key == "vel_min")    rule.velMin = v;
+            else if (key == "vel_max")    rule.velMax = v;
+            else if (key == "low")        rule.low = static_cast<int>(v);
+            else if (key == "high")       rule.high = static_cast<int>(v);
+            else if (key == "add_action") addAction = static_cast<int32_t>(v);
+            else fixed.emplace_back(key, v);
+        }
+    } catch (...) {
+        return false;
+    }
+    if (def.empty() || rule.channel < 0 || rule.channel > 16
+        || rule.low < 0 || rule.high > 127 || rule.low > rule.high)
+        return false;
+
+    std::vector<Arg> args = { strArg(def), intArg(0), intArg(addAction), intArg(group) };
+    int pitchArg = -1, velArg = -1;
+    if (!pitchCtl.empty()) { args.push_back(strArg(pitchCtl)); pitchArg = int(args.size()); args.push_back(floatArg(0)); }
+    if (!velCtl.empty())   { args.push_back(strArg(velCtl));   velArg   = int(args.size()); args.push_back(floatArg(0)); }
+    for (const auto& kv : fixed) { args.push_back(strArg(kv.first)); args.push_back(floatArg(kv.second)); }
+
+    std::vector<uint32_t> at;
+    encodeMessage(rule.on.bytes, "/s_new", args, at);
+    rule.on.nodeAt  = at[1];
+    rule.on.valueAt = pitchArg >= 0 ? at[pitchArg] : 0;
+    rule.on.extraAt = velArg   >= 0 ? at[velArg]   : 0;
+
+    // Release: a bundle carrying /error -1 first, so releasing a voice whose
+    // synth already freed itself stays quiet.
+    if (!gateCtl.empty()) {
+        std::vector<uint8_t> quiet, set;
+        encodeMessage(quiet, "/error", { intArg(-1) }, at);
+        encodeMessage(set, "/n_set", { intArg(0), strArg(gateCtl), floatArg(0) }, at);
+        auto& b = rule.off.bytes;
+        putString(b, "#bundle");
+        putU32(b, 0);
+        putU32(b, 1);                        // timetag 1 = immediately
+        putU32(b, static_cast<uint32_t>(quiet.size()));
+        b.insert(b.end(), quiet.begin(), quiet.end());
+        putU32(b, static_cast<uint32_t>(set.size()));
+        rule.off.nodeAt = static_cast<uint32_t>(b.size()) + at[0];
+        b.insert(b.end(), set.begin(), set.end());
+    }
+    rule.voices.assign(16 * 128, 0);
+    return true;
+}
+
+// /midi/map/cc   i:id s:port i:channel i:controller s:target i:index [s:control] f:min f:max [s:curve]
+// /midi/map/bend i:id s:port i:channel              s:target i:index [s:control] f:min f:max
+// target "bus" sets control bus `index`; "node" sets `control` on node (or
+// group) `index`. curve is "lin" (default) or "exp" (min and max > 0).
+bool MidiMap::configureControl(const uint8_t* data, uint32_t size, Rule& rule, bool bend) {
+    std::string target, control, curve = "lin";
+    int32_t index = 0;
+    try {
+        osc::ReceivedMessage msg(osc::ReceivedPacket(reinterpret_cast<const char*>(data),
+                                 static_cast<osc::osc_bundle_element_size_t>(size)));
+        auto it = msg.ArgumentsBegin();
+        const auto end = msg.ArgumentsEnd();
+        int32_t channel = 0, controller = 0;
+        if (!readInt(it, end, rule.id) || !readString(it, end, rule.port)
+            || !readInt(it, end, channel))
+            return false;
+        if (!bend && !readInt(it, end, controller)) return false;
+        if (!readString(it, end, target) || !readInt(it, end, index)) return false;
+        if (target == "node" && !readString(it, end, control)) return false;
+        if (!readNumber(it, end, rule.min) || !readNumber(it, end, rule.max)) return false;
+        if (!bend && it != end && !readString(it, end, curve)) return false;
+        rule.channel = channel;
+        rule.controller = controller;
+    } catch (...) {
+        return false;
+    }
+    if (rule.channel < 0 || rule.channel > 16 || rule.controller < 0 || rule.controller > 127)
+        return false;
+    if (curve != "lin" && curve != "exp") return false;
+    rule.exponential = curve == "exp";
+    if (rule.exponential && (rule.min <= 0.0f || rule.max <= 0.0f)) return false;
+
+    std::vector<uint32_t> at;
+    if (target == "bus") {
+        if (index < 0) return false;
+        encodeMessage(rule.set.bytes, "/c_set", { intArg(index), floatArg(0) }, at);
+        rule.set.valueAt = at[1];
+    } else if (target == "node") {
+        encodeMessage(rule.set.bytes, "/n_set", { intArg(index), strArg(control), floatArg(0) }, at);
+        rule.set.valueAt = at[2];
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void MidiMap::install(std::unique_ptr<Rule> rule) {
+    for (auto& existing : mRules) {
+        if (existing->id == rule->id) {
+            releaseVoices(*existing);
+            existing = std::move(rule);
+            return;
+        }
+    }
+    mRules.push_back(std::move(rule));
+}
+
+bool MidiMap::handleCommand(const uint8_t* data, uint32_t size, const Sink& reply) {
+    const char* addr = reinterpret_cast<const char*>(data);
+    if (size < 12 || std::strncmp(addr, "/midi/map/", 10) != 0) return false;
+
+    if (std::strcmp(addr, "/midi/map/notes") == 0
+        || std::strcmp(addr, "/midi/map/cc") == 0
+        || std::strcmp(addr, "/midi/map/bend") == 0) {
+        auto rule = std::make_unique<Rule>();
+        bool ok;
+        if (addr[10] == 'n') {
+            rule->kind = Kind::Notes;
+            ok = configureNotes(data, size, *rule);
+        } else {
+            const bool bend = addr[10] == 'b';
+            rule->kind = bend ? Kind::Bend : Kind::Control;
+            ok = configureControl(data, size, *rule, bend);
+        }
+        const int32_t id = rule->id;
+        if (ok) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            install(std::move(rule));
+        }
+        const std::string replyAddr = std::string(addr) + ".reply";
+        sendReply(reply, replyAddr.c_str(), id, ok);
+        return true;
+    }
+
+    if (std::strcmp(addr, "/midi/map/remove") == 0) {
+        int32_t id = 0;
+        bool found = false;
+        try {
+            osc::ReceivedMessage msg(osc::ReceivedPacket(reinterpret_cast<const char*>(data),
+                                     static_cast<osc::osc_bundle_element_size_t>(size)));
+            auto it = msg.ArgumentsBegin();
+            if (readInt(it, msg.ArgumentsEnd(), id)) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                for (auto r = mRules.begin(); r != mRules.end(); ++r) {
+                    if ((*r)->id != id) continue;
+                    releaseVoices(**r);
+                    mRules.erase(r);
+                    found = true;
+                    break;
+                }
+            }
+        } catch (...) {}
+        sendReply(reply, "/midi/map/remove.reply", id, found);
+        return true;
+    }
+
+    if (std::strcmp(addr, "/midi/map/clear") == 0) {
+        const int removed = clear();
+        char buf[64];
+        osc::OutboundPacketStream s(buf, sizeof(buf));
+        s << osc::BeginMessage("/midi/map/clear.reply") << removed << osc::EndMessage;
+        reply(reinterpret_cast<const uint8_t*>(s.Data()), static_cast<uint32_t>(s.Size()));
+        return true;
+    }
+
+    if (std::strcmp(addr, "/midi/map/list") == 0) {
+        // i:rules i:voices h:events h:messages, then per rule
+        // i:id s:kind s:port i:channel
+        std::lock_guard<std::mutex> lock(mMutex);
+        size_t bytes = 128;
+        for (const auto& r : mRules) bytes += 48 + r->port.size();
+        std::vector<char> buf(bytes);
+        osc::OutboundPacketStream s(buf.data(), buf.size());
+        s << osc::BeginMessage("/midi/map/list.reply")
+          << static_cast<int32_t>(mRules.size()) << static_cast<int32_t>(mVoices)
+          << static_cast<osc::int64>(mEvents) << static_cast<osc::int64>(mMessages);
+        for (const auto& r : mRules)
+            s << r->id << kindName(static_cast<int>(r->kind)) << r->port.c_str()
+              << static_cast<int32_t>(r->channel);
+        s << osc::EndMessage;
+        reply(reinterpret_cast<const uint8_t*>(s.Data()), static_cast<uint32_t>(s.Size()));
+        return true;
+    }
+    return false;
+}
+
+int MidiMap::clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& r : mRules) releaseVoices(*r);
+    const int removed = static_cast<int>(mRules.size());
+    mRules.clear();
+    return removed;
+}
+
+MidiMap::Stats MidiMap::stats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Stats s;
+    s.rules    = static_cast<int>(mRules.size());
+    s.voices   = mVoices;
+    s.events   = mEvents;
+    s.messages = mMessages;
+    return s;
+}
+
+// ── Evaluation (MIDI input thread) ──────────────────────────────────────────
+
+void MidiMap::emit(Template& t) {
+    if (t.bytes.empty() || !mSink) return;
+    mSink(t.bytes.data(), static_cast<uint32_t>(t.bytes.size()));
+    ++mMessages;
+}
+
+int32_t MidiMap::allocNode() {
+    const int32_t id = mNextNode;
+    mNextNode = mNextNode + 1 < kNodeBase + kNodeSpan ? mNextNode + 1 : kNodeBase;
+    return id;
+}
+
+void MidiMap::releaseVoices(Rule& rule) {
+    for (auto& node : rule.voices) {
+        if (!node) continue;
+        if (rule.off.nodeAt) {
+            patchU32(rule.off.bytes, rule.off.nodeAt, static_cast<uint32_t>(node));
+            emit(rule.off);
+        }
+        node = 0;
+        --mVoices;
+    }
+}
+
+int MidiMap::midiIn(const uint8_t* osc, uint32_t len) {
+    const char* addr = reinterpret_cast<const char*>(osc);
+    if (len < 16 || std::strncmp(addr, "/midi/in/", 9) != 0) return 0;
+    const char* verb = addr + 9;
+    enum { kNoteOn, kNoteOff, kControl, kBend } event;
+    if      (std::strcmp(verb, "note_on") == 0)        event = kNoteOn;
+    else if (std::strcmp(verb, "note_off") == 0)       event = kNoteOff;
+    else if (std::strcmp(verb, "control_change") == 0) event = kControl;
+    else if (std::strcmp(verb, "pitch_bend") == 0)     event = kBend;
+    else return 0;
+
+    // <port:s> <channel:i> <data1:i> [data2:i]
+    const char* port = nullptr;
+    int32_t channel = 0, a = 0, b = 0;
+    try {
+        osc::ReceivedMessage msg(osc::ReceivedPacket(addr,
+                                 static_cast<osc::osc_bundle_element_size_t>(len)));
+        auto it = msg.ArgumentsBegin();
+        const auto end = msg.ArgumentsEnd();
+        if (it == end || !it->IsString()) return 0;
+        port = it->AsStringUnchecked(); ++it;
+        if (!readInt(it, end, channel) || !readInt(it, end, a)) return 0;
+        if (event != kBend && !readInt(it, end, b)) return 0;
+    } catch (...) {
+        return 0;
+    }
+    if (channel < 1 || channel > 16) return 0;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const uint64_t before = mMessages;
+    for (auto& rp : mRules) {
+        Rule& r = *rp;
+        if (r.channel && r.channel != channel) continue;
+        if (r.port != "*" && r.port != port) continue;
+
+        switch (event) {
+        case kNoteOn:
+        case kNoteOff: {
+            if (r.kind != Kind::Notes || a < r.low || a > r.high) break;
+            int32_t& voice = r.voices[(channel - 1) * 128 + a];
+            if (voice) {   // note-off, or a retrigger without one
+                if (r.off.nodeAt) {
+                    patchU32(r.off.bytes, r.off.nodeAt, static_cast<uint32_t>(voice));
+                    emit(r.off);
+                }
+                voice = 0;
+                --mVoices;
+            }
+            if (event == kNoteOff) { ++mEvents; break; }
+            voice = allocNode();
+            ++mVoices;
+            patchU32(r.on.bytes, r.on.nodeAt, static_cast<uint32_t>(voice));
+            if (r.on.valueAt) {
+                const float pitch = r.hz ? 440.0f * std::exp2((a - 69) / 12.0f)
+                                         : static_cast<float>(a);
+                patchU32(r.on.bytes, r.on.valueAt, floatBits(pitch));
+            }
+            if (r.on.extraAt)
+                patchU32(r.on.bytes, r.on.extraAt,
+                         floatBits(r.velMin + (r.velMax - r.velMin) * (b / 127.0f)));
+            emit(r.on);
+            ++mEvents;
+            break;
+        }
+        case kControl: {
+            if (r.kind != Kind::Control || r.controller != a) break;
+            const float x = b / 127.0f;
+            const float v = r.exponential ? r.min * std::pow(r.max / r.min, x)
+                                          : r.min + (r.max - r.min) * x;
+            patchU32(r.set.bytes, r.set.valueAt, floatBits(v));
+            emit(r.set);
+            ++mEvents;
+            break;
+        }
+        case kBend: {
+            if (r.kind != Kind::Bend) break;
+            // 0..16383 with 8192 at rest: centre maps to the middle of the range.
+            const float x = a < 8192 ? (a - 8192) / 8192.0f : (a - 8192) / 8191.0f;
+            const float v = 0.5f * (r.min + r.max) + x * 0.5f * (r.max - r.min);
+            patchU32(r.set.bytes, r.set.valueAt, floatBits(v));
+            emit(r.set);
+            ++mEvents;
+            break;
+        }
+        }
+    }
+    return static_cast<int>(mMessages - before);
+}
@@ -0,0 +1,107 @@
+/*
+ * MidiMap.h — In-engine MIDI-to-synth mapping
+ *
+ * A rule table, configured over "/midi/map/" OSC, that turns "/midi/in/"
+ * events into scsynth commands without a client round trip:
+ *
+ *   notes  note-on  -> /s_new <def> on a MIDI-owned node ID, note and velocity
+ *                      mapped to controls; note-off -> gate release
+ *   cc     a controller -> /c_set on a bus, or /n_set on a node or group
+ *   bend   pitch bend   -> the same, centre mapping to the middle of the range
+ *
+ * Each rule's messages are encoded once when it is configured. Evaluating an
+ * event patches the node ID and the values into those bytes and hands them to
+ * the sink (the engine's ingest, origin 0), so they land in the IN ring and
+ * apply at the next block.
+ *
+ * Threads: handleCommand on the NRT gateway; midiIn on the MIDI input
+ * thread(s). One mutex guards the table; neither side is the audio thread.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class MidiMap {
+public:
+    using Sink = std::function<void(const uint8_t*, uint32_t)>;
+
+    // Where evaluated messages go. Set before any MIDI arrives.
+    void setSink(Sink sink) { mSink = std::move(sink); }
+
+    // One "/midi/map/" command; `reply` receives the OSC reply. Returns false
+    // if the address is not a map verb.
+    bool handleCommand(const uint8_t* data, uint32_t size, const Sink& reply);
+
+    // Evaluate one "/midi/in/" event packet. Returns the number of messages
+    // injected (0 when no rule matches or the event is not mapped).
+    int midiIn(const uint8_t* osc, uint32_t len);
+
+    // Release every held voice and drop all rules. Returns the rule count.
+    int clear();
+
+    struct Stats {
+        int      rules    = 0;
+        int      voices   = 0;   // notes held by note rules
+        uint64_t events   = 0;   // MIDI events that matched a rule
+        uint64_t messages = 0;   // messages injected
+    };
+    Stats stats() const;
+
+    // Node IDs for mapped notes come from [kNodeBase, kNodeBase + kNodeSpan),
+    // cycling, so they stay clear of client-allocated IDs.
+    static constexpr int32_t kNodeBase = 0x50000000;
+    static constexpr int32_t kNodeSpan = 0x01000000;
+
+private:
+    enum class Kind { Notes, Control, Bend };
+
+    // A pre-encoded message (or bundle) and the byte offsets of the fields
+    // patched per event. 0 = field absent.
+    struct Template {
+        std::vector<uint8_t> bytes;
+        uint32_t nodeAt  = 0;
+        uint32_t valueAt = 0;
+        uint32_t extraAt = 0;
+    };
+
+    struct Rule {
+        int32_t     id = 0;
+        Kind        kind = Kind::Notes;
+        std::string port;          // "*" = any input port
+        int         channel = 0;   // 1..16, 0 = any
+
+        // notes
+        int      low = 0, high = 127;
+        bool     hz = false;       // pitch control gets a frequency, not a note
+        float    velMin = 0.0f, velMax = 1.0f;
+        Template on;               // /s_new: node, pitch (value), velocity (extra)
+        Template off;              // [/error -1, /n_set node gate 0]: node
+        std::vector<int32_t> voices;   // [channel * 128 + note] -> node ID, 0 = none
+
+        // cc / bend
+        int      controller = 0;
+        float    min = 0.0f, max = 1.0f;
+        bool     exponential = false;
+        Template set;              // /c_set or /n_set: value
+    };
+
+    bool configureNotes(const uint8_t* data, uint32_t size, Rule& rule);
+    bool configureControl(const uint8_t* data, uint32_t size, Rule& rule, bool bend);
+    void install(std::unique_ptr<Rule> rule);          // mMutex held
+    void releaseVoices(Rule& rule);                    // mMutex held
+    void emit(Template& t);                            // mMutex held
+    int32_t allocNode();                               // mMutex held
+
+    Sink mSink;
+    mutable std::mutex                 mMutex;
+    std::vector<std::unique_ptr<Rule>> mRules;
+    int32_t                            mNextNode = kNodeBase;
+    int                                mVoices   = 0;
+    uint64_t                           mEvents   = 0;
+    uint64_t                           mMessages = 0;
+};
@@ -4,15 +4,22 @@
  *
  * Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
  *
- * OriginTable.h — a UDP transport's address book: maps a sender (ip,port) to a
- * stable, non-zero origin token (stamped into the IN-ring Message.sourceId) and
- * back, so a reply can be addressed to the client that sent a command.
+ * OriginTable.h — a datagram transport's address book: maps a sender address to
+ * a stable, non-zero origin token (stamped into the IN-ring Message.sourceId)
+ * and back, so a reply can be addressed to the client that sent a command.
  *
- * Client-keyed, not packet-keyed: the same (ip,port) always maps to the same
+ * Client-keyed, not packet-keyed: the same address always maps to the same
  * token, so a token never churns under traffic — it survives across a scheduled
  * event's delay. Eviction is per distinct client (LRU by last-seen) only when the
  * table is full. intern() runs on the recv thread, resolve() on the egress
  * thread, so a mutex guards the table. JUCE-free — plain std types.
+ *
+ * BasicOriginTable is keyed by any equality-comparable, copyable address type:
+ * UdpOscTransport uses the packed sockaddr it receives from ss_osc (no string
+ * formatting per datagram, and a reply needs no re-resolution); OriginTable is
+ * the (ip,port) form the UDS transport and tests use. Both lookups try the last
+ * hit first — a burst of commands from one client, and the burst of replies to
+ * it, skip the scan.
  */
 #pragma once
 
@@ -20,17 +27,22 @@
 #include <mutex>
 #include <string>
 
-class OriginTable {
+template <typename Key>
+class BasicOriginTable {
 public:
-    // Map (ip,port) → a stable token (>= 1). Known client → its existing token
+    // Map an address → a stable token (>= 1). Known client → its existing token
     // (refreshing the LRU stamp); new client → a fresh token, evicting the
     // least-recently-seen entry if the table is full.
-    uint32_t intern(const std::string& ip, int port) {
+    uint32_t intern(const Key& key) {
         std::lock_guard<std::mutex> lk(mMutex);
         const uint64_t now = ++mClock;
-        for (uint32_t i = 0; i < mUsed; ++i) {       // port-check first (cheap)
+        if (mHint < mUsed && mTable[mHint].key == key) {
+            mTable[mHint].lastSeen = now;
+            return mTable[mHint].token;
+        }
+        for (uint32_t i = 0; i < mUsed; ++i) {
             Entry& e = mTable[i];
-            if (e.port == port && e.ip == ip) { e.lastSeen = now; return e.token; }
+            if (e.key == key) { e.lastSeen = now; mHint = i; return e.token; }
         }
         uint32_t slot;
         if (mUsed < kSize) {
@@ -43,31 +55,32 @@ public:
         Entry& e = mTable[slot];
         e.token    = ++mCounter;   // >= 1
         e.lastSeen = now;
-        e.port     = port;
-        e.ip       = ip;
+        e.key      = key;
+        mHint      = slot;
         return e.token;
     }
 
-    // Resolve a token back to (ip,port). Returns false (ip cleared, port 0) for
+    // Resolve a token back to its address. Returns false (key untouched) for
     // token 0 (in-process caller) or an unknown/evicted token.
-    bool resolve(uint32_t token, std::string& ip, int& port) const {
-        ip.clear();
-        port = 0;
+    bool resolve(uint32_t token, Key& key) const {
         if (token == 0) return false;
         std::lock_guard<std::mutex> lk(mMutex);
+        if (mHint < mUsed && mTable[mHint].token == token) {
+            key = mTable[mHint].key;
+            return true;
+        }
         for (uint32_t i = 0; i < mUsed; ++i) {
             const Entry& e = mTable[i];
-            if (e.token == token) { ip = e.ip; port = e.port; return true; }
+            if (e.token == token) { key = e.key; mHint = i; return true; }
         }
         return false;
     }
 
 private:
     struct Entry {
-        uint32_t    token    = 0;
-        uint64_t    lastSeen = 0;
-        std::string ip;
-        int         port     = 0;
+        uint32_t token    = 0;
+        uint64_t lastSeen = 0;
+        Key      key{};
     };
     static constexpr uint32_t kSize = 1024;   // max distinct clients
 
@@ -75,5 +88,30 @@ private:
     uint32_t           mUsed    = 0;   // entries in use (packed prefix)
     uint32_t           mCounter = 0;   // next token
     uint64_t           mClock   = 0;   // LRU stamp source
+    mutable uint32_t   mHint    = 0;   // slot of the last intern/resolve hit
     mutable std::mutex mMutex;
 };
+
+// (ip,port) key for transports whose ingress reports the sender as text.
+struct OriginIpPort {
+    std::string ip;
+    int         port = 0;
+    bool operator==(const OriginIpPort& o) const { return port == o.port && ip == o.ip; }
+};
+
+class OriginTable : public BasicOriginTable<OriginIpPort> {
+public:
+    using BasicOriginTable<OriginIpPort>::intern;
+    using BasicOriginTable<OriginIpPort>::resolve;
+
+    uint32_t intern(const std::string& ip, int port) { return intern(OriginIpPort{ip, port}); }
+
+    // As resolve(token, key), but clears ip / zeroes port on failure.
+    bool resolve(uint32_t token, std::string& ip, int& port) const {
+        OriginIpPort k;
+        const bool ok = resolve(token, k);
+        ip   = std::move(k.ip);
+        port = k.port;
+        return ok;
+    }
+};
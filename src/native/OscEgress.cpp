@@ -7,6 +7,7 @@
 #include "IOscTransport.h"
 #include "osc_debug.h"
 #include "src/lanes/lanes_internal.h"  // ss_egress_nrt_write (NRT egress producer)
+#include "src/usdt.h"
 #include "osc/OscOutboundPacketStream.h"
 #include <cstring>
 
@@ -74,6 +75,7 @@ void OscEgress::dispatchEgress(uint32_t originToken, uint32_t route,
     if (mInterceptor && mInterceptor(osc, oscLen)) return;
 
     if (!mTransport) return;
+    SS_PROBE3(transport_send, oscLen, originToken, route);
     switch (route) {
         case REPLY:          mTransport->send(originToken, osc, oscLen, /*networkOnly*/ false); break;
         case SEND_TO_CALLER: mTransport->send(originToken, osc, oscLen, /*networkOnly*/ true);  break;
@@ -86,8 +88,15 @@ void OscEgress::dispatchEgress(uint32_t originToken, uint32_t route,
     }
 }
 
+void OscEgress::flush() {
+    if (mTransport) mTransport->flush();
+}
+
+// Outside a drain pass, so nothing else will flush it.
 void OscEgress::deliverBroadcastNotify(const uint8_t* osc, uint32_t size) {
-    if (mTransport) mTransport->broadcastNotify(osc, size);
+    if (!mTransport) return;
+    mTransport->broadcastNotify(osc, size);
+    mTransport->flush();
 }
 
 void OscEgress::deliverDebug(const char* text, uint32_t len) {
@@ -52,6 +52,8 @@ public:
     // interceptor, else route by tag to the transport.
     void dispatchEgress(uint32_t originToken, uint32_t route,
                         const uint8_t* osc, uint32_t oscLen);
+    // End of a drain: let a batching transport send what dispatchEgress queued.
+    void flush();
     // Optional pre-dispatch hook; returns true to swallow the message.
     void setInterceptor(std::function<bool(const uint8_t*, uint32_t)> fn) { mInterceptor = std::move(fn); }
     // Deliver an already-OSC packet to the notify audience and a debug line.
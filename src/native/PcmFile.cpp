@@ -0,0 +1,468 @@
+#include "PcmFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SS_PCM_SSE2 1
+#if defined(__GNUC__)
+#include <tmmintrin.h>
+#define SS_PCM_SSSE3 1
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SS_PCM_NEON 1
+#endif
+
+namespace supersonic {
+
+namespace {
+
+// Scale factors libsndfile applies with normalisation on (its default).
+constexpr float kScale8  = 1.0f / 0x80;
+constexpr float kScale16 = 1.0f / 0x8000;
+constexpr float kScale32 = 1.0f / 0x80000000u;   // 24-bit samples are shifted to 32
+
+inline uint16_t le16(const uint8_t* p) { return uint16_t(p[0] | p[1] << 8); }
+inline uint32_t le32(const uint8_t* p) { return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24; }
+inline uint16_t be16(const uint8_t* p) { return uint16_t(p[0] << 8 | p[1]); }
+inline uint32_t be32(const uint8_t* p) { return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | uint32_t(p[3]); }
+
+inline bool tag(const uint8_t* p, const char* id) { return std::memcmp(p, id, 4) == 0; }
+
+// ── Scalar kernels (tails, and hosts without a vector path) ─────────────────
+
+void scalar(PcmEncoding enc, const uint8_t* s, float* d, size_t n) {
+    switch (enc) {
+    case PcmEncoding::U8:
+        for (size_t i = 0; i < n; ++i) d[i] = (int(s[i]) - 128) * kScale8;
+        break;
+    case PcmEncoding::S8:
+        for (size_t i = 0; i < n; ++i) d[i] = int8_t(s[i]) * kScale8;
+        break;
+    case PcmEncoding::S16LE:
+        for (size_t i = 0; i < n; ++i) d[i] = int16_t(le16(s + 2 * i)) * kScale16;
+        break;
+    case PcmEncoding::S16BE:
+        for (size_t i = 0; i < n; ++i) d[i] = int16_t(be16(s + 2 * i)) * kScale16;
+        break;
+    case PcmEncoding::S24LE:
+        for (size_t i = 0; i < n; ++i, s += 3)
+            d[i] = int32_t(uint32_t(s[2]) << 24 | uint32_t(s[1]) << 16 | uint32_t(s[0]) << 8) * kScale32;
+        break;
+    case PcmEncoding::S24BE:
+        for (size_t i = 0; i < n; ++i, s += 3)
+            d[i] = int32_t(uint32_t(s[0]) << 24 | uint32_t(s[1]) << 16 | uint32_t(s[2]) << 8) * kScale32;
+        break;
+    case PcmEncoding::S32LE:
+        for (size_t i = 0; i < n; ++i) d[i] = float(int32_t(le32(s + 4 * i))) * kScale32;
+        break;
+    case PcmEncoding::S32BE:
+        for (size_t i = 0; i < n; ++i) d[i] = float(int32_t(be32(s + 4 * i))) * kScale32;
+        break;
+    case PcmEncoding::F32LE:
+        std::memcpy(d, s, n * sizeof(float));
+        break;
+    }
+}
+
+// ── Vector kernels ──────────────────────────────────────────────────────────
+// Each converts the largest prefix it can and returns the samples done; the
+// scalar kernel finishes the rest. Integer → float conversion is exact or
+// round-to-nearest in both paths, and the scales are powers of two, so the
+// results are bit-identical to the scalar ones.
+
+#if SS_PCM_SSE2
+
+inline __m128i bswap16(__m128i x) {
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+inline __m128i bswap32(__m128i x) {
+    x = bswap16(x);
+    return _mm_or_si128(_mm_slli_epi32(x, 16), _mm_srli_epi32(x, 16));
+}
+
+size_t vec16(const uint8_t* s, float* d, size_t n, bool be) {
+    const __m128 k = _mm_set1_ps(kScale16);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * i));
+        if (be) x = bswap16(x);
+        // Sign-extend by placing each int16 in the top half of an int32.
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_ps(d + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), k));
+        _mm_storeu_ps(d + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), k));
+    }
+    return i;
+}
+
+size_t vec32(const uint8_t* s, float* d, size_t n, bool be) {
+    const __m128 k = _mm_set1_ps(kScale32);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * i));
+        if (be) x = bswap32(x);
+        _mm_storeu_ps(d + i, _mm_mul_ps(_mm_cvtepi32_ps(x), k));
+    }
+    return i;
+}
+
+#if SS_PCM_SSSE3
+// 24-bit needs a byte shuffle; SSSE3 isn't in the x86-64 baseline, so this
+// is compiled for it separately and picked at runtime.
+__attribute__((target("ssse3")))
+size_t vec24(const uint8_t* s, float* d, size_t n, bool be) {
+    // Each sample's three bytes go to the top of an int32 lane; -1 zeroes
+    // the low byte.
+    const __m128i shufLe = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    const __m128i shufBe = _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9);
+    const __m128i shuf = be ? shufBe : shufLe;
+    const __m128 k = _mm_set1_ps(kScale32);
+    size_t i = 0;
+    // A 16-byte load covers 4 samples plus 4 bytes of the next ones; stop
+    // while those stay inside the source.
+    for (; i + 6 <= n; i += 4) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * i));
+        _mm_storeu_ps(d + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(x, shuf)), k));
+    }
+    return i;
+}
+
+bool haveSsse3() {
+    static const bool yes = __builtin_cpu_supports("ssse3");
+    return yes;
+}
+#else
+size_t vec24(const uint8_t*, float*, size_t, bool) { return 0; }
+bool haveSsse3() { return false; }
+#endif
+
+size_t vector(PcmEncoding enc, const uint8_t* s, float* d, size_t n) {
+    switch (enc) {
+    case PcmEncoding::S16LE: return vec16(s, d, n, false);
+    case PcmEncoding::S16BE: return vec16(s, d, n, true);
+    case PcmEncoding::S24LE: return haveSsse3() ? vec24(s, d, n, false) : 0;
+    case PcmEncoding::S24BE: return haveSsse3() ? vec24(s, d, n, true) : 0;
+    case PcmEncoding::S32LE: return vec32(s, d, n, false);
+    case PcmEncoding::S32BE: return vec32(s, d, n, true);
+    default:                 return 0;
+    }
+}
+
+#elif SS_PCM_NEON
+
+size_t vec16(const uint8_t* s, float* d, size_t n, bool be) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x16_t b = vld1q_u8(s + 2 * i);
+        if (be) b = vrev16q_u8(b);
+        const int16x8_t x = vreinterpretq_s16_u8(b);
+        vst1q_f32(d + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), kScale16));
+        vst1q_f32(d + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), kScale16));
+    }
+    return i;
+}
+
+size_t vec24(const uint8_t* s, float* d, size_t n, bool be) {
+    const uint8x8_t zero = vdup_n_u8(0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // De-interleave 8 samples into their first, second and third bytes.
+        const uint8x8x3_t v = vld3_u8(s + 3 * i);
+        const uint8x8_t b0 = be ? v.val[2] : v.val[0];   // least significant
+        const uint8x8_t b1 = v.val[1];
+        const uint8x8_t b2 = be ? v.val[0] : v.val[2];   // most significant
+        // Low halves b0 << 8, high halves b2:b1; zip them into int32 lanes.
+        const uint8x8x2_t lo = vzip_u8(zero, b0);
+        const uint8x8x2_t hi = vzip_u8(b1, b2);
+        const uint16x8x2_t w = vzipq_u16(vreinterpretq_u16_u8(vcombine_u8(lo.val[0], lo.val[1])),
+                                         vreinterpretq_u16_u8(vcombine_u8(hi.val[0], hi.val[1])));
+        vst1q_f32(d + i,     vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(w.val[0])), kScale32));
+        vst1q_f32(d + i + 4, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(w.val[1])), kScale32));
+    }
+    return i;
+}
+
+size_t vec32(const uint8_t* s, float* d, size_t n, bool be) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint8x16_t b = vld1q_u8(s + 4 * i);
+        if (be) b = vrev32q_u8(b);
+        vst1q_f32(d + i, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u8(b)), kScale32));
+    }
+    return i;
+}
+
+size_t vector(PcmEncoding enc, const uint8_t* s, float* d, size_t n) {
+    switch (enc) {
+    case PcmEncoding::S16LE: return vec16(s, d, n, false);
+    case PcmEncoding::S16BE: return vec16(s, d, n, true);
+    case PcmEncoding::S24LE: return vec24(s, d, n, false);
+    case PcmEncoding::S24BE: return vec24(s, d, n, true);
+    case PcmEncoding::S32LE: return vec32(s, d, n, false);
+    case PcmEncoding::S32BE: return vec32(s, d, n, true);
+    default:                 return 0;
+    }
+}
+
+#else
+
+size_t vector(PcmEncoding, const uint8_t*, float*, size_t) { return 0; }
+
+#endif
+
+// 80-bit IEEE extended (AIFF COMM sample rate) → integer, truncating like
+// libsndfile.
+int extendedToInt(const uint8_t* p) {
+    const int exponent = ((p[0] & 0x7F) << 8 | p[1]) - 16383 - 63;
+    uint64_t mantissa = 0;
+    for (int i = 2; i < 10; ++i) mantissa = mantissa << 8 | p[i];
+    if ((p[0] & 0x80) || mantissa == 0) return 0;
+    const double v = std::ldexp(static_cast<double>(mantissa), exponent);
+    return v >= 1.0 && v < 2147483647.0 ? static_cast<int>(v) : 0;
+}
+
+}  // namespace
+
+uint32_t pcm_bytes_per_sample(PcmEncoding enc) {
+    switch (enc) {
+    case PcmEncoding::U8:
+    case PcmEncoding::S8:    return 1;
+    case PcmEncoding::S16LE:
+    case PcmEncoding::S16BE: return 2;
+    case PcmEncoding::S24LE:
+    case PcmEncoding::S24BE: return 3;
+    default:                 return 4;
+    }
+}
+
+void pcm_to_float(PcmEncoding enc, const uint8_t* src, float* dst, size_t count) {
+    const size_t done = vector(enc, src, dst, count);
+    scalar(enc, src + done * pcm_bytes_per_sample(enc), dst + done, count - done);
+}
+
+// ── PcmFile ─────────────────────────────────────────────────────────────────
+
+PcmFile::~PcmFile() { close(); }
+
+bool PcmFile::open(const char* path) {
+    close();
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // The kernels assume a little-endian host (F32LE is a straight copy).
+    (void)path;
+    return false;
+#else
+#ifdef _WIN32
+    const int wlen = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    if (wlen <= 0) return false;
+    std::vector<wchar_t> wpath(wlen);
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath.data(), wlen);
+    HANDLE file = CreateFileW(wpath.data(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < 12
+        || static_cast<uint64_t>(size.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* base = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!base) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    mFile = file;
+    mMapping = mapping;
+    mBase = static_cast<const uint8_t*>(base);
+    mSize = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < 12
+        || static_cast<uint64_t>(st.st_size) > SIZE_MAX) {
+        ::close(fd);
+        return false;
+    }
+    void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping holds its own reference
+    if (base == MAP_FAILED) return false;
+    mBase = static_cast<const uint8_t*>(base);
+    mSize = static_cast<size_t>(st.st_size);
+#endif
+
+    bool ok = false;
+    if (tag(mBase, "RIFF") && tag(mBase + 8, "WAVE"))
+        ok = parseWav();
+    else if (tag(mBase, "FORM") && (tag(mBase + 8, "AIFF") || tag(mBase + 8, "AIFC")))
+        ok = parseAiff();
+    if (!ok) close();
+    return ok;
+#endif
+}
+
+void PcmFile::close() {
+    if (mBase) {
+#ifdef _WIN32
+        UnmapViewOfFile(mBase);
+        CloseHandle(static_cast<HANDLE>(mMapping));
+        CloseHandle(static_cast<HANDLE>(mFile));
+        mFile = mMapping = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(mBase), mSize);
+#endif
+    }
+    mBase = nullptr;
+    mSize = 0;
+    mDataOffset = 0;
+    mFrames = 0;
+    mChannels = 0;
+    mSampleRate = 0;
+}
+
+bool PcmFile::parseWav() {
+    // {00000001|00000003}-0000-0010-8000-00aa00389b71, minus the first word.
+    static const uint8_t kGuidTail[12] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+                                           0x80, 0x00, 0x00, 0xAA, 0x00, 0x38 };
+    bool haveFmt = false;
+    uint32_t format = 0, bits = 0, blockAlign = 0;
+    uint64_t pos = 12;
+    while (pos + 8 <= mSize) {
+        const uint8_t* chunk = mBase + pos;
+        const uint64_t size = le32(chunk + 4);
+        const uint64_t body = pos + 8;
+        if (tag(chunk, "fmt ")) {
+            if (size < 16 || body + size > mSize) return false;
+            const uint8_t* f = mBase + body;
+            format      = le16(f);
+            mChannels   = le16(f + 2);
+            mSampleRate = static_cast<int>(le32(f + 4));
+            blockAlign  = le16(f + 12);
+            bits        = le16(f + 14);
+            if (format == 0xFFFE) {
+                if (size < 40 || le16(f + 16) < 22) return false;
+                const uint32_t validBits = le16(f + 18);
+                if (validBits != 0 && validBits != bits) return false;
+                if (std::memcmp(f + 28, kGuidTail, sizeof(kGuidTail)) != 0) return false;
+                format = le32(f + 24);
+            }
+            haveFmt = true;
+        } else if (tag(chunk, "data")) {
+            if (!haveFmt) return false;
+            mDataOffset = body;
+            // A size running past the end (a truncated or still-growing
+            // file) is clamped to what's there, as libsndfile does.
+            const uint64_t avail = mSize - body;
+            const uint64_t bytes = std::min(size, avail);
+            switch (format) {
+            case 1:
+                if      (bits == 8)  mEncoding = PcmEncoding::U8;
+                else if (bits == 16) mEncoding = PcmEncoding::S16LE;
+                else if (bits == 24) mEncoding = PcmEncoding::S24LE;
+                else if (bits == 32) mEncoding = PcmEncoding::S32LE;
+                else return false;
+                break;
+            case 3:
+                if (bits != 32) return false;
+                mEncoding = PcmEncoding::F32LE;
+                break;
+            default:
+                return false;
+            }
+            if (mChannels <= 0 || mSampleRate <= 0
+                || blockAlign != mChannels * pcm_bytes_per_sample(mEncoding))
+                return false;
+            mFrames = static_cast<int64_t>(bytes / blockAlign);
+            return true;
+        }
+        pos = body + size + (size & 1);   // chunks are word-aligned
+    }
+    return false;
+}
+
+bool PcmFile::parseAiff() {
+    const bool aifc = tag(mBase + 8, "AIFC");
+    bool haveComm = false;
+    uint32_t bits = 0;
+    int64_t commFrames = 0;
+    bool littleEndian = false;
+    uint64_t pos = 12;
+    while (pos + 8 <= mSize) {
+        const uint8_t* chunk = mBase + pos;
+        const uint64_t size = be32(chunk + 4);
+        const uint64_t body = pos + 8;
+        if (tag(chunk, "COMM")) {
+            if (size < (aifc ? 22u : 18u) || body + size > mSize) return false;
+            const uint8_t* c = mBase + body;
+            mChannels   = be16(c);
+            commFrames  = be32(c + 2);
+            bits        = be16(c + 6);
+            mSampleRate = extendedToInt(c + 8);
+            if (aifc) {
+                if (tag(c + 18, "sowt"))      littleEndian = true;
+                else if (!tag(c + 18, "NONE")) return false;
+            }
+            haveComm = true;
+        } else if (tag(chunk, "SSND")) {
+            if (!haveComm || size < 8 || body + 8 > mSize) return false;
+            const uint64_t offset = be32(mBase + body);
+            mDataOffset = body + 8 + offset;
+            if (mDataOffset > mSize) return false;
+            switch (bits) {
+            case 8:
+                if (littleEndian) return false;
+                mEncoding = PcmEncoding::S8;
+                break;
+            case 16: mEncoding = littleEndian ? PcmEncoding::S16LE : PcmEncoding::S16BE; break;
+            case 24: mEncoding = littleEndian ? PcmEncoding::S24LE : PcmEncoding::S24BE; break;
+            case 32: mEncoding = littleEndian ? PcmEncoding::S32LE : PcmEncoding::S32BE; break;
+            default: return false;
+            }
+            if (mChannels <= 0 || mSampleRate <= 0) return false;
+            const uint64_t blockAlign = static_cast<uint64_t>(mChannels) * pcm_bytes_per_sample(mEncoding);
+            const uint64_t bytes = std::min(size - 8 - std::min(size - 8, offset), mSize - mDataOffset);
+            mFrames = std::min<int64_t>(commFrames, static_cast<int64_t>(bytes / blockAlign));
+            return true;
+        }
+        pos = body + size + (size & 1);
+    }
+    return false;
+}
+
+int64_t PcmFile::read(float* dst, int64_t startFrame, int64_t numFrames) const {
+    if (!mBase) return 0;
+    startFrame = std::clamp<int64_t>(startFrame, 0, mFrames);
+    numFrames = std::clamp<int64_t>(numFrames, 0, mFrames - startFrame);
+    if (numFrames == 0) return 0;
+
+    const uint64_t frameBytes = static_cast<uint64_t>(mChannels) * pcm_bytes_per_sample(mEncoding);
+    const uint8_t* src = mBase + mDataOffset + static_cast<uint64_t>(startFrame) * frameBytes;
+#ifndef _WIN32
+    // Read-ahead over just the range being converted.
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t from = reinterpret_cast<uintptr_t>(src) & ~(page - 1);
+    posix_madvise(reinterpret_cast<void*>(from),
+                  reinterpret_cast<uintptr_t>(src) + numFrames * frameBytes - from,
+                  POSIX_MADV_SEQUENTIAL);
+#endif
+    pcm_to_float(mEncoding, src, dst, static_cast<size_t>(numFrames) * mChannels);
+    return numFrames;
+}
+
+}  // namespace supersonic
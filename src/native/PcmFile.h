@@ -0,0 +1,84 @@
+#pragma once
+
+// Plain-PCM WAV / AIFF / AIFC reader for SampleLoader's fast path.
+//
+// Most sample libraries are 16- or 24-bit integer PCM, for which decoding is
+// only a format conversion. PcmFile parses the container header itself,
+// memory-maps the file and converts the requested frames straight into the
+// caller's float buffer with vectorised kernels, instead of going through
+// libsndfile's internal read buffers.
+//
+// open() accepts only layouts it reproduces exactly as libsndfile's
+// sf_readf_float would (same frame count, same normalisation: int16 / 2^15,
+// int24 / 2^23, int32 / 2^31, 8-bit WAV offset by 128); anything else —
+// compressed or exotic encodings, RF64, padded containers, big-endian hosts —
+// returns false and the caller falls back to libsndfile:
+//
+//   WAV   format 1 (PCM 8/16/24/32) or 3 (float 32), plain or EXTENSIBLE
+//   AIFF  8/16/24/32-bit big-endian PCM
+//   AIFC  compression NONE (big-endian) or sowt (little-endian), 16/24/32-bit
+//
+// A file truncated while it is mapped raises SIGBUS on POSIX, as with any
+// mmap reader; the loader only maps files it is asked to read, once.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace supersonic {
+
+// Sample encodings the conversion kernels handle.
+enum class PcmEncoding : uint8_t {
+    U8,                 // WAV 8-bit: unsigned, offset 128
+    S8,                 // AIFF 8-bit: signed
+    S16LE, S16BE,
+    S24LE, S24BE,
+    S32LE, S32BE,
+    F32LE,
+};
+
+// Bytes per sample of `enc`.
+uint32_t pcm_bytes_per_sample(PcmEncoding enc);
+
+// Convert `count` interleaved samples at `src` (any alignment) to float.
+void pcm_to_float(PcmEncoding enc, const uint8_t* src, float* dst, size_t count);
+
+class PcmFile {
+public:
+    PcmFile() = default;
+    ~PcmFile();
+    PcmFile(const PcmFile&) = delete;
+    PcmFile& operator=(const PcmFile&) = delete;
+
+    // Parse `path` (UTF-8) and map it. False if the file can't be opened or
+    // isn't a layout this reader handles.
+    bool open(const char* path);
+    void close();
+
+    int64_t     frames()     const { return mFrames; }
+    int         channels()   const { return mChannels; }
+    int         sampleRate() const { return mSampleRate; }
+    PcmEncoding encoding()   const { return mEncoding; }
+
+    // Convert frames [startFrame, startFrame + numFrames) — clamped to the
+    // file — into `dst` (interleaved). Returns the frames written.
+    int64_t read(float* dst, int64_t startFrame, int64_t numFrames) const;
+
+private:
+    bool parseWav();
+    bool parseAiff();
+
+    const uint8_t* mBase = nullptr;   // whole-file mapping
+    size_t         mSize = 0;
+#ifdef _WIN32
+    void*          mFile = nullptr;
+    void*          mMapping = nullptr;
+#endif
+
+    uint64_t    mDataOffset = 0;
+    int64_t     mFrames = 0;
+    int         mChannels = 0;
+    int         mSampleRate = 0;
+    PcmEncoding mEncoding = PcmEncoding::S16LE;
+};
+
+}  // namespace supersonic
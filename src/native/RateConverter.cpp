@@ -0,0 +1,217 @@
+#include "RateConverter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#ifdef NOVA_SIMD
+#include "vec.hpp"
+#endif
+
+namespace supersonic {
+
+namespace {
+
+// Zeroth-order modified Bessel function of the first kind (series), for the
+// Kaiser window.
+double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    const double q = x * x / 4.0;
+    for (int k = 1; k < 64; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-17) break;
+    }
+    return sum;
+}
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Kaiser beta for ~90 dB stopband attenuation.
+constexpr double kKaiserBeta = 8.6;
+// Passband edge as a fraction of the lower rate's Nyquist.
+constexpr double kRolloff = 0.9;
+
+inline float dot(const float* c, const float* x) {
+    constexpr int kTaps = RateConverter::kTaps;
+#ifdef NOVA_SIMD
+    using vecf = nova::vec<float>;
+    static_assert(kTaps % vecf::size == 0, "kTaps must be a multiple of the vector width");
+    vecf acc(0.f);
+    for (int i = 0; i < kTaps; i += vecf::size) {
+        vecf cv, xv;
+        cv.load(c + i);
+        xv.load(x + i);
+        acc = acc + cv * xv;
+    }
+    return acc.horizontal_sum();
+#else
+    float acc = 0.f;
+    for (int i = 0; i < kTaps; ++i)
+        acc += c[i] * x[i];
+    return acc;
+#endif
+}
+
+}  // namespace
+
+bool RateConverter::supports(int rateA, int rateB) {
+    if (rateA <= 0 || rateB <= 0) return false;
+    const int g = std::gcd(rateA, rateB);
+    return rateA / g <= kMaxPhases && rateB / g <= kMaxPhases;
+}
+
+bool RateConverter::configure(int inRate, int outRate, int numChannels,
+                              int maxPushFrames, int maxPullFrames) {
+    mChannels = 0;
+    if (inRate <= 0 || outRate <= 0 || inRate == outRate || numChannels <= 0)
+        return false;
+    const int g = std::gcd(inRate, outRate);
+    const int L = outRate / g;
+    const int M = inRate / g;
+    if (L > kMaxPhases)
+        return false;
+
+    mInRate  = inRate;
+    mOutRate = outRate;
+    mL = L;
+    mM = M;
+
+    // Prototype lowpass at the upsampled rate (inRate * L): cutoff at the
+    // lower of the two Nyquists, kTaps * L long, split into L phases. Each
+    // phase is normalised to unit DC gain so the phase-to-phase gain ripple
+    // of a finite window doesn't modulate a steady signal.
+    const int N = kTaps * L;
+    const double fc = 0.5 * kRolloff / std::max(L, M);
+    const double centre = (N - 1) / 2.0;
+    const double i0Beta = besselI0(kKaiserBeta);
+    std::vector<double> h(static_cast<size_t>(N));
+    for (int k = 0; k < N; ++k) {
+        const double t = k - centre;
+        const double x = 2.0 * fc * t;
+        const double sinc = (t == 0.0) ? 1.0 : std::sin(kPi * x) / (kPi * x);
+        const double r = 2.0 * k / (N - 1) - 1.0;
+        const double w = besselI0(kKaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0Beta;
+        h[static_cast<size_t>(k)] = sinc * w;
+    }
+    mCoefs.assign(static_cast<size_t>(L) * kTaps, 0.0f);
+    for (int p = 0; p < L; ++p) {
+        double sum = 0.0;
+        for (int t = 0; t < kTaps; ++t)
+            sum += h[static_cast<size_t>(p + t * L)];
+        // Reverse the taps: output = sum_t h[p + t*L] * x[base - t], and the
+        // history window is read oldest-first, so tap i pairs with t = kTaps-1-i.
+        for (int i = 0; i < kTaps; ++i)
+            mCoefs[static_cast<size_t>(p) * kTaps + i] =
+                static_cast<float>(h[static_cast<size_t>(p + (kTaps - 1 - i) * L)] / sum);
+    }
+
+    const int pullInput = static_cast<int>(
+        (static_cast<int64_t>(std::max(1, maxPullFrames)) + 1) * M / L) + 1;
+    mCapacity = 2 * (kTaps + std::max(1, maxPushFrames) + pullInput);
+    mHistory.assign(static_cast<size_t>(numChannels) * mCapacity, 0.0f);
+    mSrc.assign(static_cast<size_t>(numChannels), nullptr);
+    mChannels = numChannels;
+    reset();
+    return true;
+}
+
+void RateConverter::reset() {
+    std::fill(mHistory.begin(), mHistory.end(), 0.0f);
+    // kTaps-1 frames of silence ahead of the first input, so the first output
+    // sits exactly on input frame 0.
+    mFill  = kTaps - 1;
+    mPos   = kTaps - 1;
+    mPhase = 0;
+}
+
+void RateConverter::compact() {
+    // When decimating, the next output can already sit past the last pushed
+    // frame (mPos > mFill); only drop what has actually been written.
+    const int shift = std::min(mPos - (kTaps - 1), mFill);
+    if (shift <= 0) return;
+    const int keep = mFill - shift;
+    for (int ch = 0; ch < mChannels; ++ch) {
+        float* row = mHistory.data() + static_cast<size_t>(ch) * mCapacity;
+        std::memmove(row, row + shift, static_cast<size_t>(keep) * sizeof(float));
+    }
+    mPos  -= shift;
+    mFill -= shift;
+}
+
+void RateConverter::push(const float* src, int srcStride, int numChannels, int frames) {
+    if (!active()) return;
+    for (int ch = 0; ch < mChannels; ++ch)
+        mSrc[static_cast<size_t>(ch)] = (src && ch < numChannels)
+            ? src + static_cast<size_t>(ch) * srcStride : nullptr;
+    push(mSrc.data(), mChannels, frames);
+}
+
+void RateConverter::push(const float* const* src, int numChannels, int frames) {
+    if (!active() || frames <= 0) return;
+    compact();
+
+    // Keep only what fits behind the filter window; drop the oldest unread
+    // input if the caller has pushed far ahead of its pulls.
+    const int room = mCapacity - kTaps;
+    int skip = 0;
+    if (frames > room) {
+        skip   = frames - room;
+        frames = room;
+    }
+    const int overflow = mFill + frames - mCapacity;
+    if (overflow > 0) {
+        const int keep = mFill - overflow;
+        for (int ch = 0; ch < mChannels; ++ch) {
+            float* row = mHistory.data() + static_cast<size_t>(ch) * mCapacity;
+            std::memmove(row, row + overflow, static_cast<size_t>(keep) * sizeof(float));
+        }
+        mFill -= overflow;
+        mPos  -= overflow;
+        if (mPos < kTaps - 1) {
+            mPos   = kTaps - 1;
+            mPhase = 0;
+        }
+    }
+
+    for (int ch = 0; ch < mChannels; ++ch) {
+        float* row = mHistory.data() + static_cast<size_t>(ch) * mCapacity + mFill;
+        const float* in = ch < numChannels ? src[ch] : nullptr;
+        if (in)
+            std::memcpy(row, in + skip, static_cast<size_t>(frames) * sizeof(float));
+        else
+            std::memset(row, 0, static_cast<size_t>(frames) * sizeof(float));
+    }
+    mFill += frames;
+}
+
+int RateConverter::available() const {
+    if (!active() || mFill <= mPos) return 0;
+    // Output j needs input frame mPos + (mPhase + j*M) / L, which must be < mFill.
+    const int64_t span = static_cast<int64_t>(mFill - mPos) * mL - mPhase;
+    return static_cast<int>((span + mM - 1) / mM);
+}
+
+int RateConverter::pull(float* dst, int dstStride, int numChannels, int frames) {
+    const int n = std::min(frames, available());
+    const int nCh = std::min(numChannels, mChannels);
+    for (int j = 0; j < n; ++j) {
+        const float* c = mCoefs.data() + static_cast<size_t>(mPhase) * kTaps;
+        const int start = mPos - (kTaps - 1);
+        for (int ch = 0; ch < nCh; ++ch)
+            dst[static_cast<size_t>(ch) * dstStride + j] =
+                dot(c, mHistory.data() + static_cast<size_t>(ch) * mCapacity + start);
+        mPhase += mM;
+        mPos   += mPhase / mL;
+        mPhase %= mL;
+    }
+    return n;
+}
+
+double RateConverter::latencyInputFrames() const {
+    if (!active()) return 0.0;
+    return (mFill - mPos) - static_cast<double>(mPhase) / mL + groupDelayInputFrames();
+}
+
+}  // namespace supersonic
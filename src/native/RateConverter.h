@@ -0,0 +1,96 @@
+#pragma once
+
+// Fixed-ratio polyphase resampler between the World's internal rate and the
+// device rate (Config::internalSampleRate). The ratio is reduced to L/M
+// (out/in) and a Kaiser-windowed sinc prototype is split into L phases of
+// kTaps coefficients, so every output sample is one kTaps-long dot product
+// against contiguous input history — vectorised with nova::vec when
+// NOVA_SIMD is defined.
+//
+// Streaming and planar: push() appends frames per channel, pull() produces
+// output frames once enough input is buffered (available()). configure()
+// allocates and runs on the control thread; push/pull/available are RT-safe.
+// All channels advance in lockstep.
+
+#include <cstdint>
+#include <vector>
+
+namespace supersonic {
+
+class RateConverter {
+public:
+    // Coefficients per phase. With the cutoff at 90% of the lower rate's
+    // Nyquist, 64 taps reaches ~-85 dB by that Nyquist when the input rate is
+    // near the output rate; a large decimation ratio widens the transition.
+    static constexpr int kTaps = 64;
+    // Largest reduced interpolation factor accepted. Every pair of standard
+    // rates (8k..192k, 44.1k and 48k families) reduces well below this; an odd
+    // rate that doesn't makes configure() fail so the caller can fall back to
+    // running the World at the device rate.
+    static constexpr int kMaxPhases = 4096;
+
+    // Whether a converter between these rates (either direction) fits in
+    // kMaxPhases — the engine's test for pinning the World's rate.
+    static bool supports(int rateA, int rateB);
+
+    // Control thread. Sizes the history for pushes of up to maxPushFrames and
+    // pulls of up to maxPullFrames. Returns false — and leaves the converter
+    // inactive — for non-positive rates, equal rates or a ratio above
+    // kMaxPhases.
+    bool configure(int inRate, int outRate, int numChannels,
+                   int maxPushFrames, int maxPullFrames);
+
+    // Drop all buffered input (history back to silence). Control thread, or
+    // the audio thread while it owns the converter.
+    void reset();
+
+    bool active()   const { return mChannels > 0; }
+    int  inRate()   const { return mInRate; }
+    int  outRate()  const { return mOutRate; }
+    int  channels() const { return mChannels; }
+
+    // Append `frames` frames; channel ch is read from src + ch * srcStride.
+    // Channels beyond numChannels are fed silence. If the history would
+    // overflow, the oldest unread input is dropped.
+    void push(const float* src, int srcStride, int numChannels, int frames);
+    // Same, from per-channel pointers (a device callback's layout); a null
+    // channel pointer is fed silence.
+    void push(const float* const* src, int numChannels, int frames);
+
+    // Output frames producible from the input buffered so far.
+    int available() const;
+
+    // Write up to `frames` output frames (bounded by available()); channel ch
+    // goes to dst + ch * dstStride for ch < numChannels. Returns the count.
+    int pull(float* dst, int dstStride, int numChannels, int frames);
+
+    // Input frames between the next output sample and the next frame to be
+    // pushed, including the filter's group delay: how far (in input-rate
+    // frames) a frame pushed now lies behind the output about to be pulled.
+    // This is the latency the driver adds to its sample-clock report.
+    double latencyInputFrames() const;
+
+    // The filter's group delay alone, in input frames.
+    double groupDelayInputFrames() const {
+        return mL > 0 ? (static_cast<double>(kTaps) * mL - 1.0) / (2.0 * mL) : 0.0;
+    }
+
+private:
+    void compact();
+
+    int mInRate   = 0;
+    int mOutRate  = 0;
+    int mChannels = 0;
+    int mL = 0;   // interpolation factor (phases)
+    int mM = 0;   // decimation factor
+
+    std::vector<float> mCoefs;    // [phase][kTaps], taps reversed to match history order
+    std::vector<float> mHistory;  // [channel][mCapacity]
+    std::vector<const float*> mSrc;  // per-channel source pointers for push()
+    int mCapacity = 0;
+    int mFill  = 0;               // frames written per channel
+    int mPos   = 0;               // newest input frame under the next output
+    int mPhase = 0;               // next output's phase, 0..L-1
+};
+
+}  // namespace supersonic
@@ -2,19 +2,30 @@
  * SampleLoader.cpp — Background I/O thread for /b_allocRead
  *
  * Matches the WASM architecture:
- *   1. I/O thread decodes audio via libsndfile (off the audio thread)
+ *   1. I/O thread decodes audio via libsndfile (off the audio thread);
+ *      plain PCM WAV/AIFF goes through PcmFile's mapped fast path instead
  *   2. Decoded PCM + metadata are queued as CompletedLoad
  *   3. Audio thread calls installPendingBuffers() to install buffers and
  *      write /done replies to the OUT ring buffer
  *
  * This keeps the OUT ring buffer single-producer (audio thread only).
+ *
+ * Compaction (runCompaction) uses the same split: the I/O thread plans and
+ * copies, the audio thread snapshots the sample buffers and swaps data
+ * pointers in installPendingBuffers, and the old copies come back here to be
+ * freed.
  */
 #include "SampleLoader.h"
+#include "SampleResidency.h"
+#include "PcmFile.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <thread>
 #include <sndfile.h>
 
 // scsynth headers for World / SndBuf access
@@ -28,6 +39,12 @@
 
 // scsynth allocator (zalloc/zfree use aligned alloc matching free_alig)
 #include "synth/server/SC_Prototypes.h"
+#include "src/supersonic_heap.h"
+#include "src/lanes/lanes.h"
+#include "src/usdt.h"
+
+// SC_SequencedCommand.cpp (what /b_free resets a buffer with)
+void SndBuf_Init(SndBuf* buf);
 
 // oscpack for building /done reply
 #include "osc/OscOutboundPacketStream.h"
@@ -55,6 +72,7 @@ extern "C" {
     extern uint8_t* shared_memory;
     extern ControlPointers* control;
     extern PerformanceMetrics* metrics;
+    extern World* g_world;
 }
 
 // ring_buffer_write defined in audio_processor.cpp (outside any namespace).
@@ -124,6 +142,16 @@ void SampleLoader::initialise() {
 
 bool SampleLoader::load(World* world, int bufnum, const char* path,
                         int startFrame, int numFrames) {
+    return enqueueRequest(world, bufnum, path, startFrame, numFrames, false);
+}
+
+bool SampleLoader::prefetch(World* world, int bufnum, const char* path,
+                            int startFrame, int numFrames) {
+    return enqueueRequest(world, bufnum, path, startFrame, numFrames, true);
+}
+
+bool SampleLoader::enqueueRequest(World* world, int bufnum, const char* path,
+                                  int startFrame, int numFrames, bool resident) {
     int h = mHead.load(std::memory_order_relaxed);
     int next = (h + 1) % kMaxPending;
     if (next == mTail.load(std::memory_order_acquire))
@@ -135,17 +163,20 @@ bool SampleLoader::load(World* world, int bufnum, const char* path,
     req.startFrame = startFrame;
     req.numFrames  = numFrames;
     req.generation = mGeneration.load(std::memory_order_acquire);
+    req.resident   = resident;
     std::strncpy(req.path, path, sizeof(req.path) - 1);
     req.path[sizeof(req.path) - 1] = '\0';
 
     mHead.store(next, std::memory_order_release);
+    SS_PROBE2(sample_request, bufnum, static_cast<const char*>(req.path));
     mWakeUp.signal();
     return true;
 }
 
 void SampleLoader::run() {
+    auto lastCheck = std::chrono::steady_clock::now();
     while (!threadShouldExit()) {
-        mWakeUp.wait();
+        mWakeUp.wait(mAutoCompact ? kCompactCheckMs : -1);
         if (threadShouldExit()) break;
 
         // Drain all pending requests
@@ -157,6 +188,25 @@ void SampleLoader::run() {
             processRequest(mQueue[t]);
             mTail.store((t + 1) % kMaxPending, std::memory_order_release);
         }
+
+        const bool requested = mCompactRequested.exchange(false, std::memory_order_acq_rel);
+        const auto now = std::chrono::steady_clock::now();
+        const bool due = mAutoCompact
+            && now - lastCheck >= std::chrono::milliseconds(kCompactCheckMs);
+        if (requested || due) {
+            lastCheck = now;
+            CompactionReport report = runCompaction();
+            {
+                std::lock_guard<std::mutex> lk(mReportMutex);
+                mLastReport = report;
+                if (report.ran) {
+                    mTotalPasses++;
+                    mTotalMoved    += static_cast<uint64_t>(report.buffersMoved);
+                    mTotalReleased += report.bytesReleased;
+                }
+            }
+            if (requested) mCompactDone.signal();
+        }
     }
 }
 
@@ -164,7 +214,12 @@ void SampleLoader::run() {
 
 void SampleLoader::pauseLoading() {
     mGeneration.fetch_add(1, std::memory_order_acq_rel);
-    mLoadingPaused.store(true, std::memory_order_release);
+    mLoadingPaused.store(true);
+    // A compaction pass writes into pool memory that the cold swap is about
+    // to reset. It checks the pause between copy slices, so this is brief.
+    // (seq_cst pairs with runCompaction's mCompacting store / pause load.)
+    while (mCompacting.load())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
 }
 
 void SampleLoader::resumeLoading() {
@@ -174,19 +229,34 @@ void SampleLoader::resumeLoading() {
 // ── I/O thread: decode file and enqueue result ──────────────────────────────
 
 void SampleLoader::processRequest(const Request& req) {
+    SS_PROBE1(sample_decode, req.bufnum);
     // Check if this request is from a stale generation (pre-cold-swap)
     if (req.generation != mGeneration.load(std::memory_order_acquire)) {
-        enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation });
+        enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation, req.resident });
         return;
     }
 
+    ensureLoadedTable(req.world);
+
+    // Plain PCM goes through the mapped fast path; anything PcmFile doesn't
+    // take (compressed, exotic, or just unreadable) through libsndfile.
+    supersonic::PcmFile pcm;
+    const bool fast = mFastPcm && pcm.open(req.path);
+
     SF_INFO info = {};
-    SNDFILE* sf = openSndfile(req.path, SFM_READ, &info);
-    if (!sf) {
-        debugLog("[SampleLoader] sf_open failed: %s — %s",
-                      req.path, sf_strerror(nullptr));
-        enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation });
-        return;
+    SNDFILE* sf = nullptr;
+    if (fast) {
+        info.frames     = pcm.frames();
+        info.channels   = pcm.channels();
+        info.samplerate = pcm.sampleRate();
+    } else {
+        sf = openSndfile(req.path, SFM_READ, &info);
+        if (!sf) {
+            debugLog("[SampleLoader] sf_open failed: %s — %s",
+                          req.path, sf_strerror(nullptr));
+            enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation, req.resident });
+            return;
+        }
     }
 
     // Clamp startFrame / numFrames (same logic as BufAllocReadCmd::Stage2)
@@ -200,32 +270,44 @@ void SampleLoader::processRequest(const Request& req) {
     int numChannels = info.channels;
     int numSamples  = static_cast<int>(numFrames) * numChannels;
 
+    // Room for a prefetch under the residency budget: idle registered
+    // buffers go first (freed by the audio thread between blocks).
+    if (req.resident && mResidency)
+        requestEvictions(static_cast<uint64_t>(numSamples) * sizeof(float), req.generation);
+
     // Allocate buffer with scsynth's aligned allocator (zalloc)
     // so it can be freed by World destruction via free_alig/zfree.
     float* data = static_cast<float*>(zalloc(numSamples, sizeof(float)));
     if (!data) {
-        sf_close(sf);
+        if (sf) sf_close(sf);
         debugLog("[SampleLoader] zalloc failed for %d samples", numSamples);
-        enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation });
+        enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation, req.resident });
         return;
     }
 
     // Read audio data
-    sf_seek(sf, startFrame, SEEK_SET);
-    sf_count_t framesRead = sf_readf_float(sf, data, numFrames);
-    sf_close(sf);
+    sf_count_t framesRead;
+    if (fast) {
+        framesRead = pcm.read(data, startFrame, numFrames);
+        pcm.close();
+    } else {
+        sf_seek(sf, startFrame, SEEK_SET);
+        framesRead = sf_readf_float(sf, data, numFrames);
+        sf_close(sf);
+    }
 
     if (framesRead <= 0) {
         zfree(data);
-        debugLog("[SampleLoader] sf_readf_float returned %lld", (long long)framesRead);
-        enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation });
+        debugLog("[SampleLoader] %s returned %lld",
+                      fast ? "PcmFile::read" : "sf_readf_float", (long long)framesRead);
+        enqueueCompleted({ req.world, req.bufnum, nullptr, 0, 0, 0, false, req.generation, req.resident });
         return;
     }
 
     std::string fileName = std::filesystem::path(req.path).filename().string();
-    debugLog("[SampleLoader] loaded %s - buf %d, [%lld frames, %d ch, %d Hz], path: %s",
+    debugLog("[SampleLoader] loaded %s - buf %d, [%lld frames, %d ch, %d Hz%s], path: %s",
                   fileName.c_str(), req.bufnum, (long long)framesRead,
-                  numChannels, info.samplerate, req.path);
+                  numChannels, info.samplerate, fast ? ", pcm" : "", req.path);
 
     enqueueCompleted({
         req.world,
@@ -235,11 +317,13 @@ void SampleLoader::processRequest(const Request& req) {
         numChannels,
         info.samplerate,
         true,
-        req.generation
+        req.generation,
+        req.resident
     });
 }
 
 void SampleLoader::enqueueCompleted(CompletedLoad&& load) {
+    SS_PROBE2(sample_decoded, load.bufnum, load.numFrames);
     int h = mCompHead.load(std::memory_order_relaxed);
     int next = (h + 1) % kMaxPending;
     if (next == mCompTail.load(std::memory_order_acquire)) {
@@ -251,6 +335,7 @@ void SampleLoader::enqueueCompleted(CompletedLoad&& load) {
 
     mCompleted[h] = std::move(load);
     mCompHead.store(next, std::memory_order_release);
+    ss_idle_wake();   // an idle headless driver installs it on its next tick
 }
 
 // ── Audio thread: install buffers and write replies to OUT ring buffer ───────
@@ -260,6 +345,13 @@ void SampleLoader::installPendingBuffers() {
 
     uint32_t currentGen = mGeneration.load(std::memory_order_acquire);
 
+    // After a cold swap the loaded table describes the old World's buffers.
+    LoadedSlot* loaded = mLoadedArray.load(std::memory_order_acquire);
+    if (loaded && mLoadedGeneration != currentGen) {
+        std::fill(loaded, loaded + mLoadedCount, LoadedSlot{nullptr, 0});
+        mLoadedGeneration = currentGen;
+    }
+
     for (;;) {
         int t = mCompTail.load(std::memory_order_relaxed);
         int h = mCompHead.load(std::memory_order_acquire);
@@ -274,6 +366,19 @@ void SampleLoader::installPendingBuffers() {
             // on abandoned pool memory would corrupt the allocator.
             debugLog("[SampleLoader] discarded stale buf %d (gen %u != %u)",
                           load.bufnum, load.generation, currentGen);
+        } else if (load.resident) {
+            // A prefetch: nobody is waiting on a reply.
+            if (load.success && installBuffer(load)) {
+                if (mResidency)
+                    mResidency->installed(load.bufnum,
+                                          static_cast<uint64_t>(load.numFrames)
+                                              * load.numChannels * sizeof(float),
+                                          load.sampleRate > 0
+                                              ? static_cast<double>(load.numFrames) / load.sampleRate
+                                              : 0.0);
+            } else if (mResidency) {
+                mResidency->loadFailed(load.bufnum);
+            }
         } else if (load.success) {
             installBuffer(load);
             writeDoneReply(load.bufnum);
@@ -283,9 +388,15 @@ void SampleLoader::installPendingBuffers() {
 
         mCompTail.store((t + 1) % kMaxPending, std::memory_order_release);
     }
+
+    if (loaded && g_world) {
+        applyEvictions(g_world, currentGen);
+        applyRelocations(g_world, currentGen);
+        serviceSnapshot(g_world);
+    }
 }
 
-void SampleLoader::installBuffer(const CompletedLoad& load) {
+bool SampleLoader::installBuffer(const CompletedLoad& load) {
     World* world = load.world;
 
     // Free previous buffer data before overwriting
@@ -293,10 +404,393 @@ void SampleLoader::installBuffer(const CompletedLoad& load) {
     float* oldData = nrtBuf->data;
 
     // Use unified buffer_set_data (no guard samples — native allocates exact size)
-    buffer_set_data(world, load.bufnum, load.data, load.numFrames,
-                    load.numChannels, load.sampleRate, false);
+    const bool installed = buffer_set_data(world, load.bufnum, load.data, load.numFrames,
+                                           load.numChannels, load.sampleRate, false) == 0;
+    SS_PROBE3(sample_install, load.bufnum, load.numFrames, installed);
+
+    LoadedSlot* loaded = mLoadedArray.load(std::memory_order_acquire);
+    if (installed && loaded && load.bufnum < mLoadedCount)
+        loaded[load.bufnum] = { load.data, world->mSndBufUpdates[load.bufnum].writes };
 
     zfree(oldData);
+    return installed;
+}
+
+// ── Residency ───────────────────────────────────────────────────────────────
+
+namespace {
+
+// Claim buffer b for the audio thread to move or drop its data (evictions,
+// relocations). Fails while a /b_ command sits between its NRT Stage2 and its
+// Stage3: it has already read the data pointer, and may free it.
+bool claimMove(World* world, int b) {
+    uint32_t idle = 0;
+    return world->mSndBufUpdates[b].busy.compare_exchange_strong(idle, kSndBufMoving);
+}
+
+void endMove(World* world, int b) {
+    world->mSndBufUpdates[b].busy.fetch_sub(kSndBufMoving, std::memory_order_release);
+}
+
+} // namespace
+
+void SampleLoader::requestEvictions(uint64_t incoming, uint32_t generation) {
+    int h = mEvictHead.load(std::memory_order_relaxed);
+    const int t = mEvictTail.load(std::memory_order_acquire);
+    const int space = (t - h - 1 + kMaxPending) % kMaxPending;
+    if (space == 0) return;
+
+    int victims[kMaxPending];
+    const int n = mResidency->makeRoom(incoming, victims, space);
+    for (int i = 0; i < n; ++i) {
+        mEvictions[h] = { victims[i], generation };
+        h = (h + 1) % kMaxPending;
+    }
+    if (n > 0) {
+        mEvictHead.store(h, std::memory_order_release);
+        debugLog("[SampleLoader] evicting %d idle sample buffer(s) for %llu bytes",
+                 n, static_cast<unsigned long long>(incoming));
+    }
+}
+
+void SampleLoader::applyEvictions(World* world, uint32_t currentGen) {
+    LoadedSlot* loaded = mLoadedArray.load(std::memory_order_relaxed);
+    const int n = std::min(mLoadedCount, static_cast<int>(world->mNumSndBufs));
+    for (;;) {
+        int t = mEvictTail.load(std::memory_order_relaxed);
+        int h = mEvictHead.load(std::memory_order_acquire);
+        if (t == h) break;
+
+        const Eviction& e = mEvictions[t];
+        const int b = e.bufnum;
+        if (!mResidency || e.generation != currentGen) {
+            // Cold swap since: the residency was reset with the World.
+        } else if (b < n && loaded[b].data && mResidency->evictable(b)
+                   && World_GetNRTBuf(world, b)->data == loaded[b].data
+                   && world->mSndBufUpdates[b].writes == loaded[b].writes
+                   && claimMove(world, b)) {
+            // Between blocks, so no unit is mid-read; clear both mirrors as
+            // /b_free does, and the next reference reloads it.
+            float* data = loaded[b].data;
+            SndBuf_Init(World_GetNRTBuf(world, b));
+            SndBuf_Init(World_GetBuf(world, b));
+            world->mSndBufUpdates[b].writes++;
+            endMove(world, b);
+            loaded[b] = { nullptr, 0 };
+            zfree(data);
+            mResidency->evicted(b);
+        } else {
+            // Queued for use again since it was picked, no longer ours, or a
+            // /b_ command is working on it.
+            mResidency->keep(b);
+        }
+        mEvictTail.store((t + 1) % kMaxPending, std::memory_order_release);
+    }
+}
+
+// ── Sample-memory compaction ────────────────────────────────────────────────
+
+namespace {
+
+// Every area in the heap, however many there are (the list is counters,
+// copied under the heap lock).
+std::vector<supersonic_heap_area> heapAreas() {
+    std::vector<supersonic_heap_area> areas(16);
+    for (;;) {
+        const size_t n = supersonic_heap_areas(areas.data(), areas.size());
+        if (n <= areas.size()) {
+            areas.resize(n);
+            return areas;
+        }
+        areas.resize(n + 4);   // grew between the calls? go round again
+    }
+}
+// How long a pass waits on the audio thread (snapshot, swaps) before giving
+// up — it only answers at block boundaries, and not at all while stopped.
+constexpr int kAudioWaitMs = 2000;
+// Copy granularity between interruption checks.
+constexpr size_t kCopySlice = 1 << 20;
+
+} // namespace
+
+void SampleLoader::ensureLoadedTable(World* world) {
+    if (mLoadedArray.load(std::memory_order_relaxed) || !world || world->mNumSndBufs == 0)
+        return;
+    mLoadedCount = static_cast<int>(world->mNumSndBufs);
+    mLoadedStorage.reset(new LoadedSlot[mLoadedCount]());
+    mSnapshot.reset(new SnapshotEntry[mLoadedCount]);
+    mLoadedArray.store(mLoadedStorage.get(), std::memory_order_release);
+}
+
+void SampleLoader::serviceSnapshot(World* world) {
+    if (mSnapshotState.load(std::memory_order_acquire) != kSnapRequested) return;
+    const LoadedSlot* loaded = mLoadedArray.load(std::memory_order_relaxed);
+    const int n = std::min(mLoadedCount, static_cast<int>(world->mNumSndBufs));
+    int count = 0;
+    for (int b = 0; b < n; ++b) {
+        const LoadedSlot& slot = loaded[b];
+        if (!slot.data) continue;
+        const SndBuf* buf = World_GetNRTBuf(world, b);
+        if (buf->data != slot.data || world->mSndBufUpdates[b].writes != slot.writes)
+            continue;  // freed or replaced since the loader installed it
+        mSnapshot[count++] = { b, slot.data, buf->samples };
+        World_GetBuf(world, b)->written = 0;   // see applyRelocations
+    }
+    mSnapshotCount = count;
+    mSnapshotState.store(kSnapReady, std::memory_order_release);
+}
+
+void SampleLoader::applyRelocations(World* world, uint32_t currentGen) {
+    LoadedSlot* loaded = mLoadedArray.load(std::memory_order_relaxed);
+    const int n = std::min(mLoadedCount, static_cast<int>(world->mNumSndBufs));
+    for (;;) {
+        int t = mRelocTail.load(std::memory_order_relaxed);
+        int h = mRelocHead.load(std::memory_order_acquire);
+        if (t == h) break;
+
+        const Relocation& r = mRelocations[t];
+        Retired retired{ r.to, false, r.bytes, r.generation };
+        if (r.generation != currentGen) {
+            // Queued before a cold swap reset the heap: nothing to free.
+            retired.ptr = nullptr;
+        } else if (r.bufnum < n && loaded[r.bufnum].data == r.from
+                   && World_GetNRTBuf(world, r.bufnum)->data == r.from
+                   && world->mSndBufUpdates[r.bufnum].writes == loaded[r.bufnum].writes
+                   && !World_GetBuf(world, r.bufnum)->written
+                   && claimMove(world, r.bufnum)) {
+            // Between blocks, so no unit is mid-read; both mirrors move
+            // together, exactly as buffer_set_data publishes a new buffer.
+            // Nothing wrote the samples since the snapshot (written is still
+            // clear, writes unchanged), so the copy is current; and no /b_
+            // command holds the buffer, so none has read the old pointer.
+            World_GetNRTBuf(world, r.bufnum)->data = r.to;
+            World_GetBuf(world, r.bufnum)->data    = r.to;
+            endMove(world, r.bufnum);
+            loaded[r.bufnum].data = r.to;
+            retired.ptr   = r.from;
+            retired.moved = true;
+        }
+        // The loader keeps fewer than kMaxPending relocations outstanding, so
+        // the retired ring always has room.
+        int rh = mRetHead.load(std::memory_order_relaxed);
+        mRetired[rh] = retired;
+        mRetHead.store((rh + 1) % kMaxPending, std::memory_order_release);
+
+        mRelocTail.store((t + 1) % kMaxPending, std::memory_order_release);
+    }
+}
+
+int SampleLoader::drainRetired(CompactionReport& report) {
+    int drained = 0;
+    const uint32_t gen = mGeneration.load(std::memory_order_acquire);
+    for (;;) {
+        int t = mRetTail.load(std::memory_order_relaxed);
+        int h = mRetHead.load(std::memory_order_acquire);
+        if (t == h) break;
+
+        const Retired& r = mRetired[t];
+        // A stale generation's pointers belonged to the heap before a cold
+        // swap reset it (see installPendingBuffers' stale-load note).
+        if (r.ptr && r.generation == gen)
+            supersonic_heap_free(r.ptr);
+        if (r.moved) {
+            report.buffersMoved++;
+            report.bytesMoved += r.bytes;
+        }
+        mRetTail.store((t + 1) % kMaxPending, std::memory_order_release);
+        ++drained;
+    }
+    mOutstanding -= drained;
+    return drained;
+}
+
+bool SampleLoader::compactionInterrupted() const {
+    return threadShouldExit()
+        || mLoadingPaused.load(std::memory_order_acquire)
+        || mGeneration.load(std::memory_order_acquire) != mPassGeneration;
+}
+
+bool SampleLoader::waitFor(const std::function<bool()>& done, int timeoutMs) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!done()) {
+        if (compactionInterrupted() || std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+SampleLoader::CompactionReport SampleLoader::runCompaction() {
+    CompactionReport report;
+    if (mLoadingPaused.load(std::memory_order_acquire)
+        || !mLoadedArray.load(std::memory_order_acquire))
+        return report;
+
+    mPassGeneration = mGeneration.load(std::memory_order_acquire);
+    mCompacting.store(true);
+    struct Busy {
+        std::atomic<bool>& flag;
+        ~Busy() { flag.store(false, std::memory_order_release); }
+    } busy{mCompacting};
+    if (mLoadingPaused.load() || compactionInterrupted()) return report;
+
+    // Leftovers from a pass that gave up waiting on the audio thread.
+    CompactionReport late;
+    drainRetired(late);
+
+    std::vector<supersonic_heap_area> areas;
+    auto readAreas = [&] { areas = heapAreas(); };
+    auto sparse = [](const supersonic_heap_area& a) {
+        return !a.initial && a.numInUse > 0 && a.inUse * 2 <= a.size;
+    };
+
+    // Cheap check first: no growth area at most half full, nothing to gain.
+    readAreas();
+    if (std::none_of(areas.begin(), areas.end(), sparse))
+        return report;
+
+    const size_t footprintBefore = supersonic_heap_total_allocated();
+    const size_t releasedBefore  = supersonic_heap_released_bytes();
+    const size_t grownBefore     = supersonic_heap_growth_count();
+    auto growthAreas = [&] {
+        return static_cast<int>(std::count_if(areas.begin(), areas.end(),
+                                              [](const supersonic_heap_area& a) { return !a.initial; }));
+    };
+    const int areasBefore = growthAreas();
+
+    // Another thread may free a buffer while it is being copied out; its
+    // area must stay mapped until the pass is over.
+    supersonic_heap_hold_released_areas(true);
+    struct Hold {
+        ~Hold() { supersonic_heap_hold_released_areas(false); }
+    } hold;
+
+    // Which buffers hold loaded samples right now, from the audio thread.
+    int expected = kSnapIdle;
+    mSnapshotState.compare_exchange_strong(expected, kSnapRequested, std::memory_order_acq_rel);
+    if (!waitFor([this] { return mSnapshotState.load(std::memory_order_acquire) == kSnapReady; },
+                 kAudioWaitMs))
+        return report;
+    std::vector<SnapshotEntry> samples(mSnapshot.get(), mSnapshot.get() + mSnapshotCount);
+    mSnapshotState.store(kSnapIdle, std::memory_order_release);
+
+    // An area can only be emptied if every live allocation in it is a sample
+    // this pass can move.
+    readAreas();
+    std::vector<int> samplesIn(areas.size(), 0);
+    std::vector<int> areaOf(samples.size(), -1);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const char* p = reinterpret_cast<const char*>(samples[i].data);
+        for (size_t a = 0; a < areas.size(); ++a) {
+            if (p >= areas[a].begin && p < areas[a].end) {
+                areaOf[i] = static_cast<int>(a);
+                samplesIn[a]++;
+                break;
+            }
+        }
+    }
+    std::vector<int> victims;
+    for (size_t a = 0; a < areas.size(); ++a)
+        if (sparse(areas[a]) && static_cast<size_t>(samplesIn[a]) == areas[a].numInUse)
+            victims.push_back(static_cast<int>(a));
+    std::sort(victims.begin(), victims.end(),
+              [&](int x, int y) { return areas[x].inUse < areas[y].inUse; });
+
+    // A lone victim is only worth moving if its samples fit in an existing
+    // hole; two or more always net at least one area, even into a new one.
+    if (victims.size() == 1) {
+        const size_t hole = supersonic_heap_largest_free(&areas[victims[0]].base, 1);
+        if (areas[victims[0]].inUse > hole) victims.clear();
+    }
+    if (victims.empty()) return report;
+
+    std::vector<void*> victimBases;
+    std::vector<SnapshotEntry> moves;
+    for (int v : victims) {
+        victimBases.push_back(areas[v].base);
+        for (size_t i = 0; i < samples.size(); ++i)
+            if (areaOf[i] == v) moves.push_back(samples[i]);
+    }
+    // Largest first packs the destination holes best.
+    std::sort(moves.begin(), moves.end(),
+              [](const SnapshotEntry& x, const SnapshotEntry& y) { return x.samples > y.samples; });
+
+    for (const auto& m : moves) {
+        if (compactionInterrupted()) break;
+        const size_t bytes = static_cast<size_t>(m.samples) * sizeof(float);
+        auto* to = static_cast<float*>(
+            supersonic_heap_alloc_avoiding(bytes, victimBases.data(), victimBases.size()));
+        if (!to) break;
+
+        bool copied = true;
+        const auto* src = reinterpret_cast<const char*>(m.data);
+        auto* dst = reinterpret_cast<char*>(to);
+        for (size_t off = 0; off < bytes; off += kCopySlice) {
+            if (compactionInterrupted()) { copied = false; break; }
+            std::memcpy(dst + off, src + off, std::min(kCopySlice, bytes - off));
+        }
+        if (!copied
+            || !waitFor([&] { drainRetired(report); return mOutstanding < kMaxPending - 1; },
+                        kAudioWaitMs)) {
+            supersonic_heap_free(to);   // still ours: the heap hasn't been reset yet
+            break;
+        }
+
+        int h = mRelocHead.load(std::memory_order_relaxed);
+        mRelocations[h] = { m.bufnum, m.data, to, bytes, mPassGeneration };
+        mRelocHead.store((h + 1) % kMaxPending, std::memory_order_release);
+        ++mOutstanding;
+    }
+
+    waitFor([&] { drainRetired(report); return mOutstanding == 0; }, kAudioWaitMs);
+
+    // Count what actually went back to the system once the hold drops.
+    supersonic_heap_hold_released_areas(false);
+    readAreas();
+    report.ran            = report.buffersMoved > 0;
+    report.bytesReleased  = supersonic_heap_released_bytes() - releasedBefore;
+    report.areasReleased  = areasBefore - growthAreas()
+                          + static_cast<int>(supersonic_heap_growth_count() - grownBefore);
+    report.bytesReclaimed = static_cast<int64_t>(footprintBefore)
+                          - static_cast<int64_t>(supersonic_heap_total_allocated());
+
+    if (report.ran) {
+        debugLog("[SampleLoader] compacted %d buffers (%.1f MB): released %d areas (%.1f MB), footprint %+.1f MB",
+                 report.buffersMoved, report.bytesMoved / 1048576.0,
+                 report.areasReleased, report.bytesReleased / 1048576.0,
+                 -report.bytesReclaimed / 1048576.0);
+    }
+    return report;
+}
+
+SampleLoader::CompactionReport SampleLoader::compactNow(int timeoutMs) {
+    mCompactDone.reset();
+    mCompactRequested.store(true, std::memory_order_release);
+    mWakeUp.signal();
+    if (!mCompactDone.wait(timeoutMs))
+        return {};
+    std::lock_guard<std::mutex> lk(mReportMutex);
+    return mLastReport;
+}
+
+SampleLoader::MemoryReport SampleLoader::memoryReport() const {
+    MemoryReport r;
+    for (const auto& a : heapAreas()) {
+        r.areas++;
+        if (!a.initial) r.growthAreas++;
+        r.reservedBytes   += a.size;
+        r.inUseBytes      += a.inUse;
+    }
+    r.largestFreeBytes = supersonic_heap_largest_free(nullptr, 0);
+    r.freeBytes = r.reservedBytes - r.inUseBytes;
+    if (r.freeBytes > 0)
+        r.fragmentationPermille = static_cast<int>(1000 - r.largestFreeBytes * 1000 / r.freeBytes);
+
+    std::lock_guard<std::mutex> lk(mReportMutex);
+    r.passes        = mTotalPasses;
+    r.buffersMoved  = mTotalMoved;
+    r.bytesReleased = mTotalReleased;
+    return r;
 }
 
 void SampleLoader::writeDoneReply(int bufnum) {
@@ -5,6 +5,18 @@
  * dedicated juce::Thread.  Decoded PCM is queued for installation by the
  * audio thread, which installs the buffer and writes the /done reply to the
  * OUT ring buffer — keeping the OUT ring buffer single-producer (audio thread).
+ *
+ * The same thread compacts sample memory. /b_allocRead + /b_free churn
+ * leaves supersonic_heap growth areas pinned by a few live samples (an
+ * AllocPool area only goes back to the system once it is entirely free). A
+ * compaction pass copies the samples out of sparse growth areas into memory
+ * elsewhere in the pool, and the audio thread swaps each buffer's data
+ * pointer at a block boundary. Then the old copies are freed here, and the
+ * emptied areas are released.
+ *
+ * It also serves SampleResidency: prefetch() decodes a registered sample
+ * ahead of use and installs it without a /done, and eviction requests chosen
+ * here come back through the audio thread, which frees the idle buffers.
  */
 #pragma once
 
@@ -13,8 +25,12 @@
 #include <atomic>
 #include <array>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 struct World;
+class SampleResidency;
 
 class SampleLoader : public juce::Thread {
 public:
@@ -28,11 +44,23 @@ public:
     bool load(World* world, int bufnum, const char* path,
               int startFrame, int numFrames);
 
+    // Same queue, for SampleResidency (audio thread): installs silently and
+    // reports to the residency instead of replying.
+    bool prefetch(World* world, int bufnum, const char* path,
+                  int startFrame, int numFrames);
+    // Set before startThread().
+    void setResidency(SampleResidency* residency) { mResidency = residency; }
+
     // Called from the AUDIO THREAD to install completed loads and write
     // /done (or /fail) replies to the OUT ring buffer.  This mirrors the
     // WASM architecture where /b_allocPtr is processed on the audio thread.
     void installPendingBuffers();
 
+    // Loads waiting for installPendingBuffers(). Any thread.
+    bool hasCompletedLoads() const {
+        return mCompHead.load(std::memory_order_acquire) != mCompTail.load(std::memory_order_relaxed);
+    }
+
     void run() override;
 
     // Wake the I/O thread (used during shutdown to unblock WaitableEvent)
@@ -42,6 +70,43 @@ public:
     void pauseLoading();
     void resumeLoading();
 
+    // ── Sample-memory compaction ────────────────────────────────────────
+    struct CompactionReport {
+        bool     ran            = false;  // a pass moved buffers (false: nothing to do,
+                                          // timed out, or interrupted by a cold swap)
+        int      buffersMoved   = 0;
+        uint64_t bytesMoved     = 0;
+        int      areasReleased  = 0;
+        uint64_t bytesReleased  = 0;      // growth areas returned to the system
+        int64_t  bytesReclaimed = 0;      // net drop in heap footprint (released
+                                          // minus any growth the pass needed)
+    };
+    struct MemoryReport {
+        int      areas                 = 0;
+        int      growthAreas           = 0;
+        uint64_t reservedBytes         = 0;  // all pool areas
+        uint64_t inUseBytes            = 0;
+        uint64_t freeBytes             = 0;
+        uint64_t largestFreeBytes      = 0;
+        int      fragmentationPermille = 0;  // 1000 * (1 - largestFree / free)
+        int      passes                = 0;  // cumulative since boot
+        uint64_t buffersMoved          = 0;
+        uint64_t bytesReleased         = 0;
+    };
+
+    // Control thread: run a pass on the loader thread now and wait for it.
+    CompactionReport compactNow(int timeoutMs = 5000);
+    // Any thread: heap footprint and fragmentation, plus compaction totals.
+    MemoryReport memoryReport() const;
+    // Periodic passes (every kCompactCheckMs) when a growth area is at most
+    // half full. Set before startThread().
+    void setAutoCompaction(bool enabled) { mAutoCompact = enabled; }
+    // Decode plain PCM WAV/AIFF/AIFC with PcmFile instead of libsndfile
+    // (identical samples, no intermediate copies). Set before startThread().
+    void setFastPcmDecode(bool enabled) { mFastPcm = enabled; }
+
+    static constexpr int kCompactCheckMs = 5000;
+
     // SampleLoader runs off the audio thread; the engine wires this sink to
     // OscEgress::debug so its diagnostics ride the locked NRT-out ring. Set
     // before startThread().
@@ -62,6 +127,7 @@ private:
         int         startFrame = 0;
         int         numFrames  = 0;
         uint32_t    generation = 0;
+        bool        resident   = false;  // a SampleResidency prefetch
     };
 
     static constexpr int kMaxPending = 64;
@@ -79,21 +145,88 @@ private:
         int      sampleRate  = 0;
         bool     success     = false;
         uint32_t generation  = 0;
+        bool     resident    = false;
     };
 
     std::array<CompletedLoad, kMaxPending> mCompleted;
     std::atomic<int> mCompHead{0};
     std::atomic<int> mCompTail{0};
 
+    bool enqueueRequest(World* world, int bufnum, const char* path,
+                        int startFrame, int numFrames, bool resident);
     void processRequest(const Request& req);
     void enqueueCompleted(CompletedLoad&& load);
-    void installBuffer(const CompletedLoad& load);
+    bool installBuffer(const CompletedLoad& load);
     void writeDoneReply(int bufnum);
     void writeFailReply(int bufnum, const char* cmdName);
 
     juce::WaitableEvent mWakeUp;
     std::atomic<bool> mLoadingPaused{false};
     std::atomic<uint32_t> mGeneration{0};
+
+    // ── Residency ───────────────────────────────────────────────────────
+    // Loader thread -> audio thread: idle registered buffers to free.
+    struct Eviction { int bufnum; uint32_t generation; };
+    std::array<Eviction, kMaxPending> mEvictions;
+    std::atomic<int> mEvictHead{0};
+    std::atomic<int> mEvictTail{0};
+    SampleResidency* mResidency = nullptr;
+    void requestEvictions(uint64_t incoming, uint32_t generation);   // loader thread
+    void applyEvictions(World* world, uint32_t currentGen);          // audio thread
+
+    // ── Compaction ──────────────────────────────────────────────────────
+    // The audio thread owns the loaded table: per bufnum, the data pointer
+    // this loader installed and the buffer's update count right after, so a
+    // pass only ever moves sample data (never a /b_alloc buffer that units
+    // record into, even one that reuses the address). Sized once, on the I/O
+    // thread, from the first World it sees; published through mLoadedArray.
+    struct LoadedSlot { float* data; int writes; };
+    std::unique_ptr<LoadedSlot[]> mLoadedStorage;
+    std::atomic<LoadedSlot*>     mLoadedArray{nullptr};
+    int                          mLoadedCount = 0;
+    uint32_t                     mLoadedGeneration = 0;  // audio thread
+    void ensureLoadedTable(World* world);
+
+    // Snapshot of the live sample buffers, taken by the audio thread on
+    // request (mSnapshotState Requested -> Ready) so the pass never reads
+    // World state from this thread.
+    struct SnapshotEntry { int bufnum; float* data; int samples; };
+    std::unique_ptr<SnapshotEntry[]> mSnapshot;
+    int                              mSnapshotCount = 0;
+    enum : int { kSnapIdle, kSnapRequested, kSnapReady };
+    std::atomic<int>                 mSnapshotState{kSnapIdle};
+
+    // Loader thread -> audio thread: swap bufnum's data from -> to.
+    struct Relocation { int bufnum; float* from; float* to; size_t bytes; uint32_t generation; };
+    std::array<Relocation, kMaxPending> mRelocations;
+    std::atomic<int> mRelocHead{0};
+    std::atomic<int> mRelocTail{0};
+    // Audio thread -> loader thread: the copy to free (the old data once
+    // swapped, the new copy if the buffer changed meanwhile).
+    struct Retired { float* ptr; bool moved; size_t bytes; uint32_t generation; };
+    std::array<Retired, kMaxPending> mRetired;
+    std::atomic<int> mRetHead{0};
+    std::atomic<int> mRetTail{0};
+
+    void applyRelocations(World* world, uint32_t currentGen);   // audio thread
+    void serviceSnapshot(World* world);                          // audio thread
+    int  drainRetired(CompactionReport& report);                 // loader thread
+    bool waitFor(const std::function<bool()>& done, int timeoutMs);
+    CompactionReport runCompaction();                            // loader thread
+    bool compactionInterrupted() const;
+    int                  mOutstanding = 0;       // relocations not yet retired
+    uint32_t             mPassGeneration = 0;
+
+    bool                 mAutoCompact = false;
+    bool                 mFastPcm = true;
+    std::atomic<bool>    mCompactRequested{false};
+    std::atomic<bool>    mCompacting{false};
+    juce::WaitableEvent  mCompactDone;
+    mutable std::mutex   mReportMutex;
+    CompactionReport     mLastReport;
+    int                  mTotalPasses = 0;
+    uint64_t             mTotalMoved = 0;
+    uint64_t             mTotalReleased = 0;
 };
 
 // Global hook called by meth_b_allocRead in SC_MiscCmds.cpp.
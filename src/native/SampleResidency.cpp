@@ -0,0 +1,498 @@
+/*
+ * SampleResidency.cpp — Lazily resident samples, prefetched from the schedule
+ *
+ * The scan is a byte walk over bundles and /s_new (no oscpack on the audio
+ * thread): it returns at the first byte that rules a packet out, looks the
+ * synthdef up as /s_new itself does, and only reads the clock once a
+ * registered bufnum turns up.
+ */
+#include "SampleResidency.h"
+#include "SampleLoader.h"
+#include "WallClock.h"
+#include "synth/server/SC_GraphDef.h"
+#include "synth/server/SC_Prototypes.h"
+#include "SC_Graph.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+    extern World* g_world;
+}
+
+namespace {
+
+// Bundles nest; anything deeper than this is not worth scanning.
+constexpr int kMaxBundleDepth = 4;
+
+int64_t nowTimetag() {
+    return supersonic::ntpToOscTimetag(wallClockNTP());
+}
+
+uint32_t readBE32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+           (uint32_t(p[2]) << 8)  |  uint32_t(p[3]);
+}
+
+// Bytes of an OSC string at p, NUL and padding included; 0 if unterminated.
+uint32_t paddedStringSize(const uint8_t* p, const uint8_t* end) {
+    const uint8_t* q = p;
+    while (q < end && *q) ++q;
+    if (q == end) return 0;
+    return static_cast<uint32_t>(((q - p) + 4) & ~3);
+}
+
+// Home entry of a node ID in a power-of-two table.
+size_t holdHome(int32_t id, size_t mask) {
+    return (static_cast<uint32_t>(id) * 0x9E3779B1u) & mask;
+}
+
+// A float control value that holds a bufnum.
+bool bufnumValue(float f, int& out) {
+    if (!(f >= 0.0f && f < 2147483648.0f)) return false;
+    out = static_cast<int>(f);
+    return static_cast<float>(out) == f;
+}
+
+// An OSC argument that holds a bufnum: an int, or a float holding one.
+bool bufnumValue(char tag, const uint8_t* p, int& out) {
+    const uint32_t bits = readBE32(p);
+    if (tag == 'i') { out = static_cast<int32_t>(bits); return true; }
+    if (tag == 'f') {
+        float f; std::memcpy(&f, &bits, 4);
+        return bufnumValue(f, out);
+    }
+    return false;
+}
+
+// An OSC string as a name-table key: word-aligned and zero-padded, cut at
+// the table's name length as the server's own lookups are.
+void nameKey(const uint8_t* p, const uint8_t* end, int32 (&key)[kSCNameLen]) {
+    std::memset(key, 0, sizeof(key));
+    const size_t n = std::min<size_t>(strnlen(reinterpret_cast<const char*>(p), end - p),
+                                      kSCNameByteLen - 1);
+    std::memcpy(key, p, n);
+}
+
+} // namespace
+
+SampleResidency::SampleResidency() {
+    mScan.admit = &SampleResidency::admitScan;
+    mScan.due   = &SampleResidency::dueScan;
+    mScan.ctx   = this;
+    mWatch.fn   = &SampleResidency::nodeWatch;
+    mWatch.ctx  = this;
+}
+
+void SampleResidency::initialise(int numBuffers, SampleLoader* loader) {
+    mLoader   = loader;
+    mNumSlots = numBuffers > 0 ? numBuffers : 0;
+    mSlots.reset(mNumSlots ? new Slot[mNumSlots] : nullptr);
+    mSlotSources.assign(static_cast<size_t>(mNumSlots), 0);
+    mHolds.reset(new NodeHold[kNodeTableSize]());
+}
+
+void SampleResidency::setBudget(uint64_t bytes, int idleMs) {
+    mBudgetBytes.store(bytes, std::memory_order_relaxed);
+    const int64_t ms = idleMs > 0 ? idleMs : 0;
+    mIdleGrace.store((ms << 32) / 1000, std::memory_order_relaxed);
+}
+
+void SampleResidency::install() {
+    if (!mSlots) return;
+    get_scheduler().setScan(&mScan);
+    Node_SetWatch(&mWatch);
+}
+
+void SampleResidency::uninstall() {
+    if (get_scheduler().scan() == &mScan) get_scheduler().setScan(nullptr);
+    Node_SetWatch(nullptr);
+}
+
+// ── Control thread ──────────────────────────────────────────────────────────
+
+bool SampleResidency::registerBuffer(int bufnum, const std::string& path,
+                                     int startFrame, int numFrames) {
+    if (bufnum < 0 || bufnum >= mNumSlots || path.empty()) return false;
+    const Source* source = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(mSourcesMutex);
+        for (const auto& s : mSources)
+            if (s->path == path && s->startFrame == startFrame && s->numFrames == numFrames) {
+                source = s.get();
+                break;
+            }
+        if (!source) {
+            if (mSlotSources[bufnum] >= kMaxSourcesPerSlot) return false;
+            ++mSlotSources[bufnum];
+            mSources.push_back(std::make_unique<Source>(Source{path, startFrame, numFrames}));
+            source = mSources.back().get();
+        }
+    }
+    if (!mSlots[bufnum].source.exchange(source, std::memory_order_acq_rel))
+        mRegistered.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool SampleResidency::unregisterBuffer(int bufnum) {
+    if (bufnum < 0 || bufnum >= mNumSlots) return false;
+    Slot& slot = mSlots[bufnum];
+    if (!slot.source.exchange(nullptr, std::memory_order_acq_rel)) return false;
+    mRegistered.fetch_sub(1, std::memory_order_relaxed);
+    // A resident copy stays in the World, just no longer counted or evicted.
+    freed(bufnum);
+    return true;
+}
+
+void SampleResidency::freed(int bufnum) {
+    if (bufnum < 0 || bufnum >= mNumSlots) return;
+    Slot& slot = mSlots[bufnum];
+    int st = slot.state.load(std::memory_order_acquire);
+    while ((st == kResident || st == kEvicting)
+           && !slot.state.compare_exchange_weak(st, kCold, std::memory_order_acq_rel)) {}
+    if (st == kResident || st == kEvicting)
+        mResidentBytes.fetch_sub(slot.bytes.exchange(0, std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+}
+
+void SampleResidency::resetResidency() {
+    for (int b = 0; b < mNumSlots; ++b) {
+        Slot& slot = mSlots[b];
+        slot.state.store(kCold, std::memory_order_relaxed);
+        slot.bytes.store(0, std::memory_order_relaxed);
+        slot.needUntil.store(0, std::memory_order_relaxed);
+        slot.lastUse.store(0, std::memory_order_relaxed);
+        slot.duration.store(0, std::memory_order_relaxed);
+    }
+    mResidentBytes.store(0, std::memory_order_release);
+    // The old World's synths are gone; the audio thread drops their holds.
+    mHoldsEpoch.fetch_add(1, std::memory_order_release);
+}
+
+SampleResidency::Stats SampleResidency::stats() const {
+    Stats s;
+    s.registered    = mRegistered.load(std::memory_order_relaxed);
+    for (int b = 0; b < mNumSlots; ++b) {
+        const int st = mSlots[b].state.load(std::memory_order_relaxed);
+        if (st == kResident || st == kEvicting) ++s.resident;
+    }
+    s.residentBytes = mResidentBytes.load(std::memory_order_relaxed);
+    s.budgetBytes   = mBudgetBytes.load(std::memory_order_relaxed);
+    s.prefetches    = mPrefetches.load(std::memory_order_relaxed);
+    s.prefetchHits  = mHits.load(std::memory_order_relaxed);
+    s.lateLoads     = mLate.load(std::memory_order_relaxed);
+    s.evictions     = mEvictions.load(std::memory_order_relaxed);
+    return s;
+}
+
+// ── Loader thread ───────────────────────────────────────────────────────────
+
+// Held while a live synth names it, and through the idle grace or the
+// sample's own duration after its last start, whichever is longer: that
+// covers the gap before a queued /s_new starts its synth, and synths the
+// node table had no room for.
+bool SampleResidency::idle(const Slot& slot, int64_t now) const {
+    const int64_t hold = std::max(mIdleGrace.load(std::memory_order_relaxed),
+                                  slot.duration.load(std::memory_order_relaxed));
+    return slot.live.load(std::memory_order_acquire) == 0
+        && slot.needUntil.load(std::memory_order_relaxed) < now
+        && slot.lastUse.load(std::memory_order_relaxed) < now - hold;
+}
+
+int SampleResidency::makeRoom(uint64_t incoming, int* victims, int maxVictims) {
+    const uint64_t budget = mBudgetBytes.load(std::memory_order_relaxed);
+    if (budget == 0 || !mSlots) return 0;
+    const uint64_t resident = mResidentBytes.load(std::memory_order_acquire);
+    if (resident + incoming <= budget) return 0;
+    const uint64_t need = resident + incoming - budget;
+
+    const int64_t now = nowTimetag();
+    uint64_t found = 0;
+    int count = 0;
+    while (found < need && count < maxVictims) {
+        int best = -1;
+        int64_t bestUse = 0;
+        for (int b = 0; b < mNumSlots; ++b) {
+            const Slot& slot = mSlots[b];
+            if (slot.state.load(std::memory_order_relaxed) != kResident
+                || !slot.source.load(std::memory_order_relaxed) || !idle(slot, now))
+                continue;
+            const int64_t use = slot.lastUse.load(std::memory_order_relaxed);
+            if (best < 0 || use < bestUse) { best = b; bestUse = use; }
+        }
+        if (best < 0) break;
+        // Claim it; the audio thread evicts or hands it back.
+        int expected = kResident;
+        if (!mSlots[best].state.compare_exchange_strong(expected, kEvicting,
+                                                        std::memory_order_acq_rel))
+            continue;
+        victims[count++] = best;
+        found += mSlots[best].bytes.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+// ── Audio thread ────────────────────────────────────────────────────────────
+
+void SampleResidency::installed(int bufnum, uint64_t bytes, double seconds) {
+    if (bufnum < 0 || bufnum >= mNumSlots) return;
+    Slot& slot = mSlots[bufnum];
+    int expected = kLoading;
+    // Unregistered meanwhile (or reset by a cold swap): an ordinary buffer now.
+    if (!slot.source.load(std::memory_order_acquire)
+        || !slot.state.compare_exchange_strong(expected, kResident, std::memory_order_acq_rel)) {
+        if (expected == kLoading) slot.state.store(kCold, std::memory_order_release);
+        return;
+    }
+    slot.bytes.store(bytes, std::memory_order_relaxed);
+    slot.duration.store(static_cast<int64_t>(seconds * 4294967296.0), std::memory_order_relaxed);
+    mResidentBytes.fetch_add(bytes, std::memory_order_release);
+}
+
+void SampleResidency::loadFailed(int bufnum) {
+    if (bufnum < 0 || bufnum >= mNumSlots) return;
+    int expected = kLoading;
+    mSlots[bufnum].state.compare_exchange_strong(expected, kCold, std::memory_order_acq_rel);
+}
+
+bool SampleResidency::evictable(int bufnum) const {
+    if (bufnum < 0 || bufnum >= mNumSlots) return false;
+    const Slot& slot = mSlots[bufnum];
+    return slot.state.load(std::memory_order_acquire) == kEvicting
+        && slot.source.load(std::memory_order_relaxed)
+        && idle(slot, nowTimetag());
+}
+
+void SampleResidency::evicted(int bufnum) {
+    if (bufnum < 0 || bufnum >= mNumSlots) return;
+    Slot& slot = mSlots[bufnum];
+    int expected = kEvicting;
+    if (!slot.state.compare_exchange_strong(expected, kCold, std::memory_order_acq_rel)) return;
+    mResidentBytes.fetch_sub(slot.bytes.exchange(0, std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    mEvictions.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SampleResidency::keep(int bufnum) {
+    if (bufnum < 0 || bufnum >= mNumSlots) return;
+    int expected = kEvicting;
+    mSlots[bufnum].state.compare_exchange_strong(expected, kResident, std::memory_order_acq_rel);
+}
+
+void SampleResidency::nodeWatch(void* ctx, Graph* graph, int state) {
+    auto* self = static_cast<SampleResidency*>(ctx);
+    const uint32_t epoch = self->mHoldsEpoch.load(std::memory_order_acquire);
+    if (epoch != self->mHoldsSeen) {
+        self->mHoldsSeen = epoch;
+        self->clearHolds();
+    }
+    if (state == kNode_Go) self->nodeStarted(graph);
+    else                   self->nodeEnded(graph->mNode.mID);
+}
+
+void SampleResidency::nodeStarted(Graph* graph) {
+    if (mRegistered.load(std::memory_order_relaxed) == 0) return;
+    const GraphDef* def = GRAPHDEF(graph);
+    if (def->mNumBufferControls == 0) return;
+
+    // The registered buffers its buffer controls name, as it starts.
+    NodeHold hold{graph->mNode.mID, 0, {}};
+    for (uint32_t k = 0; k < def->mNumBufferControls && hold.count < kMaxNodeBuffers; ++k) {
+        const int32 index = def->mBufferControls[k];
+        int bufnum;
+        if (index < 0 || static_cast<uint32>(index) >= graph->mNumControls
+            || !bufnumValue(graph->mControls[index], bufnum)
+            || bufnum >= mNumSlots || !mSlots[bufnum].source.load(std::memory_order_relaxed)
+            || std::find(hold.buffers, hold.buffers + hold.count, bufnum) != hold.buffers + hold.count)
+            continue;
+        hold.buffers[hold.count++] = bufnum;
+    }
+    if (hold.count == 0) return;
+
+    const size_t mask = kNodeTableSize - 1;
+    for (size_t i = holdHome(hold.id, mask), n = 0; n < kNodeTableSize; i = (i + 1) & mask, ++n) {
+        if (mHolds[i].count != 0) continue;
+        mHolds[i] = hold;
+        for (int b = 0; b < hold.count; ++b)
+            mSlots[hold.buffers[b]].live.fetch_add(1, std::memory_order_acq_rel);
+        return;
+    }
+    // Table full: the time hold alone covers this one.
+}
+
+void SampleResidency::nodeEnded(int32_t id) {
+    const size_t mask = kNodeTableSize - 1;
+    size_t i = holdHome(id, mask);
+    for (size_t n = 0; mHolds[i].count != 0 && mHolds[i].id != id; i = (i + 1) & mask)
+        if (++n == kNodeTableSize) return;
+    if (mHolds[i].count == 0) return;   // held nothing
+
+    for (int b = 0; b < mHolds[i].count; ++b)
+        mSlots[mHolds[i].buffers[b]].live.fetch_sub(1, std::memory_order_acq_rel);
+
+    // Backward-shift delete: pull later entries of the probe run into the
+    // gap, so lookups never stop short at it.
+    mHolds[i].count = 0;
+    for (size_t j = (i + 1) & mask; mHolds[j].count != 0; j = (j + 1) & mask) {
+        const size_t home = holdHome(mHolds[j].id, mask);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            mHolds[i] = mHolds[j];
+            mHolds[j].count = 0;
+            i = j;
+        }
+    }
+}
+
+void SampleResidency::clearHolds() {
+    for (size_t i = 0; i < kNodeTableSize; ++i) mHolds[i].count = 0;
+    for (int b = 0; b < mNumSlots; ++b) mSlots[b].live.store(0, std::memory_order_relaxed);
+}
+
+void SampleResidency::admitScan(void* ctx, const uint8_t* osc, uint32_t len, int64_t when) {
+    auto* self = static_cast<SampleResidency*>(ctx);
+    if (self->mRegistered.load(std::memory_order_relaxed) == 0) return;
+    self->scanPacket(osc, len, when, false, 0);
+}
+
+void SampleResidency::dueScan(void* ctx, const uint8_t* osc, uint32_t len, int64_t when) {
+    auto* self = static_cast<SampleResidency*>(ctx);
+    if (self->mRegistered.load(std::memory_order_relaxed) == 0) return;
+    self->scanPacket(osc, len, when, true, 0);
+}
+
+void SampleResidency::scanPacket(const uint8_t* osc, uint32_t len, int64_t when,
+                                 bool due, int depth) {
+    const uint8_t* end = osc + len;
+
+    if (len >= 16 && std::memcmp(osc, "#bundle", 8) == 0) {
+        if (depth >= kMaxBundleDepth) return;
+        const uint8_t* p = osc + 16;
+        while (end - p >= 4) {
+            const uint32_t n = readBE32(p);
+            p += 4;
+            if (n > static_cast<uint32_t>(end - p)) return;
+            scanPacket(p, n, when, due, depth + 1);
+            p += n;
+        }
+        return;
+    }
+
+    // "/s_new" + NUL pads to 8; the type tags follow.
+    if (len < 12 || std::memcmp(osc, "/s_new", 7) != 0 || osc[8] != ',') return;
+    scanSynth(osc, end, when, due);
+}
+
+void SampleResidency::scanSynth(const uint8_t* osc, const uint8_t* end, int64_t when, bool due) {
+    const uint8_t* tags = osc + 8;
+    const uint32_t tagBytes = paddedStringSize(tags, end);
+    if (!tagBytes || tags[1] != 's') return;
+    const uint8_t* arg = tags + tagBytes;
+
+    // The synthdef says which controls name a played buffer.
+    const uint32_t defBytes = paddedStringSize(arg, end);
+    if (!defBytes || !g_world) return;
+    int32 key[kSCNameLen];
+    nameKey(arg, end, key);
+    const GraphDef* def = World_GetGraphDef(g_world, key);
+    if (!def || def->mNumBufferControls == 0) return;
+    const int32* bufControls = def->mBufferControls;
+    const uint32_t numBufControls = def->mNumBufferControls;
+    auto bufControl = [&](int32 index) -> int {
+        const int32* p = std::lower_bound(bufControls, bufControls + numBufControls, index);
+        return p != bufControls + numBufControls && *p == index ? static_cast<int>(p - bufControls) : -1;
+    };
+
+    // nodeID, addAction, target, then (control, value) pairs. A control is
+    // a name or an index; the value an int or a float.
+    uint64_t set = 0;   // buffer controls the message sets (the first 64)
+    int index = 0;
+    int control = -1;   // the pending pair's buffer control, or -1
+    arg += defBytes;
+    for (const uint8_t* t = tags + 2; *t; ++t, ++index) {
+        const char tag = static_cast<char>(*t);
+        uint32_t size;
+        switch (tag) {
+            case 'i': case 'f': case 'c': case 'r': case 'm': size = 4; break;
+            case 'h': case 'd': case 't':                    size = 8; break;
+            case 's': case 'S':
+                size = paddedStringSize(arg, end);
+                if (!size) return;
+                break;
+            case 'b':
+                if (end - arg < 4) return;
+                size = 4 + ((readBE32(arg) + 3) & ~3u);
+                break;
+            case 'T': case 'F': case 'N': case 'I':          size = 0; break;
+            default: return;   // arrays and the exotic: not worth a guess
+        }
+        if (size > static_cast<uint32_t>(end - arg)) return;
+
+        if (index >= 3) {
+            if ((index - 3) % 2 == 0) {
+                control = -1;
+                if (tag == 's' || tag == 'S') {
+                    if (def->mParamSpecTable) {
+                        nameKey(arg, end, key);
+                        if (const ParamSpec* spec = def->mParamSpecTable->Get(key))
+                            control = bufControl(spec->mIndex);
+                    }
+                } else if (tag == 'i') {
+                    control = bufControl(static_cast<int32_t>(readBE32(arg)));
+                }
+            } else if (control >= 0) {
+                int bufnum;
+                if (bufnumValue(tag, arg, bufnum)) reference(bufnum, when, due);
+                if (control < 64) set |= uint64_t(1) << control;
+            }
+        }
+        arg += size;
+    }
+
+    // The rest play their defaults.
+    for (uint32_t k = 0; k < numBufControls && k < 64; ++k) {
+        int bufnum;
+        if (!(set & (uint64_t(1) << k))
+            && bufnumValue(def->mInitialControlValues[bufControls[k]], bufnum))
+            reference(bufnum, when, due);
+    }
+}
+
+void SampleResidency::reference(int bufnum, int64_t when, bool due) {
+    if (bufnum < 0 || bufnum >= mNumSlots) return;
+    Slot& slot = mSlots[bufnum];
+    if (!slot.source.load(std::memory_order_acquire)) return;
+
+    if (!due) {
+        // Queued ahead: keep it from eviction until then, and load it now.
+        int64_t need = slot.needUntil.load(std::memory_order_relaxed);
+        while (when > need && !slot.needUntil.compare_exchange_weak(need, when,
+                                                                    std::memory_order_relaxed)) {}
+        if (slot.state.load(std::memory_order_acquire) == kCold && startLoad(bufnum))
+            mPrefetches.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    slot.lastUse.store(when ? when : nowTimetag(), std::memory_order_relaxed);
+    const int st = slot.state.load(std::memory_order_acquire);
+    if (st == kResident || st == kEvicting) {
+        mHits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        mLate.fetch_add(1, std::memory_order_relaxed);
+        if (st == kCold) startLoad(bufnum);
+    }
+}
+
+bool SampleResidency::startLoad(int bufnum) {
+    Slot& slot = mSlots[bufnum];
+    int expected = kCold;
+    if (!mLoader || !g_world
+        || !slot.state.compare_exchange_strong(expected, kLoading, std::memory_order_acq_rel))
+        return false;
+    const Source* source = slot.source.load(std::memory_order_acquire);
+    if (!source || !mLoader->prefetch(g_world, bufnum, source->path.c_str(),
+                                      source->startFrame, source->numFrames)) {
+        slot.state.store(kCold, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,165 @@
+/*
+ * SampleResidency.h — Lazily resident samples, prefetched from the schedule
+ *
+ * A buffer registered by path (/supersonic/buffers/register) stays empty until
+ * something is about to play it. The scan rides the EngineScheduler: when a
+ * bundle carrying /s_new is queued, the synthdef's buffer controls (those
+ * wired into a PlayBuf, BufRd, ... buffer input; GraphDef::mBufferControls)
+ * are read from the message, or their defaults, and any registered bufnum
+ * among them is decoded on the SampleLoader thread right away, a lookahead
+ * ahead of its timetag, and installed without a /done. When the /s_new
+ * dispatches, a resident buffer counts as a prefetch hit; a missing one is a
+ * late load (loaded from then on).
+ *
+ * Resident bytes are held under a budget. Before a decode would exceed it,
+ * the loader thread picks victims in least-recently-used order among idle
+ * buffers: nothing queued needs them, no live synth holds them, and none was
+ * started within the idle grace or its own duration, whichever is longer.
+ * A synth holds the buffers its buffer controls name when it starts
+ * (kNode_Go, through Node_SetWatch) until it ends, so a looping or slowed
+ * PlayBuf keeps its sample however long it plays; /n_set on a buffer control
+ * is not followed. The audio thread frees victims between blocks, re-checking
+ * first.
+ *
+ * Threads: register/unregister/freed on the control thread; the scan, the
+ * node watch and installed/evicted on the audio thread; makeRoom on the
+ * loader thread. Slots are plain atomics, and registration records are never
+ * freed before the destructor, so the audio thread never reads one that is
+ * gone. That makes them a bounded set: re-registering a source already on
+ * record reuses it, and a buffer slot that has made kMaxSourcesPerSlot
+ * records of its own cannot register a new source.
+ */
+#pragma once
+
+#include "src/scheduler/EngineScheduler.h"
+#include "synth/server/SC_Prototypes.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class SampleLoader;
+
+class SampleResidency {
+public:
+    SampleResidency();
+
+    // Size the registry (the World's buffer count). Call before install().
+    void initialise(int numBuffers, SampleLoader* loader);
+    // Byte budget for resident registered samples (0 = unbounded) and how
+    // long after its last use a buffer still counts as busy.
+    void setBudget(uint64_t bytes, int idleMs);
+    // Install / remove the scan on the process-wide scheduler, and the
+    // node watch.
+    void install();
+    void uninstall();
+
+    // ── Control thread ──────────────────────────────────────────────────
+    // Registering a bufnum again replaces its source (a resident copy stays
+    // until evicted or freed). False if bufnum is out of range or the record
+    // cap is reached.
+    bool registerBuffer(int bufnum, const std::string& path, int startFrame, int numFrames);
+    // Stop managing bufnum. Its contents, if any, stay as an ordinary buffer.
+    bool unregisterBuffer(int bufnum);
+    // /b_free reached a buffer (any thread): a registered one goes cold.
+    void freed(int bufnum);
+    // After a cold swap: the new World holds none of the samples.
+    // Registrations stay, so each reloads on its next reference.
+    void resetResidency();
+
+    struct Stats {
+        int      registered    = 0;
+        int      resident      = 0;
+        uint64_t residentBytes = 0;
+        uint64_t budgetBytes   = 0;
+        uint32_t prefetches    = 0;  // decodes started ahead of the timetag
+        uint32_t prefetchHits  = 0;  // /s_new found its buffer resident
+        uint32_t lateLoads     = 0;  // /s_new found its buffer missing
+        uint32_t evictions     = 0;
+    };
+    Stats stats() const;
+
+    // ── Loader thread ───────────────────────────────────────────────────
+    // Choose idle victims, least recently used first, so `incoming` more
+    // bytes fit the budget. Writes up to maxVictims bufnums; returns the
+    // count. Best effort: loads still go ahead when nothing is idle.
+    int makeRoom(uint64_t incoming, int* victims, int maxVictims);
+
+    // ── Audio thread ────────────────────────────────────────────────────
+    void installed(int bufnum, uint64_t bytes, double seconds);
+    void loadFailed(int bufnum);
+    // True if bufnum is still claimed for eviction and still idle; then
+    // evicted() once freed, or keep() to hand it back.
+    bool evictable(int bufnum) const;
+    void evicted(int bufnum);
+    void keep(int bufnum);
+
+private:
+    struct Source {
+        std::string path;
+        int         startFrame;
+        int         numFrames;
+    };
+    // Distinct registration records each buffer slot may make.
+    static constexpr size_t kMaxSourcesPerSlot = 4;
+    // Live synths tracked at once, and buffers counted per synth; past
+    // either, a synth holds its buffers by the time hold alone.
+    static constexpr size_t kNodeTableSize = 4096;   // a power of two
+    static constexpr int    kMaxNodeBuffers = 4;
+
+    enum : int { kCold, kLoading, kResident, kEvicting };
+    struct Slot {
+        std::atomic<const Source*> source{nullptr};   // null = not registered
+        std::atomic<int>           state{kCold};
+        std::atomic<int64_t>       needUntil{0};      // latest queued timetag
+        std::atomic<int64_t>       lastUse{0};        // timetag of the last play
+        std::atomic<int64_t>       duration{0};       // play time at rate 1, OSC
+                                                      // timetag units (while resident)
+        std::atomic<uint64_t>      bytes{0};          // while resident
+        std::atomic<int>           live{0};           // synths holding it
+    };
+    // A live synth and the buffers its kNode_Go counted (audio thread).
+    struct NodeHold {
+        int32_t id;
+        int32_t count;                                // 0 = empty entry
+        int32_t buffers[kMaxNodeBuffers];
+    };
+
+    static void admitScan(void* ctx, const uint8_t* osc, uint32_t len, int64_t when);
+    static void dueScan(void* ctx, const uint8_t* osc, uint32_t len, int64_t when);
+    void scanPacket(const uint8_t* osc, uint32_t len, int64_t when, bool due, int depth);
+    void scanSynth(const uint8_t* osc, const uint8_t* end, int64_t when, bool due);
+    void reference(int bufnum, int64_t when, bool due);
+    bool startLoad(int bufnum);
+    bool idle(const Slot& slot, int64_t now) const;
+    static void nodeWatch(void* ctx, struct Graph* graph, int state);
+    void nodeStarted(struct Graph* graph);
+    void nodeEnded(int32_t id);
+    void clearHolds();
+
+    std::unique_ptr<Slot[]> mSlots;
+    int                     mNumSlots = 0;
+    SampleLoader*           mLoader = nullptr;
+    EngineScheduler::Scan   mScan;
+    NodeWatch               mWatch;
+
+    std::unique_ptr<NodeHold[]> mHolds;                   // audio thread, by node ID
+    std::atomic<uint32_t>       mHoldsEpoch{0};           // bumped by resetResidency
+    uint32_t                    mHoldsSeen = 0;           // audio thread
+
+    std::mutex                           mSourcesMutex;   // control thread
+    std::vector<std::unique_ptr<Source>> mSources;        // every record ever made
+    std::vector<uint8_t>                 mSlotSources;    // records made, per slot
+
+    std::atomic<int>      mRegistered{0};
+    std::atomic<uint64_t> mBudgetBytes{0};
+    std::atomic<int64_t>  mIdleGrace{0};                  // OSC timetag units
+    std::atomic<uint64_t> mResidentBytes{0};
+    std::atomic<uint32_t> mPrefetches{0};
+    std::atomic<uint32_t> mHits{0};
+    std::atomic<uint32_t> mLate{0};
+    std::atomic<uint32_t> mEvictions{0};
+};
@@ -6,7 +6,8 @@
  *
  * ShmTransport.h — the SHM command-plane transport: replies and notify pushes
  * for the segment's one trusted peer (shm_peer_plane.h), written into the
- * plane's reply ring. The counterpart of the gateway's command-ring drain.
+ * plane's reply ring. The counterpart of the audio thread's command-ring
+ * drain (the direct peer lane, peer_lane_attach).
  *
  * Single-producer by construction: the NRT gateway is the sole IOscTransport
  * caller, so the reply ring needs no shared lock — the writer-serialisation
@@ -16,7 +17,7 @@
  * The host never blocks on peer state: a full reply ring (slow or dead peer)
  * drops the packet and counts it in the plane's rep_dropped. Token semantics
  * mirror the socket transports — send() resolves only SHM_PEER_ORIGIN_TOKEN
- * (the token the gateway drain stamps on every peer command); anything else
+ * (the token the command-ring drain stamps on every peer command); anything else
  * is undeliverable here. The subscriber audiences collapse to booleans: there
  * is exactly one possible subscriber.
  *
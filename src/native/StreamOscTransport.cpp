@@ -54,6 +54,8 @@ bool StreamOscTransport::start() {
         fprintf(stderr, "[osc] stream transport started without an endpoint\n");
         break;
     }
+    if (mServer)
+        ss_osc_stream_set_egress(mServer, mEgressBytes, static_cast<uint32_t>(mEgressOverflow));
     return mServer != nullptr;
 }
 
@@ -65,6 +67,23 @@ int StreamOscTransport::boundPort() const {
     return mServer ? ss_osc_stream_port(mServer) : 0;
 }
 
+int64_t StreamOscTransport::queueDepth(uint32_t token) const {
+    return mServer ? ss_osc_stream_queue_depth(mServer, token) : -1;
+}
+
+// Watchdog thread: the leaf's snapshot is safe from any thread. Saturated to
+// the u32 native-stats slots it is published into.
+IOscTransport::EgressStats StreamOscTransport::egressStats() const {
+    EgressStats out;
+    SsOscStreamEgressStats st{};
+    if (!mServer || !ss_osc_stream_egress_stats(mServer, &st)) return out;
+    auto sat = [](uint64_t v) { return static_cast<uint32_t>(std::min<uint64_t>(v, UINT32_MAX)); };
+    out.maxQueueBytes  = sat(st.max_queue_bytes);
+    out.droppedFrames  = sat(st.dropped_frames);
+    out.overflowCloses = sat(st.overflow_closes);
+    return out;
+}
+
 // Rust reader thread → ingest carrying the connection id as the origin token.
 void StreamOscTransport::onPacket(void* ctx, uint32_t conn, const uint8_t* osc, uint32_t len) {
     auto* self = static_cast<StreamOscTransport*>(ctx);
@@ -96,7 +115,8 @@ void StreamOscTransport::broadcast(const std::vector<uint32_t>& list,
                                    const uint8_t* data, uint32_t size) {
     if (!mServer) return;
     // Copy the audience out so a send never runs under the audience lock (a
-    // reader thread pruning via onClosed must not wait on a slow write).
+    // reader thread pruning via onClosed must not wait on the leaf). Each send
+    // only enqueues on that connection's egress queue.
     std::vector<uint32_t> targets;
     {
         std::lock_guard<std::mutex> lk(mMutex);
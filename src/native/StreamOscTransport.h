@@ -18,6 +18,11 @@
  * The NRT gateway is the sole caller of the IOscTransport methods, but
  * on_closed fires on a reader thread — one mutex covers the audience lists
  * for that cross-thread prune.
+ *
+ * Sends only enqueue: each TCP/UDS connection owns a bounded egress queue
+ * drained by its own writer thread in the Rust leaf, so a stalled client
+ * backs up its own queue rather than the gateway. setEgressQueue picks the
+ * queue size and what a full queue does (drop oldest / disconnect).
  */
 #pragma once
 
@@ -40,6 +45,17 @@ public:
     void setIngest(IngestFn fn) { mIngest = std::move(fn); }
     void setMaxConnections(uint32_t n) { mMaxConns = n; }
 
+    enum class EgressOverflow : uint32_t {
+        DropOldest = SS_OSC_EGRESS_DROP_OLDEST,
+        Disconnect = SS_OSC_EGRESS_DISCONNECT,
+    };
+    // Per-connection egress queue bytes (0 = the leaf's 1 MiB default) and
+    // overflow policy. Set before start().
+    void setEgressQueue(uint32_t bytes, EgressOverflow overflow) {
+        mEgressBytes = bytes;
+        mEgressOverflow = overflow;
+    }
+
     // Pick exactly one endpoint before start().
     void initialiseTcp(int port, const std::string& bindAddress);
     void initialiseUds(const std::string& path);   // unix only
@@ -52,6 +68,9 @@ public:
     // starts); 0 for path/name-addressed servers.
     int boundPort() const;
 
+    // Bytes queued for one connection, or -1 if it is unknown/closed.
+    int64_t queueDepth(uint32_t token) const;
+
     // ── IOscTransport ──────────────────────────────────────────────────────────
     bool send(uint32_t token, const uint8_t* data, uint32_t size, bool networkOnly) override;
     void broadcastNotify(const uint8_t* data, uint32_t size) override;
@@ -72,6 +91,7 @@ public:
     void broadcastOsc(const uint8_t* data, uint32_t size) override;
     bool subscribeOsc(uint32_t token) override;
     void unsubscribeOsc(uint32_t token) override;
+    EgressStats egressStats() const override;
 
 private:
     enum class Kind { None, Tcp, Uds, Pipe };
@@ -88,6 +108,8 @@ private:
     std::string  mBindAddress;          // Tcp
     std::string  mEndpoint;             // Uds path / pipe name
     uint32_t     mMaxConns = 4;
+    uint32_t     mEgressBytes = 0;
+    EgressOverflow mEgressOverflow = EgressOverflow::Disconnect;
     SsOscStream* mServer = nullptr;
     IngestFn     mIngest;
 
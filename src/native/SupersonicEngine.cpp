@@ -11,6 +11,9 @@
 #include "src/lanes/lanes.h"
 #include "audio_config.h"
 #include "src/shared_memory.h"
+#include "src/metrics_shards.h"
+#include "src/usdt.h"
+#include "src/supersonic_heap.h"
 #include "src/osc_debug.h"
 #include "src/clock_math.h"
 #include "osc/OscReceivedElements.h"
@@ -38,6 +41,12 @@ extern "C" {
     // Publishes NRT control-thread blocking into the native-stats region
     // (SC_World.cpp). Called from the watchdog poll.
     void World_PublishNrtBlocking(uint32_t maxPassMs, uint32_t inFlightMs);
+    // Publishes the command transport's egress queue state (SC_World.cpp).
+    void World_PublishEgress(uint32_t maxQueueBytes, uint32_t dropped,
+                             uint32_t overflowCloses);
+    // Publishes sample residency counters (SC_World.cpp).
+    void World_PublishResidency(uint32_t prefetchHits, uint32_t lateLoads,
+                                uint32_t evictions, uint32_t residentKiB);
 
     // Global used by init_memory() to pass external shared memory to World_New.
     // Declared extern "C" because init_memory() references it from an extern "C" block.
@@ -57,6 +66,9 @@ extern "C" {
 
     void destroy_world();
     void rebuild_world(double sample_rate);
+
+    const char* world_grow(const WorldLimits* want, uint32_t timeout_ms, WorldResizeReport* report);
+    bool world_limits(WorldLimits* current, WorldLimits* ceiling);
 }
 
 namespace {
@@ -411,6 +423,8 @@ void SupersonicEngine::init(const Config& cfg) {
     setEngineState(EngineState::Booting, "init");
 
     mHeadless = cfg.headless;
+    mPrecodeIngress = cfg.precodeIngress;
+    setLatencyTrace(cfg.latencyTrace);
     mSuperClock.setFreewheelClock(cfg.freewheelClock);
     mCurrentConfig = cfg;
     // mBootInputChannels may be kAutoChannelCount (-1) here — resolved to a
@@ -995,10 +1009,17 @@ void SupersonicEngine::init(const Config& cfg) {
     // resolves the same base from g_external_segment, so both agree.
     uint8_t* arena = g_external_segment ? g_external_segment : ring_buffer_storage;
 
-    // Use actual device sample rate and channel counts (may differ from requested)
+    // Use actual device sample rate and channel counts (may differ from
+    // requested) — unless the World's rate is pinned, in which case the audio
+    // callback / headless driver resample between the two.
+    mAudioCallback.setInternalSampleRate(cfg.internalSampleRate);
+    mWorldSampleRate = worldRateFor(mCurrentConfig.sampleRate);
+    if (mWorldSampleRate != mCurrentConfig.sampleRate)
+        ssLifecycleLog("[supersonic] World pinned at %d Hz (device %d Hz)\n",
+                       mWorldSampleRate, mCurrentConfig.sampleRate);
     mAudioCallback.initialiseWorld(
         arena,
-        mCurrentConfig.sampleRate,
+        mWorldSampleRate,
         mCurrentConfig.numOutputChannels,
         mCurrentConfig.numInputChannels,
         cfg.numBuffers,
@@ -1038,12 +1059,14 @@ void SupersonicEngine::init(const Config& cfg) {
     if (mShmemCreator)
         mShmemCreator->publish();
 
-    // Publish the peer command plane only when enabled: the gateway task below
-    // drains its command ring and ShmTransport sends through this slot.
-    // Disabled (or no segment) ⇒ the slot stays null and both sides are inert.
+    // Publish the peer command plane only when enabled: process_audio drains
+    // its command ring as a second IN lane and ShmTransport sends through this
+    // slot. Disabled (or no segment) ⇒ the slot stays null and both sides are
+    // inert.
     if (cfg.shmCommands) {
         if (mShmemCreator) {
             mPeerPlane.store(mShmemCreator->get_peer_plane(), std::memory_order_release);
+            peer_lane_attach(mPeerPlane.load(std::memory_order_relaxed));
         } else {
             fprintf(stderr, "[supersonic] WARNING: shmCommands requested but there is "
                             "no SHM segment (udpPort == 0) — command plane disabled\n");
@@ -1056,12 +1079,18 @@ void SupersonicEngine::init(const Config& cfg) {
     uint8_t* base = arena;
     ControlPointers*    ctrl = reinterpret_cast<ControlPointers*>(base + CONTROL_START);
     mMetrics                 = reinterpret_cast<PerformanceMetrics*>(base + METRICS_START);
+    // Transport threads count ingest into per-thread shards (metrics_shards.h);
+    // the gateway folds them into mMetrics once per pass.
+    ss_counter_shards(mMetrics, true);
 
     // -- NRT gateway: drain #1 = the RT egress lane (OUT ring), via the lanes
     //    ABI — the gateway is its single consumer; the drain state, route
     //    peeling and metrics live in lanes.cpp. Woken every audio block via
     //    processCount. (Drain #2 = the control ring, added with the NRT plane
     //    below.)
+    //    Each egress drain ends with a transport flush: a batching transport
+    //    (UDP) sends everything the drain dispatched in one go, and nothing
+    //    sits queued while the control drain runs.
     mNrtGateway.setWake(&mAudioCallback.processCount);
     mNrtGateway.addTask([this]() {
         ss_egress_rt_drain(
@@ -1071,39 +1100,8 @@ void SupersonicEngine::init(const Config& cfg) {
                     token, route, osc, len);
             },
             this, 0 /* drain everything available */);
-    });
-
-    // -- NRT gateway: peer command plane (SHM segment; shm_peer_plane.h) -----
-    // One trusted external peer writes OSC frames into the plane's SPSC
-    // command ring; this task feeds them into the ordinary ingest path (IN
-    // ring → audio-thread classify → control forward), stamped with the
-    // reserved SHM-peer origin token — identity is assigned here, never
-    // trusted from shared memory. Registered before the control-ring drain so
-    // a forwarded control command is handled the same wake. Bounded per wake
-    // so a flooding peer cannot starve the other drains (the remainder drains
-    // next block); a full IN ring Retains the frame — lossless backpressure
-    // through to the peer's own ring-full signal. Inert while mPeerPlane is
-    // null (shmCommands off).
-    mNrtGateway.addTask([this]() {
-        auto* plane = mPeerPlane.load(std::memory_order_acquire);
-        if (!plane) return;
-        constexpr uint32_t kPeerDrainMaxFrames = 256;
-        ss_drain_ring(
-            shm_peer_cmd_ring(plane), SHM_PEER_CMD_RING_SIZE,
-            &plane->cmd_head, &plane->cmd_tail, mPeerDrainState,
-            SsDrainMetrics{ nullptr, nullptr,
-                            mMetrics ? &mMetrics->osc_in_corrupted : nullptr,
-                            nullptr },
-            kPeerDrainMaxFrames,
-            [this](uint32_t /*frameSrc*/, const uint8_t* d, uint32_t n, uint32_t) {
-                if (!ss_ingress_write(d, n, SHM_PEER_ORIGIN_TOKEN))
-                    return SsDrainVerdict::Retain;   // IN ring full — retry next wake
-                if (mMetrics) {
-                    mMetrics->osc_out_messages_sent.fetch_add(1, std::memory_order_relaxed);
-                    mMetrics->osc_out_bytes_sent.fetch_add(n, std::memory_order_relaxed);
-                }
-                return SsDrainVerdict::Consume;
-            });
+        mEgress.flush();
+        ss_counter_publish(mMetrics);
     });
 
     // -- Audio-plane ingress (engine-owned) ---------------------------------
@@ -1141,11 +1139,12 @@ void SupersonicEngine::init(const Config& cfg) {
     mIngress.registerRoute("/supersonic/", &SupersonicEngine::nrtForwardSink, this);
     mIngress.registerRoute("/clock/", &SupersonicEngine::nrtForwardSink, this);
     mControlIngress.registerRoute("/supersonic/", &SupersonicEngine::routeTo<EngineControl, &EngineControl::handleSupersonicCommand>, &mEngineControl);
+    mMidiMap.setSink([this](const uint8_t* data, uint32_t size) { ingest(data, size, 0); });
 #ifdef SUPERSONIC_MIDI
     // The clock-out coordinator is a process-wide singleton; a fresh engine owns
     // no clock-out ports, so clear any left by a prior engine in this process.
     get_midi_clock_out().reset();
-    mMidiControl.init(&mEgress, &mSuperClock);
+    mMidiControl.init(&mEgress, &mSuperClock, &mMidiMap);
     mIngress.registerRoute("/midi/", &SupersonicEngine::nrtForwardSink, this);
     mControlIngress.registerRoute("/midi/", &SupersonicEngine::routeTo<MidiControl, &MidiControl::handleMidiCommand>, &mMidiControl);
 #endif
@@ -1234,6 +1233,14 @@ void SupersonicEngine::init(const Config& cfg) {
                     token, route, osc, len);
             },
             this, 0 /* drain everything available */);
+        mEgress.flush();
+    });
+
+    // Heap maintenance check, once per pass: two relaxed loads while the heap
+    // is healthy (see wakeHeapMaintenance).
+    mNrtGateway.addTask([this]() {
+        if (supersonic_heap_needs_maintenance())
+            wakeHeapMaintenance();
     });
 
     // Test hook: close the device before the source decision so
@@ -1255,6 +1262,15 @@ void SupersonicEngine::init(const Config& cfg) {
     mSampleLoader.initialise();
     // Off-thread loader diagnostics ride the NRT-out egress ring.
     mSampleLoader.setDebugSink([this](const char* t, uint32_t n) { mEgress.debug(t, n); });
+    mSampleLoader.setAutoCompaction(cfg.bufferCompaction);
+    mSampleLoader.setFastPcmDecode(cfg.fastSampleDecode);
+    // Registered samples load on demand: the scheduler scan prefetches them
+    // for queued /s_new, under a byte budget.
+    mSampleResidency.initialise(cfg.numBuffers, &mSampleLoader);
+    mSampleResidency.setBudget(static_cast<uint64_t>(std::max(0, cfg.sampleResidencyMB)) << 20,
+                               cfg.sampleIdleMs);
+    mSampleLoader.setResidency(&mSampleResidency);
+    mSampleResidency.install();
     mAudioCallback.setSampleLoader(&mSampleLoader);
     mAudioCallback.setSuperClock(&mSuperClock);
     mAudioCallback.onWake = [this]() { purge(); };
@@ -1368,6 +1384,16 @@ void SupersonicEngine::init(const Config& cfg) {
         mWatchdogStop.store(false);
         mWatchdogThread = std::thread(&SupersonicEngine::watchdogLoop, this);
     }
+
+    // Heap headroom (see heapHeadroomLoop). Manual-pump mode too: the caller's
+    // process_audio thread is marked RT all the same.
+    supersonic_heap_set_headroom(static_cast<size_t>(std::max(0, mCurrentConfig.heapHeadroomMB)) << 20);
+    if (mCurrentConfig.heapHeadroomMB > 0) {
+        mHeapHeadroomStop.store(false);
+        mHeapHeadroomWake = false;
+        mHeapHeadroomThread = std::thread(&SupersonicEngine::heapHeadroomLoop, this);
+        mHeapHeadroomRunning.store(true, std::memory_order_release);
+    }
 }
 
 void SupersonicEngine::shutdown() {
@@ -1404,6 +1430,7 @@ void SupersonicEngine::shutdown() {
     // joins. Late notifications the subsystems emit after this point sit
     // undrained in the NRT-out ring — acceptable, the consumer is going away.
     mNrtGateway.stop();
+    ss_counter_shards(mMetrics, false);
 
     // Tear down the MIDI subsystem before mEgress/mSuperClock: ss_midi_destroy
     // closes its midir connections (stopping midir's input thread), so no MIDI
@@ -1454,6 +1481,17 @@ void SupersonicEngine::shutdown() {
     if (mWatchdogThread.joinable()) mWatchdogThread.join();
     if (mReopenThread.joinable())   mReopenThread.join();
 
+    // The heap outlives the engine (process-wide); leave it with no headroom
+    // to keep. Areas still queued are freed when the World's heap goes.
+    mHeapHeadroomRunning.store(false);
+    {
+        std::lock_guard<std::mutex> lk(mHeapHeadroomMutex);
+        mHeapHeadroomStop.store(true);
+    }
+    mHeapHeadroomCv.notify_one();
+    if (mHeapHeadroomThread.joinable()) mHeapHeadroomThread.join();
+    supersonic_heap_set_headroom(0);
+
     // No control command can run now — join the device-orchestration worker
     // before tearing down the device manager + egress it calls into.
     mDebounceSwitchStop.store(true);
@@ -1496,6 +1534,7 @@ void SupersonicEngine::shutdown() {
 
     mHeadlessDriver.stopThread(2000);
     mSampleLoader.stopThread(2000);
+    mSampleResidency.uninstall();
 
     // Unpublish from /superclock_get only if we're the current
     // publisher — never stomp another engine's pointer.
@@ -1528,6 +1567,7 @@ void SupersonicEngine::shutdown() {
     // the SuperClock sample-clock binding — a late pumpAudioBlock must
     // publish into nothing rather than the unmapped segment.
     mSuperClock.bindSampleClockToShm(nullptr);
+    peer_lane_attach(nullptr);
     mPeerPlane.store(nullptr, std::memory_order_release);
     g_external_shared_memory = nullptr;
     g_external_segment = nullptr;
@@ -1552,14 +1592,14 @@ void SupersonicEngine::pumpAudioBlock() {
     // HeadlessDriver — picks up rendering from a clean time base.
     if (!mManualPumpStarted) {
         mManualSamplePos = 0.0;
-        mSuperClock.resetAudioThreadTime(mManualSamplePos, mCurrentConfig.sampleRate);
+        mSuperClock.resetAudioThreadTime(mManualSamplePos, mWorldSampleRate);
         mManualPumpStarted = true;
     }
 
     mSampleLoader.installPendingBuffers();
 
     const double   ntp        = mSuperClock.updateAudioThreadNTP(
-                                    mManualSamplePos, mCurrentConfig.sampleRate);
+                                    mManualSamplePos, mWorldSampleRate);
     const uint64_t hostMicros = static_cast<uint64_t>(
                                     std::max<int64_t>(0, mSuperClock.linkClockMicros()));
 
@@ -1574,11 +1614,11 @@ void SupersonicEngine::pumpAudioBlock() {
     // Sample clock: the manual pump renders with no live device (idle /
     // device-loss), so "audible" == render time (latency 0).
     mSuperClock.publishSampleClock(mManualSamplePos,
-                                   static_cast<double>(mCurrentConfig.sampleRate),
+                                   static_cast<double>(mWorldSampleRate),
                                    ntp, 0);
 
     renderAudioBlock(mSuperClock, blockSize, nOut, nIn,
-                     static_cast<uint32_t>(mCurrentConfig.sampleRate), ntp, hostMicros);
+                     static_cast<uint32_t>(mWorldSampleRate), ntp, hostMicros);
     mManualSamplePos += blockSize;
 
     mAudioCallback.processCount.fetch_add(1, std::memory_order_release);
@@ -1598,26 +1638,83 @@ void SupersonicEngine::noteInFlightCommand(const uint8_t* data, uint32_t size) {
     mInFlightCommand[i] = '\0';
 }
 
+void SupersonicEngine::setLatencyTrace(bool on) {
+    // Process-wide, like the lanes it stamps; init applies Config::latencyTrace
+    // so a trace left on by a previous engine in this process doesn't leak in.
+    ss_latency_trace(on);
+}
+
+SupersonicEngine::WorldGrowResult SupersonicEngine::growWorld(const WorldLimits& want) {
+    // A block or two at any sane rate; long enough to ride out a device that
+    // is briefly between callbacks.
+    constexpr uint32_t kApplyTimeoutMs = 2000;
+    WorldGrowResult result;
+    // A cold swap would destroy the World under the resize.
+    std::unique_lock<std::recursive_mutex> lk;
+    if (!tryAcquireSwapGate(lk, 20, 50)) {
+        result.error = "device busy — another swap in progress";
+        return result;
+    }
+    if (const char* err = world_grow(&want, kApplyTimeoutMs, &result.report)) {
+        result.error = err;
+        return result;
+    }
+    result.success = true;
+
+    const WorldLimits& now = result.report.mLimits;
+    uint32_t* opts = reinterpret_cast<uint32_t*>(sp_arena() + WORLD_OPTIONS_START);
+    opts[sonicpi::WorldOpts::kMaxNodes]              = now.mMaxNodes;
+    opts[sonicpi::WorldOpts::kNumBuffers]            = now.mNumBuffers;
+    opts[sonicpi::WorldOpts::kNumAudioBusChannels]   = now.mNumAudioBusChannels;
+    opts[sonicpi::WorldOpts::kNumControlBusChannels] = now.mNumControlBusChannels;
+    opts[sonicpi::WorldOpts::kMaxWireBufs]           = now.mMaxWireBufs;
+    opts[sonicpi::WorldOpts::kRealTimeMemorySize]    = now.mRealTimeMemoryKB;
+    mCurrentConfig.maxNodes              = static_cast<int>(now.mMaxNodes);
+    mCurrentConfig.numBuffers            = static_cast<int>(now.mNumBuffers);
+    mCurrentConfig.numAudioBusChannels   = static_cast<int>(now.mNumAudioBusChannels);
+    mCurrentConfig.numControlBusChannels = static_cast<int>(now.mNumControlBusChannels);
+    mCurrentConfig.maxWireBufs           = static_cast<int>(now.mMaxWireBufs);
+    mCurrentConfig.realTimeMemorySize    = static_cast<int>(now.mRealTimeMemoryKB);
+    return result;
+}
+
+bool SupersonicEngine::worldLimits(WorldLimits& current, WorldLimits& ceiling) {
+    std::unique_lock<std::recursive_mutex> lk;
+    if (!tryAcquireSwapGate(lk, 20, 50)) return false;
+    return world_limits(&current, &ceiling);
+}
+
 void SupersonicEngine::ingest(const uint8_t* data, uint32_t size, uint32_t originToken) {
     // Dumb transport: write the bytes onto the ingress lane (the IN ring) with
     // the opaque origin token in the Message header. The audio thread drains,
     // classifies (OscIngress), and either performs the audio plane inline or
     // forwards control to the NRT thread — which resolves the token back to a
     // reply address via the transport. Token 0 (in-process / embedder) replies
-    // via onReply.
-    bool written = ss_ingress_write(data, size, originToken);
+    // via onReply. Hot synth commands are pre-decoded here, on the sender's
+    // thread, unless Config::precodeIngress is off.
+    bool written = mPrecodeIngress
+        ? ss_ingress_write_precoded(data, size, originToken)
+        : ss_ingress_write(data, size, originToken);
+    SS_PROBE3(transport_recv, size, originToken, written);
+    // Counted into this thread's shard, not the shared metrics line the
+    // audio thread writes every block (metrics_shards.h).
     if (mMetrics) {
         if (written) {
-            mMetrics->osc_out_messages_sent.fetch_add(1, std::memory_order_relaxed);
-            mMetrics->osc_out_bytes_sent.fetch_add(size, std::memory_order_relaxed);
+            ss_count(mMetrics, kSsCountOscOutMessages);
+            ss_count(mMetrics, kSsCountOscOutBytes, size);
         } else {
             // Backpressure / oversize frame: the message is gone — count it
             // as a drop, never as sent.
-            mMetrics->messages_dropped.fetch_add(1, std::memory_order_relaxed);
+            ss_count(mMetrics, kSsCountMessagesDropped);
         }
     }
 }
 
+const PerformanceMetrics& SupersonicEngine::getMetrics() const {
+    ss_counter_publish(mMetrics);
+    return *mMetrics;
+}
+
 // --- Audio-thread control route: forward /clock + /supersonic to the NRT ring -
 // Runs on the audio thread (the OscIngress default-less route). Writes the raw
 // control message to the process-local NRT command ring with the origin token in
@@ -1794,6 +1891,43 @@ std::unique_lock<std::recursive_mutex> SupersonicEngine::testHoldSwapGate() {
     return std::unique_lock<std::recursive_mutex>(mSwapMutex);
 }
 
+// Heap headroom. The audio thread may neither grow the heap nor give an emptied
+// growth area back to the system (supersonic_heap.h), so this thread does both
+// for it. The audio thread can't wake it (that would be a system call), but
+// the NRT gateway already runs once per block and checks the watermark for it
+// (wakeHeapMaintenance); a block is far quicker than the headroom can drain.
+// The timed wait is only a backstop for a gateway that isn't being woken.
+void SupersonicEngine::heapHeadroomLoop() {
+    constexpr auto kBackstop = std::chrono::seconds(1);
+    std::unique_lock<std::mutex> lk(mHeapHeadroomMutex);
+    while (!mHeapHeadroomStop.load()) {
+        mHeapHeadroomCv.wait_for(lk, kBackstop,
+                                 [this] { return mHeapHeadroomWake || mHeapHeadroomStop.load(); });
+        mHeapHeadroomWake = false;
+        if (mHeapHeadroomStop.load()) break;
+        lk.unlock();
+        if (supersonic_heap_needs_maintenance())
+            supersonic_heap_maintain();
+        lk.lock();
+    }
+}
+
+// NRT gateway: the heap is below its headroom or holds areas the audio thread
+// emptied. With a headroom thread, hand it the work. Without one (headroom 0)
+// there is nothing to top up, only queued areas to release, which the gateway
+// does itself.
+void SupersonicEngine::wakeHeapMaintenance() {
+    if (mHeapHeadroomRunning.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lk(mHeapHeadroomMutex);
+            mHeapHeadroomWake = true;
+        }
+        mHeapHeadroomCv.notify_one();
+    } else if (supersonic_heap_headroom() == 0) {
+        supersonic_heap_maintain();
+    }
+}
+
 // Callback-starvation watchdog. The audio callback is the sole drain for
 // synth commands (process_audio consumes the IN ring), so a device whose
 // callback thread wedges — e.g. DirectSound spinning in its cursor poll
@@ -1842,6 +1976,15 @@ void SupersonicEngine::watchdogLoop() {
         // Publish control-thread blocking from here, off the gateway: a gateway
         // stuck in a handler cannot report its own stall.
         World_PublishNrtBlocking(nrtMaxPassMs(), nrtInFlightMs());
+        if (mTransport) {
+            const auto eg = mTransport->egressStats();
+            World_PublishEgress(eg.maxQueueBytes, eg.droppedFrames, eg.overflowCloses);
+        }
+        {
+            const auto rs = mSampleResidency.stats();
+            World_PublishResidency(rs.prefetchHits, rs.lateLoads, rs.evictions,
+                                   static_cast<uint32_t>((rs.residentBytes + 1023) / 1024));
+        }
 
         // Waiting for an audio device (no device open, not a headless / manual-
         // pump build). Keep trying to open one so the engine self-heals the
@@ -1912,7 +2055,9 @@ void SupersonicEngine::watchdogLoop() {
             // false skew).
             if (rateCheck && ph == sonicpi::audio::LivenessPhase::Live
                 && !mAudioCallback.isPaused()) {
-                const int nominal = mAudioCallback.nominalSampleRate();
+                // Engine frames advance at the World's rate, which differs
+                // from the device's nominal rate while resampling.
+                const int nominal = mAudioCallback.engineSampleRate();
                 rateSkew.observe(mSuperClock.engineFrames(),
                                  static_cast<double>(nominal) / 1000.0, t);
                 if (rateSkew.skewed()) {
@@ -2577,6 +2722,7 @@ bool SupersonicEngine::interceptBufferFreed(const uint8_t* data, uint32_t size)
 
         if (ptr) zfree(reinterpret_cast<void*>(ptr));
         mStateCache.uncacheBuffer(bufnum);
+        mSampleResidency.freed(bufnum);
         return true;
     } catch (...) {
         return false;
@@ -3061,6 +3207,14 @@ CurrentDeviceInfo SupersonicEngine::currentDevice() const {
 //
 // See the contract on the enum/helpers in SupersonicEngine.h.
 
+int SupersonicEngine::worldRateFor(double deviceRate) const {
+    const int internal = mCurrentConfig.internalSampleRate;
+    const int device   = static_cast<int>(deviceRate);
+    if (internal > 0 && supersonic::RateConverter::supports(internal, device))
+        return internal;
+    return device;
+}
+
 SupersonicEngine::AudioSource SupersonicEngine::desiredAudioSource() const {
     if (mDeviceManager && mDeviceManager->getCurrentAudioDevice())
         return AudioSource::RealCallback;
@@ -3129,8 +3283,10 @@ void SupersonicEngine::startAudioSource() {
                                    mCurrentConfig.sampleRate,
                                    mCurrentConfig.bufferSize,
                                    mCurrentConfig.numOutputChannels,
-                                   mCurrentConfig.numInputChannels);
+                                   mCurrentConfig.numInputChannels,
+                                   mWorldSampleRate);
         mHeadlessDriver.setSuperClock(&mSuperClock);
+        mHeadlessDriver.setIdleSleepMs(mCurrentConfig.idleSleepMs);
         mHeadlessDriver.startThread(juce::Thread::Priority::highest);
         mActiveSource.store(AudioSource::Headless, std::memory_order_release);
     } else {
@@ -3631,8 +3787,11 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
     // Cross-driver swaps need a cold swap: the new AudioIODeviceType
     // may report different rate / channel-count / buffer-size ranges,
     // so the World must be rebuilt against the new device's specs.
+    // A rate change with the World pinned (Config::internalSampleRate) is
+    // hot: the World keeps its rate and the callback resamples to the device.
     bool isCold = forceCold || forceColdForChannels || crossDriver
-                || (sampleRate > 0 && sampleRate != currentRate);
+                || (sampleRate > 0 && sampleRate != currentRate
+                    && rateChangeNeedsRebuild(sampleRate));
     result.type = isCold ? SwapType::Cold : SwapType::Hot;
 
     if (isCold) setEngineState(EngineState::Restarting, "rate-change");
@@ -4034,7 +4193,7 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
     }
 
     if (!errStr.empty()) {
-        if (isCold) { rebuild_world(currentRate); mWorldRebuilt = true; }
+        if (isCold) { rebuild_world(mWorldSampleRate); mWorldRebuilt = true; }
         // --- Restart audio (failure path) ---
         if (mDeviceManager) {
             // Restore the previous device setup. A failed setAudioDeviceSetup
@@ -4103,9 +4262,10 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
             newRate = newDev ? newDev->getCurrentSampleRate() : newRate;
         }
         mCurrentConfig.sampleRate = static_cast<int>(newRate);
+        const int worldRate = worldRateFor(newRate);
 
         uint32_t* opts = reinterpret_cast<uint32_t*>(sp_arena() + WORLD_OPTIONS_START);
-        opts[sonicpi::WorldOpts::kSampleRate] = static_cast<uint32_t>(newRate);
+        opts[sonicpi::WorldOpts::kSampleRate] = static_cast<uint32_t>(worldRate);
 
         // Update the world's input/output bus counts to match the new
         // device. rebuild_world() reads these to size the scsynth
@@ -4140,7 +4300,8 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
                 if (!failMsg.empty())
                     throw std::runtime_error(failMsg);
             }
-            rebuild_world(newRate);
+            rebuild_world(worldRate);
+            mWorldSampleRate = worldRate;
             mWorldRebuilt = true;
         } catch (const std::exception& e) {
             fprintf(stderr, "[supersonic] rebuild_world failed: %s — recovering with safe defaults\n",
@@ -4149,12 +4310,14 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
 
             double safeRate = currentRate;
             int safeBuffer = 128;
-            opts[sonicpi::WorldOpts::kSampleRate] = static_cast<uint32_t>(safeRate);
+            const int safeWorldRate = worldRateFor(safeRate);
+            opts[sonicpi::WorldOpts::kSampleRate] = static_cast<uint32_t>(safeWorldRate);
             mCurrentConfig.sampleRate = static_cast<int>(safeRate);
             mCurrentConfig.bufferSize = safeBuffer;
 
             try {
-                rebuild_world(safeRate);
+                rebuild_world(safeWorldRate);
+                mWorldSampleRate = safeWorldRate;
                 mWorldRebuilt = true;
                 recovered = true;
                 result.error = std::string("rebuild failed (") + e.what()
@@ -4170,6 +4333,10 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
                 return result;
             }
         }
+    } else if (!mDeviceManager && sampleRate > 0) {
+        // Headless hot swap at a new rate (World pinned): the simulated
+        // device takes the requested rate when the driver restarts below.
+        mCurrentConfig.sampleRate = static_cast<int>(sampleRate);
     }
 
     // --- Restart audio (success path) ---
@@ -4183,6 +4350,9 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
         // all reinitialisation — reloading synthdefs, clearing sample
         // caches, recreating groups/mixer/scope.  Restoring from the
         // StateCache would create duplicate state and cause distortion.
+        // Registered samples are the exception: they stay registered and
+        // reload lazily into the new World on their next reference.
+        mSampleResidency.resetResidency();
         mSampleLoader.resumeLoading();
     }
 
@@ -4234,7 +4404,7 @@ SwapResult SupersonicEngine::switchDevice(const std::string& rawOutputName,
         }
     } else {
         if (!recovered) {
-            result.sampleRate = isCold ? sampleRate : currentRate;
+            result.sampleRate = (isCold || sampleRate > 0) ? sampleRate : currentRate;
         }
         result.bufferSize = mCurrentConfig.bufferSize;
     }
@@ -5061,7 +5231,17 @@ std::string SupersonicEngine::setDeviceMode(const std::string& mode) {
             // gate itself (try_lock) and would otherwise self-deadlock.
             swapGate.unlock();
 
-            if (newRate > 0 && static_cast<int>(newRate) != mCurrentConfig.sampleRate) {
+            if (newRate > 0 && static_cast<int>(newRate) != mCurrentConfig.sampleRate
+                && !rateChangeNeedsRebuild(newRate)) {
+                // World pinned (Config::internalSampleRate): JUCE already
+                // reopened at newRate and the callback resamples; a hot
+                // switch just brings the engine's view of the device along.
+                fprintf(stderr,
+                        "[device-setup] system default has different rate "
+                        "(%d -> %.0f Hz) — World pinned at %d Hz, hot swap\n",
+                        mCurrentConfig.sampleRate, newRate, mWorldSampleRate);
+                switchDevice(newDevName, newRate, 0, /*forceCold=*/false);
+            } else if (newRate > 0 && static_cast<int>(newRate) != mCurrentConfig.sampleRate) {
                 fprintf(stderr,
                         "[device-setup] system default has different rate "
                         "(%d -> %.0f Hz) — performing cold swap\n",
@@ -30,6 +30,7 @@
 #include "src/IngressCallCtx.h"
 #include "src/shm_peer_plane.h"
 #include "EngineControl.h"
+#include "MidiMap.h"
 #ifdef SUPERSONIC_MIDI
 #include "MidiControl.h"
 #endif
@@ -42,6 +43,7 @@
 #include "src/scheduler/EngineScheduler.h"
 #include "JuceAudioCallback.h"
 #include "SampleLoader.h"
+#include "SampleResidency.h"
 #include "SuperClock.h"
 #include "DeviceInfo.h"
 #include "AudioRecovery.h"
@@ -49,6 +51,7 @@
 #include "OscBuilder.h"
 #include "HeadlessDriver.h"
 #include "src/engine_state.h"
+#include "SC_WorldResize.h"
 #include "synth/common/server_shm.hpp"
 
 class SupersonicEngine : private juce::ChangeListener {
@@ -97,6 +100,33 @@ public:
                                                    // on its own thread. Implies headless.
                                                    // Prevents a second autonomous audio
                                                    // thread racing the manual caller.
+        int    internalSampleRate       = 0;       // pin the World to this rate
+                                                   // (0 = follow the device). A
+                                                   // device at another rate is
+                                                   // fed through a polyphase
+                                                   // resampler, so device rate
+                                                   // changes become hot swaps.
+                                                   // Headless: sampleRate is the
+                                                   // simulated device rate.
+        int    idleSleepMs              = 50;      // headless: with no synths and
+                                                   // nothing due, sleep up to this
+                                                   // long between blocks instead of
+                                                   // waking every block; any
+                                                   // incoming message wakes it
+                                                   // (0 = tick every block)
+        bool   precodeIngress           = true;    // decode hot commands (/s_new,
+                                                   // /n_set, /n_free, /g_new,
+                                                   // /n_map, /c_set) on the
+                                                   // sending thread into binary
+                                                   // command records, so the
+                                                   // audio thread skips the OSC
+                                                   // parse for them
+        bool   latencyTrace             = false;   // histogram how long each
+                                                   // command waits between ingest
+                                                   // and being performed or fired,
+                                                   // per origin, into the arena's
+                                                   // LATENCY_TRACE region (see
+                                                   // setLatencyTrace)
         bool   freewheelClock           = false;   // deterministic sample-derived
                                                    // NTP (no wall-clock drift IIR);
                                                    // for offline/accuracy tests.
@@ -128,9 +158,37 @@ public:
         int    watchdogRateBadWindows   = 2;       // consecutive bad windows =>
                                                    // recovery (one window can be
                                                    // skewed by a transient stall)
+        bool   bufferCompaction         = false;   // background compaction of sample
+                                                   // memory: every few seconds, move
+                                                   // loaded samples out of sparse heap
+                                                   // growth areas so those areas go
+                                                   // back to the system. Off by default:
+                                                   // unit writes into a sample during
+                                                   // its copy are lost. Manual passes
+                                                   // (/supersonic/buffers/compact)
+                                                   // work either way.
+        int    sampleResidencyMB        = 512;     // budget for buffers registered with
+                                                   // /supersonic/buffers/register: idle
+                                                   // ones are evicted, least recently
+                                                   // used first, to stay under it
+                                                   // (0 = unbounded)
+        int    sampleIdleMs             = 10000;   // a registered buffer played within
+                                                   // this long is never evicted
+        int    heapHeadroomMB           = 16;      // free heap kept ahead of demand by
+                                                   // a background thread, so the audio
+                                                   // thread never grows the heap (it
+                                                   // may not: such an allocation fails
+                                                   // and is counted). 0 = no headroom;
+                                                   // areas the audio thread empties are
+                                                   // still released off it
+        bool   fastSampleDecode         = true;    // load plain PCM WAV/AIFF/AIFC
+                                                   // through a mapped, vectorised
+                                                   // reader (PcmFile); other files,
+                                                   // or with this off, all files go
+                                                   // through libsndfile
         bool   shmCommands              = false;   // drain the SHM segment's peer
                                                    // command plane (shm_peer_plane.h)
-                                                   // on the NRT gateway and publish
+                                                   // on the audio thread and publish
                                                    // the plane for ShmTransport.
                                                    // Needs udpPort > 0 (the port
                                                    // names the segment).
@@ -252,7 +310,9 @@ public:
     // Same struct that JS callers see via SuperSonic.getMetrics(). Both
     // runtimes write to it from symmetric paths (audio_processor, OSC
     // reader/writer, debug reader). Pointer is null before init().
-    const PerformanceMetrics& getMetrics() const { return *mMetrics; }
+    // getMetrics() first folds the per-thread ingest counters into the struct
+    // (metrics_shards.h); metricsPtr() readers see them once per audio block.
+    const PerformanceMetrics& getMetrics() const;
     const PerformanceMetrics* metricsPtr() const { return mMetrics; }
 
     // --- Variadic OSC send (builds message + dispatches through sendOSC) ---
@@ -349,6 +409,43 @@ public:
     RecordResult stopRecording();
     bool         isRecording() const;
 
+    // --- Sample-memory compaction (SampleLoader) ---
+    // Run a compaction pass now and wait for it (control thread).
+    SampleLoader::CompactionReport compactBufferMemory() { return mSampleLoader.compactNow(); }
+    // Heap footprint, fragmentation and compaction totals.
+    SampleLoader::MemoryReport     bufferMemoryReport() const { return mSampleLoader.memoryReport(); }
+
+    // --- Lazily resident samples (SampleResidency) ---
+    // Buffers registered by path load when a queued /s_new needs them.
+    SampleResidency&       sampleResidency() { return mSampleResidency; }
+    const SampleResidency& sampleResidency() const { return mSampleResidency; }
+
+    // --- Command latency trace (latency_trace.h) ---
+    // Turn ingest-to-apply latency histograms on or off at runtime; on clears
+    // them. Read them from the arena (LATENCY_TRACE_START) or through
+    // server_shared_memory_client::get_latency_trace().
+    void setLatencyTrace(bool on);
+
+    // --- Runtime World limits (SC_WorldResize.h) ---
+    // Raise nodes, buffers, buses, wire buffers or RT memory without a cold
+    // swap: nodes and buffers survive. A value at or below the current limit
+    // keeps it. Blocks the caller until the audio thread has swapped the new
+    // limits in at a block boundary. The grown limits are written back to the
+    // world options, so a later cold swap rebuilds at them.
+    struct WorldGrowResult {
+        bool success = false;
+        std::string error;
+        WorldResizeReport report;
+    };
+    WorldGrowResult growWorld(const WorldLimits& want);
+    // Current limits and the ceilings they can grow to; false with no World.
+    bool worldLimits(WorldLimits& current, WorldLimits& ceiling);
+
+    // --- In-engine MIDI mapping (MidiMap) ---
+    // /midi/in events matching a "/midi/map/" rule are ingested as scsynth
+    // commands directly (origin 0).
+    MidiMap&               midiMap() { return mMidiMap; }
+
     // Device swap event callback
     std::function<void(const std::string& event, const SwapResult& result)> onSwapEvent;
 
@@ -532,6 +629,18 @@ private:
 
     AudioSource desiredAudioSource() const;
 
+    // The rate the World should run at for a device at `deviceRate`:
+    // Config::internalSampleRate when set and a converter between the two
+    // fits (RateConverter::supports), else the device rate. A device rate
+    // change only needs a World rebuild (cold swap) when this moves off
+    // mWorldSampleRate.
+    int  worldRateFor(double deviceRate) const;
+    bool rateChangeNeedsRebuild(double deviceRate) const {
+        return worldRateFor(deviceRate) != mWorldSampleRate;
+    }
+    // Rate the live World was built at (set at init and on every rebuild).
+    int  mWorldSampleRate = 48000;
+
     // Precondition: mActiveSource == None. Picks RealCallback or Headless
     // based on desiredAudioSource(), then blocks until process_audio has
     // ticked at least once (or 5s with a warning). This blocking wait is
@@ -627,6 +736,7 @@ private:
     char              mInFlightCommand[64] = {0};
     void              noteInFlightCommand(const uint8_t* data, uint32_t size);
     EngineControl     mEngineControl;
+    MidiMap           mMidiMap;
 #ifdef SUPERSONIC_MIDI
     MidiControl       mMidiControl;
 #endif
@@ -638,6 +748,7 @@ private:
 #endif
     SuperClock        mSuperClock;
     SampleLoader      mSampleLoader;
+    SampleResidency   mSampleResidency;
     StateCache        mStateCache;
 
     // Manual-pump state for pumpAudioBlock(): sample position advanced by the
@@ -678,11 +789,10 @@ private:
 
     // Peer command plane (SHM segment; shm_peer_plane.h). init() publishes the
     // segment's plane here when Config::shmCommands is set; shutdown() nulls it
-    // before the segment unmaps. The gateway task drains its command ring into
-    // the ingest path; ShmTransport (bound to this slot via peerPlaneSlot())
+    // before the segment unmaps. process_audio drains its command ring directly
+    // (peer_lane_attach); ShmTransport (bound to this slot via peerPlaneSlot())
     // produces its reply ring. Null ⇒ the plane is inert.
     std::atomic<ShmPeerPlaneHeader*> mPeerPlane{nullptr};
-    SsDrainState                     mPeerDrainState;
 
     // Debounced device switch — rapid clicks settle into one final switch.
     struct PendingSwitch {
@@ -738,6 +848,19 @@ private:
     std::atomic<uint32_t>      mRateSkewRecoveries{0};
     void watchdogLoop();
 
+    // Heap headroom (Config::heapHeadroomMB): tops the heap's free space up
+    // and releases growth areas the audio thread emptied. See
+    // supersonic_heap_maintain. Only started with a headroom configured; the
+    // NRT gateway wakes it (wakeHeapMaintenance).
+    std::thread                mHeapHeadroomThread;
+    std::atomic<bool>          mHeapHeadroomStop{false};
+    std::atomic<bool>          mHeapHeadroomRunning{false};
+    std::mutex                 mHeapHeadroomMutex;
+    std::condition_variable    mHeapHeadroomCv;
+    bool                       mHeapHeadroomWake = false;   // under mHeapHeadroomMutex
+    void heapHeadroomLoop();
+    void wakeHeapMaintenance();
+
     HeadlessDriver               mHeadlessDriver;
     std::unique_ptr<juce::AudioDeviceManager> mDeviceManager;
     PerformanceMetrics*          mMetrics = nullptr;  // points into the shared arena; null before init()
@@ -750,6 +873,8 @@ private:
     // and closes the race fully.
     std::atomic<bool>        mLinkCallbacksAlive{true};
     bool                     mHeadless{false};
+    bool                     mPrecodeIngress{true};   // Config::precodeIngress, fixed at init
+                                                      // (read by every transport thread)
     Config                   mCurrentConfig;
     int                      mBootInputChannels = 2;  // original -i value, for re-enabling inputs
     // Rate held while on a non-wireless device. Remembered so a detour
@@ -1,12 +1,13 @@
 /*
  * UdpOscTransport.cpp — see UdpOscTransport.h. Inbound via ss_osc_ingress (Rust
- * std::net), outbound via ss_osc_send; the token table + subscriber audiences are
- * portable C++. No JUCE.
+ * std::net), outbound via ss_osc_send_batch; the token table + subscriber
+ * audiences are portable C++. No JUCE.
  */
 #include "UdpOscTransport.h"
 
 #include <algorithm>
 #include <cstdio>
+#include <mutex>
 
 namespace {
 // ss_osc_create needs an inbound emit callback for its cue server, which this
@@ -20,12 +21,13 @@ UdpOscTransport::UdpOscTransport() {
 
 UdpOscTransport::~UdpOscTransport() {
     stop();
+    flush();
     if (mOsc) ss_osc_destroy(mOsc);
 }
 
 void UdpOscTransport::start() {
     if (mIngress) return;
-    mIngress = ss_osc_ingress_start_with_src(
+    mIngress = ss_osc_ingress_start_with_addr(
         this, &UdpOscTransport::onDatagram, mPort,
         reinterpret_cast<const uint8_t*>(mBindAddress.data()),
         static_cast<uint32_t>(mBindAddress.size()));
@@ -38,36 +40,55 @@ void UdpOscTransport::stop() {
 }
 
 // Rust recv thread → intern the sender → ingest the packet carrying that token.
-void UdpOscTransport::onDatagram(void* ctx, const uint8_t* ip, uint32_t ip_len,
-                                 int32_t port, const uint8_t* osc, uint32_t len) {
+void UdpOscTransport::onDatagram(void* ctx, const SsOscAddr* src,
+                                 const uint8_t* osc, uint32_t len) {
     auto* self = static_cast<UdpOscTransport*>(ctx);
-    std::string ipStr(reinterpret_cast<const char*>(ip), ip_len);
-    uint32_t token = self->mOrigins.intern(ipStr, port);
+    Target t;
+    t.addr = *src;
+    uint32_t token = self->mOrigins.intern(t);
     if (self->mIngest) self->mIngest(osc, len, token);
 }
 
-void UdpOscTransport::sendTo(const std::string& ip, int port,
-                             const uint8_t* data, uint32_t size) {
-    if (!mOsc || ip.empty() || port <= 0) return;
-    ss_osc_send(mOsc, reinterpret_cast<const uint8_t*>(ip.data()),
-                static_cast<uint32_t>(ip.size()), port, data, size);
+// Queue one datagram; the batch goes out at flush() or when it fills.
+void UdpOscTransport::sendTo(const Target& t, const uint8_t* data, uint32_t size) {
+    if (!mOsc || t.addr.len == 0) return;
+    std::lock_guard<std::mutex> lk(mBatchMutex);
+    const auto offset = static_cast<uint32_t>(mBatchBytes.size());
+    mBatchBytes.insert(mBatchBytes.end(), data, data + size);
+    mBatch.push_back({t.addr, offset, size});
+    if (mBatch.size() >= kBatchDatagrams || mBatchBytes.size() >= kBatchBytes) flushLocked();
 }
 
-// ── IOscTransport: resolve a token / audience → (ip,port) → ss_osc_send ───────
+void UdpOscTransport::flush() {
+    std::lock_guard<std::mutex> lk(mBatchMutex);
+    flushLocked();
+}
+
+void UdpOscTransport::flushLocked() {
+    if (mBatch.empty()) return;
+    mBatchOut.clear();
+    for (const auto& p : mBatch)
+        mBatchOut.push_back({&p.addr, mBatchBytes.data() + p.offset, p.len});
+    if (mOsc)
+        ss_osc_send_batch(mOsc, mBatchOut.data(), static_cast<uint32_t>(mBatchOut.size()));
+    mBatch.clear();
+    mBatchBytes.clear();
+}
+
+// ── IOscTransport: resolve a token / audience → address → send queue ────────
 
 bool UdpOscTransport::send(uint32_t token, const uint8_t* data, uint32_t size,
                            bool /*networkOnly*/) {
     // networkOnly is moot for UDP — there is no in-process observer to skip.
-    std::string ip;
-    int port = 0;
-    if (!mOrigins.resolve(token, ip, port)) return false;
-    sendTo(ip, port, data, size);
+    Target t;
+    if (!mOrigins.resolve(token, t)) return false;
+    sendTo(t, data, size);
     return true;
 }
 
 void UdpOscTransport::broadcast(const std::vector<Target>& list,
                                 const uint8_t* data, uint32_t size) {
-    for (const auto& t : list) sendTo(t.ip, t.port, data, size);
+    for (const auto& t : list) sendTo(t, data, size);
 }
 
 void UdpOscTransport::broadcastNotify(const uint8_t* data, uint32_t size) {
@@ -78,19 +99,23 @@ void UdpOscTransport::broadcastLink(const uint8_t* data, uint32_t size) {
 }
 
 bool UdpOscTransport::subscribeNotify(uint32_t token) {
-    std::string ip;
-    int port = 0;
-    mOrigins.resolve(token, ip, port);
-    return addTarget(mNotifyTargets, ip, port);
+    Target t;
+    mOrigins.resolve(token, t);
+    return addTarget(mNotifyTargets, t);
 }
 void UdpOscTransport::subscribeNotifyPort(int port) {
-    addTarget(mNotifyTargets, "127.0.0.1", port);
+    static const char kLoopback[] = "127.0.0.1";
+    Target t;
+    if (!mOsc || port <= 0 ||
+        !ss_osc_addr_resolve(mOsc, reinterpret_cast<const uint8_t*>(kLoopback),
+                             sizeof(kLoopback) - 1, port, &t.addr))
+        return;
+    addTarget(mNotifyTargets, t);
 }
 void UdpOscTransport::unsubscribeNotify(uint32_t token) {
-    std::string ip;
-    int port = 0;
-    mOrigins.resolve(token, ip, port);
-    removeTarget(mNotifyTargets, ip, port);
+    Target t;
+    mOrigins.resolve(token, t);
+    removeTarget(mNotifyTargets, t);
 }
 void UdpOscTransport::clearNotify() { mNotifyTargets.clear(); }
 
@@ -98,19 +123,15 @@ void UdpOscTransport::clearNotify() { mNotifyTargets.clear(); }
 // caller-relative registration: resolve the origin token, reject an unaddressable
 // caller (in-process, no port), then add/remove the target.
 bool UdpOscTransport::subscribeCallerTo(std::vector<Target>& list, uint32_t token) {
-    std::string ip;
-    int port = 0;
-    mOrigins.resolve(token, ip, port);
-    if (port <= 0) return false;
-    addTarget(list, ip, port);
+    Target t;
+    if (!mOrigins.resolve(token, t)) return false;
+    addTarget(list, t);
     return true;
 }
 void UdpOscTransport::unsubscribeCallerFrom(std::vector<Target>& list, uint32_t token) {
-    std::string ip;
-    int port = 0;
-    mOrigins.resolve(token, ip, port);
-    if (port <= 0) return;
-    removeTarget(list, ip, port);
+    Target t;
+    if (!mOrigins.resolve(token, t)) return;
+    removeTarget(list, t);
 }
 
 bool UdpOscTransport::subscribeLink(uint32_t token) { return subscribeCallerTo(mLinkNotifyTargets, token); }
@@ -127,18 +148,16 @@ void UdpOscTransport::unsubscribeOsc(uint32_t token) { unsubscribeCallerFrom(mOs
 
 // Cap subscriber lists so clients that reconnect on fresh ephemeral ports
 // (restart loops) can't grow them unbounded; evict oldest first.
-bool UdpOscTransport::addTarget(std::vector<Target>& list, const std::string& ip, int port) {
-    if (ip.empty() || port <= 0) return false;
-    for (auto& t : list)
-        if (t.ip == ip && t.port == port) return false;
+bool UdpOscTransport::addTarget(std::vector<Target>& list, const Target& t) {
+    if (t.addr.len == 0) return false;
+    for (auto& x : list)
+        if (x == t) return false;
     constexpr std::size_t kMax = 32;
     if (list.size() >= kMax) list.erase(list.begin());
-    list.push_back({ip, port});
+    list.push_back(t);
     return true;
 }
 
-void UdpOscTransport::removeTarget(std::vector<Target>& list, const std::string& ip, int port) {
-    list.erase(std::remove_if(list.begin(), list.end(),
-                   [&](const Target& t) { return t.ip == ip && t.port == port; }),
-               list.end());
+void UdpOscTransport::removeTarget(std::vector<Target>& list, const Target& t) {
+    list.erase(std::remove(list.begin(), list.end(), t), list.end());
 }
@@ -7,18 +7,27 @@
  * UdpOscTransport.h — the UDP OSC transport, JUCE-free. Inbound datagrams are
  * received by the Rust std::net subsystem (ss_osc) and handed to the ingest
  * callback carrying an interned origin token; outbound replies/broadcasts go back
- * out through ss_osc_send. The token address-book (OriginTable) and the notify
- * subscriber audiences are the transport's portable, dual-licensed address book;
- * only the actual sockets live in the Rust leaf.
+ * out through ss_osc_send_batch. The token address-book (OriginTable) and the
+ * notify subscriber audiences are the transport's portable, dual-licensed
+ * address book; only the actual sockets live in the Rust leaf.
  *
- * The NRT gateway is the sole caller of the IOscTransport methods (one thread);
- * inbound runs on the Rust recv threads (the OriginTable's mutex covers the
- * cross-thread intern/resolve).
+ * Origins are kept as the packed sockaddr the ingress reports (SsOscAddr), so
+ * interning a sender is a memcmp and a reply needs no address parsing or
+ * resolution. Sends are queued and go out in one batch (sendmmsg on Linux) when
+ * the gateway flushes at the end of a drain, or once the queue reaches
+ * kBatchDatagrams / kBatchBytes.
+ *
+ * The NRT gateway is the main caller of the IOscTransport methods, but a send
+ * can also come from outside a drain pass (OscEgress::deliverBroadcastNotify),
+ * so the send queue has its own mutex. Inbound runs on the Rust recv threads
+ * (the OriginTable's mutex covers the cross-thread intern/resolve).
  */
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -62,26 +71,46 @@ public:
     void broadcastOsc(const uint8_t* data, uint32_t size) override;
     bool subscribeOsc(uint32_t token) override;
     void unsubscribeOsc(uint32_t token) override;
+    void flush() override;
+
+    // Queue limits: reaching either sends the queue without waiting for flush().
+    static constexpr uint32_t kBatchDatagrams = 64;
+    static constexpr uint32_t kBatchBytes     = 256 * 1024;
 
 private:
-    struct Target { std::string ip; int port; };
+    // A resolved peer: OriginTable key and subscriber-list entry.
+    struct Target {
+        SsOscAddr addr{};
+        bool operator==(const Target& o) const {
+            return addr.len == o.addr.len && std::memcmp(addr.bytes, o.addr.bytes, addr.len) == 0;
+        }
+    };
 
-    static void onDatagram(void* ctx, const uint8_t* ip, uint32_t ip_len,
-                           int32_t port, const uint8_t* osc, uint32_t len);
+    static void onDatagram(void* ctx, const SsOscAddr* src,
+                           const uint8_t* osc, uint32_t len);
 
-    void sendTo(const std::string& ip, int port, const uint8_t* data, uint32_t size);
+    void sendTo(const Target& t, const uint8_t* data, uint32_t size);
+    void flushLocked();   // mBatchMutex held
     void broadcast(const std::vector<Target>& list, const uint8_t* data, uint32_t size);
     bool subscribeCallerTo(std::vector<Target>& list, uint32_t token);
     void unsubscribeCallerFrom(std::vector<Target>& list, uint32_t token);
-    static bool addTarget(std::vector<Target>& list, const std::string& ip, int port);
-    static void removeTarget(std::vector<Target>& list, const std::string& ip, int port);
+    static bool addTarget(std::vector<Target>& list, const Target& t);
+    static void removeTarget(std::vector<Target>& list, const Target& t);
 
     int           mPort = 57110;
     std::string   mBindAddress;
     IngestFn      mIngest;
     SsOsc*        mOsc     = nullptr;   // outbound send handle
     SsOscIngress* mIngress = nullptr;   // inbound recv (owns the Rust recv threads)
-    OriginTable   mOrigins;
+    BasicOriginTable<Target> mOrigins;
+
+    // Pending sends: addresses and payload bytes copied in, offsets into mBatchBytes
+    // (resolved to pointers only at flush, since the buffer may grow).
+    std::mutex                 mBatchMutex;
+    struct Pending { SsOscAddr addr; uint32_t offset; uint32_t len; };
+    std::vector<Pending>       mBatch;
+    std::vector<uint8_t>       mBatchBytes;
+    std::vector<SsOscDatagram> mBatchOut;
 
     std::vector<Target> mNotifyTargets;
     std::vector<Target> mLinkNotifyTargets;
@@ -0,0 +1,285 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+
+    Offline score renderer: renders an scsynth NRT score to a 32-bit float WAV,
+    cutting it into time segments that render on separate engine processes
+    (see render/score_plan.h for where it cuts and why).
+
+    Usage: supersonic-render [options] <score> <out.wav>
+
+      -j, --jobs N         engine processes at once (default: CPU count)
+      -n, --segments N     segments to aim for (default: jobs)
+      -r, --rate HZ        sample rate (48000)
+      -c, --channels N     output channels (2)
+      -b, --block N        control block frames (128)
+      -d, --synthdefs P    .scsyndef file or directory, sent as /d_recv at time
+                           0 (repeatable)
+      -t, --traits FILE    per-def life / release / tail declarations
+          --warmup S       warm-up window persistent nodes must forget in (2)
+          --max-warmup S   furthest back a segment may start (8)
+          --crossfade S    overlap blended at each cut (0.05)
+          --tail S         render this long past the last event (0)
+          --serial         one engine, no cuts
+          --analyse        report lifetimes and the plan; render nothing
+          --verify         also render serially and compare sample by sample
+          --tolerance X    largest difference --verify accepts (1e-4)
+
+    Exit status: 0 rendered (and verified), 1 error, 2 verification failed.
+*/
+
+#include "render/render_engine.h"
+#include "render/score_plan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ss_render;
+
+namespace {
+
+bool read_file(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    out.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// /d_recv <blob>
+std::vector<uint8_t> d_recv(const std::vector<uint8_t>& def) {
+    std::vector<uint8_t> m = {'/', 'd', '_', 'r', 'e', 'c', 'v', 0, ',', 'b', 0, 0};
+    put_be32(m, uint32_t(def.size()));
+    m.insert(m.end(), def.begin(), def.end());
+    while (m.size() % 4) m.push_back(0);
+    return m;
+}
+
+// 32-bit IEEE float WAV, interleaved.
+bool write_wav(const std::string& path, const float* data, int64_t frames, uint32_t channels,
+               uint32_t rate) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const uint64_t bytes = uint64_t(frames) * channels * 4;
+    auto u32 = [&](uint32_t v) { uint8_t b[4] = {uint8_t(v), uint8_t(v >> 8), uint8_t(v >> 16), uint8_t(v >> 24)}; std::fwrite(b, 1, 4, f); };
+    auto u16 = [&](uint16_t v) { uint8_t b[2] = {uint8_t(v), uint8_t(v >> 8)}; std::fwrite(b, 1, 2, f); };
+    std::fwrite("RIFF", 1, 4, f);
+    u32(uint32_t(std::min<uint64_t>(bytes + 36, 0xFFFFFFFFu)));
+    std::fwrite("WAVEfmt ", 1, 8, f);
+    u32(16);
+    u16(3);                                   // WAVE_FORMAT_IEEE_FLOAT
+    u16(uint16_t(channels));
+    u32(rate);
+    u32(rate * channels * 4);
+    u16(uint16_t(channels * 4));
+    u16(32);
+    std::fwrite("data", 1, 4, f);
+    u32(uint32_t(std::min<uint64_t>(bytes, 0xFFFFFFFFu)));
+    const bool ok = std::fwrite(data, 4, size_t(frames) * channels, f) == size_t(frames) * channels;
+    return std::fclose(f) == 0 && ok;
+}
+
+const char* kind_name(IssueKind k) {
+    switch (k) {
+        case IssueKind::InfiniteSustain:   return "infinite sustain";
+        case IssueKind::UnboundedFeedback: return "unbounded feedback";
+        case IssueKind::BufferWrites:      return "buffer writes";
+        case IssueKind::Nondeterministic:  return "nondeterministic";
+        case IssueKind::Unsupported:       return "unsupported";
+    }
+    return "";
+}
+
+int usage() {
+    std::fprintf(stderr,
+        "usage: supersonic-render [options] <score> <out.wav>\n"
+        "  -j/--jobs N  -n/--segments N  -r/--rate HZ  -c/--channels N  -b/--block N\n"
+        "  -d/--synthdefs PATH  -t/--traits FILE  --warmup S  --max-warmup S\n"
+        "  --crossfade S  --tail S  --serial  --analyse  --verify  --tolerance X\n");
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    PlanOptions plan;
+    uint32_t jobs = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t segments = 0, channels = 2, block = 128;
+    double rate = 48000.0, tolerance = 1e-4;
+    bool serial = false, analyseOnly = false, verify = false;
+    std::vector<std::string> defPaths, positional;
+    std::string traitsPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto val = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* v = nullptr;
+        if ((a == "-j" || a == "--jobs") && (v = val())) jobs = uint32_t(std::max(1, std::atoi(v)));
+        else if ((a == "-n" || a == "--segments") && (v = val())) segments = uint32_t(std::max(1, std::atoi(v)));
+        else if ((a == "-r" || a == "--rate") && (v = val())) rate = std::atof(v);
+        else if ((a == "-c" || a == "--channels") && (v = val())) channels = uint32_t(std::max(1, std::atoi(v)));
+        else if ((a == "-b" || a == "--block") && (v = val())) block = uint32_t(std::max(1, std::atoi(v)));
+        else if ((a == "-d" || a == "--synthdefs") && (v = val())) defPaths.push_back(v);
+        else if ((a == "-t" || a == "--traits") && (v = val())) traitsPath = v;
+        else if (a == "--warmup" && (v = val())) plan.warmup = std::atof(v);
+        else if (a == "--max-warmup" && (v = val())) plan.maxWarmup = std::atof(v);
+        else if (a == "--crossfade" && (v = val())) plan.crossfade = std::atof(v);
+        else if (a == "--tail" && (v = val())) plan.tail = std::atof(v);
+        else if (a == "--tolerance" && (v = val())) tolerance = std::atof(v);
+        else if (a == "--serial") serial = true;
+        else if (a == "--analyse" || a == "--analyze") analyseOnly = true;
+        else if (a == "--verify") verify = true;
+        else if (!a.empty() && a[0] != '-') positional.push_back(a);
+        else return usage();
+    }
+    if (positional.size() != 2 && !(analyseOnly && positional.size() == 1)) return usage();
+    if (rate <= 0.0) return usage();
+
+    // Score, with any synthdef files loaded ahead of it.
+    std::vector<uint8_t> bytes;
+    if (!read_file(positional[0], bytes)) {
+        std::fprintf(stderr, "supersonic-render: cannot read %s\n", positional[0].c_str());
+        return 1;
+    }
+    Score score;
+    std::string err;
+    if (!parse_score(bytes.data(), bytes.size(), score, err)) {
+        std::fprintf(stderr, "supersonic-render: %s: %s\n", positional[0].c_str(), err.c_str());
+        return 1;
+    }
+    std::vector<SynthDefInfo> defs;
+    std::vector<ScoreEvent> loads;
+    for (const auto& p : defPaths) {
+        std::vector<std::string> files;
+        std::error_code ec;
+        const bool dir = std::filesystem::is_directory(p, ec);
+        if (dir) {
+            for (const auto& e : std::filesystem::directory_iterator(p, ec))
+                if (e.path().extension() == ".scsyndef") files.push_back(e.path().string());
+            std::sort(files.begin(), files.end());
+        } else {
+            files.push_back(p);
+        }
+        for (const auto& f : files) {
+            std::vector<uint8_t> def;
+            if (!read_file(f, def) || !scan_synthdefs(def.data(), def.size(), defs, err)) {
+                std::fprintf(stderr, "supersonic-render: %s: %s%s\n", f.c_str(),
+                             def.empty() ? "cannot read" : err.c_str(), dir ? " (skipped)" : "");
+                if (dir) continue;        // one bad file in a directory is not fatal
+                return 1;
+            }
+            loads.push_back({0.0, d_recv(def)});
+        }
+    }
+    score.events.insert(score.events.begin(), loads.begin(), loads.end());
+
+    TraitTable traits;
+    if (!traitsPath.empty()) {
+        std::vector<uint8_t> t;
+        if (!read_file(traitsPath, t) ||
+            !parse_traits(std::string(t.begin(), t.end()), traits, err)) {
+            std::fprintf(stderr, "supersonic-render: %s: %s\n", traitsPath.c_str(),
+                         t.empty() ? "cannot read" : err.c_str());
+            return 1;
+        }
+    }
+
+    // Analyse and plan.
+    const Analysis analysis = analyse_score(score, defs, traits);
+    plan.sampleRate = rate;
+    plan.blockFrames = block;
+    plan.segments = serial ? 1 : (segments ? segments : jobs);
+    const Plan p = plan_segments(score, analysis, plan);
+
+    std::fprintf(stderr, "score: %zu events, %.3f s, %zu nodes\n", score.events.size(),
+                 score.duration(), analysis.nodes.size());
+    for (const auto& is : analysis.issues)
+        std::fprintf(stderr, "  %s @ %.3fs: %s\n", kind_name(is.kind), is.time, is.text.c_str());
+    for (const auto& n : p.notes) std::fprintf(stderr, "  %s\n", n.c_str());
+    for (size_t k = 0; k < p.segments.size(); ++k) {
+        const Segment& s = p.segments[k];
+        std::fprintf(stderr, "  segment %zu: output %.3f-%.3f s, warm start %.3f s\n", k,
+                     double(s.startFrame) / rate, double(s.endFrame) / rate,
+                     double(s.warmFrame) / rate);
+    }
+    if (analyseOnly) return 0;
+
+    // Render: the segments, plus a serial reference when verifying.
+    EngineOptions eo;
+    eo.sampleRate = rate;
+    eo.channels = channels;
+    eo.world = default_world_options(channels, block);
+    std::vector<SegmentScript> scripts;
+    for (const Segment& s : p.segments) scripts.push_back(segment_script(score, analysis, s, plan));
+    if (verify) {
+        Segment whole;
+        whole.endFrame = whole.renderEnd = p.totalFrames;
+        scripts.push_back(segment_script(score, analysis, whole, plan));
+    }
+    std::vector<std::unique_ptr<SharedFloats>> bufs;
+    std::vector<float*> outs;
+    for (const auto& sc : scripts) {
+        bufs.push_back(std::make_unique<SharedFloats>(size_t(sc.renderEnd - sc.warmFrame) * channels));
+        if (!bufs.back()->ok()) {
+            std::fprintf(stderr, "supersonic-render: out of memory for render buffers\n");
+            return 1;
+        }
+        outs.push_back(bufs.back()->data());
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto results = render_parallel(eo, scripts, outs, jobs);
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    bool ok = true;
+    for (size_t k = 0; k < results.size(); ++k) {
+        const auto& r = results[k];
+        if (!r.ok) {
+            std::fprintf(stderr, "  render %zu failed: %s\n", k, r.error.c_str());
+            ok = false;
+        }
+        if (r.failReplies)
+            std::fprintf(stderr, "  render %zu: %u /fail replies (first: %s)\n", k, r.failReplies,
+                         r.firstFail.c_str());
+        if (r.lateBundles)
+            std::fprintf(stderr, "  render %zu: %u bundles queued late\n", k, r.lateBundles);
+    }
+    if (!ok) return 1;
+
+    std::vector<float> out(size_t(p.totalFrames) * channels, 0.0f);
+    std::vector<const float*> rendered(outs.begin(), outs.begin() + ptrdiff_t(p.segments.size()));
+    for (const auto& j : stitch(p, channels, rendered, out.data()))
+        std::fprintf(stderr, "  cut at %.3f s: segments differ by up to %.3g across the crossfade\n",
+                     double(j.frame) / rate, double(j.maxDiff));
+    std::fprintf(stderr, "rendered %.3f s of audio in %.3f s on %u job(s)\n",
+                 double(p.totalFrames) / rate, secs, jobs);
+
+    if (!write_wav(positional[1], out.data(), p.totalFrames, channels, uint32_t(rate))) {
+        std::fprintf(stderr, "supersonic-render: cannot write %s\n", positional[1].c_str());
+        return 1;
+    }
+
+    if (verify) {
+        const float* ref = outs.back();
+        float worst = 0.0f;
+        size_t at = 0;
+        for (size_t i = 0; i < out.size(); ++i) {
+            const float d = std::fabs(out[i] - ref[i]);
+            if (d > worst) { worst = d; at = i; }
+        }
+        std::fprintf(stderr, "verify: max difference from a serial render %.3g at %.3f s\n",
+                     double(worst), double(at / channels) / rate);
+        if (!(worst <= tolerance)) return 2;
+    }
+    return 0;
+}
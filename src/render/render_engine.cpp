@@ -0,0 +1,256 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+
+    render_engine.cpp — see render_engine.h.
+*/
+
+#include "render/render_engine.h"
+
+#include "IngressCallCtx.h"
+#include "OscIngress.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+// ── Host glue the shared engine expects a host to provide ────────────────────
+// As in the freestanding host: no public shm segment, so the engine uses its
+// own arena.
+extern "C" {
+void* g_external_shared_memory = nullptr;
+}
+
+namespace ss_render {
+
+namespace {
+
+// Small NTP base: keeps the int64 OSC time tag positive (a real-date NTP
+// overflows it — see nosynth_smoke) while leaving room for prerolls, which
+// tick at frames before a segment's warm start.
+constexpr double kNtpBase = 4096.0;
+
+// The engine drains at most this many IN-ring messages per block
+// (process_audio's MAX_MESSAGES_PER_FRAME); writing faster only fills the ring.
+constexpr uint32_t kWritesPerBlock = 32;
+
+// Keep bundles well inside the IN ring's largest frame.
+constexpr size_t kMaxBundleBytes = 64 * 1024;
+
+double ntp_at(int64_t frame, double sr) { return kNtpBase + double(frame) / sr; }
+
+// Count /fail replies; everything else the engine says is dropped.
+void on_egress(void* ctx, uint32_t, uint32_t, const uint8_t* osc, uint32_t len, uint32_t) {
+    auto* r = static_cast<RenderResult*>(ctx);
+    ss_host::OscReader msg(osc, len);
+    if (!msg.ok() || std::strcmp(msg.address(), "/fail") != 0) return;
+    if (r->failReplies++ == 0) {
+        const char* cmd;
+        if (msg.readString(cmd)) r->firstFail = cmd;
+    }
+}
+
+void drain_egress(RenderResult& res) {
+    ss_egress_rt_drain(&on_egress, &res, 0);
+    ss_egress_nrt_drain(&on_egress, &res, 0);
+}
+
+// One #bundle holding timed[i, j) — all at the same score time.
+std::vector<uint8_t> make_bundle(const std::vector<const ScoreEvent*>& timed, size_t i, size_t j) {
+    std::vector<uint8_t> b;
+    b.insert(b.end(), {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0});
+    put_be64(b, seconds_to_timetag(kNtpBase + timed[i]->time));
+    for (; i < j; ++i) {
+        put_be32(b, uint32_t(timed[i]->msg.size()));
+        b.insert(b.end(), timed[i]->msg.begin(), timed[i]->msg.end());
+    }
+    return b;
+}
+
+struct SharedResult {
+    int32_t  done;
+    int32_t  ok;
+    uint32_t failReplies;
+    uint32_t lateBundles;
+    char     firstFail[64];
+    char     error[160];
+};
+
+}  // namespace
+
+SsWorldOptions default_world_options(uint32_t channels, uint32_t blockFrames) {
+    SsWorldOptions w = {};
+    w.num_buffers              = 1024;
+    w.max_nodes                = 1024;
+    w.max_graph_defs           = 512;
+    w.max_wire_bufs            = 64;
+    w.num_audio_bus_channels   = 1024;
+    w.num_input_bus_channels   = 2;
+    w.num_output_bus_channels  = channels;
+    w.num_control_bus_channels = 16384;
+    w.buf_length               = blockFrames;
+    w.real_time_memory_size    = 8192;   // KB
+    w.num_rgens                = 64;
+    w.load_graph_defs          = 0;
+    w.verbosity                = 0;
+    w.shared_memory_id         = 0;
+    return w;
+}
+
+RenderResult render_script(const EngineOptions& opts, const SegmentScript& script, float* out) {
+    RenderResult res;
+    const double sr = opts.sampleRate;
+    const uint32_t channels = opts.channels;
+
+    // The engine dispatches through whatever ingress its host publishes. A
+    // renderer only performs: everything goes to the synth plane, as on the
+    // worklet hosts — no control namespaces, no NRT thread.
+    static OscIngress ingress;
+    ingress.setDefault(&ss_synth_default_route, nullptr);
+    g_active_ingress.store(&ingress, std::memory_order_release);
+
+    ss_init(&opts.world, sr);
+    const int64_t bl = ss_block_size();
+    if (bl <= 0) { res.error = "engine did not boot"; return res; }
+    if (script.warmFrame % bl != 0) { res.error = "warm start is not on a block edge"; return res; }
+
+    // Preroll: state and carried nodes, performed immediately over a run of
+    // blocks that ends where the segment starts.
+    const size_t nPre = script.preroll.size();
+    int64_t frame = script.warmFrame;
+    if (nPre > 0) {
+        const int64_t blocks = int64_t((nPre + kWritesPerBlock - 1) / kWritesPerBlock) + 2;
+        frame = script.warmFrame - blocks * bl;
+        size_t next = 0;
+        while (next < nPre || frame < script.warmFrame) {
+            for (uint32_t w = 0; w < kWritesPerBlock && next < nPre; ++w) {
+                const auto& m = script.preroll[next]->msg;
+                if (!ss_ingress_write(m.data(), uint32_t(m.size()), 0)) break;
+                ++next;
+            }
+            // A full ring holds the clock one block short of the warm start
+            // until it drains.
+            const int64_t at = std::min(frame, script.warmFrame - bl);
+            if (!ss_tick(ntp_at(at, sr), channels, 0)) { res.error = "engine error in preroll"; return res; }
+            drain_egress(res);
+            if (frame < script.warmFrame) frame += bl;
+        }
+    }
+
+    // Timed events, a bundle per distinct time, queued lookaheadBlocks ahead.
+    const auto& timed = script.timed;
+    size_t ti = 0;
+    const int64_t ahead = int64_t(std::max<uint32_t>(1, opts.lookaheadBlocks)) * bl;
+    for (frame = script.warmFrame; frame < script.renderEnd; frame += bl) {
+        const double horizon = double(frame + ahead) / sr;
+        for (uint32_t w = 0; w < kWritesPerBlock && ti < timed.size() && timed[ti]->time < horizon; ++w) {
+            size_t j = ti + 1, bytes = timed[ti]->msg.size() + 20;
+            while (j < timed.size() && timed[j]->time == timed[ti]->time &&
+                   bytes + timed[j]->msg.size() + 4 <= kMaxBundleBytes)
+                bytes += timed[j++]->msg.size() + 4;
+            const auto b = make_bundle(timed, ti, j);
+            if (!ss_ingress_write(b.data(), uint32_t(b.size()), 0)) break;
+            if (timed[ti]->time * sr < double(frame)) ++res.lateBundles;
+            ti = j;
+        }
+        if (!ss_tick(ntp_at(frame, sr), channels, 0)) { res.error = "engine error"; return res; }
+        drain_egress(res);
+
+        const float* block = ss_audio_out();
+        const int64_t n = std::min<int64_t>(bl, script.renderEnd - frame);
+        float* dst = out + size_t(frame - script.warmFrame) * channels;
+        for (int64_t i = 0; i < n; ++i)
+            for (uint32_t c = 0; c < channels; ++c)
+                dst[size_t(i) * channels + c] = block[size_t(c) * size_t(bl) + size_t(i)];
+    }
+    res.ok = true;
+    return res;
+}
+
+std::vector<RenderResult> render_parallel(const EngineOptions& opts,
+                                          const std::vector<SegmentScript>& scripts,
+                                          const std::vector<float*>& outs, uint32_t jobs) {
+    const size_t n = scripts.size();
+    std::vector<RenderResult> results(n);
+    void* mem = mmap(nullptr, sizeof(SharedResult) * std::max<size_t>(1, n), PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        for (auto& r : results) r.error = "mmap failed";
+        return results;
+    }
+    auto* shared = static_cast<SharedResult*>(mem);
+    std::memset(shared, 0, sizeof(SharedResult) * n);
+
+    std::map<pid_t, size_t> running;
+    size_t next = 0;
+    jobs = std::max<uint32_t>(1, jobs);
+    while (next < n || !running.empty()) {
+        while (next < n && running.size() < jobs) {
+            std::fflush(nullptr);
+            const pid_t pid = fork();
+            if (pid == 0) {
+                // Child: one engine, one script, straight out.
+                const RenderResult r = render_script(opts, scripts[next], outs[next]);
+                SharedResult& s = shared[next];
+                s.ok = r.ok ? 1 : 0;
+                s.failReplies = r.failReplies;
+                s.lateBundles = r.lateBundles;
+                std::snprintf(s.firstFail, sizeof(s.firstFail), "%s", r.firstFail.c_str());
+                std::snprintf(s.error, sizeof(s.error), "%s", r.error.c_str());
+                s.done = 1;
+                _exit(r.ok ? 0 : 1);
+            }
+            if (pid < 0) {
+                results[next].error = std::string("fork failed: ") + std::strerror(errno);
+                ++next;
+                continue;
+            }
+            running[pid] = next++;
+        }
+        if (running.empty()) break;
+        int status = 0;
+        const pid_t done = waitpid(-1, &status, 0);
+        if (done < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        auto it = running.find(done);
+        if (it == running.end()) continue;
+        const size_t i = it->second;
+        running.erase(it);
+        RenderResult& r = results[i];
+        const SharedResult& s = shared[i];
+        r.ok = s.done && s.ok;
+        r.failReplies = s.failReplies;
+        r.lateBundles = s.lateBundles;
+        r.firstFail = s.firstFail;
+        r.error = s.error;
+        if (WIFSIGNALED(status))
+            r.error = "worker killed by signal " + std::to_string(WTERMSIG(status));
+        else if (!s.done)
+            r.error = "worker exited without a result";
+    }
+    munmap(mem, sizeof(SharedResult) * std::max<size_t>(1, n));
+    return results;
+}
+
+SharedFloats::SharedFloats(size_t count) : mCount(count) {
+    if (count == 0) return;
+    void* p = mmap(nullptr, count * sizeof(float), PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p != MAP_FAILED) mData = static_cast<float*>(p);
+}
+
+SharedFloats::~SharedFloats() {
+    if (mData) munmap(mData, mCount * sizeof(float));
+}
+
+}  // namespace ss_render
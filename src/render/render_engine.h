@@ -0,0 +1,76 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+
+    Engine side of the offline renderer. render_script() drives this process's
+    engine through the lanes C ABI — ss_init once, then preroll messages,
+    time-tagged bundles fed a few blocks ahead, ss_tick per block — and copies
+    ss_audio_out into an interleaved buffer. The engine is process-singleton,
+    so render_parallel() gives every script its own process (fork), rendering
+    into shared memory, at most `jobs` at a time. POSIX only.
+
+    Time: block n of a script renders at NTP kNtpBase + frame / sampleRate,
+    with frame counted from the start of the score — the same value in a
+    segment as in a serial render, so every event lands at the same sample
+    offset within the same block in both.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lanes/lanes.h"
+#include "render/score_plan.h"
+
+namespace ss_render {
+
+struct EngineOptions {
+    double         sampleRate = 48000.0;
+    uint32_t       channels   = 2;
+    SsWorldOptions world      = {};   // filled by default_world_options()
+    uint32_t       lookaheadBlocks = 16;   // bundles are queued this far ahead
+};
+
+// World sized like the native engine's defaults (SupersonicEngine::Config).
+SsWorldOptions default_world_options(uint32_t channels, uint32_t blockFrames);
+
+struct RenderResult {
+    bool        ok = false;
+    std::string error;
+    uint32_t    failReplies = 0;   // /fail replies from the engine
+    std::string firstFail;         // the first one's command name
+    uint32_t    lateBundles = 0;   // bundles that could not be queued in time
+};
+
+// Render `script` on this process's engine (which must not have been
+// initialised yet) into `out`: (renderEnd - warmFrame) × channels floats.
+RenderResult render_script(const EngineOptions& opts, const SegmentScript& script, float* out);
+
+// Render every script in its own process, `jobs` at a time. `outs[i]` receives
+// script i. Returns one result per script.
+std::vector<RenderResult> render_parallel(const EngineOptions& opts,
+                                          const std::vector<SegmentScript>& scripts,
+                                          const std::vector<float*>& outs, uint32_t jobs);
+
+// Shared, zeroed float storage that a forked child's writes land in.
+class SharedFloats {
+public:
+    explicit SharedFloats(size_t count);
+    ~SharedFloats();
+    SharedFloats(const SharedFloats&) = delete;
+    SharedFloats& operator=(const SharedFloats&) = delete;
+
+    float* data() const { return mData; }
+    size_t size() const { return mCount; }
+    bool   ok()   const { return mData != nullptr || mCount == 0; }
+
+private:
+    float* mData  = nullptr;
+    size_t mCount = 0;
+};
+
+}  // namespace ss_render
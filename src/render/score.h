@@ -0,0 +1,254 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+
+    Score model for the offline renderer: a time-ordered list of OSC commands,
+    read from scsynth's NRT score format (a sequence of [int32 size][#bundle]
+    records whose time tags are seconds from the start of the render), plus a
+    reader for the synthdef files those commands load — enough of the SCgf
+    format to know each def's controls, their defaults and which UGens it
+    uses. Pure data + parsing: no engine, no IO, no allocation beyond the
+    returned vectors.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "host/osc_reader.h"
+
+namespace ss_render {
+
+using ss_host::be32;
+using ss_host::be64;
+using ss_host::pad4;
+
+// One OSC message (never a bundle) and the score time it is performed at.
+struct ScoreEvent {
+    double               time = 0.0;   // seconds from the start of the render
+    std::vector<uint8_t> msg;
+};
+
+// Events in performance order: by time, then by position in the file.
+struct Score {
+    std::vector<ScoreEvent> events;
+    double duration() const { return events.empty() ? 0.0 : events.back().time; }
+};
+
+// ── OSC framing helpers ──────────────────────────────────────────────────────
+
+inline void put_be32(std::vector<uint8_t>& b, uint32_t v) {
+    for (int i = 3; i >= 0; --i) b.push_back(uint8_t(v >> (i * 8)));
+}
+inline void put_be64(std::vector<uint8_t>& b, uint64_t v) {
+    for (int i = 7; i >= 0; --i) b.push_back(uint8_t(v >> (i * 8)));
+}
+
+// Seconds ↔ OSC 32.32 fixed-point time tag.
+inline uint64_t seconds_to_timetag(double s) {
+    if (s <= 0.0) return 0;
+    return uint64_t(s * 4294967296.0 + 0.5);
+}
+inline double timetag_to_seconds(uint64_t tt) { return double(tt) / 4294967296.0; }
+
+inline bool is_bundle(const uint8_t* p, size_t len) {
+    return len >= 16 && std::memcmp(p, "#bundle", 8) == 0;
+}
+
+// Append the messages of one bundle (recursing into nested bundles, which
+// take the later of their own and the enclosing time) to `out`.
+inline bool flatten_bundle(const uint8_t* p, size_t len, double outer, Score& out) {
+    if (!is_bundle(p, len)) return false;
+    double t = timetag_to_seconds(be64(p + 8));
+    if (be64(p + 8) == 1) t = outer;                  // "immediately"
+    if (t < outer) t = outer;
+    size_t pos = 16;
+    while (pos + 4 <= len) {
+        const uint32_t n = be32(p + pos);
+        pos += 4;
+        if (n == 0 || pos + n > len) return false;
+        if (is_bundle(p + pos, n)) {
+            if (!flatten_bundle(p + pos, n, t, out)) return false;
+        } else if (p[pos] == '/') {
+            out.events.push_back({t, std::vector<uint8_t>(p + pos, p + pos + n)});
+        } else {
+            return false;
+        }
+        pos += n;
+    }
+    return pos == len;
+}
+
+// Parse an NRT score file. Records need not be time-ordered in the file; the
+// result is (stable-)sorted by time. False + `err` on a malformed record.
+inline bool parse_score(const uint8_t* data, size_t len, Score& out, std::string& err) {
+    out.events.clear();
+    size_t pos = 0;
+    while (pos < len) {
+        if (pos + 4 > len) { err = "truncated record header"; return false; }
+        const uint32_t n = be32(data + pos);
+        pos += 4;
+        if (n == 0 || pos + n > len) { err = "record runs past end of file"; return false; }
+        if (!flatten_bundle(data + pos, n, 0.0, out)) {
+            err = "record at byte " + std::to_string(pos - 4) + " is not a valid #bundle";
+            return false;
+        }
+        pos += n;
+    }
+    std::stable_sort(out.events.begin(), out.events.end(),
+                     [](const ScoreEvent& a, const ScoreEvent& b) { return a.time < b.time; });
+    return true;
+}
+
+// Serialise back to the NRT format: one record per distinct time.
+inline std::vector<uint8_t> write_score(const Score& s) {
+    std::vector<uint8_t> out;
+    size_t i = 0;
+    while (i < s.events.size()) {
+        std::vector<uint8_t> b;
+        b.insert(b.end(), {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0});
+        put_be64(b, seconds_to_timetag(s.events[i].time));
+        const double t = s.events[i].time;
+        for (; i < s.events.size() && s.events[i].time == t; ++i) {
+            put_be32(b, uint32_t(s.events[i].msg.size()));
+            b.insert(b.end(), s.events[i].msg.begin(), s.events[i].msg.end());
+        }
+        put_be32(out, uint32_t(b.size()));
+        out.insert(out.end(), b.begin(), b.end());
+    }
+    return out;
+}
+
+inline const char* address_of(const ScoreEvent& e) {
+    return reinterpret_cast<const char*>(e.msg.data());
+}
+
+// ── Synthdefs ────────────────────────────────────────────────────────────────
+
+// What the planner needs to know about one def.
+struct SynthDefInfo {
+    std::string              name;
+    std::vector<float>       defaults;     // initial control values
+    std::vector<std::string> controlNames; // per control index ("" = unnamed)
+    bool feedback      = false;  // LocalIn / InFeedback: output feeds back in
+    bool writesBuffers = false;  // BufWr / RecordBuf / …: mutates shared buffers
+    bool random        = false;  // noise / random UGens: output depends on seeds
+
+    // Control index for `name`, or -1.
+    int controlIndex(const char* n) const {
+        for (size_t i = 0; i < controlNames.size(); ++i)
+            if (controlNames[i] == n) return int(i);
+        return -1;
+    }
+};
+
+namespace detail {
+
+inline bool in_list(const std::string& s, const char* const* list) {
+    for (; *list; ++list)
+        if (s == *list) return true;
+    return false;
+}
+
+inline void classify_ugen(const std::string& cls, SynthDefInfo& d) {
+    static const char* const kFeedback[] = {"LocalIn", "InFeedback", nullptr};
+    static const char* const kBufWrite[] = {
+        "BufWr", "RecordBuf", "ScopeOut", "ScopeOut2", "SetBuf", "ClearBuf",
+        "Logger", "DiskOut", nullptr};
+    static const char* const kRandom[] = {
+        "WhiteNoise", "PinkNoise", "BrownNoise", "GrayNoise", "ClipNoise",
+        "Dust", "Dust2", "Crackle", "Rand", "IRand", "ExpRand", "LinRand",
+        "NRand", "TRand", "TIRand", "TExpRand", "CoinGate", "LFNoise0",
+        "LFNoise1", "LFNoise2", "LFClipNoise", "LFDNoise0", "LFDNoise1",
+        "LFDNoise3", "LFDClipNoise", "Drand", "Dxrand", "Dwrand", "Dwhite",
+        "Diwhite", "Dbrown", "Dibrown", "Dshuf", "TWindex", "RandID",
+        "RandSeed", "MostChange", nullptr};
+    if (in_list(cls, kFeedback)) d.feedback = true;
+    if (in_list(cls, kBufWrite)) d.writesBuffers = true;
+    if (in_list(cls, kRandom)) d.random = true;
+}
+
+// Big-endian cursor over a synthdef file; any overrun latches !ok.
+struct DefCursor {
+    const uint8_t* p;
+    size_t         len;
+    size_t         pos = 0;
+    bool           ok  = true;
+
+    bool need(size_t n) { if (!ok || pos + n > len) ok = false; return ok; }
+    int32_t i8()  { if (!need(1)) return 0; return int8_t(p[pos++]); }
+    int32_t i16() { if (!need(2)) return 0; int16_t v = int16_t((p[pos] << 8) | p[pos + 1]); pos += 2; return v; }
+    int32_t i32() { if (!need(4)) return 0; int32_t v = int32_t(be32(p + pos)); pos += 4; return v; }
+    float   f32() { uint32_t r = uint32_t(i32()); float f; std::memcpy(&f, &r, 4); return f; }
+    int32_t count(int version) { return version >= 2 ? i32() : i16(); }
+    std::string pstr() {
+        if (!need(1)) return {};
+        const size_t n = p[pos++];
+        if (!need(n)) return {};
+        std::string s(reinterpret_cast<const char*>(p + pos), n);
+        pos += n;
+        return s;
+    }
+};
+
+}  // namespace detail
+
+// Read every def in an SCgf file (v1 or v2). False + `err` if malformed.
+inline bool scan_synthdefs(const uint8_t* data, size_t len,
+                           std::vector<SynthDefInfo>& out, std::string& err) {
+    detail::DefCursor c{data, len};
+    if (len < 10 || std::memcmp(data, "SCgf", 4) != 0) { err = "not an SCgf synthdef"; return false; }
+    c.pos = 4;
+    const int version = c.i32();
+    if (version != 1 && version != 2) { err = "unsupported synthdef version"; return false; }
+    const int numDefs = c.i16();
+    for (int d = 0; d < numDefs && c.ok; ++d) {
+        SynthDefInfo info;
+        info.name = c.pstr();
+        const int numConsts = c.count(version);
+        if (numConsts < 0 || !c.need(size_t(numConsts) * 4)) break;
+        c.pos += size_t(numConsts) * 4;
+        const int numParams = c.count(version);
+        if (numParams < 0) { c.ok = false; break; }
+        if (!c.need(size_t(numParams) * 4)) break;   // before sizing anything by it
+        for (int i = 0; i < numParams && c.ok; ++i) info.defaults.push_back(c.f32());
+        info.controlNames.assign(size_t(numParams), std::string());
+        const int numNames = c.count(version);
+        for (int i = 0; i < numNames && c.ok; ++i) {
+            std::string n = c.pstr();
+            const int idx = c.count(version);
+            if (idx >= 0 && idx < numParams) info.controlNames[size_t(idx)] = n;
+        }
+        const int numUGens = c.count(version);
+        for (int u = 0; u < numUGens && c.ok; ++u) {
+            const std::string cls = c.pstr();
+            detail::classify_ugen(cls, info);
+            c.i8();                                    // rate
+            const int numIn  = c.count(version);
+            const int numOut = c.count(version);
+            c.i16();                                   // special index
+            if (numIn < 0 || numOut < 0) { c.ok = false; break; }
+            const size_t inBytes = size_t(numIn) * (version >= 2 ? 8 : 4);
+            if (!c.need(inBytes + size_t(numOut))) break;
+            c.pos += inBytes + size_t(numOut);
+        }
+        const int numVariants = c.i16();
+        for (int v = 0; v < numVariants && c.ok; ++v) {
+            c.pstr();
+            if (!c.need(size_t(numParams) * 4)) break;
+            c.pos += size_t(numParams) * 4;
+        }
+        if (c.ok) out.push_back(std::move(info));
+    }
+    if (!c.ok) { err = "truncated synthdef"; return false; }
+    return true;
+}
+
+}  // namespace ss_render
@@ -0,0 +1,622 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+
+    Time-segmentation planner for the offline renderer. A World is one
+    sequential timeline, so a long score renders on one core; but most nodes in
+    a generative score live for a note or a grain, so the score can be cut at
+    points where little is alive and the pieces rendered on separate engines.
+
+    analyse_score() follows every node through the score — created by /s_new,
+    ended by /n_free, a group free, a gate release plus the def's release time,
+    or the def's own lifetime bound — using per-def traits the caller declares
+    (life / release / tail, constants or sums of control values) and what the
+    synthdef files show (feedback, buffer-writing and random UGens).
+
+    plan_segments() then picks cut times. A segment whose output starts at cut
+    T begins rendering earlier, at its warm start: every node that still sounds
+    within the warm-up window before T is replayed from its own /s_new, and
+    persistent nodes (long FX with a declared tail no longer than the window)
+    are recreated at the warm start with the state commands that reached them,
+    so by T their memory only holds what the replayed nodes fed them. State
+    commands (synthdefs, groups, buffers, control buses) before the warm start
+    are replayed ahead of it in order. A cut is refused where that is not
+    enough:
+
+      - a node with no known end that is not persistent (an infinite sustain,
+        or a feedback def with no declared tail) forbids every cut after it
+        starts + maxWarmup;
+      - a node that writes buffers forbids every later cut — buffer contents
+        depend on the whole history;
+      - any other node forbids cuts that would have to replay it from further
+        back than maxWarmup.
+
+    Consecutive segments overlap by a crossfade window; stitch() blends them
+    there and reports how far apart they were, which is the render's own check
+    that the warm-up was long enough. Pure logic: no engine, no IO.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "render/score.h"
+
+namespace ss_render {
+
+constexpr double kForever = std::numeric_limits<double>::infinity();
+
+// ── Def traits ───────────────────────────────────────────────────────────────
+
+// A duration: a constant plus the sum of some of the node's control values
+// (so "attack+decay+sustain+release" follows each note's arguments).
+struct TraitExpr {
+    bool                     set = false;
+    double                   constant = 0.0;
+    std::vector<std::string> controls;
+};
+
+struct DefTraits {
+    TraitExpr life;     // longest a node lives unless freed earlier
+    TraitExpr release;  // longest it lives after its gate goes to 0
+    TraitExpr tail;     // how long its output remembers its input/state;
+                        // declaring it marks the def persistent (long FX)
+};
+
+// Traits per def name; "*" is the fallback for undeclared defs.
+using TraitTable = std::map<std::string, DefTraits>;
+
+// Parse "<def|*> key=expr [key=expr...]" lines; '#' starts a comment. expr is
+// terms joined by '+', each a number (seconds) or a control name.
+inline bool parse_traits(const std::string& text, TraitTable& out, std::string& err) {
+    size_t lineNo = 0, pos = 0;
+    while (pos <= text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos) eol = text.size();
+        std::string line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+        ++lineNo;
+        if (const size_t hash = line.find('#'); hash != std::string::npos) line.resize(hash);
+        std::vector<std::string> words;
+        size_t i = 0;
+        while (i < line.size()) {
+            while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i]))) ++i;
+            size_t j = i;
+            while (j < line.size() && !std::isspace(static_cast<unsigned char>(line[j]))) ++j;
+            if (j > i) words.push_back(line.substr(i, j - i));
+            i = j;
+        }
+        if (words.empty()) continue;
+        DefTraits& t = out[words[0]];
+        for (size_t w = 1; w < words.size(); ++w) {
+            const size_t eq = words[w].find('=');
+            const std::string key = words[w].substr(0, eq);
+            TraitExpr* e = key == "life" ? &t.life : key == "release" ? &t.release
+                         : key == "tail" ? &t.tail : nullptr;
+            if (!e || eq == std::string::npos || eq + 1 >= words[w].size()) {
+                err = "line " + std::to_string(lineNo) + ": expected life=, release= or tail=";
+                return false;
+            }
+            *e = TraitExpr{};
+            e->set = true;
+            std::string rest = words[w].substr(eq + 1);
+            size_t s = 0;
+            while (s <= rest.size()) {
+                size_t plus = rest.find('+', s);
+                if (plus == std::string::npos) plus = rest.size();
+                const std::string term = rest.substr(s, plus - s);
+                char* end = nullptr;
+                const double v = std::strtod(term.c_str(), &end);
+                if (term.empty()) {
+                    err = "line " + std::to_string(lineNo) + ": empty term in " + key;
+                    return false;
+                }
+                if (end && *end == '\0') e->constant += v;
+                else e->controls.push_back(term);
+                s = plus + 1;
+            }
+        }
+    }
+    return true;
+}
+
+// ── Node analysis ────────────────────────────────────────────────────────────
+
+struct NodeSpan {
+    int32_t     id = 0;            // -1: auto-assigned, never addressable
+    std::string def;
+    double      start = 0.0;
+    double      end = kForever;    // kForever: no known end
+    double      tail = -1.0;       // < 0: not persistent
+    bool        writesBuffers = false;
+    bool        random = false;
+    bool        feedback = false;
+};
+
+enum class IssueKind { InfiniteSustain, UnboundedFeedback, BufferWrites, Nondeterministic, Unsupported };
+
+struct Issue {
+    IssueKind   kind;
+    double      time;      // where it starts to matter
+    std::string text;
+};
+
+struct Analysis {
+    std::vector<NodeSpan>             nodes;
+    // Per score event: the nodes a node command (/s_new, /n_*) addresses;
+    // empty for state commands.
+    std::vector<std::vector<int32_t>> eventNodes;
+    std::vector<Issue>                issues;
+};
+
+namespace detail {
+
+using Controls = std::map<std::string, float>;
+
+inline double eval_trait(const TraitExpr& e, const SynthDefInfo* def, const Controls& args) {
+    if (!e.set) return -1.0;
+    double v = e.constant;
+    for (const auto& name : e.controls) {
+        auto it = args.find(name);
+        if (it != args.end()) { v += it->second; continue; }
+        const int idx = def ? def->controlIndex(name.c_str()) : -1;
+        if (idx < 0) return -1.0;                           // unknown → no bound
+        v += def->defaults[size_t(idx)];
+    }
+    return std::max(0.0, v);
+}
+
+inline bool read_number(ss_host::OscReader& r, float& out) {
+    switch (r.peekType()) {
+        case 'f': return r.readFloat(out);
+        case 'i': { int32_t v; if (!r.readInt32(v)) return false; out = float(v); return true; }
+        case 'd': { double v; if (!r.readDouble(v)) return false; out = float(v); return true; }
+        default:  return false;
+    }
+}
+
+// Read "<control> <value>" pairs (name or index) until the arguments run out.
+inline void read_controls(ss_host::OscReader& r, const SynthDefInfo* def, Controls& out) {
+    while (r.peekType()) {
+        std::string name;
+        if (r.peekType() == 's') {
+            const char* s;
+            if (!r.readString(s)) return;
+            name = s;
+        } else if (r.peekType() == 'i') {
+            int32_t idx;
+            if (!r.readInt32(idx)) return;
+            if (def && idx >= 0 && size_t(idx) < def->controlNames.size())
+                name = def->controlNames[size_t(idx)];
+        } else {
+            return;
+        }
+        float v;
+        if (!read_number(r, v)) { if (!r.skip()) return; continue; }
+        if (!name.empty()) out[name] = v;
+    }
+}
+
+inline bool starts_with(const char* s, const char* prefix) {
+    return std::strncmp(s, prefix, std::strlen(prefix)) == 0;
+}
+
+}  // namespace detail
+
+// Follow every node through `score`. `defs` are the synthdefs the score uses
+// (from its /d_recv blobs and any files the caller loaded).
+inline Analysis analyse_score(const Score& score, const std::vector<SynthDefInfo>& defs,
+                              const TraitTable& traits) {
+    using namespace detail;
+    Analysis a;
+    a.eventNodes.resize(score.events.size());
+
+    std::map<std::string, const SynthDefInfo*> defByName;
+    for (const auto& d : defs) defByName[d.name] = &d;
+    std::deque<SynthDefInfo> inlineDefs;      // from /d_recv; deque keeps addresses
+    static const DefTraits kNoTraits;
+    auto traitsFor = [&](const std::string& name) -> const DefTraits& {
+        auto it = traits.find(name);
+        if (it != traits.end()) return it->second;
+        it = traits.find("*");
+        return it != traits.end() ? it->second : kNoTraits;
+    };
+
+    std::map<int32_t, int32_t> live;          // node id → index in a.nodes
+    std::map<int32_t, int32_t> parent;        // node/group id → parent group id
+    std::vector<Controls>      args;          // per node, for release exprs
+    std::set<std::string>      reported;
+
+    auto endNode = [&](int32_t idx, double t) {
+        NodeSpan& n = a.nodes[size_t(idx)];
+        if (t < n.end) n.end = t;
+    };
+    auto inGroup = [&](int32_t id, int32_t group) {
+        for (int hops = 0; hops < 1024; ++hops) {
+            auto it = parent.find(id);
+            if (it == parent.end()) return false;
+            if (it->second == group) return true;
+            id = it->second;
+        }
+        return false;
+    };
+    auto freeTree = [&](int32_t group, double t, bool includeSelf, std::vector<int32_t>& hit) {
+        for (auto it = live.begin(); it != live.end();) {
+            if (inGroup(it->first, group) || (includeSelf && it->first == group)) {
+                endNode(it->second, t);
+                hit.push_back(it->second);
+                it = live.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    };
+    auto parentFor = [&](int32_t action, int32_t target) {
+        if (action == 0 || action == 1) return target;      // head / tail of group
+        auto it = parent.find(target);                      // before / after / replace
+        return it != parent.end() ? it->second : 0;
+    };
+    auto note = [&](IssueKind k, double t, const std::string& key, const std::string& text) {
+        if (reported.insert(key).second) a.issues.push_back({k, t, text});
+    };
+
+    for (size_t e = 0; e < score.events.size(); ++e) {
+        const ScoreEvent& ev = score.events[e];
+        ss_host::OscReader r(ev.msg.data(), ev.msg.size());
+        if (!r.ok()) continue;
+        const char* addr = r.address();
+        const double t = ev.time;
+
+        if (std::strcmp(addr, "/d_recv") == 0) {
+            // Defs sent inline by the score are known from here on.
+            const uint8_t* blob;
+            uint32_t n;
+            std::vector<SynthDefInfo> got;
+            std::string err;
+            if (r.readBlob(blob, n) && scan_synthdefs(blob, n, got, err))
+                for (auto& d : got) {
+                    inlineDefs.push_back(std::move(d));
+                    defByName[inlineDefs.back().name] = &inlineDefs.back();
+                }
+        } else if (std::strcmp(addr, "/s_new") == 0) {
+            const char* defName;
+            int32_t id = -1, action = 0, target = 0;
+            if (!r.readString(defName)) continue;
+            r.readInt32(id);
+            r.readInt32(action);
+            r.readInt32(target);
+            const SynthDefInfo* def = defByName.count(defName) ? defByName[defName] : nullptr;
+            NodeSpan n;
+            n.id = id;
+            n.def = defName;
+            n.start = t;
+            Controls c;
+            read_controls(r, def, c);
+            const DefTraits& tr = traitsFor(defName);
+            const double life = eval_trait(tr.life, def, c);
+            if (life >= 0.0) n.end = t + life;
+            n.tail = eval_trait(tr.tail, def, c);
+            if (def) {
+                n.writesBuffers = def->writesBuffers;
+                n.random = def->random;
+                n.feedback = def->feedback;
+            }
+            if (action == 4) {                                  // replace target
+                auto it = live.find(target);
+                if (it != live.end()) {
+                    endNode(it->second, t);
+                    a.eventNodes[e].push_back(it->second);
+                    live.erase(it);
+                }
+            }
+            const int32_t idx = int32_t(a.nodes.size());
+            a.nodes.push_back(n);
+            args.push_back(std::move(c));
+            a.eventNodes[e].push_back(idx);
+            if (id >= 0) {
+                parent[id] = parentFor(action, target);
+                live[id] = idx;
+            }
+        } else if (std::strcmp(addr, "/g_new") == 0 || std::strcmp(addr, "/p_new") == 0) {
+            int32_t id, action, target;
+            while (r.readInt32(id) && r.readInt32(action) && r.readInt32(target))
+                parent[id] = parentFor(action, target);
+        } else if (std::strcmp(addr, "/n_free") == 0) {
+            int32_t id;
+            while (r.readInt32(id)) {
+                auto it = live.find(id);
+                if (it != live.end()) {
+                    endNode(it->second, t);
+                    a.eventNodes[e].push_back(it->second);
+                    live.erase(it);
+                } else {
+                    freeTree(id, t, false, a.eventNodes[e]);    // freeing a group
+                }
+            }
+        } else if (std::strcmp(addr, "/g_freeAll") == 0 || std::strcmp(addr, "/g_deepFree") == 0) {
+            int32_t id;
+            while (r.readInt32(id)) freeTree(id, t, false, a.eventNodes[e]);
+        } else if (std::strcmp(addr, "/n_set") == 0) {
+            int32_t id;
+            if (!r.readInt32(id)) continue;
+            auto it = live.find(id);
+            if (it == live.end()) continue;
+            const int32_t idx = it->second;
+            a.eventNodes[e].push_back(idx);
+            NodeSpan& n = a.nodes[size_t(idx)];
+            const SynthDefInfo* def = defByName.count(n.def) ? defByName[n.def] : nullptr;
+            Controls c;
+            read_controls(r, def, c);
+            for (const auto& kv : c) args[size_t(idx)][kv.first] = kv.second;
+            auto g = c.find("gate");
+            if (g != c.end() && g->second <= 0.0f) {
+                const double rel = eval_trait(traitsFor(n.def).release, def, args[size_t(idx)]);
+                if (rel >= 0.0) endNode(idx, t + rel);
+            }
+        } else if (starts_with(addr, "/n_")) {
+            // Other node commands address the nodes among their int arguments;
+            // those followed by controls address only the first. /n_order's
+            // first two ints are an add action and a target.
+            const bool single = starts_with(addr, "/n_set") || starts_with(addr, "/n_map") ||
+                                std::strcmp(addr, "/n_fill") == 0;
+            int skip = std::strcmp(addr, "/n_order") == 0 ? 2 : 0;
+            while (r.peekType()) {
+                int32_t id;
+                if (r.peekType() != 'i') { if (!r.skip()) break; continue; }
+                r.readInt32(id);
+                if (skip > 0) { --skip; continue; }
+                auto it = live.find(id);
+                if (it != live.end()) a.eventNodes[e].push_back(it->second);
+                if (single) break;
+            }
+        } else if (std::strcmp(addr, "/b_allocRead") == 0 || std::strcmp(addr, "/b_allocReadChannel") == 0 ||
+                   std::strcmp(addr, "/b_read") == 0 || std::strcmp(addr, "/b_readChannel") == 0 ||
+                   std::strcmp(addr, "/b_write") == 0 || std::strcmp(addr, "/d_load") == 0 ||
+                   std::strcmp(addr, "/d_loadDir") == 0) {
+            note(IssueKind::Unsupported, t, addr,
+                 std::string(addr) + " needs file access, which the offline renderer does not "
+                 "have; load synthdefs with --synthdefs and fill buffers with /b_alloc + /b_setn");
+        }
+    }
+
+    // Per-node verdicts, reported once per def.
+    for (const NodeSpan& n : a.nodes) {
+        if (n.writesBuffers)
+            note(IssueKind::BufferWrites, n.start, "buf:" + n.def,
+                 n.def + " writes buffers; no cut is possible after it starts");
+        if (n.feedback && n.tail < 0.0)
+            note(IssueKind::UnboundedFeedback, n.start, "fb:" + n.def,
+                 n.def + " feeds its output back (LocalIn/InFeedback) with no declared tail; "
+                 "cuts must wait until each instance ends");
+        if (n.end == kForever && n.tail < 0.0)
+            note(IssueKind::InfiniteSustain, n.start, "inf:" + n.def,
+                 n.def + " (first at " + std::to_string(n.start) + "s) has no known end — no "
+                 "/n_free, no gate release with a release trait, no life trait");
+        if (n.random)
+            note(IssueKind::Nondeterministic, n.start, "rnd:" + n.def,
+                 n.def + " uses random UGens; a segmented render matches a serial one only "
+                 "statistically");
+    }
+    return a;
+}
+
+// ── Segment planning ─────────────────────────────────────────────────────────
+
+struct PlanOptions {
+    uint32_t segments   = 4;      // wanted; fewer if the score won't cut
+    double   warmup     = 2.0;    // s: window persistent nodes must forget in
+    double   maxWarmup  = 8.0;    // s: furthest back a segment may start
+    double   crossfade  = 0.05;   // s: overlap between neighbours
+    double   minSegment = 1.0;    // s
+    double   tail       = 0.0;    // s rendered past the last event
+    double   sampleRate = 48000.0;
+    uint32_t blockFrames = 64;    // cuts and warm starts land on block edges
+};
+
+struct Segment {
+    int64_t warmFrame  = 0;   // rendering starts here
+    int64_t startFrame = 0;   // output starts here (the cut)
+    int64_t endFrame   = 0;   // output ends here (next cut / end of score)
+    int64_t renderEnd  = 0;   // rendering ends here (endFrame + crossfade)
+};
+
+struct Plan {
+    std::vector<Segment> segments;
+    int64_t              totalFrames = 0;
+    int64_t              crossfadeFrames = 0;
+    std::vector<std::string> notes;   // why fewer cuts than asked for, etc.
+};
+
+inline int64_t seconds_to_frames(double s, double sr) { return int64_t(std::llround(s * sr)); }
+
+inline Plan plan_segments(const Score& score, const Analysis& a, const PlanOptions& o) {
+    Plan p;
+    const double sr = o.sampleRate;
+    const int64_t bl = std::max<int64_t>(1, o.blockFrames);
+    p.totalFrames = std::max<int64_t>(bl, int64_t(std::ceil((score.duration() + o.tail) * sr)));
+    p.crossfadeFrames = std::max<int64_t>(1, seconds_to_frames(o.crossfade, sr));
+    const double W = o.warmup, M = std::max(o.warmup, o.maxWarmup);
+    auto persistent = [&](const NodeSpan& n) {
+        return n.tail >= 0.0 && n.tail <= W && !n.writesBuffers;
+    };
+
+    // Forbidden cut times, as open intervals.
+    std::vector<std::pair<double, double>> forbid;
+    for (const NodeSpan& n : a.nodes) {
+        if (n.writesBuffers) forbid.push_back({n.start + M, kForever});
+        else if (!persistent(n)) forbid.push_back({n.start + M, n.end + W});
+    }
+    std::sort(forbid.begin(), forbid.end());
+    std::vector<std::pair<double, double>> merged;
+    for (const auto& f : forbid) {
+        if (f.second <= f.first) continue;
+        if (!merged.empty() && f.first <= merged.back().second)
+            merged.back().second = std::max(merged.back().second, f.second);
+        else
+            merged.push_back(f);
+    }
+    auto allowed = [&](double t) {
+        auto it = std::upper_bound(merged.begin(), merged.end(), std::make_pair(t, kForever));
+        if (it == merged.begin()) return true;
+        --it;
+        return !(t > it->first && t < it->second);
+    };
+
+    // Nearest allowed block edge to each ideal cut.
+    const double dur = double(p.totalFrames) / sr;
+    const int64_t minGap = std::max(p.crossfadeFrames, seconds_to_frames(o.minSegment, sr));
+    std::vector<int64_t> cuts;
+    const uint32_t want = std::max<uint32_t>(1, o.segments);
+    for (uint32_t k = 1; k < want; ++k) {
+        const double ideal = dur * k / want;
+        // Candidate edges: the ideal itself and the borders of whichever
+        // forbidden interval holds it.
+        std::vector<double> cands{ideal};
+        for (const auto& m : merged)
+            if (ideal > m.first && ideal < m.second) { cands = {m.first, m.second}; break; }
+        int64_t best = -1;
+        double bestDist = kForever;
+        for (double c : cands) {
+            if (!(c < kForever)) continue;
+            for (int64_t f : {int64_t(std::floor(c * sr / bl)) * bl, int64_t(std::ceil(c * sr / bl)) * bl}) {
+                if (f <= 0 || f >= p.totalFrames) continue;
+                if (!allowed(double(f) / sr)) continue;
+                const double d = std::fabs(double(f) / sr - ideal);
+                if (d < bestDist) { bestDist = d; best = f; }
+            }
+        }
+        if (best < 0) continue;
+        const int64_t prev = cuts.empty() ? 0 : cuts.back();
+        if (best - prev < minGap || p.totalFrames - best < minGap) continue;
+        cuts.push_back(best);
+    }
+    if (cuts.size() + 1 < want)
+        p.notes.push_back("asked for " + std::to_string(want) + " segments; the score allows " +
+                          std::to_string(cuts.size() + 1));
+
+    // Warm starts: back far enough to replay every non-persistent node still
+    // sounding in the warm-up window from its own start.
+    std::vector<int64_t> starts{0};
+    starts.insert(starts.end(), cuts.begin(), cuts.end());
+    for (size_t k = 0; k < starts.size(); ++k) {
+        Segment s;
+        s.startFrame = starts[k];
+        s.endFrame = k + 1 < starts.size() ? starts[k + 1] : p.totalFrames;
+        s.renderEnd = k + 1 < starts.size() ? std::min(p.totalFrames, s.endFrame + p.crossfadeFrames)
+                                            : p.totalFrames;
+        double warm = double(s.startFrame) / sr - W;
+        if (k == 0) warm = 0.0;
+        const double T = double(s.startFrame) / sr;
+        for (const NodeSpan& n : a.nodes)
+            if (k > 0 && !persistent(n) && n.start < T && n.end > T - W) warm = std::min(warm, n.start);
+        s.warmFrame = std::max<int64_t>(0, int64_t(std::floor(warm * sr / bl)) * bl);
+        p.segments.push_back(s);
+    }
+    return p;
+}
+
+// ── Segment scripts ──────────────────────────────────────────────────────────
+
+// What one engine performs: `preroll` immediately, in order, before the first
+// rendered block; `timed` at their score times.
+struct SegmentScript {
+    std::vector<const ScoreEvent*> preroll;
+    std::vector<const ScoreEvent*> timed;
+    int64_t warmFrame = 0;
+    int64_t renderEnd = 0;
+};
+
+inline SegmentScript segment_script(const Score& score, const Analysis& a, const Segment& s,
+                                    const PlanOptions& o) {
+    SegmentScript out;
+    out.warmFrame = s.warmFrame;
+    out.renderEnd = s.renderEnd;
+    const double sr = o.sampleRate;
+    const double ws = double(s.warmFrame) / sr;
+    const double endT = double(s.renderEnd) / sr;
+    const double W = o.warmup;
+
+    // Nodes created before the warm start are dropped unless persistent and
+    // still alive at it; those are carried (recreated by the preroll).
+    std::vector<uint8_t> dropped(a.nodes.size(), 0);
+    for (size_t i = 0; i < a.nodes.size(); ++i) {
+        const NodeSpan& n = a.nodes[i];
+        if (s.warmFrame == 0 || n.start >= ws) continue;
+        const bool carried = n.tail >= 0.0 && n.tail <= W && !n.writesBuffers && n.end > ws;
+        dropped[i] = carried ? 0 : 1;
+    }
+    auto keep = [&](size_t e) {
+        const auto& nodes = a.eventNodes[e];
+        if (nodes.empty()) return true;
+        for (int32_t n : nodes)
+            if (!dropped[size_t(n)]) return true;
+        return false;
+    };
+    // The last segment also performs events landing exactly on its end.
+    const bool last = s.renderEnd == s.endFrame;
+    for (size_t e = 0; e < score.events.size(); ++e) {
+        const ScoreEvent& ev = score.events[e];
+        if (ev.time > endT || (ev.time == endT && !last)) break;
+        if (!keep(e)) continue;
+        if (s.warmFrame > 0 && ev.time < ws) out.preroll.push_back(&ev);
+        else out.timed.push_back(&ev);
+    }
+    return out;
+}
+
+// ── Stitching ────────────────────────────────────────────────────────────────
+
+struct JointReport {
+    int64_t frame   = 0;     // the cut
+    float   maxDiff = 0.0f;  // largest |a - b| across the crossfade
+};
+
+// Blend rendered segments (interleaved, `channels` wide, each starting at its
+// warmFrame) into `out` (totalFrames × channels), crossfading each neighbour
+// pair across [cut, cut + crossfade).
+inline std::vector<JointReport> stitch(const Plan& plan, uint32_t channels,
+                                       const std::vector<const float*>& rendered, float* out) {
+    std::vector<JointReport> joints;
+    const int64_t X = plan.crossfadeFrames;
+    for (size_t k = 0; k < plan.segments.size(); ++k) {
+        const Segment& s = plan.segments[k];
+        const float* src = rendered[k];
+        for (int64_t f = s.startFrame; f < s.endFrame; ++f) {
+            const float* from = src + size_t(f - s.warmFrame) * channels;
+            std::memcpy(out + size_t(f) * channels, from, sizeof(float) * channels);
+        }
+        if (k == 0) continue;
+        const Segment& prev = plan.segments[k - 1];
+        const float* psrc = rendered[k - 1];
+        JointReport j;
+        j.frame = s.startFrame;
+        const int64_t n = std::min<int64_t>(X, std::min(prev.renderEnd, s.endFrame) - s.startFrame);
+        for (int64_t i = 0; i < n; ++i) {
+            const int64_t f = s.startFrame + i;
+            const float g = (float(i) + 0.5f) / float(n);
+            const float* pa = psrc + size_t(f - prev.warmFrame) * channels;
+            float* o = out + size_t(f) * channels;
+            for (uint32_t c = 0; c < channels; ++c) {
+                j.maxDiff = std::max(j.maxDiff, std::fabs(pa[c] - o[c]));
+                o[c] = pa[c] * (1.0f - g) + o[c] * g;
+            }
+        }
+        joints.push_back(j);
+    }
+    return joints;
+}
+
+}  // namespace ss_render
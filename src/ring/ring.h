@@ -27,3 +27,8 @@ struct alignas(4) Message {
 
 constexpr uint32_t MESSAGE_MAGIC = 0xDEADBEEF;
 constexpr uint32_t PADDING_MAGIC = 0xBADDCAFE;  // end-of-ring pad marker; frame restarts at offset 0
+
+// sourceId flag on IN-ring frames: the payload is a pre-decoded command record
+// (cmd_record.h), not raw OSC. The low 31 bits remain the origin token, so
+// origin tokens are 31-bit. The ring itself never looks at it.
+constexpr uint32_t SOURCE_ID_PRECODED = 0x80000000u;
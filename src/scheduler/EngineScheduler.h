@@ -20,6 +20,7 @@
 
 #include "Scheduler.h"
 #include "../memory_profile.h"
+#include "../latency_trace.h"   // kSsLatencyUntraced
 
 class EngineScheduler {
 public:
@@ -32,17 +33,37 @@ public:
     // Per-event metadata: the origin token of the ingress message that scheduled
     // it, so a due event's reply (synth) routes back to that caller. 0 = no/broadcast
     // origin (e.g. engine-generated MIDI clock). Carried opaquely — just a number.
-    struct EngineMeta { uint32_t origin = 0; };
+    // ingressUs/latencyClass carry a latency-trace stamp (latency_trace.h) to the
+    // fire; kSsLatencyUntraced = untraced.
+    struct EngineMeta {
+        uint32_t origin = 0;
+        uint32_t ingressUs = 0;
+        uint8_t  latencyClass = kSsLatencyUntraced;
+    };
 
     using Core  = Scheduler<EngineMeta, SCHEDULER_SLOT_COUNT, SCHEDULER_DATA_POOL_SIZE>;
     using Event = Core::Event;
 
+    // Pluggable look-ahead over the OSC the engine runs (sample prefetch, ...).
+    // admit() sees each event as it is queued, with its timetag: the earliest
+    // point anything can act on it. due() sees every packet as it dispatches,
+    // queued or immediate (`when` = 0). Both run on the audio thread inside the
+    // drain, so they must be RT-safe and return early on anything of no
+    // interest. Either may be null; the scan must outlive its installation.
+    struct Scan {
+        void (*admit)(void* ctx, const uint8_t* osc, uint32_t len, int64_t when) = nullptr;
+        void (*due)(void* ctx, const uint8_t* osc, uint32_t len, int64_t when)   = nullptr;
+        void* ctx = nullptr;
+    };
+
     // Store an OSC packet to fire at timetag `when`, keyed by `tag` (for flush),
-    // carrying the scheduling caller's `origin`. Rejects oversize payloads and a
-    // full pool (both counted as drops). RT-safe.
-    bool addScheduled(int64_t when, uint32_t tag, uint32_t origin, const uint8_t* osc, uint32_t len) {
+    // carrying the scheduling caller's `origin` (and, when traced, its ingress
+    // stamp). Rejects oversize payloads and a full pool (both counted as drops).
+    // RT-safe.
+    bool addScheduled(int64_t when, uint32_t tag, uint32_t origin, const uint8_t* osc, uint32_t len,
+                      uint32_t ingressUs = 0, uint8_t latencyClass = kSsLatencyUntraced) {
         if (len > kMaxPayload) { mDropped.fetch_add(1, std::memory_order_relaxed); return false; }
-        if (!mCore.add(when, tag, EngineMeta{origin}, osc, len)) {
+        if (!mCore.add(when, tag, EngineMeta{origin, ingressUs, latencyClass}, osc, len)) {
             mDropped.fetch_add(1, std::memory_order_relaxed);   // pool full
             return false;
         }
@@ -57,15 +78,21 @@ public:
     void     requestClear() { mCore.requestClear(); }
     bool     drainPendingClear() { return mCore.drainPendingClear(); }
     int      size() const { return mCore.size(); }
+    int64_t  nextTime() const { return mCore.nextTime(); }   // INT64_MAX if empty
     bool     full() const { return mCore.full(); }
 
     // Events dropped before reaching the queue (oversize vs the data pool, or
     // pool momentarily full).
     uint32_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
 
+    // Install (or clear, with nullptr) the look-ahead scan. Any thread.
+    void        setScan(const Scan* scan) { mScan.store(scan, std::memory_order_release); }
+    const Scan* scan() const { return mScan.load(std::memory_order_acquire); }
+
 private:
-    Core                  mCore;
-    std::atomic<uint32_t> mDropped{0};
+    Core                     mCore;
+    std::atomic<uint32_t>    mDropped{0};
+    std::atomic<const Scan*> mScan{nullptr};
 };
 
 // The process-wide scheduler (defined in audio_processor.cpp, where it is
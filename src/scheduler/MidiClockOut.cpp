@@ -6,6 +6,7 @@
 #include "EngineScheduler.h"
 #include "SuperClock.h"
 #include "osc/OscOutboundPacketStream.h"
+#include "../lanes/lanes.h"   // ss_idle_wake
 
 #include <utility>
 
@@ -25,17 +26,22 @@ std::vector<uint8_t> MidiClockOut::encodeClockTick(const std::string& port) {
 void MidiClockOut::reset() {
     std::lock_guard<std::mutex> guard(mLock);
     mPending.clear();
+    mPendingCount.store(0, std::memory_order_relaxed);
 }
 
 void MidiClockOut::onBeat(SuperClock& clock, const std::string& port, double durationSeconds) {
     const double now = clock.now();
     auto osc = encodeClockTick(port);
-    std::lock_guard<std::mutex> guard(mLock);
-    for (int64_t i = 0; i < kPulsesPerBeat; ++i) {
-        const double t = now + durationSeconds * static_cast<double>(i)
-                                   / static_cast<double>(kPulsesPerBeat);
-        mPending.push_back({t, osc});
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        for (int64_t i = 0; i < kPulsesPerBeat; ++i) {
+            const double t = now + durationSeconds * static_cast<double>(i)
+                                       / static_cast<double>(kPulsesPerBeat);
+            mPending.push_back({t, osc});
+        }
+        mPendingCount.store(static_cast<uint32_t>(mPending.size()), std::memory_order_relaxed);
     }
+    ss_idle_wake();   // an idle host must tick again to generate the burst
 }
 
 void MidiClockOut::generate(double nowNtp) {
@@ -57,4 +63,5 @@ void MidiClockOut::generate(double nowNtp) {
         }
     }
     mPending.resize(w);   // shrink only — no allocation on the audio thread
+    mPendingCount.store(static_cast<uint32_t>(w), std::memory_order_relaxed);
 }
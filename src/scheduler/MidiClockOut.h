@@ -13,6 +13,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <string>
@@ -38,6 +39,9 @@ public:
     // try_lock — a block skipped on contention is caught up by the next call.
     void generate(double nowNtp);
 
+    // No burst ticks waiting to be scheduled (the engine's idle check). Any thread.
+    bool idle() const { return mPendingCount.load(std::memory_order_relaxed) == 0; }
+
 private:
     // A one-shot OSC packet to emit at an absolute NTP time (a burst tick).
     struct Pending {
@@ -45,8 +49,9 @@ private:
         std::vector<uint8_t> osc;
     };
 
-    std::mutex           mLock;
-    std::vector<Pending> mPending;
+    std::mutex            mLock;
+    std::vector<Pending>  mPending;
+    std::atomic<uint32_t> mPendingCount{0};   // mPending.size(), written under mLock
 
     static std::vector<uint8_t> encodeClockTick(const std::string& port);
 };
@@ -23,6 +23,8 @@
 #include <cstdint>
 #include <cstring>
 
+#include "../usdt.h"
+
 // Stable 32-bit hash of a tag string (FNV-1a). Shared by producers and the
 // flush side so the same string keys the same events. Never returns 0 — 0 is
 // reserved as the flush wildcard ("cancel everything").
@@ -92,6 +94,7 @@ public:
         s.inUse     = true;
 
         heapPush(when, s.stability, static_cast<int16_t>(slot));
+        SS_PROBE4(sched_insert, when, tag, size, mLive);
         return true;
     }
 
@@ -122,15 +125,19 @@ public:
     // slots are freed and the heap is rebuilt from the survivors, so the heap
     // never carries dead entries. RT-safe (no allocation); O(n) over the pool.
     void flush(uint32_t tag) {
-        if (tag == 0) { reset(); return; }
+        if (tag == 0) { clear(); return; }
         bool freedAny = false;
         for (int i = 0; i < SlotCount; ++i) {
             if (mPool[i].inUse && mPool[i].tag == tag) { freeSlot(i); freedAny = true; }
         }
         if (freedAny) rebuildHeap();
+        SS_PROBE2(sched_flush, tag, mLive);
     }
 
-    void clear() { reset(); }
+    void clear() {
+        reset();
+        SS_PROBE2(sched_flush, 0u, 0);
+    }
 
     int      size() const { return mLive; }
     bool     full() const { return mQueueSize >= SlotCount; }
@@ -144,7 +151,7 @@ public:
     void requestClear() { mClearPending.store(true, std::memory_order_release); }
     bool drainPendingClear() {
         if (mClearPending.exchange(false, std::memory_order_acquire)) {
-            reset();
+            clear();
             return true;
         }
         return false;
@@ -10,11 +10,15 @@
  * host run the SAME loop; only the dispatch sink differs (the engine routes
  * through its OscIngress with the synth default; the host through its own, with
  * no synth registered). `Scheduler` is duck-typed: popDue → Event{valid, data,
- * size, when, meta->origin} → release.
+ * size, when, meta->origin} → release. A sink that takes a sixth argument also
+ * gets the event's whole metadata (the engine's latency-trace stamp).
  */
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
+
+#include "../usdt.h"
 
 template <class Scheduler, class DispatchFn>
 inline void ss_fire_due(Scheduler& sched, int64_t nextTime, int64_t blockTime,
@@ -22,7 +26,12 @@ inline void ss_fire_due(Scheduler& sched, int64_t nextTime, int64_t blockTime,
     for (;;) {
         auto ev = sched.popDue(nextTime);
         if (!ev.valid()) break;
-        dispatch(ev.data, ev.size, ev.meta->origin, ev.when, blockTime);
+        SS_PROBE4(sched_fire, ev.when, blockTime, ev.meta->origin, ev.size);
+        if constexpr (std::is_invocable_v<DispatchFn&, const uint8_t*, uint32_t, uint32_t,
+                                          int64_t, int64_t, decltype(*ev.meta)>)
+            dispatch(ev.data, ev.size, ev.meta->origin, ev.when, blockTime, *ev.meta);
+        else
+            dispatch(ev.data, ev.size, ev.meta->origin, ev.when, blockTime);
         sched.release(ev);
     }
 }
@@ -149,7 +149,7 @@ static_assert((SHM_SCOPE_START + SHM_SCOPE_HEADER_SIZE) % 16 == 0,
 // native-only observability that has no WASM counterpart (DSP load, JUCE audio
 // callback overruns), which keeps PerformanceMetrics a clean cross-platform
 // surface rather than a pile of fields that are 0 on half the runtimes.
-constexpr uint32_t NATIVE_STATS_SIZE  = 32;  // u32 x8 (see field offsets below)
+constexpr uint32_t NATIVE_STATS_SIZE  = 104; // u32 x26 (see field offsets below)
 constexpr uint32_t NATIVE_STATS_START = SHM_SCOPE_START + SHM_SCOPE_TOTAL_SIZE;
 // Field byte offsets within the native-stats region.
 constexpr uint32_t NATIVE_STAT_SYNTHDEFS      = 0;
@@ -166,6 +166,113 @@ constexpr uint32_t NATIVE_STAT_CB_OVERRUNS    = 20;  // audio callbacks that ove
 // show until it ends.
 constexpr uint32_t NATIVE_STAT_NRT_MAX_PASS_MS  = 24;
 constexpr uint32_t NATIVE_STAT_NRT_IN_FLIGHT_MS = 28;
+// Per-connection egress queues of the command transport (stream servers; 0 for
+// transports that send inline). MAX_QUEUE is the deepest single connection's
+// backlog right now — one stalled client shows here without holding up others.
+constexpr uint32_t NATIVE_STAT_EGRESS_MAX_QUEUE_BYTES = 32;
+constexpr uint32_t NATIVE_STAT_EGRESS_DROPPED         = 36;  // frames dropped by a full queue
+constexpr uint32_t NATIVE_STAT_EGRESS_OVERFLOW_CLOSES = 40;  // clients disconnected by a full queue
+// Lazily resident samples (SampleResidency). A late load is a /s_new that
+// found its registered buffer missing — the prefetch did not land in time.
+constexpr uint32_t NATIVE_STAT_PREFETCH_HITS   = 44;
+constexpr uint32_t NATIVE_STAT_LATE_LOADS      = 48;
+constexpr uint32_t NATIVE_STAT_EVICTIONS       = 52;
+constexpr uint32_t NATIVE_STAT_RESIDENT_KIB    = 56;  // KiB held by registered samples (u32
+                                                      // bytes would wrap at 4 GiB)
+// Smoothing units (Lag family, Ramp, VarLag) parked on their constant-fill
+// calc function because their output has settled.
+constexpr uint32_t NATIVE_STAT_CONVERGED_UNITS = 60;
+// FFT/IFFT transforms: the running total, and the most run in any one block
+// since the previous publish (~64 blocks). Staggered hop phases keep the peak
+// near total / hop rather than every chain at once.
+constexpr uint32_t NATIVE_STAT_FFT_TRANSFORMS = 64;
+constexpr uint32_t NATIVE_STAT_FFT_BLOCK_PEAK = 68;
+// Unit-constructor RTAllocs served from per-node arenas and from the pool, and
+// synths constructed: (arena + pool) / synths is the allocations per /s_new.
+constexpr uint32_t NATIVE_STAT_ARENA_ALLOCS      = 72;
+constexpr uint32_t NATIVE_STAT_ARENA_POOL_ALLOCS = 76;
+constexpr uint32_t NATIVE_STAT_ARENA_SYNTHS      = 80;
+// Blocks the engine did not render because it was idle (no synths, nothing
+// drained or due): skipped inside the tick, or never ticked by a sleeping host.
+constexpr uint32_t NATIVE_STAT_IDLE_BLOCKS       = 84;
+// IN-ring frames that arrived as pre-decoded command records (cmd_record.h)
+// and ran through the jump table rather than the OSC parse.
+constexpr uint32_t NATIVE_STAT_PRECODED_CMDS     = 88;
+// Runtime World growth (SC_WorldResize.h): resizes applied, how long the last
+// one held the audio thread, and the memory all of them added.
+constexpr uint32_t NATIVE_STAT_WORLD_RESIZES        = 92;
+constexpr uint32_t NATIVE_STAT_WORLD_RESIZE_APPLY_US = 96;
+constexpr uint32_t NATIVE_STAT_WORLD_RESIZE_BYTES   = 100;
+
+// Command latency trace (latency_trace.h): how long IN-ring commands waited
+// between ss_ingress_write and being performed (immediate) or fired
+// (scheduled), as log2-microsecond histograms per origin token and per
+// delivery class. Written only while tracing is enabled, by the audio thread
+// alone; all fields are u32. Bucket 0 = 0 µs, bucket b = [2^(b-1), 2^b) µs,
+// the last bucket everything longer. EPOCH bumps on each reset (tracing
+// re-enabled), after the counters are zeroed.
+constexpr uint32_t LATENCY_TRACE_ORIGINS = 8;   // last row: every origin past the first 7
+constexpr uint32_t LATENCY_TRACE_CLASSES = 3;   // immediate, bundle, /schedule
+constexpr uint32_t LATENCY_TRACE_BUCKETS = 24;
+constexpr uint32_t LATENCY_TRACE_START =
+    (NATIVE_STATS_START + NATIVE_STATS_SIZE + 15u) & ~15u;
+// Field byte offsets within the latency-trace region.
+constexpr uint32_t LATENCY_TRACE_ENABLED    = 0;   // u32 1 while tracing
+constexpr uint32_t LATENCY_TRACE_EPOCH      = 4;   // u32 reset count
+                                                   // [8..15] reserved
+constexpr uint32_t LATENCY_TRACE_ORIGIN_IDS = 16;  // u32[ORIGINS] origin token + 1 (0 = unused row)
+constexpr uint32_t LATENCY_TRACE_MAX_US     = 48;  // u32[CLASSES] longest wait per class
+                                                   // [60..63] reserved
+constexpr uint32_t LATENCY_TRACE_COUNTS     = 64;  // u32[ORIGINS][CLASSES][BUCKETS]
+constexpr uint32_t LATENCY_TRACE_SIZE =
+    LATENCY_TRACE_COUNTS + LATENCY_TRACE_ORIGINS * LATENCY_TRACE_CLASSES * LATENCY_TRACE_BUCKETS * 4;
+static_assert(LATENCY_TRACE_ORIGIN_IDS + LATENCY_TRACE_ORIGINS * 4 <= LATENCY_TRACE_MAX_US &&
+              LATENCY_TRACE_MAX_US + LATENCY_TRACE_CLASSES * 4 <= LATENCY_TRACE_COUNTS,
+              "latency-trace header fields overlap");
+
+// Bus meters (bus_meter.h): per-channel peak, RMS and true peak of the
+// hardware outputs and of up to METER_MAX_BUSES client-selected audio buses,
+// measured by the audio thread after each graph pass. Two halves:
+//   request   client-written. Write the fields, then bump REQ_GEN; the engine
+//             applies the request at its next block. Values are validated
+//             there, so a torn or hostile request only meters the wrong bus.
+//   published audio-thread-written under SEQ (seqlock, as SAMPLE_CLOCK_SEQ):
+//             the applied configuration and one row of levels per channel,
+//             outputs first, then the buses in request order.
+// Levels are linear amplitude, f32. PEAK and TRUE_PEAK fall 20 dB in PEAK_MS;
+// RMS integrates the mean square over an RMS_MS time constant; MAX is the
+// highest true peak since the request was applied (a clip indicator).
+constexpr uint32_t METER_MAX_OUTPUTS  = 16;
+constexpr uint32_t METER_MAX_BUSES    = 16;
+constexpr uint32_t METER_MAX_CHANNELS = METER_MAX_OUTPUTS + METER_MAX_BUSES;
+constexpr uint32_t METER_FLAG_ON        = 1u;   // meter at all (off: one load per block)
+constexpr uint32_t METER_FLAG_TRUE_PEAK = 2u;   // 4x-oversampled true peak (off: = sample peak)
+constexpr uint32_t METER_START =
+    (LATENCY_TRACE_START + LATENCY_TRACE_SIZE + 15u) & ~15u;
+// Field byte offsets within the meter region — request half.
+constexpr uint32_t METER_REQ_GEN       = 0;   // u32 bumped after the fields below
+constexpr uint32_t METER_REQ_FLAGS     = 4;   // u32 METER_FLAG_*
+constexpr uint32_t METER_REQ_RMS_MS    = 8;   // u32 0 = default (300)
+constexpr uint32_t METER_REQ_PEAK_MS   = 12;  // u32 0 = default (1700)
+constexpr uint32_t METER_REQ_BUS_COUNT = 16;  // u32
+                                              // [20..31] reserved
+constexpr uint32_t METER_REQ_BUSES     = 32;  // u32[MAX_BUSES] audio bus indices
+// Published half.
+constexpr uint32_t METER_SEQ           = 96;  // u32 seqlock (odd = mid-update)
+constexpr uint32_t METER_GEN           = 100; // u32 REQ_GEN of the applied request
+constexpr uint32_t METER_FLAGS         = 104; // u32 applied METER_FLAG_*
+constexpr uint32_t METER_OUTPUTS       = 108; // u32 output rows
+constexpr uint32_t METER_BUSES         = 112; // u32 bus rows (invalid indices dropped)
+constexpr uint32_t METER_RMS_MS        = 116; // u32
+constexpr uint32_t METER_PEAK_MS       = 120; // u32
+constexpr uint32_t METER_BLOCKS        = 124; // u32 blocks metered since applied
+constexpr uint32_t METER_BUS_IDS       = 128; // u32[MAX_BUSES] bus index of each bus row
+constexpr uint32_t METER_ROWS          = 192; // f32[MAX_CHANNELS][4] peak, rms, true peak, max
+constexpr uint32_t METER_ROW_SIZE      = 16;
+constexpr uint32_t METER_SIZE = METER_ROWS + METER_MAX_CHANNELS * METER_ROW_SIZE;
+static_assert(METER_REQ_BUSES + METER_MAX_BUSES * 4 <= METER_SEQ &&
+              METER_BUS_IDS + METER_MAX_BUSES * 4 <= METER_ROWS,
+              "meter fields overlap");
 
 // SuperClock's sample clock — the engine's sample position anchored to
 // wall-clock DAC time. One anchor plus the rate defines the whole line
@@ -177,7 +284,7 @@ constexpr uint32_t NATIVE_STAT_NRT_IN_FLIGHT_MS = 28;
 // scope streams, plus anything needing audible-time alignment (recording
 // markers, visual sync). See docs/scope-streams-sample-clock.md.
 constexpr uint32_t SAMPLE_CLOCK_SIZE  = 32;
-constexpr uint32_t SAMPLE_CLOCK_START = (NATIVE_STATS_START + NATIVE_STATS_SIZE + 15u) & ~15u;
+constexpr uint32_t SAMPLE_CLOCK_START = (METER_START + METER_SIZE + 15u) & ~15u;
 // Field byte offsets within the sample-clock region.
 constexpr uint32_t SAMPLE_CLOCK_SEQ            = 0;   // u32 seqlock (odd = mid-update)
 constexpr uint32_t SAMPLE_CLOCK_SAMPLE_RATE    = 4;   // u32
@@ -489,6 +596,8 @@ struct BufferLayout {
     uint32_t padding_magic;
     uint32_t scheduler_data_pool_size;
     uint32_t scheduler_slot_count;
+    uint32_t meter_start;
+    uint32_t meter_size;
     uint8_t ring_padding_marker;
     uint8_t _padding[3];  // Align to 4 bytes
 };
@@ -545,6 +654,8 @@ constexpr BufferLayout BUFFER_LAYOUT = {
     PADDING_MAGIC,
     SCHEDULER_DATA_POOL_SIZE,
     SCHEDULER_SLOT_COUNT,
+    METER_START,
+    METER_SIZE,
     RING_PADDING_MARKER,
     {0, 0, 0}  // padding
 };
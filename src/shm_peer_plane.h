@@ -12,9 +12,11 @@
  * through a pair of message-framed SPSC rings, using the same wire format as
  * every other SuperSonic ring (ring/ring.h; RingBufferWriter / ring_drain).
  *
- *   command ring: peer produces, the host's NRT gateway consumes and feeds
- *                 the ordinary ingest path (so routing, scheduling, and reply
- *                 tokens behave exactly as they do for socket transports).
+ *   command ring: peer produces, the host's audio thread consumes it as a
+ *                 second IN lane (process_audio, after the IN ring), so
+ *                 routing, scheduling, and reply tokens behave exactly as
+ *                 they do for socket transports, without the extra copy
+ *                 through the IN ring.
  *   reply ring:   the NRT gateway produces (ShmTransport — the gateway is the
  *                 sole transport caller, so single-producer holds by
  *                 construction), the peer consumes.
@@ -26,7 +28,9 @@
  *     inherit from a corpse.
  *   - The host consumer (ring_drain) validates every header and treats the
  *     shared cursors as untrusted, so no peer state can make it read out of
- *     bounds or spin.
+ *     bounds or spin. Each frame is copied out of the ring before it is
+ *     parsed, so a peer that rewrites a frame after publishing it changes
+ *     nothing the host reads: validation and dispatch both see the copy.
  *   - The host producer derives every write offset from its own head cursor;
  *     a hostile rep_tail can only cause reply drops, never out-of-bounds
  *     writes. Ring-full replies are dropped and counted (rep_dropped) — the
@@ -46,7 +50,9 @@
  *
  * Commands are stamped with SHM_PEER_ORIGIN_TOKEN by the host drain — the
  * frame's own sourceId is ignored, so origin identity is assigned by the
- * transport exactly as with sockets, never trusted from shared memory.
+ * transport exactly as with sockets, never trusted from shared memory. Only
+ * its SOURCE_ID_PRECODED bit is read: the payload is then a command record
+ * (cmd_record.h), bounds-checked on the host's copy of the frame.
  */
 #pragma once
 
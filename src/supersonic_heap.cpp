@@ -13,6 +13,15 @@
  * Thread safety: a std::atomic_flag spinlock protects AllocPool operations.
  * Contention is minimal — only buffer commands (/b_alloc, /b_allocRead) and
  * SampleLoader touch this, both infrequently.
+ *
+ * The audio thread must not reach the system allocator through the pool, yet
+ * AllocPool grows (NewArea) on whichever thread's allocation exhausts it and
+ * releases an emptied growth area (FreeArea) on whichever thread frees its
+ * last chunk. So on a thread marked RT the area callbacks refuse growth and
+ * queue releases, and supersonic_heap_maintain() — run off the audio thread by
+ * the engine's headroom thread — does the system calls instead, outside the
+ * lock: it releases (or reuses) queued areas and pre-adds growth areas so free
+ * space stays at the headroom.
  */
 
 #include "supersonic_heap.h"
@@ -28,6 +37,7 @@
 #include "SC_AllocPool.h"
 #include "mem_region.h"
 #include "SC_Platform.h"
+#include <algorithm>
 #include <atomic>
 #include <cstdlib>
 #include <cstdio>
@@ -61,11 +71,110 @@ static inline void heap_lock() {
 static inline void heap_unlock() { g_heap_lock.clear(std::memory_order_release); }
 #endif
 
-// Track dynamically allocated growth areas for cleanup
-static std::vector<void*> g_extra_areas;
+// Track dynamically allocated growth areas (base, bytes) for cleanup
+struct GrowthArea { void* ptr; size_t size; };
+static std::vector<GrowthArea> g_extra_areas;
 static size_t g_initial_size = 0;
 static size_t g_total_allocated = 0;
 static size_t g_growth_count = 0;
+static size_t g_released_bytes = 0;
+
+// Every linked area, initial included, sorted by base, with what is live in
+// it — supersonic_heap_areas() copies these instead of walking the chunks
+// under the lock. Entries are added only where an area is (heap_new_area,
+// never on the audio thread) and dropped in heap_free_area, which doesn't
+// allocate.
+struct AreaUse {
+    char*  begin;
+    char*  end;
+    size_t inUse;
+    size_t numInUse;
+};
+static std::vector<AreaUse> g_area_use;
+
+static void heap_track_area(void* ptr, size_t size) {
+    char* begin = static_cast<char*>(ptr);
+    auto it = std::lower_bound(g_area_use.begin(), g_area_use.end(), begin,
+                               [](const AreaUse& a, const char* p) { return a.begin < p; });
+    g_area_use.insert(it, {begin, begin + size, 0, 0});
+}
+
+static void heap_untrack_area(void* ptr) {
+    for (auto it = g_area_use.begin(); it != g_area_use.end(); ++it) {
+        if (it->begin == ptr) {
+            g_area_use.erase(it);
+            return;
+        }
+    }
+}
+
+// Count a live allocation in (or, with sign -1, out of) its area. Under the lock.
+static void heap_count_chunk(void* ptr, size_t chunkBytes, int sign) {
+    const char* p = static_cast<const char*>(ptr);
+    auto it = std::upper_bound(g_area_use.begin(), g_area_use.end(), p,
+                               [](const char* q, const AreaUse& a) { return q < a.begin; });
+    if (it == g_area_use.begin())
+        return;
+    --it;
+    if (p >= it->end)
+        return;
+    if (sign > 0) {
+        it->inUse += chunkBytes;
+        it->numInUse++;
+    } else {
+        it->inUse -= chunkBytes;
+        it->numInUse--;
+    }
+}
+
+// supersonic_heap_hold_released_areas: emptied growth areas parked here,
+// still mapped, until the hold is dropped.
+static bool g_hold_release = false;
+static std::vector<GrowthArea> g_held_areas;
+
+// ── Headroom ──────────────────────────────────────────────────────────────
+// The RT mark is per-thread on a hosted build. A lean target has no other
+// thread to hand growth to, so there it never applies.
+#if SC_HAS_HOSTED_OS
+static thread_local bool t_rt_thread = false;
+static inline bool on_rt_thread() { return t_rt_thread; }
+#else
+static inline bool on_rt_thread() { return false; }
+#endif
+
+// Free space = usable bytes in linked areas − chunk bytes of live allocations.
+// Atomics so supersonic_heap_needs_maintenance() can poll without the lock.
+static std::atomic<size_t> g_pool_bytes{0};
+static std::atomic<size_t> g_in_use_bytes{0};
+static std::atomic<size_t> g_headroom{0};
+static std::atomic<size_t> g_rt_refused{0};
+
+// Growth areas the audio thread emptied, still mapped. Reserved at init so
+// queuing never allocates; a pathological heap that overflows it falls back
+// to freeing inline (a few hundred areas is already far past any real use).
+static constexpr size_t kMaxDeferredAreas = 256;
+static std::vector<GrowthArea> g_deferred;
+static std::atomic<size_t> g_deferred_count{0};
+
+// An area supersonic_heap_maintain() mapped (or took back off the queue)
+// outside the lock, handed to AllocPool::AddArea through heap_new_area.
+static GrowthArea g_adopt = {nullptr, 0};
+
+static inline size_t heap_free_now() {
+    const size_t pool = g_pool_bytes.load(std::memory_order_relaxed);
+    const size_t used = g_in_use_bytes.load(std::memory_order_relaxed);
+    return pool > used ? pool - used : 0;
+}
+
+// AllocPool's release filter: an emptied growth area stays in the pool while
+// releasing it would leave less than the headroom free — otherwise churn on
+// the audio thread would queue the very area the headroom thread just added.
+static bool heap_release_area(size_t areaSize) {
+    const size_t headroom = g_headroom.load(std::memory_order_relaxed);
+    if (headroom == 0) return true;
+    const size_t free = heap_free_now();
+    return free >= areaSize && free - areaSize >= headroom;
+}
 
 // AllocPool callbacks — NewAreaFunc / FreeAreaFunc
 // First call returns the pre-allocated backing block. Subsequent calls (when
@@ -78,15 +187,35 @@ static void* heap_new_area(size_t size) {
         // Initial allocation — return the pre-allocated backing block
         void* ptr = g_pending_area;
         g_pending_area = nullptr;
+        heap_track_area(ptr, size);
+        return ptr;
+    }
+
+    if (g_adopt.ptr) {
+        // Headroom area from supersonic_heap_maintain(), already mapped (and
+        // already counted in g_total_allocated).
+        void* ptr = g_adopt.ptr;
+        g_extra_areas.push_back(g_adopt);
+        heap_track_area(ptr, size);
+        g_adopt = {nullptr, 0};
+        g_pool_bytes.fetch_add(size - kAreaOverhead, std::memory_order_relaxed);
         return ptr;
     }
 
+    // Never from the audio thread: fail the allocation and count it.
+    if (on_rt_thread()) {
+        g_rt_refused.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
     // Growth allocation — Bulk tier (PSRAM on embedded, malloc on desktop)
     void* ptr = supersonic::mem::alloc(supersonic::mem::Tier::Bulk, size);
     if (ptr) {
-        g_extra_areas.push_back(ptr);
+        g_extra_areas.push_back({ptr, size});
+        heap_track_area(ptr, size);
         g_total_allocated += size;
         g_growth_count++;
+        g_pool_bytes.fetch_add(size - kAreaOverhead, std::memory_order_relaxed);
     }
     return ptr;
 }
@@ -97,10 +226,21 @@ static void heap_free_area(void* ptr) {
     if (ptr == g_heap_backing)
         return;
 
+    heap_untrack_area(ptr);
     // Free growth areas and remove from tracking
     for (auto it = g_extra_areas.begin(); it != g_extra_areas.end(); ++it) {
-        if (*it == ptr) {
-            supersonic::mem::free(ptr);
+        if (it->ptr == ptr) {
+            g_pool_bytes.fetch_sub(it->size - kAreaOverhead, std::memory_order_relaxed);
+            if (g_hold_release && g_held_areas.size() < g_held_areas.capacity()) {
+                g_held_areas.push_back(*it);
+            } else if (on_rt_thread() && g_deferred.size() < g_deferred.capacity()) {
+                g_deferred.push_back(*it);
+                g_deferred_count.store(g_deferred.size(), std::memory_order_relaxed);
+            } else {
+                supersonic::mem::free(ptr);
+                g_released_bytes  += it->size;
+                g_total_allocated -= it->size;
+            }
             g_extra_areas.erase(it);
             return;
         }
@@ -111,7 +251,12 @@ void supersonic_heap_init(size_t bytes) {
     if (g_heap_pool) {
         // Pool exists — reset it (all old allocations are abandoned since
         // a fresh World_New is about to run). No need to reallocate.
+        heap_lock();
         g_heap_pool->FreeAllInternal();
+        g_in_use_bytes.store(0, std::memory_order_relaxed);
+        for (auto& area : g_area_use)
+            area.inUse = area.numInUse = 0;
+        heap_unlock();
         return;
     }
 
@@ -148,12 +293,17 @@ void supersonic_heap_init(size_t bytes) {
     g_initial_size = total;
     g_total_allocated = total;
     g_growth_count = 0;
+    g_pool_bytes.store(bytes, std::memory_order_relaxed);
+    g_in_use_bytes.store(0, std::memory_order_relaxed);
+    g_deferred.reserve(kMaxDeferredAreas);
+    g_area_use.reserve(16);
 
     // AllocPool::NewArea will call heap_new_area, which returns this block
     g_pending_area = g_heap_backing;
 
     // areaMoreSize > 0 enables automatic growth when the pool is exhausted
     g_heap_pool = new AllocPool(heap_new_area, heap_free_area, bytes, HEAP_GROWTH_SIZE);
+    g_heap_pool->SetAreaReleaseFilter(heap_release_area);
 }
 
 void* supersonic_heap_alloc(size_t bytes) {
@@ -164,6 +314,11 @@ void* supersonic_heap_alloc(size_t bytes) {
     heap_lock();
 
     void* ptr = g_heap_pool->Alloc(bytes);
+    if (ptr) {
+        const size_t chunk = AllocPool::ChunkBytes(ptr);
+        g_in_use_bytes.fetch_add(chunk, std::memory_order_relaxed);
+        heap_count_chunk(ptr, chunk, 1);
+    }
 
     heap_unlock();
 
@@ -176,21 +331,38 @@ void supersonic_heap_free(void* ptr) {
 
     heap_lock();
 
+    const size_t chunk = AllocPool::ChunkBytes(ptr);
+    g_in_use_bytes.fetch_sub(chunk, std::memory_order_relaxed);
+    heap_count_chunk(ptr, chunk, -1);
     g_heap_pool->Free(ptr);
 
     heap_unlock();
 }
 
 void supersonic_heap_destroy() {
+    // Locked against a concurrent supersonic_heap_maintain() (the headroom
+    // thread); nothing else may use the heap across a destroy.
+    heap_lock();
     if (g_heap_pool) {
         delete g_heap_pool;
         g_heap_pool = nullptr;
     }
     // Free growth areas
-    for (void* area : g_extra_areas) {
-        supersonic::mem::free(area);
+    for (const auto& area : g_extra_areas) {
+        supersonic::mem::free(area.ptr);
     }
     g_extra_areas.clear();
+    g_area_use.clear();
+    for (const auto& area : g_held_areas) {
+        supersonic::mem::free(area.ptr);
+    }
+    g_held_areas.clear();
+    g_hold_release = false;
+    for (const auto& area : g_deferred) {
+        supersonic::mem::free(area.ptr);
+    }
+    g_deferred.clear();
+    g_deferred_count.store(0, std::memory_order_relaxed);
     // Free initial backing block
     if (g_heap_backing) {
         supersonic::mem::free(g_heap_backing);
@@ -198,6 +370,11 @@ void supersonic_heap_destroy() {
     }
     g_total_allocated = 0;
     g_growth_count = 0;
+    g_released_bytes = 0;
+    g_pool_bytes.store(0, std::memory_order_relaxed);
+    g_in_use_bytes.store(0, std::memory_order_relaxed);
+    g_rt_refused.store(0, std::memory_order_relaxed);
+    heap_unlock();
 }
 
 size_t supersonic_heap_total_allocated() {
@@ -208,6 +385,185 @@ size_t supersonic_heap_growth_count() {
     return g_growth_count;
 }
 
+size_t supersonic_heap_areas(supersonic_heap_area* out, size_t maxAreas) {
+    if (!g_heap_pool)
+        return 0;
+    heap_lock();
+    const size_t count = g_area_use.size();
+    const size_t n = std::min(count, maxAreas);
+    for (size_t i = 0; i < n; ++i) {
+        const AreaUse& a = g_area_use[i];
+        out[i].base     = a.begin;
+        out[i].begin    = a.begin;
+        out[i].end      = a.end;
+        out[i].size     = static_cast<size_t>(a.end - a.begin) - kAreaOverhead;
+        out[i].inUse    = a.inUse;
+        out[i].numInUse = a.numInUse;
+        out[i].initial  = a.begin == g_heap_backing;
+    }
+    heap_unlock();
+    return count;
+}
+
+size_t supersonic_heap_largest_free(void* const* areaBases, size_t numAreas) {
+    if (!g_heap_pool)
+        return 0;
+    heap_lock();
+    const size_t largest = g_heap_pool->LargestFreeAvoiding(areaBases, numAreas);
+    heap_unlock();
+    return largest;
+}
+
+void* supersonic_heap_alloc_avoiding(size_t bytes, void* const* areaBases, size_t numAreas) {
+    if (!g_heap_pool)
+        return nullptr;
+    heap_lock();
+    void* ptr = g_heap_pool->AllocAvoiding(bytes, areaBases, numAreas);
+    if (ptr) {
+        const size_t chunk = AllocPool::ChunkBytes(ptr);
+        g_in_use_bytes.fetch_add(chunk, std::memory_order_relaxed);
+        heap_count_chunk(ptr, chunk, 1);
+    }
+    heap_unlock();
+    return ptr;
+}
+
+size_t supersonic_heap_chunk_bytes(void* ptr) {
+    return ptr ? AllocPool::ChunkBytes(ptr) : 0;
+}
+
+void supersonic_heap_hold_released_areas(bool hold) {
+    std::vector<GrowthArea> release;
+    if (hold) {
+        // Reserve before taking the lock: heap_free_area runs under it, on
+        // whichever thread freed the last chunk, and must not allocate.
+        std::vector<GrowthArea> spare;
+        spare.reserve(64);
+        heap_lock();
+        if (!g_hold_release) {
+            g_held_areas.swap(spare);
+            g_hold_release = true;
+        }
+        heap_unlock();
+        return;
+    }
+    heap_lock();
+    g_hold_release = false;
+    release.swap(g_held_areas);
+    for (const auto& area : release) {
+        g_released_bytes  += area.size;
+        g_total_allocated -= area.size;
+    }
+    heap_unlock();
+    for (const auto& area : release)
+        supersonic::mem::free(area.ptr);
+}
+
+size_t supersonic_heap_released_bytes() {
+    return g_released_bytes;
+}
+
+void supersonic_heap_set_rt_thread(bool rt) {
+#if SC_HAS_HOSTED_OS
+    t_rt_thread = rt;
+#else
+    (void)rt;
+#endif
+}
+
+void supersonic_heap_set_headroom(size_t bytes) {
+    g_headroom.store(bytes, std::memory_order_relaxed);
+}
+
+size_t supersonic_heap_headroom() {
+    return g_headroom.load(std::memory_order_relaxed);
+}
+
+size_t supersonic_heap_free_bytes() {
+    return heap_free_now();
+}
+
+bool supersonic_heap_needs_maintenance() {
+    if (g_deferred_count.load(std::memory_order_relaxed) > 0)
+        return true;
+    const size_t headroom = g_headroom.load(std::memory_order_relaxed);
+    return headroom > 0 && g_pool_bytes.load(std::memory_order_relaxed) > 0
+        && heap_free_now() < headroom;
+}
+
+bool supersonic_heap_maintain() {
+    if (on_rt_thread())
+        return false;
+    bool did = false;
+
+    // Take the queue, leaving a reserved-but-empty vector in its place so the
+    // audio thread can keep queuing without allocating.
+    std::vector<GrowthArea> queued;
+    queued.reserve(kMaxDeferredAreas);
+    heap_lock();
+    queued.swap(g_deferred);
+    g_deferred_count.store(0, std::memory_order_relaxed);
+    heap_unlock();
+
+    // Queued areas go back into the pool while it is short of headroom (no
+    // system call at all); the rest are released.
+    for (const auto& area : queued) {
+        heap_lock();
+        bool reused = false;
+        if (g_heap_pool && heap_free_now() < g_headroom.load(std::memory_order_relaxed)) {
+            g_adopt = area;
+            reused = g_heap_pool->AddArea(area.size - kAreaOverhead);
+            g_adopt = {nullptr, 0};
+        }
+        if (!reused) {
+            g_released_bytes  += area.size;
+            g_total_allocated -= area.size;
+        }
+        heap_unlock();
+        if (!reused)
+            supersonic::mem::free(area.ptr);
+        did = true;
+    }
+
+    // Top up: map outside the lock, then link the area in under it.
+    for (;;) {
+        const size_t headroom = g_headroom.load(std::memory_order_relaxed);
+        const size_t free = heap_free_now();
+        if (headroom == 0 || free >= headroom || g_pool_bytes.load(std::memory_order_relaxed) == 0)
+            break;
+        const size_t bytes = std::max(HEAP_GROWTH_SIZE, headroom - free) + kAreaOverhead;
+        void* ptr = supersonic::mem::alloc(supersonic::mem::Tier::Bulk, bytes);
+        if (!ptr)
+            break;
+        heap_lock();
+        bool added = false;
+        if (g_heap_pool) {
+            g_adopt = {ptr, bytes};
+            added = g_heap_pool->AddArea(bytes - kAreaOverhead);
+            g_adopt = {nullptr, 0};
+            if (added) {
+                g_total_allocated += bytes;
+                g_growth_count++;
+            }
+        }
+        heap_unlock();
+        if (!added) {
+            supersonic::mem::free(ptr);
+            break;
+        }
+        did = true;
+    }
+    return did;
+}
+
+size_t supersonic_heap_rt_growth_refused() {
+    return g_rt_refused.load(std::memory_order_relaxed);
+}
+
+size_t supersonic_heap_deferred_areas() {
+    return g_deferred_count.load(std::memory_order_relaxed);
+}
+
 #else // !SUPERSONIC_SYNTH — inert stubs (no AllocPool, no scsynth dependency)
 
 void   supersonic_heap_init(size_t)        {}
@@ -216,5 +572,19 @@ void   supersonic_heap_free(void*)         {}
 void   supersonic_heap_destroy()           {}
 size_t supersonic_heap_total_allocated()   { return 0; }
 size_t supersonic_heap_growth_count()      { return 0; }
+size_t supersonic_heap_areas(supersonic_heap_area*, size_t)             { return 0; }
+size_t supersonic_heap_largest_free(void* const*, size_t)              { return 0; }
+void*  supersonic_heap_alloc_avoiding(size_t, void* const*, size_t)    { return nullptr; }
+size_t supersonic_heap_chunk_bytes(void*)                              { return 0; }
+void   supersonic_heap_hold_released_areas(bool)                       {}
+size_t supersonic_heap_released_bytes()                                { return 0; }
+void   supersonic_heap_set_rt_thread(bool)                             {}
+void   supersonic_heap_set_headroom(size_t)                            {}
+size_t supersonic_heap_headroom()                                      { return 0; }
+size_t supersonic_heap_free_bytes()                                    { return 0; }
+bool   supersonic_heap_needs_maintenance()                             { return false; }
+bool   supersonic_heap_maintain()                                      { return false; }
+size_t supersonic_heap_rt_growth_refused()                             { return 0; }
+size_t supersonic_heap_deferred_areas()                                { return 0; }
 
 #endif // SUPERSONIC_SYNTH
@@ -5,13 +5,31 @@
  * so these are inline passthroughs with zero overhead.
  *
  * On native, a global AllocPool instance provides a heap from a system-malloc'd
- * block, with automatic growth when exhausted. All allocations are RT-safe once
- * the memory is allocated (growth happens on the SampleLoader thread, not RT).
+ * block, with automatic growth when exhausted. The audio thread never reaches
+ * the system allocator through it: a thread marked with
+ * supersonic_heap_set_rt_thread() has growth refused (the allocation fails and
+ * is counted) and the growth areas it empties queued, not freed. A non-RT
+ * thread calling supersonic_heap_maintain() releases that queue and keeps
+ * supersonic_heap_set_headroom() bytes free ahead of demand, so RT allocations
+ * find room without growing.
  */
 
 #pragma once
 #include <cstddef>
 
+// One pool area, as reported by supersonic_heap_areas(). `base` is the block
+// the area was carved from (what heap_free_area releases); [begin, end) is that
+// block, for mapping an allocation back to its area.
+struct supersonic_heap_area {
+    void*  base;
+    char*  begin;
+    char*  end;
+    size_t size;         // usable bytes
+    size_t inUse;        // bytes in live allocations, chunk headers included
+    size_t numInUse;     // live allocations
+    bool   initial;      // the boot-time area (never released)
+};
+
 #ifdef __EMSCRIPTEN__
 // WASM: emscripten's malloc already operates on pre-allocated linear memory
 #include "synth/common/malloc_aligned.hpp"
@@ -21,6 +39,20 @@ inline void   supersonic_heap_free(void* ptr) { nova::free_aligned(ptr); }
 inline void   supersonic_heap_destroy() {}
 inline size_t supersonic_heap_total_allocated() { return 0; }
 inline size_t supersonic_heap_growth_count() { return 0; }
+inline size_t supersonic_heap_areas(supersonic_heap_area*, size_t) { return 0; }
+inline size_t supersonic_heap_largest_free(void* const*, size_t) { return 0; }
+inline void*  supersonic_heap_alloc_avoiding(size_t, void* const*, size_t) { return nullptr; }
+inline size_t supersonic_heap_chunk_bytes(void*) { return 0; }
+inline void   supersonic_heap_hold_released_areas(bool) {}
+inline size_t supersonic_heap_released_bytes() { return 0; }
+inline void   supersonic_heap_set_rt_thread(bool) {}
+inline void   supersonic_heap_set_headroom(size_t) {}
+inline size_t supersonic_heap_headroom() { return 0; }
+inline size_t supersonic_heap_free_bytes() { return 0; }
+inline bool   supersonic_heap_needs_maintenance() { return false; }
+inline bool   supersonic_heap_maintain() { return false; }
+inline size_t supersonic_heap_rt_growth_refused() { return 0; }
+inline size_t supersonic_heap_deferred_areas() { return 0; }
 #else
 // Native: growable pool (implemented in supersonic_heap.cpp)
 void   supersonic_heap_init(size_t bytes);
@@ -29,4 +61,47 @@ void   supersonic_heap_free(void* ptr);
 void   supersonic_heap_destroy();
 size_t supersonic_heap_total_allocated();
 size_t supersonic_heap_growth_count();
+
+// Buffer compaction support (SampleLoader). Areas are listed in address
+// order; returns the area count, filling at most maxAreas entries. The usage
+// figures are counters kept by alloc/free, so this never walks the chunks.
+size_t supersonic_heap_areas(supersonic_heap_area* out, size_t maxAreas);
+// Largest free chunk outside the listed areas (by base; none for the whole
+// pool). Walks only the free lists.
+size_t supersonic_heap_largest_free(void* const* areaBases, size_t numAreas);
+// Allocate outside the listed areas (by base), growing the pool if nothing
+// else fits — the destination for data evacuated from those areas.
+void*  supersonic_heap_alloc_avoiding(size_t bytes, void* const* areaBases, size_t numAreas);
+// Pool bytes behind a live allocation (what freeing it returns).
+size_t supersonic_heap_chunk_bytes(void* ptr);
+// While held, growth areas that empty out stay mapped (queued) instead of
+// going back to the system — for a reader copying out of pool memory that
+// another thread may free underneath it. Releasing the hold frees the queue.
+void   supersonic_heap_hold_released_areas(bool hold);
+// Total bytes of growth areas returned to the system since init.
+size_t supersonic_heap_released_bytes();
+
+// ── Headroom (audio-thread safety) ──────────────────────────────────────────
+// Mark the calling thread as the audio thread (process_audio does, for the
+// whole callback). While marked: an allocation the pool can't satisfy fails
+// instead of growing (counted in rt_growth_refused), and a growth area it
+// empties is queued for supersonic_heap_maintain() instead of being freed.
+// Hosted builds only; a lean target has no other thread to hand the work to.
+void   supersonic_heap_set_rt_thread(bool rt);
+// Free bytes to keep in the pool ahead of demand (0 = none; the default).
+void   supersonic_heap_set_headroom(size_t bytes);
+size_t supersonic_heap_headroom();
+// Pool bytes not in live allocations (across areas — not one contiguous run).
+size_t supersonic_heap_free_bytes();
+// Lock-free: free space is under the headroom, or emptied areas are queued.
+bool   supersonic_heap_needs_maintenance();
+// Non-RT housekeeping: reuse or release queued areas, then add growth areas
+// until free space is back at the headroom. System calls happen outside the
+// pool lock, so the audio thread never waits on one. Returns true if it did
+// anything; a no-op on the audio thread.
+bool   supersonic_heap_maintain();
+// Allocations refused on the audio thread because they would have grown.
+size_t supersonic_heap_rt_growth_refused();
+// Emptied growth areas waiting for supersonic_heap_maintain().
+size_t supersonic_heap_deferred_areas();
 #endif
@@ -71,7 +71,12 @@ void AllocPool::InitAlloc() {
         return;
 
     /* alloc initial area */
+#ifdef SUPERSONIC
+    if (!NewArea(mAreaInitSize))
+        throw std::runtime_error(std::string("Could not allocate new area"));
+#else
     NewArea(mAreaInitSize);
+#endif
     /* get chunk */
     AllocAreaPtr area = mAreas;
     AllocChunkPtr chunk = &area->mChunk;
@@ -177,7 +182,11 @@ void AllocPool::Free(void* inPtr) {
     }
 
     chunk->SetSizeFree(size);
+#ifdef SUPERSONIC
+    if (mAreaMoreSize && chunk->IsArea() && (!mReleaseFilter || mReleaseFilter(size))) {
+#else
     if (mAreaMoreSize && chunk->IsArea()) {
+#endif
         // whole area is free
         FreeArea(chunk);
     } else {
@@ -190,8 +199,16 @@ void AllocPool::Free(void* inPtr) {
 AllocAreaPtr AllocPool::NewArea(size_t inAreaSize) {
     void* ptr = (AllocAreaPtr)(mAllocArea)(inAreaSize + kAreaOverhead);
 
+#ifdef SUPERSONIC
+    // [SUPERSONIC] The area callback refuses growth on the audio thread; the
+    // Alloc paths already treat a null area as an exhausted pool, so report
+    // it that way rather than throwing through the audio callback.
+    if (ptr == NULL)
+        return NULL;
+#else
     if (ptr == NULL)
         throw std::runtime_error(std::string("Could not allocate new area"));
+#endif
 
     // AllocAreaPtr area = (AllocAreaPtr)((unsigned long)ptr & ~kAlignMask);
     AllocAreaPtr area = (AllocAreaPtr)(((size_t)ptr + kAlignMask) & ~kAlignMask);
@@ -541,6 +558,112 @@ void AllocPool::LinkFree(AllocChunkPtr inChunk) {
     }
 }
 
+#ifdef SUPERSONIC
+size_t AllocPool::LargestFreeAvoiding(void* const* inAreaBases, size_t inNumAreas) {
+    auto excluded = [&](AllocChunkPtr p) {
+        AllocAreaPtr area = mAreas;
+        do {
+            const char* begin = (const char*)&area->mChunk;
+            if ((const char*)p >= begin && (const char*)p < begin + area->mSize) {
+                for (size_t i = 0; i < inNumAreas; ++i)
+                    if (inAreaBases[i] == area->mUnalignedPointerToThis)
+                        return true;
+                return false;
+            }
+            area = area->mNext;
+        } while (area != mAreas);
+        return false;
+    };
+    if (!mAreas)
+        return 0;
+    // Every chunk in a bin is at least as large as any in the bins below it.
+    for (int i = kNumAllocBins - 1; i >= 0; --i) {
+        AllocChunkPtr bin = mBins + i;
+        size_t largest = 0;
+        for (AllocChunkPtr p = bin->Next(); p != bin; p = p->Next())
+            if (!excluded(p))
+                largest = sc_max(largest, p->Size());
+        if (largest)
+            return largest;
+    }
+    return 0;
+}
+
+void* AllocPool::AllocAvoiding(size_t inBytes, void* const* inAreaBases, size_t inNumAreas) {
+    // Take the excluded areas' free chunks out of their bins for the length of
+    // one Alloc, chained through their (now unused) links. They stay marked
+    // free, and nothing can coalesce with them meanwhile because the caller
+    // holds the pool for the whole call.
+    AllocChunkPtr held = nullptr;
+    AllocAreaPtr area = mAreas;
+    if (area) {
+        do {
+            bool excluded = false;
+            for (size_t i = 0; i < inNumAreas && !excluded; ++i)
+                excluded = inAreaBases[i] == area->mUnalignedPointerToThis;
+            if (excluded) {
+                for (AllocChunkPtr p = &area->mChunk; p->mSize != kChunkInUse; p = p->NextChunk()) {
+                    if (!p->InUse()) {
+                        UnlinkFree(p);
+                        p->mNext = held;
+                        held = p;
+                    }
+                }
+            }
+            area = area->mNext;
+        } while (area != mAreas);
+    }
+
+    void* ptr = nullptr;
+    try {
+        ptr = Alloc(inBytes);
+    } catch (...) {
+        ptr = nullptr; // NewArea failed: report it like any exhausted pool
+    }
+
+    while (held) {
+        AllocChunkPtr next = static_cast<AllocChunkPtr>(held->mNext);
+        LinkFree(held);
+        held = next;
+    }
+    return ptr;
+}
+
+bool AllocPool::AddArea(size_t inAreaSize) {
+    check_pool();
+    AllocAreaPtr area = NewArea(inAreaSize);
+    if (!area)
+        return false;
+    LinkFree(&area->mChunk);
+    check_pool();
+    return true;
+}
+
+bool AllocPool::RemoveArea(void* inBase) {
+    AllocAreaPtr area = mAreas;
+    if (!area)
+        return false;
+    do {
+        if (area->mUnalignedPointerToThis == inBase) {
+            AllocChunkPtr chunk = &area->mChunk;
+            if (chunk->InUse() || !chunk->IsArea())
+                return false;
+            UnlinkFree(chunk);
+            if (area->mNext == area) {
+                mAreas = NULL;
+            } else {
+                mAreas = area->mPrev->mNext = area->mNext;
+                area->mNext->mPrev = area->mPrev;
+            }
+            check_pool();
+            return true;
+        }
+        area = area->mNext;
+    } while (area != mAreas);
+    return false;
+}
+#endif
+
 void AllocPool::DoCheckArea(AllocAreaPtr area) {
     assert(area->mChunk.PrevInUse());
 
@@ -136,6 +136,29 @@ public:
 
     static AllocChunkPtr MemToChunk(void* inPtr) { return (AllocChunkPtr)((char*)(inPtr) - sizeof(AllocChunk)); }
 
+#ifdef SUPERSONIC
+    // [SUPERSONIC] Placement control for supersonic_heap's buffer compaction.
+    // Callers serialise these with every other pool call.
+    // Largest free chunk outside the areas whose base is listed. Walks the
+    // free lists from the top bin down, never the chunks in use.
+    size_t LargestFreeAvoiding(void* const* inAreaBases, size_t inNumAreas);
+    // Alloc, but never from the areas whose base is listed. May add an area.
+    MALLOC void* AllocAvoiding(size_t inBytes, void* const* inAreaBases, size_t inNumAreas);
+    // Chunk bytes behind a live allocation, header included.
+    static size_t ChunkBytes(void* inPtr) { return MemToChunk(inPtr)->Size(); }
+    // Add a free area of inAreaSize usable bytes ahead of demand (the heap's
+    // headroom manager). False if the NewAreaFunc returned nothing.
+    bool AddArea(size_t inAreaSize);
+    // Unlink an area AddArea added while it is still wholly free, without
+    // calling the FreeAreaFunc: the caller keeps its memory (a refused
+    // World_ApplyResize). False if it isn't in the pool or is partly in use.
+    bool RemoveArea(void* inBase);
+    // Asked before an emptied growth area goes to the FreeAreaFunc; false
+    // keeps it in the pool as free space. Null (the default) always releases.
+    typedef bool (*AreaReleaseFunc)(size_t areaSize);
+    void SetAreaReleaseFilter(AreaReleaseFunc inFilter) { mReleaseFilter = inFilter; }
+#endif
+
 private:
     void InitAlloc();
     void InitBins();
@@ -254,4 +277,7 @@ private:
     FreeAreaFunc mFreeArea;
     size_t mAreaInitSize, mAreaMoreSize;
     unsigned long mBinBlocks[4];
+#ifdef SUPERSONIC
+    AreaReleaseFunc mReleaseFilter = nullptr;
+#endif
 };
@@ -53,7 +53,7 @@ using std::string;
 // (shm_peer_plane.h) sits after the blob: it is native-segment-only (its
 // consumers are the native host and an external peer), so the arena layout —
 // and with it the web SAB and embedded profiles — is untouched by it.
-static constexpr size_t SHM_BLOB_OFFSET = 128;  // aligned, >= sizeof(shm_segment_header)
+static constexpr size_t SHM_BLOB_OFFSET = 256;  // aligned, >= sizeof(shm_segment_header)
 // Rounded up to 8: the arena total is only guaranteed 4-aligned, and the peer
 // plane header is alignas(8).
 static constexpr size_t SHM_PEER_OFFSET = (SHM_BLOB_OFFSET + TOTAL_BUFFER_SIZE + 7u) & ~size_t{7};
@@ -190,6 +190,11 @@ inline void shm_remove(const string& name) {
 //   0x5C09E008  scope slots became lossless cursor-ring streams
 //               (shm_scope_stream.hpp) + SuperClock sample-clock region appended
 //               to the arena (engine-frames ↔ DAC-NTP mapping)
+//   0x5C09E009  + command latency-trace region in the arena (the sample-clock
+//               region moved up behind it); header grew past 128 B, so
+//               SHM_BLOB_OFFSET 128→256
+//   0x5C09E00A  + bus-meter region in the arena (bus_meter.h), between the
+//               latency trace and the sample clock
 //
 // Publication: the creator zeroes the whole segment and writes the header
 // geometry, but defers the MAGIC store. The engine then populates the arena
@@ -207,7 +212,7 @@ inline void shm_remove(const string& name) {
 // changes propagate through the header rather than requiring a hand-synced copy.
 // All offsets are relative to the arena blob base (segment + blob_offset).
 struct shm_segment_header {
-    static constexpr uint32_t MAGIC = 0x5C09E008;  // E008: scope streams + sample-clock region (E007: peer command plane)
+    static constexpr uint32_t MAGIC = 0x5C09E00A;  // E00A: bus-meter region (E009: latency-trace region)
 
     uint32_t magic;
     uint32_t blob_offset;          // segment base → arena blob
@@ -251,6 +256,9 @@ struct shm_segment_header {
     uint32_t peer_header_bytes;    // sizeof(ShmPeerPlaneHeader)
     uint32_t peer_cmd_ring_bytes;  // SHM_PEER_CMD_RING_SIZE
     uint32_t peer_rep_ring_bytes;  // SHM_PEER_REP_RING_SIZE
+
+    uint32_t latency_trace_offset; // command latency histograms (LATENCY_TRACE_*)
+    uint32_t meter_offset;         // output/bus level meters (METER_*)
 };
 static_assert(sizeof(shm_segment_header) <= SHM_BLOB_OFFSET,
               "shm_segment_header must fit within SHM_BLOB_OFFSET");
@@ -309,6 +317,8 @@ public:
 
             header_->native_stats_offset = NATIVE_STATS_START;
             header_->sample_clock_offset     = SAMPLE_CLOCK_START;
+            header_->latency_trace_offset    = LATENCY_TRACE_START;
+            header_->meter_offset            = METER_START;
 
             header_->peer_offset         = static_cast<uint32_t>(SHM_PEER_OFFSET);
             header_->peer_header_bytes   = static_cast<uint32_t>(sizeof(ShmPeerPlaneHeader));
@@ -455,6 +465,183 @@ inline sample_clock_view read_sample_clock(const uint8_t* tl) {
     return v;
 }
 
+// ──── Latency-trace view ────────────────────────────────────────────────
+//
+// Snapshot of the command latency histograms (LATENCY_TRACE_*; see
+// latency_trace.h): per origin row and delivery class, how long commands
+// waited between ss_ingress_write and being performed or fired. Counters are
+// read one by one while the engine may be adding to them; a changed epoch
+// between two snapshots means tracing was reset in between.
+
+struct latency_trace_view {
+    static constexpr uint32_t origins = LATENCY_TRACE_ORIGINS;
+    static constexpr uint32_t classes = LATENCY_TRACE_CLASSES;  // immediate, bundle, /schedule
+    static constexpr uint32_t buckets = LATENCY_TRACE_BUCKETS;
+
+    bool     enabled = false;
+    uint32_t epoch = 0;
+    uint32_t origin_ids[origins] = {};  // origin token + 1 (0 = unused row;
+                                        // the last row holds every other origin)
+    uint32_t max_us[classes] = {};
+    uint32_t counts[origins][classes][buckets] = {};
+
+    // Exclusive upper bound of bucket b, in µs (UINT32_MAX for the last).
+    static uint32_t bucket_limit_us(uint32_t b) {
+        return b + 1 < buckets ? (1u << b) : UINT32_MAX;
+    }
+
+    uint64_t total(uint32_t cls) const {
+        uint64_t n = 0;
+        for (uint32_t o = 0; o < origins; ++o)
+            for (uint32_t b = 0; b < buckets; ++b)
+                n += counts[o][cls][b];
+        return n;
+    }
+
+    // Upper bound of the bucket holding quantile q (0..1) of class cls across
+    // all origins, in µs; 0 if nothing was recorded.
+    uint32_t quantile_us(uint32_t cls, double q) const {
+        const uint64_t n = total(cls);
+        if (n == 0) return 0;
+        const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(n - 1)) + 1;
+        uint64_t seen = 0;
+        for (uint32_t b = 0; b < buckets; ++b) {
+            for (uint32_t o = 0; o < origins; ++o)
+                seen += counts[o][cls][b];
+            if (seen >= rank)
+                return bucket_limit_us(b);
+        }
+        return bucket_limit_us(buckets - 1);
+    }
+};
+
+inline latency_trace_view read_latency_trace(const uint8_t* region) {
+    latency_trace_view v;
+    if (!region) return v;
+    auto field = [region](uint32_t off) {
+        return reinterpret_cast<const std::atomic<uint32_t>*>(region + off)
+            ->load(std::memory_order_relaxed);
+    };
+    v.epoch = reinterpret_cast<const std::atomic<uint32_t>*>(region + LATENCY_TRACE_EPOCH)
+                  ->load(std::memory_order_acquire);
+    v.enabled = field(LATENCY_TRACE_ENABLED) != 0;
+    for (uint32_t o = 0; o < LATENCY_TRACE_ORIGINS; ++o)
+        v.origin_ids[o] = field(LATENCY_TRACE_ORIGIN_IDS + o * 4);
+    for (uint32_t c = 0; c < LATENCY_TRACE_CLASSES; ++c)
+        v.max_us[c] = field(LATENCY_TRACE_MAX_US + c * 4);
+    uint32_t off = LATENCY_TRACE_COUNTS;
+    for (auto& row : v.counts)
+        for (auto& cls : row)
+            for (auto& n : cls) {
+                n = field(off);
+                off += 4;
+            }
+    return v;
+}
+
+// ──── Bus-meter view ─────────────────────────────────────────────────────
+//
+// Seqlock-consistent snapshot of the level meters (METER_*; see
+// bus_meter.h): one row per metered channel, the hardware outputs first,
+// then the requested buses. `valid` is false until the engine has applied a
+// request. Levels are linear amplitude.
+
+struct meter_view {
+    struct row {
+        float peak = 0.f;        // sample peak, falling 20 dB per peak_ms
+        float rms = 0.f;         // over an rms_ms time constant
+        float true_peak = 0.f;   // 4x oversampled; = peak unless requested
+        float max = 0.f;         // highest true peak since the request applied
+    };
+
+    bool     valid = false;
+    uint32_t gen = 0;            // the request generation applied
+    uint32_t flags = 0;          // METER_FLAG_*
+    uint32_t outputs = 0;
+    uint32_t buses = 0;
+    uint32_t rms_ms = 0;
+    uint32_t peak_ms = 0;
+    uint32_t blocks = 0;         // blocks metered since applied
+    uint32_t bus_ids[METER_MAX_BUSES] = {};
+    row      rows[METER_MAX_CHANNELS] = {};
+
+    const row& output(uint32_t ch) const { return rows[ch]; }
+    const row& bus(uint32_t i) const { return rows[outputs + i]; }
+};
+
+inline meter_view read_meters(const uint8_t* region) {
+    meter_view v;
+    if (!region) return v;
+    auto field = [region](uint32_t off) {
+        return reinterpret_cast<const std::atomic<uint32_t>*>(region + off)
+            ->load(std::memory_order_relaxed);
+    };
+    auto level = [&field](uint32_t off) {
+        const uint32_t bits = field(off);
+        float f;
+        std::memcpy(&f, &bits, sizeof f);
+        return f;
+    };
+    auto* seq = reinterpret_cast<const std::atomic<uint32_t>*>(region + METER_SEQ);
+    for (int tries = 0; tries < 8; ++tries) {
+        const uint32_t s0 = seq->load(std::memory_order_acquire);
+        if (s0 == 0)
+            return v;  // never published
+        if (s0 & 1u)
+            continue;  // writer mid-update
+        meter_view t;
+        t.gen     = field(METER_GEN);
+        t.flags   = field(METER_FLAGS);
+        t.outputs = std::min(field(METER_OUTPUTS), METER_MAX_OUTPUTS);
+        t.buses   = std::min(field(METER_BUSES), METER_MAX_BUSES);
+        t.rms_ms  = field(METER_RMS_MS);
+        t.peak_ms = field(METER_PEAK_MS);
+        t.blocks  = field(METER_BLOCKS);
+        for (uint32_t i = 0; i < METER_MAX_BUSES; ++i)
+            t.bus_ids[i] = field(METER_BUS_IDS + i * 4);
+        for (uint32_t c = 0; c < METER_MAX_CHANNELS; ++c) {
+            const uint32_t r = METER_ROWS + c * METER_ROW_SIZE;
+            t.rows[c] = { level(r), level(r + 4), level(r + 8), level(r + 12) };
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq->load(std::memory_order_relaxed) == s0) {
+            t.valid = true;
+            return t;
+        }
+    }
+    return v;
+}
+
+// What to meter. The engine applies it at its next block and echoes the
+// generation in meter_view::gen once it has.
+struct meter_request {
+    bool     on = true;
+    bool     true_peak = false;
+    uint32_t rms_ms = 0;         // 0 = default (300 ms)
+    uint32_t peak_ms = 0;        // 0 = default (20 dB in 1700 ms)
+    uint32_t bus_count = 0;
+    uint32_t buses[METER_MAX_BUSES] = {};
+};
+
+// Write a request and bump its generation; returns the new generation.
+// Requests from several writers at once may interleave — the engine
+// validates whatever it reads, so the cost is metering the wrong buses.
+inline uint32_t write_meter_request(uint8_t* region, const meter_request& req) {
+    auto field = [region](uint32_t off) {
+        return reinterpret_cast<std::atomic<uint32_t>*>(region + off);
+    };
+    field(METER_REQ_FLAGS)->store((req.on ? METER_FLAG_ON : 0u) |
+                                  (req.true_peak ? METER_FLAG_TRUE_PEAK : 0u),
+                                  std::memory_order_relaxed);
+    field(METER_REQ_RMS_MS)->store(req.rms_ms, std::memory_order_relaxed);
+    field(METER_REQ_PEAK_MS)->store(req.peak_ms, std::memory_order_relaxed);
+    const uint32_t n = std::min(req.bus_count, METER_MAX_BUSES);
+    field(METER_REQ_BUS_COUNT)->store(n, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < n; ++i)
+        field(METER_REQ_BUSES + i * 4)->store(req.buses[i], std::memory_order_relaxed);
+    return field(METER_REQ_GEN)->fetch_add(1, std::memory_order_release) + 1;
+}
+
 // ──── Observer views (GUI / passive reader side) ────────────────────────
 //
 // Byte-level views onto observable regions, for consumers that render them
@@ -485,6 +672,24 @@ struct native_stats {
     uint32_t callback_overruns   = 0;  // audio callbacks that overran their budget
     uint32_t nrt_max_pass_ms     = 0;  // longest NRT control-drain pass (high-water)
     uint32_t nrt_in_flight_ms    = 0;  // NRT control-drain pass blocked right now
+    uint32_t egress_max_queue_bytes = 0;  // deepest per-connection egress queue
+    uint32_t egress_dropped         = 0;  // frames dropped by a full egress queue
+    uint32_t egress_overflow_closes = 0;  // clients closed by a full egress queue
+    uint32_t prefetch_hits          = 0;  // /s_new found its registered sample resident
+    uint32_t late_loads             = 0;  // /s_new found its registered sample missing
+    uint32_t evictions              = 0;  // idle registered samples evicted
+    uint32_t resident_kib           = 0;  // KiB held by registered samples
+    uint32_t converged_units        = 0;  // smoothing units on their constant fill
+    uint32_t fft_transforms         = 0;  // FFT/IFFT transforms since boot
+    uint32_t fft_block_peak         = 0;  // most transforms in one block, last window
+    uint32_t arena_allocs           = 0;  // constructor RTAllocs from node arenas
+    uint32_t arena_pool_allocs      = 0;  // constructor RTAllocs from the pool
+    uint32_t arena_synths           = 0;  // synths constructed
+    uint32_t idle_blocks            = 0;  // blocks skipped while idle
+    uint32_t precoded_cmds          = 0;  // commands run from pre-decoded records
+    uint32_t world_resizes          = 0;  // runtime World resizes applied
+    uint32_t world_resize_apply_us  = 0;  // audio-thread time of the last one
+    uint32_t world_resize_bytes     = 0;  // memory added by all of them
 };
 
 // ──── Creator (audio engine side) ───────────────────────────────────────
@@ -593,7 +798,9 @@ public:
             || header->node_tree_offset != NODE_TREE_START
             || header->audio_offset    != SHM_AUDIO_START
             || header->scope_offset    != SHM_SCOPE_START
-            || header->sample_clock_offset != SAMPLE_CLOCK_START)
+            || header->sample_clock_offset != SAMPLE_CLOCK_START
+            || header->latency_trace_offset != LATENCY_TRACE_START
+            || header->meter_offset != METER_START)
             throw std::runtime_error(
                 "Shared memory layout mismatch — engine and reader were built "
                 "with different memory profiles (test-sized build staged as "
@@ -645,7 +852,25 @@ public:
                  field(NATIVE_STAT_BUFFER_BYTES),   field(NATIVE_STAT_CPU_AVG_CENTI),
                  field(NATIVE_STAT_CPU_PEAK_CENTI), field(NATIVE_STAT_CB_OVERRUNS),
                  field(NATIVE_STAT_NRT_MAX_PASS_MS),
-                 field(NATIVE_STAT_NRT_IN_FLIGHT_MS) };
+                 field(NATIVE_STAT_NRT_IN_FLIGHT_MS),
+                 field(NATIVE_STAT_EGRESS_MAX_QUEUE_BYTES),
+                 field(NATIVE_STAT_EGRESS_DROPPED),
+                 field(NATIVE_STAT_EGRESS_OVERFLOW_CLOSES),
+                 field(NATIVE_STAT_PREFETCH_HITS),
+                 field(NATIVE_STAT_LATE_LOADS),
+                 field(NATIVE_STAT_EVICTIONS),
+                 field(NATIVE_STAT_RESIDENT_KIB),
+                 field(NATIVE_STAT_CONVERGED_UNITS),
+                 field(NATIVE_STAT_FFT_TRANSFORMS),
+                 field(NATIVE_STAT_FFT_BLOCK_PEAK),
+                 field(NATIVE_STAT_ARENA_ALLOCS),
+                 field(NATIVE_STAT_ARENA_POOL_ALLOCS),
+                 field(NATIVE_STAT_ARENA_SYNTHS),
+                 field(NATIVE_STAT_IDLE_BLOCKS),
+                 field(NATIVE_STAT_PRECODED_CMDS),
+                 field(NATIVE_STAT_WORLD_RESIZES),
+                 field(NATIVE_STAT_WORLD_RESIZE_APPLY_US),
+                 field(NATIVE_STAT_WORLD_RESIZE_BYTES) };
     }
     // Native segments always carry the stats region; a web-origin arena has no
     // shm client at all. Kept for observer-API symmetry.
@@ -660,6 +885,18 @@ public:
         return read_sample_clock(shm->get_base() + SAMPLE_CLOCK_START);
     }
 
+    latency_trace_view get_latency_trace() {
+        return read_latency_trace(shm->get_base() + LATENCY_TRACE_START);
+    }
+
+    meter_view get_meters() {
+        return read_meters(shm->get_base() + METER_START);
+    }
+
+    uint32_t request_meters(const meter_request& req) {
+        return write_meter_request(shm->get_base() + METER_START, req);
+    }
+
     shm_audio_buffer* get_audio_buffer(unsigned int index) {
         return shm->get_audio_buffer(index);
     }
@@ -694,4 +931,10 @@ using detail_server_shm::ring_view;
 using detail_server_shm::node_tree_view;
 using detail_server_shm::native_stats;
 using detail_server_shm::sample_clock_view;
+using detail_server_shm::latency_trace_view;
+using detail_server_shm::read_latency_trace;
+using detail_server_shm::meter_view;
+using detail_server_shm::meter_request;
+using detail_server_shm::read_meters;
+using detail_server_shm::write_meter_request;
 // shm_audio_buffer + AUDIO_* names are exported by shm_audio_buffer.hpp.
@@ -28,6 +28,22 @@ enum { kGraph_Reblock = 0x1, kGraph_Resample = 0x2 };
 
 #define kGraph_ReblockOrResample (kGraph_Reblock | kGraph_Resample)
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] Zero-copy bus reads. For a unit that copies a bus into its
+// outputs (In.ar, InFeedback.ar, LocalIn.ar), the inputs that read each of its
+// output channels, so the unit can point them at the bus instead of copying.
+// Guards are the audio-rate bus writers that run between the unit and its
+// last reader; the unit checks their buses every block. Built at load by
+// GraphDef_FindBusAliases (SC_GraphDef.cpp) and shared by the def's synths.
+struct BusAlias {
+    uint32 mNumChannels; // 0: nothing may read this unit's bus in place
+    const int32* mChannelStart; // mNumChannels + 1 offsets into mReaders, in pairs
+    const int32* mReaders; // (unit index, input index) pairs, by channel
+    uint32 mNumGuards;
+    const int32* mGuards; // (unit index, first channel input, channel count)
+};
+#endif
+
 /*
  changes to this struct likely also mean that a change is needed for
     static const int sc_api_version = x;
@@ -75,5 +91,19 @@ struct Graph {
     int localMaxBufNum;
 
     void* mPrivate;
+
+#ifdef SUPERSONIC
+    // [SUPERSONIC] Hop phase shared by this synth's FFTs, or -1 until its first
+    // FFT takes one (see FFT_UGens.cpp).
+    int32 mFFTPhase;
+    // [SUPERSONIC] Per-unit BusAlias table from the GraphDef, or null.
+    const struct BusAlias* mBusAliases;
+    // [SUPERSONIC] Constructor arena (SC_Graph.cpp): the node's block, or null,
+    // its size, the bytes handed out, and what the constructors asked for.
+    char* mArena;
+    uint32 mArenaSize;
+    uint32 mArenaUsed;
+    uint32 mArenaDemand;
+#endif
 };
 typedef struct Graph Graph;
@@ -24,6 +24,10 @@
 
 #define GETSNDFILE(x) ((SNDFILE*)x->sndfile)
 
+#ifdef SUPERSONIC
+#    include <atomic>
+#endif
+
 #ifdef SUPERNOVA
 
 #    include <atomic>
@@ -165,6 +169,13 @@ struct SndBuf {
     bool isLocal;
     mutable rw_spinlock lock;
 #endif
+#ifdef SUPERSONIC
+    // [SUPERSONIC] Set by anything that writes the samples on the audio
+    // thread (LOCK_SNDBUF, /b_set, /b_setn, /b_fill). Sample compaction clears
+    // it when it snapshots the buffer and drops its copy if it is set again
+    // before the copy is swapped in. Audio thread only.
+    int written;
+#endif
 };
 
 typedef struct SndBuf SndBuf;
@@ -172,9 +183,20 @@ typedef struct SndBuf SndBuf;
 struct SndBufUpdates {
     int reads;
     int writes;
+#ifdef SUPERSONIC
+    // [SUPERSONIC] Buffer commands between their NRT Stage2 and their Stage3
+    // (SC_SequencedCommand::HoldBuffer), plus kSndBufMoving while the audio
+    // thread moves or drops the buffer's data (SampleLoader). Each side only
+    // goes ahead when the other is absent.
+    std::atomic<uint32_t> busy;
+#endif
 };
 typedef struct SndBufUpdates SndBufUpdates;
 
+#ifdef SUPERSONIC
+constexpr uint32_t kSndBufMoving = 0x80000000u;
+#endif
+
 enum { coord_None, coord_Complex, coord_Polar };
 
 #ifdef SUPERSONIC
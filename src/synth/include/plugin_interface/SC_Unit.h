@@ -258,15 +258,31 @@ template <bool shared> struct buffer_lock {
 #    define RELEASE_BUS_AUDIO(index)
 #    define RELEASE_BUS_AUDIO_SHARED(index)
 
-#    define LOCK_SNDBUF(buf)
+#    ifdef SUPERSONIC
+// [SUPERSONIC] No locks, but exclusive access marks the buffer written
+// (SndBuf::written), so a compaction copy taken before it is not swapped in.
+#        define LOCK_SNDBUF(buf) ((buf)->written = 1)
+#    else
+#        define LOCK_SNDBUF(buf)
+#    endif
 #    define LOCK_SNDBUF_SHARED(buf)
 
-#    define LOCK_SNDBUF2(buf1, buf2)
+#    ifdef SUPERSONIC
+#        define LOCK_SNDBUF2(buf1, buf2) ((buf1)->written = (buf2)->written = 1)
+#        define LOCK_SNDBUF2_EXCLUSIVE_SHARED(buf1, buf2) ((buf1)->written = 1)
+#        define LOCK_SNDBUF2_SHARED_EXCLUSIVE(buf1, buf2) ((buf2)->written = 1)
+#    else
+#        define LOCK_SNDBUF2(buf1, buf2)
+#        define LOCK_SNDBUF2_EXCLUSIVE_SHARED(buf1, buf2)
+#        define LOCK_SNDBUF2_SHARED_EXCLUSIVE(buf1, buf2)
+#    endif
 #    define LOCK_SNDBUF2_SHARED(buf1, buf2)
-#    define LOCK_SNDBUF2_EXCLUSIVE_SHARED(buf1, buf2)
-#    define LOCK_SNDBUF2_SHARED_EXCLUSIVE(buf1, buf2)
 
-#    define ACQUIRE_SNDBUF(buf)
+#    ifdef SUPERSONIC
+#        define ACQUIRE_SNDBUF(buf) ((buf)->written = 1)
+#    else
+#        define ACQUIRE_SNDBUF(buf)
+#    endif
 #    define ACQUIRE_SNDBUF_SHARED(buf)
 #    define RELEASE_SNDBUF(buf)
 #    define RELEASE_SNDBUF_SHARED(buf)
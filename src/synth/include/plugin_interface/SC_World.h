@@ -109,6 +109,37 @@ struct World {
     nova::spin_lock* mControlBusLock;
 #endif
 
+#ifdef SUPERSONIC
+    // [SUPERSONIC] Smoothing units (Lag family, Ramp, VarLag) currently on their
+    // converged constant-fill calc function. Audio thread only.
+    uint32 mNumConvergedUnits;
+
+    // [SUPERSONIC] Staggered FFT frames (FFT_UGens.cpp). mFFTPhaseNext hands
+    // each synth with FFTs its hop phase, round-robin. The plugin counts the
+    // transforms it runs in mFFTsThisBlock; EngineCore_BeginBlock folds that
+    // into the running total and the per-block peak.
+    uint32 mFFTPhaseNext;
+    uint32 mFFTsThisBlock;
+    uint32 mFFTBlockPeak;
+    uint32 mFFTTransforms;
+
+    // [SUPERSONIC] Per-node constructor arenas (SC_Graph.cpp). mArenaGraph is
+    // the synth whose units are running, so RTFree can tell its arena memory
+    // apart; mArenaCtors is set while its constructors run. The counters are
+    // constructor RTAllocs served from an arena and from the pool, and synths
+    // constructed.
+    struct Graph* mArenaGraph;
+    SCBool mArenaCtors;
+    uint32 mArenaAllocs;
+    uint32 mArenaPoolAllocs;
+    uint32 mArenaSynths;
+
+    // [SUPERSONIC] LocalBuf numbers handed out and not yet freed
+    // (DelayUGens.cpp). They are offsets past mNumSndBufs, so
+    // World_ApplyResize may not raise that while any are live.
+    uint32 mNumLocalBufs;
+#endif
+
 #ifdef SC_BELA
     BelaContext* mBelaContext;
     BelaScope* mBelaScope;
@@ -120,8 +120,11 @@ enum {
 #ifdef SUPERSONIC
     cmd_b_allocPtr = 66,
     cmd_superclock_get = 67,
+    cmd_d_optimise = 68,
+    cmd_d_stats = 69,
+    cmd_d_arena = 70,
 
-    NUMBER_OF_COMMANDS = 68
+    NUMBER_OF_COMMANDS = 71
 #else
     NUMBER_OF_COMMANDS = 66
 #endif
@@ -0,0 +1,280 @@
+/*
+ * BandLimitedOsc.hpp — polynomial band-limited oscillator kernels.
+ *
+ * [SUPERSONIC] The alternative kernels behind the `mode` input on Saw, Pulse,
+ * Blip (OscUGens.cpp) and LFTri (LFUGens.cpp). Upstream's Saw/Pulse/Blip
+ * integrate a harmonic-limited impulse train built from sine and cosecant
+ * table lookups plus a division per sample; these start from a naive phase
+ * accumulator and patch the samples either side of each discontinuity with a
+ * two-sample polynomial residual instead:
+ *
+ *   PolyBLEP   step discontinuities (saw reset, pulse edges)
+ *   PolyBLAMP  slope discontinuities (triangle corners)
+ *
+ * Blip keeps upstream's closed-form Dirichlet kernel but steps its two sines
+ * as rotating phasors rather than looking them up in the sine/cosecant tables.
+ *
+ * Each sample's phase is computed in closed form from the block's start phase
+ * (no loop-carried accumulator) and the residuals are selects rather than
+ * branches, so with NOVA_SIMD a block is rendered a nova::vec at a time; the
+ * scalar path covers control rate and block sizes that are not a multiple of
+ * the vector width. Aliasing is not zero — the residual only spans two samples
+ * — see test/band_limited_osc.spec.mjs for the measured levels.
+ *
+ * Levels and polarity match the upstream UGens, so switching mode never
+ * changes a patch's gain: Saw falls from +0.5 to -0.5, Pulse sits at `w`
+ * then `w - 1`, Blip is the normalised cosine sum, LFTri spans -1..1.
+ *
+ * No SC dependencies: the kernels take plain arrays so they can be driven and
+ * benchmarked outside a World.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#ifdef NOVA_SIMD
+#    include "vec.hpp"
+#endif
+
+namespace blosc {
+
+// ── Lane helpers: one spelling for float and nova::vec<float> ───────────────
+
+inline float wrap01(float x) { return x - std::floor(x); }
+inline float absval(float x) { return std::fabs(x); }
+inline float recip(float x) { return 1.f / x; }
+// a < b ? x : y
+inline float ifLess(float a, float b, float x, float y) { return a < b ? x : y; }
+
+#ifdef NOVA_SIMD
+using vecf = nova::vec<float>;
+
+inline vecf wrap01(vecf x) { return frac(x); }
+inline vecf absval(vecf x) { return abs(x); }
+inline vecf recip(vecf x) { return reciprocal(x); }
+inline vecf ifLess(vecf a, vecf b, vecf x, vecf y) { return select(y, x, mask_lt(a, b)); }
+#endif
+
+// Calls f(sampleIndex) for every sample of the block and stores the result;
+// a vector of consecutive indices at a time when the block allows it.
+template <typename F> inline void render(float* out, int n, F&& f) {
+#ifdef NOVA_SIMD
+    if (n % vecf::size == 0) {
+        float lanes[vecf::size];
+        for (int l = 0; l < vecf::size; ++l)
+            lanes[l] = static_cast<float>(l);
+        vecf fi;
+        fi.load(lanes);
+        const vecf step(static_cast<float>(vecf::size));
+        for (int i = 0; i < n; i += vecf::size) {
+            f(fi).store(out + i);
+            fi = fi + step;
+        }
+        return;
+    }
+#endif
+    for (int i = 0; i < n; ++i)
+        out[i] = f(static_cast<float>(i));
+}
+
+// Phase after n samples. Kept in double by the units so long runs don't drift.
+inline double advance(double phase, float inc, int n) {
+    phase += static_cast<double>(inc) * n;
+    return phase - std::floor(phase);
+}
+
+// Per-sample increment bounds. Above Nyquist the two residual windows overlap
+// and the waveform is meaningless anyway; the floor keeps 1/dt finite for a
+// stopped oscillator. The residuals take the magnitude; the wrap direction is
+// handled by the residual's symmetry (see blep).
+inline float clampInc(float dt) {
+    dt = std::fabs(dt);
+    return dt < 1e-7f ? 1e-7f : (dt > 0.5f ? 0.5f : dt);
+}
+
+// ── Residuals ───────────────────────────────────────────────────────────────
+
+// Residual of a unit upward step at phase 0, for a sample at phase t (cycles,
+// [0,1)) with per-sample increment dt and rdt = 1/dt. Non-zero only on the
+// sample either side of the wrap.
+//
+// dt is |inc|. Running backwards (inc < 0) the waveform crosses the same step
+// from the other side, so both the step's sign and which side is "after" flip.
+// The residual is odd about the wrap, so the two flips cancel and the same
+// function of phase is correct in both directions: a negative frequency
+// renders the time-reversed waveform (test/band_limited_osc.spec.mjs).
+template <typename T> inline T blep(T t, T dt, T rdt) {
+    const T one(1.f);
+    const T a = one - t * rdt;         // after the wrap: t in [0, dt)
+    const T b = one + (t - one) * rdt; // before it:      t in (1-dt, 1)
+    return ifLess(t, dt, T(-0.5f) * a * a, T(0.f)) + ifLess(one - dt, t, T(0.5f) * b * b, T(0.f));
+}
+
+// Residual of a unit slope increase (per sample) at phase 0 — the integral of
+// blep(). Scale by the slope change in output units per sample, taken at
+// |inc|: reversed, the corner's slope change and its sides both flip, and the
+// residual is even about it, so the two cancel as in blep().
+template <typename T> inline T blamp(T t, T dt, T rdt) {
+    const T one(1.f), sixth(1.f / 6.f);
+    const T a = one - t * rdt;
+    const T b = one + (t - one) * rdt;
+    return ifLess(t, dt, sixth * a * a * a, T(0.f)) + ifLess(one - dt, t, sixth * b * b * b, T(0.f));
+}
+
+// sin(2*pi*x) for any x: reduce to [-0.25, 0.25] cycles, then an odd
+// polynomial (max error ~4e-6). Its relative accuracy near zero is what keeps
+// blip()'s ratio finite next to the impulse.
+template <typename T> inline T sin2pi(T x) {
+    T r = wrap01(x + T(0.5f)) - T(0.5f);
+    r = ifLess(T(0.25f), r, T(0.5f) - r, r);
+    r = ifLess(r, T(-0.25f), T(-0.5f) - r, r);
+    const T z = r * r;
+    return r
+        * (T(6.2831853f)
+           + z * (T(-41.341702f) + z * (T(81.605249f) + z * (T(-76.705859f) + z * T(42.058694f)))));
+}
+
+// ── Block kernels ───────────────────────────────────────────────────────────
+// `phase` is the cycle position of out[0]; each returns the position after
+// the block.
+
+// Falling saw, +0.5 -> -0.5 per cycle.
+inline double saw(float* out, int n, double phase, float inc) {
+    const float dt = clampInc(inc), rdt = 1.f / dt, p0 = static_cast<float>(phase);
+    render(out, n, [=](auto fi) {
+        using T = decltype(fi);
+        const T p = wrap01(T(p0) + fi * T(inc));
+        return T(0.5f) - p + blep(p, T(dt), T(rdt));
+    });
+    return advance(phase, inc, n);
+}
+
+// Pulse as the difference of two saws offset by the width, as upstream does:
+// `w` for the first (1 - w) of the cycle, `w - 1` for the rest. The width
+// ramps linearly from w0 to w1 across the block.
+inline double pulse(float* out, int n, double phase, float inc, float w0, float w1) {
+    const float dt = clampInc(inc), rdt = 1.f / dt, p0 = static_cast<float>(phase);
+    const float dw = n > 0 ? (w1 - w0) / static_cast<float>(n) : 0.f;
+    // The second edge moves at inc + dw per sample while the width slews.
+    const float inc2 = inc + dw, dt2 = clampInc(inc2), rdt2 = 1.f / dt2;
+    render(out, n, [=](auto fi) {
+        using T = decltype(fi);
+        const T p = wrap01(T(p0) + fi * T(inc));
+        const T q = wrap01(T(p0 + w0) + fi * T(inc2));
+        return (q - p) + blep(p, T(dt), T(rdt)) - blep(q, T(dt2), T(rdt2));
+    });
+    return advance(phase, inc, n);
+}
+
+// One triangle sample: -1..1, trough at phase 0, peak at 0.5 (LFTri's shape in
+// cycles rather than LFTri's [-1, 3) phase units).
+template <typename T> inline T triAt(T p, float dt, float rdt) {
+    const T h = wrap01(p + T(0.5f));
+    const T naive = ifLess(p, T(0.5f), T(4.f) * p - T(1.f), T(3.f) - T(4.f) * p);
+    // Each corner changes the slope by 8 * dt per sample.
+    return naive + T(8.f * dt) * (blamp(p, T(dt), T(rdt)) - blamp(h, T(dt), T(rdt)));
+}
+
+inline double tri(float* out, int n, double phase, float inc) {
+    const float dt = clampInc(inc), rdt = 1.f / dt, p0 = static_cast<float>(phase);
+    render(out, n, [=](auto fi) {
+        using T = decltype(fi);
+        return triAt(wrap01(T(p0) + fi * T(inc)), dt, rdt);
+    });
+    return advance(phase, inc, n);
+}
+
+// Per-sample triangle step for an audio-rate frequency; the caller owns the
+// loop.
+inline float triSample(double& phase, float inc) {
+    const float dt = clampInc(inc);
+    const float z = triAt(static_cast<float>(phase), dt, 1.f / dt);
+    phase += inc;
+    phase -= std::floor(phase);
+    return z;
+}
+
+// Band-limited impulse train: sum_{k=1..N} cos(2*pi*k*phase) / N, peak 1 —
+// upstream's closed-form Dirichlet kernel sin(K*x) / sin(x), x = pi*phase,
+// K = 2N+1. Rather than evaluating both sines per sample, each is a unit phasor
+// rotated by a fixed step: seeded once per block from polynomial sines (one
+// seed per lane), then a complex multiply per sample. When the harmonic count
+// changes the block crossfades from nPrev to nHarm, as upstream does.
+template <typename T> struct Phasor {
+    T c, s;       // cos, sin of the current angle (cycles = a + lane * step)
+    float rc, rs; // rotation by `lanes` samples
+
+    void seed(T cycles, float advance) {
+        c = sin2pi(cycles + T(0.25f));
+        s = sin2pi(cycles);
+        rc = std::cos(6.2831853f * advance);
+        rs = std::sin(6.2831853f * advance);
+    }
+    void rotate() {
+        const T c1 = c * T(rc) - s * T(rs);
+        s = s * T(rc) + c * T(rs);
+        c = c1;
+    }
+};
+
+// sin(K*x)/sin(x) - 1, scaled: the upstream kernel with its limit at the
+// impulse, where both sines vanish (same threshold as upstream).
+template <typename T> inline T dirichlet(T num, T den, T rden, float k, float scale) {
+    return (ifLess(absval(den), T(0.0005f), T(k), num * rden) - T(1.f)) * T(scale);
+}
+
+template <typename T, int L>
+inline void blipLanes(float* out, int n, float p0, float inc, float k, float scale, float kPrev, float scalePrev) {
+    float lanes[L];
+    for (int l = 0; l < L; ++l)
+        lanes[l] = static_cast<float>(l);
+    T fi;
+    if constexpr (L == 1)
+        fi = 0.f;
+    else
+        fi.load(lanes);
+
+    // Half-phase in cycles: x = pi * phase.
+    const T x0 = T(0.5f * p0) + fi * T(0.5f * inc);
+    const float step = 0.5f * inc * L;
+    Phasor<T> den, num, prev;
+    den.seed(x0, step);
+    num.seed(x0 * T(k), step * k);
+    const bool xfade = kPrev != k;
+    if (xfade)
+        prev.seed(x0 * T(kPrev), step * kPrev);
+    const T xfadeStep(n > 0 ? 1.f / static_cast<float>(n) : 0.f);
+
+    for (int i = 0; i < n; i += L) {
+        const T rden = recip(ifLess(absval(den.s), T(0.0005f), T(1.f), den.s));
+        T z = dirichlet(num.s, den.s, rden, k, scale);
+        if (xfade) {
+            const T zPrev = dirichlet(prev.s, den.s, rden, kPrev, scalePrev);
+            z = zPrev + fi * xfadeStep * (z - zPrev);
+            prev.rotate();
+            fi = fi + T(static_cast<float>(L));
+        }
+        if constexpr (L == 1)
+            out[i] = z;
+        else
+            z.store(out + i);
+        den.rotate();
+        num.rotate();
+    }
+}
+
+inline double blip(float* out, int n, double phase, float inc, int32_t nHarm, int32_t nPrev) {
+    const float p0 = static_cast<float>(phase);
+    const float k = static_cast<float>(2 * nHarm + 1), scale = 0.5f / static_cast<float>(nHarm);
+    const float kPrev = static_cast<float>(2 * nPrev + 1), scalePrev = 0.5f / static_cast<float>(nPrev);
+#ifdef NOVA_SIMD
+    if (n % vecf::size == 0)
+        blipLanes<vecf, vecf::size>(out, n, p0, inc, k, scale, kPrev, scalePrev);
+    else
+#endif
+        blipLanes<float, 1>(out, n, p0, inc, k, scale, kPrev, scalePrev);
+    return advance(phase, inc, n);
+}
+
+} // namespace blosc
@@ -657,12 +657,20 @@ void LocalBuf_Ctor(LocalBuf* unit) {
         LocalBuf_allocBuffer(unit, unit->m_buf, (int)IN0(0), (int)IN0(1));
         if (!unit->chunk)
             fbufnum = -1.f;
+#ifdef SUPERSONIC
+        else
+            unit->mWorld->mNumLocalBufs++;
+#endif
     }
 
     OUT0(0) = fbufnum;
 }
 
 void LocalBuf_Dtor(LocalBuf* unit) {
+#ifdef SUPERSONIC
+    if (unit->chunk)
+        unit->mWorld->mNumLocalBufs--;
+#endif
     RTFree(unit->mWorld, unit->chunk);
     if (unit->mParent->localBufNum <= 1) { // only the last time.
         for (int i = 0; i != unit->mParent->localMaxBufNum; ++i)
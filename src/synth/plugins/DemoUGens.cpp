@@ -275,6 +275,51 @@ void UnitCmdDemo_Dtor(UnitCmdDemo* unit) {
     }
 }
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] Unit commands on constructor memory, for the per-node arena
+// tests (test_node_arena.cpp). The constructor RTAllocs a table of ones,
+// which comes from the node's arena once the def has been measured; "resize"
+// RTReallocs it from a unit command and fills the new entries with ones. The
+// output is the table's sum, so it shows the size and that the data survived.
+
+struct ArenaCmdDemo : public Unit {
+    float* table;
+    int size;
+};
+
+void ArenaCmdDemo_next(ArenaCmdDemo* unit, int inNumSamples) {
+    float sum = 0.f;
+    for (int i = 0; i < unit->size; ++i)
+        sum += unit->table[i];
+    OUT0(0) = sum;
+}
+
+void ArenaCmdDemo_Ctor(ArenaCmdDemo* unit) {
+    unit->size = 0;
+    unit->table = (float*)RTAlloc(unit->mWorld, 4 * sizeof(float));
+    ClearUnitIfMemFailed(unit->table);
+    std::fill_n(unit->table, 4, 1.f);
+    unit->size = 4;
+    SETCALC(ArenaCmdDemo_next);
+    ArenaCmdDemo_next(unit, 1);
+}
+
+void ArenaCmdDemo_resize(ArenaCmdDemo* unit, sc_msg_iter* args) {
+    int size = args->geti();
+    if (size <= 0 || !unit->table)
+        return;
+    float* table = (float*)RTRealloc(unit->mWorld, unit->table, size * sizeof(float));
+    if (!table)
+        return;
+    if (size > unit->size)
+        std::fill_n(table + unit->size, size - unit->size, 1.f);
+    unit->table = table;
+    unit->size = size;
+}
+
+void ArenaCmdDemo_Dtor(ArenaCmdDemo* unit) { RTFree(unit->mWorld, unit->table); }
+#endif
+
 PluginLoad(DemoUGens) {
     ft = inTable;
 
@@ -293,4 +338,9 @@ PluginLoad(DemoUGens) {
     // Let's also define an extended (asynchronous) unit command.
     // ('testCommand' calls DoAsyncUnitCommand.)
     DefineUnitCmdEx("UnitCmdDemo", "testCommand", (UnitCmdFuncEx)&UnitCmdDemo_testCommand);
+
+#ifdef SUPERSONIC
+    DefineDtorUnit(ArenaCmdDemo);
+    DefineUnitCmd("ArenaCmdDemo", "resize", (UnitCmdFunc)&ArenaCmdDemo_resize);
+#endif
 }
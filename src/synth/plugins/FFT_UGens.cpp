@@ -139,6 +139,35 @@ static int FFTBase_Ctor(FFTBase* unit, int frmsizinput) {
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] Staggered frames. Upstream every FFT starts its hop count at 0,
+// so chains started in the same block transform together in one block out of
+// every hop and in none of the others. Here each synth takes a phase from a
+// round-robin World counter, and its FFTs start their count part-way through
+// the hop so that frames land on blocks whose index, modulo the hop in blocks,
+// is that phase. The FFTs of one synth share a phase, so chains that meet in a
+// PV_ unit stay in step. A non-zero trailing "align" input (7th, after
+// winsize) keeps upstream timing, for analyses that must line up across synths.
+static void FFT_Stagger(FFT* unit) {
+    const int step = unit->m_numSamples;
+    if (step != FULLBUFLENGTH || (unit->mNumInputs > 6 && ZIN0(6) > 0.f)
+        || (unit->mParent->mFlags & kGraph_ReblockOrResample)) // block index != call count
+        return;
+    const int hopBlocks = unit->m_hopsize / step;
+    if (hopBlocks < 2)
+        return;
+    Graph* graph = unit->mParent;
+    if (graph->mFFTPhase < 0)
+        graph->mFFTPhase = (int32)(unit->mWorld->mFFTPhaseNext++ & 0x7fffffff);
+    // Counting from `lead` blocks in, the frame lands hopBlocks - lead calls
+    // from now, the first call being this block.
+    int lead = (int)(((int64)unit->mWorld->mBufCounter - 1 - graph->mFFTPhase) % hopBlocks);
+    if (lead < 0)
+        lead += hopBlocks;
+    unit->m_pos = lead * step;
+}
+#endif
+
 void FFT_Ctor(FFT* unit) {
     int winType = sc_clip((int)ZIN0(3), -1, 1); // wintype may be used by the base ctor
     unit->m_wintype = winType;
@@ -182,6 +211,9 @@ void FFT_Ctor(FFT* unit) {
     } else {
         unit->m_numSamples = 1;
     }
+#ifdef SUPERSONIC
+    FFT_Stagger(unit);
+#endif
 
     SETCALC(FFT_next);
 }
@@ -218,6 +250,9 @@ void FFT_next(FFT* unit, int wrongNumSamples) {
         unit->m_pos = 0;
         if (gate) {
             scfft_dofft(unit->m_scfft);
+#ifdef SUPERSONIC
+            ++unit->mWorld->mFFTsThisBlock;
+#endif
             unit->m_fftsndbuf->coord = coord_Complex;
             ZOUT0(0) = unit->m_fftbufnum;
         } else {
@@ -293,6 +328,9 @@ void IFFT_next(IFFT* unit, int wrongNumSamples) {
         float* fftbuf = unit->m_fftsndbuf->data;
 
         scfft_doifft(unit->m_scfft);
+#ifdef SUPERSONIC
+        ++unit->mWorld->mFFTsThisBlock;
+#endif
 
         // Then shunt the "old" time-domain output down by one hop
         int hopsamps = pos;
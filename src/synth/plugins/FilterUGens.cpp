@@ -45,42 +45,66 @@ static InterfaceTable* ft;
 struct Ramp : public Unit {
     double m_level, m_slope;
     int m_counter;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct Lag : public Unit {
     float m_lag;
     double m_b1, m_y1;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct Lag2 : public Unit {
     float m_lag;
     double m_b1, m_y1a, m_y1b;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct Lag3 : public Unit {
     float m_lag;
     double m_b1, m_y1a, m_y1b, m_y1c;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct LagUD : public Unit {
     float m_lagu, m_lagd;
     double m_b1u, m_b1d, m_y1;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct Lag2UD : public Unit {
     float m_lagu, m_lagd;
     double m_b1u, m_b1d, m_y1a, m_y1b;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct Lag3UD : public Unit {
     float m_lagu, m_lagd;
     double m_b1u, m_b1d, m_y1a, m_y1b, m_y1c;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct VarLag : public Unit {
     double m_level, m_slope;
     int m_counter;
     float m_in, m_lagTime;
+#ifdef SUPERSONIC
+    UnitCalcFunc m_resume;
+#endif
 };
 
 struct OnePole : public Unit {
@@ -310,6 +334,17 @@ void Lag3UD_Ctor(Lag3UD* unit);
 void VarLag_next(VarLag* unit, int inNumSamples);
 void VarLag_Ctor(VarLag* unit);
 
+#ifdef SUPERSONIC
+void Ramp_Dtor(Ramp* unit);
+void Lag_Dtor(Lag* unit);
+void Lag2_Dtor(Lag2* unit);
+void Lag3_Dtor(Lag3* unit);
+void LagUD_Dtor(LagUD* unit);
+void Lag2UD_Dtor(Lag2UD* unit);
+void Lag3UD_Dtor(Lag3UD* unit);
+void VarLag_Dtor(VarLag* unit);
+#endif
+
 void OnePole_next_a(OnePole* unit, int inNumSamples);
 void OnePole_next_k(OnePole* unit, int inNumSamples);
 void OnePole_Ctor(OnePole* unit);
@@ -470,6 +505,221 @@ void MoogFF_Ctor(MoogFF* unit);
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] Converged-state fast paths for the smoothing family (Ramp, Lag,
+// Lag2, Lag3, LagUD, Lag2UD, Lag3UD, VarLag). Once a unit's state has stopped
+// moving, it swaps its calc function for a constant fill. The fill re-checks
+// the inputs every block and, the moment anything moves, hands that whole
+// block back to the saved calc function, so the output is bit-identical to
+// never having switched. World::mNumConvergedUnits counts the units on a fill.
+//
+// "Stopped moving" is exact, not a tolerance: every one-pole stage must be a
+// fixed point of its own update (y == in + b1 * (y - in) in double), so the
+// full calc function would recompute the same state on every sample. A stage
+// that ends up a few ulps short of its input, where the update rounds back to
+// the same value, counts too.
+
+// True if input 0 holds `x` for the whole block.
+static inline bool smoothingInputHeld(Unit* unit, int inNumSamples, float x) {
+    const float* in = IN(0);
+    const int n = INRATE(0) == calc_FullRate ? inNumSamples : 1;
+    for (int i = 0; i < n; ++i)
+        if (in[i] != x)
+            return false;
+    return true;
+}
+
+// The value input 0 ended the block on.
+static inline float smoothingLastInput(Unit* unit, int inNumSamples) {
+    return INRATE(0) == calc_FullRate ? IN(0)[inNumSamples - 1] : IN0(0);
+}
+
+// One-pole stage `y` driven by `in` does not move (same expression as the loops).
+static inline bool lagFixed(double in, double b1, double y) { return in + b1 * (y - in) == y; }
+
+// `resume` is the unit's m_resume field (#ifdef SUPERSONIC in each smoothing
+// UGen's struct): null while the unit runs its full calc function, and while it
+// is converged, the calc function to hand back to once its input moves.
+static inline void enterConverged(Unit* unit, UnitCalcFunc& resume, UnitCalcFunc fill) {
+    if (resume)
+        return;
+    resume = unit->mCalcFunc;
+    unit->mCalcFunc = fill;
+    ++unit->mWorld->mNumConvergedUnits;
+}
+
+static inline void leaveConverged(Unit* unit, UnitCalcFunc& resume, int inNumSamples) {
+    unit->mCalcFunc = resume;
+    resume = nullptr;
+    --unit->mWorld->mNumConvergedUnits;
+    (unit->mCalcFunc)(unit, inNumSamples);
+}
+
+static inline void convergedDtor(Unit* unit, UnitCalcFunc resume) {
+    if (resume)
+        --unit->mWorld->mNumConvergedUnits;
+}
+
+// Ramp holds still once its slope no longer changes its level. The fill walks
+// the segment boundaries the block would cross, recomputing each new slope from
+// the input sample the ramp takes there, and stores the same state the full
+// calc function would have.
+static void Ramp_next_converged(Ramp* unit, int inNumSamples) {
+    const float* in = IN(0);
+    const float period = ZIN0(1);
+    const double level = unit->m_level;
+    double slope = unit->m_slope;
+    int counter = unit->m_counter;
+    int pos = 0;
+    while (counter <= inNumSamples - pos) {
+        pos += counter;
+        counter = sc_max(1, (int)(period * SAMPLERATE));
+        slope = (in[BUFLENGTH == 1 ? 0 : pos] - level) / counter;
+        if (level + slope != level) {
+            leaveConverged(unit, unit->m_resume, inNumSamples);
+            return;
+        }
+        if (pos == inNumSamples)
+            break;
+    }
+    unit->m_slope = slope;
+    unit->m_counter = counter - (inNumSamples - pos);
+    Fill(inNumSamples, OUT(0), static_cast<float>(level));
+}
+
+static inline void Ramp_maybeConverge(Ramp* unit) {
+    if (unit->m_level + unit->m_slope == unit->m_level)
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&Ramp_next_converged);
+}
+
+static inline bool Lag_stationary(Lag* unit, float x) { return lagFixed(x, unit->m_b1, unit->m_y1); }
+
+static void Lag_next_converged(Lag* unit, int inNumSamples) {
+    const float x = IN0(0);
+    if (ZIN0(1) == unit->m_lag && smoothingInputHeld(unit, inNumSamples, x) && Lag_stationary(unit, x))
+        Fill(inNumSamples, OUT(0), static_cast<float>(unit->m_y1));
+    else
+        leaveConverged(unit, unit->m_resume, inNumSamples);
+}
+
+static inline void Lag_maybeConverge(Lag* unit, int inNumSamples) {
+    if (Lag_stationary(unit, smoothingLastInput(unit, inNumSamples)))
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&Lag_next_converged);
+}
+
+static inline bool LagUD_stationary(LagUD* unit, float x) {
+    const double y = unit->m_y1;
+    return lagFixed(x, x > y ? unit->m_b1u : unit->m_b1d, y);
+}
+
+static void LagUD_next_converged(LagUD* unit, int inNumSamples) {
+    const float x = IN0(0);
+    if (ZIN0(1) == unit->m_lagu && ZIN0(2) == unit->m_lagd && smoothingInputHeld(unit, inNumSamples, x)
+        && LagUD_stationary(unit, x))
+        Fill(inNumSamples, OUT(0), static_cast<float>(unit->m_y1));
+    else
+        leaveConverged(unit, unit->m_resume, inNumSamples);
+}
+
+static inline void LagUD_maybeConverge(LagUD* unit, int inNumSamples) {
+    if (LagUD_stationary(unit, smoothingLastInput(unit, inNumSamples)))
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&LagUD_next_converged);
+}
+
+static inline bool Lag2_stationary(Lag2* unit, float x) {
+    return lagFixed(x, unit->m_b1, unit->m_y1a) && lagFixed(unit->m_y1a, unit->m_b1, unit->m_y1b);
+}
+
+static void Lag2_next_converged(Lag2* unit, int inNumSamples) {
+    const float x = IN0(0);
+    if (ZIN0(1) == unit->m_lag && smoothingInputHeld(unit, inNumSamples, x) && Lag2_stationary(unit, x))
+        Fill(inNumSamples, OUT(0), static_cast<float>(unit->m_y1b));
+    else
+        leaveConverged(unit, unit->m_resume, inNumSamples);
+}
+
+static inline void Lag2_maybeConverge(Lag2* unit, int inNumSamples) {
+    if (Lag2_stationary(unit, smoothingLastInput(unit, inNumSamples)))
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&Lag2_next_converged);
+}
+
+static inline bool Lag2UD_stationary(Lag2UD* unit, float x) {
+    const double a = unit->m_y1a, b = unit->m_y1b;
+    return lagFixed(x, x > a ? unit->m_b1u : unit->m_b1d, a) && lagFixed(a, a > b ? unit->m_b1u : unit->m_b1d, b);
+}
+
+static void Lag2UD_next_converged(Lag2UD* unit, int inNumSamples) {
+    const float x = IN0(0);
+    if (ZIN0(1) == unit->m_lagu && ZIN0(2) == unit->m_lagd && smoothingInputHeld(unit, inNumSamples, x)
+        && Lag2UD_stationary(unit, x))
+        Fill(inNumSamples, OUT(0), static_cast<float>(unit->m_y1b));
+    else
+        leaveConverged(unit, unit->m_resume, inNumSamples);
+}
+
+static inline void Lag2UD_maybeConverge(Lag2UD* unit, int inNumSamples) {
+    if (Lag2UD_stationary(unit, smoothingLastInput(unit, inNumSamples)))
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&Lag2UD_next_converged);
+}
+
+static inline bool Lag3_stationary(Lag3* unit, float x) {
+    return lagFixed(x, unit->m_b1, unit->m_y1a) && lagFixed(unit->m_y1a, unit->m_b1, unit->m_y1b)
+        && lagFixed(unit->m_y1b, unit->m_b1, unit->m_y1c);
+}
+
+static void Lag3_next_converged(Lag3* unit, int inNumSamples) {
+    const float x = IN0(0);
+    if (ZIN0(1) == unit->m_lag && smoothingInputHeld(unit, inNumSamples, x) && Lag3_stationary(unit, x))
+        Fill(inNumSamples, OUT(0), static_cast<float>(unit->m_y1c));
+    else
+        leaveConverged(unit, unit->m_resume, inNumSamples);
+}
+
+static inline void Lag3_maybeConverge(Lag3* unit, int inNumSamples) {
+    if (Lag3_stationary(unit, smoothingLastInput(unit, inNumSamples)))
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&Lag3_next_converged);
+}
+
+// The third stage picks its coefficient from the first two, as Lag3UD_next does.
+static inline bool Lag3UD_stationary(Lag3UD* unit, float x) {
+    const double a = unit->m_y1a, b = unit->m_y1b, c = unit->m_y1c;
+    const double bab = a > b ? unit->m_b1u : unit->m_b1d;
+    return lagFixed(x, x > a ? unit->m_b1u : unit->m_b1d, a) && lagFixed(a, bab, b) && lagFixed(b, bab, c);
+}
+
+static void Lag3UD_next_converged(Lag3UD* unit, int inNumSamples) {
+    const float x = IN0(0);
+    if (ZIN0(1) == unit->m_lagu && ZIN0(2) == unit->m_lagd && smoothingInputHeld(unit, inNumSamples, x)
+        && Lag3UD_stationary(unit, x))
+        Fill(inNumSamples, OUT(0), static_cast<float>(unit->m_y1c));
+    else
+        leaveConverged(unit, unit->m_resume, inNumSamples);
+}
+
+static inline void Lag3UD_maybeConverge(Lag3UD* unit, int inNumSamples) {
+    if (Lag3UD_stationary(unit, smoothingLastInput(unit, inNumSamples)))
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&Lag3UD_next_converged);
+}
+
+// VarLag reads only the first input sample of a block, and once its counter
+// runs out it holds its level until that input or the lag time changes.
+static void VarLag_next_converged(VarLag* unit, int inNumSamples) {
+    if (*IN(0) == unit->m_in && ZIN0(1) == unit->m_lagTime)
+        Fill(inNumSamples, OUT(0), static_cast<float>(unit->m_level));
+    else
+        leaveConverged(unit, unit->m_resume, inNumSamples);
+}
+
+void Ramp_Dtor(Ramp* unit) { convergedDtor(unit, unit->m_resume); }
+void Lag_Dtor(Lag* unit) { convergedDtor(unit, unit->m_resume); }
+void Lag2_Dtor(Lag2* unit) { convergedDtor(unit, unit->m_resume); }
+void Lag3_Dtor(Lag3* unit) { convergedDtor(unit, unit->m_resume); }
+void LagUD_Dtor(LagUD* unit) { convergedDtor(unit, unit->m_resume); }
+void Lag2UD_Dtor(Lag2UD* unit) { convergedDtor(unit, unit->m_resume); }
+void Lag3UD_Dtor(Lag3UD* unit) { convergedDtor(unit, unit->m_resume); }
+void VarLag_Dtor(VarLag* unit) { convergedDtor(unit, unit->m_resume); }
+#endif
+
 void Ramp_next(Ramp* unit, int inNumSamples) {
     float* out = ZOUT(0);
     float* in = IN(0);
@@ -494,6 +744,9 @@ void Ramp_next(Ramp* unit, int inNumSamples) {
     unit->m_level = level;
     unit->m_slope = slope;
     unit->m_counter = counter;
+#ifdef SUPERSONIC
+    Ramp_maybeConverge(unit);
+#endif
 }
 
 void Ramp_next_1(Ramp* unit, int inNumSamples) {
@@ -508,6 +761,9 @@ void Ramp_next_1(Ramp* unit, int inNumSamples) {
         unit->m_counter = counter = sc_max(1, counter);
         unit->m_slope = (in - unit->m_level) / counter;
     }
+#ifdef SUPERSONIC
+    Ramp_maybeConverge(unit);
+#endif
 }
 
 void Ramp_Ctor(Ramp* unit) {
@@ -520,6 +776,9 @@ void Ramp_Ctor(Ramp* unit) {
     unit->m_counter = 1;
     unit->m_level = ZIN0(0);
     unit->m_slope = 0.f;
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     ZOUT0(0) = unit->m_level;
 }
 
@@ -542,6 +801,9 @@ void Lag_next(Lag* unit, int inNumSamples) {
         LOOP1(inNumSamples, b1 += b1_slope; double y0 = ZXP(in); ZXP(out) = y1 = y0 + b1 * (y1 - y0););
     }
     unit->m_y1 = zapgremlins(y1);
+#ifdef SUPERSONIC
+    Lag_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 void Lag_next_1(Lag* unit, int inNumSamples) {
@@ -562,6 +824,9 @@ void Lag_next_1(Lag* unit, int inNumSamples) {
         *out = y1 = y0 + b1 * (y1 - y0);
     }
     unit->m_y1 = zapgremlins(y1);
+#ifdef SUPERSONIC
+    Lag_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 void Lag_Ctor(Lag* unit) {
@@ -573,6 +838,9 @@ void Lag_Ctor(Lag* unit) {
     unit->m_lag = uninitializedControl;
     unit->m_b1 = 0.f;
     unit->m_y1 = ZIN0(0);
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     Lag_next(unit, 1);
 }
 
@@ -601,6 +869,9 @@ void LagUD_next(LagUD* unit, int inNumSamples) {
               if (y0 > y1) ZXP(out) = y1 = y0 + b1u * (y1 - y0); else ZXP(out) = y1 = y0 + b1d * (y1 - y0););
     }
     unit->m_y1 = zapgremlins(y1);
+#ifdef SUPERSONIC
+    LagUD_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 void LagUD_Ctor(LagUD* unit) {
@@ -611,6 +882,9 @@ void LagUD_Ctor(LagUD* unit) {
     unit->m_b1u = 0.f;
     unit->m_b1d = 0.f;
     unit->m_y1 = ZIN0(0);
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     LagUD_next(unit, 1);
 }
 
@@ -637,6 +911,9 @@ static void Lag2_next_k(Lag2* unit, int inNumSamples) {
     }
     unit->m_y1a = zapgremlins(y1a);
     unit->m_y1b = zapgremlins(y1b);
+#ifdef SUPERSONIC
+    Lag2_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 static void Lag2_next_i(Lag2* unit, int inNumSamples) {
@@ -651,6 +928,9 @@ static void Lag2_next_i(Lag2* unit, int inNumSamples) {
           ZXP(out) = y1b;);
     unit->m_y1a = zapgremlins(y1a);
     unit->m_y1b = zapgremlins(y1b);
+#ifdef SUPERSONIC
+    Lag2_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 static void Lag2_next_1_i(Lag2* unit, int inNumSamples) {
@@ -665,6 +945,9 @@ static void Lag2_next_1_i(Lag2* unit, int inNumSamples) {
 
     unit->m_y1a = zapgremlins(y1a);
     unit->m_y1b = zapgremlins(y1b);
+#ifdef SUPERSONIC
+    Lag2_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 void Lag2_Ctor(Lag2* unit) {
@@ -685,6 +968,9 @@ void Lag2_Ctor(Lag2* unit) {
     unit->m_lag = uninitializedControl;
     unit->m_b1 = 0.f;
     unit->m_y1a = unit->m_y1b = ZIN0(0);
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     Lag2_next_k(unit, 1);
 }
 
@@ -722,6 +1008,9 @@ void Lag2UD_next(Lag2UD* unit, int inNumSamples) {
     }
     unit->m_y1a = zapgremlins(y1a);
     unit->m_y1b = zapgremlins(y1b);
+#ifdef SUPERSONIC
+    Lag2UD_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 void Lag2UD_Ctor(Lag2UD* unit) {
@@ -732,6 +1021,9 @@ void Lag2UD_Ctor(Lag2UD* unit) {
     unit->m_b1u = 0.f;
     unit->m_b1d = 0.f;
     unit->m_y1a = unit->m_y1b = ZIN0(0);
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     Lag2UD_next(unit, 1);
 }
 
@@ -760,6 +1052,9 @@ void Lag3_next(Lag3* unit, int inNumSamples) {
     unit->m_y1a = zapgremlins(y1a);
     unit->m_y1b = zapgremlins(y1b);
     unit->m_y1c = zapgremlins(y1c);
+#ifdef SUPERSONIC
+    Lag3_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 static void Lag3_next_1_i(Lag3* unit, int inNumSamples) {
@@ -780,6 +1075,9 @@ static void Lag3_next_1_i(Lag3* unit, int inNumSamples) {
     unit->m_y1a = zapgremlins(y1a);
     unit->m_y1b = zapgremlins(y1b);
     unit->m_y1c = zapgremlins(y1c);
+#ifdef SUPERSONIC
+    Lag3_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 void Lag3_Ctor(Lag3* unit) {
@@ -800,6 +1098,9 @@ void Lag3_Ctor(Lag3* unit) {
     unit->m_lag = uninitializedControl;
     unit->m_b1 = 0.f;
     unit->m_y1a = unit->m_y1b = unit->m_y1c = ZIN0(0);
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     Lag3_next(unit, 1);
 }
 
@@ -842,6 +1143,9 @@ void Lag3UD_next(Lag3UD* unit, int inNumSamples) {
     unit->m_y1a = zapgremlins(y1a);
     unit->m_y1b = zapgremlins(y1b);
     unit->m_y1c = zapgremlins(y1c);
+#ifdef SUPERSONIC
+    Lag3UD_maybeConverge(unit, inNumSamples);
+#endif
 }
 
 void Lag3UD_Ctor(Lag3UD* unit) {
@@ -853,6 +1157,9 @@ void Lag3UD_Ctor(Lag3UD* unit) {
     unit->m_b1d = 0.f;
 
     unit->m_y1a = unit->m_y1b = unit->m_y1c = ZIN0(0);
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     Lag3UD_next(unit, 1);
 }
 
@@ -895,6 +1202,10 @@ void VarLag_next(VarLag* unit, int inNumSamples) {
     unit->m_level = level;
     unit->m_slope = slope;
     unit->m_counter = counter;
+#ifdef SUPERSONIC
+    if (counter == 0)
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&VarLag_next_converged);
+#endif
 }
 
 
@@ -929,6 +1240,10 @@ void VarLag_next_1(VarLag* unit, int inNumSamples) {
     } else {
         unit->m_level = unit->m_in;
     }
+#ifdef SUPERSONIC
+    if (unit->m_counter == 0 && unit->m_level == unit->m_in)
+        enterConverged(unit, unit->m_resume, (UnitCalcFunc)&VarLag_next_converged);
+#endif
 }
 
 void VarLag_Ctor(VarLag* unit) {
@@ -945,6 +1260,9 @@ void VarLag_Ctor(VarLag* unit) {
     unit->m_slope = (in - unit->m_level) / counter;
     unit->m_in = in;
     unit->m_lagTime = lagTime;
+#ifdef SUPERSONIC
+    unit->m_resume = nullptr;
+#endif
     ZOUT0(0) = unit->m_level;
 }
 
@@ -5425,6 +5743,17 @@ extern "C"
 PluginLoad(Filter) {
     ft = inTable;
 
+#ifdef SUPERSONIC
+    // Dtors release the converged-unit count (see the fast paths above).
+    DefineDtorUnit(Ramp);
+    DefineDtorUnit(Lag);
+    DefineDtorUnit(Lag2);
+    DefineDtorUnit(Lag3);
+    DefineDtorUnit(LagUD);
+    DefineDtorUnit(Lag2UD);
+    DefineDtorUnit(Lag3UD);
+    DefineDtorUnit(VarLag);
+#else
     DefineSimpleUnit(Ramp);
     DefineSimpleUnit(Lag);
     DefineSimpleUnit(Lag2);
@@ -5433,6 +5762,7 @@ PluginLoad(Filter) {
     DefineSimpleUnit(Lag2UD);
     DefineSimpleUnit(Lag3UD);
     DefineSimpleUnit(VarLag);
+#endif
     DefineSimpleUnit(OnePole);
     DefineSimpleUnit(OneZero);
     DefineSimpleUnit(TwoPole);
@@ -72,6 +72,9 @@ struct InTrig : IOUnit {};
 
 struct In : IOUnit {
     int32* m_busTouchedCache; // for reblocking
+#ifdef SUPERSONIC
+    const BusAlias* m_alias; // [SUPERSONIC] zero-copy readers, see BusAlias_Get()
+#endif
 };
 
 struct InFeedback : public In {
@@ -110,6 +113,9 @@ struct LocalIn : public Unit {
     // overflow in case we need to reblock/resample!
     int64* m_busTouched;
     float* m_realData;
+#ifdef SUPERSONIC
+    const BusAlias* m_alias; // [SUPERSONIC] zero-copy readers, see BusAlias_Get()
+#endif
 };
 
 struct LocalOut : Unit {
@@ -265,6 +271,55 @@ static inline float readControlBus(const float* bus, int channelIndex, int maxCh
     }
 }
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] Zero-copy bus reads. When the GraphDef found readers that can
+// take a bus reader's outputs straight from the bus (BusAlias in SC_Graph.h),
+// the unit points those readers' inputs at the bus each block and skips the
+// copy. Channels that must read as silence or a default, and blocks where a
+// guard writer targets the same buses, fall back to the copy with the readers
+// pointed back at the unit's own outputs. Reblocked graphs always copy.
+static inline const BusAlias* BusAlias_Get(Unit* unit) {
+    const BusAlias* aliases = unit->mParent->mBusAliases;
+    if (!aliases || (unit->mParent->mFlags & kGraph_ReblockOrResample))
+        return nullptr;
+    const BusAlias* alias = aliases + unit->mParentIndex;
+    return alias->mNumChannels == (uint32)unit->mNumOutputs ? alias : nullptr;
+}
+
+// Whether readers may read audio buses [busChannel, busChannel + numChannels)
+// in place this block: the range is valid, so m_bus points at it, and no
+// guard writer targets any of it.
+static inline bool BusAlias_Clear(const Unit* unit, const BusAlias* alias, int32 busChannel, int32 numChannels,
+                                  int32 maxChannel) {
+    if (!alias || busChannel < 0 || busChannel + numChannels > maxChannel)
+        return false;
+    Unit** units = unit->mParent->mUnits;
+    const int32* guard = alias->mGuards;
+    for (uint32 g = 0; g < alias->mNumGuards; ++g, guard += 3) {
+        const int32 writerChannel = (int32)*units[guard[0]]->mInBuf[0];
+        if (writerChannel < busChannel + numChannels && busChannel < writerChannel + guard[2])
+            return false;
+    }
+    return true;
+}
+
+// Point the readers of output `channel` at `bus`, or back at the output when
+// `bus` is null. True when the readers now read the bus, so the copy can go.
+static inline bool BusAlias_Bind(Unit* unit, const BusAlias* alias, int channel, float* bus) {
+    if (!alias)
+        return false;
+    const int32* reader = alias->mReaders + 2 * alias->mChannelStart[channel];
+    const int32* end = alias->mReaders + 2 * alias->mChannelStart[channel + 1];
+    if (reader == end)
+        return false;
+    float* source = bus ? bus : OUT(channel);
+    Unit** units = unit->mParent->mUnits;
+    for (; reader != end; reader += 2)
+        units[reader[0]]->mInBuf[reader[1]] = source;
+    return bus != nullptr;
+}
+#endif
+
 // Update the relevant IOUnit instance members if the audio bus number has changed
 static inline void IO_a_update_channels(IOUnit* unit, World* world, float fbusChannel, int numChannels, int bufLength) {
     if (fbusChannel != unit->m_fbusChannel) {
@@ -704,16 +759,28 @@ FLATTEN void In_next_a_nova(In* unit, int inNumSamples) {
     int32* touched = unit->m_busTouched;
     const int32 bufCounter = unit->mWorld->mBufCounter;
     const int32 maxChannel = world->mNumAudioBusChannels;
+#ifdef SUPERSONIC
+    const BusAlias* alias = unit->m_alias;
+    const bool direct = BusAlias_Clear(unit, alias, (int32)fbusChannel, numChannels, maxChannel);
+#endif
 
     for (int i = 0; i < numChannels; ++i, in += bufLength) {
         AudioBusGuard<true> guard(unit, fbusChannel + i, maxChannel);
 
         float* out = OUT(i);
 
-        if (guard.isValid() && (touched[i] == bufCounter))
+        if (guard.isValid() && (touched[i] == bufCounter)) {
+#ifdef SUPERSONIC
+            if (BusAlias_Bind(unit, alias, i, direct ? in : nullptr))
+                continue;
+#endif
             nova::copyvec_simd(out, in, inNumSamples);
-        else
+        } else {
+#ifdef SUPERSONIC
+            BusAlias_Bind(unit, alias, i, nullptr);
+#endif
             nova::zerovec_simd(out, inNumSamples);
+        }
     }
 }
 
@@ -729,15 +796,27 @@ FLATTEN void In_next_a_nova_64(In* unit, int inNumSamples) {
     int32* touched = unit->m_busTouched;
     const int32 bufCounter = unit->mWorld->mBufCounter;
     const int32 maxChannel = world->mNumAudioBusChannels;
+#ifdef SUPERSONIC
+    const BusAlias* alias = unit->m_alias;
+    const bool direct = BusAlias_Clear(unit, alias, (int32)fbusChannel, numChannels, maxChannel);
+#endif
 
     for (int i = 0; i < numChannels; ++i, in += bufLength) {
         AudioBusGuard<true> guard(unit, fbusChannel + i, maxChannel);
 
         float* out = OUT(i);
-        if (guard.isValid() && (touched[i] == bufCounter))
+        if (guard.isValid() && (touched[i] == bufCounter)) {
+#ifdef SUPERSONIC
+            if (BusAlias_Bind(unit, alias, i, direct ? in : nullptr))
+                continue;
+#endif
             nova::copyvec_simd<64>(out, in);
-        else
+        } else {
+#ifdef SUPERSONIC
+            BusAlias_Bind(unit, alias, i, nullptr);
+#endif
             nova::zerovec_simd<64>(out);
+        }
     }
 }
 
@@ -755,15 +834,27 @@ void In_next_a(In* unit, int inNumSamples) {
     int32* touched = unit->m_busTouched;
     const int32 bufCounter = unit->mWorld->mBufCounter;
     const int32 maxChannel = world->mNumAudioBusChannels;
+#ifdef SUPERSONIC
+    const BusAlias* alias = unit->m_alias;
+    const bool direct = BusAlias_Clear(unit, alias, (int32)fbusChannel, numChannels, maxChannel);
+#endif
 
     for (int i = 0; i < numChannels; ++i, in += bufLength) {
         AudioBusGuard<true> guard(unit, fbusChannel + i, maxChannel);
 
         float* out = OUT(i);
-        if (guard.isValid() && (touched[i] == bufCounter))
+        if (guard.isValid() && (touched[i] == bufCounter)) {
+#ifdef SUPERSONIC
+            if (BusAlias_Bind(unit, alias, i, direct ? in : nullptr))
+                continue;
+#endif
             Copy(inNumSamples, out, in);
-        else
+        } else {
+#ifdef SUPERSONIC
+            BusAlias_Bind(unit, alias, i, nullptr);
+#endif
             Clear(inNumSamples, out);
+        }
     }
 }
 
@@ -852,6 +943,9 @@ void In_Ctor(In* unit) {
     World* world = unit->mWorld;
     unit->m_fbusChannel = std::numeric_limits<float>::quiet_NaN();
     unit->m_busTouchedCache = nullptr;
+#ifdef SUPERSONIC
+    unit->m_alias = unit->mCalcRate == calc_FullRate ? BusAlias_Get(unit) : nullptr;
+#endif
 
     if (unit->mCalcRate == calc_FullRate) {
         if (REBLOCK_OR_RESAMPLE) {
@@ -1043,6 +1137,10 @@ void InFeedback_next_a(InFeedback* unit, int inNumSamples) {
     int32* touched = unit->m_busTouched;
     const int32 bufCounter = unit->mWorld->mBufCounter;
     const int32 maxChannel = world->mNumAudioBusChannels;
+#ifdef SUPERSONIC
+    const BusAlias* alias = unit->m_alias;
+    const bool direct = BusAlias_Clear(unit, alias, (int32)fbusChannel, numChannels, maxChannel);
+#endif
 
     for (int i = 0; i < numChannels; ++i, in += bufLength) {
         AudioBusGuard<true> guard(unit, fbusChannel + i, maxChannel);
@@ -1051,15 +1149,28 @@ void InFeedback_next_a(InFeedback* unit, int inNumSamples) {
         int diff = bufCounter - touched[i];
 
         if (guard.isValid() && diff == 0) {
+#ifdef SUPERSONIC
+            if (!BusAlias_Bind(unit, alias, i, direct ? in : nullptr))
+#endif
             Copy(inNumSamples, out, in);
             unit->m_busUsedInPrevCycle[i] = true;
         } else if (guard.isValid() && diff == 1) {
             if (unit->m_busUsedInPrevCycle[i]) {
+#ifdef SUPERSONIC
+                BusAlias_Bind(unit, alias, i, nullptr);
+#endif
                 Clear(inNumSamples, out);
                 unit->m_busUsedInPrevCycle[i] = false;
-            } else
+            } else {
+#ifdef SUPERSONIC
+                if (!BusAlias_Bind(unit, alias, i, direct ? in : nullptr))
+#endif
                 Copy(inNumSamples, out, in);
+            }
         } else {
+#ifdef SUPERSONIC
+            BusAlias_Bind(unit, alias, i, nullptr);
+#endif
             Clear(inNumSamples, out);
             unit->m_busUsedInPrevCycle[i] = false;
         }
@@ -1074,6 +1185,9 @@ void InFeedback_Ctor(InFeedback* unit) {
     unit->m_bus = world->mAudioBus;
     unit->m_busTouched = world->mAudioBusTouched;
     unit->m_busTouchedCache = nullptr;
+#ifdef SUPERSONIC
+    unit->m_alias = BusAlias_Get(unit);
+#endif
 
     if (numChannels > InFeedback::smallVecSize) {
         unit->m_busUsedInPrevCycle = (bool*)RTAlloc(world, numChannels * sizeof(bool));
@@ -2171,10 +2285,18 @@ void LocalIn_next_a(LocalIn* unit, int inNumSamples) {
         float* out = OUT(i);
         int diff = bufCounter - touched[i];
         // Print("LocalIn  %d  %d  %g\n", i, diff, in[0]);
-        if (diff == 1 || diff == 0)
+        if (diff == 1 || diff == 0) {
+#ifdef SUPERSONIC
+            if (BusAlias_Bind(unit, unit->m_alias, i, in))
+                continue;
+#endif
             Copy(inNumSamples, out, in);
-        else // get default value from UGen input
+        } else { // get default value from UGen input
+#ifdef SUPERSONIC
+            BusAlias_Bind(unit, unit->m_alias, i, nullptr);
+#endif
             Fill(inNumSamples, out, IN0(i));
+        }
     }
 }
 
@@ -2192,10 +2314,18 @@ FLATTEN void LocalIn_next_a_nova(LocalIn* unit, int inNumSamples) {
         float* out = OUT(i);
         int diff = bufCounter - touched[i];
         // Print("LocalIn  %d  %d  %g\n", i, diff, in[0]);
-        if (diff == 1 || diff == 0)
+        if (diff == 1 || diff == 0) {
+#ifdef SUPERSONIC
+            if (BusAlias_Bind(unit, unit->m_alias, i, in))
+                continue;
+#endif
             nova::copyvec_simd(out, in, inNumSamples);
-        else // get default value from UGen input
+        } else { // get default value from UGen input
+#ifdef SUPERSONIC
+            BusAlias_Bind(unit, unit->m_alias, i, nullptr);
+#endif
             Fill(inNumSamples, out, IN0(i));
+        }
     }
 }
 
@@ -2211,10 +2341,18 @@ FLATTEN void LocalIn_next_a_nova_64(LocalIn* unit, int inNumSamples) {
         float* out = OUT(i);
         int diff = bufCounter - touched[i];
         // Print("LocalIn  %d  %d  %g\n", i, diff, in[0]);
-        if (diff == 1 || diff == 0)
+        if (diff == 1 || diff == 0) {
+#ifdef SUPERSONIC
+            if (BusAlias_Bind(unit, unit->m_alias, i, in))
+                continue;
+#endif
             nova::copyvec_simd<64>(out, in);
-        else // get default value from UGen input
+        } else { // get default value from UGen input
+#ifdef SUPERSONIC
+            BusAlias_Bind(unit, unit->m_alias, i, nullptr);
+#endif
             Fill(inNumSamples, out, IN0(i));
+        }
     }
 }
 #endif
@@ -2272,6 +2410,9 @@ void LocalIn_Ctor(LocalIn* unit) {
 
     unit->m_busTouched = (int64*)(unit->m_bus + busDataSize);
     std::fill_n(unit->m_busTouched, numChannels, -1);
+#ifdef SUPERSONIC
+    unit->m_alias = nullptr;
+#endif
 
     if (unit->mCalcRate == calc_FullRate) {
         if (unit->mParent->mLocalAudioBusUnit) {
@@ -2280,6 +2421,9 @@ void LocalIn_Ctor(LocalIn* unit) {
             return;
         }
         unit->mParent->mLocalAudioBusUnit = unit;
+#ifdef SUPERSONIC
+        unit->m_alias = BusAlias_Get(unit);
+#endif
         if (REBLOCK_OR_RESAMPLE)
             SETCALC(LocalIn_next_a_reblock);
 #ifdef NOVA_SIMD
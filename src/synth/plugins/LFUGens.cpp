@@ -25,6 +25,9 @@
 #include <limits>
 #include <cstdio>
 #include "function_attributes.h"
+#ifdef SUPERSONIC
+#    include "BandLimitedOsc.hpp"
+#endif
 
 #include <boost/align/is_aligned.hpp>
 
@@ -183,6 +186,10 @@ void LFSaw_Ctor(LFSaw* unit);
 void LFTri_next_a(LFTri* unit, int inNumSamples);
 void LFTri_next_k(LFTri* unit, int inNumSamples);
 void LFTri_Ctor(LFTri* unit);
+#ifdef SUPERSONIC
+void LFTri_next_blamp_a(LFTri* unit, int inNumSamples);
+void LFTri_next_blamp_k(LFTri* unit, int inNumSamples);
+#endif
 
 void LFPar_next_a(LFPar* unit, int inNumSamples);
 void LFPar_next_k(LFPar* unit, int inNumSamples);
@@ -667,7 +674,42 @@ void LFTri_next_k(LFTri* unit, int inNumSamples) {
     unit->mPhase = phase;
 }
 
+#ifdef SUPERSONIC
+// PolyBLAMP mode: mPhase holds the cycle position ([0, 1), trough at 0) and
+// mFreqMul the sample duration, rather than LFTri's [-1, 3) phase units.
+void LFTri_next_blamp_a(LFTri* unit, int inNumSamples) {
+    float* out = OUT(0);
+    const float* freq = IN(0);
+    float freqmul = unit->mFreqMul;
+    double phase = unit->mPhase;
+    for (int i = 0; i < inNumSamples; ++i)
+        out[i] = blosc::triSample(phase, freq[i] * freqmul);
+    unit->mPhase = phase;
+}
+
+void LFTri_next_blamp_k(LFTri* unit, int inNumSamples) {
+    unit->mPhase = blosc::tri(OUT(0), inNumSamples, unit->mPhase, ZIN0(0) * unit->mFreqMul);
+}
+#endif
+
 void LFTri_Ctor(LFTri* unit) {
+#ifdef SUPERSONIC
+    // Optional trailing `mode` input, absent from upstream synthdefs: non-zero
+    // selects the band-limited (PolyBLAMP) triangle. Same shape and iphase.
+    if (unit->mNumInputs > 2 && ZIN0(2) != 0.f) {
+        if (INRATE(0) == calc_FullRate) {
+            SETCALC(LFTri_next_blamp_a);
+        } else {
+            SETCALC(LFTri_next_blamp_k);
+        }
+        unit->mFreqMul = unit->mRate->mSampleDur;
+        // iphase is in LFTri units; -1 is the trough.
+        double initPhase = unit->mPhase = sc_wrap((static_cast<double>(ZIN0(1)) + 1.0) * 0.25, 0.0, 1.0);
+        LFTri_next_blamp_k(unit, 1);
+        unit->mPhase = initPhase;
+        return;
+    }
+#endif
     if (INRATE(0) == calc_FullRate) {
         SETCALC(LFTri_next_a);
     } else {
@@ -20,6 +20,9 @@
 
 #include "SC_PlugIn.h"
 #include "function_attributes.h"
+#ifdef SUPERSONIC
+#    include "BandLimitedOsc.hpp"
+#endif
 #include <limits>
 #include <string.h>
 
@@ -130,18 +133,28 @@ struct Blip : public Unit {
     int32 m_phase, m_numharm, m_N;
     float m_freqin, m_scale;
     double m_cpstoinc;
+#ifdef SUPERSONIC
+    double m_blphase; // cycle position, polynomial mode (BandLimitedOsc.hpp)
+#endif
 };
 
 struct Saw : public Unit {
     int32 m_phase, m_N;
     float m_freqin, m_scale, m_y1;
     double m_cpstoinc;
+#ifdef SUPERSONIC
+    double m_blphase;
+#endif
 };
 
 struct Pulse : public Unit {
     int32 m_phase, m_phaseoff, m_N;
     float m_freqin, m_scale, m_y1;
     double m_cpstoinc;
+#ifdef SUPERSONIC
+    double m_blphase;
+    float m_blwidth;
+#endif
 };
 
 struct Klang : public Unit {
@@ -276,6 +289,12 @@ void Saw_next(Saw* unit, int inNumSamples);
 void Pulse_Ctor(Pulse* unit);
 void Pulse_next(Pulse* unit, int inNumSamples);
 
+#ifdef SUPERSONIC
+void Blip_next_poly(Blip* unit, int inNumSamples);
+void Saw_next_poly(Saw* unit, int inNumSamples);
+void Pulse_next_poly(Pulse* unit, int inNumSamples);
+#endif
+
 void Klang_Dtor(Klang* unit);
 void Klang_Ctor(Klang* unit);
 void Klang_next(Klang* unit, int inNumSamples);
@@ -2241,6 +2260,19 @@ void Blip_Ctor(Blip* unit) {
     unit->m_scale = 0.5 / N;
     unit->m_phase = 0;
 
+#ifdef SUPERSONIC
+    // Optional trailing `mode` input, absent from upstream synthdefs: non-zero
+    // selects the polynomial kernel (BandLimitedOsc.hpp). Read once, like the
+    // rate dispatch.
+    if (unit->mNumInputs > 2 && ZIN0(2) != 0.f) {
+        SETCALC(Blip_next_poly);
+        unit->m_blphase = 0.;
+        Blip_next_poly(unit, 1);
+        unit->m_blphase = 0.;
+        return;
+    }
+#endif
+
     Blip_next(unit, 1);
     unit->m_N = N;
     unit->m_scale = 0.5 / N;
@@ -2374,6 +2406,30 @@ void Blip_next(Blip* unit, int inNumSamples) {
     unit->m_numharm = numharm;
 }
 
+#ifdef SUPERSONIC
+// Same harmonic count rules as Blip_next (clamped to Nyquist, crossfaded over
+// the block when it changes); the Dirichlet kernel is evaluated with
+// polynomial sines instead of the sine/cosecant tables.
+void Blip_next_poly(Blip* unit, int inNumSamples) {
+    float freqin = ZIN0(0);
+    int numharm = (int32)ZIN0(1);
+
+    int32 prevN = unit->m_N;
+    int32 N = prevN;
+    if (numharm != unit->m_numharm || freqin != unit->m_freqin) {
+        int32 maxN = sc_max(1, (int32)((SAMPLERATE * 0.5) / freqin));
+        N = sc_max(1, sc_min(numharm, maxN));
+        unit->m_N = N;
+        unit->m_scale = 0.5 / N;
+    }
+
+    unit->m_blphase =
+        blosc::blip(OUT(0), inNumSamples, unit->m_blphase, freqin * (float)SAMPLEDUR, N, prevN);
+    unit->m_freqin = freqin;
+    unit->m_numharm = numharm;
+}
+#endif
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -2392,6 +2448,17 @@ void Saw_Ctor(Saw* unit) {
     unit->m_phase = 0;
     unit->m_y1 = -0.46f;
 
+#ifdef SUPERSONIC
+    // Optional `mode` input: non-zero selects the PolyBLEP kernel (see Blip_Ctor).
+    if (unit->mNumInputs > 1 && ZIN0(1) != 0.f) {
+        SETCALC(Saw_next_poly);
+        unit->m_blphase = 0.;
+        Saw_next_poly(unit, 1);
+        unit->m_blphase = 0.;
+        return;
+    }
+#endif
+
     Saw_next(unit, 1);
     unit->m_scale = 0.5 / unit->m_N;
     unit->m_phase = 0;
@@ -2525,6 +2592,22 @@ void Saw_next(Saw* unit, int inNumSamples) {
     unit->m_freqin = freqin;
 }
 
+#ifdef SUPERSONIC
+// Width slews across the block, as upstream's phase offset does.
+void Pulse_next_poly(Pulse* unit, int inNumSamples) {
+    float width = ZIN0(1);
+    unit->m_blphase = blosc::pulse(OUT(0), inNumSamples, unit->m_blphase, ZIN0(0) * (float)SAMPLEDUR,
+                                   unit->m_blwidth, width);
+    unit->m_blwidth = width;
+}
+#endif
+
+#ifdef SUPERSONIC
+void Saw_next_poly(Saw* unit, int inNumSamples) {
+    unit->m_blphase = blosc::saw(OUT(0), inNumSamples, unit->m_blphase, ZIN0(0) * (float)SAMPLEDUR);
+}
+#endif
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -2543,6 +2626,17 @@ void Pulse_Ctor(Pulse* unit) {
     unit->m_phase = 0;
     unit->m_phaseoff = 0;
     unit->m_y1 = 0.f;
+#ifdef SUPERSONIC
+    // Optional `mode` input: non-zero selects the PolyBLEP kernel (see Blip_Ctor).
+    if (unit->mNumInputs > 2 && ZIN0(2) != 0.f) {
+        SETCALC(Pulse_next_poly);
+        unit->m_blphase = 0.;
+        unit->m_blwidth = ZIN0(1);
+        Pulse_next_poly(unit, 1);
+        unit->m_blphase = 0.;
+        return;
+    }
+#endif
     ZOUT0(0) = 0.f;
 }
 
@@ -17,6 +17,10 @@
  */
 #include "SC_PlugIn.h"
 
+#if defined(SUPERSONIC) && defined(NOVA_SIMD)
+#    include "vec.hpp"
+#endif
+
 // gcc3.3 mathlib doesnt know these yet
 #if gccversion < 4
 #    define powf pow
@@ -127,16 +131,180 @@ struct GVerb : public Unit {
 extern "C" {
 void FreeVerb_Ctor(FreeVerb* unit);
 void FreeVerb_next(FreeVerb* unit, int inNumSamples);
+#ifdef SUPERSONIC
+void FreeVerb_next_lanes(FreeVerb* unit, int inNumSamples);
+#endif
 
 
 void GVerb_Ctor(GVerb* unit);
 void GVerb_Dtor(GVerb* unit);
 void GVerb_next(GVerb* unit, int inNumSamples);
+#ifdef SUPERSONIC
+void GVerb_next_lanes(GVerb* unit, int inNumSamples);
+#endif
 };
 
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] Lane-parallel FreeVerb / FreeVerb2.
+//
+// The generated loops (FreeVerb_next, FreeVerb2_next) step every delay line
+// once per sample. Each comb is at least 1116 samples long and each allpass at
+// least 225, so within a chunk of up to kFreeVerbChunk samples no line reads a
+// position it has written: a line's taps for the whole chunk are one
+// contiguous span (two across the wrap), copied out up front and written back
+// after. In between, the eight comb
+// one-poles advance side by side in nova::vec lanes, and the comb sum and the
+// allpass chain are evaluated a stage at a time across the chunk, which the
+// compiler vectorises over samples. Every sample sees the same float operations
+// in the same order as the generated code, so the output is bit-identical; a
+// non-zero trailing `mode` input selects the generated loop instead.
+
+static const int kFreeVerbChunk = 64;
+static const int kFreeVerbCombs = 8;
+static const int kFreeVerbAllpasses = 4;
+
+// One channel's state, pointing at the unit's unrolled fields. Allpasses are
+// in signal order (dline3, dline2, dline1, dline0 for FreeVerb).
+struct FreeVerbChannel {
+    float* comb[kFreeVerbCombs];
+    int combLen[kFreeVerbCombs];
+    int* combIota[kFreeVerbCombs];
+    float* combTap[kFreeVerbCombs]; // R4_0, R6_0, ...: last comb output
+    float* combLp[kFreeVerbCombs]; // R5_0, R7_0, ...: damping one-pole
+    float* ap[kFreeVerbAllpasses];
+    int apLen[kFreeVerbAllpasses];
+    int* apIota[kFreeVerbAllpasses];
+    float* apTap[kFreeVerbAllpasses]; // R3_0, R2_0, ...: last allpass tap
+    float* apOut[kFreeVerbAllpasses]; // R3_1, R2_1, ...
+};
+
+// Copies the m ring positions after `iota` into buf (or back from it when
+// Write) and returns the new iota. m never exceeds len.
+template <bool Write> static inline int freeverb_ring_span(float* line, int len, int iota, int m, float* buf) {
+    int pos = iota + 1 == len ? 0 : iota + 1;
+    for (int i = 0; i < m;) {
+        const int run = sc_min(m - i, len - pos);
+        for (int k = 0; k < run; ++k) {
+            if (Write)
+                line[pos + k] = buf[i + k];
+            else
+                buf[i + k] = line[pos + k];
+        }
+        i += run;
+        pos += run;
+        if (pos == len)
+            pos = 0;
+    }
+    return pos == 0 ? len - 1 : pos - 1;
+}
+
+// Damped feedback for every comb: writes[c][i] from the taps read this chunk.
+static inline void freeverb_combs(const FreeVerbChannel& ch, const float (*taps)[kFreeVerbChunk],
+                                  float (*writes)[kFreeVerbChunk], const float* x4, int m, float ftemp5, float ftemp6,
+                                  float ftemp7) {
+    float laneTap[kFreeVerbCombs], laneLp[kFreeVerbCombs];
+    for (int c = 0; c < kFreeVerbCombs; ++c) {
+        laneTap[c] = *ch.combTap[c];
+        laneLp[c] = *ch.combLp[c];
+    }
+
+#    ifdef NOVA_SIMD
+    using vecf = nova::vec<float>;
+    static_assert(kFreeVerbCombs % vecf::size == 0, "comb bank must fill whole vectors");
+    const int kLaneVecs = kFreeVerbCombs / vecf::size;
+    float laneW[kFreeVerbCombs];
+    vecf prev[kLaneVecs], lp[kLaneVecs];
+    for (int v = 0; v < kLaneVecs; ++v) {
+        prev[v].load(laneTap + v * vecf::size);
+        lp[v].load(laneLp + v * vecf::size);
+    }
+    const vecf g5(ftemp5), g6(ftemp6), g7(ftemp7);
+    for (int i = 0; i < m; ++i) {
+        const vecf x(x4[i]);
+        for (int c = 0; c < kFreeVerbCombs; ++c)
+            laneTap[c] = taps[c][i];
+        for (int v = 0; v < kLaneVecs; ++v) {
+            lp[v] = (g7 * prev[v]) + (g6 * lp[v]);
+            (x + (g5 * lp[v])).store(laneW + v * vecf::size);
+            prev[v].load(laneTap + v * vecf::size);
+        }
+        for (int c = 0; c < kFreeVerbCombs; ++c)
+            writes[c][i] = laneW[c];
+    }
+    for (int v = 0; v < kLaneVecs; ++v) {
+        prev[v].store(laneTap + v * vecf::size);
+        lp[v].store(laneLp + v * vecf::size);
+    }
+#    else
+    for (int i = 0; i < m; ++i) {
+        for (int c = 0; c < kFreeVerbCombs; ++c) {
+            laneLp[c] = (ftemp7 * laneTap[c]) + (ftemp6 * laneLp[c]);
+            writes[c][i] = x4[i] + (ftemp5 * laneLp[c]);
+            laneTap[c] = taps[c][i];
+        }
+    }
+#    endif
+
+    for (int c = 0; c < kFreeVerbCombs; ++c) {
+        *ch.combTap[c] = laneTap[c];
+        *ch.combLp[c] = laneLp[c];
+    }
+}
+
+static void freeverb_channel_next(const FreeVerbChannel& ch, const float* x4, const float* dry, float* out, int m,
+                                  float ftemp0, float ftemp1, float ftemp5, float ftemp6, float ftemp7) {
+    float taps[kFreeVerbCombs][kFreeVerbChunk];
+    float writes[kFreeVerbCombs][kFreeVerbChunk];
+    float aps[kFreeVerbChunk + 1]; // [0] is the previous chunk's last tap
+    float ys[kFreeVerbChunk];
+    float wr[kFreeVerbChunk];
+
+    for (int c = 0; c < kFreeVerbCombs; ++c)
+        freeverb_ring_span<false>(ch.comb[c], ch.combLen[c], *ch.combIota[c], m, taps[c]);
+    freeverb_combs(ch, taps, writes, x4, m, ftemp5, ftemp6, ftemp7);
+    for (int c = 0; c < kFreeVerbCombs; ++c)
+        *ch.combIota[c] = freeverb_ring_span<true>(ch.comb[c], ch.combLen[c], *ch.combIota[c], m, writes[c]);
+
+    aps[0] = *ch.apTap[0];
+    freeverb_ring_span<false>(ch.ap[0], ch.apLen[0], *ch.apIota[0], m, aps + 1);
+    for (int i = 0; i < m; ++i) {
+        const float ftemp8 = (taps[6][i] + taps[7][i]);
+        wr[i] = ((((0.500000f * aps[i]) + taps[0][i]) + (taps[1][i] + taps[2][i]))
+                 + ((taps[3][i] + taps[4][i]) + (taps[5][i] + ftemp8)));
+        ys[i] = (aps[i + 1]
+                 - (((taps[0][i] + taps[1][i]) + (taps[2][i] + taps[3][i])) + ((taps[4][i] + taps[5][i]) + ftemp8)));
+    }
+    *ch.apIota[0] = freeverb_ring_span<true>(ch.ap[0], ch.apLen[0], *ch.apIota[0], m, wr);
+    *ch.apTap[0] = aps[m];
+    *ch.apOut[0] = ys[m - 1];
+
+    for (int s = 1; s < kFreeVerbAllpasses; ++s) {
+        aps[0] = *ch.apTap[s];
+        freeverb_ring_span<false>(ch.ap[s], ch.apLen[s], *ch.apIota[s], m, aps + 1);
+        for (int i = 0; i < m; ++i) {
+            wr[i] = ((0.500000f * aps[i]) + ys[i]);
+            ys[i] = (aps[i + 1] - ys[i]);
+        }
+        *ch.apIota[s] = freeverb_ring_span<true>(ch.ap[s], ch.apLen[s], *ch.apIota[s], m, wr);
+        *ch.apTap[s] = aps[m];
+        *ch.apOut[s] = ys[m - 1];
+    }
+
+    for (int i = 0; i < m; ++i)
+        out[i] = ((ftemp1 * dry[i]) + (ftemp0 * ys[i]));
+}
+#endif // SUPERSONIC
+
 void FreeVerb_Ctor(FreeVerb* unit) {
+#ifdef SUPERSONIC
+    if (unit->mNumInputs > 4 && IN0(4) != 0.f)
+        SETCALC(FreeVerb_next);
+    else
+        SETCALC(FreeVerb_next_lanes);
+#else
     SETCALC(FreeVerb_next);
+#endif
 
     unit->iota0 = 0;
     unit->iota1 = 0;
@@ -202,7 +370,7 @@ void FreeVerb_Ctor(FreeVerb* unit) {
     for (int i = 0; i < 1356; i++)
         unit->dline11[i] = 0.0;
 
-    FreeVerb_next(unit, 1);
+    (unit->mCalcFunc)(unit, 1);
 }
 
 void FreeVerb_next(FreeVerb* unit, int inNumSamples) {
@@ -423,6 +591,48 @@ void FreeVerb_next(FreeVerb* unit, int inNumSamples) {
     unit->R19_0 = R19_0;
 }
 
+#ifdef SUPERSONIC
+void FreeVerb_next_lanes(FreeVerb* unit, int inNumSamples) {
+    const float* input0 = IN(0);
+    float* output0 = OUT(0);
+
+    const float ftemp0 = sc_clip(IN0(1), 0.f, 1.f); // mix
+    const float ftemp1 = (1 - ftemp0);
+    const float room = sc_clip(IN0(2), 0.f, 1.f);
+    const float ftemp5 = (0.700000f + (0.280000f * room));
+    const float damp = sc_clip(IN0(3), 0.f, 1.f);
+    const float ftemp6 = (0.400000f * damp);
+    const float ftemp7 = (1 - ftemp6);
+
+    const FreeVerbChannel ch = {
+        { unit->dline4, unit->dline5, unit->dline6, unit->dline7, unit->dline8, unit->dline9, unit->dline10,
+          unit->dline11 },
+        { 1617, 1557, 1491, 1422, 1277, 1116, 1188, 1356 },
+        { &unit->iota4, &unit->iota5, &unit->iota6, &unit->iota7, &unit->iota8, &unit->iota9, &unit->iota10,
+          &unit->iota11 },
+        { &unit->R4_0, &unit->R6_0, &unit->R8_0, &unit->R10_0, &unit->R12_0, &unit->R14_0, &unit->R16_0,
+          &unit->R18_0 },
+        { &unit->R5_0, &unit->R7_0, &unit->R9_0, &unit->R11_0, &unit->R13_0, &unit->R15_0, &unit->R17_0,
+          &unit->R19_0 },
+        { unit->dline3, unit->dline2, unit->dline1, unit->dline0 },
+        { 556, 441, 341, 225 },
+        { &unit->iota3, &unit->iota2, &unit->iota1, &unit->iota0 },
+        { &unit->R3_0, &unit->R2_0, &unit->R1_0, &unit->R0_0 },
+        { &unit->R3_1, &unit->R2_1, &unit->R1_1, &unit->R0_1 },
+    };
+
+    float x4[kFreeVerbChunk], dry[kFreeVerbChunk];
+    for (int off = 0; off < inNumSamples; off += kFreeVerbChunk) {
+        const int m = sc_min(kFreeVerbChunk, inNumSamples - off);
+        for (int i = 0; i < m; ++i) {
+            dry[i] = input0[off + i];
+            x4[i] = (1.500000e-02f * dry[i]);
+        }
+        freeverb_channel_next(ch, x4, dry, output0 + off, m, ftemp0, ftemp1, ftemp5, ftemp6, ftemp7);
+    }
+}
+#endif
+
 // FreeVerb2
 struct FreeVerb2 : public Unit {
     int iota0;
@@ -526,11 +736,21 @@ struct FreeVerb2 : public Unit {
 extern "C" {
 void FreeVerb2_Ctor(FreeVerb2* unit);
 void FreeVerb2_next(FreeVerb2* unit, int inNumSamples);
+#ifdef SUPERSONIC
+void FreeVerb2_next_lanes(FreeVerb2* unit, int inNumSamples);
+#endif
 };
 
 
 void FreeVerb2_Ctor(FreeVerb2* unit) {
+#ifdef SUPERSONIC
+    if (unit->mNumInputs > 5 && IN0(5) != 0.f)
+        SETCALC(FreeVerb2_next);
+    else
+        SETCALC(FreeVerb2_next_lanes);
+#else
     SETCALC(FreeVerb2_next);
+#endif
 
     unit->iota0 = 0;
     unit->iota1 = 0;
@@ -657,7 +877,7 @@ void FreeVerb2_Ctor(FreeVerb2* unit) {
     for (int i = 0; i < 1379; i++)
         unit->dline23[i] = 0.0;
 
-    FreeVerb2_next(unit, 1);
+    (unit->mCalcFunc)(unit, 1);
 }
 
 void FreeVerb2_next(FreeVerb2* unit, int inNumSamples) {
@@ -1023,6 +1243,70 @@ void FreeVerb2_next(FreeVerb2* unit, int inNumSamples) {
 }
 
 
+#ifdef SUPERSONIC
+void FreeVerb2_next_lanes(FreeVerb2* unit, int inNumSamples) {
+    const float* input0 = IN(0);
+    const float* input1 = IN(1);
+    float* output0 = OUT(0);
+    float* output1 = OUT(1);
+
+    const float ftemp0 = sc_clip(IN0(2), 0.f, 1.f); // mix
+    const float ftemp1 = (1 - ftemp0);
+    const float room = sc_clip(IN0(3), 0.f, 1.f);
+    const float ftemp5 = (0.700000f + (0.280000f * room));
+    const float damp = sc_clip(IN0(4), 0.f, 1.f);
+    const float ftemp6 = (0.400000f * damp);
+    const float ftemp7 = (1 - ftemp6);
+
+    const FreeVerbChannel left = {
+        { unit->dline4, unit->dline5, unit->dline6, unit->dline7, unit->dline8, unit->dline9, unit->dline10,
+          unit->dline11 },
+        { 1617, 1557, 1491, 1422, 1277, 1116, 1188, 1356 },
+        { &unit->iota4, &unit->iota5, &unit->iota6, &unit->iota7, &unit->iota8, &unit->iota9, &unit->iota10,
+          &unit->iota11 },
+        { &unit->R4_0, &unit->R6_0, &unit->R8_0, &unit->R10_0, &unit->R12_0, &unit->R14_0, &unit->R16_0,
+          &unit->R18_0 },
+        { &unit->R5_0, &unit->R7_0, &unit->R9_0, &unit->R11_0, &unit->R13_0, &unit->R15_0, &unit->R17_0,
+          &unit->R19_0 },
+        { unit->dline3, unit->dline2, unit->dline1, unit->dline0 },
+        { 556, 441, 341, 225 },
+        { &unit->iota3, &unit->iota2, &unit->iota1, &unit->iota0 },
+        { &unit->R3_0, &unit->R2_0, &unit->R1_0, &unit->R0_0 },
+        { &unit->R3_1, &unit->R2_1, &unit->R1_1, &unit->R0_1 },
+    };
+    const FreeVerbChannel right = {
+        { unit->dline16, unit->dline17, unit->dline18, unit->dline19, unit->dline20, unit->dline21, unit->dline22,
+          unit->dline23 },
+        { 1640, 1580, 1514, 1445, 1300, 1139, 1211, 1379 },
+        { &unit->iota16, &unit->iota17, &unit->iota18, &unit->iota19, &unit->iota20, &unit->iota21,
+          &unit->iota22, &unit->iota23 },
+        { &unit->R24_0, &unit->R26_0, &unit->R28_0, &unit->R30_0, &unit->R32_0, &unit->R34_0, &unit->R36_0,
+          &unit->R38_0 },
+        { &unit->R25_0, &unit->R27_0, &unit->R29_0, &unit->R31_0, &unit->R33_0, &unit->R35_0, &unit->R37_0,
+          &unit->R39_0 },
+        { unit->dline15, unit->dline14, unit->dline13, unit->dline12 },
+        { 579, 464, 364, 248 },
+        { &unit->iota15, &unit->iota14, &unit->iota13, &unit->iota12 },
+        { &unit->R23_0, &unit->R22_0, &unit->R21_0, &unit->R20_0 },
+        { &unit->R23_1, &unit->R22_1, &unit->R21_1, &unit->R20_1 },
+    };
+
+    // Inputs are copied per chunk: an output may share a wire with either input.
+    float x4[kFreeVerbChunk], dry0[kFreeVerbChunk], dry1[kFreeVerbChunk];
+    for (int off = 0; off < inNumSamples; off += kFreeVerbChunk) {
+        const int m = sc_min(kFreeVerbChunk, inNumSamples - off);
+        for (int i = 0; i < m; ++i) {
+            dry0[i] = input0[off + i];
+            dry1[i] = input1[off + i];
+            x4[i] = (1.500000e-02f * (dry0[i] + dry1[i]));
+        }
+        freeverb_channel_next(left, x4, dry0, output0 + off, m, ftemp0, ftemp1, ftemp5, ftemp6, ftemp7);
+        freeverb_channel_next(right, x4, dry1, output1 + off, m, ftemp0, ftemp1, ftemp5, ftemp6, ftemp7);
+    }
+}
+#endif
+
+
 #define TRUE 1
 #define FALSE 0
 
@@ -1267,7 +1551,14 @@ static inline float gverb_set_drylevel(GVerb* unit, float a) {
 }
 
 void GVerb_Ctor(GVerb* unit) {
+#ifdef SUPERSONIC
+    if (unit->mNumInputs > 10 && IN0(10) != 0.f)
+        SETCALC(GVerb_next);
+    else
+        SETCALC(GVerb_next_lanes);
+#else
     SETCALC(GVerb_next);
+#endif
     float roomsize = unit->roomsize = IN0(1);
     float revtime = unit->revtime = IN0(2);
     float damping = unit->damping = IN0(3);
@@ -1512,6 +1803,261 @@ void GVerb_next(GVerb* unit, int inNumSamples) {
     unit->earlylevelslope = unit->taillevelslope = unit->drylevelslope = 0.f;
 }
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] GVerb with its four FDN lines, dampers and early taps held as
+// lanes (structure of arrays) and every ring index stepped with a compare
+// instead of the `%` per access (twenty integer divisions a sample in
+// GVerb_next). The line and tap lengths differ, so reads and writes are
+// per-lane gathers and scatters; between them the gains, dampers, tap mix and
+// feedback matrix are one nova::vec op each (gverb_lanes_step). The diffusers
+// are a serial chain and stay scalar. Same arithmetic, in the same order, as
+// GVerb_next.
+
+static inline int gverb_ring_read_index(int idx, int n, int size) {
+    int i = (idx - n + size) % size;
+    return i < 0 ? i + size : i;
+}
+
+// `>=` rather than `==`: the first FDN line's length comes from nearestprime(),
+// which returns -1 for any non-prime room size, and upstream's `% -1` then pins
+// that line to index 0.
+static inline int gverb_ring_next(int i, int size) { return ++i >= size ? 0 : i; }
+
+// The FDN lanes of one GVerb: gains and damper state, stepped a sample at a
+// time by gverb_lanes_step().
+struct GVerbLanes {
+    alignas(16) float fdngains[FDNORDER];
+    alignas(16) float fdngainslopes[FDNORDER];
+    alignas(16) float tapgains[FDNORDER];
+    alignas(16) float tapgainslopes[FDNORDER];
+    alignas(16) float damping[FDNORDER];
+    alignas(16) float damping1[FDNORDER]; // 1 - damping
+    alignas(16) float delay[FDNORDER]; // damper one-pole state
+};
+
+// Feedback matrix signs, one lane per output: f = 0.5 * sum(kMix[k] * d[k]).
+// Each sign is exact, so every lane adds the same terms in the same order as
+// gverb_fdnmatrix().
+alignas(16) static const float kGVerbMix[FDNORDER][FDNORDER] = { { +1.f, +1.f, -1.f, +1.f },
+                                                                 { +1.f, -1.f, +1.f, +1.f },
+                                                                 { -1.f, -1.f, -1.f, +1.f },
+                                                                 { -1.f, +1.f, +1.f, +1.f } };
+
+// One sample across the lanes: the early taps (u), the damped line outputs
+// (d), the matrix output (f), each lane's share of the tap mix (e) and what
+// goes back into each line (w), from the gathered tap and line reads. The
+// gains then step by their slopes.
+static inline void gverb_lanes_step(GVerbLanes& s, const float* tapin, const float* fdnin, float taillevel,
+                                    float earlylevel, float* u, float* d, float* f, float* e, float* w) {
+#    ifdef NOVA_SIMD
+    using vecf = nova::vec<float>;
+    if constexpr (vecf::size == FDNORDER) {
+        vecf tg, fg, in;
+        tg.load_aligned(s.tapgains);
+        fg.load_aligned(s.fdngains);
+        in.load_aligned(tapin);
+        const vecf vu = tg * in;
+        in.load_aligned(fdnin);
+        vecf damp, damp1, delay;
+        damp.load_aligned(s.damping);
+        damp1.load_aligned(s.damping1);
+        delay.load_aligned(s.delay);
+        const vecf vd = (fg * in) * damp1 + delay * damp;
+        // zapgremlins(): keep 1e-15 < |x| < 1e15, zero the rest (NaN included).
+        const vecf zero(0.f);
+        auto zap = [&](vecf x) {
+            const vecf a = abs(x);
+            return select(zero, select(zero, x, mask_lt(a, vecf(1e15f))), mask_gt(a, vecf(1e-15f)));
+        };
+        zap(vd).store_aligned(s.delay);
+        vu.store_aligned(u);
+        vd.store_aligned(d);
+        (vecf(taillevel) * vd + vecf(earlylevel) * vu).store_aligned(e);
+
+        vecf m0, m1, m2, m3;
+        m0.load_aligned(kGVerbMix[0]);
+        m1.load_aligned(kGVerbMix[1]);
+        m2.load_aligned(kGVerbMix[2]);
+        m3.load_aligned(kGVerbMix[3]);
+        const vecf vf =
+            vecf(0.5f) * (((m0 * vecf(d[0]) + m1 * vecf(d[1])) + m2 * vecf(d[2])) + m3 * vecf(d[3]));
+        vf.store_aligned(f);
+        zap(vu + vf).store_aligned(w);
+
+        vecf slope;
+        slope.load_aligned(s.fdngainslopes);
+        (fg + slope).store_aligned(s.fdngains);
+        slope.load_aligned(s.tapgainslopes);
+        (tg + slope).store_aligned(s.tapgains);
+        return;
+    }
+#    endif
+    for (int j = 0; j < FDNORDER; j++) {
+        u[j] = s.tapgains[j] * tapin[j];
+        const float y = (s.fdngains[j] * fdnin[j]) * s.damping1[j] + s.delay[j] * s.damping[j];
+        s.delay[j] = zapgremlins(y);
+        d[j] = y;
+        e[j] = taillevel * d[j] + earlylevel * u[j];
+    }
+    for (int j = 0; j < FDNORDER; j++) {
+        f[j] = 0.5f
+            * (((kGVerbMix[0][j] * d[0] + kGVerbMix[1][j] * d[1]) + kGVerbMix[2][j] * d[2])
+               + kGVerbMix[3][j] * d[3]);
+        w[j] = zapgremlins(u[j] + f[j]);
+        s.fdngains[j] += s.fdngainslopes[j];
+        s.tapgains[j] += s.tapgainslopes[j];
+    }
+}
+
+void GVerb_next_lanes(GVerb* unit, int inNumSamples) {
+    float* in = IN(0);
+    float* outl = OUT(0);
+    float* outr = OUT(1);
+    float roomsize = IN0(1);
+    float revtime = IN0(2);
+    float damping = IN0(3);
+    float inputbandwidth = IN0(4);
+    float drylevel = IN0(6);
+    float earlylevel = IN0(7);
+    float taillevel = IN0(8);
+
+    if ((roomsize != unit->roomsize) || (revtime != unit->revtime) || (damping != unit->damping)
+        || (inputbandwidth != unit->inputbandwidth) || (drylevel != unit->drylevel) || (earlylevel != unit->earlylevel)
+        || (taillevel != unit->taillevel)) {
+        gverb_set_roomsize(unit, roomsize);
+        gverb_set_revtime(unit, revtime);
+        gverb_set_damping(unit, damping);
+        gverb_set_inputbandwidth(unit, inputbandwidth);
+        drylevel = gverb_set_drylevel(unit, drylevel);
+        earlylevel = gverb_set_earlylevel(unit, earlylevel);
+        taillevel = gverb_set_taillevel(unit, taillevel);
+    }
+
+    const float earlylevelslope = unit->earlylevelslope;
+    const float taillevelslope = unit->taillevelslope;
+    const float drylevelslope = unit->drylevelslope;
+
+    // Lane state, loaded once per block.
+    GVerbLanes lanes;
+    float* fdnbuf[FDNORDER];
+    int fdnsize[FDNORDER], fdnwrite[FDNORDER], fdnread[FDNORDER], tapread[FDNORDER];
+    alignas(16) float u[FDNORDER], f[FDNORDER], d[FDNORDER];
+
+    g_fixeddelay* tapdelay = unit->tapdelay;
+    float* tapbuf = tapdelay->buf;
+    const int tapsize = tapdelay->size;
+    int tapwrite = tapdelay->idx;
+
+    for (int j = 0; j < FDNORDER; j++) {
+        g_fixeddelay* del = unit->fdndels[j];
+        lanes.fdngains[j] = unit->fdngains[j];
+        lanes.fdngainslopes[j] = unit->fdngainslopes[j];
+        lanes.tapgains[j] = unit->tapgains[j];
+        lanes.tapgainslopes[j] = unit->tapgainslopes[j];
+        lanes.damping[j] = unit->fdndamps[j]->damping;
+        lanes.damping1[j] = 1.0f - lanes.damping[j];
+        lanes.delay[j] = unit->fdndamps[j]->delay;
+        fdnbuf[j] = del->buf;
+        fdnsize[j] = del->size;
+        fdnwrite[j] = del->idx;
+        fdnread[j] = gverb_ring_read_index(del->idx, unit->fdnlens[j], del->size);
+        tapread[j] = gverb_ring_read_index(tapwrite, unit->taps[j], tapsize);
+    }
+
+    // Diffusers: the input one, then three per side.
+    g_diffuser* difs[7] = { unit->ldifs[0], unit->ldifs[1], unit->ldifs[2], unit->ldifs[3],
+                            unit->rdifs[1], unit->rdifs[2], unit->rdifs[3] };
+    int difidx[7];
+    for (int k = 0; k < 7; k++)
+        difidx[k] = difs[k]->idx;
+    auto diffuse = [&](int k, float x) {
+        g_diffuser* p = difs[k];
+        float* buf = p->buf;
+        const float coef = p->coef;
+        const int idx = difidx[k];
+        float w = x - buf[idx] * coef;
+        w = flush_to_zero(w);
+        const float y = buf[idx] + w * coef;
+        buf[idx] = zapgremlins(w);
+        difidx[k] = gverb_ring_next(idx, p->size);
+        return y;
+    };
+
+    g_damper* inputdamper = unit->inputdamper;
+
+    for (int i = 0; i < inNumSamples; i++) {
+        float sign, sum, lsum, rsum, x;
+        if (sc_isnan(in[i]))
+            x = 0.f;
+        else
+            x = in[i];
+        sum = 0.f;
+        sign = 1.f;
+
+        float z = damper_do(unit, inputdamper, x);
+        z = diffuse(0, z);
+
+        alignas(16) float tapin[FDNORDER], fdnin[FDNORDER], e[FDNORDER], w[FDNORDER];
+        for (int j = 0; j < FDNORDER; j++) {
+            tapin[j] = tapbuf[tapread[j]];
+            fdnin[j] = fdnbuf[j][fdnread[j]];
+        }
+
+        tapbuf[tapwrite] = zapgremlins(z);
+        tapwrite = gverb_ring_next(tapwrite, tapsize);
+
+        gverb_lanes_step(lanes, tapin, fdnin, taillevel, earlylevel, u, d, f, e, w);
+
+        for (int j = 0; j < FDNORDER; j++) {
+            sum += sign * e[j];
+            sign = -sign;
+        }
+
+        sum += x * earlylevel;
+        lsum = sum;
+        rsum = sum;
+
+        for (int j = 0; j < FDNORDER; j++) {
+            tapread[j] = gverb_ring_next(tapread[j], tapsize);
+            fdnread[j] = gverb_ring_next(fdnread[j], fdnsize[j]);
+            fdnbuf[j][fdnwrite[j]] = w[j];
+            fdnwrite[j] = gverb_ring_next(fdnwrite[j], fdnsize[j]);
+        }
+
+        lsum = diffuse(1, lsum);
+        lsum = diffuse(2, lsum);
+        lsum = diffuse(3, lsum);
+        rsum = diffuse(4, rsum);
+        rsum = diffuse(5, rsum);
+        rsum = diffuse(6, rsum);
+
+        x = x * drylevel;
+        outl[i] = lsum + x;
+        outr[i] = rsum + x;
+
+        drylevel += drylevelslope;
+        taillevel += taillevelslope;
+        earlylevel += earlylevelslope;
+    }
+
+    for (int k = 0; k < 7; k++)
+        difs[k]->idx = difidx[k];
+    tapdelay->idx = tapwrite;
+    for (int j = 0; j < FDNORDER; j++) {
+        unit->fdndels[j]->idx = fdnwrite[j];
+        unit->fdndamps[j]->delay = lanes.delay[j];
+        unit->u[j] = u[j];
+        unit->f[j] = f[j];
+        unit->d[j] = d[j];
+        unit->tapgains[j] = lanes.tapgains[j];
+        unit->fdngains[j] = lanes.fdngains[j];
+        unit->fdngainslopes[j] = 0.f;
+        unit->tapgainslopes[j] = 0.f;
+    }
+    unit->earlylevelslope = unit->taillevelslope = unit->drylevelslope = 0.f;
+}
+#endif
+
 extern "C"
 PluginLoad(Reverb) {
     ft = inTable;
@@ -221,6 +221,38 @@ public:
         // printf("mMaxItems %d   mTableSize %d   newSize %d\n", mMaxItems, mTableSize, newSize);
     }
 
+#ifdef SUPERSONIC
+    // Raise the item limit of a fixed-size table (World_ApplyResize). The new
+    // table is a power of two at least twice inMaxItems, drawn from the pool;
+    // returns false, leaving the table untouched, if the pool cannot supply it.
+    bool Regrow(int32 inMaxItems) {
+        if (inMaxItems <= mMaxItems)
+            return true;
+        int32 newSize = 32;
+        while (newSize < (inMaxItems << 1))
+            newSize <<= 1;
+        T** newItems = static_cast<T**>(mPool->Alloc(newSize * sizeof(T*)));
+        if (newItems == NULL)
+            return false;
+        for (int i = 0; i < newSize; ++i)
+            newItems[i] = 0;
+        T** oldItems = mItems;
+        int32 oldSize = mTableSize;
+        mItems = newItems;
+        mTableSize = newSize;
+        mHashMask = newSize - 1;
+        mMaxItems = inMaxItems;
+        mNumItems = 0;
+        for (int i = 0; i < oldSize; ++i) {
+            T* item = oldItems[i];
+            if (item)
+                Add(item);
+        }
+        mPool->Free(oldItems);
+        return true;
+    }
+#endif
+
     bool Add(T* inItem) {
         // printf("mNumItems %d\n", mNumItems);
         // printf("mMaxItems %d\n", mMaxItems);
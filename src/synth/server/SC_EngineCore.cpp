@@ -49,6 +49,11 @@ void EngineCore_BeginBlock(World* world) {
     // to a bus this block and accumulate only on later writes.
     memset(world->mAudioBus, 0,
            (size_t)world->mNumOutputs * (size_t)world->mBufLength * sizeof(float));
+    // Close out the previous block's FFT count (published by World_UpdateNativeStats).
+    if (world->mFFTsThisBlock > world->mFFTBlockPeak)
+        world->mFFTBlockPeak = world->mFFTsThisBlock;
+    world->mFFTTransforms += world->mFFTsThisBlock;
+    world->mFFTsThisBlock = 0;
     world->mBufCounter++;
 }
 
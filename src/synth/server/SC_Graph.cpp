@@ -35,7 +35,11 @@
 #include "SC_Errors.h"
 #include "Unroll.h"
 #include "SC_ReplyImpl.hpp"
+#include "SC_AllocPool.h"
 #include "clz.h"
+#ifdef SUPERSONIC
+#include "../../cmd_record.h"
+#endif
 
 // =============================================================================
 // SUPERSONIC MODIFICATIONS
@@ -45,6 +49,11 @@
 // 1. ss_log declaration: For WASM debugging output
 // 2. Graph_CalcTrace: Uses ss_log instead of scprintf
 // 3. Graph_New error logging: Added ss_log call on error
+// 4. Graph_Ctor: initialises mFFTPhase (staggered FFT frames) and mBusAliases
+//    (zero-copy bus reads)
+// 5. Per-node constructor arenas: Graph_Arena* back the plugin RTAlloc,
+//    RTRealloc and RTFree entries; constructors, Graph_Calc, destructors and
+//    unit commands run with the node set as world->mArenaGraph
 // =============================================================================
 
 #ifdef SUPERSONIC
@@ -67,6 +76,103 @@ struct QueuedCmd {
 void Graph_FirstCalc(Graph* inGraph);
 void Graph_NullFirstCalc(Graph* inGraph);
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] Per-node constructor arenas.
+//
+// Unit constructors allocate delay lines, tables and state through RTAlloc,
+// one pool allocation each. While a synth's constructors run, the plugin
+// RTAlloc entry instead bumps through one block taken for the whole node,
+// sized by its def's mArenaBytes. The first instance has no block and only
+// measures; an instance whose constructors ask for more than the block holds
+// gets the rest from the pool and raises mArenaBytes for the next one, and
+// each instance that asks for less moves it an eighth of the way back down,
+// so one unusually large instance does not size every later block. The
+// block is freed with the node, so RTFree of arena memory does nothing: the
+// plugin entries recognise it by world->mArenaGraph, the node whose units are
+// running. That is set for constructors, Graph_Calc and destructors here, and
+// for unit commands: synchronous and queued ones in Unit_RunCommand, and an
+// async one's real-time stage and cleanup in AsyncUnitCmd. A unit may keep
+// arena memory across any of them and RTRealloc or RTFree it in another.
+// Allocations outside constructors always go to the pool.
+std::atomic<bool> gGraphArena { true };
+
+static inline bool Graph_InArena(const Graph* inGraph, const void* inPtr) {
+    if (!inGraph)
+        return false;
+    uintptr_t base = (uintptr_t)inGraph->mArena;
+    return (uintptr_t)inPtr - base < inGraph->mArenaSize;
+}
+
+void* Graph_ArenaAlloc(World* inWorld, size_t inByteSize) {
+    Graph* graph = inWorld->mArenaGraph;
+    if (!graph || !inWorld->mArenaCtors)
+        return World_Alloc(inWorld, inByteSize);
+
+    size_t bytes = (inByteSize + kAlignMask) & ~kAlignMask;
+    if (bytes > 0x7fffffff - graph->mArenaDemand) {
+        inWorld->mArenaPoolAllocs++;
+        return World_Alloc(inWorld, inByteSize);
+    }
+    graph->mArenaDemand += (uint32)bytes;
+    if (bytes <= graph->mArenaSize - graph->mArenaUsed) {
+        void* ptr = graph->mArena + graph->mArenaUsed;
+        graph->mArenaUsed += (uint32)bytes;
+        inWorld->mArenaAllocs++;
+        return ptr;
+    }
+    inWorld->mArenaPoolAllocs++;
+    return World_Alloc(inWorld, inByteSize);
+}
+
+void* Graph_ArenaRealloc(World* inWorld, void* inPtr, size_t inByteSize) {
+    Graph* graph = inWorld->mArenaGraph;
+    if (!Graph_InArena(graph, inPtr))
+        return World_Realloc(inWorld, inPtr, inByteSize);
+
+    // Arena blocks don't record their size; copy no further than the arena.
+    void* ptr = World_Alloc(inWorld, inByteSize);
+    if (ptr) {
+        size_t avail = (size_t)(graph->mArena + graph->mArenaSize - (char*)inPtr);
+        memcpy(ptr, inPtr, sc_min(inByteSize, avail));
+    }
+    return ptr;
+}
+
+void Graph_ArenaFree(World* inWorld, void* inPtr) {
+    if (!Graph_InArena(inWorld->mArenaGraph, inPtr))
+        World_Free(inWorld, inPtr);
+}
+
+// Take the node's block and route its constructors' RTAllocs through it.
+// Returns the previous mArenaGraph for Graph_ArenaEnd.
+static Graph* Graph_ArenaBegin(Graph* inGraph) {
+    World* world = inGraph->mNode.mWorld;
+    uint32 bytes = GRAPHDEF(inGraph)->mArenaBytes;
+    if (bytes && !inGraph->mArena && gGraphArena.load(std::memory_order_relaxed)) {
+        inGraph->mArena = (char*)World_Alloc(world, bytes);
+        if (inGraph->mArena)
+            inGraph->mArenaSize = bytes;
+    }
+    Graph* prev = world->mArenaGraph;
+    world->mArenaGraph = inGraph;
+    world->mArenaCtors = true;
+    return prev;
+}
+
+static void Graph_ArenaEnd(Graph* inGraph, Graph* inPrev) {
+    World* world = inGraph->mNode.mWorld;
+    GraphDef* def = GRAPHDEF(inGraph);
+    const uint32 demand = inGraph->mArenaDemand;
+    if (demand > def->mArenaBytes)
+        def->mArenaBytes = demand;
+    else
+        def->mArenaBytes -= ((def->mArenaBytes - demand) >> 3) & ~(uint32)kAlignMask;
+    world->mArenaSynths++;
+    world->mArenaCtors = false;
+    world->mArenaGraph = inPrev;
+}
+#endif
+
 static void Graph_Dtor(Graph* inGraph) {
     // scprintf("->Graph_Dtor %d\n", inGraph->mNode.mID);
     World* world = inGraph->mNode.mWorld;
@@ -75,13 +181,29 @@ static void Graph_Dtor(Graph* inGraph) {
     if (inGraph->mNode.mCalcFunc != (NodeCalcFunc)Graph_FirstCalc
         && inGraph->mNode.mCalcFunc != (NodeCalcFunc)(Graph_NullFirstCalc)) {
         // the above test insures that dtors are not called if ctors have not been called.
+#ifdef SUPERSONIC
+        Graph* prevArenaGraph = world->mArenaGraph;
+        world->mArenaGraph = inGraph;
+#endif
         for (uint32 i = 0; i < numUnits; ++i) {
             Unit* unit = graphUnits[i];
             UnitDtorFunc dtor = unit->mUnitDef->mUnitDtorFunc;
             if (dtor)
                 (dtor)(unit);
         }
+#ifdef SUPERSONIC
+        world->mArenaGraph = prevArenaGraph;
+#endif
+    }
+#ifdef SUPERSONIC
+    if (inGraph->mArena) {
+        World_Free(world, inGraph->mArena);
+        // An async unit command can outlive this (the Graph is refcounted):
+        // nothing may match the freed block any more.
+        inGraph->mArena = nullptr;
+        inGraph->mArenaSize = 0;
     }
+#endif
 
     // NOTE: mBufRate is allocated as part of mFullRate, see Graph_Ctor()!
     if (inGraph->mFullRate != &world->mFullRate)
@@ -153,7 +275,8 @@ bool Graph_HasParent(const Graph* inGraph) { return inGraph->mNode.mParent != nu
 
 ////////////////////////////////////////////////////////////////////////////////
 
-static void Graph_Ctor(World* inWorld, GraphDef* inGraphDef, Graph* graph, sc_msg_iter* msg, bool argtype);
+static void Graph_Ctor(World* inWorld, GraphDef* inGraphDef, Graph* graph, sc_msg_iter* msg, bool argtype,
+                       const SsCmdView* precoded = nullptr);
 
 // 'argtype' is true for normal args, false for setn type args
 int Graph_New(World* inWorld, GraphDef* inGraphDef, int32 inID, sc_msg_iter* args, Graph** outGraph, bool argtype) {
@@ -169,8 +292,54 @@ int Graph_New(World* inWorld, GraphDef* inGraphDef, int32 inID, sc_msg_iter* arg
     return err;
 }
 
+#ifdef SUPERSONIC
+int Graph_NewPrecoded(World* inWorld, GraphDef* inGraphDef, int32 inID, const SsCmdView& inCmd, Graph** outGraph) {
+    Graph* graph;
+    int err = Node_New(inWorld, &inGraphDef->mNodeDef, inID, (Node**)&graph);
+    if (err) {
+        ss_log("[Graph_New] ERROR: Node_New failed with error code %d", err);
+        return err;
+    }
+
+    Graph_Ctor(inWorld, inGraphDef, graph, nullptr, false, &inCmd);
+    *outGraph = graph;
+    return err;
+}
+
+// [SUPERSONIC] The control-setting loop of Graph_Ctor, over a precoded
+// /s_new's entries: same calls, with the name hashes and element indices the
+// producer resolved.
+static void Graph_SetPrecodedControls(Graph* graph, const SsCmdView& cmd) {
+    for (uint32 n = 0; n < cmd.rec->count; ++n) {
+        const SsCmdEntry& e = cmd.entries[n];
+        int32* name = e.nameOff ? (int32*)(cmd.osc + e.nameOff) : nullptr;
+        switch (e.op) {
+        case kSsCmdSet:
+            if (name)
+                Graph_SetControl(graph, e.key, name, e.aux, e.value.f);
+            else
+                Graph_SetControl(graph, e.key + e.aux, e.value.f);
+            break;
+        case kSsCmdMapControl:
+            if (name)
+                Graph_MapControl(graph, e.key, name, e.aux, e.value.i);
+            else
+                Graph_MapControl(graph, e.key + e.aux, e.value.i);
+            break;
+        case kSsCmdMapAudio:
+            if (name)
+                Graph_MapAudioControl(graph, e.key, name, e.aux, e.value.i);
+            else
+                Graph_MapAudioControl(graph, e.key + e.aux, e.value.i);
+            break;
+        }
+    }
+}
+#endif
+
 // 'argtype' is true for normal args, false for setn type args
-static void Graph_Ctor(World* inWorld, GraphDef* inGraphDef, Graph* graph, sc_msg_iter* msg, bool argtype) {
+static void Graph_Ctor(World* inWorld, GraphDef* inGraphDef, Graph* graph, sc_msg_iter* msg, bool argtype,
+                       const SsCmdView* precoded) {
     // scprintf("->Graph_Ctor\n");
 
     // hit the memory allocator only once.
@@ -229,6 +398,11 @@ static void Graph_Ctor(World* inWorld, GraphDef* inGraphDef, Graph* graph, sc_ms
     // set controls
     // if argtype == true -> normal args as always
     // if argtype == false -> setn type args
+#ifdef SUPERSONIC
+    if (precoded)
+        Graph_SetPrecodedControls(graph, *precoded);
+    else
+#endif
     if (argtype) {
         while (msg->remain() >= 8) {
             int i = 0;
@@ -542,6 +716,14 @@ static void Graph_Ctor(World* inWorld, GraphDef* inGraphDef, Graph* graph, sc_ms
     // so far mPrivate is only used for queued unit commands,
     // i.e. it just points to the head of the list.
     graph->mPrivate = nullptr;
+#ifdef SUPERSONIC
+    graph->mFFTPhase = -1;
+    graph->mBusAliases = inGraphDef->mBusAliases;
+    graph->mArena = nullptr;
+    graph->mArenaSize = 0;
+    graph->mArenaUsed = 0;
+    graph->mArenaDemand = 0;
+#endif
 
     // initialize units
     // scprintf("initialize units\n");
@@ -650,12 +832,18 @@ static void Graph_DispatchUnitCmds(Graph* inGraph) {
         assert(nodeID == inGraph->mNode.mID);
 
         uint32 unitID = msg.geti();
+#ifdef SUPERSONIC
+        // [SUPERSONIC] Queued with the synthdef's unit index; see Unit_DoCmd().
+        unitID = (uint32)GraphDef_UnitIndex((GraphDef*)inGraph->mNode.mDef, unitID);
+#endif
         Unit* unit = inGraph->mUnits[unitID];
         UnitDef* unitDef = unit->mUnitDef;
 
         int32* cmdName = msg.gets4();
         UnitCmd* cmd = unitDef->mCmds->Get(cmdName);
 
+        // Sets the node as mArenaGraph itself: Graph_ArenaEnd has already
+        // restored the caller's.
         Unit_RunCommand(cmd, unit, &msg, &item->mReplyAddress);
 
         World_Free(inGraph->mNode.mWorld, item);
@@ -685,11 +873,17 @@ bool Graph_InitUnits(Graph* inGraph) {
 
     uint32 numUnits = inGraph->mNumUnits;
     Unit** units = inGraph->mUnits;
+#ifdef SUPERSONIC
+    Graph* prevArenaGraph = Graph_ArenaBegin(inGraph);
+#endif
     for (uint32 i = 0; i < numUnits; ++i) {
         Unit* unit = units[i];
         // call constructor
         (*unit->mUnitDef->mUnitCtorFunc)(unit);
     }
+#ifdef SUPERSONIC
+    Graph_ArenaEnd(inGraph, prevArenaGraph);
+#endif
 
     // [SuperSonic] Prevent zombie synth nodes when RT memory is exhausted.
     //
@@ -736,11 +930,17 @@ void Graph_NullFirstCalc(Graph* inGraph) {
     // scprintf("->Graph_FirstCalc\n");
     uint32 numUnits = inGraph->mNumUnits;
     Unit** units = inGraph->mUnits;
+#ifdef SUPERSONIC
+    Graph* prevArenaGraph = Graph_ArenaBegin(inGraph);
+#endif
     for (uint32 i = 0; i < numUnits; ++i) {
         Unit* unit = units[i];
         // call constructor
         (*unit->mUnitDef->mUnitCtorFunc)(unit);
     }
+#ifdef SUPERSONIC
+    Graph_ArenaEnd(inGraph, prevArenaGraph);
+#endif
     // scprintf("<-Graph_FirstCalc\n");
 
     inGraph->mNode.mCalcFunc = &Node_NullCalc;
@@ -764,6 +964,13 @@ void Graph_Calc(Graph* inGraph) {
 
     int numTicks = inGraph->mNumTicks;
 
+#ifdef SUPERSONIC
+    // [SUPERSONIC] So RTFree from a calc function recognises arena memory.
+    World* world = inGraph->mNode.mWorld;
+    Graph* prevArenaGraph = world->mArenaGraph;
+    world->mArenaGraph = inGraph;
+#endif
+
     for (int k = 0; k < numTicks; ++k) {
         // set before calling Graph_Calc_unit()!
         inGraph->mTickCounter = k;
@@ -799,6 +1006,9 @@ void Graph_Calc(Graph* inGraph) {
             Graph_Calc_unit(calcUnits[i]);
     }
 
+#ifdef SUPERSONIC
+    world->mArenaGraph = prevArenaGraph;
+#endif
     // scprintf("<-Graph_Calc\n");
 }
 
@@ -817,6 +1027,12 @@ void Graph_CalcTrace(Graph* inGraph) {
 
     int numTicks = inGraph->mNumTicks;
 
+#ifdef SUPERSONIC
+    World* world = inGraph->mNode.mWorld;
+    Graph* prevArenaGraph = world->mArenaGraph;
+    world->mArenaGraph = inGraph;
+#endif
+
     for (int k = 0; k < numTicks; ++k) {
         if (numTicks > 1)
             ss_log("tick %d of %d:\n", k + 1, numTicks);
@@ -839,6 +1055,9 @@ void Graph_CalcTrace(Graph* inGraph) {
         }
     }
 
+#ifdef SUPERSONIC
+    world->mArenaGraph = prevArenaGraph;
+#endif
     inGraph->mNode.mCalcFunc = (NodeCalcFunc)&Graph_Calc;
 }
 
@@ -41,6 +41,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <cstddef>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -62,6 +65,13 @@ namespace fs = std::filesystem;
 //    GraphDef_LoadDir, GraphDef_LoadGlob, load_file — not available in WASM)
 // 3. GraphDef_Recv: Extra std::string* outErrorMsg parameter for WASM error reporting
 // 4. g_lastGraphDefError: Static error storage for Emscripten/WASM exception handling
+// 5. GraphDef_Optimise: load-time constant folding and dead-unit elimination
+//    (switch: gGraphDefOptimise / /d_optimise; counts: /d_stats)
+// 6. GraphDef_FindBusAliases: readers that may take In/InFeedback/LocalIn
+//    outputs straight from the bus (BusAlias in SC_Graph.h)
+// 7. mArenaBytes: per-def constructor arena size, learned by SC_Graph.cpp
+// 8. GraphDef_FindBufferControls: controls that name a played buffer
+//    (SampleResidency's prefetch)
 //
 // Backported from SuperCollider upstream commit 99be55460
 // https://github.com/supercollider/supercollider/commit/99be55460
@@ -298,6 +308,437 @@ static void GraphDef_SetAllocSizes(GraphDef* graphDef) {
 }
 
 
+#ifdef SUPERSONIC
+// =============================================================================
+// [SUPERSONIC] Load-time constant folding and dead-unit elimination
+// =============================================================================
+// Runs on the unit specs straight after they are read, before buffer
+// colouring assigns wires, so everything downstream (wire count, wire
+// buffers, calc-unit list, the Graph's bump allocation) is sized for the
+// optimised graph.
+//
+//  - Folding: a scalar-rate math unit (BinaryOpUGen, UnaryOpUGen, MulAdd,
+//    Sum3, Sum4) whose inputs are all constants is evaluated once, here, by
+//    running its own constructor on scratch wires. Its consumers are rewired
+//    to a new constant. Evaluating through the real constructor keeps the
+//    result bit-identical to what every instance would have computed.
+//    Chains fold in one forward pass because units are topologically sorted.
+//    Scalar units fed by init-rate units (Rand, Control, ...) already run
+//    once per instance in their constructor and have no calc function, so
+//    they are left as they are.
+//  - Elimination: a unit from a known side-effect-free set whose outputs
+//    nothing consumes is dropped, along with anything feeding only it.
+//    Random ops are kept even when unused: they advance the graph's RGen, so
+//    dropping one would change what a RandSeed'd synth produces.
+//
+// Units that accept /u_cmd are never removed, and GraphDef_UnitIndex() maps
+// /u_cmd's unit index (as written in the synthdef) to the surviving unit.
+
+std::atomic<bool> gGraphDefOptimise { true };
+
+void UnitSpec_Free(UnitSpec* inUnitSpec);
+
+namespace {
+
+// Special indices from BinaryOpUGens.cpp / UnaryOpUGens.cpp.
+constexpr int16 kBinaryOpRandRange = 47;
+constexpr int16 kBinaryOpExpRandRange = 48;
+constexpr int16 kUnaryOpRand = 37; // rand, rand2, linrand, bilinrand, sum3rand
+constexpr int16 kUnaryOpSum3Rand = 41;
+constexpr int16 kUnaryOpCoin = 44;
+
+bool UnitNameIs(const UnitSpec* unitSpec, const char* name) {
+    return strncmp((const char*)unitSpec->mUnitDef->mUnitDefName, name, kSCNameByteLen) == 0;
+}
+
+bool IsRandomOp(const UnitSpec* unitSpec) {
+    const int16 op = unitSpec->mSpecialIndex;
+    if (UnitNameIs(unitSpec, "BinaryOpUGen"))
+        return op == kBinaryOpRandRange || op == kBinaryOpExpRandRange;
+    if (UnitNameIs(unitSpec, "UnaryOpUGen"))
+        return (op >= kUnaryOpRand && op <= kUnaryOpSum3Rand) || op == kUnaryOpCoin;
+    return false;
+}
+
+// Deterministic math whose scalar-rate constructor computes its one output.
+bool IsFoldable(const UnitSpec* unitSpec) {
+    static const char* const kNames[] = { "BinaryOpUGen", "UnaryOpUGen", "MulAdd", "Sum3", "Sum4" };
+    if (unitSpec->mCalcRate != calc_ScalarRate || unitSpec->mNumOutputs != 1 || IsRandomOp(unitSpec))
+        return false;
+    for (const char* name : kNames)
+        if (UnitNameIs(unitSpec, name))
+            return true;
+    return false;
+}
+
+// Units whose only effect is their outputs: no bus/buffer writes, no done
+// actions, no replies, no RNG draws.
+bool IsPure(const UnitSpec* unitSpec) {
+    static const char* const kNames[] = {
+        "BinaryOpUGen", "UnaryOpUGen", "MulAdd", "Sum3", "Sum4",
+        "DC", "Silent", "K2A", "A2K", "In", "InFeedback",
+        "SinOsc", "FSinOsc", "LFSaw", "LFPar", "LFCub", "LFTri", "LFPulse", "Impulse",
+        "Saw", "Pulse", "Blip", "VarSaw", "SyncSaw",
+        "LPF", "HPF", "BPF", "BRF", "RLPF", "RHPF", "OnePole", "OneZero", "TwoPole", "TwoZero",
+        "LeakDC", "Lag", "Lag2", "Lag3", "LagUD", "Ramp",
+        "Clip", "Wrap", "Fold", "InRange", "LinExp",
+        "Pan2", "LinPan2", "Balance2", "XFade2", "LinXFade2", "Select",
+    };
+    if (unitSpec->mCalcRate == calc_DemandRate || unitSpec->mNumOutputs == 0 || unitSpec->mUnitDef->mCmds
+        || IsRandomOp(unitSpec))
+        return false;
+    for (const char* name : kNames)
+        if (UnitNameIs(unitSpec, name))
+            return true;
+    return false;
+}
+
+// Run the unit's constructor against constant inputs and return its output.
+float EvaluateConstantUnit(World* inWorld, UnitSpec* unitSpec, const float32* constants) {
+    Graph graph;
+    memset(&graph, 0, sizeof(graph));
+    graph.mNode.mWorld = inWorld;
+    graph.mFullRate = &inWorld->mFullRate;
+    graph.mBufRate = &inWorld->mBufRate;
+    graph.mRGen = inWorld->mRGen;
+
+    std::vector<std::max_align_t> space(unitSpec->mAllocSize / sizeof(std::max_align_t) + 1);
+    char* memory = reinterpret_cast<char*>(space.data());
+    Unit* unit = Unit_New(inWorld, &graph, unitSpec, memory);
+    unit->mParent = &graph;
+    unit->mParentIndex = 0;
+
+    std::vector<Wire> wires(unitSpec->mNumInputs + 1);
+    for (uint32 i = 0; i <= unitSpec->mNumInputs; ++i) {
+        Wire* wire = &wires[i];
+        wire->mFromUnit = nullptr;
+        wire->mCalcRate = calc_ScalarRate;
+        wire->mBuffer = &wire->mScalarValue;
+        wire->mScalarValue = i < unitSpec->mNumInputs ? constants[unitSpec->mInputSpec[i].mFromOutputIndex] : 0.f;
+        if (i < unitSpec->mNumInputs) {
+            unit->mInput[i] = wire;
+            unit->mInBuf[i] = wire->mBuffer;
+        } else {
+            wire->mFromUnit = unit;
+            unit->mOutput[0] = wire;
+            unit->mOutBuf[0] = wire->mBuffer;
+        }
+    }
+
+    (*unitSpec->mUnitDef->mUnitCtorFunc)(unit);
+    const float result = wires[unitSpec->mNumInputs].mScalarValue;
+    if (unitSpec->mUnitDef->mUnitDtorFunc)
+        (*unitSpec->mUnitDef->mUnitDtorFunc)(unit);
+    return result;
+}
+
+// Every input must name an earlier unit's output or an existing constant;
+// anything else is left for the rest of the reader to deal with as upstream
+// does, unoptimised.
+bool InputsWellFormed(const GraphDef* graphDef) {
+    for (uint32 j = 0; j < graphDef->mNumUnitSpecs; ++j) {
+        const UnitSpec* unitSpec = graphDef->mUnitSpecs + j;
+        for (uint32 i = 0; i < unitSpec->mNumInputs; ++i) {
+            const InputSpec* in = unitSpec->mInputSpec + i;
+            if (in->mFromUnitIndex >= 0) {
+                if ((uint32)in->mFromUnitIndex >= j || in->mFromOutputIndex < 0
+                    || (uint32)in->mFromOutputIndex >= graphDef->mUnitSpecs[in->mFromUnitIndex].mNumOutputs)
+                    return false;
+            } else if (in->mFromOutputIndex < 0 || (uint32)in->mFromOutputIndex >= graphDef->mNumConstants) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+static void GraphDef_Optimise(World* inWorld, GraphDef* graphDef) {
+    const uint32 numUnits = graphDef->mNumUnitSpecs;
+    graphDef->mNumUnitsRead = numUnits;
+    graphDef->mNumCalcUnitsRead = graphDef->mNumCalcUnits;
+    graphDef->mNumFolded = 0;
+    graphDef->mUnitIndexMap = nullptr;
+    if (!gGraphDefOptimise.load(std::memory_order_relaxed) || numUnits == 0 || !InputsWellFormed(graphDef))
+        return;
+
+    UnitSpec* specs = graphDef->mUnitSpecs;
+
+    // Fold, forwards.
+    std::vector<float32> constants(graphDef->mConstants, graphDef->mConstants + graphDef->mNumConstants);
+    for (uint32 j = 0; j < numUnits; ++j) {
+        UnitSpec* unitSpec = specs + j;
+        if (!IsFoldable(unitSpec))
+            continue;
+        bool allConstant = true;
+        for (uint32 i = 0; i < unitSpec->mNumInputs && allConstant; ++i)
+            allConstant = unitSpec->mInputSpec[i].mFromUnitIndex < 0;
+        if (!allConstant)
+            continue;
+
+        const float32 value = EvaluateConstantUnit(inWorld, unitSpec, constants.data());
+        int32 constIndex = -1;
+        for (size_t c = 0; c < constants.size(); ++c) {
+            if (memcmp(&constants[c], &value, sizeof(float32)) == 0) {
+                constIndex = (int32)c;
+                break;
+            }
+        }
+        if (constIndex < 0) {
+            constIndex = (int32)constants.size();
+            constants.push_back(value);
+        }
+        for (uint32 k = j + 1; k < numUnits; ++k) {
+            UnitSpec* consumer = specs + k;
+            for (uint32 i = 0; i < consumer->mNumInputs; ++i) {
+                InputSpec* in = consumer->mInputSpec + i;
+                if (in->mFromUnitIndex == (int32)j) {
+                    in->mFromUnitIndex = -1;
+                    in->mFromOutputIndex = constIndex;
+                }
+            }
+        }
+        graphDef->mNumFolded++;
+    }
+
+    // Eliminate, backwards: a pure unit is live only while something live
+    // reads one of its outputs.
+    std::vector<uint32> consumers(numUnits, 0);
+    for (uint32 j = 0; j < numUnits; ++j)
+        for (uint32 i = 0; i < specs[j].mNumInputs; ++i)
+            if (specs[j].mInputSpec[i].mFromUnitIndex >= 0)
+                consumers[specs[j].mInputSpec[i].mFromUnitIndex]++;
+    std::vector<bool> live(numUnits, true);
+    uint32 numLive = numUnits;
+    for (uint32 j = numUnits; j-- > 0;) {
+        if (consumers[j] != 0 || !IsPure(specs + j))
+            continue;
+        live[j] = false;
+        numLive--;
+        for (uint32 i = 0; i < specs[j].mNumInputs; ++i)
+            if (specs[j].mInputSpec[i].mFromUnitIndex >= 0)
+                consumers[specs[j].mInputSpec[i].mFromUnitIndex]--;
+    }
+
+    if (constants.size() != graphDef->mNumConstants) {
+        float32* grown = new float32[constants.size()];
+        std::copy(constants.begin(), constants.end(), grown);
+        delete[] graphDef->mConstants;
+        graphDef->mConstants = grown;
+        graphDef->mNumConstants = (uint32)constants.size();
+    }
+
+    // Every constant is a wire, and folding may have added constants, so the
+    // wire count is re-derived even when nothing is eliminated.
+    graphDef->mNumWires = graphDef->mNumConstants;
+    for (uint32 j = 0; j < numUnits; ++j)
+        if (live[j])
+            graphDef->mNumWires += specs[j].mNumOutputs;
+    if (numLive == numUnits)
+        return;
+
+    // Compact the spec array in place and renumber inputs.
+    int32* indexMap = new int32[numUnits];
+    uint32 out = 0;
+    for (uint32 j = 0; j < numUnits; ++j) {
+        if (!live[j]) {
+            indexMap[j] = -1;
+            UnitSpec_Free(specs + j);
+            continue;
+        }
+        indexMap[j] = (int32)out;
+        if (out != j)
+            specs[out] = specs[j];
+        UnitSpec* unitSpec = specs + out;
+        for (uint32 i = 0; i < unitSpec->mNumInputs; ++i) {
+            InputSpec* in = unitSpec->mInputSpec + i;
+            if (in->mFromUnitIndex >= 0)
+                in->mFromUnitIndex = indexMap[in->mFromUnitIndex];
+        }
+        ++out;
+    }
+    graphDef->mUnitIndexMap = indexMap;
+    graphDef->mNumUnitSpecs = numLive;
+
+    // Re-derive what the reader accumulated per unit.
+    graphDef->mNumCalcUnits = 0;
+    graphDef->mNodeDef.mAllocSize = sizeof(Graph);
+    for (uint32 j = 0; j < numLive; ++j) {
+        const UnitSpec* unitSpec = specs + j;
+        if (unitSpec->mCalcRate == calc_BufRate || unitSpec->mCalcRate == calc_FullRate)
+            graphDef->mNumCalcUnits++;
+        graphDef->mNodeDef.mAllocSize += unitSpec->mAllocSize;
+    }
+}
+
+int32 GraphDef_UnitIndex(const GraphDef* inGraphDef, uint32 inOriginalIndex) {
+    if (!inGraphDef->mUnitIndexMap)
+        return inOriginalIndex < inGraphDef->mNumUnitSpecs ? (int32)inOriginalIndex : -1;
+    if (inOriginalIndex >= inGraphDef->mNumUnitsRead)
+        return -1;
+    return inGraphDef->mUnitIndexMap[inOriginalIndex];
+}
+
+namespace {
+
+// Units whose calc function copies a bus into their outputs.
+bool IsBusReader(const UnitSpec* unitSpec) {
+    return unitSpec->mCalcRate == calc_FullRate
+        && (UnitNameIs(unitSpec, "In") || UnitNameIs(unitSpec, "InFeedback") || UnitNameIs(unitSpec, "LocalIn"));
+}
+
+// First channel input of an audio-rate global bus writer (its bus index is
+// input 0), or -1 if the unit is not one.
+int32 BusWriterFirstChannel(const UnitSpec* unitSpec) {
+    if (unitSpec->mCalcRate != calc_FullRate)
+        return -1;
+    if (UnitNameIs(unitSpec, "Out") || UnitNameIs(unitSpec, "ReplaceOut") || UnitNameIs(unitSpec, "OffsetOut"))
+        return 1;
+    if (UnitNameIs(unitSpec, "XOut"))
+        return 2;
+    return -1;
+}
+
+} // namespace
+
+// For each bus reader, the inputs that can read its bus in place: every
+// reader of every channel, provided none is demand rate (pulled at unknown
+// times) and every bus writer between the reader and its last reader takes
+// its bus from a unit that has already run. Those writers become guards. A
+// LocalOut in that span rules LocalIn out, as its bus is fixed.
+static void GraphDef_FindBusAliases(GraphDef* graphDef) {
+    graphDef->mBusAliases = nullptr;
+    graphDef->mBusAliasPool = nullptr;
+    graphDef->mNumAliasedChannels = 0;
+    const uint32 numUnits = graphDef->mNumUnitSpecs;
+    if (!gGraphDefOptimise.load(std::memory_order_relaxed) || numUnits == 0 || !InputsWellFormed(graphDef))
+        return;
+
+    struct Found {
+        uint32 unit;
+        std::vector<std::vector<int32>> readers; // per channel, (unit, input) pairs
+        std::vector<int32> guards;
+    };
+    std::vector<Found> found;
+    size_t poolSize = 0;
+    const UnitSpec* specs = graphDef->mUnitSpecs;
+    for (uint32 j = 0; j < numUnits; ++j) {
+        if (!IsBusReader(specs + j))
+            continue;
+        const bool localBus = UnitNameIs(specs + j, "LocalIn");
+        Found f { j, std::vector<std::vector<int32>>(specs[j].mNumOutputs), {} };
+        uint32 lastReader = j;
+        bool ok = true;
+        for (uint32 k = j + 1; k < numUnits && ok; ++k) {
+            for (uint32 i = 0; i < specs[k].mNumInputs; ++i) {
+                const InputSpec* in = specs[k].mInputSpec + i;
+                if (in->mFromUnitIndex != (int32)j)
+                    continue;
+                ok = ok && specs[k].mCalcRate != calc_DemandRate;
+                f.readers[in->mFromOutputIndex].push_back((int32)k);
+                f.readers[in->mFromOutputIndex].push_back((int32)i);
+                lastReader = k;
+            }
+        }
+        for (uint32 k = j + 1; k <= lastReader && ok; ++k) {
+            if (localBus) {
+                ok = !(specs[k].mCalcRate == calc_FullRate && UnitNameIs(specs + k, "LocalOut"));
+                continue;
+            }
+            const int32 firstChannel = BusWriterFirstChannel(specs + k);
+            if (firstChannel < 0)
+                continue;
+            if (specs[k].mInputSpec[0].mFromUnitIndex >= (int32)j) {
+                ok = false;
+                continue;
+            }
+            f.guards.insert(f.guards.end(),
+                            { (int32)k, firstChannel, (int32)specs[k].mNumInputs - firstChannel });
+        }
+        if (!ok || lastReader == j)
+            continue;
+        poolSize += f.readers.size() + 1 + f.guards.size();
+        for (const auto& r : f.readers) {
+            poolSize += r.size();
+            if (!r.empty())
+                graphDef->mNumAliasedChannels++;
+        }
+        found.push_back(std::move(f));
+    }
+    if (found.empty())
+        return;
+
+    graphDef->mBusAliases = new BusAlias[numUnits] {};
+    graphDef->mBusAliasPool = new int32[poolSize];
+    int32* pool = graphDef->mBusAliasPool;
+    for (const Found& f : found) {
+        BusAlias* alias = graphDef->mBusAliases + f.unit;
+        alias->mNumChannels = (uint32)f.readers.size();
+        int32* channelStart = pool;
+        pool += f.readers.size() + 1;
+        int32* readers = pool;
+        int32 pairs = 0;
+        for (size_t c = 0; c < f.readers.size(); ++c) {
+            channelStart[c] = pairs;
+            pool = std::copy(f.readers[c].begin(), f.readers[c].end(), pool);
+            pairs += (int32)f.readers[c].size() / 2;
+        }
+        channelStart[f.readers.size()] = pairs;
+        alias->mChannelStart = channelStart;
+        alias->mReaders = readers;
+        alias->mNumGuards = (uint32)f.guards.size() / 3;
+        alias->mGuards = pool;
+        pool = std::copy(f.guards.begin(), f.guards.end(), pool);
+    }
+}
+
+// The controls fed straight into the buffer input of a unit that plays from
+// a buffer. Only direct wires count: a bufnum computed from a control is
+// not followed.
+static void GraphDef_FindBufferControls(GraphDef* graphDef) {
+    graphDef->mBufferControls = nullptr;
+    graphDef->mNumBufferControls = 0;
+    if (!InputsWellFormed(graphDef))
+        return;
+
+    static const struct {
+        const char* name;
+        uint32 input;
+    } kPlayers[] = {
+        { "PlayBuf", 0 }, { "BufRd", 0 }, { "SimpleLoopBuf", 0 },
+        { "TGrains", 1 }, { "GrainBuf", 2 }, { "Warp1", 0 },
+    };
+    std::vector<int32> controls;
+    const UnitSpec* specs = graphDef->mUnitSpecs;
+    for (uint32 j = 0; j < graphDef->mNumUnitSpecs; ++j) {
+        for (const auto& player : kPlayers) {
+            if (!UnitNameIs(specs + j, player.name) || player.input >= specs[j].mNumInputs)
+                continue;
+            const InputSpec* in = specs[j].mInputSpec + player.input;
+            if (in->mFromUnitIndex < 0)
+                break;
+            const UnitSpec* from = specs + in->mFromUnitIndex;
+            if (!UnitNameIs(from, "Control") && !UnitNameIs(from, "TrigControl")
+                && !UnitNameIs(from, "LagControl") && !UnitNameIs(from, "AudioControl"))
+                break;
+            const int32 index = from->mSpecialIndex + in->mFromOutputIndex;
+            if (index >= 0 && (uint32)index < graphDef->mNumControls
+                && std::find(controls.begin(), controls.end(), index) == controls.end())
+                controls.push_back(index);
+            break;
+        }
+    }
+    if (controls.empty())
+        return;
+    std::sort(controls.begin(), controls.end());
+    graphDef->mBufferControls = new int32[controls.size()];
+    std::copy(controls.begin(), controls.end(), graphDef->mBufferControls);
+    graphDef->mNumBufferControls = (uint32)controls.size();
+}
+#endif // SUPERSONIC
+
+
 /** \note Relevant supernova code: \c sc_synthdef::sc_synthdef() */
 GraphDef* GraphDef_Read(World* inWorld, const char*& buffer, const char* end, GraphDef* inList, int32 inVersion) {
     int32 name[kSCNodeDefNameLen];
@@ -364,6 +805,12 @@ GraphDef* GraphDef_Read(World* inWorld, const char*& buffer, const char* end, Gr
         graphDef->mNumWires += unitSpec->mNumOutputs;
     }
 
+#ifdef SUPERSONIC
+    GraphDef_Optimise(inWorld, graphDef.get());
+    GraphDef_FindBusAliases(graphDef.get());
+    GraphDef_FindBufferControls(graphDef.get());
+#endif
+
     DoBufferColoring(inWorld, graphDef.get());
 
     GraphDef_SetAllocSizes(graphDef.get());
@@ -599,6 +1046,12 @@ void GraphDef_Free(GraphDef* inGraphDef) {
     delete[] inGraphDef->mConstants;
     delete[] inGraphDef->mUnitSpecs;
     delete[] inGraphDef->mVariants;
+#ifdef SUPERSONIC
+    delete[] inGraphDef->mUnitIndexMap;
+    delete[] inGraphDef->mBusAliases;
+    delete[] inGraphDef->mBusAliasPool;
+    delete[] inGraphDef->mBufferControls;
+#endif
     delete inGraphDef;
 }
 
@@ -22,6 +22,7 @@
 
 #include "SC_SynthDef.h"
 #include "HashTable.h"
+#include <atomic>
 #include <filesystem>
 #include <string>
 
@@ -74,6 +75,34 @@ struct GraphDef {
 
     uint32 mNumVariants;
     struct GraphDef* mVariants;
+
+#ifdef SUPERSONIC
+    // [SUPERSONIC] Load-time optimisation (GraphDef_Optimise): unit counts as
+    // read from the synthdef, units folded into constants, and the map from
+    // the synthdef's unit indices to the surviving ones (-1 = removed) so
+    // /u_cmd keeps addressing units by their original index. The map is null
+    // when nothing was removed.
+    uint32 mNumUnitsRead;
+    uint32 mNumCalcUnitsRead;
+    uint32 mNumFolded;
+    int32* mUnitIndexMap;
+    // [SUPERSONIC] Zero-copy bus reads (GraphDef_FindBusAliases): one BusAlias
+    // per unit, pointing into mBusAliasPool, or null when no unit qualifies.
+    // mNumAliasedChannels counts output channels with in-place readers.
+    struct BusAlias* mBusAliases;
+    int32* mBusAliasPool;
+    uint32 mNumAliasedChannels;
+    // [SUPERSONIC] Constructor arena size for new instances (SC_Graph.cpp):
+    // what recent instances' unit constructors asked RTAlloc for, in
+    // 64-byte-rounded bytes. Rises to any larger demand at once and decays
+    // toward smaller ones. 0 until the first instance is constructed.
+    uint32 mArenaBytes;
+    // [SUPERSONIC] Controls wired straight into the buffer input of a unit
+    // that plays from a buffer (GraphDef_FindBufferControls), in control
+    // order, or null if none. SampleResidency reads /s_new against these.
+    int32* mBufferControls;
+    uint32 mNumBufferControls;
+#endif
 };
 
 GraphDef* GraphDef_Recv(World* inWorld, const char* buffer, size_t size, GraphDef* inList, std::string* outErrorMsg = nullptr);
@@ -86,4 +115,15 @@ SCErr GraphDef_Remove(World* inWorld, int32* inName);
 SCErr GraphDef_DeleteMsg(struct World* inWorld, GraphDef* inDef);
 void GraphDef_Dump(GraphDef* inGraphDef);
 int32 GetHash(ParamSpec* inParamSpec);
+#ifdef SUPERSONIC
+// [SUPERSONIC] Constant folding / dead-unit elimination at load. Enabled by
+// default; /d_optimise toggles it for defs received afterwards.
+extern std::atomic<bool> gGraphDefOptimise;
+// [SUPERSONIC] Per-node constructor arenas (SC_Graph.cpp). Enabled by
+// default; /d_arena toggles it for synths constructed afterwards.
+extern std::atomic<bool> gGraphArena;
+// Surviving unit index for a unit index as written in the synthdef, or -1 if
+// the unit was optimised away or the index is out of range.
+int32 GraphDef_UnitIndex(const GraphDef* inGraphDef, uint32 inOriginalIndex);
+#endif
 int32* GetKey(ParamSpec* inParamSpec);
@@ -111,6 +111,21 @@ struct HiddenWorld {
     uint32 mMaxWireBufs;
     float* mWireBufSpace;
 
+    // Runtime growth (SC_WorldResize.h): the current node limit and RT pool
+    // size, the ceilings the address-stable tables were reserved at, and
+    // resize stats (count, last swap time, bytes added).
+    uint32 mMaxNodes;
+    uint32 mRealTimeMemoryKB;
+    uint32 mMaxNodesCeiling;
+    uint32 mNumSndBufsCeiling;
+    uint32 mNumAudioBusChannelsCeiling;
+    uint32 mNumControlBusChannelsCeiling;
+    uint32 mMaxWireBufsCeiling;
+    uint32 mRealTimeMemoryCeilingKB;
+    uint32 mResizes;
+    uint32 mResizeApplyUs;
+    uint64 mResizeBytes;
+
     TriggersFifo mTriggers;
     NodeReplyFifo mNodeMsgs;
     NodeEndsFifo mNodeEnds;
@@ -188,10 +188,19 @@ void SC_NamedObj::SetName(const char* inName) {
 SC_LibCmd::SC_LibCmd(SC_CommandFunc inFunc): mFunc(inFunc) {}
 
 SCErr SC_LibCmd::Perform(struct World* inWorld, int inSize, char* inData, ReplyAddress* inReply) {
+#ifdef SUPERSONIC
+    return Perform(mFunc, inWorld, inSize, inData, inReply);
+}
+
+SCErr SC_LibCmd::Perform(SC_CommandFunc inFunc, struct World* inWorld, int inSize, char* inData,
+                         ReplyAddress* inReply) {
+#else
+    SC_CommandFunc inFunc = mFunc;
+#endif
     SCErr err;
     //	int kSendError = 1;		// i.e., 0x01 | 0x02;
     try {
-        err = (mFunc)(inWorld, inSize, inData, inReply);
+        err = (inFunc)(inWorld, inSize, inData, inReply);
     } catch (int iexc) {
         err = iexc;
         ss_log("ERROR: %s threw int exception: %d", (char*)Name(), iexc);
@@ -51,6 +51,9 @@ HashTable<struct BufGen, Malloc>* gBufGenLib = nullptr;
 HashTable<struct PlugInCmd, Malloc>* gPlugInCmds = nullptr;
 extern struct InterfaceTable gInterfaceTable;
 SC_LibCmd* gCmdArray[NUMBER_OF_COMMANDS];
+#ifdef SUPERSONIC
+SC_CommandFunc gPrecodedCmdArray[NUMBER_OF_COMMANDS];
+#endif
 
 void initMiscCommands();
 
@@ -32,6 +32,11 @@ public:
     SC_LibCmd(SC_CommandFunc inFunc);
 
     SCErr Perform(struct World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
+#ifdef SUPERSONIC
+    // [SUPERSONIC] Run inFunc under this command's name and error reporting
+    // (the precoded jump table's handlers, see PerformPrecodedCommand).
+    SCErr Perform(SC_CommandFunc inFunc, struct World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
+#endif
 
 private:
     SC_CommandFunc mFunc;
@@ -45,3 +50,8 @@ void deinitialize_library();
 SCErr NewCommand(const char* inPath, uint32 inCommandNumber, SC_CommandFunc inFunc);
 
 extern SC_LibCmd* gCmdArray[NUMBER_OF_COMMANDS];
+#ifdef SUPERSONIC
+// [SUPERSONIC] Handlers for pre-decoded command records (cmd_record.h), by
+// command number; null where only the OSC form exists.
+extern SC_CommandFunc gPrecodedCmdArray[NUMBER_OF_COMMANDS];
+#endif
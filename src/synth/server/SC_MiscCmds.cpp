@@ -35,6 +35,7 @@
 #include "SC_WorldOptions.h"
 #include "SC_Version.hpp"
 #include "../../SuperClock.h"
+#include "../../cmd_record.h"
 
 extern int gMissingNodeID;
 
@@ -850,36 +851,107 @@ SCErr meth_d_free(World* inWorld, int inSize, char* inData, ReplyAddress* inRepl
     return kSCErr_None;
 }
 
+#ifdef SUPERSONIC
+// [SUPERSONIC] /d_optimise [flag:i] — enable (1) or disable (0) load-time
+// constant folding and dead-unit elimination for synthdefs received from
+// now on; defs already loaded keep their form. With no argument it only
+// queries. Reply: /d_optimise.reply enabled:i
+SCErr meth_d_optimise(World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
+SCErr meth_d_optimise(World* inWorld, int inSize, char* inData, ReplyAddress* inReply) {
+    sc_msg_iter msg(inSize, inData);
+    if (msg.remain())
+        gGraphDefOptimise.store(msg.geti() != 0, std::memory_order_relaxed);
 
-// [SuperSonic] Declared in SC_Graph.cpp. Runs UGen constructors + zombie check
-// synchronously so /n_set (and siblings) later in the same bundle mutate the
-// post-init graph state instead of racing the constructors.
-bool Graph_InitUnits(Graph* inGraph);
+    small_scpacket packet;
+    packet.adds("/d_optimise.reply");
+    packet.maketags(2);
+    packet.addtag(',');
+    packet.addtag('i');
+    packet.addi(gGraphDefOptimise.load(std::memory_order_relaxed) ? 1 : 0);
+    CallSequencedCommand(SendReplyCmd, inWorld, packet.size(), packet.data(), inReply);
+    return kSCErr_None;
+}
 
-// 'argtype' is false for setn type args
-SCErr meth_s_do_new(World* inWorld, int inSize, char* inData, bool argtype) {
-    SCErr err;
+// [SUPERSONIC] /d_arena [flag:i] — enable (1) or disable (0) per-node
+// constructor arenas for synths constructed from now on; running synths keep
+// what they have. With no argument it only queries.
+// Reply: /d_arena.reply enabled:i
+SCErr meth_d_arena(World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
+SCErr meth_d_arena(World* inWorld, int inSize, char* inData, ReplyAddress* inReply) {
     sc_msg_iter msg(inSize, inData);
-    int32* defname = msg.gets4();
-    if (!defname)
-        return kSCErr_WrongArgType;
+    if (msg.remain())
+        gGraphArena.store(msg.geti() != 0, std::memory_order_relaxed);
 
-    int32 nodeID = msg.geti();
-    int32 addAction = msg.geti();
+    small_scpacket packet;
+    packet.adds("/d_arena.reply");
+    packet.maketags(2);
+    packet.addtag(',');
+    packet.addtag('i');
+    packet.addi(gGraphArena.load(std::memory_order_relaxed) ? 1 : 0);
+    CallSequencedCommand(SendReplyCmd, inWorld, packet.size(), packet.data(), inReply);
+    return kSCErr_None;
+}
 
-    GraphDef* def = World_GetGraphDef(inWorld, defname);
-    if (!def) {
-        ss_log("*** ERROR: SynthDef %s not found\n", (char*)defname);
-        return kSCErr_SynthDefNotFound;
+// [SUPERSONIC] /d_stats name... — what load-time optimisation did to each def.
+// Reply per def: /d_stats.reply name:s unitsRead:i units:i calcUnitsRead:i
+//                calcUnits:i folded:i aliasedChannels:i arenaBytes:i
+SCErr meth_d_stats(World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
+SCErr meth_d_stats(World* inWorld, int inSize, char* inData, ReplyAddress* inReply) {
+    sc_msg_iter msg(inSize, inData);
+    while (msg.remain()) {
+        int32* defname = msg.gets4();
+        if (!defname)
+            return kSCErr_SynthDefNotFound;
+        GraphDef* def = World_GetGraphDef(inWorld, defname);
+        if (!def)
+            return kSCErr_SynthDefNotFound;   // the dispatcher sends the /fail
+
+        small_scpacket packet;
+        packet.adds("/d_stats.reply");
+        packet.maketags(9);
+        packet.addtag(',');
+        packet.addtag('s');
+        packet.adds((char*)def->mNodeDef.mName);
+        packet.addtag('i');
+        packet.addi((int)def->mNumUnitsRead);
+        packet.addtag('i');
+        packet.addi((int)def->mNumUnitSpecs);
+        packet.addtag('i');
+        packet.addi((int)def->mNumCalcUnitsRead);
+        packet.addtag('i');
+        packet.addi((int)def->mNumCalcUnits);
+        packet.addtag('i');
+        packet.addi((int)def->mNumFolded);
+        packet.addtag('i');
+        packet.addi((int)def->mNumAliasedChannels);
+        packet.addtag('i');
+        packet.addi((int)def->mArenaBytes);
+        CallSequencedCommand(SendReplyCmd, inWorld, packet.size(), packet.data(), inReply);
     }
+    return kSCErr_None;
+}
+#endif
+
+
+// [SuperSonic] Declared in SC_Graph.cpp. Runs UGen constructors + zombie check
+// synchronously so /n_set (and siblings) later in the same bundle mutate the
+// post-init graph state instead of racing the constructors.
+bool Graph_InitUnits(Graph* inGraph);
 
+// [SUPERSONIC] The node-creation half of meth_s_do_new, shared with the
+// precoded /s_new. target is the already-resolved target node (null when not
+// found); the controls come from msg, or from the record when precoded is set.
+static SCErr Synth_AddNew(World* inWorld, GraphDef* def, int32 nodeID, int32 addAction, Node* target,
+                          sc_msg_iter* msg, bool argtype, const SsCmdView* precoded) {
+    SCErr err;
     Graph* graph = nullptr;
     switch (addAction) {
     case 0: {
-        Group* group = Msg_GetGroup(inWorld, msg);
+        Group* group = target && target->mIsGroup ? (Group*)target : nullptr;
         if (!group)
             return kSCErr_GroupNotFound;
-        err = Graph_New(inWorld, def, nodeID, &msg, &graph, argtype);
+        err = precoded ? Graph_NewPrecoded(inWorld, def, nodeID, *precoded, &graph)
+                       : Graph_New(inWorld, def, nodeID, msg, &graph, argtype);
         if (err)
             return err;
         if (!graph)
@@ -887,37 +959,41 @@ SCErr meth_s_do_new(World* inWorld, int inSize, char* inData, bool argtype) {
         Group_AddHead(group, &graph->mNode);
     } break;
     case 1: {
-        Group* group = Msg_GetGroup(inWorld, msg);
+        Group* group = target && target->mIsGroup ? (Group*)target : nullptr;
         if (!group)
             return kSCErr_GroupNotFound;
-        err = Graph_New(inWorld, def, nodeID, &msg, &graph, argtype);
+        err = precoded ? Graph_NewPrecoded(inWorld, def, nodeID, *precoded, &graph)
+                       : Graph_New(inWorld, def, nodeID, msg, &graph, argtype);
         if (err)
             return err;
         Group_AddTail(group, &graph->mNode);
     } break;
     case 2: {
-        Node* beforeThisNode = Msg_GetNode(inWorld, msg);
+        Node* beforeThisNode = target;
         if (!beforeThisNode)
             return kSCErr_NodeNotFound;
-        err = Graph_New(inWorld, def, nodeID, &msg, &graph, argtype);
+        err = precoded ? Graph_NewPrecoded(inWorld, def, nodeID, *precoded, &graph)
+                       : Graph_New(inWorld, def, nodeID, msg, &graph, argtype);
         if (err)
             return err;
         Node_AddBefore(&graph->mNode, beforeThisNode);
     } break;
     case 3: {
-        Node* afterThisNode = Msg_GetNode(inWorld, msg);
+        Node* afterThisNode = target;
         if (!afterThisNode)
             return kSCErr_NodeNotFound;
-        err = Graph_New(inWorld, def, nodeID, &msg, &graph, argtype);
+        err = precoded ? Graph_NewPrecoded(inWorld, def, nodeID, *precoded, &graph)
+                       : Graph_New(inWorld, def, nodeID, msg, &graph, argtype);
         if (err)
             return err;
         Node_AddAfter(&graph->mNode, afterThisNode);
     } break;
     case 4: {
-        Node* replaceThisNode = Msg_GetNode(inWorld, msg);
+        Node* replaceThisNode = target;
         if (!replaceThisNode)
             return kSCErr_NodeNotFound;
-        err = Graph_New(inWorld, def, nodeID, &msg, &graph, argtype);
+        err = precoded ? Graph_NewPrecoded(inWorld, def, nodeID, *precoded, &graph)
+                       : Graph_New(inWorld, def, nodeID, msg, &graph, argtype);
         if (err)
             return err;
         Node_Replace(&graph->mNode, replaceThisNode);
@@ -934,6 +1010,28 @@ SCErr meth_s_do_new(World* inWorld, int inSize, char* inData, bool argtype) {
     return kSCErr_None;
 }
 
+// 'argtype' is false for setn type args
+SCErr meth_s_do_new(World* inWorld, int inSize, char* inData, bool argtype) {
+    sc_msg_iter msg(inSize, inData);
+    int32* defname = msg.gets4();
+    if (!defname)
+        return kSCErr_WrongArgType;
+
+    int32 nodeID = msg.geti();
+    int32 addAction = msg.geti();
+
+    GraphDef* def = World_GetGraphDef(inWorld, defname);
+    if (!def) {
+        ss_log("*** ERROR: SynthDef %s not found\n", (char*)defname);
+        return kSCErr_SynthDefNotFound;
+    }
+    if (addAction < 0 || addAction > 4)
+        return kSCErr_Failed;
+
+    Node* target = Msg_GetNode(inWorld, msg);
+    return Synth_AddNew(inWorld, def, nodeID, addAction, target, &msg, argtype, nullptr);
+}
+
 SCErr meth_s_new(World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
 SCErr meth_s_new(World* inWorld, int inSize, char* inData, ReplyAddress*) {
     return meth_s_do_new(inWorld, inSize, inData, true);
@@ -944,101 +1042,112 @@ SCErr meth_s_newargs(World* inWorld, int inSize, char* inData, ReplyAddress*) {
     return meth_s_do_new(inWorld, inSize, inData, false);
 }
 
-SCErr meth_g_new(World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
-SCErr meth_g_new(World* inWorld, int inSize, char* inData, ReplyAddress* /*inReply*/) {
+// [SUPERSONIC] One group of meth_g_new, shared with the precoded /g_new.
+// target is the already-resolved target node (null when not found).
+static SCErr Group_AddNew(World* inWorld, int32 newGroupID, int32 addAction, Node* target) {
     SCErr err;
-
-    sc_msg_iter msg(inSize, inData);
-    while (msg.remain()) {
-        int32 newGroupID = msg.geti();
-        int32 addAction = msg.geti();
-
-        Group* newGroup = nullptr;
-        switch (addAction) {
-        case 0: {
-            Group* group = Msg_GetGroup(inWorld, msg);
-            if (!group)
-                return kSCErr_GroupNotFound;
-            err = Group_New(inWorld, newGroupID, &newGroup);
-            if (err) {
-                if (err == kSCErr_DuplicateNodeID) {
-                    newGroup = World_GetGroup(inWorld, newGroupID);
-                    if (!newGroup || !newGroup->mNode.mParent || newGroup->mNode.mParent != group)
-                        return err;
-                } else
+    Group* newGroup = nullptr;
+    switch (addAction) {
+    case 0: {
+        Group* group = target && target->mIsGroup ? (Group*)target : nullptr;
+        if (!group)
+            return kSCErr_GroupNotFound;
+        err = Group_New(inWorld, newGroupID, &newGroup);
+        if (err) {
+            if (err == kSCErr_DuplicateNodeID) {
+                newGroup = World_GetGroup(inWorld, newGroupID);
+                if (!newGroup || !newGroup->mNode.mParent || newGroup->mNode.mParent != group)
                     return err;
-            } else {
-                Group_AddHead(group, &newGroup->mNode);
-            }
-        } break;
-        case 1: {
-            Group* group = Msg_GetGroup(inWorld, msg);
-            if (!group)
-                return kSCErr_GroupNotFound;
-            err = Group_New(inWorld, newGroupID, &newGroup);
-            if (err) {
-                if (err == kSCErr_DuplicateNodeID) {
-                    newGroup = World_GetGroup(inWorld, newGroupID);
-                    if (!newGroup || !newGroup->mNode.mParent || newGroup->mNode.mParent != group)
-                        return err;
-                } else
+            } else
+                return err;
+        } else {
+            Group_AddHead(group, &newGroup->mNode);
+        }
+    } break;
+    case 1: {
+        Group* group = target && target->mIsGroup ? (Group*)target : nullptr;
+        if (!group)
+            return kSCErr_GroupNotFound;
+        err = Group_New(inWorld, newGroupID, &newGroup);
+        if (err) {
+            if (err == kSCErr_DuplicateNodeID) {
+                newGroup = World_GetGroup(inWorld, newGroupID);
+                if (!newGroup || !newGroup->mNode.mParent || newGroup->mNode.mParent != group)
                     return err;
-            } else {
-                Group_AddTail(group, &newGroup->mNode);
-            }
-        } break;
-        case 2: {
-            Node* beforeThisNode = Msg_GetNode(inWorld, msg);
-            if (!beforeThisNode)
-                return kSCErr_TargetNodeNotFound;
-            err = Group_New(inWorld, newGroupID, &newGroup);
-            if (err) {
-                if (err == kSCErr_DuplicateNodeID) {
-                    newGroup = World_GetGroup(inWorld, newGroupID);
-                    if (!newGroup || !newGroup->mNode.mParent
-                        || newGroup->mNode.mParent->mNode.mID != beforeThisNode->mParent->mNode.mID)
-                        return err;
-                } else
+            } else
+                return err;
+        } else {
+            Group_AddTail(group, &newGroup->mNode);
+        }
+    } break;
+    case 2: {
+        Node* beforeThisNode = target;
+        if (!beforeThisNode)
+            return kSCErr_TargetNodeNotFound;
+        err = Group_New(inWorld, newGroupID, &newGroup);
+        if (err) {
+            if (err == kSCErr_DuplicateNodeID) {
+                newGroup = World_GetGroup(inWorld, newGroupID);
+                if (!newGroup || !newGroup->mNode.mParent
+                    || newGroup->mNode.mParent->mNode.mID != beforeThisNode->mParent->mNode.mID)
                     return err;
-            } else {
-                Node_AddBefore(&newGroup->mNode, beforeThisNode);
-            }
-        } break;
-        case 3: {
-            Node* afterThisNode = Msg_GetNode(inWorld, msg);
-            if (!afterThisNode)
-                return kSCErr_TargetNodeNotFound;
-            err = Group_New(inWorld, newGroupID, &newGroup);
-            if (err) {
-                if (err == kSCErr_DuplicateNodeID) {
-                    newGroup = World_GetGroup(inWorld, newGroupID);
-                    if (!newGroup || !newGroup->mNode.mParent
-                        || newGroup->mNode.mParent->mNode.mID != afterThisNode->mParent->mNode.mID)
-                        return err;
-                } else
+            } else
+                return err;
+        } else {
+            Node_AddBefore(&newGroup->mNode, beforeThisNode);
+        }
+    } break;
+    case 3: {
+        Node* afterThisNode = target;
+        if (!afterThisNode)
+            return kSCErr_TargetNodeNotFound;
+        err = Group_New(inWorld, newGroupID, &newGroup);
+        if (err) {
+            if (err == kSCErr_DuplicateNodeID) {
+                newGroup = World_GetGroup(inWorld, newGroupID);
+                if (!newGroup || !newGroup->mNode.mParent
+                    || newGroup->mNode.mParent->mNode.mID != afterThisNode->mParent->mNode.mID)
                     return err;
-            } else {
-                Node_AddAfter(&newGroup->mNode, afterThisNode);
-            }
-        } break;
-        case 4: {
-            Node* replaceThisNode = Msg_GetNode(inWorld, msg);
-            if (!replaceThisNode)
-                return kSCErr_TargetNodeNotFound;
-            if (replaceThisNode->mID == 0)
-                return kSCErr_ReplaceRootGroup;
-            Node_RemoveID(replaceThisNode);
-
-            err = Group_New(inWorld, newGroupID, &newGroup);
-            if (err)
+            } else
                 return err;
-            Node_Replace(&newGroup->mNode, replaceThisNode);
-        } break;
-        default:
-            return kSCErr_Failed;
+        } else {
+            Node_AddAfter(&newGroup->mNode, afterThisNode);
         }
+    } break;
+    case 4: {
+        Node* replaceThisNode = target;
+        if (!replaceThisNode)
+            return kSCErr_TargetNodeNotFound;
+        if (replaceThisNode->mID == 0)
+            return kSCErr_ReplaceRootGroup;
+        Node_RemoveID(replaceThisNode);
 
-        Node_StateMsg(&newGroup->mNode, kNode_Go);
+        err = Group_New(inWorld, newGroupID, &newGroup);
+        if (err)
+            return err;
+        Node_Replace(&newGroup->mNode, replaceThisNode);
+    } break;
+    default:
+        return kSCErr_Failed;
+    }
+
+    Node_StateMsg(&newGroup->mNode, kNode_Go);
+    return kSCErr_None;
+}
+
+SCErr meth_g_new(World* inWorld, int inSize, char* inData, ReplyAddress* inReply);
+SCErr meth_g_new(World* inWorld, int inSize, char* inData, ReplyAddress* /*inReply*/) {
+    sc_msg_iter msg(inSize, inData);
+    while (msg.remain()) {
+        int32 newGroupID = msg.geti();
+        int32 addAction = msg.geti();
+        if (addAction < 0 || addAction > 4)
+            return kSCErr_Failed;
+
+        Node* target = Msg_GetNode(inWorld, msg);
+        SCErr err = Group_AddNew(inWorld, newGroupID, addAction, target);
+        if (err)
+            return err;
     }
 
     return kSCErr_None;
@@ -1463,6 +1572,7 @@ SCErr meth_b_set(World* inWorld, int inSize, char* inData, ReplyAddress* /*inRep
     SndBuf* buf = World_GetBuf(inWorld, bufindex);
     if (!buf)
         return kSCErr_Failed;
+    LOCK_SNDBUF(buf);
 
     float* data = buf->data;
     uint32 numSamples = buf->samples;
@@ -1485,6 +1595,7 @@ SCErr meth_b_setn(World* inWorld, int inSize, char* inData, ReplyAddress* /*inRe
     SndBuf* buf = World_GetBuf(inWorld, bufindex);
     if (!buf)
         return kSCErr_Failed;
+    LOCK_SNDBUF(buf);
 
     float* data = buf->data;
     int numSamples = buf->samples;
@@ -1517,6 +1628,7 @@ SCErr meth_b_fill(World* inWorld, int inSize, char* inData, ReplyAddress* /*inRe
     SndBuf* buf = World_GetBuf(inWorld, bufindex);
     if (!buf)
         return kSCErr_Failed;
+    LOCK_SNDBUF(buf);
 
     float* data = buf->data;
     int numSamples = buf->samples;
@@ -1969,6 +2081,120 @@ SCErr meth_error(World* inWorld, int inSize, char* inData, ReplyAddress* /*inRep
     return kSCErr_None;
 }
 
+#ifdef SUPERSONIC
+// =============================================================================
+// [SUPERSONIC] Precoded hot commands (cmd_record.h).
+// A producer decoded these before they reached the IN ring; inData is the
+// record (bounds-checked by ss_cmd_view before dispatch), not OSC arguments.
+// Each handler is its meth_* twin run over the record's entries — the same
+// calls and the same errors, reported under the twin's name by
+// PerformPrecodedCommand — minus the tag walk and the name hashing.
+// =============================================================================
+
+static Node* Precoded_GetNode(World* inWorld, int32 nodeID) {
+    gMissingNodeID = nodeID;
+    return World_GetNode(inWorld, nodeID);
+}
+
+static void Node_SetPrecodedControls(Node* node, const SsCmdView& cmd) {
+    for (uint32 n = 0; n < cmd.rec->count; ++n) {
+        const SsCmdEntry& e = cmd.entries[n];
+        int32* name = e.nameOff ? (int32*)(cmd.osc + e.nameOff) : nullptr;
+        switch (e.op) {
+        case kSsCmdSet:
+            if (name)
+                Node_SetControl(node, e.key, name, e.aux, e.value.f);
+            else
+                Node_SetControl(node, e.key + e.aux, e.value.f);
+            break;
+        case kSsCmdMapControl:
+            if (name)
+                Node_MapControl(node, e.key, name, e.aux, e.value.i);
+            else
+                Node_MapControl(node, e.key + e.aux, e.value.i);
+            break;
+        case kSsCmdMapAudio:
+            if (name)
+                Node_MapAudioControl(node, e.key, name, e.aux, e.value.i);
+            else
+                Node_MapAudioControl(node, e.key + e.aux, e.value.i);
+            break;
+        }
+    }
+}
+
+static SCErr meth_s_new_precoded(World* inWorld, int /*inSize*/, char* inData, ReplyAddress* /*inReply*/) {
+    const SsCmdView cmd = ss_cmd_view_checked(inData);
+    int32* defname = (int32*)(cmd.osc + cmd.rec->nameOff);
+    GraphDef* def = World_GetGraphDef(inWorld, cmd.rec->nameHash, defname);
+    if (!def) {
+        ss_log("*** ERROR: SynthDef %s not found\n", (char*)defname);
+        return kSCErr_SynthDefNotFound;
+    }
+    if (cmd.rec->addAction < 0 || cmd.rec->addAction > 4)
+        return kSCErr_Failed;
+
+    Node* target = Precoded_GetNode(inWorld, cmd.rec->target);
+    return Synth_AddNew(inWorld, def, cmd.rec->node, cmd.rec->addAction, target, nullptr, true, &cmd);
+}
+
+// /n_set and /n_map: the entries carry their op (n_map's are all map-control).
+static SCErr meth_n_set_precoded(World* inWorld, int /*inSize*/, char* inData, ReplyAddress* /*inReply*/) {
+    const SsCmdView cmd = ss_cmd_view_checked(inData);
+    Node* node = Precoded_GetNode(inWorld, cmd.rec->node);
+    if (!node)
+        return kSCErr_NodeNotFound;
+    Node_SetPrecodedControls(node, cmd);
+    return kSCErr_None;
+}
+
+static SCErr meth_n_free_precoded(World* inWorld, int /*inSize*/, char* inData, ReplyAddress* /*inReply*/) {
+    const SsCmdView cmd = ss_cmd_view_checked(inData);
+    for (uint32 n = 0; n < cmd.rec->count; ++n) {
+        Node* node = Precoded_GetNode(inWorld, cmd.entries[n].key);
+        if (!node)
+            return kSCErr_NodeNotFound;
+
+        Node_Delete(node);
+    }
+    return kSCErr_None;
+}
+
+static SCErr meth_g_new_precoded(World* inWorld, int /*inSize*/, char* inData, ReplyAddress* /*inReply*/) {
+    const SsCmdView cmd = ss_cmd_view_checked(inData);
+    for (uint32 n = 0; n < cmd.rec->count; ++n) {
+        const SsCmdEntry& e = cmd.entries[n];
+        if (e.aux > 4)
+            return kSCErr_Failed;
+        Node* target = Precoded_GetNode(inWorld, e.value.i);
+        SCErr err = Group_AddNew(inWorld, e.key, e.aux, target);
+        if (err)
+            return err;
+    }
+    return kSCErr_None;
+}
+
+static SCErr meth_c_set_precoded(World* inWorld, int /*inSize*/, char* inData, ReplyAddress* /*inReply*/) {
+    const SsCmdView cmd = ss_cmd_view_checked(inData);
+    float* data = inWorld->mControlBus;
+    int32* touched = inWorld->mControlBusTouched;
+    int32 bufCounter = inWorld->mBufCounter;
+    uint32 maxIndex = inWorld->mNumControlBusChannels;
+
+    for (uint32 n = 0; n < cmd.rec->count; ++n) {
+        uint32 index = cmd.entries[n].key;
+        if (index < maxIndex) {
+            data[index] = cmd.entries[n].value.f;
+            touched[index] = bufCounter;
+        } else
+            return kSCErr_IndexOutOfRange;
+    }
+    return kSCErr_None;
+}
+
+#define NEW_PRECODED(name, func) gPrecodedCmdArray[cmd_##name] = func
+#endif
+
 #define NEW_COMMAND(name) NewCommand(#name, cmd_##name, meth_##name)
 
 void initMiscCommands();
@@ -1984,6 +2210,16 @@ void initMiscCommands() {
 
 #ifdef SUPERSONIC
     NEW_COMMAND(superclock_get);
+    NEW_COMMAND(d_optimise);
+    NEW_COMMAND(d_stats);
+    NEW_COMMAND(d_arena);
+
+    NEW_PRECODED(s_new, meth_s_new_precoded);
+    NEW_PRECODED(n_set, meth_n_set_precoded);
+    NEW_PRECODED(n_map, meth_n_set_precoded);
+    NEW_PRECODED(n_free, meth_n_free_precoded);
+    NEW_PRECODED(g_new, meth_g_new_precoded);
+    NEW_PRECODED(c_set, meth_c_set_precoded);
 #endif
 
     NEW_COMMAND(d_recv);
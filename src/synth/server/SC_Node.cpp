@@ -42,6 +42,12 @@ extern "C" {
     extern uint8_t* shared_memory;
 }
 #include "../../node_tree.h"
+#include "../../usdt.h"
+#include <atomic>
+
+static std::atomic<const NodeWatch*> gNodeWatch{nullptr};
+
+void Node_SetWatch(const NodeWatch* watch) { gNodeWatch.store(watch, std::memory_order_release); }
 // =============================================================================
 // SUPERSONIC MODIFICATION END
 // =============================================================================
@@ -403,6 +409,11 @@ void Node_StateMsg(Node* inNode, int inState) {
     // - But we want ALL nodes in the SAB tree for real-time visualization
     // - The SAB tree is polled locally, so there's no network overhead concern
     // =========================================================================
+    // Node lifecycle tracepoints (usdt.h), for every node including negative IDs.
+    if (inState == kNode_Go)
+        SS_PROBE2(node_create, inNode->mID, inNode->mIsGroup);
+    else if (inState == kNode_End)
+        SS_PROBE1(node_free, inNode->mID);
     if (shared_memory) {
         uint8_t* node_tree_ptr = shared_memory + NODE_TREE_START;
         NodeTreeHeader* tree_header = reinterpret_cast<NodeTreeHeader*>(node_tree_ptr);
@@ -421,6 +432,11 @@ void Node_StateMsg(Node* inNode, int inState) {
             // kNode_On, kNode_Off, kNode_Info don't affect tree structure
         }
     }
+    // Synths starting and ending, for the native engine's sample residency.
+    if (!inNode->mIsGroup && (inState == kNode_Go || inState == kNode_End)) {
+        if (const NodeWatch* watch = gNodeWatch.load(std::memory_order_acquire))
+            watch->fn(watch->ctx, reinterpret_cast<Graph*>(inNode), inState);
+    }
     // =========================================================================
     // SUPERSONIC MODIFICATION END
     // =========================================================================
@@ -91,6 +91,10 @@ int32 GetHash(struct GraphDef* inGraphDef);
 void World_AddGraphDef(struct World* inWorld, struct GraphDef* inGraphDef);
 void World_RemoveGraphDef(struct World* inWorld, struct GraphDef* inGraphDef);
 struct GraphDef* World_GetGraphDef(struct World* inWorld, int32* inKey);
+#ifdef SUPERSONIC
+// Lookup with the name's hash already computed (precoded /s_new).
+struct GraphDef* World_GetGraphDef(struct World* inWorld, int32 inHash, int32* inKey);
+#endif
 void World_FreeAllGraphDefs(World* inWorld);
 void GraphDef_Free(GraphDef* inGraphDef);
 void GraphDef_Define(World* inWorld, GraphDef* inList);
@@ -121,6 +125,16 @@ void Graph_MapControl(Graph* inGraph, int32 inHash, int32* inName, uint32 inInde
 void Graph_MapAudioControl(Graph* inGraph, uint32 inIndex, uint32 inBus);
 void Graph_MapAudioControl(Graph* inGraph, int32 inHash, int32* inName, uint32 inIndex, uint32 inBus);
 void Graph_Trace(Graph* inGraph);
+#ifdef SUPERSONIC
+// Plugin RTAlloc/RTRealloc/RTFree: per-node constructor arenas (SC_Graph.cpp).
+void* Graph_ArenaAlloc(World* inWorld, size_t inByteSize);
+void* Graph_ArenaRealloc(World* inWorld, void* inPtr, size_t inByteSize);
+void Graph_ArenaFree(World* inWorld, void* inPtr);
+// Graph_New for a precoded /s_new (cmd_record.h): controls come from the
+// record's entries instead of an sc_msg_iter.
+int Graph_NewPrecoded(World* inWorld, GraphDef* def, int32 inID, const struct SsCmdView& inCmd,
+                      Graph** outGraph);
+#endif
 
 ////////////////////////////////////////////////////////////////////////
 
@@ -142,6 +156,16 @@ void Node_StateMsg(Node* inNode, int inState);
 void Node_Trace(Node* inNode);
 void Node_SendReply(Node* inNode, int replyID, const char* cmdName, int numArgs, const float* values);
 void Node_SendReply(Node* inNode, int replyID, const char* cmdName, float value);
+#ifdef SUPERSONIC
+// [SUPERSONIC] One process-wide watcher of synths starting (kNode_Go) and
+// ending (kNode_End), called from Node_StateMsg on the audio thread.
+// SampleResidency counts the synths holding each registered buffer with it.
+struct NodeWatch {
+    void (*fn)(void* ctx, struct Graph* graph, int state) = nullptr;
+    void* ctx = nullptr;
+};
+void Node_SetWatch(const NodeWatch* watch);
+#endif
 
 extern "C" {
 void Node_SetRun(Node* inNode, int inRun);
@@ -186,6 +186,9 @@ void SC_SequencedCommand::CallEveryStage() {
             break;
         mNextStage++;
     case 2:
+#ifdef SUPERSONIC
+        HoldBuffer();
+#endif
         if (!Stage2())
             break;
         mNextStage++;
@@ -223,10 +226,16 @@ void SC_SequencedCommand::CallNextStage() {
         sendAgain = Stage1(); // RT
         break;
     case 2:
+#ifdef SUPERSONIC
+        HoldBuffer();
+#endif
         sendAgain = Stage2(); // NRT
         break;
     case 3:
         sendAgain = Stage3(); // RT
+#ifdef SUPERSONIC
+        ReleaseBuffer();
+#endif
         break;
     case 4:
         Stage4(); // NRT
@@ -260,10 +269,34 @@ void SC_SequencedCommand::CallNextStage() {
 }
 
 void SC_SequencedCommand::Delete() {
+#ifdef SUPERSONIC
+    ReleaseBuffer();
+#endif
     CallDestructor();
     World_Free(mWorld, this);
 }
 
+#ifdef SUPERSONIC
+// NRT thread. The audio thread only claims kSndBufMoving when busy is 0, and
+// holds it for a few stores between blocks, so the wait is short.
+void SC_SequencedCommand::HoldBuffer() {
+    const int index = HeldBuffer();
+    if (index < 0 || mHeld || !mWorld->mNumSndBufs)
+        return;
+    mHeld = mWorld->mSndBufUpdates + (uint32(index) < mWorld->mNumSndBufs ? index : 0);
+    uint32_t prev = mHeld->busy.fetch_add(1);
+    while (prev & kSndBufMoving)
+        prev = mHeld->busy.load();
+}
+
+void SC_SequencedCommand::ReleaseBuffer() {
+    if (mHeld) {
+        mHeld->busy.fetch_sub(1, std::memory_order_release);
+        mHeld = nullptr;
+    }
+}
+#endif
+
 bool SC_SequencedCommand::Stage1() { return true; }
 
 bool SC_SequencedCommand::Stage2() { return false; }
@@ -1749,8 +1782,17 @@ AsyncUnitCmd::AsyncUnitCmd(
 }
 
 AsyncUnitCmd::~AsyncUnitCmd() {
+#ifdef SUPERSONIC
+    // [SUPERSONIC] The real-time stages run with the node as mArenaGraph, as
+    // Unit_RunCommand does, so RTFree/RTRealloc recognise its arena memory.
+    Graph* prevArenaGraph = mWorld->mArenaGraph;
+    mWorld->mArenaGraph = mUnit->mParent;
+#endif
     if (mCleanup)
         mCleanup(mWorld, mCmdData);
+#ifdef SUPERSONIC
+    mWorld->mArenaGraph = prevArenaGraph;
+#endif
     // finally release the owning Graph
     Graph_Release(mUnit->mParent);
 }
@@ -1767,7 +1809,14 @@ bool AsyncUnitCmd::Stage3() {
     // nullptr as the Unit pointer so that the stage function can detect and properly
     // handle the situation. For example, it may still have to release resources on stage4.
     mAlive = Graph_HasParent(mUnit->mParent);
+#ifdef SUPERSONIC
+    Graph* prevArenaGraph = mWorld->mArenaGraph;
+    mWorld->mArenaGraph = mUnit->mParent;
+#endif
     bool result = !mStage3 || (mStage3)(mAlive ? mUnit : nullptr, mCmdData, &mReplyAddress);
+#ifdef SUPERSONIC
+    mWorld->mArenaGraph = prevArenaGraph;
+#endif
     // Only send completition message if the Graph is still alive!
     if (result && mAlive)
         SEND_COMPLETION_MSG;
@@ -88,6 +88,17 @@ protected:
     int mMsgSize;
     char* mMsgData;
 
+#ifdef SUPERSONIC
+    // [SUPERSONIC] The buffer a /b_ command changes or reads on the NRT
+    // thread, or -1. It is held busy (SndBufUpdates::busy) from just before
+    // Stage2 until Stage3 has published it, or the command is deleted, so
+    // SampleLoader does not move or drop the data under it meanwhile.
+    virtual int HeldBuffer() const { return -1; }
+    void HoldBuffer();
+    void ReleaseBuffer();
+    SndBufUpdates* mHeld = nullptr;
+#endif
+
     virtual void CallDestructor() = 0;
 };
 
@@ -123,6 +134,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     BufGen* mBufGen;
     sc_msg_iter mMsg;
     char* mData;
@@ -147,6 +161,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     SndBuf mSndBuf;
     int mNumChannels, mNumFrames;
     float* mFreeData;
@@ -169,6 +186,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     float* mFreeData;
 
     virtual void CallDestructor();
@@ -210,6 +230,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
 
     virtual void CallDestructor();
 };
@@ -229,6 +252,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     float* mFreeData;
     SndBuf mSndBuf;
     char* mFilename;
@@ -252,6 +278,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     char* mFilename;
     int mFileOffset, mNumFrames, mBufOffset;
     bool mLeaveFileOpen;
@@ -293,6 +322,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     float* mFreeData;
     SndBuf mSndBuf;
     char* mFilename;
@@ -315,6 +347,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     char* mFilename;
     int mFileOffset, mNumFrames, mBufOffset;
     bool mLeaveFileOpen;
@@ -337,6 +372,9 @@ public:
 
 protected:
     int mBufIndex;
+#ifdef SUPERSONIC
+    int HeldBuffer() const override { return mBufIndex; }
+#endif
     char* mFilename;
 #ifndef NO_LIBSNDFILE
     SF_INFO mFileInfo;
@@ -15,6 +15,7 @@
 #include "SC_Lib_Cintf.h"
 #include "SC_OSC_Commands.h"
 #include "sc_msg_iter.h"
+#include "../../cmd_record.h"
 #include <stdint.h>
 #include <cstddef>
 #include <cstring>
@@ -185,6 +186,24 @@ int PerformOSCMessage(World* inWorld, int inSize, char* inData, ReplyAddress* in
     return err;
 }
 
+// [SUPERSONIC] Perform a pre-decoded command record (cmd_record.h) through the
+// precoded jump table, under the command's own name and error reporting.
+// The record carries its original message, so a command without a precoded
+// handler — and every command while /dumpOSC is on — goes through
+// PerformOSCMessage instead.
+int PerformPrecodedCommand(World* inWorld, const SsCmdView& inCmd, ReplyAddress* inReply) {
+    if (!inWorld || !gCmdLib)
+        return kSCErr_Failed;
+    const uint32 index = inCmd.rec->cmd;
+    SC_CommandFunc func = index < NUMBER_OF_COMMANDS ? gPrecodedCmdArray[index] : nullptr;
+    SC_LibCmd* cmdObj = index < NUMBER_OF_COMMANDS ? gCmdArray[index] : nullptr;
+    if (!func || !cmdObj || inWorld->mDumpOSC)
+        return PerformOSCMessage(inWorld, static_cast<int>(inCmd.oscLen), const_cast<char*>(inCmd.osc),
+                                 inReply);
+    return cmdObj->Perform(func, inWorld, static_cast<int>(inCmd.size),
+                           reinterpret_cast<char*>(const_cast<SsCmdRecord*>(inCmd.rec)), inReply);
+}
+
 // Maximum bundle nesting depth - prevents stack overflow from malicious packets
 static constexpr int MAX_BUNDLE_DEPTH = 8;
 
@@ -24,6 +24,7 @@
 #include "SC_Endian.h" // first to avoid win32 IN clash
 
 #include "SC_Graph.h"
+#include "SC_GraphDef.h"
 #include "SC_InterfaceTable.h"
 #include "SC_Lib_Cintf.h"
 #include "SC_Prototypes.h"
@@ -130,6 +131,14 @@ SCErr Unit_DoCmd(World* inWorld, int inSize, const char* inData, ReplyAddress* i
         return kSCErr_NodeNotFound;
 
     uint32 unitID = msg.geti();
+#ifdef SUPERSONIC
+    // [SUPERSONIC] The unit index is as written in the synthdef; map it past
+    // any units removed at load (GraphDef_Optimise).
+    int32 unitIndex = GraphDef_UnitIndex((GraphDef*)graph->mNode.mDef, unitID);
+    if (unitIndex < 0)
+        return kSCErr_IndexOutOfRange;
+    unitID = (uint32)unitIndex;
+#endif
     if (unitID >= graph->mNumUnits)
         return kSCErr_IndexOutOfRange;
 
@@ -159,11 +168,21 @@ SCErr Unit_DoCmd(World* inWorld, int inSize, const char* inData, ReplyAddress* i
 }
 
 void Unit_RunCommand(const UnitCmd* cmd, Unit* unit, sc_msg_iter* msg, ReplyAddress* inReplyAddr) {
+#ifdef SUPERSONIC
+    // [SUPERSONIC] RTFree from the command must recognise the node's arena
+    // memory (per-node constructor arenas, SC_Graph.cpp).
+    World* world = unit->mWorld;
+    Graph* prevArenaGraph = world->mArenaGraph;
+    world->mArenaGraph = unit->mParent;
+#endif
     if (cmd->mHasFuncEx) {
         cmd->mFuncEx(unit, msg, inReplyAddr);
     } else {
         cmd->mFunc(unit, msg);
     }
+#ifdef SUPERSONIC
+    world->mArenaGraph = prevArenaGraph;
+#endif
 }
 
 int PlugIn_DoCmd(World* inWorld, int inSize, char* inData, ReplyAddress* inReply) {
@@ -49,6 +49,7 @@
 #include "../../common/Samp.hpp"
 #include "../../common/SC_fftlib.hpp"
 #include "SC_StringParser.h"
+#include "SC_WorldResize.h"
 
 #ifdef SUPERSONIC
 // Called explicitly in World_New to guarantee tables are populated
@@ -155,6 +156,22 @@ static void* supersonic_rt_pool_area_alloc(size_t size) {
     return supersonic::mem::alloc(supersonic::mem::Tier::Bulk, size); // growth -> PSRAM
 }
 static void supersonic_rt_pool_area_free(void* ptr) { supersonic::mem::free(ptr); }
+
+// World_ApplyResize (SC_WorldResize.cpp): add an area allocated off the audio
+// thread to the RT pool. The area callback hands the pending block straight
+// back, so nothing is allocated here. Audio thread.
+bool World_AddRealTimeArea(World* inWorld, void* inArea, size_t inBytes) {
+    g_rt_pool_pending = inArea;
+    const bool added = inWorld->hw->mAllocPool->AddArea(inBytes);
+    g_rt_pool_pending = nullptr;
+    return added;
+}
+
+// Undo World_AddRealTimeArea while nothing has been allocated from the area
+// yet; the caller gets its memory back. Audio thread.
+bool World_RemoveRealTimeArea(World* inWorld, void* inArea) {
+    return inWorld->hw->mAllocPool->RemoveArea(inArea);
+}
 #endif
 
 void* sc_dbg_malloc(size_t size, const char* tag, int line) {
@@ -286,9 +303,15 @@ void InterfaceTable_Init() {
     ft->fNRTRealloc = &realloc;
     ft->fNRTFree = &free;
 
+#ifdef SUPERSONIC
+    ft->fRTAlloc = &Graph_ArenaAlloc;
+    ft->fRTRealloc = &Graph_ArenaRealloc;
+    ft->fRTFree = &Graph_ArenaFree;
+#else
     ft->fRTAlloc = &World_Alloc;
     ft->fRTRealloc = &World_Realloc;
     ft->fRTFree = &World_Free;
+#endif
 
     ft->fNodeRun = &Node_SetRun;
 
@@ -462,6 +485,10 @@ World* World_New(WorldOptions* inOptions) {
         HiddenWorld* hw = world->hw;
         hw->mGraphDefLib = new HashTable<struct GraphDef, Malloc>(&gMalloc, inOptions->mMaxGraphDefs, false);
         hw->mNodeLib = new IntHashTable<Node, AllocPool>(hw->mAllocPool, inOptions->mMaxNodes, false);
+        hw->mMaxNodes = inOptions->mMaxNodes;
+        hw->mRealTimeMemoryKB = inOptions->mRealTimeMemorySize;
+        hw->mMaxNodesCeiling = World_GrowthCeiling(inOptions->mMaxNodes);
+        hw->mRealTimeMemoryCeilingKB = World_GrowthCeiling(inOptions->mRealTimeMemorySize);
         hw->mUsers = new Clients();
         hw->mMaxUsers = inOptions->mMaxLogins;
         hw->mAvailableClientIDs = new ClientIDs();
@@ -504,24 +531,38 @@ World* World_New(WorldOptions* inOptions) {
             hw->mShmem = nullptr;
         }
 #endif
+        // Buses, their touched stamps and the SndBuf tables are reserved up to
+        // their growth ceilings: units cache pointers into them, so
+        // World_ApplyResize grows them in place rather than moving them.
         // Control busses are process-local on every runtime (not observed
-        // cross-process), so they are heap-allocated rather than placed in the
+        // cross-process), so they are allocated here rather than placed in the
         // shm arena.
-        world->mControlBus = (float*)zalloc(world->mNumControlBusChannels, sizeof(float));
+        hw->mNumAudioBusChannelsCeiling = World_GrowthCeiling(world->mNumAudioBusChannels);
+        hw->mNumControlBusChannelsCeiling = World_GrowthCeiling(world->mNumControlBusChannels);
+        hw->mNumSndBufsCeiling = World_GrowthCeiling(inOptions->mNumBuffers);
+
+        world->mControlBus = (float*)World_ReserveTable(hw->mNumControlBusChannelsCeiling * sizeof(float),
+                                                        world->mNumControlBusChannels * sizeof(float));
 
         world->mNumSharedControls = 0;
         world->mSharedControls = inOptions->mSharedControls;
 
-        int numsamples = world->mBufLength * world->mNumAudioBusChannels;
-        world->mAudioBus = (float*)zalloc(numsamples, sizeof(float));
+        const size_t busBytes = (size_t)world->mBufLength * sizeof(float);
+        world->mAudioBus = (float*)World_ReserveTable(hw->mNumAudioBusChannelsCeiling * busBytes,
+                                                      world->mNumAudioBusChannels * busBytes);
 
-        world->mAudioBusTouched = (int32*)zalloc(inOptions->mNumAudioBusChannels, sizeof(int32));
-        world->mControlBusTouched = (int32*)zalloc(inOptions->mNumControlBusChannels, sizeof(int32));
+        world->mAudioBusTouched = (int32*)World_ReserveTable(hw->mNumAudioBusChannelsCeiling * sizeof(int32),
+                                                             world->mNumAudioBusChannels * sizeof(int32));
+        world->mControlBusTouched = (int32*)World_ReserveTable(
+            hw->mNumControlBusChannelsCeiling * sizeof(int32), world->mNumControlBusChannels * sizeof(int32));
 
         world->mNumSndBufs = inOptions->mNumBuffers;
-        world->mSndBufs = (SndBuf*)zalloc(world->mNumSndBufs, sizeof(SndBuf));
-        world->mSndBufsNonRealTimeMirror = (SndBuf*)zalloc(world->mNumSndBufs, sizeof(SndBuf));
-        world->mSndBufUpdates = (SndBufUpdates*)zalloc(world->mNumSndBufs, sizeof(SndBufUpdates));
+        world->mSndBufs = (SndBuf*)World_ReserveTable(hw->mNumSndBufsCeiling * sizeof(SndBuf),
+                                                      world->mNumSndBufs * sizeof(SndBuf));
+        world->mSndBufsNonRealTimeMirror = (SndBuf*)World_ReserveTable(hw->mNumSndBufsCeiling * sizeof(SndBuf),
+                                                                       world->mNumSndBufs * sizeof(SndBuf));
+        world->mSndBufUpdates = (SndBufUpdates*)World_ReserveTable(
+            hw->mNumSndBufsCeiling * sizeof(SndBufUpdates), world->mNumSndBufs * sizeof(SndBufUpdates));
 
         GroupNodeDef_Init();
 
@@ -994,6 +1035,12 @@ void World_FreeAllGraphDefs(World* inWorld) {
 
 GraphDef* World_GetGraphDef(World* inWorld, int32* inKey) { return inWorld->hw->mGraphDefLib->Get(inKey); }
 
+#ifdef SUPERSONIC
+GraphDef* World_GetGraphDef(World* inWorld, int32 inHash, int32* inKey) {
+    return inWorld->hw->mGraphDefLib->Get(inHash, inKey);
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int32* GetKey(UnitDef* inUnitDef) { return inUnitDef->mUnitDefName; }
@@ -1097,7 +1144,11 @@ void World_Start(World* inWorld) {
     for (uint32 i = 0; i < inWorld->mNumControlBusChannels; ++i)
         inWorld->mControlBusTouched[i] = -1;
 
-    inWorld->hw->mWireBufSpace = (float*)malloc_alig(inWorld->hw->mMaxWireBufs * inWorld->mBufLength * sizeof(float));
+    // Reserved up to the growth ceiling like the buses: graph wires point into it.
+    HiddenWorld* hw = inWorld->hw;
+    const size_t wireBytes = (size_t)inWorld->mBufLength * sizeof(float);
+    hw->mMaxWireBufsCeiling = World_GrowthCeiling(hw->mMaxWireBufs);
+    hw->mWireBufSpace = (float*)World_ReserveTable(hw->mMaxWireBufsCeiling * wireBytes, hw->mMaxWireBufs * wireBytes);
 
     inWorld->hw->mTriggers.MakeEmpty();
     inWorld->hw->mNodeMsgs.MakeEmpty();
@@ -1132,7 +1183,7 @@ void World_Cleanup(World* world, bool unload_plugins) {
     if (world->mDriverLock)
         reinterpret_cast<SC_Lock*>(world->mDriverLock)->lock();
     if (hw) {
-        sc_free(hw->mWireBufSpace);
+        World_ReleaseTable(hw->mWireBufSpace, hw->mMaxWireBufsCeiling * (size_t)world->mBufLength * sizeof(float));
         delete hw->mAudioDriver;
         hw->mAudioDriver = nullptr;
     }
@@ -1161,20 +1212,22 @@ void World_Cleanup(World* world, bool unload_plugins) {
 #endif
     }
 
-    free_alig(world->mSndBufsNonRealTimeMirror);
-    free_alig(world->mSndBufs);
-
-    free_alig(world->mControlBusTouched);
-    free_alig(world->mAudioBusTouched);
+    if (hw) {
+        World_ReleaseTable(world->mSndBufUpdates, hw->mNumSndBufsCeiling * sizeof(SndBufUpdates));
+        World_ReleaseTable(world->mSndBufsNonRealTimeMirror, hw->mNumSndBufsCeiling * sizeof(SndBuf));
+        World_ReleaseTable(world->mSndBufs, hw->mNumSndBufsCeiling * sizeof(SndBuf));
+
+        World_ReleaseTable(world->mControlBusTouched, hw->mNumControlBusChannelsCeiling * sizeof(int32));
+        World_ReleaseTable(world->mAudioBusTouched, hw->mNumAudioBusChannelsCeiling * sizeof(int32));
+        World_ReleaseTable(world->mControlBus, hw->mNumControlBusChannelsCeiling * sizeof(float));
+        World_ReleaseTable(world->mAudioBus,
+                           hw->mNumAudioBusChannelsCeiling * (size_t)world->mBufLength * sizeof(float));
+    }
 #ifndef SC_LEAN_TARGET
-    if (hw->mShmem) {
-        if (hw->mOwnsShmem)
-            delete hw->mShmem;
-        // else: caller owns it — don't delete (survives cold swap)
-    } else
+    // Caller-owned shared memory survives the World (cold swap).
+    if (hw && hw->mShmem && hw->mOwnsShmem)
+        delete hw->mShmem;
 #endif
-        free_alig(world->mControlBus);
-    free_alig(world->mAudioBus);
     delete[] world->mRGen;
     if (hw) {
 #ifndef NO_LIBSNDFILE
@@ -1335,6 +1388,25 @@ extern "C" void World_UpdateNativeStats(World* inWorld) {
         ->store(bufCount, std::memory_order_relaxed);
     reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_BUFFER_BYTES)
         ->store(static_cast<uint32_t>(bufBytes), std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_CONVERGED_UNITS)
+        ->store(inWorld->mNumConvergedUnits, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_FFT_TRANSFORMS)
+        ->store(inWorld->mFFTTransforms, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_FFT_BLOCK_PEAK)
+        ->store(inWorld->mFFTBlockPeak, std::memory_order_relaxed);
+    inWorld->mFFTBlockPeak = 0;  // start the next window
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_ARENA_ALLOCS)
+        ->store(inWorld->mArenaAllocs, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_ARENA_POOL_ALLOCS)
+        ->store(inWorld->mArenaPoolAllocs, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_ARENA_SYNTHS)
+        ->store(inWorld->mArenaSynths, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_WORLD_RESIZES)
+        ->store(inWorld->hw->mResizes, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_WORLD_RESIZE_APPLY_US)
+        ->store(inWorld->hw->mResizeApplyUs, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_WORLD_RESIZE_BYTES)
+        ->store(static_cast<uint32_t>(inWorld->hw->mResizeBytes), std::memory_order_relaxed);
 }
 
 // Publish NRT control-thread blocking into the native-stats region. Written by
@@ -1351,6 +1423,39 @@ extern "C" void World_PublishNrtBlocking(uint32_t maxPassMs, uint32_t inFlightMs
         ->store(inFlightMs, std::memory_order_relaxed);
 }
 
+// Publish the command transport's egress queue state (deepest per-connection
+// backlog, frames dropped / clients closed by a full queue). Polled by the
+// watchdog like the NRT blocking stats above; relaxed display values.
+extern "C" void World_PublishEgress(uint32_t maxQueueBytes, uint32_t dropped,
+                                    uint32_t overflowCloses) {
+    uint8_t* base = reinterpret_cast<uint8_t*>(get_shared_memory_base());
+    if (!base) return;
+    uint8_t* ns = base + NATIVE_STATS_START;
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_EGRESS_MAX_QUEUE_BYTES)
+        ->store(maxQueueBytes, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_EGRESS_DROPPED)
+        ->store(dropped, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_EGRESS_OVERFLOW_CLOSES)
+        ->store(overflowCloses, std::memory_order_relaxed);
+}
+
+// Publish sample residency: prefetch hits, late loads, evictions, and the
+// memory registered samples hold right now, in KiB. Polled by the watchdog.
+extern "C" void World_PublishResidency(uint32_t prefetchHits, uint32_t lateLoads,
+                                       uint32_t evictions, uint32_t residentKiB) {
+    uint8_t* base = reinterpret_cast<uint8_t*>(get_shared_memory_base());
+    if (!base) return;
+    uint8_t* ns = base + NATIVE_STATS_START;
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_PREFETCH_HITS)
+        ->store(prefetchHits, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_LATE_LOADS)
+        ->store(lateLoads, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_EVICTIONS)
+        ->store(evictions, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_RESIDENT_KIB)
+        ->store(residentKiB, std::memory_order_relaxed);
+}
+
 // Publish the audio-thread DSP load + overrun count into the same native-stats
 // region. Split from World_UpdateNativeStats because the source (audio callback
 // timing) lives in the platform driver, not the World. Native-only; relaxed
@@ -0,0 +1,351 @@
+/*
+ * SC_WorldResize.cpp — see SC_WorldResize.h.
+ */
+#include "SC_WorldResize.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "SC_World.h"
+#include "SC_HiddenWorld.h"    // ceilings, mNodeLib, mMaxWireBufs, resize stats
+#include "SC_Prototypes.h"     // zalloc, zfree
+#include "SC_AllocPool.h"      // kAreaOverhead
+#include "memory_profile.h"    // SUPERSONIC_WORLD_GROWTH_FACTOR
+
+#if defined(SUPERSONIC) && !defined(__EMSCRIPTEN__)
+#include "mem_region.h"
+// SC_World.cpp: hands a pre-allocated area to the RT AllocPool (its area
+// callbacks and pending-area slot live there), and takes it back unused.
+bool World_AddRealTimeArea(World* inWorld, void* inArea, size_t inBytes);
+bool World_RemoveRealTimeArea(World* inWorld, void* inArea);
+#endif
+
+#if SUPERSONIC_WORLD_GROWTH_FACTOR > 1
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace {
+
+uint64_t nowUs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+// Bytes of the node table IntHashTable::Regrow builds for inMaxItems.
+size_t nodeTableBytes(uint32 inMaxItems) {
+    size_t size = 32;
+    while (size < (static_cast<size_t>(inMaxItems) << 1))
+        size <<= 1;
+    return size * sizeof(Node*);
+}
+
+size_t sndBufBytes(uint32 n) { return static_cast<size_t>(n) * (2 * sizeof(SndBuf) + sizeof(SndBufUpdates)); }
+
+// Back [inFrom, inTo) of freshly committed or allocated memory with pages
+// now. Both the reserved tables and the RT area are demand-zero, so the first
+// write to each page faults; done here, on the control thread, those faults
+// never land on the audio thread after the apply. Bytes below inFrom may be
+// live (the audio thread reads them), so the fallback rewrites each byte it
+// touches with its own value rather than clearing it.
+void prefault(void* base, size_t inFrom, size_t inTo) {
+    if (inTo <= inFrom)
+        return;
+    char* p = static_cast<char*>(base);
+#if SUPERSONIC_WORLD_GROWTH_FACTOR > 1 && !defined(_WIN32) && defined(MADV_POPULATE_WRITE)
+    // Whole pages only: the first may be shared with live data, which
+    // MADV_POPULATE_WRITE leaves as it is.
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(p + inFrom) & ~(page - 1);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(p + inTo);
+    if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_POPULATE_WRITE) == 0)
+        return;
+#endif
+    constexpr size_t kStride = 4096;
+    volatile char* v = p;
+    for (size_t off = inFrom; off < inTo; off += kStride)
+        v[off] = v[off];
+    v[inTo - 1] = v[inTo - 1];
+}
+
+// Commit [0, newBytes) of a reserved table and back the new part with pages.
+// Returns the bytes added.
+bool commitGrowth(void* base, size_t oldBytes, size_t newBytes, uint64_t& ioBytes) {
+    if (newBytes <= oldBytes)
+        return true;
+    if (!World_CommitTable(base, newBytes))
+        return false;
+    prefault(base, oldBytes, newBytes);
+    ioBytes += newBytes - oldBytes;
+    return true;
+}
+
+} // namespace
+
+struct WorldResize {
+    WorldLimits mFrom;
+    WorldLimits mTo;
+    void* mArea = nullptr;      // RT pool area: RT growth + the new node table
+    size_t mAreaBytes = 0;
+    uint64_t mBytes = 0;
+    uint32_t mPrepareUs = 0;
+    uint32_t mApplyUs = 0;
+    const char* mError = nullptr;
+};
+
+uint32 World_GrowthCeiling(uint32 inBootSize) {
+    // IntHashTable sizes its table at twice the item count in an int32.
+    const uint64_t ceiling = static_cast<uint64_t>(inBootSize) * SUPERSONIC_WORLD_GROWTH_FACTOR;
+    return static_cast<uint32>(std::min<uint64_t>(ceiling, 1u << 29));
+}
+
+void World_GetLimits(World* inWorld, WorldLimits* outCurrent, WorldLimits* outCeiling) {
+    HiddenWorld* hw = inWorld->hw;
+    if (outCurrent) {
+        outCurrent->mMaxNodes = hw->mMaxNodes;
+        outCurrent->mNumBuffers = inWorld->mNumSndBufs;
+        outCurrent->mNumAudioBusChannels = inWorld->mNumAudioBusChannels;
+        outCurrent->mNumControlBusChannels = inWorld->mNumControlBusChannels;
+        outCurrent->mMaxWireBufs = hw->mMaxWireBufs;
+        outCurrent->mRealTimeMemoryKB = hw->mRealTimeMemoryKB;
+    }
+    if (outCeiling) {
+        outCeiling->mMaxNodes = hw->mMaxNodesCeiling;
+        outCeiling->mNumBuffers = hw->mNumSndBufsCeiling;
+        outCeiling->mNumAudioBusChannels = hw->mNumAudioBusChannelsCeiling;
+        outCeiling->mNumControlBusChannels = hw->mNumControlBusChannelsCeiling;
+        outCeiling->mMaxWireBufs = hw->mMaxWireBufsCeiling;
+        outCeiling->mRealTimeMemoryKB = hw->mRealTimeMemoryCeilingKB;
+    }
+}
+
+WorldResize* World_PrepareResize(World* inWorld, const WorldLimits& inWant, const char** outError) {
+    const uint64_t t0 = nowUs();
+    HiddenWorld* hw = inWorld->hw;
+    WorldLimits cur, ceil;
+    World_GetLimits(inWorld, &cur, &ceil);
+
+    WorldLimits to;
+    to.mMaxNodes = std::max(inWant.mMaxNodes, cur.mMaxNodes);
+    to.mNumBuffers = std::max(inWant.mNumBuffers, cur.mNumBuffers);
+    to.mNumAudioBusChannels = std::max(inWant.mNumAudioBusChannels, cur.mNumAudioBusChannels);
+    to.mNumControlBusChannels = std::max(inWant.mNumControlBusChannels, cur.mNumControlBusChannels);
+    to.mMaxWireBufs = std::max(inWant.mMaxWireBufs, cur.mMaxWireBufs);
+    to.mRealTimeMemoryKB = std::max(inWant.mRealTimeMemoryKB, cur.mRealTimeMemoryKB);
+
+    const char* error = nullptr;
+    if (to.mMaxNodes > ceil.mMaxNodes)
+        error = "nodes above ceiling";
+    else if (to.mNumBuffers > ceil.mNumBuffers)
+        error = "buffers above ceiling";
+    else if (to.mNumAudioBusChannels > ceil.mNumAudioBusChannels)
+        error = "audio buses above ceiling";
+    else if (to.mNumControlBusChannels > ceil.mNumControlBusChannels)
+        error = "control buses above ceiling";
+    else if (to.mMaxWireBufs > ceil.mMaxWireBufs)
+        error = "wire buffers above ceiling";
+    else if (to.mRealTimeMemoryKB > ceil.mRealTimeMemoryKB)
+        error = "RT memory above ceiling";
+    if (error) {
+        *outError = error;
+        return nullptr;
+    }
+
+    WorldResize* r = new WorldResize;
+    r->mFrom = cur;
+    r->mTo = to;
+
+    // Back the grown ranges of the reserved tables. Nothing past the current
+    // counts is read by the audio thread, so this needs no handoff.
+    const size_t bufLength = static_cast<size_t>(inWorld->mBufLength);
+    bool ok = commitGrowth(inWorld->mAudioBus, cur.mNumAudioBusChannels * bufLength * sizeof(float),
+                           to.mNumAudioBusChannels * bufLength * sizeof(float), r->mBytes)
+        && commitGrowth(inWorld->mAudioBusTouched, cur.mNumAudioBusChannels * sizeof(int32),
+                        to.mNumAudioBusChannels * sizeof(int32), r->mBytes)
+        && commitGrowth(inWorld->mControlBus, cur.mNumControlBusChannels * sizeof(float),
+                        to.mNumControlBusChannels * sizeof(float), r->mBytes)
+        && commitGrowth(inWorld->mControlBusTouched, cur.mNumControlBusChannels * sizeof(int32),
+                        to.mNumControlBusChannels * sizeof(int32), r->mBytes)
+        && commitGrowth(inWorld->mSndBufs, cur.mNumBuffers * sizeof(SndBuf), to.mNumBuffers * sizeof(SndBuf),
+                        r->mBytes)
+        && commitGrowth(inWorld->mSndBufsNonRealTimeMirror, cur.mNumBuffers * sizeof(SndBuf),
+                        to.mNumBuffers * sizeof(SndBuf), r->mBytes)
+        && commitGrowth(inWorld->mSndBufUpdates, cur.mNumBuffers * sizeof(SndBufUpdates),
+                        to.mNumBuffers * sizeof(SndBufUpdates), r->mBytes)
+        && commitGrowth(hw->mWireBufSpace, cur.mMaxWireBufs * bufLength * sizeof(float),
+                        to.mMaxWireBufs * bufLength * sizeof(float), r->mBytes);
+    if (!ok) {
+        delete r;
+        *outError = "out of memory";
+        return nullptr;
+    }
+    // World_Start's untouched stamp, so new buses read as silent / unset.
+    for (uint32 i = cur.mNumAudioBusChannels; i < to.mNumAudioBusChannels; ++i)
+        inWorld->mAudioBusTouched[i] = -1;
+    for (uint32 i = cur.mNumControlBusChannels; i < to.mNumControlBusChannels; ++i)
+        inWorld->mControlBusTouched[i] = -1;
+
+    // One RT pool area carries the RT growth plus the new node table, so the
+    // apply cannot fail to find room for the table.
+    size_t areaBytes = static_cast<size_t>(to.mRealTimeMemoryKB - cur.mRealTimeMemoryKB) * 1024;
+    if (to.mMaxNodes > cur.mMaxNodes)
+        areaBytes += nodeTableBytes(to.mMaxNodes) + kAlign * 4;
+    if (areaBytes) {
+#if defined(SUPERSONIC) && !defined(__EMSCRIPTEN__)
+        r->mArea = supersonic::mem::alloc(supersonic::mem::Tier::Bulk, areaBytes + kAreaOverhead);
+        if (!r->mArea) {
+            delete r;
+            *outError = "out of memory";
+            return nullptr;
+        }
+        prefault(r->mArea, 0, areaBytes + kAreaOverhead);
+        r->mAreaBytes = areaBytes;
+        r->mBytes += areaBytes + kAreaOverhead;
+#else
+        // The pool is one pre-allocated block here: RT memory cannot grow, and
+        // a larger node table must fit in the pool's free space.
+        if (to.mRealTimeMemoryKB > cur.mRealTimeMemoryKB) {
+            delete r;
+            *outError = "RT memory cannot grow on this runtime";
+            return nullptr;
+        }
+#endif
+    }
+
+    r->mPrepareUs = static_cast<uint32_t>(nowUs() - t0);
+    return r;
+}
+
+bool World_ApplyResize(World* inWorld, WorldResize* inResize) {
+    const uint64_t t0 = nowUs();
+    HiddenWorld* hw = inWorld->hw;
+    const WorldLimits& to = inResize->mTo;
+
+    // A LocalBuf's number is mNumSndBufs + n; raising mNumSndBufs would turn
+    // it into a global buffer.
+    if (to.mNumBuffers > inWorld->mNumSndBufs && inWorld->mNumLocalBufs > 0) {
+        inResize->mError = "buffers cannot grow while a synth holds LocalBufs";
+        return false;
+    }
+#if defined(SUPERSONIC) && !defined(__EMSCRIPTEN__)
+    if (inResize->mArea && !World_AddRealTimeArea(inWorld, inResize->mArea, inResize->mAreaBytes)) {
+        inResize->mError = "RT pool refused the area";
+        return false;
+    }
+#endif
+    // The new table comes from the area when there is one (it was sized for
+    // it), else from the pool's free space. The last point of failure: a
+    // refusal here takes the area back out of the pool, so no limit, and not
+    // the pool either, has moved.
+    if (to.mMaxNodes > hw->mMaxNodes) {
+        if (!hw->mNodeLib->Regrow(static_cast<int32>(to.mMaxNodes))) {
+#if defined(SUPERSONIC) && !defined(__EMSCRIPTEN__)
+            if (inResize->mArea && !World_RemoveRealTimeArea(inWorld, inResize->mArea))
+                inResize->mArea = nullptr; // still in the pool; it owns it
+#endif
+            inResize->mError = "RT pool has no room for the node table";
+            return false;
+        }
+        hw->mMaxNodes = to.mMaxNodes;
+    }
+#if defined(SUPERSONIC) && !defined(__EMSCRIPTEN__)
+    inResize->mArea = nullptr; // the pool owns it now
+#endif
+    inWorld->mNumSndBufs = to.mNumBuffers;
+    inWorld->mNumAudioBusChannels = to.mNumAudioBusChannels;
+    inWorld->mNumControlBusChannels = to.mNumControlBusChannels;
+    hw->mMaxWireBufs = to.mMaxWireBufs;
+    hw->mRealTimeMemoryKB = to.mRealTimeMemoryKB;
+
+    inResize->mApplyUs = static_cast<uint32_t>(nowUs() - t0);
+    hw->mResizes++;
+    hw->mResizeApplyUs = inResize->mApplyUs;
+    hw->mResizeBytes += inResize->mBytes;
+    return true;
+}
+
+void World_FinishResize(World* inWorld, WorldResize* inResize, WorldResizeReport* outReport) {
+#if defined(SUPERSONIC) && !defined(__EMSCRIPTEN__)
+    if (inResize->mArea)
+        supersonic::mem::free(inResize->mArea);
+#endif
+    if (outReport) {
+        World_GetLimits(inWorld, &outReport->mLimits, nullptr);
+        outReport->mBytesAdded = inResize->mError ? 0 : inResize->mBytes;
+        outReport->mPrepareUs = inResize->mPrepareUs;
+        outReport->mApplyUs = inResize->mApplyUs;
+        outReport->mError = inResize->mError;
+    }
+    delete inResize;
+}
+
+// ─── Address-stable table storage ───────────────────────────────────────────
+
+#if SUPERSONIC_WORLD_GROWTH_FACTOR > 1 && defined(_WIN32)
+
+void* World_ReserveTable(size_t inReserveBytes, size_t inCommitBytes) {
+    if (!inReserveBytes)
+        return nullptr;
+    void* base = VirtualAlloc(nullptr, inReserveBytes, MEM_RESERVE, PAGE_NOACCESS);
+    if (base && !World_CommitTable(base, inCommitBytes)) {
+        VirtualFree(base, 0, MEM_RELEASE);
+        return nullptr;
+    }
+    return base;
+}
+
+bool World_CommitTable(void* inBase, size_t inCommitBytes) {
+    return !inCommitBytes || VirtualAlloc(inBase, inCommitBytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void World_ReleaseTable(void* inBase, size_t) {
+    if (inBase)
+        VirtualFree(inBase, 0, MEM_RELEASE);
+}
+
+#elif SUPERSONIC_WORLD_GROWTH_FACTOR > 1
+
+// Anonymous mappings are zero-filled and backed page by page on first touch,
+// so the reservation costs address space only.
+void* World_ReserveTable(size_t inReserveBytes, size_t) {
+    if (!inReserveBytes)
+        return nullptr;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void* base = mmap(nullptr, inReserveBytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return base == MAP_FAILED ? nullptr : base;
+}
+
+bool World_CommitTable(void*, size_t) { return true; }
+
+void World_ReleaseTable(void* inBase, size_t inReserveBytes) {
+    if (inBase)
+        munmap(inBase, inReserveBytes);
+}
+
+#else
+
+void* World_ReserveTable(size_t, size_t inCommitBytes) { return zalloc(1, inCommitBytes); }
+
+bool World_CommitTable(void*, size_t) { return true; }
+
+void World_ReleaseTable(void* inBase, size_t) {
+    if (inBase)
+        zfree(inBase);
+}
+
+#endif
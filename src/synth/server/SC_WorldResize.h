@@ -0,0 +1,79 @@
+/*
+ * SC_WorldResize.h — grow the World's fixed limits while it runs
+ *
+ * World_New sizes the node table, sample buffers, audio/control buses, wire
+ * buffers and RT memory once. Raising one used to need a cold swap, which
+ * drops every node and buffer. These calls raise them in place instead.
+ *
+ * Units hold raw pointers into the bus, touched-stamp, SndBuf and wire-buffer
+ * tables (Out/In, GET_BUF, /n_map, graph wires), so those tables cannot move.
+ * World_New reserves them in address space at SUPERSONIC_WORLD_GROWTH_FACTOR
+ * times their boot size (memory_profile.h). Growing one initialises the new
+ * range off the audio thread and publishes the larger count at a block
+ * boundary. The node hash table has no outside pointers into it, so it is
+ * rebuilt into a larger table. RT memory grows by adding a pool area.
+ *
+ * Three steps, on two threads:
+ *   World_PrepareResize   control thread: validate, allocate, initialise
+ *   World_ApplyResize     audio thread, at the top of a block: publish
+ *   World_FinishResize    control thread: free leftovers, fill the report
+ * The resize is all-or-nothing: a refused apply changes no limit and leaves
+ * the RT pool as it was.
+ */
+
+#pragma once
+
+#include "SC_Types.h"
+#include <cstddef>
+#include <cstdint>
+
+struct World;
+
+// One value per limit. In a request, a value at or below the current limit
+// means "keep it".
+struct WorldLimits {
+    uint32 mMaxNodes = 0;
+    uint32 mNumBuffers = 0;
+    uint32 mNumAudioBusChannels = 0;
+    uint32 mNumControlBusChannels = 0;
+    uint32 mMaxWireBufs = 0;
+    uint32 mRealTimeMemoryKB = 0;
+};
+
+struct WorldResizeReport {
+    WorldLimits mLimits;        // limits after the resize (unchanged if refused)
+    uint64_t mBytesAdded = 0;   // memory the resize committed or allocated
+    uint32_t mPrepareUs = 0;    // control-thread preparation
+    uint32_t mApplyUs = 0;      // audio-thread swap, inside one block
+    const char* mError = nullptr;
+};
+
+struct WorldResize;
+
+// Current limits and the ceilings they can grow to. Control thread.
+void World_GetLimits(World* inWorld, WorldLimits* outCurrent, WorldLimits* outCeiling);
+
+// Build a resize for `inWant`. Returns nullptr and sets *outError if a value is
+// above its ceiling or memory cannot be had; nothing has changed then.
+WorldResize* World_PrepareResize(World* inWorld, const WorldLimits& inWant, const char** outError);
+
+// Publish the prepared resize. Audio thread, between blocks, never concurrent
+// with World_Run. Returns false, changing nothing, if it must be refused
+// (buffers cannot grow while a synth holds LocalBufs, whose numbers are
+// offsets past mNumSndBufs).
+bool World_ApplyResize(World* inWorld, WorldResize* inResize);
+
+// Free what the resize left behind (an unused RT area if it was refused or
+// never applied), fill *outReport and delete the resize. Control thread.
+void World_FinishResize(World* inWorld, WorldResize* inResize, WorldResizeReport* outReport);
+
+// Address-stable table storage for World_New / World_Start / World_Cleanup.
+// Reserves inReserveBytes, usable up to inCommitBytes now and zero-filled;
+// World_CommitTable extends the usable range in place. With a growth factor
+// of 1 these are plain zalloc/zfree.
+void* World_ReserveTable(size_t inReserveBytes, size_t inCommitBytes);
+bool World_CommitTable(void* inBase, size_t inCommitBytes);
+void World_ReleaseTable(void* inBase, size_t inReserveBytes);
+
+// Boot size -> ceiling for one limit.
+uint32 World_GrowthCeiling(uint32 inBootSize);
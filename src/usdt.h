@@ -0,0 +1,65 @@
+/*
+ * SuperSonic
+ * Copyright (c) 2026 Sam Aaron
+ *
+ * Dual-licensed MIT OR GPL-3.0-or-later (see repo LICENSE).
+ *
+ * usdt.h — USDT static tracepoints (provider "supersonic").
+ *
+ * Each SS_PROBEn site compiles to a single nop plus a note in the ELF
+ * .note.stapsdt section naming the probe and where its arguments live.
+ * Nothing runs unless a tracer (bpftrace, perf, SystemTap) attaches, at
+ * which point the kernel patches the nop into a breakpoint. Arguments are
+ * kept to values the surrounding code already has (at most a relaxed load),
+ * so an unattached probe costs next to nothing. sys/sdt.h is header-only:
+ * no library, no runtime dependency.
+ *
+ * Compiled in on Linux when the build defines SUPERSONIC_USDT (the
+ * SUPERSONIC_USDT CMake option, on by default when sys/sdt.h is found).
+ * Everywhere else — the WASM and embedded builds, macOS, Windows, or with
+ * the option off — every probe is an empty statement that does not
+ * evaluate its arguments.
+ *
+ * Probes (arguments in order). `block` is process_count, so the block
+ * probes of one callback pair up:
+ *   block_begin(block)                  process_audio, once the engine is ready
+ *   block_drained(block, performed)     IN lanes drained
+ *   block_fired(block, queued)          due scheduler events dispatched
+ *   block_rendered(block)               graph pass done (synth builds)
+ *   block_end(block, idle)              process_audio exit (idle = silent skip)
+ *   ingress_write(len, origin, seq, ok) IN-ring write (seq 0 when not written)
+ *   ingress_drain(len, origin, seq)     IN-lane frame taken by the audio thread
+ *   sched_insert(when, tag, size, live) event parked on a scheduler
+ *   sched_fire(when, block_time, origin, size)
+ *   sched_flush(tag, live)              tag 0 = clear
+ *   node_create(id, is_group)           node started (n_go)
+ *   node_free(id)                       node ended (n_end)
+ *   sample_request(bufnum, path)        SampleLoader job queued
+ *   sample_decode(bufnum)               I/O thread starts reading it
+ *   sample_decoded(bufnum, frames)      handed to the audio thread (0 = failed)
+ *   sample_install(bufnum, frames, ok)  swapped into the World
+ *   gateway_wake(wake)                  NRT gateway pass begins
+ *   gateway_done(us)                    ...and ends, with its duration
+ *   transport_recv(len, origin, ok)     SupersonicEngine::ingest
+ *   transport_send(len, origin, route)  egress handed to the transport
+ *
+ * scripts/bpftrace/ has ready-made scripts built on these.
+ */
+#pragma once
+
+#if defined(SUPERSONIC_USDT) && defined(__linux__) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SS_USDT_ENABLED 1
+#define SS_PROBE0(name)                DTRACE_PROBE(supersonic, name)
+#define SS_PROBE1(name, a)             DTRACE_PROBE1(supersonic, name, a)
+#define SS_PROBE2(name, a, b)          DTRACE_PROBE2(supersonic, name, a, b)
+#define SS_PROBE3(name, a, b, c)       DTRACE_PROBE3(supersonic, name, a, b, c)
+#define SS_PROBE4(name, a, b, c, d)    DTRACE_PROBE4(supersonic, name, a, b, c, d)
+#else
+#define SS_USDT_ENABLED 0
+#define SS_PROBE0(name)                do {} while (0)
+#define SS_PROBE1(name, a)             do { (void)sizeof(a); } while (0)
+#define SS_PROBE2(name, a, b)          do { (void)sizeof(a); (void)sizeof(b); } while (0)
+#define SS_PROBE3(name, a, b, c)       do { (void)sizeof(a); (void)sizeof(b); (void)sizeof(c); } while (0)
+#define SS_PROBE4(name, a, b, c, d)    do { (void)sizeof(a); (void)sizeof(b); (void)sizeof(c); (void)sizeof(d); } while (0)
+#endif
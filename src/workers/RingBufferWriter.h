@@ -55,6 +55,26 @@ public:
         const void*           data,
         uint32_t              data_size,
         uint32_t              source_id = 0)
+    {
+        return write(buffer_start, buffer_size, head, tail, sequence, write_lock,
+                     data, data_size, source_id, [](uint32_t) {});
+    }
+
+    // As above, calling on_seq(seq) with the frame's sequence number while
+    // the lock is held, before the head is published — so anything it stores
+    // is visible to a reader that sees the frame (the latency trace stamps).
+    template <class OnSeq>
+    static bool write(
+        uint8_t*              buffer_start,
+        uint32_t              buffer_size,
+        std::atomic<int32_t>* head,
+        std::atomic<int32_t>* tail,
+        std::atomic<int32_t>* sequence,
+        std::atomic<int32_t>* write_lock,
+        const void*           data,
+        uint32_t              data_size,
+        uint32_t              source_id,
+        OnSeq&&               on_seq)
     {
         const uint32_t total_size   = static_cast<uint32_t>(sizeof(Message)) + data_size;
         const uint32_t aligned_size = (total_size + 3u) & ~3u;
@@ -122,6 +142,7 @@ public:
         if (aligned_size > total_size)
             std::memset(buffer_start + uh + total_size, 0, aligned_size - total_size);
 
+        on_seq(seq);
         head->store(static_cast<int32_t>((uh + aligned_size) % buffer_size),
                     std::memory_order_release);
         write_lock->store(0, std::memory_order_release);
@@ -2,6 +2,7 @@
  * RingReader.cpp — see RingReader.h.
  */
 #include "RingReader.h"
+#include "../usdt.h"
 #include <cstdio>
 
 void RingReader::start() {
@@ -126,6 +127,7 @@ void RingReader::run() {
         // this thread was unavailable to everything queued behind it.
         const uint64_t startUs = nowUs();
         mPassStartUs.store(startUs, std::memory_order_relaxed);
+        SS_PROBE1(gateway_wake, mLastWake);
 
         for (auto& d : mDrains) drainOne(d);
 
@@ -133,6 +135,7 @@ void RingReader::run() {
         mPassStartUs.store(0, std::memory_order_relaxed);
         const uint32_t us = static_cast<uint32_t>(
             elapsed > UINT32_MAX ? UINT32_MAX : elapsed);
+        SS_PROBE1(gateway_done, us);
         if (us > mMaxPassUs.load(std::memory_order_relaxed))
             mMaxPassUs.store(us, std::memory_order_relaxed);
         if (us >= mSlowPassThresholdUs && mOnSlowPass) mOnSlowPass(us);
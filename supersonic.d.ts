@@ -1580,6 +1580,12 @@ export class SuperSonic {
   send(address: '/d_free', ...names: [string, ...string[]]): void;
   /** Free all loaded synthdefs. Not in the official SC reference but supported by scsynth. */
   send(address: '/d_freeAll'): void;
+  /** SuperSonic extension. Turn load-time synthdef optimisation (constant folding, unused-unit removal) on (1) or off (0) for defs received afterwards; omit to query. Replies with `/d_optimise.reply enabled`. */
+  send(address: '/d_optimise', enable?: 0 | 1): void;
+  /** SuperSonic extension. Query load-time optimisation per synthdef. Replies with `/d_stats.reply name unitsRead units calcUnitsRead calcUnits folded aliasedChannels arenaBytes` for each. */
+  send(address: '/d_stats', ...names: [string, ...string[]]): void;
+  /** SuperSonic extension. Turn per-synth constructor memory blocks on (1) or off (0) for synths created afterwards; omit to query. Replies with `/d_arena.reply enabled`. */
+  send(address: '/d_arena', enable?: 0 | 1): void;
 
   // ── Synth commands ─────────────────────────────────────────────────
 
@@ -1967,6 +1973,33 @@ export class SuperSonic {
     channels: number;
   };
 
+  /**
+   * Choose what the engine meters: the hardware outputs plus up to 16 audio
+   * buses, measured after every block with no synths or OSC involved. SAB
+   * mode only. Returns the request generation (`getMeters().gen` reaches it
+   * once the engine has applied it), or null when metering is unavailable.
+   */
+  setMeters(options?: {
+    enabled?: boolean;
+    buses?: number[];
+    truePeak?: boolean;
+    rmsMs?: number;
+    peakMs?: number;
+  }): number | null;
+
+  /**
+   * Latest meter levels (linear amplitude), or null before the engine has
+   * applied a request.
+   */
+  getMeters(): {
+    gen: number;
+    blocks: number;
+    rmsMs: number;
+    peakMs: number;
+    outputs: Array<{ peak: number; rms: number; truePeak: number; max: number }>;
+    buses: Array<{ bus: number; peak: number; rms: number; truePeak: number; max: number }>;
+  } | null;
+
   /**
    * Get a comprehensive system performance report.
    *
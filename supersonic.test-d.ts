@@ -645,6 +645,11 @@ expectType<void>(sonic.send('/d_recv', new ArrayBuffer(8), new ArrayBuffer(4)));
 expectType<void>(sonic.send('/d_free', 'beep'));
 expectType<void>(sonic.send('/d_free', 'beep', 'pad', 'kick'));
 expectType<void>(sonic.send('/d_freeAll'));
+expectType<void>(sonic.send('/d_optimise', 0));
+expectType<void>(sonic.send('/d_optimise'));
+expectType<void>(sonic.send('/d_stats', 'beep', 'pad'));
+expectType<void>(sonic.send('/d_arena', 0));
+expectType<void>(sonic.send('/d_arena'));
 
 // --- Synth commands ---
 expectType<void>(sonic.send('/s_new', 'beep', 1001, 0, 1));
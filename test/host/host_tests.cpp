@@ -3,21 +3,27 @@
     Copyright (c) 2025 Sam Aaron
 
     Unit tests for the standalone host's pure logic: the OSC reader and the
-    HostScheduler ingest/tick/outbound path. No sockets, no threads, no engine —
-    a fake clock (explicit `now`), the scheduler framing due events into a ring,
-    and a synchronous drain into capturing delivery callbacks. Standalone assert
-    harness; builds independently of the engine.
+    HostScheduler ingest/tick/outbound path. No sockets, no engine — a fake clock
+    (explicit `now`), the scheduler framing due events into a ring, and a
+    synchronous drain into capturing delivery callbacks. The last test runs the
+    real tick loop on a thread against the wall clock and prints its dispatch
+    lateness histogram. Standalone assert harness; builds independently of the
+    engine.
 */
 
 #include "host/host_scheduler.h"
 #include "host/host_outbound.h"
 #include "host/osc_reader.h"
+#include "host/tick_loop.h"
 #include "OscIngress.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <thread>
 #include <vector>
 
 using ss_host::HostScheduler;
@@ -80,9 +86,63 @@ std::vector<uint8_t> midi_msg(const std::vector<uint8_t>& raw) {
 
 // Capture of one OSC send.
 struct OscSend { std::string host; int port; std::vector<uint8_t> inner; };
+
+void print_lateness(const char* label, const ss_host::LatenessHistogram& h) {
+    std::printf("%s: %llu events, p50 <%lld us, p99 <%lld us, max %lld us\n", label,
+                static_cast<unsigned long long>(h.total),
+                static_cast<long long>(h.quantileUs(0.5)),
+                static_cast<long long>(h.quantileUs(0.99)),
+                static_cast<long long>(h.maxUs));
+    for (int b = 0; b < ss_host::LatenessHistogram::kBuckets; ++b)
+        if (h.counts[b])
+            std::printf("  <%8lld us  %llu\n",
+                        static_cast<long long>(ss_host::LatenessHistogram::bucketLimitUs(b)),
+                        static_cast<unsigned long long>(h.counts[b]));
+}
+
+// Run the real tick loop on a thread, schedule `n` events `gapMs` apart behind a
+// far-future one (each must wake the sleeper early), and return the lateness
+// histogram once they have all fired.
+ss_host::LatenessHistogram run_live(uint32_t spinUs, int n, int gapMs, int& fired) {
+    std::atomic<int> sends{0};
+    ss_host::SendOsc countOsc = [&](const char*, int, const uint8_t*, uint32_t) { ++sends; };
+    ss_host::SendMidi noMidi  = [](const uint8_t*, uint32_t) {};
+    ss_host::HostSenders senders{ countOsc, noMidi };
+    OscIngress ingress;
+    ingress.registerRoute("/osc/send", &ss_host::hostOscSendRoute, &senders);
+    HostScheduler sched(ingress);
+
+    std::atomic<bool> running{true};
+    ss_host::TickLoopOptions opt;
+    opt.spinUs = spinUs;
+    std::thread loop([&] { ss_host::run_tick_loop(sched, running, opt); });
+
+    const int64_t second = int64_t(1) << 32;
+    auto far = osc_at(ss_host::osc_now() + 10 * second, "h", 1, {0x00});
+    sched.ingest(far.data(), far.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));   // let it sleep on the far deadline
+    const int64_t start = ss_host::osc_now() + 20 * (second / 1000);
+    for (int i = 0; i < n; ++i) {
+        auto m = osc_at(start + i * gapMs * (second / 1000), "h", 2, {0x01});
+        sched.ingest(m.data(), m.size());
+    }
+    const auto deadline = std::chrono::steady_clock::now()
+                        + std::chrono::milliseconds(40 + n * gapMs + 2000);
+    while (sends.load() < n && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    running.store(false);
+    sched.doorbell().ring();
+    loop.join();
+    fired = sends.load();
+    return sched.lateness();
+}
 }  // namespace
 
-int main() {
+int main(int argc, char** argv) {
+    // -v: print the live lateness histograms (test 12) even when they pass.
+    const bool verbose = argc > 1 && std::strcmp(argv[1], "-v") == 0;
+
     // 1) OscReader reads /osc/send fields in order.
     {
         std::vector<uint8_t> inner = {0xDE, 0xAD, 0xBE, 0xEF, 0x01};
@@ -224,6 +284,67 @@ int main() {
         CHECK(midiSends.empty());
     }
 
+    // 10) The sleep handshake: while the tick thread is between beginPass() and
+    //     sleepingUntil(), every ingest rings; once it sleeps towards a deadline,
+    //     only an earlier event does.
+    {
+        oscSends.clear();
+        uint32_t armed = sched.beginPass();
+        auto a = osc_at(50000, "h", 1, {0x01});
+        sched.ingest(a.data(), a.size());
+        CHECK(sched.doorbell().arm() != armed);        // awake: rung
+        sched.tick(10000);
+        CHECK(sched.nextDue() == 50000);
+
+        armed = sched.beginPass();
+        sched.tick(10000);
+        sched.sleepingUntil(sched.nextDue());
+        auto later = osc_at(60000, "h", 2, {0x02});
+        sched.ingest(later.data(), later.size());
+        CHECK(sched.doorbell().arm() == armed);        // later than the deadline: no ring
+        CHECK(!sched.doorbell().wait(armed, 0));       // past deadline: returns, not rung
+        auto earlier = osc_at(20000, "h", 3, {0x03});
+        sched.ingest(earlier.data(), earlier.size());
+        CHECK(sched.doorbell().arm() != armed);        // earlier: rung
+        CHECK(sched.doorbell().wait(armed, INT64_MAX));  // and a wait returns at once
+
+        sched.tick(60000);
+        CHECK(oscSends.size() == 3);
+        CHECK(oscSends[0].port == 3);
+        CHECK(sched.nextDue() == INT64_MAX);
+    }
+
+    // 11) Lateness is measured from each event's timetag to the tick that fired it.
+    {
+        sched.resetLateness();
+        const int64_t ms = (int64_t(1) << 32) / 1000;
+        auto a = osc_at(100 * ms, "h", 1, {0x01});
+        auto b = osc_at(103 * ms, "h", 1, {0x01});
+        sched.ingest(a.data(), a.size());
+        sched.ingest(b.data(), b.size());
+        sched.tick(104 * ms);
+        const auto& h = sched.lateness();
+        CHECK(h.total == 2);
+        CHECK(h.maxUs >= 3999 && h.maxUs <= 4000);
+        CHECK(h.counts[ss_host::LatenessHistogram::bucket(1000)] == 1);   // ~1 ms late
+        CHECK(h.quantileUs(1.0) == 4096);
+    }
+
+    // 12) Live: the deadline-driven loop on the real clock. Near events queued
+    //     behind a far one must wake the sleeper. The histogram is printed
+    //     with -v, or when the bound fails. The bound is loose on purpose —
+    //     shared CI runners can be descheduled.
+    for (uint32_t spinUs : {0u, 200u}) {
+        int fired = 0;
+        auto h = run_live(spinUs, 40, 5, fired);
+        char label[64];
+        std::snprintf(label, sizeof label, "dispatch lateness (spin %u us)", spinUs);
+        if (verbose || h.quantileUs(0.5) > 8192) print_lateness(label, h);
+        CHECK(fired == 40);
+        CHECK(h.total == 40);
+        CHECK(h.quantileUs(0.5) <= 8192);
+    }
+
     if (g_failures) {
         std::fprintf(stderr, "%d failure(s)\n", g_failures);
         return 1;
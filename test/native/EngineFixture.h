@@ -97,6 +97,11 @@ public:
     // Stop the HeadlessDriver so callers can own process_audio exclusively
     void stopHeadlessDriver();
 
+    // The HeadlessDriver and the engine-frame counter, for tests that compare
+    // simulated-device progress with World progress (pinned internal rate).
+    const HeadlessDriver& headlessDriver() const { return mEngine.mHeadlessDriver; }
+    uint64_t engineFrames() const { return mEngine.mSuperClock.engineFrames(); }
+
     // Render `n` audio blocks on the calling (test) thread via
     // SupersonicEngine::pumpAudioBlock(). In manualAudioPump mode (no driver
     // thread) the test thread is the sole audio-thread writer, so a bus snapshot
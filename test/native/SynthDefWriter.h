@@ -0,0 +1,75 @@
+/*
+ * SynthDefWriter.h — minimal SCgf v2 writer for tests that lay out a graph
+ * unit by unit. Parameters are constants, come in on buses, or are named
+ * controls (controls + params, read by a Control unit).
+ *
+ * Grown from the private copy in test_graphdef_optimise.cpp (those older
+ * tests keep their own).
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osc_test {
+
+struct DefWriter {
+    struct Input { int32_t unit; int32_t index; };  // unit -1 => constant index
+    struct Ugen {
+        std::string name;
+        uint8_t rate;  // 0 ir, 1 kr, 2 ar
+        std::vector<Input> inputs;
+        std::vector<uint8_t> outputs;
+        int16_t special = 0;
+    };
+
+    std::string name;
+    std::vector<float> constants;
+    std::vector<float> controls;                           // initial values
+    std::vector<std::pair<std::string, int32_t>> params;   // name, control index
+    std::vector<Ugen> ugens;
+
+    Input c(float v) {
+        for (size_t i = 0; i < constants.size(); ++i)
+            if (constants[i] == v) return {-1, static_cast<int32_t>(i)};
+        constants.push_back(v);
+        return {-1, static_cast<int32_t>(constants.size() - 1)};
+    }
+    Input add(Ugen u) {
+        ugens.push_back(std::move(u));
+        return {static_cast<int32_t>(ugens.size() - 1), 0};
+    }
+
+    std::vector<uint8_t> bytes() const {
+        std::vector<uint8_t> b = {'S', 'C', 'g', 'f'};
+        auto i8  = [&](uint8_t v) { b.push_back(v); };
+        auto i16 = [&](int v) { i8(static_cast<uint8_t>(v >> 8)); i8(static_cast<uint8_t>(v)); };
+        auto i32 = [&](int32_t v) { for (int s = 24; s >= 0; s -= 8) i8(static_cast<uint8_t>(uint32_t(v) >> s)); };
+        auto f32 = [&](float f) { int32_t v; std::memcpy(&v, &f, 4); i32(v); };
+        auto str = [&](const std::string& s) { i8(static_cast<uint8_t>(s.size())); for (char ch : s) i8(static_cast<uint8_t>(ch)); };
+        i32(2); i16(1);
+        str(name);
+        i32(static_cast<int32_t>(constants.size()));
+        for (float f : constants) f32(f);
+        i32(static_cast<int32_t>(controls.size()));
+        for (float f : controls) f32(f);
+        i32(static_cast<int32_t>(params.size()));
+        for (const auto& p : params) { str(p.first); i32(p.second); }
+        i32(static_cast<int32_t>(ugens.size()));
+        for (const auto& u : ugens) {
+            str(u.name); i8(u.rate);
+            i32(static_cast<int32_t>(u.inputs.size()));
+            i32(static_cast<int32_t>(u.outputs.size()));
+            i16(u.special);
+            for (const auto& in : u.inputs) { i32(in.unit); i32(in.index); }
+            for (uint8_t r : u.outputs) i8(r);
+        }
+        i16(0);  // variants
+        return b;
+    }
+};
+
+}  // namespace osc_test
@@ -14,6 +14,7 @@
  */
 #include "EngineFixture.h"
 #include "SupersonicEngine.h"
+#include "src/metrics_shards.h"
 #include <cstdio>
 #include <algorithm>
 #include <vector>
@@ -316,6 +317,92 @@ TEST_CASE("benchmark: mixed load", "[.][benchmark]") {
     CHECK(r.avgNs < r.budgetNs);
 }
 
+// Upstream kernels (mode 0) vs the polynomial ones (mode 1, see
+// BandLimitedOsc.hpp) on the blosc_*_probe synthdefs. Each run gets a fresh
+// engine; the per-voice figure subtracts an idle baseline.
+TEST_CASE("benchmark: band-limited oscillator modes", "[.][benchmark]") {
+    constexpr int kVoices = 32;
+    const char* probes[] = {"blosc_saw_probe", "blosc_pulse_probe", "blosc_blip_probe", "blosc_tri_probe"};
+
+    double idleNs;
+    {
+        EngineFixture fx;
+        spinUpCpu();
+        stopHeadlessDriver(fx);
+        idleNs = runBenchmark("idle baseline", 3000).avgNs;
+    }
+
+    for (const char* probe : probes) {
+        double perVoice[2] = {0, 0};
+        for (int mode = 0; mode < 2; ++mode) {
+            EngineFixture fx;
+            REQUIRE(fx.loadSynthDef(probe));
+            for (int i = 0; i < kVoices; i++) {
+                osc_test::Builder b;
+                auto& s = b.begin("/s_new");
+                s << probe << (1000 + i) << 0 << 1 << "freq" << (110.0f + 37.0f * i)
+                  << "mode" << static_cast<float>(mode);
+                fx.send(b.end());
+            }
+            waitForSynths(fx, kVoices);
+            stopHeadlessDriver(fx);
+
+            char label[64];
+            snprintf(label, sizeof(label), "%dx %s mode %d", kVoices, probe, mode);
+            auto r = runBenchmark(label, 3000);
+            perVoice[mode] = (r.avgNs - idleNs) / kVoices;
+            CHECK(r.avgNs < r.budgetNs);
+        }
+        fprintf(stderr, "    %-20s  %6.0f ns/voice upstream  %6.0f ns/voice polynomial  (%.2fx)\n",
+                probe, perVoice[0], perVoice[1], perVoice[1] > 0 ? perVoice[0] / perVoice[1] : 0.0);
+    }
+    // Relative cost depends on the vector width the engine was built for; the
+    // printed table is the result.
+    SUCCEED();
+}
+
+TEST_CASE("benchmark: lane-parallel reverbs", "[.][benchmark]") {
+    // GVerb's probe allocates ~850KB of delay lines per instance, so keep the
+    // count well inside the default 8MB real-time pool.
+    constexpr int kInstances = 4;
+    const char* probes[] = {"reverb_freeverb_probe", "reverb_freeverb2_probe", "reverb_gverb_probe"};
+
+    double idleNs;
+    {
+        EngineFixture fx;
+        spinUpCpu();
+        stopHeadlessDriver(fx);
+        idleNs = runBenchmark("idle baseline", 3000).avgNs;
+    }
+
+    for (const char* probe : probes) {
+        double perInstance[2] = {0, 0};
+        for (int mode = 0; mode < 2; ++mode) {
+            EngineFixture fx;
+            REQUIRE(fx.loadSynthDef(probe));
+            for (int i = 0; i < kInstances; i++) {
+                osc_test::Builder b;
+                auto& s = b.begin("/s_new");
+                s << probe << (1000 + i) << 0 << 1 << "mode" << static_cast<float>(mode);
+                fx.send(b.end());
+            }
+            waitForSynths(fx, kInstances);
+            stopHeadlessDriver(fx);
+
+            char label[64];
+            snprintf(label, sizeof(label), "%dx %s mode %d", kInstances, probe, mode);
+            auto r = runBenchmark(label, 3000);
+            perInstance[mode] = (r.avgNs - idleNs) / kInstances;
+            CHECK(r.avgNs < r.budgetNs);
+        }
+        fprintf(stderr, "    %-24s  %6.0f ns/instance lanes  %6.0f ns/instance scalar  (%.2fx)\n",
+                probe, perInstance[0], perInstance[1], perInstance[0] > 0 ? perInstance[1] / perInstance[0] : 0.0);
+    }
+    // Per-instance cost includes the probe's LFSaw * LFPulse source; the
+    // printed table is the result.
+    SUCCEED();
+}
+
 TEST_CASE("benchmark: reproducibility check", "[.][benchmark]") {
     // Run the same benchmark twice and verify results are within 15%
     // If this fails, the benchmark environment is too noisy
@@ -488,3 +575,60 @@ TEST_CASE("benchmark: scaling test", "[.][benchmark]") {
         fprintf(stderr, "  CPU @ %d MHz (end of scaling test)\n", freqKHz / 1000);
     SUCCEED();
 }
+
+// =========================================================================
+// Ingest counters: per-thread shards vs one shared metrics line
+// =========================================================================
+
+// Total ops/s across `threads` threads each running `body(i)` `perThread` times.
+template <typename Fn>
+static double runThreads(int threads, int perThread, Fn body) {
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < perThread; i++) body(i);
+        });
+    }
+    while (ready.load() < threads) {}
+    int64_t t0 = nowNs();
+    go.store(true, std::memory_order_release);
+    for (auto& th : pool) th.join();
+    int64_t t1 = nowNs();
+    return (double)threads * perThread / ((double)(t1 - t0) / 1e9);
+}
+
+TEST_CASE("benchmark: ingest counters", "[.][benchmark]") {
+    EngineFixture fx;
+    auto* m = const_cast<PerformanceMetrics*>(fx.engine().metricsPtr());
+    auto pkt = osc_test::message("/status");
+    const uint32_t size = static_cast<uint32_t>(pkt.size());
+
+    fprintf(stderr, "\n  --- Ingest counters (ops/s, all threads) ---\n");
+    fprintf(stderr, "  %-8s %14s %14s %14s %14s\n",
+            "threads", "count shared", "count sharded", "ingest shared", "ingest sharded");
+    for (int threads : {1, 2, 4, 8}) {
+        double rate[4];
+        for (int sharded = 0; sharded < 2; sharded++) {
+            ss_counter_shards(m, sharded != 0);
+            // Just the counting an ingest does, with the audio thread still
+            // writing its counters into the same line.
+            rate[sharded] = runThreads(threads, 2000000, [&](int) {
+                ss_count(m, kSsCountOscOutMessages);
+                ss_count(m, kSsCountOscOutBytes, size);
+            });
+            // The whole ingest: ring write (or drop once the ring is full)
+            // plus counting.
+            rate[2 + sharded] = runThreads(threads, 100000, [&](int) {
+                fx.engine().ingest(pkt.ptr(), size, 0);
+            });
+        }
+        fprintf(stderr, "  %-8d %14.0f %14.0f %14.0f %14.0f\n",
+                threads, rate[0], rate[1], rate[2], rate[3]);
+    }
+    ss_counter_shards(m, true);
+    SUCCEED();
+}
@@ -0,0 +1,330 @@
+/*
+ * test_buffer_compaction.cpp — Tests for background compaction of
+ * sample-buffer memory.
+ *
+ * The direct heap tests cover the allocator hooks compaction is built on
+ * (area introspection, placement that avoids given areas, the release
+ * hold). The engine tests drive /supersonic/buffers/compact and
+ * /supersonic/buffers/stats and check that loaded samples survive a pass,
+ * including /b_free and /b_set arriving while it runs.
+ */
+#include "EngineFixture.h"
+#include "supersonic_heap.h"
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#ifndef SUPERSONIC_SAMPLES_DIR
+#define SUPERSONIC_SAMPLES_DIR ""
+#endif
+
+// ── Direct heap tests ───────────────────────────────────────────────────────
+
+TEST_CASE("supersonic_heap_areas reports the initial and growth areas", "[heap][compaction]") {
+    supersonic_heap_destroy();
+    supersonic_heap_init(256 * 1024);
+
+    supersonic_heap_area areas[8];
+    REQUIRE(supersonic_heap_areas(areas, 8) == 1);
+    CHECK(areas[0].initial);
+    CHECK(areas[0].numInUse == 0);
+
+    void* big = supersonic_heap_alloc(512 * 1024);
+    REQUIRE(big != nullptr);
+
+    size_t n = supersonic_heap_areas(areas, 8);
+    REQUIRE(n == 2);
+    size_t growth = areas[0].initial ? 1 : 0;
+    CHECK_FALSE(areas[growth].initial);
+    CHECK(areas[growth].numInUse == 1);
+    CHECK(areas[growth].inUse >= supersonic_heap_chunk_bytes(big));
+    CHECK((char*)big >= areas[growth].begin);
+    CHECK((char*)big < areas[growth].end);
+
+    supersonic_heap_free(big);
+    supersonic_heap_destroy();
+}
+
+TEST_CASE("supersonic_heap_alloc_avoiding never places into an excluded area", "[heap][compaction]") {
+    supersonic_heap_destroy();
+    supersonic_heap_init(256 * 1024);
+
+    // Pin a growth area with a small allocation, leaving most of it free
+    void* fill = supersonic_heap_alloc(200 * 1024);
+    void* pin = supersonic_heap_alloc(128 * 1024);
+    REQUIRE(fill != nullptr);
+    REQUIRE(pin != nullptr);
+
+    supersonic_heap_area areas[8];
+    size_t n = supersonic_heap_areas(areas, 8);
+    REQUIRE(n >= 2);
+    void* pinned = nullptr;
+    for (size_t i = 0; i < n; ++i)
+        if ((char*)pin >= areas[i].begin && (char*)pin < areas[i].end)
+            pinned = areas[i].base;
+    REQUIRE(pinned != nullptr);
+
+    void* moved = supersonic_heap_alloc_avoiding(64 * 1024, &pinned, 1);
+    REQUIRE(moved != nullptr);
+    n = supersonic_heap_areas(areas, 8);
+    for (size_t i = 0; i < n; ++i) {
+        if (areas[i].base == pinned) {
+            CHECK_FALSE(((char*)moved >= areas[i].begin && (char*)moved < areas[i].end));
+            CHECK(areas[i].numInUse == 1);
+        }
+    }
+
+    // The excluded area's free space is still usable afterwards
+    void* again = supersonic_heap_alloc(32 * 1024);
+    REQUIRE(again != nullptr);
+
+    supersonic_heap_free(again);
+    supersonic_heap_free(moved);
+    supersonic_heap_free(pin);
+    supersonic_heap_free(fill);
+    supersonic_heap_destroy();
+}
+
+TEST_CASE("supersonic_heap_areas counts every area and allocation", "[heap][compaction]") {
+    supersonic_heap_destroy();
+    supersonic_heap_init(64 * 1024);
+
+    // Too big for two to share a growth area
+    constexpr size_t kBig = 12 * 1024 * 1024;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 3; ++i) {
+        blocks.push_back(supersonic_heap_alloc(kBig));
+        REQUIRE(blocks.back() != nullptr);
+    }
+
+    // Asked for fewer than there are, the count is still whole
+    supersonic_heap_area one[1];
+    const size_t n = supersonic_heap_areas(one, 1);
+    REQUIRE(n == 4);
+    std::vector<supersonic_heap_area> areas(n);
+    REQUIRE(supersonic_heap_areas(areas.data(), n) == n);
+
+    std::vector<void*> growthBases;
+    for (const auto& a : areas) {
+        if (a.initial) {
+            CHECK(a.numInUse == 0);
+            continue;
+        }
+        growthBases.push_back(a.base);
+        REQUIRE(a.numInUse == 1);
+        bool found = false;
+        for (void* b : blocks)
+            if ((char*)b >= a.begin && (char*)b < a.end) {
+                CHECK(a.inUse == supersonic_heap_chunk_bytes(b));
+                found = true;
+            }
+        CHECK(found);
+    }
+
+    // The growth areas' tails are the big holes; without them only the
+    // initial area is left
+    CHECK(supersonic_heap_largest_free(nullptr, 0) > 64 * 1024);
+    CHECK(supersonic_heap_largest_free(growthBases.data(), growthBases.size()) <= 64 * 1024);
+
+    for (void* b : blocks) supersonic_heap_free(b);
+    supersonic_heap_destroy();
+}
+
+TEST_CASE("supersonic_heap holds emptied areas until the hold is dropped", "[heap][compaction]") {
+    supersonic_heap_destroy();
+    supersonic_heap_init(64 * 1024);
+
+    void* p = supersonic_heap_alloc(256 * 1024);
+    REQUIRE(p != nullptr);
+    size_t grown = supersonic_heap_total_allocated();
+    size_t releasedBefore = supersonic_heap_released_bytes();
+
+    supersonic_heap_hold_released_areas(true);
+    supersonic_heap_free(p);
+    // Still mapped: footprint unchanged while held
+    CHECK(supersonic_heap_total_allocated() == grown);
+    CHECK(supersonic_heap_released_bytes() == releasedBefore);
+
+    supersonic_heap_hold_released_areas(false);
+    CHECK(supersonic_heap_total_allocated() < grown);
+    CHECK(supersonic_heap_released_bytes() > releasedBefore);
+
+    supersonic_heap_destroy();
+}
+
+// ── Engine tests ────────────────────────────────────────────────────────────
+
+TEST_CASE("/supersonic/buffers/stats reports the heap", "[compaction]") {
+    EngineFixture fx;
+
+    fx.send(osc_test::message("/supersonic/buffers/stats"));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/buffers/stats.reply", r));
+    auto p = r.parsed();
+    CHECK(p.argInt(0) >= 1);                       // areas
+    CHECK(p.argInt(1) == p.argInt(0) - 1);         // growth areas
+    CHECK(p.argInt64(2) > 0);                      // reserved
+    CHECK(p.argInt64(5) <= p.argInt64(4));         // largest free <= free
+    CHECK(p.argInt(6) >= 0);
+    CHECK(p.argInt(6) <= 1000);
+}
+
+TEST_CASE("/supersonic/buffers/compact with nothing to move is a no-op", "[compaction]") {
+    EngineFixture fx;
+
+    fx.send(osc_test::message("/supersonic/buffers/compact"));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/buffers/compact.reply", r, 10000));
+    auto p = r.parsed();
+    CHECK(p.argInt(0) == 0);
+    CHECK(p.argInt(1) == 0);
+    CHECK(p.argInt(3) == 0);
+}
+
+TEST_CASE("compaction moves loaded samples out of a sparse growth area", "[compaction]") {
+    std::string path = std::string(SUPERSONIC_SAMPLES_DIR) + "/bd_haus.flac";
+    if (!std::filesystem::exists(path)) { SKIP("Sample not found"); }
+
+    EngineFixture fx;
+
+    // Fill most of the initial heap with plain buffers so the samples
+    // loaded next land in a growth area, then pad that growth area with
+    // more plain buffers and free them so only the samples remain.
+    constexpr int kFill = 6;        // 6 × 8 MB
+    constexpr int kPad = 3;         // 3 × 4 MB
+    constexpr int kSamples = 4;
+    for (int i = 0; i < kFill; ++i)
+        REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_alloc", 100 + i, 1024 * 1024, 2)));
+    for (int i = 0; i < kSamples; ++i) {
+        osc_test::Builder b;
+        b.begin("/b_allocRead") << int32_t(i) << path.c_str() << int32_t(0) << int32_t(0);
+        if (!fx.sendAndExpectDone(b.end(), 5000)) { SKIP("/b_allocRead not supported"); }
+    }
+    for (int i = 0; i < kPad; ++i)
+        REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_alloc", 200 + i, 1024 * 1024, 1)));
+
+    // Reference values from every loaded sample
+    auto probe = [&](int bufnum) {
+        fx.clearReplies();
+        osc_test::Builder b;
+        b.begin("/b_get") << int32_t(bufnum) << int32_t(0) << int32_t(17) << int32_t(1001);
+        fx.send(b.end());
+        OscReply r;
+        REQUIRE(fx.waitForReply("/b_set", r));
+        auto p = r.parsed();
+        return std::vector<float>{p.argFloat(2), p.argFloat(4), p.argFloat(6)};
+    };
+    std::vector<std::vector<float>> before;
+    for (int i = 0; i < kSamples; ++i) before.push_back(probe(i));
+
+    for (int i = 0; i < kPad; ++i)
+        REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_free", 200 + i)));
+    for (int i = 0; i < kFill; ++i)
+        REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_free", 100 + i)));
+
+    fx.clearReplies();
+    fx.send(osc_test::message("/supersonic/buffers/compact"));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/buffers/compact.reply", r, 10000));
+    auto p = r.parsed();
+    if (p.argInt(0) == 1) {
+        CHECK(p.argInt(1) >= 1);
+        CHECK(p.argInt64(2) > 0);
+        CHECK(p.argInt(3) >= 1);
+        CHECK(p.argInt64(4) > 0);
+
+        fx.clearReplies();
+        fx.send(osc_test::message("/supersonic/buffers/stats"));
+        OscReply s;
+        REQUIRE(fx.waitForReply("/supersonic/buffers/stats.reply", s));
+        CHECK(s.parsed().argInt(7) >= 1);                            // passes
+        CHECK(s.parsed().argInt64(8) >= p.argInt(1));                // buffers moved
+    }
+
+    // Whether or not anything moved, every sample reads back unchanged
+    for (int i = 0; i < kSamples; ++i) CHECK(probe(i) == before[i]);
+
+    for (int i = 0; i < kSamples; ++i)
+        fx.send(osc_test::message("/b_free", i));
+}
+
+// Samples in a growth area with nothing else left in it, as above: a
+// compaction pass has them to move.
+static bool loadSparseSamples(EngineFixture& fx, const std::string& path, int samples) {
+    for (int i = 0; i < 6; ++i)
+        if (!fx.sendAndExpectDone(osc_test::message("/b_alloc", 100 + i, 1024 * 1024, 2))) return false;
+    for (int i = 0; i < samples; ++i) {
+        osc_test::Builder b;
+        b.begin("/b_allocRead") << int32_t(i) << path.c_str() << int32_t(0) << int32_t(0);
+        if (!fx.sendAndExpectDone(b.end(), 5000)) return false;
+    }
+    for (int i = 0; i < 6; ++i)
+        if (!fx.sendAndExpectDone(osc_test::message("/b_free", 100 + i))) return false;
+    return true;
+}
+
+static int64_t heapInUse(EngineFixture& fx) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/supersonic/buffers/stats"));
+    OscReply r;
+    if (!fx.waitForReply("/supersonic/buffers/stats.reply", r)) return -1;
+    return r.parsed().argInt64(3);
+}
+
+TEST_CASE("/b_free during a compaction pass frees each sample once", "[compaction]") {
+    std::string path = std::string(SUPERSONIC_SAMPLES_DIR) + "/bd_haus.flac";
+    if (!std::filesystem::exists(path)) { SKIP("Sample not found"); }
+
+    EngineFixture fx;
+    const int64_t baseline = heapInUse(fx);
+    REQUIRE(baseline >= 0);
+
+    constexpr int kSamples = 4;
+    if (!loadSparseSamples(fx, path, kSamples)) { SKIP("/b_allocRead not supported"); }
+
+    // The frees land while the pass plans, copies and swaps. Whichever side
+    // gets a buffer first, it is freed exactly once and no copy leaks.
+    fx.clearReplies();
+    fx.send(osc_test::message("/supersonic/buffers/compact"));
+    for (int i = 0; i < kSamples; ++i)
+        fx.send(osc_test::message("/b_free", i));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/buffers/compact.reply", r, 10000));
+
+    CHECK(fx.pollUntil([&] { return heapInUse(fx) == baseline; }, 3000));
+
+    // The heap is still sound: a fresh buffer allocates and reads back.
+    REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_alloc", 7, 4096, 1)));
+    fx.send(osc_test::message("/b_set", 7, 10, 0.5f));
+    fx.clearReplies();
+    fx.send(osc_test::message("/b_get", 7, 10));
+    OscReply g;
+    REQUIRE(fx.waitForReply("/b_set", g));
+    CHECK(g.parsed().argFloat(2) == 0.5f);
+}
+
+TEST_CASE("a sample written during a compaction pass keeps the write", "[compaction]") {
+    std::string path = std::string(SUPERSONIC_SAMPLES_DIR) + "/bd_haus.flac";
+    if (!std::filesystem::exists(path)) { SKIP("Sample not found"); }
+
+    EngineFixture fx;
+    constexpr int kSamples = 4;
+    if (!loadSparseSamples(fx, path, kSamples)) { SKIP("/b_allocRead not supported"); }
+
+    // Before the snapshot the copy includes the write; after it, the write
+    // marks the buffer and the stale copy is dropped. Either way it stays.
+    fx.clearReplies();
+    fx.send(osc_test::message("/supersonic/buffers/compact"));
+    for (int i = 0; i < kSamples; ++i)
+        fx.send(osc_test::message("/b_set", i, 100, 0.25f));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/buffers/compact.reply", r, 10000));
+
+    for (int i = 0; i < kSamples; ++i) {
+        fx.clearReplies();
+        fx.send(osc_test::message("/b_get", i, 100));
+        OscReply g;
+        REQUIRE(fx.waitForReply("/b_set", g));
+        CHECK(g.parsed().argFloat(2) == 0.25f);
+    }
+}
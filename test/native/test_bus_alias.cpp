@@ -0,0 +1,136 @@
+/*
+ * test_bus_alias.cpp — zero-copy In.ar reads (GraphDef_FindBusAliases in
+ * SC_GraphDef.cpp, BusAlias_* in IOUGens.cpp).
+ *
+ * Readers of an In.ar are pointed at the bus instead of a copied wire when no
+ * bus writer runs between the In and its last reader, or when the writers
+ * there target other buses. /d_stats reports the aliased channels; the values
+ * the readers see must be what they would see copied.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "EngineFixture.h"
+#include "SynthDefWriter.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using osc_test::DefWriter;
+
+constexpr int16_t kMul = 2;  // BinaryOpUGen special index
+constexpr int32_t kBus = 40;
+
+bool load(EngineFixture& fx, const DefWriter& d) {
+    auto bytes = d.bytes();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+// DC.ar(0.25) onto audio bus 40.
+DefWriter writerDef() {
+    DefWriter d;
+    d.name = "alias_writer";
+    auto dc = d.add({"DC", 2, {d.c(0.25f)}, {2}});
+    d.add({"Out", 2, {d.c(kBus), dc}, {}});
+    return d;
+}
+
+// In.ar(40, 2) * 2 onto control buses 60, 61 (through A2K).
+DefWriter readerDef() {
+    DefWriter d;
+    d.name = "alias_reader";
+    auto in = d.add({"In", 2, {d.c(kBus)}, {2, 2}});
+    for (int32_t c = 0; c < 2; ++c) {
+        auto x = d.add({"BinaryOpUGen", 2, {{in.unit, c}, d.c(2)}, {2}, kMul});
+        auto k = d.add({"A2K", 1, {x}, {1}});
+        d.add({"Out", 1, {d.c(float(60 + c)), k}, {}});
+    }
+    return d;
+}
+
+// In.ar(40) read on both sides of a ReplaceOut.ar(40, 0.75): the late reader
+// must still see the value In read (onto control bus 62). The writer's bus is
+// a constant, so the def keeps an alias table and falls back every block.
+DefWriter hazardDef() {
+    DefWriter d;
+    d.name = "alias_hazard";
+    auto in = d.add({"In", 2, {d.c(kBus)}, {2}});
+    auto early = d.add({"A2K", 1, {in}, {1}});
+    auto dc = d.add({"DC", 2, {d.c(0.75f)}, {2}});
+    d.add({"ReplaceOut", 2, {d.c(kBus), dc}, {}});
+    auto late = d.add({"A2K", 1, {in}, {1}});
+    d.add({"Out", 1, {d.c(62), late}, {}});
+    d.add({"Out", 1, {d.c(63), early}, {}});
+    return d;
+}
+
+int aliasedChannels(EngineFixture& fx, const char* name) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/d_stats", name));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/d_stats.reply", r));
+    return r.parsed().argInt(6);
+}
+
+float bus(EngineFixture& fx, int32_t index) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/c_get", index));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/c_set", r));
+    return r.parsed().argFloat(1);
+}
+
+void start(EngineFixture& fx, const char* name, int32_t id) {
+    osc_test::Builder b;
+    b.begin("/s_new") << name << id << int32_t(1) << int32_t(1);  // tail of group 1
+    fx.send(b.end());
+}
+
+}  // namespace
+
+TEST_CASE("In.ar readers read the bus in place", "[bus_alias]") {
+    EngineFixture fx;
+    REQUIRE(load(fx, writerDef()));
+    REQUIRE(load(fx, readerDef()));
+    CHECK(aliasedChannels(fx, "alias_reader") == 2);
+    CHECK(aliasedChannels(fx, "alias_writer") == 0);
+
+    start(fx, "alias_writer", 1000);
+    start(fx, "alias_reader", 1001);
+    REQUIRE(fx.waitForBlocks(4));
+    CHECK(bus(fx, 60) == 0.5f);
+    CHECK(bus(fx, 61) == 0.0f);  // untouched bus reads as silence
+
+    // Nothing writes the bus any more: the readers must not see stale data.
+    fx.send(osc_test::message("/n_free", 1000));
+    REQUIRE(fx.waitForBlocks(4));
+    CHECK(bus(fx, 60) == 0.0f);
+}
+
+TEST_CASE("a bus writer between In.ar and its readers forces the copy", "[bus_alias]") {
+    EngineFixture fx;
+    REQUIRE(load(fx, writerDef()));
+    REQUIRE(load(fx, hazardDef()));
+
+    start(fx, "alias_writer", 1000);
+    start(fx, "alias_hazard", 1001);
+    REQUIRE(fx.waitForBlocks(4));
+    CHECK(bus(fx, 62) == 0.25f);
+    CHECK(bus(fx, 63) == 0.25f);
+}
+
+TEST_CASE("/d_optimise 0 leaves In.ar copying", "[bus_alias]") {
+    EngineFixture fx;
+    fx.send(osc_test::message("/d_optimise", 0));
+    OscReply ack;
+    REQUIRE(fx.waitForReply("/d_optimise.reply", ack));
+    REQUIRE(load(fx, writerDef()));
+    REQUIRE(load(fx, readerDef()));
+    CHECK(aliasedChannels(fx, "alias_reader") == 0);
+
+    start(fx, "alias_writer", 1000);
+    start(fx, "alias_reader", 1001);
+    REQUIRE(fx.waitForBlocks(4));
+    CHECK(bus(fx, 60) == 0.5f);
+    fx.send(osc_test::message("/d_optimise", 1));
+}
@@ -0,0 +1,138 @@
+/*
+ * test_bus_meter.cpp — built-in level meters (bus_meter.h, the METER arena
+ * region, server_shared_memory_client::request_meters / get_meters).
+ *
+ * Nothing is metered until a client writes a request. Once applied, every
+ * hardware output and each requested bus gets a row of peak, RMS and true
+ * peak that tracks what the graph wrote, and falls once it stops.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "EngineFixture.h"
+#include "SynthDefWriter.h"
+#include "audio_processor.h"   // get_shared_memory_base
+#include "shared_memory.h"
+#include "bus_meter.h"
+#include "synth/common/server_shm.hpp"
+
+#include <cmath>
+
+namespace {
+
+using osc_test::DefWriter;
+
+uint8_t* region() {
+    return static_cast<uint8_t*>(get_shared_memory_base()) + METER_START;
+}
+
+meter_view meters() { return read_meters(region()); }
+
+uint32_t request(const meter_request& req) { return write_meter_request(region(), req); }
+
+// DC.ar(level) onto audio bus `bus`.
+bool loadDc(EngineFixture& fx, const char* name, int32_t bus, float level) {
+    DefWriter d;
+    d.name = name;
+    auto dc = d.add({"DC", 2, {d.c(level)}, {2}});
+    d.add({"Out", 2, {d.c(float(bus)), dc}, {}});
+    auto bytes = d.bytes();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+void play(EngineFixture& fx, const char* name, int32_t id) {
+    osc_test::Builder b;
+    b.begin("/s_new") << name << id << int32_t(0) << int32_t(1);
+    fx.send(b.end());
+}
+
+}  // namespace
+
+TEST_CASE("true peak finds the peak between samples", "[meter]") {
+    // A quarter-rate sine at 45 degrees samples at +-0.707 and peaks at 1.
+    constexpr double kPi = 3.14159265358979323846;
+    float in[256];
+    for (int i = 0; i < 256; ++i)
+        in[i] = static_cast<float>(std::sin(kPi / 2.0 * i + kPi / 4.0));
+    float history[kSsMeterTaps - 1] = {};
+    ss_meter_true_peak(in, 64, history);   // fill the filter
+    const float tp = ss_meter_true_peak(in + 64, 192, history);
+    CHECK(tp == Catch::Approx(1.0f).margin(0.03f));
+
+    // DC passes at unity gain.
+    float dc[128];
+    for (float& s : dc) s = 0.5f;
+    float h2[kSsMeterTaps - 1] = {};
+    ss_meter_true_peak(dc, 128, h2);
+    CHECK(ss_meter_true_peak(dc, 128, h2) == Catch::Approx(0.5f).margin(1e-4f));
+}
+
+TEST_CASE("nothing is metered until requested", "[meter]") {
+    EngineFixture fx;
+    REQUIRE(fx.waitForBlocks(8));
+    CHECK_FALSE(meters().valid);
+}
+
+TEST_CASE("outputs and requested buses are metered", "[meter]") {
+    EngineFixture fx;
+    REQUIRE(loadDc(fx, "meter_out", 0, 0.5f));
+    REQUIRE(loadDc(fx, "meter_bus", 40, 0.25f));
+    play(fx, "meter_out", 1000);
+    play(fx, "meter_bus", 1001);
+
+    meter_request req;
+    req.true_peak = true;
+    req.rms_ms = 20;
+    req.bus_count = 3;
+    req.buses[0] = 40;
+    req.buses[1] = 1u << 30;   // no such bus: dropped
+    req.buses[2] = 41;         // nothing writes it
+    const uint32_t gen = request(req);
+    REQUIRE(fx.pollUntil([&] { auto m = meters(); return m.gen == gen && m.blocks > 100; }, 3000));
+
+    const meter_view m = meters();
+    REQUIRE(m.valid);
+    CHECK(m.flags == (METER_FLAG_ON | METER_FLAG_TRUE_PEAK));
+    CHECK(m.outputs >= 2);
+    REQUIRE(m.buses == 2);
+    CHECK(m.bus_ids[0] == 40);
+    CHECK(m.bus_ids[1] == 41);
+    CHECK(m.rms_ms == 20);
+    CHECK(m.peak_ms == kSsMeterDefaultPeakMs);
+
+    CHECK(m.output(0).peak == Catch::Approx(0.5f));
+    CHECK(m.output(0).rms == Catch::Approx(0.5f).margin(0.01f));
+    CHECK(m.output(0).true_peak == Catch::Approx(0.5f).margin(0.01f));
+    // The step from silence overshoots between samples (Gibbs), as it would
+    // after reconstruction.
+    CHECK(m.output(0).max >= 0.5f);
+    CHECK(m.output(0).max < 0.6f);
+    CHECK(m.output(1).peak == 0.f);
+    CHECK(m.bus(0).peak == Catch::Approx(0.25f));
+    CHECK(m.bus(0).rms == Catch::Approx(0.25f).margin(0.01f));
+    CHECK(m.bus(1).peak == 0.f);
+}
+
+TEST_CASE("levels fall once the signal stops", "[meter]") {
+    EngineFixture fx;
+    REQUIRE(loadDc(fx, "meter_fall", 0, 0.8f));
+    play(fx, "meter_fall", 1000);
+
+    meter_request req;
+    req.peak_ms = 100;
+    req.rms_ms = 20;
+    const uint32_t gen = request(req);
+    REQUIRE(fx.pollUntil([&] { auto m = meters(); return m.gen == gen && m.output(0).peak > 0.7f; }, 3000));
+
+    fx.send(osc_test::message("/n_free", 1000));
+    REQUIRE(fx.pollUntil([] { return meters().output(0).peak < 0.01f; }, 3000));
+    const meter_view m = meters();
+    CHECK(m.output(0).rms < 0.01f);
+    CHECK(m.output(0).max == Catch::Approx(0.8f));   // held
+    CHECK(m.output(0).true_peak == m.output(0).peak); // not requested
+
+    // Off: the applied generation moves on and no rows are published.
+    req.on = false;
+    const uint32_t off = request(req);
+    REQUIRE(fx.pollUntil([&] { return meters().gen == off; }, 3000));
+    CHECK(meters().outputs == 0);
+}
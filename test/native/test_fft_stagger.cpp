@@ -0,0 +1,92 @@
+/*
+ * test_fft_stagger.cpp — staggered FFT frame scheduling (FFT_UGens.cpp).
+ *
+ * Eight FFT chains with the same hop, started in one bundle, transform all in
+ * the same block upstream. Staggered, each synth gets its own hop phase, so
+ * the fftBlockPeak native stat drops to ceil(8 / hop-in-blocks). With the
+ * trailing align input set they keep upstream timing and peak at 8.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "EngineFixture.h"
+#include "SynthDefWriter.h"
+#include "audio_processor.h"   // get_shared_memory_base, g_world
+#include "shared_memory.h"     // NATIVE_STAT_FFT_*
+#include "SC_World.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace {
+
+using osc_test::DefWriter;
+
+constexpr int   kChains     = 8;
+constexpr int   kFrames     = 1024;
+constexpr float kHop        = 0.5f;
+constexpr int   kFirstBuf   = 20;
+
+uint32_t nativeStat(uint32_t offset) {
+    auto* ns = static_cast<uint8_t*>(get_shared_memory_base()) + NATIVE_STATS_START;
+    return reinterpret_cast<std::atomic<uint32_t>*>(ns + offset)->load(std::memory_order_relaxed);
+}
+
+std::string defName(int chain, bool align) {
+    return std::string(align ? "fft_aligned_" : "fft_staggered_") + std::to_string(chain);
+}
+
+// SinOsc.ar -> FFT(buf, sig, 0.5, 0, 1, 0[, align]) -> Out.kr
+bool loadChain(EngineFixture& fx, int chain, bool align) {
+    DefWriter d;
+    d.name = defName(chain, align);
+    auto sig = d.add({"SinOsc", 2, {d.c(440), d.c(0)}, {2}});
+    std::vector<DefWriter::Input> in = {d.c(float(kFirstBuf + chain)), sig, d.c(kHop), d.c(0), d.c(1), d.c(0)};
+    if (align) in.push_back(d.c(1));
+    auto fft = d.add({"FFT", 1, in, {1}});
+    d.add({"Out", 1, {d.c(float(100 + chain)), fft}, {}});
+    auto bytes = d.bytes();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+// Start every chain in one immediate bundle, so they all begin in one block.
+void startChains(EngineFixture& fx, bool align) {
+    std::vector<char> buf(4096);
+    osc::OutboundPacketStream s(buf.data(), buf.size());
+    s << osc::BeginBundleImmediate;
+    for (int i = 0; i < kChains; ++i)
+        s << osc::BeginMessage("/s_new") << defName(i, align).c_str() << int32_t(1000 + i) << int32_t(0)
+          << int32_t(1) << osc::EndMessage;
+    s << osc::EndBundle;
+    osc_test::Packet pkt;
+    pkt.data.assign(s.Data(), s.Data() + s.Size());
+    fx.send(pkt);
+}
+
+// The per-block peak from a publish window that saw only running chains.
+uint32_t steadyBlockPeak(EngineFixture& fx, bool align) {
+    for (int i = 0; i < kChains; ++i) {
+        REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_alloc", kFirstBuf + i, kFrames, 1)));
+        REQUIRE(loadChain(fx, i, align));
+    }
+    const uint32_t before = nativeStat(NATIVE_STAT_FFT_TRANSFORMS);
+    startChains(fx, align);
+    REQUIRE(fx.pollUntil([&] { return nativeStat(NATIVE_STAT_FFT_TRANSFORMS) > before; }, 3000));
+    REQUIRE(fx.waitForBlocks(200, 5000));
+    return nativeStat(NATIVE_STAT_FFT_BLOCK_PEAK);
+}
+
+int hopBlocks() { return static_cast<int>(kFrames * kHop) / g_world->mBufLength; }
+
+}  // namespace
+
+TEST_CASE("FFT chains started together spread their frames over the hop", "[fft]") {
+    EngineFixture fx;
+    const int hop = hopBlocks();
+    REQUIRE(hop >= 2);
+    CHECK(steadyBlockPeak(fx, false) == static_cast<uint32_t>((kChains + hop - 1) / hop));
+}
+
+TEST_CASE("the align input keeps FFT chains in phase", "[fft]") {
+    EngineFixture fx;
+    CHECK(steadyBlockPeak(fx, true) == static_cast<uint32_t>(kChains));
+}
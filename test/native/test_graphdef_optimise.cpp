@@ -0,0 +1,187 @@
+/*
+ * test_graphdef_optimise.cpp — load-time constant folding and dead-unit
+ * elimination (GraphDef_Optimise in SC_GraphDef.cpp), /d_optimise, /d_stats.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "EngineFixture.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Minimal SCgf v2 writer: enough to lay out a graph unit by unit.
+struct DefWriter {
+    struct Input { int32_t unit; int32_t index; };  // unit -1 => constant index
+    struct Ugen {
+        std::string name;
+        uint8_t rate;  // 0 ir, 1 kr, 2 ar
+        std::vector<Input> inputs;
+        std::vector<uint8_t> outputs;
+        int16_t special = 0;
+    };
+
+    std::string name;
+    std::vector<float> constants;
+    std::vector<Ugen> ugens;
+
+    Input c(float v) {
+        for (size_t i = 0; i < constants.size(); ++i)
+            if (constants[i] == v) return {-1, static_cast<int32_t>(i)};
+        constants.push_back(v);
+        return {-1, static_cast<int32_t>(constants.size() - 1)};
+    }
+    Input add(Ugen u) {
+        ugens.push_back(std::move(u));
+        return {static_cast<int32_t>(ugens.size() - 1), 0};
+    }
+
+    std::vector<uint8_t> bytes() const {
+        std::vector<uint8_t> b = {'S', 'C', 'g', 'f'};
+        auto i8  = [&](uint8_t v) { b.push_back(v); };
+        auto i16 = [&](int v) { i8(static_cast<uint8_t>(v >> 8)); i8(static_cast<uint8_t>(v)); };
+        auto i32 = [&](int32_t v) { for (int s = 24; s >= 0; s -= 8) i8(static_cast<uint8_t>(uint32_t(v) >> s)); };
+        auto f32 = [&](float f) { int32_t v; std::memcpy(&v, &f, 4); i32(v); };
+        auto str = [&](const std::string& s) { i8(static_cast<uint8_t>(s.size())); for (char ch : s) i8(static_cast<uint8_t>(ch)); };
+        i32(2); i16(1);
+        str(name);
+        i32(static_cast<int32_t>(constants.size()));
+        for (float f : constants) f32(f);
+        i32(0);  // controls
+        i32(0);  // param names
+        i32(static_cast<int32_t>(ugens.size()));
+        for (const auto& u : ugens) {
+            str(u.name); i8(u.rate);
+            i32(static_cast<int32_t>(u.inputs.size()));
+            i32(static_cast<int32_t>(u.outputs.size()));
+            i16(u.special);
+            for (const auto& in : u.inputs) { i32(in.unit); i32(in.index); }
+            for (uint8_t r : u.outputs) i8(r);
+        }
+        i16(0);  // variants
+        return b;
+    }
+};
+
+// BinaryOpUGen / UnaryOpUGen special indices.
+constexpr int16_t kMul = 2, kSqrt = 14, kRand = 37;
+
+// 11 units: a constant chain feeding a SinOsc's frequency and a control bus,
+// an unused SinOsc * 0.5 pair, and an unused (but RNG-drawing) rand.
+std::vector<uint8_t> probeDef() {
+    DefWriter d;
+    d.name = "opt_probe";
+    auto u0 = d.add({"BinaryOpUGen", 0, {d.c(440), d.c(2)}, {0}, kMul});    // 880
+    auto u1 = d.add({"BinaryOpUGen", 0, {u0, d.c(0.5f)}, {0}, kMul});       // 440
+    auto u2 = d.add({"UnaryOpUGen", 0, {u1}, {0}, kSqrt});                  // sqrt(440)
+    auto u3 = d.add({"SinOsc", 2, {d.c(333), d.c(0)}, {2}});                // unused
+    d.add({"BinaryOpUGen", 2, {u3, d.c(0.5f)}, {2}, kMul});                 // unused
+    auto u5 = d.add({"SinOsc", 2, {u1, d.c(0)}, {2}});
+    d.add({"UnaryOpUGen", 0, {d.c(3)}, {0}, kRand});                        // unused, kept
+    auto u7 = d.add({"MulAdd", 0, {u2, d.c(0.01f), d.c(0.1f)}, {0}});
+    auto u8 = d.add({"BinaryOpUGen", 2, {u5, u7}, {2}, kMul});
+    d.add({"Out", 2, {d.c(0), u8}, {}});
+    d.add({"Out", 1, {d.c(5), u2}, {}});
+    return d.bytes();
+}
+
+bool loadProbe(EngineFixture& fx) {
+    auto bytes = probeDef();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+struct Stats { int unitsRead, units, calcRead, calc, folded; };
+
+Stats queryStats(EngineFixture& fx) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/d_stats", "opt_probe"));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/d_stats.reply", r));
+    auto p = r.parsed();
+    REQUIRE(p.argString(0) == "opt_probe");
+    return {p.argInt(1), p.argInt(2), p.argInt(3), p.argInt(4), p.argInt(5)};
+}
+
+float controlBusAfterSynth(EngineFixture& fx) {
+    osc_test::Builder b;
+    auto& s = b.begin("/s_new");
+    s << "opt_probe" << 1000 << 0 << 1;
+    fx.send(b.end());
+    REQUIRE(fx.waitForBlocks(2));
+    fx.clearReplies();
+    fx.send(osc_test::message("/c_get", 5));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/c_set", r));
+    return r.parsed().argFloat(1);
+}
+
+}  // namespace
+
+TEST_CASE("GraphDefOptimise: folds constant math and drops unused units", "[GraphDefOptimise]") {
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx));
+
+    auto st = queryStats(fx);
+    CHECK(st.unitsRead == 11);
+    CHECK(st.folded == 4);       // 440*2, *0.5, sqrt, MulAdd
+    CHECK(st.units == 5);        // SinOsc, rand, *, Out, Out
+    CHECK(st.calcRead == 6);
+    CHECK(st.calc == 4);
+
+    fx.send(osc_test::message("/status"));
+    OscReply status;
+    REQUIRE(fx.waitForReply("/status.reply", status));
+    const int unitsBefore = status.parsed().argInt(1);
+
+    const float folded = controlBusAfterSynth(fx);
+    fx.clearReplies();
+    fx.send(osc_test::message("/status"));
+    REQUIRE(fx.waitForReply("/status.reply", status));
+    CHECK(status.parsed().argInt(1) - unitsBefore == 5);
+
+    // Unoptimised, the same def computes the same value per instance.
+    fx.send(osc_test::message("/n_free", 1000));
+    fx.clearReplies();
+    fx.send(osc_test::message("/d_optimise", 0));
+    OscReply ack;
+    REQUIRE(fx.waitForReply("/d_optimise.reply", ack));
+    CHECK(ack.parsed().argInt(0) == 0);
+    REQUIRE(loadProbe(fx));
+
+    auto plain = queryStats(fx);
+    CHECK(plain.unitsRead == 11);
+    CHECK(plain.units == 11);
+    CHECK(plain.calc == 6);
+    CHECK(plain.folded == 0);
+    CHECK(controlBusAfterSynth(fx) == folded);
+
+    fx.send(osc_test::message("/d_optimise", 1));
+    fx.send(osc_test::message("/n_free", 1000));
+}
+
+TEST_CASE("GraphDefOptimise: /u_cmd keeps synthdef unit indices", "[GraphDefOptimise]") {
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx));
+    osc_test::Builder b;
+    auto& s = b.begin("/s_new");
+    s << "opt_probe" << 1000 << 0 << 1;
+    fx.send(b.end());
+    REQUIRE(fx.waitForBlocks(2));
+
+    // Unit 3 (the unused SinOsc) was removed: addressing it is out of range
+    // rather than silently hitting whichever unit now sits at index 3.
+    fx.clearReplies();
+    {
+        osc_test::Builder ub;
+        auto& u = ub.begin("/u_cmd");
+        u << 1000 << 3 << "anything";
+        fx.send(ub.end());
+    }
+    OscReply fail;
+    REQUIRE(fx.waitForReply("/fail", fail));
+    CHECK(fail.parsed().argString(0) == "/u_cmd");
+    CHECK(fail.parsed().argString(1).find("index out of range") != std::string::npos);
+
+    fx.send(osc_test::message("/n_free", 1000));
+}
@@ -6,6 +6,7 @@
  */
 #include "EngineFixture.h"
 #include "supersonic_heap.h"
+#include "rt_alloc.h"
 #include <cstring>
 
 // ── Direct heap tests (bypass engine, test the allocator directly) ──────────
@@ -96,6 +97,89 @@ TEST_CASE("supersonic_heap destroy cleans up growth areas", "[heap][growth]") {
     supersonic_heap_destroy();
 }
 
+// ── Headroom: growth happens off the audio thread ───────────────────────────
+
+TEST_CASE("supersonic_heap RT churn stays inside the headroom", "[heap][headroom]") {
+#if defined(RT_ALLOC_HOOKS_UNAVAILABLE)
+    SKIP("needs the operator new/delete counters from test_rt_alloc.cpp, "
+         "which cannot link under TSan (see rt_alloc.h)");
+#else
+    supersonic_heap_destroy();
+    supersonic_heap_init(256 * 1024);
+    supersonic_heap_set_headroom(8 * 1024 * 1024);
+
+    // The maintenance thread's job, done here by hand
+    REQUIRE(supersonic_heap_needs_maintenance());
+    REQUIRE(supersonic_heap_maintain());
+    CHECK(supersonic_heap_free_bytes() >= 8 * 1024 * 1024);
+    CHECK_FALSE(supersonic_heap_needs_maintenance());
+
+    const size_t grown = supersonic_heap_growth_count();
+    const size_t footprint = supersonic_heap_total_allocated();
+    const size_t released = supersonic_heap_released_bytes();
+
+    // Large alloc/free churn on a thread marked as the audio thread. No
+    // Catch assertions inside the guard: they allocate.
+    int failed = 0;
+    void* huge = nullptr;
+    rt_alloc::reset();
+    {
+        rt_alloc::Guard g;
+        supersonic_heap_set_rt_thread(true);
+        for (int round = 0; round < 200; round++) {
+            void* p[3];
+            for (int i = 0; i < 3; i++) {
+                p[i] = supersonic_heap_alloc((512 + ((round * 3 + i) % 4) * 512) * 1024);
+                if (!p[i]) failed++;
+            }
+            for (int i = 0; i < 3; i++) supersonic_heap_free(p[i]);
+        }
+        // Bigger than any free chunk: refused rather than grown
+        huge = supersonic_heap_alloc(64 * 1024 * 1024);
+        supersonic_heap_set_rt_thread(false);
+    }
+
+    CHECK(rt_alloc::g_allocs.load(std::memory_order_relaxed) == 0);
+    CHECK(failed == 0);
+    CHECK(huge == nullptr);
+    CHECK(supersonic_heap_rt_growth_refused() == 1);
+    CHECK(supersonic_heap_growth_count() == grown);
+    CHECK(supersonic_heap_total_allocated() == footprint);
+    CHECK(supersonic_heap_released_bytes() == released);
+    CHECK(supersonic_heap_deferred_areas() == 0);
+
+    supersonic_heap_set_headroom(0);
+    supersonic_heap_destroy();
+#endif  // !RT_ALLOC_HOOKS_UNAVAILABLE
+}
+
+TEST_CASE("supersonic_heap defers area release from the audio thread", "[heap][headroom]") {
+    supersonic_heap_destroy();
+    supersonic_heap_init(256 * 1024);
+
+    // Grow off the audio thread, then free the area's only allocation on it
+    void* p = supersonic_heap_alloc(512 * 1024);
+    REQUIRE(p != nullptr);
+    REQUIRE(supersonic_heap_growth_count() == 1);
+    const size_t released = supersonic_heap_released_bytes();
+
+    supersonic_heap_set_rt_thread(true);
+    supersonic_heap_free(p);
+    CHECK_FALSE(supersonic_heap_maintain());  // no-op on the audio thread
+    supersonic_heap_set_rt_thread(false);
+
+    CHECK(supersonic_heap_deferred_areas() == 1);
+    CHECK(supersonic_heap_released_bytes() == released);
+    CHECK(supersonic_heap_needs_maintenance());
+
+    // With no headroom wanted, maintenance hands the area back
+    CHECK(supersonic_heap_maintain());
+    CHECK(supersonic_heap_deferred_areas() == 0);
+    CHECK(supersonic_heap_released_bytes() > released);
+
+    supersonic_heap_destroy();
+}
+
 // ── Engine integration test (uses the default 64MB heap) ────────────────────
 
 TEST_CASE("engine buffer allocation works with growable heap", "[heap][growth]") {
@@ -0,0 +1,126 @@
+/*
+ * test_idle.cpp — idle mode (process_audio's quiet-block skip, ss_idle_* in
+ * lanes.cpp, HeadlessDriver::idleSleep).
+ *
+ * With no synths and nothing due the engine stops running the graph and the
+ * headless driver sleeps through blocks, bounded by Config::idleSleepMs. The
+ * skipped blocks still advance processCount and the engine frames, an
+ * incoming message wakes the driver at once, and a bundle scheduled into the
+ * idle stretch still fires on time. The long sleep caps below make a missed
+ * wakeup show up as a timeout.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "EngineFixture.h"
+#include "SynthDefWriter.h"
+#include "audio_processor.h"   // get_shared_memory_base
+#include "shared_memory.h"     // NATIVE_STAT_IDLE_BLOCKS
+#include "WallClock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using osc_test::DefWriter;
+using Clock = std::chrono::steady_clock;
+
+uint32_t idleBlocks() {
+    auto* ns = static_cast<uint8_t*>(get_shared_memory_base()) + NATIVE_STATS_START;
+    return reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_IDLE_BLOCKS)
+        ->load(std::memory_order_relaxed);
+}
+
+SupersonicEngine::Config sleepyConfig() {
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.idleSleepMs = 3000;
+    return cfg;
+}
+
+// Q32.32 NTP timetag `ms` from now, on the wall clock the engine runs against.
+uint64_t ntpPlusMs(int ms) {
+    const double t = wallClockNTP() + ms / 1000.0;
+    const double secs = std::floor(t);
+    return (static_cast<uint64_t>(secs) << 32)
+         | static_cast<uint64_t>((t - secs) * 4294967296.0);
+}
+
+// A bundle at `timetag` holding /sync `id`.
+osc_test::Packet syncBundle(uint64_t timetag, int32_t id) {
+    std::vector<char> buf(256);
+    osc::OutboundPacketStream s(buf.data(), buf.size());
+    s << osc::BeginBundle(timetag) << osc::BeginMessage("/sync") << id << osc::EndMessage
+      << osc::EndBundle;
+    osc_test::Packet pkt;
+    pkt.data.assign(s.Data(), s.Data() + s.Size());
+    return pkt;
+}
+
+int elapsedMs(Clock::time_point since) {
+    return static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count());
+}
+
+}  // namespace
+
+TEST_CASE("an idle engine skips blocks until a synth runs", "[idle]") {
+    EngineFixture fx;
+    REQUIRE(fx.pollUntil([] { return idleBlocks() > 0; }, 3000));
+    // Skipped blocks count as blocks.
+    REQUIRE(fx.waitForBlocks(100));
+
+    DefWriter d;
+    d.name = "idle_probe";
+    d.add({"Out", 1, {d.c(90), d.add({"DC", 1, {d.c(0.5f)}, {1}})}, {}});
+    auto bytes = d.bytes();
+    REQUIRE(fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size())));
+    osc_test::Builder b;
+    b.begin("/s_new") << "idle_probe" << int32_t(1000) << int32_t(0) << int32_t(1);
+    fx.send(b.end());
+    REQUIRE(fx.waitForBlocks(4));
+
+    const uint32_t running = idleBlocks();
+    REQUIRE(fx.waitForBlocks(200, 5000));
+    CHECK(idleBlocks() == running);
+
+    fx.send(osc_test::message("/n_free", 1000));
+    CHECK(fx.pollUntil([&] { return idleBlocks() > running; }, 3000));
+}
+
+TEST_CASE("a message wakes a sleeping headless driver", "[idle]") {
+    EngineFixture fx(sleepyConfig());
+    const auto start = Clock::now();
+    const uint64_t framesBefore = fx.engineFrames();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    fx.clearReplies();
+    const auto sent = Clock::now();
+    fx.send(osc_test::message("/sync", 7));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/synced", r, 2000));
+    CHECK(elapsedMs(sent) < 1000);
+
+    // The blocks slept through were accounted: engine frames kept pace with
+    // the wall clock rather than freezing while the driver slept.
+    const double seconds = elapsedMs(start) / 1000.0;
+    const double frames = static_cast<double>(fx.engineFrames() - framesBefore);
+    CHECK(frames > 0.5 * seconds * 48000.0);
+    CHECK(frames < 1.5 * seconds * 48000.0 + 48000.0 * 0.05);
+    CHECK(idleBlocks() > 0);
+}
+
+TEST_CASE("a bundle scheduled while idle fires on time", "[idle]") {
+    EngineFixture fx(sleepyConfig());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    fx.clearReplies();
+    const auto sent = Clock::now();
+    fx.send(syncBundle(ntpPlusMs(400), 9));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/synced", r, 2500));
+    const int ms = elapsedMs(sent);
+    CHECK(ms >= 350);
+    CHECK(ms < 1500);
+}
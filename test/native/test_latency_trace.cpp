@@ -0,0 +1,141 @@
+/*
+ * test_latency_trace.cpp — command latency tracing (latency_trace.h, the
+ * LATENCY_TRACE arena region, ss_latency_trace, Config::latencyTrace).
+ *
+ * With tracing on, every command written through the ingress lane is
+ * stamped and its wait until performed (immediate) or fired (scheduled) is
+ * histogrammed per origin and delivery class. Off, nothing is recorded;
+ * turning it on again starts a fresh epoch.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "EngineFixture.h"
+#include "audio_processor.h"   // get_shared_memory_base
+#include "shared_memory.h"
+#include "latency_trace.h"
+#include "synth/common/server_shm.hpp"
+#include "WallClock.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+latency_trace_view trace() {
+    return read_latency_trace(static_cast<const uint8_t*>(get_shared_memory_base())
+                              + LATENCY_TRACE_START);
+}
+
+SupersonicEngine::Config tracedConfig() {
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.latencyTrace = true;
+    return cfg;
+}
+
+// Row of the histogram holding `origin`, or -1.
+int rowOf(const latency_trace_view& v, uint32_t origin) {
+    for (uint32_t i = 0; i < latency_trace_view::origins; ++i)
+        if (v.origin_ids[i] == origin + 1) return static_cast<int>(i);
+    return -1;
+}
+
+uint64_t rowTotal(const latency_trace_view& v, int row, uint32_t cls) {
+    uint64_t n = 0;
+    for (uint32_t b = 0; b < latency_trace_view::buckets; ++b)
+        n += v.counts[row][cls][b];
+    return n;
+}
+
+// A bundle `ms` from now holding /sync `id`.
+osc_test::Packet syncBundle(int ms, int32_t id) {
+    const double t = wallClockNTP() + ms / 1000.0;
+    const double secs = std::floor(t);
+    const uint64_t timetag = (static_cast<uint64_t>(secs) << 32)
+                           | static_cast<uint64_t>((t - secs) * 4294967296.0);
+    std::vector<char> buf(256);
+    osc::OutboundPacketStream s(buf.data(), buf.size());
+    s << osc::BeginBundle(timetag) << osc::BeginMessage("/sync") << id << osc::EndMessage
+      << osc::EndBundle;
+    osc_test::Packet pkt;
+    pkt.data.assign(s.Data(), s.Data() + s.Size());
+    return pkt;
+}
+
+}  // namespace
+
+TEST_CASE("latency buckets are log2 microseconds", "[latency_trace]") {
+    CHECK(ss_latency_bucket(0) == 0);
+    CHECK(ss_latency_bucket(1) == 1);
+    CHECK(ss_latency_bucket(2) == 2);
+    CHECK(ss_latency_bucket(3) == 2);
+    CHECK(ss_latency_bucket(1000) == 10);
+    CHECK(ss_latency_bucket(0xFFFFFFFFu) == LATENCY_TRACE_BUCKETS - 1);
+    CHECK(latency_trace_view::bucket_limit_us(10) == 1024);
+}
+
+TEST_CASE("a stamp only matches the sequence number it was written for", "[latency_trace]") {
+    ss_latency_clear_stamps();
+    uint32_t us = 0;
+    CHECK_FALSE(ss_latency_stamp_of(0, us));
+    CHECK_FALSE(ss_latency_stamp_of(1, us));
+    ss_latency_stamp(7, 1234);
+    REQUIRE(ss_latency_stamp_of(7, us));
+    CHECK(us == 1234);
+    CHECK_FALSE(ss_latency_stamp_of(7 + kSsLatencyStampSlots, us));
+    ss_latency_clear_stamps();
+}
+
+TEST_CASE("immediate commands are traced per origin", "[latency_trace]") {
+    EngineFixture fx(tracedConfig());
+    REQUIRE(fx.pollUntil([] { return trace().enabled; }, 2000));
+
+    osc_test::Packet sync = osc_test::message("/sync", 1);
+    for (int i = 0; i < 5; ++i) fx.send(sync);
+    for (int i = 0; i < 3; ++i) fx.engine().ingest(sync.ptr(), sync.size(), 42);
+    REQUIRE(fx.pollUntil([] { return trace().total(kSsLatencyClassImmediate) >= 8; }, 3000));
+
+    const latency_trace_view v = trace();
+    const int inProcess = rowOf(v, 0);
+    const int peer = rowOf(v, 42);
+    REQUIRE(inProcess >= 0);
+    REQUIRE(peer >= 0);
+    CHECK(rowTotal(v, inProcess, kSsLatencyClassImmediate) >= 5);
+    CHECK(rowTotal(v, peer, kSsLatencyClassImmediate) == 3);
+    CHECK(v.total(kSsLatencyClassBundle) == 0);
+    // Waits are bounded by the block period plus scheduling jitter, not by
+    // anything like the bucket range.
+    CHECK(v.max_us[kSsLatencyClassImmediate] < 1000000);
+}
+
+TEST_CASE("a scheduled bundle is traced from ingest to fire", "[latency_trace]") {
+    EngineFixture fx(tracedConfig());
+    REQUIRE(fx.pollUntil([] { return trace().enabled; }, 2000));
+
+    fx.clearReplies();
+    fx.send(syncBundle(200, 3));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/synced", r, 3000));
+    REQUIRE(fx.pollUntil([] { return trace().total(kSsLatencyClassBundle) == 1; }, 2000));
+    // Its time in the scheduler pool counts: at least most of the lead.
+    CHECK(trace().max_us[kSsLatencyClassBundle] >= 150000);
+}
+
+TEST_CASE("tracing off records nothing and on again resets", "[latency_trace]") {
+    EngineFixture fx;
+    REQUIRE(fx.waitForBlocks(4));
+    CHECK_FALSE(trace().enabled);
+    fx.send(osc_test::message("/sync", 1));
+    REQUIRE(fx.waitForBlocks(4));
+    CHECK(trace().total(kSsLatencyClassImmediate) == 0);
+
+    fx.engine().setLatencyTrace(true);
+    REQUIRE(fx.pollUntil([] { return trace().enabled; }, 2000));
+    fx.send(osc_test::message("/sync", 2));
+    REQUIRE(fx.pollUntil([] { return trace().total(kSsLatencyClassImmediate) == 1; }, 2000));
+    const uint32_t epoch = trace().epoch;
+
+    fx.engine().setLatencyTrace(false);
+    fx.engine().setLatencyTrace(true);
+    REQUIRE(fx.pollUntil([&] { return trace().epoch != epoch; }, 2000));
+    CHECK(trace().total(kSsLatencyClassImmediate) == 0);
+    fx.engine().setLatencyTrace(false);
+}
@@ -14,9 +14,11 @@
 #include "OscBuilder.h"
 #include "WallClock.h"
 #include "src/shared_memory.h"
+#include "src/metrics_shards.h"
 
 #include <thread>
 #include <chrono>
+#include <vector>
 
 extern "C" uint8_t ring_buffer_storage[];
 
@@ -181,6 +183,43 @@ TEST_CASE("metrics: osc_out_bytes_sent increments by message size",
     CHECK(after >= before + pkt.size());
 }
 
+TEST_CASE("metrics: concurrent ingest is counted exactly",
+          "[metrics][osc-out]") {
+    // Each transport thread counts into its own shard; getMetrics() folds
+    // them in, so every message shows up as either sent or dropped.
+    EngineFixture fx;
+    const uint32_t sentBefore = metrics(fx).osc_out_messages_sent.load();
+    const uint32_t dropBefore = metrics(fx).messages_dropped.load();
+    auto pkt = osc_test::message("/status");
+    constexpr int kThreads = 4, kEach = 500;
+    std::vector<std::thread> senders;
+    for (int t = 0; t < kThreads; t++)
+        senders.emplace_back([&] {
+            for (int i = 0; i < kEach; i++)
+                fx.engine().ingest(pkt.ptr(), static_cast<uint32_t>(pkt.size()), 0);
+        });
+    for (auto& s : senders) s.join();
+    const uint32_t sent = metrics(fx).osc_out_messages_sent.load() - sentBefore;
+    const uint32_t dropped = metrics(fx).messages_dropped.load() - dropBefore;
+    CHECK(sent + dropped == kThreads * kEach);
+}
+
+TEST_CASE("metrics: a shard keeps its counts when its thread exits",
+          "[metrics][osc-out]") {
+    PerformanceMetrics m{};
+    ss_counter_shards(&m, true);
+    for (int round = 0; round < 3; round++)
+        std::thread([&] { ss_count(&m, kSsCountOscOutBytes, 7); }).join();
+    ss_counter_publish(&m);
+    CHECK(m.osc_out_bytes_sent.load() == 21);
+
+    // Off publishes what is outstanding, then counts go straight to the field.
+    std::thread([&] { ss_count(&m, kSsCountOscOutBytes, 5); }).join();
+    ss_counter_shards(&m, false);
+    ss_count(&m, kSsCountOscOutBytes, 1);
+    CHECK(m.osc_out_bytes_sent.load() == 27);
+}
+
 // ============================================================================
 // OSC In [26-29]
 // ============================================================================
@@ -0,0 +1,241 @@
+/*
+ * test_midi_map.cpp — In-engine MIDI-to-synth mapping (MidiMap)
+ *
+ * Rules are configured and /midi/in events fed straight into the engine's
+ * MidiMap, standing in for the MIDI input thread, so no device (or the Rust
+ * subsystem) is needed. The mapped scsynth commands go through the real
+ * ingest path, so the synths, buses and node controls here are the engine's.
+ *
+ * The latency benchmark is a loopback harness: it compares a mapped note with
+ * the client round trip it replaces (event out to the client, /s_new back).
+ * Run with:  ./SuperSonicNativeTests "[midi_map][benchmark]"
+ */
+#include "EngineFixture.h"
+#include <catch2/catch_approx.hpp>
+#include "MidiMap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Apply one "/midi/map/" command; returns its reply's ok flag (or, for
+// verbs without one, the first argument).
+static int mapCommand(EngineFixture& fx, const osc_test::Packet& pkt) {
+    int result = -1;
+    fx.engine().midiMap().handleCommand(pkt.ptr(), pkt.size(),
+        [&](const uint8_t* data, uint32_t size) {
+            auto p = osc_test::parseReply(data, size);
+            result = p.argCount() >= 2 ? p.argInt(1) : p.argInt(0);
+        });
+    return result;
+}
+
+static int midiIn(EngineFixture& fx, const char* verb, int channel, int a, int b = -1) {
+    osc_test::Builder m;
+    auto& s = m.begin((std::string("/midi/in/") + verb).c_str());
+    s << "test-port" << int32_t(channel) << int32_t(a);
+    if (b >= 0) s << int32_t(b);
+    auto pkt = m.end();
+    return fx.engine().midiMap().midiIn(pkt.ptr(), pkt.size());
+}
+
+static float nodeControl(EngineFixture& fx, int32_t node, const char* control) {
+    fx.clearReplies();
+    osc_test::Builder b;
+    b.begin("/s_get") << node << control;
+    fx.send(b.end());
+    OscReply r;
+    REQUIRE(fx.waitForReply("/n_set", r));
+    return r.parsed().argFloat(2);
+}
+
+static float bus(EngineFixture& fx, int32_t index) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/c_get", index));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/c_set", r));
+    return r.parsed().argFloat(1);
+}
+
+static osc_test::Packet rodeoRule(int32_t id) {
+    osc_test::Builder b;
+    b.begin("/midi/map/notes") << id << "*" << int32_t(0) << "sonic-pi-rodeo" << int32_t(1)
+        << "vel_max" << 0.5f << "release" << 0.01f;
+    return b.end();
+}
+
+TEST_CASE("mapped note-on plays a synth and note-off releases it", "[midi_map]") {
+    EngineFixture fx;
+    REQUIRE(fx.loadSynthDef("sonic-pi-rodeo"));
+    fx.send(osc_test::message("/notify", 1));
+    REQUIRE(mapCommand(fx, rodeoRule(1)) == 1);
+
+    fx.clearReplies();
+    CHECK(midiIn(fx, "note_on", 1, 64, 127) == 1);
+    OscReply go;
+    REQUIRE(fx.waitForReply("/n_go", go));
+    const int32_t node = go.parsed().argInt(0);
+    CHECK(node >= MidiMap::kNodeBase);
+    CHECK(nodeControl(fx, node, "note") == 64.0f);
+    CHECK(nodeControl(fx, node, "amp") == 0.5f);
+    CHECK(fx.engine().midiMap().stats().voices == 1);
+
+    fx.clearReplies();
+    CHECK(midiIn(fx, "note_off", 1, 64, 0) == 1);
+    OscReply end;
+    REQUIRE(fx.waitForReply("/n_end", end, 3000));
+    CHECK(end.parsed().argInt(0) == node);
+    CHECK(fx.engine().midiMap().stats().voices == 0);
+}
+
+TEST_CASE("note rules honour channel and note range", "[midi_map]") {
+    EngineFixture fx;
+    osc_test::Builder b;
+    b.begin("/midi/map/notes") << int32_t(1) << "*" << int32_t(2) << "sonic-pi-rodeo" << int32_t(1)
+        << "low" << int32_t(36) << "high" << int32_t(47);
+    REQUIRE(mapCommand(fx, b.end()) == 1);
+
+    CHECK(midiIn(fx, "note_on", 1, 40, 100) == 0);   // wrong channel
+    CHECK(midiIn(fx, "note_on", 2, 60, 100) == 0);   // out of range
+    CHECK(midiIn(fx, "note_on", 2, 40, 100) == 1);
+    CHECK(midiIn(fx, "note_on", 2, 40, 100) == 2);   // retrigger: release + new
+    CHECK(fx.engine().midiMap().stats().voices == 1);
+}
+
+TEST_CASE("CC maps onto a control bus with scaling", "[midi_map]") {
+    EngineFixture fx;
+    osc_test::Builder lin;
+    lin.begin("/midi/map/cc") << int32_t(1) << "*" << int32_t(0) << int32_t(7)
+        << "bus" << int32_t(5) << -1.0f << 1.0f;
+    REQUIRE(mapCommand(fx, lin.end()) == 1);
+    osc_test::Builder exp;
+    exp.begin("/midi/map/cc") << int32_t(2) << "*" << int32_t(0) << int32_t(74)
+        << "bus" << int32_t(6) << 100.0f << 10000.0f << "exp";
+    REQUIRE(mapCommand(fx, exp.end()) == 1);
+
+    CHECK(midiIn(fx, "control_change", 3, 7, 127) == 1);
+    CHECK(midiIn(fx, "control_change", 3, 74, 0) == 1);
+    CHECK(midiIn(fx, "control_change", 3, 1, 64) == 0);   // unmapped controller
+    fx.waitForBlocks(2);
+    CHECK(bus(fx, 5) == 1.0f);
+    CHECK(bus(fx, 6) == Catch::Approx(100.0f));
+
+    midiIn(fx, "control_change", 3, 74, 127);
+    fx.waitForBlocks(2);
+    CHECK(bus(fx, 6) == Catch::Approx(10000.0f));
+}
+
+TEST_CASE("pitch bend sets a node control, centred on the range", "[midi_map]") {
+    EngineFixture fx;
+    REQUIRE(fx.loadSynthDef("sonic-pi-rodeo"));
+    fx.send(osc_test::message("/notify", 1));
+    REQUIRE(mapCommand(fx, rodeoRule(1)) == 1);
+    osc_test::Builder b;
+    b.begin("/midi/map/bend") << int32_t(2) << "*" << int32_t(0)
+        << "node" << int32_t(1) << "cutoff" << 60.0f << 120.0f;
+    REQUIRE(mapCommand(fx, b.end()) == 1);
+
+    fx.clearReplies();
+    midiIn(fx, "note_on", 1, 60, 100);
+    OscReply go;
+    REQUIRE(fx.waitForReply("/n_go", go));
+    const int32_t node = go.parsed().argInt(0);
+
+    CHECK(midiIn(fx, "pitch_bend", 1, 8192) == 1);   // group 1 holds the voice
+    fx.waitForBlocks(2);
+    CHECK(nodeControl(fx, node, "cutoff") == 90.0f);
+    midiIn(fx, "pitch_bend", 1, 16383);
+    fx.waitForBlocks(2);
+    CHECK(nodeControl(fx, node, "cutoff") == 120.0f);
+    midiIn(fx, "pitch_bend", 1, 0);
+    fx.waitForBlocks(2);
+    CHECK(nodeControl(fx, node, "cutoff") == 60.0f);
+}
+
+TEST_CASE("map rules are validated, replaced, listed and removed", "[midi_map]") {
+    EngineFixture fx;
+    osc_test::Builder badCurve;
+    badCurve.begin("/midi/map/cc") << int32_t(1) << "*" << int32_t(0) << int32_t(7)
+        << "bus" << int32_t(0) << 0.0f << 1.0f << "exp";   // exp needs min > 0
+    CHECK(mapCommand(fx, badCurve.end()) == 0);
+    osc_test::Builder badTarget;
+    badTarget.begin("/midi/map/bend") << int32_t(1) << "*" << int32_t(0)
+        << "synth" << int32_t(0) << 0.0f << 1.0f;
+    CHECK(mapCommand(fx, badTarget.end()) == 0);
+    osc_test::Builder badChannel;
+    badChannel.begin("/midi/map/notes") << int32_t(1) << "*" << int32_t(17) << "x" << int32_t(1);
+    CHECK(mapCommand(fx, badChannel.end()) == 0);
+
+    REQUIRE(mapCommand(fx, rodeoRule(1)) == 1);
+    REQUIRE(mapCommand(fx, rodeoRule(1)) == 1);   // same id replaces
+    REQUIRE(mapCommand(fx, rodeoRule(2)) == 1);
+    CHECK(fx.engine().midiMap().stats().rules == 2);
+
+    osc_test::Packet list = osc_test::message("/midi/map/list");
+    osc_test::ParsedReply listed;
+    fx.engine().midiMap().handleCommand(list.ptr(), list.size(),
+        [&](const uint8_t* data, uint32_t size) { listed = osc_test::parseReply(data, size); });
+    CHECK(listed.argInt(0) == 2);
+    CHECK(listed.argInt(4) == 1);
+    CHECK(listed.argString(5) == "notes");
+
+    CHECK(mapCommand(fx, osc_test::message("/midi/map/remove", 1)) == 1);
+    CHECK(mapCommand(fx, osc_test::message("/midi/map/remove", 1)) == 0);
+    CHECK(mapCommand(fx, osc_test::message("/midi/map/clear")) == 1);
+    CHECK(fx.engine().midiMap().stats().rules == 0);
+}
+
+// ── Latency: mapped note vs client round trip ───────────────────────────────
+
+static double percentile(std::vector<double> v, double p) {
+    std::sort(v.begin(), v.end());
+    return v[static_cast<size_t>(p * (v.size() - 1))];
+}
+
+TEST_CASE("benchmark: MIDI note-to-sound latency", "[.][benchmark][midi_map]") {
+    EngineFixture fx;
+    REQUIRE(fx.loadSynthDef("sonic-pi-rodeo"));
+    fx.send(osc_test::message("/notify", 1));
+    REQUIRE(mapCommand(fx, rodeoRule(1)) == 1);
+    constexpr int kNotes = 50;
+    using clock = std::chrono::steady_clock;
+    auto ms = [](clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    // Client round trip: the event reaches the client through the egress (a
+    // /sync -> /synced hop stands in for the /midi/in broadcast), then the
+    // client's /s_new goes back through the IN ring.
+    std::vector<double> roundTrip;
+    for (int i = 0; i < kNotes; ++i) {
+        fx.clearReplies();
+        const auto t0 = clock::now();
+        fx.send(osc_test::message("/sync", i));
+        OscReply r;
+        REQUIRE(fx.waitForReply("/synced", r));
+        osc_test::Builder b;
+        b.begin("/s_new") << "sonic-pi-rodeo" << int32_t(1000 + i) << int32_t(0) << int32_t(1)
+            << "note" << 60.0f << "release" << 0.01f;
+        fx.send(b.end());
+        REQUIRE(fx.waitForReply("/n_go", r));
+        roundTrip.push_back(ms(clock::now() - t0));
+        fx.send(osc_test::message("/n_free", 1000 + i));
+    }
+
+    // Mapped: the MIDI thread writes /s_new into the IN ring itself.
+    std::vector<double> mapped;
+    for (int i = 0; i < kNotes; ++i) {
+        fx.clearReplies();
+        const auto t0 = clock::now();
+        midiIn(fx, "note_on", 1, 60, 100);
+        OscReply r;
+        REQUIRE(fx.waitForReply("/n_go", r));
+        mapped.push_back(ms(clock::now() - t0));
+        midiIn(fx, "note_off", 1, 60, 0);
+    }
+
+    fprintf(stderr, "\n  MIDI note -> /n_go latency (%d notes)\n", kNotes);
+    fprintf(stderr, "    client round trip  median %.3f ms  p95 %.3f ms\n",
+            percentile(roundTrip, 0.5), percentile(roundTrip, 0.95));
+    fprintf(stderr, "    in-engine map      median %.3f ms  p95 %.3f ms\n\n",
+            percentile(mapped, 0.5), percentile(mapped, 0.95));
+    CHECK(percentile(mapped, 0.5) <= percentile(roundTrip, 0.5));
+}
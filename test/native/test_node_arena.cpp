@@ -0,0 +1,205 @@
+/*
+ * test_node_arena.cpp — per-node constructor arenas (Graph_Arena* in
+ * SC_Graph.cpp), /d_arena, and the arena* native stats.
+ *
+ * The first instance of a def takes its constructors' allocations from the
+ * pool and records how much they asked for (arenaBytes in /d_stats). Later
+ * instances get one block of that size up front and the constructors bump
+ * through it, so no constructor allocation reaches the pool. Unit commands
+ * may RTRealloc and RTFree that memory later (ArenaCmdDemo, DemoUGens.cpp).
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "EngineFixture.h"
+#include "SynthDefWriter.h"
+#include "audio_processor.h"   // get_shared_memory_base
+#include "shared_memory.h"     // NATIVE_STAT_ARENA_*
+
+#include <atomic>
+
+namespace {
+
+using osc_test::DefWriter;
+
+constexpr uint32_t kCtorAllocs = 2;  // DelayN and CombN delay lines
+
+uint32_t nativeStat(uint32_t offset) {
+    auto* ns = static_cast<uint8_t*>(get_shared_memory_base()) + NATIVE_STATS_START;
+    return reinterpret_cast<std::atomic<uint32_t>*>(ns + offset)->load(std::memory_order_relaxed);
+}
+
+struct Counts { uint32_t arena, pool, synths; };
+
+Counts counts() {
+    return {nativeStat(NATIVE_STAT_ARENA_ALLOCS), nativeStat(NATIVE_STAT_ARENA_POOL_ALLOCS),
+            nativeStat(NATIVE_STAT_ARENA_SYNTHS)};
+}
+
+// DelayN.ar(DC.ar(0.5), 0.01, 0.001) onto control bus 70, and a CombN on the
+// same signal onto control bus 71 (both through A2K).
+bool loadProbe(EngineFixture& fx) {
+    DefWriter d;
+    d.name = "arena_probe";
+    auto dc = d.add({"DC", 2, {d.c(0.5f)}, {2}});
+    auto delay = d.add({"DelayN", 2, {dc, d.c(0.01f), d.c(0.001f)}, {2}});
+    auto comb = d.add({"CombN", 2, {dc, d.c(0.02f), d.c(0.01f), d.c(0.1f)}, {2}});
+    d.add({"Out", 1, {d.c(70), d.add({"A2K", 1, {delay}, {1}})}, {}});
+    d.add({"Out", 1, {d.c(71), d.add({"A2K", 1, {comb}, {1}})}, {}});
+    auto bytes = d.bytes();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+int arenaBytes(EngineFixture& fx, const char* def = "arena_probe") {
+    fx.clearReplies();
+    fx.send(osc_test::message("/d_stats", def));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/d_stats.reply", r));
+    return r.parsed().argInt(7);
+}
+
+float bus(EngineFixture& fx, int32_t index) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/c_get", index));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/c_set", r));
+    return r.parsed().argFloat(1);
+}
+
+// ArenaCmdDemo.kr onto control bus 72: the sum of its constructor table.
+bool loadCmdProbe(EngineFixture& fx) {
+    DefWriter d;
+    d.name = "arena_cmd";
+    auto table = d.add({"ArenaCmdDemo", 1, {}, {1}});
+    d.add({"Out", 1, {d.c(72), table}, {}});
+    auto bytes = d.bytes();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+// Start one probe and wait until the stats show its constructors ran.
+Counts spawn(EngineFixture& fx, int32_t id, const char* def = "arena_probe") {
+    const Counts before = counts();
+    osc_test::Builder b;
+    b.begin("/s_new") << def << id << int32_t(0) << int32_t(1);
+    fx.send(b.end());
+    REQUIRE(fx.pollUntil([&] { return counts().synths > before.synths; }, 3000));
+    const Counts after = counts();
+    return {after.arena - before.arena, after.pool - before.pool, after.synths - before.synths};
+}
+
+void setArena(EngineFixture& fx, int enabled) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/d_arena", enabled));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/d_arena.reply", r));
+    REQUIRE(r.parsed().argInt(0) == enabled);
+}
+
+}  // namespace
+
+TEST_CASE("constructors bump through the node arena after the first instance", "[arena]") {
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx));
+    CHECK(arenaBytes(fx) == 0);
+
+    auto first = spawn(fx, 1000);
+    CHECK(first.pool == kCtorAllocs);
+    CHECK(first.arena == 0);
+    CHECK(arenaBytes(fx) > 0);
+
+    fx.send(osc_test::message("/n_free", 1000));
+    auto second = spawn(fx, 1001);
+    CHECK(second.arena == kCtorAllocs);
+    CHECK(second.pool == 0);
+
+    // The delay lines in the arena behave like pool ones.
+    REQUIRE(fx.waitForBlocks(8));
+    CHECK(bus(fx, 70) == 0.5f);
+    CHECK(bus(fx, 71) > 0.5f);
+
+    // Freeing the node hands the arena back; the pool keeps working.
+    fx.send(osc_test::message("/n_free", 1001));
+    auto third = spawn(fx, 1002);
+    CHECK(third.arena == kCtorAllocs);
+}
+
+TEST_CASE("/d_arena 0 sends constructor allocations to the pool", "[arena]") {
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx));
+    spawn(fx, 1000);
+    setArena(fx, 0);
+
+    auto off = spawn(fx, 1001);
+    CHECK(off.pool == kCtorAllocs);
+    CHECK(off.arena == 0);
+    REQUIRE(fx.waitForBlocks(8));
+    CHECK(bus(fx, 70) == 0.5f);
+
+    setArena(fx, 1);
+}
+
+TEST_CASE("unit commands reallocate and free arena memory", "[arena]") {
+    EngineFixture fx;
+    REQUIRE(loadCmdProbe(fx));
+    spawn(fx, 1000, "arena_cmd");
+    fx.send(osc_test::message("/n_free", 1000));
+
+    for (int32_t id = 1001; id <= 1004; ++id) {
+        auto s = spawn(fx, id, "arena_cmd");
+        REQUIRE(s.arena == 1);   // the table is in the node's arena
+        REQUIRE(fx.waitForBlocks(2));
+        CHECK(bus(fx, 72) == 4.f);
+
+        // Arena block to pool block, then pool to pool; the node's free
+        // then RTFrees a pool block and hands the arena back.
+        for (int32_t size : {64, 8}) {
+            osc_test::Builder b;
+            b.begin("/u_cmd") << id << int32_t(0) << "resize" << size;
+            fx.send(b.end());
+            REQUIRE(fx.waitForBlocks(2));
+            CHECK(bus(fx, 72) == float(size));
+        }
+        fx.send(osc_test::message("/n_free", id));
+    }
+
+    // The pool is intact: the delay-line probe still builds and runs.
+    REQUIRE(loadProbe(fx));
+    spawn(fx, 1100);
+    REQUIRE(fx.waitForBlocks(8));
+    CHECK(bus(fx, 70) == 0.5f);
+}
+
+TEST_CASE("one large instance does not size a def's arena for good", "[arena]") {
+    EngineFixture fx;
+    // DelayN.ar(DC.ar(0.5), max, 0.001) onto control bus 73: the delay line,
+    // and so the constructors' demand, follows the "max" control.
+    DefWriter d;
+    d.name = "arena_var";
+    d.controls = {0.01f};
+    d.params = {{"max", 0}};
+    auto ctl = d.add({"Control", 1, {}, {1}, 0});
+    auto dc = d.add({"DC", 2, {d.c(0.5f)}, {2}});
+    auto delay = d.add({"DelayN", 2, {dc, ctl, d.c(0.001f)}, {2}});
+    d.add({"Out", 1, {d.c(73), d.add({"A2K", 1, {delay}, {1}})}, {}});
+    auto bytes = d.bytes();
+    REQUIRE(fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size())));
+
+    auto run = [&](int32_t id, float max) {
+        const uint32_t before = counts().synths;
+        osc_test::Builder b;
+        b.begin("/s_new") << "arena_var" << id << int32_t(0) << int32_t(1) << "max" << max;
+        fx.send(b.end());
+        REQUIRE(fx.pollUntil([&] { return counts().synths > before; }, 3000));
+        fx.send(osc_test::message("/n_free", id));
+    };
+
+    run(2000, 0.01f);
+    const int small = arenaBytes(fx, "arena_var");
+    run(2001, 1.0f);
+    const int large = arenaBytes(fx, "arena_var");
+    REQUIRE(large > small);
+
+    for (int32_t id = 2002; id < 2034; ++id)
+        run(id, 0.01f);
+    const int settled = arenaBytes(fx, "arena_var");
+    CHECK(settled >= small);
+    CHECK(settled < small + (large - small) / 10);
+}
@@ -0,0 +1,294 @@
+/*
+ * test_pcm_decode.cpp — PcmFile, SampleLoader's mapped PCM fast path.
+ *
+ * Files are written with libsndfile itself, so the headers are the ones real
+ * tools produce; PcmFile must return exactly what sf_readf_float returns for
+ * them (same frame count, same bits), and refuse everything else so the
+ * loader falls back to libsndfile.
+ *
+ * The benchmark compares load throughput over a directory of real samples:
+ *
+ *   SUPERSONIC_BENCH_SAMPLES=/path/to/samples ./SuperSonicNativeTests "[pcm_decode][benchmark]"
+ *
+ * "cold" drops each file from the page cache first (Linux only; elsewhere it
+ * reports warm numbers twice).
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "PcmFile.h"
+
+#include <sndfile.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using supersonic::PcmEncoding;
+using supersonic::PcmFile;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr int kFrames = 4099;   // odd, so every kernel runs its scalar tail
+
+fs::path tempPath(const char* name) {
+    return fs::temp_directory_path() / (std::string("supersonic_pcm_") + name);
+}
+
+// Write `kFrames` frames of full-scale noise in `format`.
+bool writeNoise(const fs::path& path, int format, int channels, int rate = 44100) {
+    SF_INFO info = {};
+    info.channels = channels;
+    info.samplerate = rate;
+    info.format = format;
+    SNDFILE* sf = sf_open(path.string().c_str(), SFM_WRITE, &info);
+    if (!sf) return false;
+    std::mt19937 rng(static_cast<uint32_t>(format * 31 + channels));
+    std::vector<int> data(static_cast<size_t>(kFrames) * channels);
+    for (int& v : data) v = static_cast<int>(rng());
+    data[0] = INT32_MIN;
+    data[1 % data.size()] = INT32_MAX;
+    const sf_count_t n = (format & SF_FORMAT_SUBMASK) == SF_FORMAT_FLOAT
+        ? [&] {
+              std::vector<float> f(data.size());
+              for (size_t i = 0; i < f.size(); ++i) f[i] = data[i] / 2147483648.0f;
+              return sf_writef_float(sf, f.data(), kFrames);
+          }()
+        : sf_writef_int(sf, data.data(), kFrames);
+    sf_close(sf);
+    return n == kFrames;
+}
+
+// Frames [start, start + count) through libsndfile.
+std::vector<float> sndfileRead(const fs::path& path, sf_count_t start, sf_count_t count,
+                               SF_INFO& info) {
+    info = {};
+    SNDFILE* sf = sf_open(path.string().c_str(), SFM_READ, &info);
+    if (!sf) return {};
+    std::vector<float> out(static_cast<size_t>(count) * info.channels);
+    sf_seek(sf, start, SEEK_SET);
+    out.resize(static_cast<size_t>(sf_readf_float(sf, out.data(), count)) * info.channels);
+    sf_close(sf);
+    return out;
+}
+
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+struct Case {
+    const char* name;
+    int format;
+    int channels;
+    PcmEncoding encoding;
+};
+
+const Case kCases[] = {
+    { "u8.wav",      SF_FORMAT_WAV  | SF_FORMAT_PCM_U8,  1, PcmEncoding::U8 },
+    { "s16.wav",     SF_FORMAT_WAV  | SF_FORMAT_PCM_16,  2, PcmEncoding::S16LE },
+    { "s24.wav",     SF_FORMAT_WAV  | SF_FORMAT_PCM_24,  2, PcmEncoding::S24LE },
+    { "s32.wav",     SF_FORMAT_WAV  | SF_FORMAT_PCM_32,  1, PcmEncoding::S32LE },
+    { "f32.wav",     SF_FORMAT_WAV  | SF_FORMAT_FLOAT,   2, PcmEncoding::F32LE },
+    { "s24x.wav",    SF_FORMAT_WAVEX | SF_FORMAT_PCM_24, 6, PcmEncoding::S24LE },
+    { "s8.aiff",     SF_FORMAT_AIFF | SF_FORMAT_PCM_S8,  1, PcmEncoding::S8 },
+    { "s16.aiff",    SF_FORMAT_AIFF | SF_FORMAT_PCM_16,  2, PcmEncoding::S16BE },
+    { "s24.aiff",    SF_FORMAT_AIFF | SF_FORMAT_PCM_24,  2, PcmEncoding::S24BE },
+    { "s32.aiff",    SF_FORMAT_AIFF | SF_FORMAT_PCM_32,  1, PcmEncoding::S32BE },
+    // Little-endian AIFF is written as AIFC 'sowt'.
+    { "s16le.aiff",  SF_FORMAT_AIFF | SF_FORMAT_PCM_16 | SF_ENDIAN_LITTLE, 2, PcmEncoding::S16LE },
+    { "s24le.aiff",  SF_FORMAT_AIFF | SF_FORMAT_PCM_24 | SF_ENDIAN_LITTLE, 1, PcmEncoding::S24LE },
+};
+
+}  // namespace
+
+TEST_CASE("PcmFile reads plain PCM exactly as libsndfile does", "[pcm_decode]") {
+    for (const Case& c : kCases) {
+        INFO(c.name);
+        const fs::path path = tempPath(c.name);
+        REQUIRE(writeNoise(path, c.format, c.channels));
+
+        PcmFile pcm;
+        REQUIRE(pcm.open(path.string().c_str()));
+        SF_INFO info;
+        const std::vector<float> whole = sndfileRead(path, 0, kFrames, info);
+        CHECK(pcm.frames() == info.frames);
+        CHECK(pcm.channels() == info.channels);
+        CHECK(pcm.sampleRate() == info.samplerate);
+        CHECK(pcm.encoding() == c.encoding);
+
+        std::vector<float> fast(whole.size());
+        CHECK(pcm.read(fast.data(), 0, kFrames) == kFrames);
+        CHECK(sameBits(fast, whole));
+
+        // A sub-range at an unaligned offset, and one clamped at the end.
+        const std::vector<float> mid = sndfileRead(path, 1001, 777, info);
+        fast.assign(mid.size(), 0.0f);
+        CHECK(pcm.read(fast.data(), 1001, 777) == 777);
+        CHECK(sameBits(fast, mid));
+
+        const std::vector<float> tail = sndfileRead(path, kFrames - 5, 100, info);
+        fast.assign(tail.size(), 0.0f);
+        CHECK(pcm.read(fast.data(), kFrames - 5, 100) == 5);
+        CHECK(sameBits(fast, tail));
+
+        pcm.close();
+        fs::remove(path);
+    }
+}
+
+TEST_CASE("PcmFile leaves other encodings to libsndfile", "[pcm_decode]") {
+    const Case others[] = {
+        { "adpcm.wav",  SF_FORMAT_WAV  | SF_FORMAT_IMA_ADPCM, 1, PcmEncoding::S16LE },
+        { "f64.wav",    SF_FORMAT_WAV  | SF_FORMAT_DOUBLE,    1, PcmEncoding::S16LE },
+        { "ulaw.wav",   SF_FORMAT_WAV  | SF_FORMAT_ULAW,      1, PcmEncoding::S16LE },
+        { "f32.aiff",   SF_FORMAT_AIFF | SF_FORMAT_FLOAT,     1, PcmEncoding::S16LE },
+        { "s16.flac",   SF_FORMAT_FLAC | SF_FORMAT_PCM_16,    1, PcmEncoding::S16LE },
+        { "s16.au",     SF_FORMAT_AU   | SF_FORMAT_PCM_16,    1, PcmEncoding::S16LE },
+    };
+    for (const Case& c : others) {
+        INFO(c.name);
+        const fs::path path = tempPath(c.name);
+        if (!writeNoise(path, c.format, c.channels)) continue;   // codec not built in
+        PcmFile pcm;
+        CHECK_FALSE(pcm.open(path.string().c_str()));
+        fs::remove(path);
+    }
+
+    PcmFile pcm;
+    CHECK_FALSE(pcm.open(tempPath("missing.wav").string().c_str()));
+}
+
+TEST_CASE("PcmFile clamps a data chunk that runs past the end of the file", "[pcm_decode]") {
+    const fs::path path = tempPath("short.wav");
+    REQUIRE(writeNoise(path, SF_FORMAT_WAV | SF_FORMAT_PCM_16, 2));
+    // Cut the file mid-frame, as a crashed recorder would leave it.
+    fs::resize_file(path, fs::file_size(path) - 4 * 10 - 2);
+
+    SF_INFO info;
+    const std::vector<float> ref = sndfileRead(path, 0, kFrames, info);
+    PcmFile pcm;
+    REQUIRE(pcm.open(path.string().c_str()));
+    CHECK(pcm.frames() == info.frames);
+    std::vector<float> fast(ref.size());
+    CHECK(pcm.read(fast.data(), 0, kFrames) == info.frames);
+    CHECK(sameBits(fast, ref));
+    pcm.close();
+    fs::remove(path);
+}
+
+TEST_CASE("pcm_to_float vector paths match the scalar conversion", "[pcm_decode]") {
+    std::mt19937 rng(7);
+    const PcmEncoding all[] = { PcmEncoding::S16LE, PcmEncoding::S16BE, PcmEncoding::S24LE,
+                                PcmEncoding::S24BE, PcmEncoding::S32LE, PcmEncoding::S32BE };
+    for (PcmEncoding enc : all) {
+        const uint32_t width = supersonic::pcm_bytes_per_sample(enc);
+        // Every length up to a few vectors, each from an odd address.
+        for (size_t n = 0; n < 40; ++n) {
+            std::vector<uint8_t> src(n * width + 1);
+            for (auto& b : src) b = static_cast<uint8_t>(rng());
+            std::vector<float> whole(n + 1, -7.0f), pieces(n + 1, -7.0f);
+            supersonic::pcm_to_float(enc, src.data() + 1, whole.data(), n);
+            // One sample at a time only ever takes the scalar path.
+            for (size_t i = 0; i < n; ++i)
+                supersonic::pcm_to_float(enc, src.data() + 1 + i * width, pieces.data() + i, 1);
+            CHECK(sameBits(whole, pieces));
+            CHECK(whole[n] == -7.0f);
+        }
+    }
+}
+
+// ─── Benchmark ──────────────────────────────────────────────────────────────
+
+namespace {
+
+void dropFromCache(const fs::path& path) {
+#ifdef __linux__
+    const int fd = ::open(path.string().c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+#else
+    (void)path;
+#endif
+}
+
+double nowSec() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Load every file the way SampleLoader does; returns decoded bytes.
+uint64_t loadAll(const std::vector<fs::path>& files, bool fast, bool cold) {
+    uint64_t bytes = 0;
+    for (const fs::path& path : files) {
+        if (cold) dropFromCache(path);
+        if (fast) {
+            PcmFile pcm;
+            if (!pcm.open(path.string().c_str())) continue;
+            std::vector<float> data(static_cast<size_t>(pcm.frames()) * pcm.channels());
+            bytes += static_cast<uint64_t>(pcm.read(data.data(), 0, pcm.frames()))
+                   * pcm.channels() * sizeof(float);
+        } else {
+            SF_INFO info = {};
+            SNDFILE* sf = sf_open(path.string().c_str(), SFM_READ, &info);
+            if (!sf) continue;
+            std::vector<float> data(static_cast<size_t>(info.frames) * info.channels);
+            bytes += static_cast<uint64_t>(sf_readf_float(sf, data.data(), info.frames))
+                   * info.channels * sizeof(float);
+            sf_close(sf);
+        }
+    }
+    return bytes;
+}
+
+}  // namespace
+
+TEST_CASE("PcmFile load throughput vs libsndfile", "[.][benchmark][pcm_decode]") {
+    const char* dir = std::getenv("SUPERSONIC_BENCH_SAMPLES");
+    if (!dir || !fs::is_directory(dir)) {
+        WARN("SUPERSONIC_BENCH_SAMPLES not set to a directory — skipping");
+        SUCCEED();
+        return;
+    }
+
+    // Only files the fast path takes, so both decoders read the same set.
+    std::vector<fs::path> files;
+    uint64_t onDisk = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(dir)) {
+        if (!entry.is_regular_file()) continue;
+        PcmFile pcm;
+        if (!pcm.open(entry.path().string().c_str())) continue;
+        files.push_back(entry.path());
+        onDisk += entry.file_size();
+    }
+    if (files.empty()) {
+        WARN("no plain PCM WAV/AIFF files under " << dir << " — skipping");
+        SUCCEED();
+        return;
+    }
+
+    std::printf("\n  %zu files, %.1f MB on disk\n", files.size(), onDisk / 1048576.0);
+    std::printf("  %-12s %-6s %10s %10s\n", "decoder", "cache", "seconds", "MB/s out");
+    for (bool cold : { true, false }) {
+        for (bool fast : { false, true }) {
+            if (!cold) loadAll(files, fast, false);   // warm the cache
+            const double t0 = nowSec();
+            const uint64_t bytes = loadAll(files, fast, cold);
+            const double dt = nowSec() - t0;
+            std::printf("  %-12s %-6s %10.3f %10.1f\n", fast ? "PcmFile" : "libsndfile",
+                        cold ? "cold" : "warm", dt, bytes / 1048576.0 / dt);
+        }
+    }
+    SUCCEED();
+}
@@ -0,0 +1,174 @@
+/*
+ * test_precoded.cpp — pre-decoded command records (cmd_record.h, the
+ * precoded jump table in SC_MiscCmds.cpp, ss_ingress_write_precoded).
+ *
+ * SupersonicEngine::ingest decodes /s_new, /n_set, /n_map, /n_free, /g_new
+ * and /c_set into binary records before they reach the IN ring; the audio
+ * thread runs them without parsing the OSC. The records must do exactly
+ * what the messages do — controls, arrays, bus mappings, error replies —
+ * and anything the encoder can't mirror goes in raw.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "EngineFixture.h"
+#include "audio_processor.h"   // get_shared_memory_base
+#include "shared_memory.h"     // NATIVE_STAT_PRECODED_CMDS
+#include "cmd_record.h"
+
+#include <atomic>
+#include <vector>
+
+namespace {
+
+uint32_t precodedCommands() {
+    auto* ns = static_cast<uint8_t*>(get_shared_memory_base()) + NATIVE_STATS_START;
+    return reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_PRECODED_CMDS)
+        ->load(std::memory_order_relaxed);
+}
+
+std::vector<uint8_t> encode(const osc_test::Packet& pkt) {
+    std::vector<uint8_t> rec(SS_CMD_RECORD_MAX);
+    rec.resize(ss_cmd_encode(pkt.ptr(), pkt.size(), rec.data(), SS_CMD_RECORD_MAX));
+    return rec;
+}
+
+float controlValue(EngineFixture& fx, int32_t node, const char* name) {
+    fx.clearReplies();
+    osc_test::Builder b;
+    b.begin("/s_get") << node << name;
+    fx.send(b.end());
+    OscReply r;
+    REQUIRE(fx.waitForReply("/n_set", r));
+    return r.parsed().argFloat(2);
+}
+
+float bus(EngineFixture& fx, int32_t index) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/c_get", index));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/c_set", r));
+    return r.parsed().argFloat(1);
+}
+
+}  // namespace
+
+TEST_CASE("hot commands encode to records, everything else stays raw", "[precoded]") {
+    osc_test::Builder b;
+    b.begin("/n_set") << int32_t(1000) << "note" << 60.0f << int32_t(3)
+                      << osc::BeginArray << 0.5f << "c7" << osc::EndArray;
+    auto rec = encode(b.end());
+    REQUIRE(!rec.empty());
+
+    SsCmdView v;
+    REQUIRE(ss_cmd_view(rec.data(), static_cast<uint32_t>(rec.size()), v));
+    CHECK(v.rec->cmd == cmd_n_set);
+    CHECK(v.rec->node == 1000);
+    REQUIRE(v.rec->count == 3);
+    CHECK(v.entries[0].nameOff != 0);
+    CHECK(v.entries[0].value.f == 60.0f);
+    CHECK(v.entries[1].key == 3);
+    CHECK(v.entries[1].aux == 0);
+    CHECK(v.entries[2].op == kSsCmdMapControl);
+    CHECK(v.entries[2].value.i == 7);
+    CHECK(v.entries[2].aux == 1);
+
+    // Not hot, or a shape only the OSC path handles.
+    CHECK(encode(osc_test::message("/status")).empty());
+    CHECK(encode(osc_test::message("/n_run", 1000, 0)).empty());
+    osc_test::Builder path;
+    path.begin("/n_set") << "h" << int32_t(1) << "amp" << 0.1f;
+    CHECK(encode(path.end()).empty());
+    osc_test::Builder dbl;
+    dbl.begin("/c_set") << int32_t(1) << 0.5;
+    CHECK(encode(dbl.end()).empty());
+}
+
+TEST_CASE("the consumer rejects records whose offsets leave the payload", "[precoded]") {
+    osc_test::Builder b;
+    b.begin("/s_new") << "sonic-pi-beep" << int32_t(1000) << int32_t(0) << int32_t(1)
+                      << "note" << 60.0f;
+    auto rec = encode(b.end());
+    REQUIRE(!rec.empty());
+    const auto size = static_cast<uint32_t>(rec.size());
+
+    SsCmdView v;
+    CHECK_FALSE(ss_cmd_view(rec.data(), size - 4, v));
+
+    auto badName = rec;
+    reinterpret_cast<SsCmdEntry*>(badName.data() + sizeof(SsCmdRecord))->nameOff = 4096;
+    CHECK_FALSE(ss_cmd_view(badName.data(), size, v));
+    CHECK(v.osc != nullptr);   // still dispatchable as the message it carries
+
+    auto badCount = rec;
+    reinterpret_cast<SsCmdRecord*>(badCount.data())->count = 0xFFFF;
+    CHECK_FALSE(ss_cmd_view(badCount.data(), size, v));
+    CHECK(v.osc == nullptr);
+}
+
+TEST_CASE("precoded /s_new, /n_set and /n_map match the OSC path", "[precoded]") {
+    EngineFixture fx;
+    REQUIRE(fx.loadSynthDef("sonic-pi-beep"));
+    const uint32_t before = precodedCommands();
+
+    fx.send(osc_test::message("/g_new", 10, 0, 1));
+    osc_test::Builder c;
+    c.begin("/c_set") << int32_t(12) << 0.25f << int32_t(13) << int32_t(3);
+    fx.send(c.end());
+    osc_test::Builder s;
+    s.begin("/s_new") << "sonic-pi-beep" << int32_t(1000) << int32_t(0) << int32_t(10)
+                      << "note" << 72.0f << "release" << 60.0f << "amp" << "c12";
+    fx.send(s.end());
+    CHECK(controlValue(fx, 1000, "note") == Catch::Approx(72.0f));
+    CHECK(controlValue(fx, 1000, "release") == Catch::Approx(60.0f));
+    CHECK(bus(fx, 12) == Catch::Approx(0.25f));
+    CHECK(bus(fx, 13) == Catch::Approx(3.0f));
+
+    osc_test::Builder n;
+    n.begin("/n_set") << int32_t(1000) << "note" << 48 << "pan" << -0.5f;
+    fx.send(n.end());
+    CHECK(controlValue(fx, 1000, "note") == Catch::Approx(48.0f));
+    CHECK(controlValue(fx, 1000, "pan") == Catch::Approx(-0.5f));
+
+    osc_test::Builder m;
+    m.begin("/n_map") << int32_t(1000) << "note" << int32_t(12);
+    fx.send(m.end());
+    REQUIRE(fx.waitForBlocks(2));
+    CHECK(controlValue(fx, 1000, "note") == Catch::Approx(0.25f));
+
+    fx.send(osc_test::message("/n_free", 1000));
+    REQUIRE(fx.pollUntil([&] { return precodedCommands() >= before + 6; }, 3000));
+}
+
+TEST_CASE("precoded commands report errors like their OSC twins", "[precoded]") {
+    EngineFixture fx;
+    fx.send(osc_test::message("/notify", 1));
+    fx.clearReplies();
+
+    fx.send(osc_test::message("/n_free", 4242));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/fail", r));
+    CHECK(r.parsed().argString(0) == "/n_free");
+
+    fx.clearReplies();
+    osc_test::Builder s;
+    s.begin("/s_new") << "no-such-def" << int32_t(1000) << int32_t(0) << int32_t(1);
+    fx.send(s.end());
+    REQUIRE(fx.waitForReply("/fail", r));
+    CHECK(r.parsed().argString(0) == "/s_new");
+}
+
+TEST_CASE("precodeIngress off writes every message raw", "[precoded]") {
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.precodeIngress = false;
+    EngineFixture fx(cfg);
+    REQUIRE(fx.loadSynthDef("sonic-pi-beep"));
+    const uint32_t before = precodedCommands();
+
+    osc_test::Builder s;
+    s.begin("/s_new") << "sonic-pi-beep" << int32_t(1000) << int32_t(0) << int32_t(1)
+                      << "note" << 65.0f << "release" << 60.0f;
+    fx.send(s.end());
+    CHECK(controlValue(fx, 1000, "note") == Catch::Approx(65.0f));
+    REQUIRE(fx.waitForBlocks(130));
+    CHECK(precodedCommands() == before);
+}
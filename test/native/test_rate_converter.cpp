@@ -0,0 +1,202 @@
+/*
+ * test_rate_converter.cpp — fixed internal sample rate (Config::internalSampleRate)
+ *
+ * Two layers:
+ *   - RateConverter (src/native/RateConverter.*) in isolation: a sine through
+ *     common rate pairs must come out at the right frequency, level and
+ *     phase, with the phase pinned by the reported latency — the figure the
+ *     drivers hand to SuperClock's sample clock.
+ *   - The engine through the headless driver with a simulated device rate:
+ *     the World stays at the pinned rate, engine frames advance at that rate
+ *     against the device's, and a device rate change is a hot swap.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "EngineFixture.h"
+#include "src/native/RateConverter.h"
+
+#include <cmath>
+#include <vector>
+
+using supersonic::RateConverter;
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+// Stream a two-channel sine (sin / half-level cos) through `rc` in blocks of
+// `push` input frames, pulling `pull` output frames at a time. Before each
+// pull, the reported latency must place the next output exactly where the
+// analytic signal says it is. Returns the worst sample error after warm-up.
+double streamSine(RateConverter& rc, int inRate, int outRate, int push, int pull,
+                  double freq, double& worstLatencyError) {
+    std::vector<float> in(static_cast<size_t>(2 * push)), out(static_cast<size_t>(2 * pull));
+    int64_t pushed = 0, pulled = 0;
+    double worst = 0.0;
+    worstLatencyError = 0.0;
+    const double gd = rc.groupDelayInputFrames();
+    for (int iter = 0; iter < 400; ++iter) {
+        while (rc.available() < pull) {
+            for (int i = 0; i < push; ++i) {
+                const double t = static_cast<double>(pushed + i) / inRate;
+                in[static_cast<size_t>(i)]        = static_cast<float>(0.5 * std::sin(kTwoPi * freq * t));
+                in[static_cast<size_t>(push + i)] = static_cast<float>(0.25 * std::cos(kTwoPi * freq * t));
+            }
+            rc.push(in.data(), push, 2, push);
+            pushed += push;
+        }
+        // Next output position in input frames, from the output count alone.
+        const double nextOut = static_cast<double>(pulled) * inRate / outRate;
+        worstLatencyError = std::max(worstLatencyError,
+            std::fabs((pushed - rc.latencyInputFrames() + gd) - nextOut));
+
+        const int n = rc.pull(out.data(), pull, 2, pull);
+        REQUIRE(n == pull);
+        for (int j = 0; j < n; ++j) {
+            if (pulled + j < 256) continue;  // filter warm-up from the zero history
+            const double t = (static_cast<double>(pulled + j) * inRate / outRate - gd) / inRate;
+            worst = std::max(worst, std::fabs(out[static_cast<size_t>(j)] - 0.5 * std::sin(kTwoPi * freq * t)));
+            worst = std::max(worst, std::fabs(out[static_cast<size_t>(pull + j)] - 0.25 * std::cos(kTwoPi * freq * t)));
+        }
+        pulled += n;
+    }
+    return worst;
+}
+
+}  // namespace
+
+TEST_CASE("RateConverter: sine survives common rate pairs, latency is exact", "[RateConverter]") {
+    struct Pair { int in, out, push, pull; };
+    // World block sizes on the push side, device buffers on the pull side,
+    // deliberately not multiples of each other.
+    const Pair pairs[] = {
+        {48000, 44100, 128, 512},
+        {44100, 48000, 64, 441},
+        {48000, 96000, 128, 256},
+        {96000, 44100, 128, 100},
+        {48000, 88200, 256, 1024},
+    };
+    for (const auto& p : pairs) {
+        RateConverter rc;
+        REQUIRE(rc.configure(p.in, p.out, 2, p.push, p.pull));
+        REQUIRE(rc.active());
+        double latencyError = 0.0;
+        const double err = streamSine(rc, p.in, p.out, p.push, p.pull, 1000.0, latencyError);
+        INFO(p.in << " -> " << p.out);
+        CHECK(err < 1e-3);            // ~-66 dB re the 0.5 sine, well inside 16-bit
+        CHECK(latencyError < 1e-6);   // sample clock lands on the right frame
+    }
+}
+
+TEST_CASE("RateConverter: stopband rejects content above the device Nyquist", "[RateConverter]") {
+    // 48k -> 44.1k: 23 kHz can't be represented at the device rate and must
+    // not fold back to 21.1 kHz.
+    RateConverter rc;
+    REQUIRE(rc.configure(48000, 44100, 1, 128, 512));
+    std::vector<float> in(128), out(512);
+    int64_t pushed = 0;
+    double sumSq = 0.0;
+    int64_t count = 0;
+    for (int iter = 0; iter < 200; ++iter) {
+        while (rc.available() < 512) {
+            for (int i = 0; i < 128; ++i)
+                in[static_cast<size_t>(i)] = static_cast<float>(
+                    std::sin(kTwoPi * 23000.0 * static_cast<double>(pushed + i) / 48000.0));
+            rc.push(in.data(), 128, 1, 128);
+            pushed += 128;
+        }
+        rc.pull(out.data(), 512, 1, 512);
+        if (iter < 2) continue;
+        for (float v : out) { sumSq += static_cast<double>(v) * v; ++count; }
+    }
+    const double rmsDb = 10.0 * std::log10(sumSq / count / 0.5);  // re a full-scale sine
+    CHECK(rmsDb < -80.0);
+}
+
+TEST_CASE("RateConverter: equal rates and unreducible ratios stay inactive", "[RateConverter]") {
+    RateConverter rc;
+    CHECK_FALSE(rc.configure(48000, 48000, 2, 128, 128));
+    CHECK_FALSE(rc.active());
+    // 44057 is prime: the reduced ratio needs 44057 phases.
+    CHECK_FALSE(RateConverter::supports(48000, 44057));
+    CHECK_FALSE(rc.configure(48000, 44057, 2, 128, 128));
+    CHECK_FALSE(rc.active());
+    CHECK(RateConverter::supports(48000, 44100));
+    CHECK(RateConverter::supports(192000, 8000));
+    // Inactive converters are inert.
+    float buf[4] = {1, 2, 3, 4};
+    rc.push(buf, 2, 2, 2);
+    CHECK(rc.available() == 0);
+    CHECK(rc.pull(buf, 2, 2, 2) == 0);
+}
+
+// ── Engine: headless driver with a simulated device rate ────────────────────
+
+namespace {
+
+SupersonicEngine::Config pinnedConfig(int deviceRate) {
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.sampleRate         = deviceRate;   // the simulated device
+    cfg.internalSampleRate = 48000;
+    return cfg;
+}
+
+double worldRate(EngineFixture& fix) {
+    fix.clearReplies();
+    fix.send(osc_test::message("/status"));
+    OscReply reply;
+    REQUIRE(fix.waitForReply("/status.reply", reply));
+    return reply.parsed().argDouble(7);  // nominal sample rate
+}
+
+}  // namespace
+
+TEST_CASE("InternalRate: World runs at the pinned rate behind a 44.1k device", "[InternalRate]") {
+    EngineFixture fix(pinnedConfig(44100));
+    REQUIRE(fix.headlessDriver().isResampling());
+    CHECK(worldRate(fix) == 48000.0);
+
+    // Engine frames advance at 48k per 44.1k device frames, give or take the
+    // block the converter renders ahead and the two counters being read while
+    // the driver runs.
+    const uint64_t dev0 = fix.headlessDriver().deviceFrames();
+    const uint64_t eng0 = fix.engineFrames();
+    REQUIRE(fix.waitForBlocks(200, 5000));
+    const double dev = static_cast<double>(fix.headlessDriver().deviceFrames() - dev0);
+    const double eng = static_cast<double>(fix.engineFrames() - eng0);
+    REQUIRE(dev > 0.0);
+    CHECK(std::fabs(eng - dev * 48000.0 / 44100.0) < 4 * 128);
+}
+
+TEST_CASE("InternalRate: device rate change is a hot swap", "[InternalRate]") {
+    EngineFixture fix(pinnedConfig(48000));
+    CHECK_FALSE(fix.headlessDriver().isResampling());
+
+    auto r1 = fix.engine().switchDevice("", 44100);
+    REQUIRE(r1.success);
+    CHECK(r1.type == SwapType::Hot);
+    CHECK(static_cast<int>(r1.sampleRate) == 44100);
+    CHECK(fix.headlessDriver().isResampling());
+    CHECK(worldRate(fix) == 48000.0);
+
+    auto r2 = fix.engine().switchDevice("", 96000);
+    REQUIRE(r2.success);
+    CHECK(r2.type == SwapType::Hot);
+    CHECK(worldRate(fix) == 48000.0);
+
+    // Back to the World's own rate: no conversion at all.
+    auto r3 = fix.engine().switchDevice("", 48000);
+    REQUIRE(r3.success);
+    CHECK(r3.type == SwapType::Hot);
+    CHECK_FALSE(fix.headlessDriver().isResampling());
+    CHECK(worldRate(fix) == 48000.0);
+}
+
+TEST_CASE("InternalRate: an unreducible device rate falls back to a cold swap", "[InternalRate]") {
+    EngineFixture fix(pinnedConfig(48000));
+    auto r = fix.engine().switchDevice("", 44057);
+    REQUIRE(r.success);
+    CHECK(r.type == SwapType::Cold);
+    CHECK_FALSE(fix.headlessDriver().isResampling());
+    CHECK(worldRate(fix) == 44057.0);
+}
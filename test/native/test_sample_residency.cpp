@@ -0,0 +1,303 @@
+/*
+ * test_sample_residency.cpp — Lazily resident samples
+ *
+ * Buffers registered with /supersonic/buffers/register stay empty until a
+ * /s_new that plays them is queued (prefetch) or dispatched (late load), and
+ * idle ones are evicted to stay under the byte budget. Which controls play a
+ * buffer comes from the synthdef: residency_probe wires "buf" (control 0)
+ * into a PlayBuf; "amp" and "buf_gain" go elsewhere.
+ */
+#include "EngineFixture.h"
+#include "OscBuilder.h"
+#include "SynthDefWriter.h"
+#include "WallClock.h"
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#ifndef SUPERSONIC_SAMPLES_DIR
+#define SUPERSONIC_SAMPLES_DIR ""
+#endif
+
+static std::string samplePath(const char* name) {
+    return std::string(SUPERSONIC_SAMPLES_DIR) + "/" + name;
+}
+
+// PlayBuf.ar(1, buf) * amp * buf_gain onto a private audio bus.
+static bool loadProbe(EngineFixture& fx, const char* name = "residency_probe", float buf = 0.f) {
+    osc_test::DefWriter d;
+    d.name = name;
+    d.controls = {buf, 1.f, 1.f};
+    d.params = {{"buf", 0}, {"amp", 1}, {"buf_gain", 2}};
+    auto ctl = d.add({"Control", 1, {}, {1, 1, 1}, 0});
+    auto play = d.add({"PlayBuf", 2, {ctl, d.c(1), d.c(1), d.c(0), d.c(0), d.c(0)}, {2}});
+    auto amp = d.add({"BinaryOpUGen", 2, {play, {ctl.unit, 1}}, {2}, 2});
+    auto out = d.add({"BinaryOpUGen", 2, {amp, {ctl.unit, 2}}, {2}, 2});
+    d.add({"Out", 2, {d.c(100), out}, {}});
+    auto bytes = d.bytes();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+static bool registerBuffer(EngineFixture& fx, int32_t bufnum, const std::string& path) {
+    fx.clearReplies();
+    osc_test::Builder b;
+    b.begin("/supersonic/buffers/register") << bufnum << path.c_str();
+    fx.send(b.end());
+    OscReply r;
+    return fx.waitForReply("/supersonic/buffers/register.reply", r)
+        && r.parsed().argInt(1) == 1;
+}
+
+struct Residency { int registered, resident, prefetches, hits, late, evictions; };
+
+static Residency residency(EngineFixture& fx) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/supersonic/buffers/residency"));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/buffers/residency.reply", r));
+    auto p = r.parsed();
+    return { p.argInt(0), p.argInt(1), p.argInt(4), p.argInt(5), p.argInt(6), p.argInt(7) };
+}
+
+// Poll the residency stats until pred holds (or timeoutMs passes).
+template <class Pred>
+static bool waitResidency(EngineFixture& fx, Pred pred, int timeoutMs = 3000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (pred(residency(fx))) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+}
+
+static int32_t frames(EngineFixture& fx, int32_t bufnum) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/b_query", bufnum));
+    OscReply info;
+    REQUIRE(fx.waitForReply("/b_info", info));
+    return info.parsed().argInt(1);
+}
+
+static OscPacket sNew(const char* control, float value, int32_t node = -1) {
+    return OscBuilder::message("/s_new", "residency_probe", node, int32_t(0),
+                               int32_t(0), control, value);
+}
+
+static OscPacket sNew(int32_t control, float value, int32_t node = -1) {
+    return OscBuilder::message("/s_new", "residency_probe", node, int32_t(0),
+                               int32_t(0), control, value);
+}
+
+static void freeNode(EngineFixture& fx, int32_t node) {
+    auto pkt = OscBuilder::message("/n_free", node);
+    fx.send(pkt.ptr(), pkt.size());
+}
+
+static uint64_t timetagIn(int ms) {   // ms may be negative: a late bundle
+    return static_cast<uint64_t>(supersonic::ntpToOscTimetag(wallClockNTP() + ms / 1000.0));
+}
+
+TEST_CASE("registered buffer loads ahead of a queued /s_new", "[residency]") {
+    const std::string path = samplePath("bd_haus.flac");
+    if (!std::filesystem::exists(path)) { SKIP("Sample not found"); }
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx));
+
+    REQUIRE(registerBuffer(fx, 5, path));
+    CHECK(frames(fx, 5) == 0);   // nothing loaded yet
+
+    auto pkt = OscBuilder::bundle(timetagIn(500), { sNew("buf", 5.0f) });
+    fx.send(pkt.ptr(), pkt.size());
+
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 1; }, 450));
+    CHECK(residency(fx).prefetches == 1);
+    CHECK(frames(fx, 5) > 0);
+
+    // Once it dispatches, the buffer was there in time.
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.hits + r.late > 0; }));
+    auto r = residency(fx);
+    CHECK(r.hits == 1);
+    CHECK(r.late == 0);
+}
+
+TEST_CASE("immediate /s_new on a cold registered buffer is a late load", "[residency]") {
+    const std::string path = samplePath("bd_haus.flac");
+    if (!std::filesystem::exists(path)) { SKIP("Sample not found"); }
+    EngineFixture fx;
+
+    REQUIRE(loadProbe(fx));
+
+    REQUIRE(registerBuffer(fx, 6, path));
+    auto pkt = sNew(int32_t(0), 6.0f);   // by control index
+    fx.send(pkt.ptr(), pkt.size());
+
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.late == 1 && r.resident == 1; }));
+    CHECK(residency(fx).prefetches == 0);
+    CHECK(frames(fx, 6) > 0);
+}
+
+TEST_CASE("only controls that play a buffer, holding registered bufnums, trigger a load", "[residency]") {
+    const std::string path = samplePath("bd_haus.flac");
+    if (!std::filesystem::exists(path)) { SKIP("Sample not found"); }
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx));
+
+    REQUIRE(registerBuffer(fx, 7, path));
+    auto pkt = OscBuilder::bundle(timetagIn(200), { sNew("amp", 7.0f), sNew("buf_gain", 7.0f),
+                                                    sNew("buf", 8.0f) });
+    fx.send(pkt.ptr(), pkt.size());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    auto r = residency(fx);
+    CHECK(r.prefetches == 0);
+    CHECK(r.resident == 0);
+    CHECK(frames(fx, 7) == 0);
+}
+
+TEST_CASE("a buffer control left at its default is prefetched", "[residency]") {
+    const std::string path = samplePath("bd_haus.flac");
+    if (!std::filesystem::exists(path)) { SKIP("Sample not found"); }
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx, "residency_default", 9.f));
+
+    REQUIRE(registerBuffer(fx, 9, path));
+    auto msg = OscBuilder::message("/s_new", "residency_default", int32_t(-1), int32_t(0),
+                                   int32_t(0), "amp", 0.5f);
+    auto pkt = OscBuilder::bundle(timetagIn(500), { msg });
+    fx.send(pkt.ptr(), pkt.size());
+
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 1; }, 450));
+    CHECK(residency(fx).prefetches == 1);
+    CHECK(frames(fx, 9) > 0);
+}
+
+TEST_CASE("idle registered buffers are evicted to stay under the budget", "[residency]") {
+    const std::string a = samplePath("ambi_haunted_hum.flac");
+    const std::string b = samplePath("ambi_lunar_land.flac");
+    if (!std::filesystem::exists(a) || !std::filesystem::exists(b)) { SKIP("Sample not found"); }
+
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.sampleResidencyMB = 1;   // either sample alone is over
+    cfg.sampleIdleMs      = 0;
+    EngineFixture fx(cfg);
+    REQUIRE(loadProbe(fx));
+
+    REQUIRE(registerBuffer(fx, 10, a));
+    REQUIRE(registerBuffer(fx, 11, b));
+
+    // Started longer ago than the sample lasts (~10 s), and since freed.
+    auto first = OscBuilder::bundle(timetagIn(-15000), { sNew("buf", 10.0f, 3000) });
+    fx.send(first.ptr(), first.size());
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 1; }));
+    CHECK(frames(fx, 10) > 0);
+    freeNode(fx, 3000);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto second = sNew("buf", 11.0f);
+    fx.send(second.ptr(), second.size());
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.evictions == 1; }));
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 1; }));
+    CHECK(frames(fx, 10) == 0);   // evicted; reloads on its next reference
+    CHECK(frames(fx, 11) > 0);
+}
+
+TEST_CASE("a buffer still playing out is not evicted", "[residency]") {
+    const std::string a = samplePath("ambi_haunted_hum.flac");
+    const std::string b = samplePath("ambi_lunar_land.flac");
+    if (!std::filesystem::exists(a) || !std::filesystem::exists(b)) { SKIP("Sample not found"); }
+
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.sampleResidencyMB = 1;
+    cfg.sampleIdleMs      = 0;   // only the sample's own duration holds it
+    EngineFixture fx(cfg);
+    REQUIRE(loadProbe(fx));
+
+    REQUIRE(registerBuffer(fx, 10, a));
+    REQUIRE(registerBuffer(fx, 11, b));
+
+    auto first = sNew("buf", 10.0f);
+    fx.send(first.ptr(), first.size());
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 1; }));
+
+    // Over budget, but the synth on 10 is still reading it.
+    auto second = sNew("buf", 11.0f);
+    fx.send(second.ptr(), second.size());
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 2; }));
+    CHECK(residency(fx).evictions == 0);
+    CHECK(frames(fx, 10) > 0);
+}
+
+TEST_CASE("a buffer a live synth holds is not evicted", "[residency]") {
+    const std::string a = samplePath("ambi_haunted_hum.flac");
+    const std::string b = samplePath("ambi_lunar_land.flac");
+    const std::string c = samplePath("bd_haus.flac");
+    if (!std::filesystem::exists(a) || !std::filesystem::exists(b) || !std::filesystem::exists(c)) {
+        SKIP("Sample not found");
+    }
+
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.sampleResidencyMB = 1;
+    cfg.sampleIdleMs      = 0;
+    EngineFixture fx(cfg);
+    REQUIRE(loadProbe(fx));
+
+    REQUIRE(registerBuffer(fx, 10, a));
+    REQUIRE(registerBuffer(fx, 11, b));
+    REQUIRE(registerBuffer(fx, 12, c));
+
+    // Started longer ago than the sample lasts, but the synth (a loop, or a
+    // slow rate) is still running: only its node holds the buffer.
+    auto first = OscBuilder::bundle(timetagIn(-15000), { sNew("buf", 10.0f, 3000) });
+    fx.send(first.ptr(), first.size());
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 1; }));
+
+    auto second = sNew("buf", 11.0f, 3001);
+    fx.send(second.ptr(), second.size());
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.resident == 2; }));
+    CHECK(residency(fx).evictions == 0);
+    CHECK(frames(fx, 10) > 0);
+
+    // Once it ends, the buffer is idle again and goes first.
+    freeNode(fx, 3000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto third = sNew("buf", 12.0f, 3002);
+    fx.send(third.ptr(), third.size());
+    REQUIRE(waitResidency(fx, [](const Residency& r) { return r.evictions == 1; }));
+    CHECK(frames(fx, 10) == 0);
+    CHECK(frames(fx, 11) > 0);   // its synth is still running
+}
+
+TEST_CASE("registration records are capped per buffer slot", "[residency]") {
+    EngineFixture fx;
+
+    // Registration reads nothing, so the paths need not exist.
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(registerBuffer(fx, 20, "/nowhere/" + std::to_string(i) + ".wav"));
+    CHECK_FALSE(registerBuffer(fx, 20, "/nowhere/4.wav"));
+    CHECK(registerBuffer(fx, 20, "/nowhere/0.wav"));   // already on record
+    CHECK(registerBuffer(fx, 21, "/nowhere/5.wav"));   // another slot's allowance
+}
+
+TEST_CASE("unregistered buffers are left alone", "[residency]") {
+    EngineFixture fx;
+    REQUIRE(loadProbe(fx));
+
+    osc_test::Builder bad;
+    bad.begin("/supersonic/buffers/register") << int32_t(-1) << "/nowhere.wav";
+    fx.send(bad.end());
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/buffers/register.reply", r));
+    CHECK(r.parsed().argInt(1) == 0);
+
+    fx.clearReplies();
+    fx.send(osc_test::message("/supersonic/buffers/unregister", 3));
+    REQUIRE(fx.waitForReply("/supersonic/buffers/unregister.reply", r));
+    CHECK(r.parsed().argInt(1) == 0);   // was never registered
+
+    auto pkt = sNew("buf", 3.0f);
+    fx.send(pkt.ptr(), pkt.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto s = residency(fx);
+    CHECK(s.registered == 0);
+    CHECK(s.late == 0);
+}
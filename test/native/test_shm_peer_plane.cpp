@@ -4,6 +4,12 @@
  * engine → reply-ring round trip with ShmTransport bound the way Main.cpp
  * binds it (--shm-commands).
  *
+ * The command ring is a direct IN lane: process_audio drains it itself, so a
+ * command lands in the first block after it is written. The latency cases
+ * check that and print the wall-clock command-to-application time. A peer
+ * may send pre-decoded command records (cmd_record.h) as the IN ring's
+ * producers do.
+ *
  * The cross-process crash properties (SIGKILL mid-write, lock-holding corpse,
  * reattach) are proven in test_shm_peer_crash.cpp.
  */
@@ -12,12 +18,19 @@
 #include "EngineFixture.h"
 #include "OscTestUtils.h"
 #include "ShmTransport.h"
+#include "src/audio_processor.h"   // get_shared_memory_base
+#include "src/cmd_record.h"
 #include "src/lanes/ring_drain.h"
+#include "src/ring/ring.h"         // SOURCE_ID_PRECODED
+#include "src/shared_memory.h"     // NATIVE_STAT_PRECODED_CMDS
 #include "src/shm_peer_plane.h"
 #include "src/synth/common/server_shm.hpp"
 #include "src/workers/RingBufferWriter.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <string>
 #include <thread>
 #include <vector>
@@ -230,3 +243,129 @@ TEST_CASE("shm-peer load: high-volume commands round-trip losslessly through the
 
     engine.shutdown();
 }
+
+TEST_CASE("shm-peer latency: a command is applied in the next audio block",
+          "[shm][peer][latency]") {
+    constexpr unsigned kPort = 57227;
+    auto cfg = planeConfig(kPort);
+    cfg.manualAudioPump = true;   // the test thread renders every block
+    EngineFixture fx(cfg);
+
+    server_shared_memory_client client(kPort);
+    ShmPeerPlaneHeader* plane = client.get_peer_plane();
+    REQUIRE(plane != nullptr);
+    shm_peer_attach(plane, 1);
+
+    const PerformanceMetrics& m = fx.engine().getMetrics();
+    fx.pumpBlock(4);
+
+    // Before the direct lane the NRT gateway copied the command into the IN
+    // ring after one block and the audio thread performed it in the next: two
+    // blocks. Now the block that follows the write performs it.
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t before = m.messages_processed.load(std::memory_order_relaxed);
+        REQUIRE(peerWrite(plane, osc_test::message("/status")));
+        fx.pumpBlock(1);
+        CHECK(m.messages_processed.load(std::memory_order_relaxed) == before + 1);
+    }
+
+    // The reply still reaches the peer's origin through the egress lane.
+    fx.clearReplies();
+    REQUIRE(peerWrite(plane, osc_test::message("/sync", 99)));
+    OscReply reply;
+    REQUIRE(fx.waitForReply("/synced", reply));
+    CHECK(reply.parsed().argInt(0) == 99);
+    CHECK(m.osc_in_corrupted.load(std::memory_order_relaxed) == 0);
+}
+
+TEST_CASE("shm-peer latency: command-to-application time on the live driver",
+          "[shm][peer][latency]") {
+    constexpr unsigned kPort = 57228;
+    EngineFixture fx(planeConfig(kPort));
+
+    server_shared_memory_client client(kPort);
+    ShmPeerPlaneHeader* plane = client.get_peer_plane();
+    REQUIRE(plane != nullptr);
+    shm_peer_attach(plane, 1);
+
+    const PerformanceMetrics& m = fx.engine().getMetrics();
+    REQUIRE(fx.waitForBlocks(4));
+
+    // Time from the peer's write to the audio thread performing it, one
+    // command at a time, read off messages_processed.
+    constexpr int N = 200;
+    std::vector<double> us;
+    us.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        const uint32_t before = m.messages_processed.load(std::memory_order_acquire);
+        const auto t0 = std::chrono::steady_clock::now();
+        REQUIRE(peerWrite(plane, osc_test::message("/status")));
+        // Spin rather than waitUntil: its 5 ms poll would swamp the measurement.
+        const auto deadline = t0 + std::chrono::seconds(2);
+        while (m.messages_processed.load(std::memory_order_acquire) == before &&
+               std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        REQUIRE(m.messages_processed.load(std::memory_order_acquire) != before);
+        us.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - t0).count());
+    }
+    std::sort(us.begin(), us.end());
+    const double blockUs = 1e6 * 128 / 48000;
+    fprintf(stderr, "  shm peer lane: command-to-application p50 %.0f us, p99 %.0f us, "
+                    "max %.0f us (block %.0f us)\n",
+            us[N / 2], us[N * 99 / 100], us[N - 1], blockUs);
+    // Loose: the write waits at most one block for the next drain; allow a
+    // descheduled CI driver a few more.
+    CHECK(us[N / 2] < 4 * blockUs);
+}
+
+TEST_CASE("shm-peer: pre-decoded records from the peer take the record path",
+          "[shm][peer][precoded]") {
+    constexpr unsigned kPort = 57229;
+    auto cfg = planeConfig(kPort);
+    cfg.manualAudioPump = true;
+    EngineFixture fx(cfg);
+
+    server_shared_memory_client client(kPort);
+    ShmPeerPlaneHeader* plane = client.get_peer_plane();
+    REQUIRE(plane != nullptr);
+    shm_peer_attach(plane, 1);
+    fx.pumpBlock(4);
+
+    auto* ns = static_cast<uint8_t*>(get_shared_memory_base()) + NATIVE_STATS_START;
+    auto& precoded = *reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_PRECODED_CMDS);
+    const uint32_t before = precoded.load(std::memory_order_relaxed);
+
+    // A peer encodes /g_new itself and flags the frame; the low sourceId bits
+    // are still ignored (the origin is the transport's).
+    auto pkt = osc_test::message("/g_new", 4100, 0, 0);
+    std::vector<uint8_t> rec(SS_CMD_RECORD_MAX);
+    rec.resize(ss_cmd_encode(pkt.ptr(), pkt.size(), rec.data(), SS_CMD_RECORD_MAX));
+    REQUIRE(!rec.empty());
+    REQUIRE(RingBufferWriter::write(
+        shm_peer_cmd_ring(plane), SHM_PEER_CMD_RING_SIZE,
+        &plane->cmd_head, &plane->cmd_tail,
+        &plane->cmd_sequence, &plane->cmd_write_lock,
+        rec.data(), static_cast<uint32_t>(rec.size()), SOURCE_ID_PRECODED | 7));
+    fx.pumpBlock(1);
+    CHECK(precoded.load(std::memory_order_relaxed) == before + 1);
+
+    // A record whose offsets leave the payload is dropped, not followed.
+    std::vector<uint8_t> bad = rec;
+    reinterpret_cast<SsCmdRecord*>(bad.data())->oscOffset = 0xFFFF0000u;
+    REQUIRE(RingBufferWriter::write(
+        shm_peer_cmd_ring(plane), SHM_PEER_CMD_RING_SIZE,
+        &plane->cmd_head, &plane->cmd_tail,
+        &plane->cmd_sequence, &plane->cmd_write_lock,
+        bad.data(), static_cast<uint32_t>(bad.size()), SOURCE_ID_PRECODED));
+    fx.pumpBlock(1);
+    CHECK(precoded.load(std::memory_order_relaxed) == before + 1);
+
+    // The group exists, and replies still reach the peer's origin.
+    fx.clearReplies();
+    REQUIRE(peerWrite(plane, osc_test::message("/sync", 5)));
+    OscReply reply;
+    REQUIRE(fx.waitForReply("/synced", reply));
+    fx.send(osc_test::message("/n_free", 4100));
+    fx.pumpBlock(1);
+}
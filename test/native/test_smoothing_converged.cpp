@@ -0,0 +1,163 @@
+/*
+ * test_smoothing_converged.cpp — converged-state fast paths for the smoothing
+ * UGens (Lag family, Ramp, VarLag in FilterUGens.cpp).
+ *
+ * A settled unit swaps to a constant fill and counts itself in the
+ * smoothingConverged native stat; a moving input hands the block back to the
+ * full calc function. The graphs are hand-built so the input is a control bus
+ * the test drives with /c_set.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include "EngineFixture.h"
+#include "audio_processor.h"   // get_shared_memory_base, g_world
+#include "shared_memory.h"     // NATIVE_STAT_CONVERGED_UNITS
+#include "SC_World.h"
+#include "SC_Constants.h"  // log001, as the Lag calc functions use
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Minimal SCgf v2 writer (as in test_graphdef_optimise.cpp).
+struct DefWriter {
+    struct Input { int32_t unit; int32_t index; };  // unit -1 => constant index
+    struct Ugen {
+        std::string name;
+        uint8_t rate;  // 0 ir, 1 kr, 2 ar
+        std::vector<Input> inputs;
+        std::vector<uint8_t> outputs;
+        int16_t special = 0;
+    };
+
+    std::string name;
+    std::vector<float> constants;
+    std::vector<Ugen> ugens;
+
+    Input c(float v) {
+        for (size_t i = 0; i < constants.size(); ++i)
+            if (constants[i] == v) return {-1, static_cast<int32_t>(i)};
+        constants.push_back(v);
+        return {-1, static_cast<int32_t>(constants.size() - 1)};
+    }
+    Input add(Ugen u) {
+        ugens.push_back(std::move(u));
+        return {static_cast<int32_t>(ugens.size() - 1), 0};
+    }
+
+    std::vector<uint8_t> bytes() const {
+        std::vector<uint8_t> b = {'S', 'C', 'g', 'f'};
+        auto i8  = [&](uint8_t v) { b.push_back(v); };
+        auto i16 = [&](int v) { i8(static_cast<uint8_t>(v >> 8)); i8(static_cast<uint8_t>(v)); };
+        auto i32 = [&](int32_t v) { for (int s = 24; s >= 0; s -= 8) i8(static_cast<uint8_t>(uint32_t(v) >> s)); };
+        auto f32 = [&](float f) { int32_t v; std::memcpy(&v, &f, 4); i32(v); };
+        auto str = [&](const std::string& s) { i8(static_cast<uint8_t>(s.size())); for (char ch : s) i8(static_cast<uint8_t>(ch)); };
+        i32(2); i16(1);
+        str(name);
+        i32(static_cast<int32_t>(constants.size()));
+        for (float f : constants) f32(f);
+        i32(0);  // controls
+        i32(0);  // param names
+        i32(static_cast<int32_t>(ugens.size()));
+        for (const auto& u : ugens) {
+            str(u.name); i8(u.rate);
+            i32(static_cast<int32_t>(u.inputs.size()));
+            i32(static_cast<int32_t>(u.outputs.size()));
+            i16(u.special);
+            for (const auto& in : u.inputs) { i32(in.unit); i32(in.index); }
+            for (uint8_t r : u.outputs) i8(r);
+        }
+        i16(0);  // variants
+        return b;
+    }
+};
+
+constexpr int32_t kInBus = 10;   // target, driven by the test
+constexpr float   kLag   = 0.2f;
+
+// In.kr(10) smoothed by Lag, Lag3, Ramp and VarLag (all kr, lag 0.2 s) onto
+// control buses 11..14.
+bool loadProbe(EngineFixture& fx) {
+    DefWriter d;
+    d.name = "smoothing_probe";
+    auto x = d.add({"In", 1, {d.c(kInBus)}, {1}});
+    auto lag    = d.add({"Lag", 1, {x, d.c(kLag)}, {1}});
+    auto lag3   = d.add({"Lag3", 1, {x, d.c(kLag)}, {1}});
+    auto ramp   = d.add({"Ramp", 1, {x, d.c(kLag)}, {1}});
+    auto varlag = d.add({"VarLag", 1, {x, d.c(kLag), x}, {1}});
+    d.add({"Out", 1, {d.c(11), lag}, {}});
+    d.add({"Out", 1, {d.c(12), lag3}, {}});
+    d.add({"Out", 1, {d.c(13), ramp}, {}});
+    d.add({"Out", 1, {d.c(14), varlag}, {}});
+    auto bytes = d.bytes();
+    return fx.sendAndExpectDone(osc_test::messageWithBlob("/d_recv", bytes.data(), bytes.size()));
+}
+
+uint32_t convergedUnits() {
+    auto* ns = static_cast<uint8_t*>(get_shared_memory_base()) + NATIVE_STATS_START;
+    return reinterpret_cast<std::atomic<uint32_t>*>(ns + NATIVE_STAT_CONVERGED_UNITS)
+        ->load(std::memory_order_relaxed);
+}
+
+float bus(EngineFixture& fx, int32_t index) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/c_get", index));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/c_set", r));
+    return r.parsed().argFloat(1);
+}
+
+void startProbe(EngineFixture& fx, float target) {
+    fx.send(osc_test::message("/c_set", kInBus, target));
+    REQUIRE(loadProbe(fx));
+    osc_test::Builder b;
+    b.begin("/s_new") << "smoothing_probe" << int32_t(1000) << int32_t(0) << int32_t(1);
+    fx.send(b.end());
+}
+
+}  // namespace
+
+TEST_CASE("settled smoothing units switch to the constant fill and back", "[smoothing]") {
+    EngineFixture fx;
+    startProbe(fx, 0.5f);
+    REQUIRE(fx.pollUntil([] { return convergedUnits() == 4; }, 3000));
+    CHECK(bus(fx, 11) == 0.5f);
+    CHECK(bus(fx, 14) == 0.5f);
+
+    fx.send(osc_test::message("/c_set", kInBus, 1.0f));
+    REQUIRE(fx.pollUntil([] { return convergedUnits() < 4; }, 3000));
+    const float moving = bus(fx, 11);
+    CHECK(moving > 0.5f);
+
+    // Settled again on the new target, at exactly the value the filter reaches.
+    REQUIRE(fx.pollUntil([] { return convergedUnits() == 4; }, 3000));
+    for (int32_t i = 11; i <= 14; ++i)
+        CHECK(bus(fx, i) == 1.0f);
+
+    fx.send(osc_test::message("/n_free", 1000));
+    CHECK(fx.pollUntil([] { return convergedUnits() == 0; }, 3000));
+}
+
+TEST_CASE("a settled Lag resumes on the exact recurrence", "[smoothing]") {
+    EngineFixture fx;
+    startProbe(fx, 0.25f);
+    REQUIRE(fx.pollUntil([] { return convergedUnits() == 4; }, 3000));
+
+    fx.send(osc_test::message("/c_set", kInBus, -0.75f));
+    REQUIRE(fx.waitForBlocks(2));
+    const float observed = bus(fx, 11);
+
+    // Lag.kr steps once per block: y = x + b1 * (y - x), from the settled value.
+    const double b1 = std::exp(log001 / (kLag * g_world->mBufRate.mSampleRate));
+    double y = 0.25f;
+    bool onTrajectory = false;
+    for (int n = 1; n < 1000 && !onTrajectory; ++n) {
+        y = -0.75f + b1 * (y - -0.75f);
+        onTrajectory = static_cast<float>(y) == observed;
+    }
+    CHECK(observed < 0.25f);
+    CHECK(onTrajectory);
+}
@@ -1,7 +1,7 @@
 /*
- * test_transports.cpp — acceptance tests for the kernel-ACL'd command
- * transports (StreamOscTransport over TCP + UDS stream, UdsDgramOscTransport)
- * against real client sockets. No engine: the transports talk to a recorded
+ * test_transports.cpp — acceptance tests for the command transports
+ * (StreamOscTransport over TCP + UDS stream, UdsDgramOscTransport,
+ * UdpOscTransport) against real client sockets. No engine: the transports talk to a recorded
  * ingest callback, exactly as Main.cpp wires them to engine.ingest().
  *
  * Unix-only: the client side uses POSIX sockets directly. The shared
@@ -14,6 +14,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "src/native/StreamOscTransport.h"
+#include "src/native/UdpOscTransport.h"
 #include "src/native/UdsDgramOscTransport.h"
 #include "OscTestUtils.h"
 
@@ -146,6 +147,31 @@ int bindUnixDgram(const std::string& path) {
     return fd;
 }
 
+// A loopback UDP client socket bound to an ephemeral port.
+int bindUdpLoopback(int& port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(fd >= 0);
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr);
+    REQUIRE(bind(fd, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) == 0);
+    socklen_t len = sizeof(sa);
+    REQUIRE(getsockname(fd, reinterpret_cast<sockaddr*>(&sa), &len) == 0);
+    port = ntohs(sa.sin_port);
+    setRecvTimeout(fd);
+    return fd;
+}
+
+void sendUdp(int fd, int port, const std::vector<uint8_t>& pkt) {
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(static_cast<uint16_t>(port));
+    inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr);
+    REQUIRE(sendto(fd, pkt.data(), pkt.size(), 0,
+                   reinterpret_cast<sockaddr*>(&sa), sizeof(sa))
+            == static_cast<ssize_t>(pkt.size()));
+}
+
 void sendUnixDgram(int fd, const std::string& to, const std::vector<uint8_t>& pkt) {
     sockaddr_un sa{};
     sa.sun_family = AF_UNIX;
@@ -278,4 +304,76 @@ TEST_CASE("UdsDgramOscTransport: bound peers get replies, unbound peers are unad
     CHECK(access(server.c_str(), F_OK) != 0);  // stop unlinks the socket path
 }
 
+TEST_CASE("UdpOscTransport: replies queue until flush, then arrive in order",
+          "[transport][udp]") {
+    // Pick a free port for the server (probe closes before the transport binds).
+    int serverPort = 0;
+    close(bindUdpLoopback(serverPort));
+
+    IngestLog log;
+    UdpOscTransport t;
+    t.setIngest([&](const uint8_t* d, uint32_t n, uint32_t tok) { log.record(d, n, tok); });
+    t.initialise(serverPort, "127.0.0.1");
+    t.start();
+
+    int clientPort = 0;
+    int fd = bindUdpLoopback(clientPort);
+    auto probe = message("/status");
+    sendUdp(fd, serverPort, probe.data);
+    REQUIRE(waitUntil([&] { return log.count() == 1; }));
+    auto [token, pkt] = log.at(0);
+    CHECK(token >= 1);
+    CHECK(parseAddress(pkt.data(), static_cast<uint32_t>(pkt.size())) == "/status");
+
+    // Same sender → same token.
+    sendUdp(fd, serverPort, probe.data);
+    REQUIRE(waitUntil([&] { return log.count() == 2; }));
+    CHECK(log.at(1).first == token);
+
+    // Replies are queued, not sent, until the gateway's flush.
+    auto r1 = message("/r", 1);
+    auto r2 = message("/r", 2);
+    auto r3 = message("/r", 3);
+    REQUIRE(t.send(token, r1.ptr(), r1.size(), false));
+    REQUIRE(t.send(token, r2.ptr(), r2.size(), false));
+    REQUIRE(t.send(token, r3.ptr(), r3.size(), false));
+    CHECK_FALSE(t.send(0, r1.ptr(), r1.size(), false));   // in-process: unaddressable
+    uint8_t buf[512];
+    CHECK(recv(fd, buf, sizeof(buf), MSG_DONTWAIT) < 0);
+
+    t.flush();
+    for (int i = 1; i <= 3; ++i) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        REQUIRE(n > 0);
+        auto m = osc_test::parseReply(buf, static_cast<uint32_t>(n));
+        CHECK(m.address == "/r");
+        CHECK(m.argInt(0) == i);
+    }
+
+    // A full batch goes out without waiting for flush.
+    for (uint32_t i = 0; i < UdpOscTransport::kBatchDatagrams; ++i)
+        REQUIRE(t.send(token, r1.ptr(), r1.size(), false));
+    for (uint32_t i = 0; i < UdpOscTransport::kBatchDatagrams; ++i)
+        REQUIRE(recv(fd, buf, sizeof(buf), 0) > 0);
+
+    // Notify audience: caller-relative and the explicit local reply port.
+    CHECK(t.subscribeNotify(token));
+    CHECK_FALSE(t.subscribeNotify(token));                // already subscribed
+    int explicitPort = 0;
+    int portFd = bindUdpLoopback(explicitPort);
+    t.subscribeNotifyPort(explicitPort);
+    auto push = message("/supersonic/devices/changed");
+    t.broadcastNotify(push.ptr(), push.size());
+    t.flush();
+    for (int s : {fd, portFd}) {
+        ssize_t n = recv(s, buf, sizeof(buf), 0);
+        REQUIRE(n > 0);
+        CHECK(parseAddress(buf, static_cast<uint32_t>(n)) == "/supersonic/devices/changed");
+    }
+
+    close(fd);
+    close(portFd);
+    t.stop();
+}
+
 #endif // !_WIN32
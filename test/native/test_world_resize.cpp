@@ -0,0 +1,152 @@
+/*
+ * test_world_resize.cpp — growing World limits at runtime (SC_WorldResize.h)
+ *
+ * /supersonic/world/grow raises nodes, buffers, buses, wire buffers and RT
+ * memory in place. Nodes, buffers and bus values from before the resize must
+ * still be there after it, the new capacity must be usable straight away,
+ * and a refused resize must change nothing.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "EngineFixture.h"
+#include "audio_processor.h"   // get_shared_memory_base
+#include "shared_memory.h"     // NATIVE_STAT_WORLD_RESIZES
+
+#include <atomic>
+
+namespace {
+
+struct Limits { int nodes, buffers, audioBuses, controlBuses, wireBufs, rtMemoryKB; };
+
+OscReply grow(EngineFixture& fx, int nodes, int buffers, int audioBuses, int controlBuses,
+              int wireBufs = 0, int rtMemoryKB = 0) {
+    fx.clearReplies();
+    osc_test::Builder b;
+    b.begin("/supersonic/world/grow") << int32_t(nodes) << int32_t(buffers) << int32_t(audioBuses)
+                                      << int32_t(controlBuses) << int32_t(wireBufs)
+                                      << int32_t(rtMemoryKB);
+    fx.send(b.end());
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/world/grow.reply", r, 5000));
+    return r;
+}
+
+Limits limits(EngineFixture& fx, bool ceiling = false) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/supersonic/world/limits"));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/supersonic/world/limits.reply", r));
+    auto p = r.parsed();
+    const int o = ceiling ? 6 : 0;
+    return { p.argInt(o), p.argInt(o + 1), p.argInt(o + 2), p.argInt(o + 3), p.argInt(o + 4),
+             p.argInt(o + 5) };
+}
+
+bool nodeExists(EngineFixture& fx, int32_t id) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/n_query", id));
+    OscReply r;
+    return fx.waitForReply("/n_info", r, 500);
+}
+
+bool groupNew(EngineFixture& fx, int32_t id) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/g_new", id, 0, 1));
+    OscReply r;
+    if (fx.waitForReply("/fail", r, 300))
+        return false;
+    return nodeExists(fx, id);
+}
+
+void setBus(EngineFixture& fx, int32_t index, float value) {
+    osc_test::Builder b;
+    b.begin("/c_set") << index << value;
+    fx.send(b.end());
+}
+
+float bus(EngineFixture& fx, int32_t index) {
+    fx.clearReplies();
+    fx.send(osc_test::message("/c_get", index));
+    OscReply r;
+    REQUIRE(fx.waitForReply("/c_set", r));
+    return r.parsed().argFloat(1);
+}
+
+uint32_t nativeStat(uint32_t offset) {
+    auto* ns = static_cast<uint8_t*>(get_shared_memory_base()) + NATIVE_STATS_START;
+    return reinterpret_cast<std::atomic<uint32_t>*>(ns + offset)->load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+TEST_CASE("growing the node limit keeps existing nodes", "[world][resize]") {
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.maxNodes = 8;
+    EngineFixture fx(cfg);
+    fx.send(osc_test::message("/notify", 1));
+
+    int32_t id = 100;
+    while (id < 120 && groupNew(fx, id))
+        ++id;
+    REQUIRE(id < 120);     // hit the boot limit
+    REQUIRE(id > 100);
+
+    const uint32_t resizesBefore = nativeStat(NATIVE_STAT_WORLD_RESIZES);
+    auto r = grow(fx, 64, 0, 0, 0).parsed();
+    REQUIRE(r.argInt(0) == 1);
+    CHECK(r.argInt(1) == 64);
+    CHECK(limits(fx).nodes == 64);
+
+    for (int32_t old = 100; old < id; ++old)
+        CHECK(nodeExists(fx, old));
+    for (int32_t more = 200; more < 240; ++more)
+        REQUIRE(groupNew(fx, more));
+    CHECK(fx.pollUntil([&] { return nativeStat(NATIVE_STAT_WORLD_RESIZES) > resizesBefore; }, 3000));
+}
+
+TEST_CASE("growing buffers and buses keeps their contents", "[world][resize]") {
+    auto cfg = EngineFixture::defaultConfig();
+    cfg.numBuffers = 16;
+    cfg.numControlBusChannels = 64;
+    EngineFixture fx(cfg);
+
+    REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_alloc", 3, 512, 1)));
+    setBus(fx, 10, 0.25f);
+    CHECK(bus(fx, 10) == Catch::Approx(0.25f));
+
+    auto r = grow(fx, 0, 64, 0, 1024).parsed();
+    REQUIRE(r.argInt(0) == 1);
+    CHECK(r.argInt(2) == 64);
+    CHECK(r.argInt(4) == 1024);
+    CHECK(r.argInt64(7) > 0);  // bytes added
+
+    fx.clearReplies();
+    fx.send(osc_test::message("/b_query", 3));
+    OscReply info;
+    REQUIRE(fx.waitForReply("/b_info", info));
+    CHECK(info.parsed().argInt(1) == 512);
+    CHECK(bus(fx, 10) == Catch::Approx(0.25f));
+
+    REQUIRE(fx.sendAndExpectDone(osc_test::message("/b_alloc", 40, 256, 1)));
+    setBus(fx, 900, 0.5f);
+    CHECK(bus(fx, 900) == Catch::Approx(0.5f));
+}
+
+TEST_CASE("a resize above the ceiling changes nothing", "[world][resize]") {
+    EngineFixture fx;
+    const Limits before = limits(fx);
+    const Limits ceiling = limits(fx, true);
+    REQUIRE(ceiling.buffers >= before.buffers);
+
+    auto r = grow(fx, before.nodes * 2, ceiling.buffers + 1, 0, 0).parsed();
+    CHECK(r.argInt(0) == 0);
+    const Limits after = limits(fx);
+    CHECK(after.nodes == before.nodes);
+    CHECK(after.buffers == before.buffers);
+
+    // Values at or below the current limits keep them.
+    r = grow(fx, 1, 1, 1, 1, 1, 1).parsed();
+    REQUIRE(r.argInt(0) == 1);
+    CHECK(r.argInt(1) == before.nodes);
+    CHECK(r.argInt(6) == before.rtMemoryKB);
+}
@@ -0,0 +1,376 @@
+/*
+    SuperSonic
+    Copyright (c) 2025 Sam Aaron
+
+    Tests for the offline score renderer: score and synthdef parsing, node
+    lifetime analysis, segment planning and stitching (pure logic), then an end
+    to end render of a short score — notes through a persistent reverb — cut
+    into segments on forked engines and compared sample by sample against the
+    same score rendered serially. Standalone assert harness, like host_tests.
+*/
+
+#include "render/render_engine.h"
+#include "render/score_plan.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ss_render;
+
+static int g_failures = 0;
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            std::fprintf(stderr, "FAIL %s:%d  %s\n", __FILE__, __LINE__, #cond); \
+            ++g_failures;                                                      \
+        }                                                                      \
+    } while (0)
+
+#ifndef SS_TEST_SYNTHDEF_DIR
+#define SS_TEST_SYNTHDEF_DIR "packages/supersonic-scsynth-synthdefs/synthdefs"
+#endif
+
+// ── tiny OSC encoder for building test scores ────────────────────────────────
+namespace {
+struct Osc {
+    std::vector<uint8_t> b;
+    void pad() { while (b.size() % 4) b.push_back(0); }
+    void str(const char* s) { b.insert(b.end(), s, s + std::strlen(s) + 1); pad(); }
+    void i32(int32_t v) { for (int i = 3; i >= 0; --i) b.push_back(uint8_t(v >> (i * 8))); }
+    void f32(float v) { uint32_t r; std::memcpy(&r, &v, 4); i32(int32_t(r)); }
+    void blob(const std::vector<uint8_t>& d) {
+        i32(int32_t(d.size()));
+        b.insert(b.end(), d.begin(), d.end());
+        pad();
+    }
+};
+
+// /s_new def id action target [name value]...
+std::vector<uint8_t> s_new(const char* def, int32_t id, int32_t action, int32_t target,
+                           const std::vector<std::pair<const char*, float>>& ctl = {}) {
+    Osc o;
+    o.str("/s_new");
+    std::string tags = ",siii";
+    for (size_t i = 0; i < ctl.size(); ++i) tags += "sf";
+    o.str(tags.c_str());
+    o.str(def); o.i32(id); o.i32(action); o.i32(target);
+    for (const auto& c : ctl) { o.str(c.first); o.f32(c.second); }
+    return o.b;
+}
+std::vector<uint8_t> ints(const char* addr, const std::vector<int32_t>& v) {
+    Osc o;
+    o.str(addr);
+    o.str((std::string(",") + std::string(v.size(), 'i')).c_str());
+    for (int32_t x : v) o.i32(x);
+    return o.b;
+}
+std::vector<uint8_t> n_set(int32_t id, const char* name, float v) {
+    Osc o; o.str("/n_set"); o.str(",isf"); o.i32(id); o.str(name); o.f32(v);
+    return o.b;
+}
+std::vector<uint8_t> d_recv(const std::vector<uint8_t>& def) {
+    Osc o; o.str("/d_recv"); o.str(",b"); o.blob(def);
+    return o.b;
+}
+
+std::vector<uint8_t> read_def(const char* name) {
+    std::ifstream f(std::string(SS_TEST_SYNTHDEF_DIR) + "/" + name + ".scsyndef", std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+Score score_of(std::vector<ScoreEvent> ev) {
+    Score s;
+    s.events = std::move(ev);
+    return s;
+}
+
+// A minimal def with only controls: enough for the analyser.
+SynthDefInfo def_info(const char* name, std::vector<std::pair<const char*, float>> ctl) {
+    SynthDefInfo d;
+    d.name = name;
+    for (const auto& c : ctl) {
+        d.controlNames.push_back(c.first);
+        d.defaults.push_back(c.second);
+    }
+    return d;
+}
+}  // namespace
+
+int main() {
+    // ── Score format ─────────────────────────────────────────────────────────
+    {
+        Score s = score_of({{0.0, ints("/g_new", {2, 0, 0})},
+                            {0.5, s_new("a", 1000, 0, 2)},
+                            {0.5, ints("/n_free", {1000})},
+                            {1.25, ints("/n_free", {1001})}});
+        const auto bytes = write_score(s);
+        Score back;
+        std::string err;
+        CHECK(parse_score(bytes.data(), bytes.size(), back, err));
+        CHECK(back.events.size() == 4);
+        CHECK(back.events[1].time == 0.5 && back.events[2].time == 0.5);
+        CHECK(back.events[2].msg == s.events[2].msg);     // same-time order kept
+        CHECK(std::fabs(back.duration() - 1.25) < 1e-9);
+
+        // Out-of-order records sort; a truncated one is refused.
+        Score rev = score_of({{2.0, ints("/n_free", {1})}});
+        auto b2 = write_score(rev);
+        b2.insert(b2.end(), bytes.begin(), bytes.end());
+        CHECK(parse_score(b2.data(), b2.size(), back, err));
+        CHECK(back.events.size() == 5 && back.events.back().time == 2.0);
+        CHECK(!parse_score(bytes.data(), bytes.size() - 3, back, err));
+    }
+    // Nested bundles take the later of their own and the outer time.
+    {
+        std::vector<uint8_t> inner = {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0};
+        put_be64(inner, seconds_to_timetag(0.25));
+        const auto m = ints("/n_free", {7});
+        put_be32(inner, uint32_t(m.size()));
+        inner.insert(inner.end(), m.begin(), m.end());
+        std::vector<uint8_t> outer = {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0};
+        put_be64(outer, seconds_to_timetag(1.0));
+        put_be32(outer, uint32_t(inner.size()));
+        outer.insert(outer.end(), inner.begin(), inner.end());
+        std::vector<uint8_t> file;
+        put_be32(file, uint32_t(outer.size()));
+        file.insert(file.end(), outer.begin(), outer.end());
+        Score s;
+        std::string err;
+        CHECK(parse_score(file.data(), file.size(), s, err));
+        CHECK(s.events.size() == 1 && s.events[0].time == 1.0);
+    }
+
+    // ── Synthdef scan ────────────────────────────────────────────────────────
+    const auto beepDef = read_def("sonic-pi-beep");
+    const auto verbDef = read_def("sonic-pi-fx_reverb");
+    std::vector<SynthDefInfo> defs;
+    {
+        std::string err;
+        CHECK(!beepDef.empty() && !verbDef.empty());
+        CHECK(scan_synthdefs(beepDef.data(), beepDef.size(), defs, err));
+        CHECK(scan_synthdefs(verbDef.data(), verbDef.size(), defs, err));
+        CHECK(defs.size() == 2);
+        if (defs.size() == 2) {
+            CHECK(defs[0].name == "sonic-pi-beep");
+            CHECK(defs[0].controlIndex("release") >= 0);
+            CHECK(defs[0].controlIndex("no-such-control") < 0);
+            CHECK(!defs[0].writesBuffers && !defs[0].feedback);
+        }
+        CHECK(!scan_synthdefs(beepDef.data(), beepDef.size() / 2, defs, err));
+
+        // A parameter count far past the end is refused before anything is
+        // sized by it.
+        const uint8_t huge[] = {'S', 'C', 'g', 'f', 0, 0, 0, 2, 0, 1,
+                                1, 'x', 0, 0, 0, 0, 0x7f, 0xff, 0xff, 0xff};
+        CHECK(!scan_synthdefs(huge, sizeof(huge), defs, err));
+    }
+
+    // ── Traits ───────────────────────────────────────────────────────────────
+    {
+        TraitTable t;
+        std::string err;
+        CHECK(parse_traits("# comment\nnote life=attack+0.5+release release=0.25\n"
+                           "* life=4\nfx tail=1.5\n", t, err));
+        CHECK(t.size() == 3);
+        CHECK(t["note"].life.set && t["note"].life.constant == 0.5);
+        CHECK(t["note"].life.controls.size() == 2);
+        CHECK(t["fx"].tail.set && t["fx"].tail.constant == 1.5 && !t["fx"].life.set);
+        CHECK(!parse_traits("note lief=1\n", t, err));
+        CHECK(!parse_traits("note life=1+\n", t, err));
+    }
+
+    // ── Analysis ─────────────────────────────────────────────────────────────
+    {
+        std::vector<SynthDefInfo> d = {def_info("note", {{"attack", 0.1f}, {"release", 1.0f}, {"gate", 1.0f}}),
+                                       def_info("pad", {{"gate", 1.0f}}),
+                                       def_info("fx", {{"mix", 0.5f}})};
+        TraitTable t;
+        std::string err;
+        CHECK(parse_traits("note life=attack+release\npad release=0.5\nfx tail=1\n", t, err));
+        Score s = score_of({{0.0, ints("/g_new", {2, 0, 0})},
+                            {0.0, s_new("fx", 900, 1, 0)},
+                            {1.0, s_new("note", 1000, 0, 2, {{"release", 2.0f}})},  // ends 3.1
+                            {1.0, s_new("note", 1001, 0, 2)},                       // would end 2.1
+                            {1.5, ints("/n_free", {1001})},                         // ends 1.5
+                            {2.0, s_new("pad", 1002, 0, 2)},
+                            {3.0, n_set(1002, "gate", 0.0f)},                       // ends 3.5
+                            {4.0, s_new("pad", 1003, 0, 2)},
+                            {5.0, ints("/g_freeAll", {2})},                         // ends 5.0
+                            {6.0, s_new("pad", 1004, 0, 2)}});                      // never ends
+        const Analysis a = analyse_score(s, d, t);
+        CHECK(a.nodes.size() == 6);
+        if (a.nodes.size() == 6) {
+            CHECK(a.nodes[0].end == kForever && a.nodes[0].tail == 1.0);
+            CHECK(std::fabs(a.nodes[1].end - 3.1) < 1e-6);
+            CHECK(a.nodes[2].end == 1.5);
+            CHECK(a.nodes[3].end == 3.5);
+            CHECK(a.nodes[4].end == 5.0);
+            CHECK(a.nodes[5].end == kForever);
+        }
+        CHECK(a.eventNodes[0].empty());                   // /g_new is state
+        CHECK(a.eventNodes[4].size() == 1 && a.eventNodes[4][0] == 2);
+        CHECK(a.eventNodes[6].size() == 1 && a.eventNodes[6][0] == 3);
+        CHECK(a.eventNodes[8].size() == 3);                 // everything left in group 2
+        int infinite = 0;
+        for (const auto& is : a.issues) infinite += is.kind == IssueKind::InfiniteSustain;
+        CHECK(infinite == 1);                             // reported once, for pad
+
+        // Planning: block-aligned cuts, none inside a node's forbidden span,
+        // none after the unending pad + maxWarmup.
+        PlanOptions o;
+        o.segments = 8;
+        o.warmup = 0.5;
+        o.maxWarmup = 1.0;
+        o.minSegment = 0.25;
+        o.tail = 12.0;
+        o.sampleRate = 1000.0;
+        o.blockFrames = 10;
+        const Plan p = plan_segments(s, a, o);
+        CHECK(p.segments.size() > 1);
+        CHECK(!p.notes.empty());                          // fewer than 8
+        for (size_t k = 0; k < p.segments.size(); ++k) {
+            const Segment& g = p.segments[k];
+            CHECK(g.startFrame % 10 == 0 && g.warmFrame % 10 == 0);
+            CHECK(g.warmFrame <= g.startFrame && g.startFrame < g.endFrame && g.endFrame <= g.renderEnd);
+            if (k > 0) {
+                CHECK(g.startFrame == p.segments[k - 1].endFrame);
+                CHECK(g.startFrame <= 7000);              // pad 1004 from 6.0 + 1.0
+                for (const NodeSpan& n : a.nodes) {
+                    if (n.tail >= 0.0) continue;
+                    const double T = double(g.startFrame) / 1000.0;
+                    CHECK(!(T > n.start + 1.0 && T < n.end + 0.5));
+                }
+            }
+        }
+        CHECK(p.segments.back().endFrame == p.totalFrames);
+
+        // One segment when nothing may be cut: the held pad forbids
+        // everything past 0.5 s, and 0.5 s is too short a segment.
+        o.maxWarmup = 0.5;
+        o.minSegment = 1.0;
+        o.tail = 0.0;
+        Score held = score_of({{0.0, s_new("pad", 1, 0, 0)}, {10.0, ints("/n_free", {1})}});
+        const Plan one = plan_segments(held, analyse_score(held, d, t), o);
+        CHECK(one.segments.size() == 1);
+
+        // Scripts: a note long gone by the warm start is dropped with the
+        // commands that address it; the fx is carried into the preroll.
+        Segment seg;
+        seg.warmFrame = 4000;
+        seg.startFrame = 4500;
+        seg.endFrame = 5500;
+        seg.renderEnd = 5600;
+        o.warmup = 2.0;
+        const SegmentScript sc = segment_script(s, a, seg, o);
+        CHECK(sc.preroll.size() == 2);                    // /g_new, fx
+        if (sc.preroll.size() == 2) {
+            CHECK(sc.preroll[0] == &s.events[0] && sc.preroll[1] == &s.events[1]);
+        }
+        CHECK(sc.timed.size() == 2);                      // pad 1003, /g_freeAll
+        if (sc.timed.size() == 2) {
+            CHECK(sc.timed[0] == &s.events[7] && sc.timed[1] == &s.events[8]);
+        }
+    }
+
+    // ── Stitching ────────────────────────────────────────────────────────────
+    {
+        Plan p;
+        p.totalFrames = 20;
+        p.crossfadeFrames = 4;
+        p.segments = {{0, 0, 10, 14}, {6, 10, 20, 20}};
+        std::vector<float> a(14, 1.0f), b(14, 3.0f);
+        std::vector<float> out(20, 0.0f);
+        const auto j = stitch(p, 1, {a.data(), b.data()}, out.data());
+        CHECK(j.size() == 1 && j[0].frame == 10 && j[0].maxDiff == 2.0f);
+        CHECK(out[0] == 1.0f && out[9] == 1.0f);
+        CHECK(out[10] > 1.0f && out[10] < out[13] && out[13] < 3.0f);
+        CHECK(out[14] == 3.0f && out[19] == 3.0f);
+    }
+
+    // ── End to end ───────────────────────────────────────────────────────────
+    // Short notes into a reverb that runs throughout, on bus 16. Cut into
+    // segments, the reverb is recreated at each warm start, so the check is
+    // that its memory has forgotten the difference by the cut.
+    if (!beepDef.empty() && !verbDef.empty()) {
+        std::vector<ScoreEvent> ev = {
+            {0.0, d_recv(beepDef)},
+            {0.0, d_recv(verbDef)},
+            {0.0, ints("/g_new", {2, 0, 0})},
+            {0.0, s_new("sonic-pi-fx_reverb", 900, 1, 0,
+                        {{"in_bus", 16.0f}, {"out_bus", 0.0f}, {"room", 0.3f}, {"mix", 0.4f}})},
+        };
+        for (int i = 0; i < 24; ++i)
+            ev.push_back({0.25 * i, s_new("sonic-pi-beep", -1, 0, 2,
+                                          {{"note", float(60 + (i * 7) % 24)}, {"out_bus", 16.0f},
+                                           {"attack", 0.01f}, {"sustain", 0.0f}, {"release", 0.2f}})});
+        Score s = score_of(std::move(ev));
+
+        TraitTable t;
+        std::string err;
+        CHECK(parse_traits("sonic-pi-beep life=attack+decay+sustain+release\n"
+                           "sonic-pi-fx_reverb tail=1\n", t, err));
+        const Analysis a = analyse_score(s, {}, t);       // defs come from /d_recv
+        CHECK(a.nodes.size() == 25);
+        CHECK(a.nodes.size() == 25 && a.nodes[1].end < 0.5);
+
+        PlanOptions o;
+        o.segments = 3;
+        o.warmup = 2.0;
+        o.maxWarmup = 4.0;
+        o.minSegment = 1.0;
+        o.tail = 1.0;
+        o.blockFrames = 128;
+        const Plan p = plan_segments(s, a, o);
+        CHECK(p.segments.size() == 3);
+
+        EngineOptions eo;
+        eo.channels = 2;
+        eo.world = default_world_options(2, 128);
+        std::vector<SegmentScript> scripts;
+        for (const Segment& g : p.segments) scripts.push_back(segment_script(s, a, g, o));
+        Segment whole;
+        whole.endFrame = whole.renderEnd = p.totalFrames;
+        scripts.push_back(segment_script(s, a, whole, o));
+
+        std::vector<std::unique_ptr<SharedFloats>> bufs;
+        std::vector<float*> outs;
+        for (const auto& sc : scripts) {
+            bufs.push_back(std::make_unique<SharedFloats>(size_t(sc.renderEnd - sc.warmFrame) * 2));
+            outs.push_back(bufs.back()->data());
+        }
+        const auto res = render_parallel(eo, scripts, outs, 4);
+        CHECK(res.size() == 4);
+        for (const auto& r : res) {
+            CHECK(r.ok);
+            CHECK(r.failReplies == 0);
+            CHECK(r.lateBundles == 0);
+            if (!r.ok) std::fprintf(stderr, "  render: %s\n", r.error.c_str());
+        }
+
+        std::vector<float> out(size_t(p.totalFrames) * 2, 0.0f);
+        stitch(p, 2, {outs[0], outs[1], outs[2]}, out.data());
+        const float* ref = outs[3];
+        float worst = 0.0f, peak = 0.0f;
+        for (size_t i = 0; i < out.size(); ++i) {
+            worst = std::max(worst, std::fabs(out[i] - ref[i]));
+            peak = std::max(peak, std::fabs(ref[i]));
+        }
+        CHECK(peak > 0.01f);                              // it made sound
+        CHECK(worst < 1e-4f);
+        if (!(worst < 1e-4f)) std::fprintf(stderr, "  segmented vs serial: %g\n", double(worst));
+    }
+
+    if (g_failures) {
+        std::fprintf(stderr, "%d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::printf("render tests OK\n");
+    return 0;
+}
@@ -74,8 +74,8 @@ test("WORLD_OPTIONS_START is consistent with TOTAL_BUFFER_SIZE", async ({ sonicP
   }, sonicConfig);
 
   // Scope is the last large region; the arena ends with the fixed-size
-  // NATIVE_STATS tail then the 16-aligned SAMPLE_CLOCK region (see
-  // shared_memory.h). Update this if the tail regions change.
+  // NATIVE_STATS, LATENCY_TRACE and METER tail then the 16-aligned SAMPLE_CLOCK
+  // region (see shared_memory.h). Update this if the tail regions change.
   expect(result.sampleClockStart + result.sampleClockSize).toBe(result.totalBufferSize);
   expect(result.scopeStart + result.scopeTotalSize).toBeLessThanOrEqual(result.sampleClockStart);
   // WORLD_OPTIONS comes before the end of the buffer